@@ -21,6 +21,7 @@
 #include "zenoh-pico/collections/element.h"
 #include "zenoh-pico/collections/fifo_mt.h"
 #include "zenoh-pico/collections/ring_mt.h"
+#include "zenoh-pico/collections/spsc_mt.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/result.h"
 
@@ -36,14 +37,13 @@ extern "C" {
         collection_type collection;                                                                                  \
     } handler_type;                                                                                                  \
                                                                                                                      \
+    /* Elements live in the collection slots, they are dropped or moved out in place */                             \
     static inline void _z_##handler_name##_elem_free(void **elem) {                                                  \
         elem_drop_f(elem_move_f((elem_owned_type *)*elem));                                                          \
-        z_free(*elem);                                                                                               \
         *elem = NULL;                                                                                                \
     }                                                                                                                \
     static inline void _z_##handler_name##_elem_move(void *dst, void *src) {                                         \
         memcpy(dst, src, sizeof(elem_owned_type));                                                                   \
-        z_free(src);                                                                                                 \
     }                                                                                                                \
                                                                                                                      \
     static inline void _z_##handler_name##_clear(handler_type *handler) {                                            \
@@ -68,14 +68,10 @@ extern "C" {
     static inline void _z_##handler_name##_send(elem_loaned_type *elem, void *context) {                             \
         _z_##handler_name##_rc_t *handler = (_z_##handler_name##_rc_t *)context;                                     \
         if (_z_rc_strong_count(handler->_cnt) > 1) {                                                                 \
-            elem_owned_type *internal_elem = (elem_owned_type *)z_malloc(sizeof(elem_owned_type));                   \
-            if (internal_elem == NULL) {                                                                             \
-                _Z_ERROR("Out of memory");                                                                           \
-                return;                                                                                              \
-            }                                                                                                        \
-            elem_take_f(internal_elem, elem);                                                                        \
-            z_result_t ret =                                                                                         \
-                collection_push_f(internal_elem, &_Z_RC_IN_VAL(handler)->collection, _z_##handler_name##_elem_free); \
+            elem_owned_type internal_elem;                                                                           \
+            elem_take_f(&internal_elem, elem);                                                                       \
+            z_result_t ret = collection_push_f(&internal_elem, &_Z_RC_IN_VAL(handler)->collection,                   \
+                                               _z_##handler_name##_elem_free);                                       \
             if (ret != _Z_RES_OK) {                                                                                  \
                 _Z_ERROR("%s failed: %i", #collection_push_f, ret);                                                  \
             }                                                                                                        \
@@ -88,7 +84,7 @@ extern "C" {
             _Z_ERROR_RETURN(_Z_ERR_INVALID);                                                                         \
         }                                                                                                            \
         _z_##handler_name##_t h;                                                                                     \
-        _Z_RETURN_IF_ERR(collection_new_f(&h.collection, capacity));                                                 \
+        _Z_RETURN_IF_ERR(collection_new_f(&h.collection, capacity, sizeof(elem_owned_type)));                        \
         handler->_rc = _z_##handler_name##_rc_new_from_val(&h);                                                      \
         if (_Z_RC_IS_NULL(&handler->_rc)) {                                                                          \
             _z_##handler_name##_clear(&h);                                                                           \
@@ -195,6 +191,11 @@ _Z_CHANNEL_DEFINE(sample, ring)
 //   z_owned_fifo_handler_sample_t/z_loaned_fifo_handler_sample_t
 _Z_CHANNEL_DEFINE(sample, fifo)
 
+// This macro defines:
+//   z_spsc_channel_sample_new()
+//   z_owned_spsc_handler_sample_t/z_loaned_spsc_handler_sample_t
+_Z_CHANNEL_DEFINE(sample, spsc)
+
 #if Z_FEATURE_QUERYABLE == 1
 // This macro defines:
 //   z_ring_channel_query_new()
@@ -205,9 +206,15 @@ _Z_CHANNEL_DEFINE(query, ring)
 //   z_fifo_channel_query_new()
 //   z_owned_fifo_handler_query_t/z_loaned_fifo_handler_query_t
 _Z_CHANNEL_DEFINE(query, fifo)
+
+// This macro defines:
+//   z_spsc_channel_query_new()
+//   z_owned_spsc_handler_query_t/z_loaned_spsc_handler_query_t
+_Z_CHANNEL_DEFINE(query, spsc)
 #else   // Z_FEATURE_QUERYABLE
 _Z_CHANNEL_DEFINE_DUMMY(query, ring)
 _Z_CHANNEL_DEFINE_DUMMY(query, fifo)
+_Z_CHANNEL_DEFINE_DUMMY(query, spsc)
 #endif  // Z_FEATURE_QUERYABLE
 
 #if Z_FEATURE_QUERY == 1
@@ -220,9 +227,15 @@ _Z_CHANNEL_DEFINE(reply, ring)
 //   z_fifo_channel_reply_new()
 //   z_owned_fifo_handler_reply_t/z_loaned_fifo_handler_reply_t
 _Z_CHANNEL_DEFINE(reply, fifo)
+
+// This macro defines:
+//   z_spsc_channel_reply_new()
+//   z_owned_spsc_handler_reply_t/z_loaned_spsc_handler_reply_t
+_Z_CHANNEL_DEFINE(reply, spsc)
 #else   // Z_FEATURE_QUERY
 _Z_CHANNEL_DEFINE_DUMMY(reply, ring)
 _Z_CHANNEL_DEFINE_DUMMY(reply, fifo)
+_Z_CHANNEL_DEFINE_DUMMY(reply, spsc)
 #endif  // Z_FEATURE_QUERY
 
 #ifdef __cplusplus
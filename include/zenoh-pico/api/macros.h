@@ -73,6 +73,9 @@
                   z_owned_ring_handler_query_t : z_ring_handler_query_loan,            \
                   z_owned_ring_handler_reply_t : z_ring_handler_reply_loan,            \
                   z_owned_ring_handler_sample_t : z_ring_handler_sample_loan,          \
+                  z_owned_spsc_handler_query_t : z_spsc_handler_query_loan,            \
+                  z_owned_spsc_handler_reply_t : z_spsc_handler_reply_loan,            \
+                  z_owned_spsc_handler_sample_t : z_spsc_handler_sample_loan,          \
                   z_owned_reply_err_t : z_reply_err_loan,                              \
                   z_owned_closure_sample_t : z_closure_sample_loan,                    \
                   z_owned_closure_reply_t : z_closure_reply_loan,                      \
@@ -164,6 +167,9 @@
                   z_moved_ring_handler_query_t* : z_ring_handler_query_drop,           \
                   z_moved_ring_handler_reply_t* : z_ring_handler_reply_drop,           \
                   z_moved_ring_handler_sample_t* : z_ring_handler_sample_drop,         \
+                  z_moved_spsc_handler_query_t* : z_spsc_handler_query_drop,           \
+                  z_moved_spsc_handler_reply_t* : z_spsc_handler_reply_drop,           \
+                  z_moved_spsc_handler_sample_t* : z_spsc_handler_sample_drop,         \
                   z_moved_reply_err_t* : z_reply_err_drop,                             \
                   ze_moved_serializer_t* : ze_serializer_drop,                         \
                   z_moved_bytes_writer_t* : z_bytes_writer_drop,                       \
@@ -239,7 +245,10 @@
         const z_loaned_fifo_handler_sample_t* : z_fifo_handler_sample_try_recv, \
         const z_loaned_ring_handler_query_t* : z_ring_handler_query_try_recv, \
         const z_loaned_ring_handler_reply_t* : z_ring_handler_reply_try_recv, \
-        const z_loaned_ring_handler_sample_t* : z_ring_handler_sample_try_recv \
+        const z_loaned_ring_handler_sample_t* : z_ring_handler_sample_try_recv, \
+        const z_loaned_spsc_handler_query_t* : z_spsc_handler_query_try_recv, \
+        const z_loaned_spsc_handler_reply_t* : z_spsc_handler_reply_try_recv, \
+        const z_loaned_spsc_handler_sample_t* : z_spsc_handler_sample_try_recv \
     )(x, __VA_ARGS__)
 
 #define z_recv(x, ...) \
@@ -249,7 +258,10 @@
         const z_loaned_fifo_handler_sample_t* : z_fifo_handler_sample_recv, \
         const z_loaned_ring_handler_query_t* : z_ring_handler_query_recv, \
         const z_loaned_ring_handler_reply_t* : z_ring_handler_reply_recv, \
-        const z_loaned_ring_handler_sample_t* : z_ring_handler_sample_recv \
+        const z_loaned_ring_handler_sample_t* : z_ring_handler_sample_recv, \
+        const z_loaned_spsc_handler_query_t* : z_spsc_handler_query_recv, \
+        const z_loaned_spsc_handler_reply_t* : z_spsc_handler_reply_recv, \
+        const z_loaned_spsc_handler_sample_t* : z_spsc_handler_sample_recv \
     )(x, __VA_ARGS__)
 
 /**
@@ -297,6 +309,9 @@
                   z_owned_ring_handler_query_t : z_ring_handler_query_move,             \
                   z_owned_ring_handler_reply_t : z_ring_handler_reply_move,             \
                   z_owned_ring_handler_sample_t : z_ring_handler_sample_move,           \
+                  z_owned_spsc_handler_query_t : z_spsc_handler_query_move,             \
+                  z_owned_spsc_handler_reply_t : z_spsc_handler_reply_move,             \
+                  z_owned_spsc_handler_sample_t : z_spsc_handler_sample_move,           \
                   z_owned_fifo_handler_query_t : z_fifo_handler_query_move,             \
                   z_owned_fifo_handler_reply_t : z_fifo_handler_reply_move,             \
                   z_owned_fifo_handler_sample_t : z_fifo_handler_sample_move,           \
@@ -348,6 +363,9 @@
         z_owned_ring_handler_query_t *: z_ring_handler_query_take,             \
         z_owned_ring_handler_reply_t *: z_ring_handler_reply_take,             \
         z_owned_ring_handler_sample_t *: z_ring_handler_sample_take,           \
+        z_owned_spsc_handler_query_t *: z_spsc_handler_query_take,             \
+        z_owned_spsc_handler_reply_t *: z_spsc_handler_reply_take,             \
+        z_owned_spsc_handler_sample_t *: z_spsc_handler_sample_take,           \
         z_owned_sample_t *: z_sample_take,                                     \
         z_owned_source_info_t *: z_source_info_take,                           \
         z_owned_session_t *: z_session_take,                                   \
@@ -526,6 +544,9 @@ inline const z_loaned_fifo_handler_sample_t* z_loan(const z_owned_fifo_handler_s
 inline const z_loaned_ring_handler_query_t* z_loan(const z_owned_ring_handler_query_t& x) { return z_ring_handler_query_loan(&x); }
 inline const z_loaned_ring_handler_reply_t* z_loan(const z_owned_ring_handler_reply_t& x) { return z_ring_handler_reply_loan(&x); }
 inline const z_loaned_ring_handler_sample_t* z_loan(const z_owned_ring_handler_sample_t& x) { return z_ring_handler_sample_loan(&x); }
+inline const z_loaned_spsc_handler_query_t* z_loan(const z_owned_spsc_handler_query_t& x) { return z_spsc_handler_query_loan(&x); }
+inline const z_loaned_spsc_handler_reply_t* z_loan(const z_owned_spsc_handler_reply_t& x) { return z_spsc_handler_reply_loan(&x); }
+inline const z_loaned_spsc_handler_sample_t* z_loan(const z_owned_spsc_handler_sample_t& x) { return z_spsc_handler_sample_loan(&x); }
 inline const z_loaned_bytes_writer_t* z_loan(const z_owned_bytes_writer_t& x) { return z_bytes_writer_loan(&x); }
 inline const ze_loaned_serializer_t* z_loan(const ze_owned_serializer_t& x) { return ze_serializer_loan(&x); }
 inline const z_loaned_cancellation_token_t* z_loan(const z_owned_cancellation_token_t& x) { return z_cancellation_token_loan(&x); }
@@ -598,10 +619,13 @@ inline void z_drop(z_moved_closure_zid_t* v) { z_closure_zid_drop(v); }
 inline void z_drop(z_moved_closure_matching_status_t* v) { z_closure_matching_status_drop(v); }
 inline void z_drop(ze_moved_closure_miss_t* v) { ze_closure_miss_drop(v); }
 inline void z_drop(z_moved_ring_handler_sample_t* v) { z_ring_handler_sample_drop(v); }
+inline void z_drop(z_moved_spsc_handler_sample_t* v) { z_spsc_handler_sample_drop(v); }
 inline void z_drop(z_moved_fifo_handler_sample_t* v) { z_fifo_handler_sample_drop(v); }
 inline void z_drop(z_moved_ring_handler_query_t* v) { z_ring_handler_query_drop(v); }
+inline void z_drop(z_moved_spsc_handler_query_t* v) { z_spsc_handler_query_drop(v); }
 inline void z_drop(z_moved_fifo_handler_query_t* v) { z_fifo_handler_query_drop(v); }
 inline void z_drop(z_moved_ring_handler_reply_t* v) { z_ring_handler_reply_drop(v); }
+inline void z_drop(z_moved_spsc_handler_reply_t* v) { z_spsc_handler_reply_drop(v); }
 inline void z_drop(z_moved_fifo_handler_reply_t* v) { z_fifo_handler_reply_drop(v); }
 inline void z_drop(z_moved_bytes_writer_t* v) { z_bytes_writer_drop(v); }
 inline void z_drop(ze_moved_serializer_t* v) { ze_serializer_drop(v); }
@@ -639,6 +663,9 @@ inline void z_internal_null(ze_owned_closure_miss_t* v) { ze_internal_closure_mi
 inline void z_internal_null(z_owned_ring_handler_query_t* v) { return z_internal_ring_handler_query_null(v); }
 inline void z_internal_null(z_owned_ring_handler_reply_t* v) { return z_internal_ring_handler_reply_null(v); }
 inline void z_internal_null(z_owned_ring_handler_sample_t* v) { return z_internal_ring_handler_sample_null(v); }
+inline void z_internal_null(z_owned_spsc_handler_query_t* v) { return z_internal_spsc_handler_query_null(v); }
+inline void z_internal_null(z_owned_spsc_handler_reply_t* v) { return z_internal_spsc_handler_reply_null(v); }
+inline void z_internal_null(z_owned_spsc_handler_sample_t* v) { return z_internal_spsc_handler_sample_null(v); }
 inline void z_internal_null(z_owned_fifo_handler_query_t* v) { return z_internal_fifo_handler_query_null(v); }
 inline void z_internal_null(z_owned_fifo_handler_reply_t* v) { return z_internal_fifo_handler_reply_null(v); }
 inline void z_internal_null(z_owned_fifo_handler_sample_t* v) { return z_internal_fifo_handler_sample_null(v); }
@@ -674,6 +701,9 @@ inline bool z_internal_check(const z_owned_fifo_handler_sample_t& v) { return z_
 inline bool z_internal_check(const z_owned_ring_handler_query_t& v) { return z_internal_ring_handler_query_check(&v); }
 inline bool z_internal_check(const z_owned_ring_handler_reply_t& v) { return z_internal_ring_handler_reply_check(&v); }
 inline bool z_internal_check(const z_owned_ring_handler_sample_t& v) { return z_internal_ring_handler_sample_check(&v); }
+inline bool z_internal_check(const z_owned_spsc_handler_query_t& v) { return z_internal_spsc_handler_query_check(&v); }
+inline bool z_internal_check(const z_owned_spsc_handler_reply_t& v) { return z_internal_spsc_handler_reply_check(&v); }
+inline bool z_internal_check(const z_owned_spsc_handler_sample_t& v) { return z_internal_spsc_handler_sample_check(&v); }
 inline bool z_internal_check(const z_owned_bytes_writer_t& v) { return z_internal_bytes_writer_check(&v); }
 inline bool z_internal_check(const ze_owned_serializer_t& v) { return ze_internal_serializer_check(&v); }
 inline bool z_internal_check(const z_owned_cancellation_token_t& v) { return z_internal_cancellation_token_check(&v); }
@@ -770,12 +800,21 @@ inline z_result_t z_try_recv(const z_loaned_fifo_handler_sample_t* this_, z_owne
 inline z_result_t z_try_recv(const z_loaned_ring_handler_query_t* this_, z_owned_query_t* query) {
     return z_ring_handler_query_try_recv(this_, query);
 }
+inline z_result_t z_try_recv(const z_loaned_spsc_handler_query_t* this_, z_owned_query_t* query) {
+    return z_spsc_handler_query_try_recv(this_, query);
+}
 inline z_result_t z_try_recv(const z_loaned_ring_handler_reply_t* this_, z_owned_reply_t* reply) {
     return z_ring_handler_reply_try_recv(this_, reply);
 }
+inline z_result_t z_try_recv(const z_loaned_spsc_handler_reply_t* this_, z_owned_reply_t* reply) {
+    return z_spsc_handler_reply_try_recv(this_, reply);
+}
 inline z_result_t z_try_recv(const z_loaned_ring_handler_sample_t* this_, z_owned_sample_t* sample) {
     return z_ring_handler_sample_try_recv(this_, sample);
 }
+inline z_result_t z_try_recv(const z_loaned_spsc_handler_sample_t* this_, z_owned_sample_t* sample) {
+    return z_spsc_handler_sample_try_recv(this_, sample);
+}
 
 
 inline z_result_t z_recv(const z_loaned_fifo_handler_query_t* this_, z_owned_query_t* query) {
@@ -790,12 +829,21 @@ inline z_result_t z_recv(const z_loaned_fifo_handler_sample_t* this_, z_owned_sa
 inline z_result_t z_recv(const z_loaned_ring_handler_query_t* this_, z_owned_query_t* query) {
     return z_ring_handler_query_recv(this_, query);
 }
+inline z_result_t z_recv(const z_loaned_spsc_handler_query_t* this_, z_owned_query_t* query) {
+    return z_spsc_handler_query_recv(this_, query);
+}
 inline z_result_t z_recv(const z_loaned_ring_handler_reply_t* this_, z_owned_reply_t* reply) {
     return z_ring_handler_reply_recv(this_, reply);
 }
+inline z_result_t z_recv(const z_loaned_spsc_handler_reply_t* this_, z_owned_reply_t* reply) {
+    return z_spsc_handler_reply_recv(this_, reply);
+}
 inline z_result_t z_recv(const z_loaned_ring_handler_sample_t* this_, z_owned_sample_t* sample) {
     return z_ring_handler_sample_recv(this_, sample);
 }
+inline z_result_t z_recv(const z_loaned_spsc_handler_sample_t* this_, z_owned_sample_t* sample) {
+    return z_spsc_handler_sample_recv(this_, sample);
+}
 
 // clang-format on
 
@@ -844,9 +892,14 @@ inline z_moved_fifo_handler_sample_t* z_move(z_owned_fifo_handler_sample_t& x) {
 }
 inline z_moved_ring_handler_query_t* z_move(z_owned_ring_handler_query_t& x) { return z_ring_handler_query_move(&x); }
 inline z_moved_ring_handler_reply_t* z_move(z_owned_ring_handler_reply_t& x) { return z_ring_handler_reply_move(&x); }
+inline z_moved_spsc_handler_query_t* z_move(z_owned_spsc_handler_query_t& x) { return z_spsc_handler_query_move(&x); }
+inline z_moved_spsc_handler_reply_t* z_move(z_owned_spsc_handler_reply_t& x) { return z_spsc_handler_reply_move(&x); }
 inline z_moved_ring_handler_sample_t* z_move(z_owned_ring_handler_sample_t& x) {
     return z_ring_handler_sample_move(&x);
 }
+inline z_moved_spsc_handler_sample_t* z_move(z_owned_spsc_handler_sample_t& x) {
+    return z_spsc_handler_sample_move(&x);
+}
 inline z_moved_bytes_writer_t* z_move(z_owned_bytes_writer_t& x) { return z_bytes_writer_move(&x); }
 inline ze_moved_serializer_t* z_move(ze_owned_serializer_t& x) { return ze_serializer_move(&x); }
 inline z_moved_cancellation_token_t* z_move(z_owned_cancellation_token_t& x) { return z_cancellation_token_move(&x); }
@@ -899,18 +952,27 @@ inline void z_take(ze_owned_closure_miss_t* this_, ze_moved_closure_miss_t* v) {
 inline void z_take(z_owned_ring_handler_sample_t* this_, z_moved_ring_handler_sample_t* v) {
     z_ring_handler_sample_take(this_, v);
 }
+inline void z_take(z_owned_spsc_handler_sample_t* this_, z_moved_spsc_handler_sample_t* v) {
+    z_spsc_handler_sample_take(this_, v);
+}
 inline void z_take(z_owned_fifo_handler_sample_t* this_, z_moved_fifo_handler_sample_t* v) {
     z_fifo_handler_sample_take(this_, v);
 }
 inline void z_take(z_owned_ring_handler_query_t* this_, z_moved_ring_handler_query_t* v) {
     z_ring_handler_query_take(this_, v);
 }
+inline void z_take(z_owned_spsc_handler_query_t* this_, z_moved_spsc_handler_query_t* v) {
+    z_spsc_handler_query_take(this_, v);
+}
 inline void z_take(z_owned_fifo_handler_query_t* this_, z_moved_fifo_handler_query_t* v) {
     z_fifo_handler_query_take(this_, v);
 }
 inline void z_take(z_owned_ring_handler_reply_t* this_, z_moved_ring_handler_reply_t* v) {
     z_ring_handler_reply_take(this_, v);
 }
+inline void z_take(z_owned_spsc_handler_reply_t* this_, z_moved_spsc_handler_reply_t* v) {
+    z_spsc_handler_reply_take(this_, v);
+}
 inline void z_take(z_owned_fifo_handler_reply_t* this_, z_moved_fifo_handler_reply_t* v) {
     z_fifo_handler_reply_take(this_, v);
 }
@@ -1265,26 +1327,50 @@ struct z_loaned_to_owned_type_t<z_loaned_ring_handler_query_t> {
     typedef z_owned_ring_handler_query_t type;
 };
 template <>
+struct z_loaned_to_owned_type_t<z_loaned_spsc_handler_query_t> {
+    typedef z_owned_spsc_handler_query_t type;
+};
+template <>
 struct z_owned_to_loaned_type_t<z_owned_ring_handler_query_t> {
     typedef z_loaned_ring_handler_query_t type;
 };
 template <>
+struct z_owned_to_loaned_type_t<z_owned_spsc_handler_query_t> {
+    typedef z_loaned_spsc_handler_query_t type;
+};
+template <>
 struct z_loaned_to_owned_type_t<z_loaned_ring_handler_reply_t> {
     typedef z_owned_ring_handler_reply_t type;
 };
 template <>
+struct z_loaned_to_owned_type_t<z_loaned_spsc_handler_reply_t> {
+    typedef z_owned_spsc_handler_reply_t type;
+};
+template <>
 struct z_owned_to_loaned_type_t<z_owned_ring_handler_reply_t> {
     typedef z_loaned_ring_handler_reply_t type;
 };
 template <>
+struct z_owned_to_loaned_type_t<z_owned_spsc_handler_reply_t> {
+    typedef z_loaned_spsc_handler_reply_t type;
+};
+template <>
 struct z_loaned_to_owned_type_t<z_loaned_ring_handler_sample_t> {
     typedef z_owned_ring_handler_sample_t type;
 };
 template <>
+struct z_loaned_to_owned_type_t<z_loaned_spsc_handler_sample_t> {
+    typedef z_owned_spsc_handler_sample_t type;
+};
+template <>
 struct z_owned_to_loaned_type_t<z_owned_ring_handler_sample_t> {
     typedef z_loaned_ring_handler_sample_t type;
 };
 template <>
+struct z_owned_to_loaned_type_t<z_owned_spsc_handler_sample_t> {
+    typedef z_loaned_spsc_handler_sample_t type;
+};
+template <>
 struct z_loaned_to_owned_type_t<z_loaned_bytes_writer_t> {
     typedef z_owned_bytes_writer_t type;
 };
@@ -906,6 +906,39 @@ z_result_t z_bytes_writer_write_all(z_loaned_bytes_writer_t *writer, const uint8
  */
 z_result_t z_bytes_writer_append(z_loaned_bytes_writer_t *writer, z_moved_bytes_t *bytes);
 
+#if Z_FEATURE_SHM == 1
+/**
+ * Constructs a shared memory provider, creating a segment of ``size`` bytes the payloads it allocates are taken from.
+ * Payloads of at least ``Z_SHM_THRESHOLD`` bytes allocated by a provider are sent by reference to the peers of the
+ * same host, and copied to the others.
+ *
+ * Parameters:
+ *   provider: An uninitialized memory location where provider is to be constructed.
+ *   size: The size of the segment.
+ *
+ * Return:
+ *   ``0`` in case of success, ``negative value`` otherwise.
+ */
+z_result_t z_shm_provider_new(z_owned_shm_provider_t *provider, size_t size);
+
+/**
+ * Allocates a payload of ``len`` bytes in shared memory. Its data must be written before the payload is sent, and
+ * remains valid until the payload is dropped. The segment of the provider stays mapped until the provider and all the
+ * payloads it allocated are dropped.
+ *
+ * Parameters:
+ *   provider: Pointer to a :c:type:`z_loaned_shm_provider_t` to allocate from.
+ *   len: The number of bytes to allocate.
+ *   bytes: An uninitialized memory location where the payload is to be constructed.
+ *   data: Set to the start of the payload data.
+ *
+ * Return:
+ *   ``0`` in case of success, ``_Z_ERR_SYSTEM_OUT_OF_MEMORY`` if the segment is full, ``negative value`` otherwise.
+ */
+z_result_t z_shm_provider_alloc(const z_loaned_shm_provider_t *provider, size_t len, z_owned_bytes_t *bytes,
+                                uint8_t **data);
+#endif
+
 /**
  * Create timestamp.
  *
@@ -1325,6 +1358,9 @@ _Z_OWNED_FUNCTIONS_DEF(query)
 _Z_OWNED_FUNCTIONS_DEF(slice)
 _Z_OWNED_FUNCTIONS_DEF(bytes)
 _Z_OWNED_FUNCTIONS_NO_COPY_DEF(bytes_writer)
+#if Z_FEATURE_SHM == 1
+_Z_OWNED_FUNCTIONS_NO_COPY_DEF(shm_provider)
+#endif
 _Z_OWNED_FUNCTIONS_DEF(reply_err)
 _Z_OWNED_FUNCTIONS_DEF(encoding)
 
@@ -2635,7 +2671,8 @@ void zp_task_read_options_default(zp_task_read_options_t *options);
  * Starts a task to read from the network and process the received messages.
  *
  * Note that the task can be implemented in form of thread, process, etc. and its implementation is
- * platform-dependent.
+ * platform-dependent. If the config enables the transmission queue, its writer task is started as well, with the same
+ * task attributes.
  *
  * Parameters:
  *   zs: Pointer to a :c:type:`z_loaned_session_t` to start the task from.
@@ -2697,6 +2734,22 @@ z_result_t zp_start_lease_task(z_loaned_session_t *zs, const zp_task_lease_optio
  */
 z_result_t zp_stop_lease_task(z_loaned_session_t *zs);
 
+#ifdef Z_FEATURE_UNSTABLE_API
+/**
+ * Gets the state of the transmission queue of a session opened with ``Z_CONFIG_TX_QUEUE_KEY`` set to ``true``.
+ *
+ * Parameters:
+ *   zs: Pointer to a :c:type:`z_loaned_session_t` to get the queue state from.
+ *   stats: Pointer to an uninitialized :c:type:`zp_tx_queue_stats_t` to fill.
+ *
+ * Return:
+ *   ``0`` if the session has a transmission queue, ``negative value`` otherwise.
+ *
+ * .. warning:: This API has been marked as unstable: it works as advertised, but it may be changed in a future release.
+ */
+z_result_t zp_tx_queue_stats(const z_loaned_session_t *zs, zp_tx_queue_stats_t *stats);
+#endif
+
 /************* Single Thread helpers **************/
 /**
  * Builds a :c:type:`zp_read_options_t` with default value.
@@ -73,6 +73,13 @@ _Z_OWNED_TYPE_VALUE(_z_bytes_t, bytes)
  */
 _Z_OWNED_TYPE_VALUE(_z_bytes_writer_t, bytes_writer)
 
+#if Z_FEATURE_SHM == 1
+/**
+ * Represents a provider allocating payloads in shared memory, sent by reference to the peers of the same host.
+ */
+_Z_OWNED_TYPE_VALUE(_z_shm_provider_t, shm_provider)
+#endif
+
 /**
  * A reader for data.
  */
@@ -465,10 +472,16 @@ typedef struct {
 
 /**
  * Represents the configuration used to configure a read task started via :c:func:`zp_start_read_task`.
+ *
+ * Members:
+ *   z_task_attr_t *task_attributes: The attributes of the task.
+ *   uint8_t worker_count: The number of tasks reading the peers of a unicast transport in peer mode, peers being spread
+ *     across them. Only used on platforms with socket event sets (Linux), a single task reads them otherwise.
  */
 typedef struct {
 #if Z_FEATURE_MULTI_THREAD == 1
     z_task_attr_t *task_attributes;
+    uint8_t worker_count;
 #else
     uint8_t __dummy;  // Just to avoid empty structures that might cause undefined behavior
 #endif
@@ -520,6 +533,20 @@ typedef struct {
     uint8_t __dummy;  // Just to avoid empty structures that might cause undefined behavior
 } zp_send_join_options_t;
 
+#ifdef Z_FEATURE_UNSTABLE_API
+/**
+ * Represents the state of the transmission queue of a session, see :c:func:`zp_tx_queue_stats`.
+ *
+ * Members:
+ *   size_t depth: Number of messages waiting to be sent.
+ *   uint64_t dropped: Number of messages dropped by congestion control since the transport was opened.
+ */
+typedef struct {
+    size_t depth;
+    uint64_t dropped;
+} zp_tx_queue_stats_t;
+#endif
+
 /**
  * Represents the configuration used to configure a publisher upon declaration with :c:func:`z_declare_publisher`.
  *
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+#ifndef ZENOH_PICO_COLLECTIONS_ARENA_H
+#define ZENOH_PICO_COLLECTIONS_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A bump allocator for data that doesn't outlive a given scope. Allocations are never freed one by one, the whole
+ * arena is reset at once. Its buffer is only allocated on first use.
+ *
+ * Members:
+ *   uint8_t *_buf: the arena memory, NULL until the first allocation
+ *   size_t _capacity: the size of the arena memory, in bytes
+ *   size_t _len: the number of bytes already handed out
+ */
+typedef struct {
+    uint8_t *_buf;
+    size_t _capacity;
+    size_t _len;
+} _z_arena_t;
+
+static inline _z_arena_t _z_arena_null(void) { return (_z_arena_t){0}; }
+static inline _z_arena_t _z_arena_make(size_t capacity) {
+    _z_arena_t arena = {0};
+    arena._capacity = capacity;
+    return arena;
+}
+static inline size_t _z_arena_len(const _z_arena_t *arena) { return arena->_len; }
+// Makes all the memory handed out available again, what was allocated in it must not be used anymore
+static inline void _z_arena_reset(_z_arena_t *arena) { arena->_len = 0; }
+
+// Returns size bytes aligned on 8 bytes, or NULL if the arena has no room left for them
+void *_z_arena_alloc(_z_arena_t *arena, size_t size);
+void _z_arena_clear(_z_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_COLLECTIONS_ARENA_H */
@@ -27,6 +27,9 @@ extern "C" {
 /*-------- Fifo Buffer Multithreaded --------*/
 typedef struct {
     _z_fifo_t _fifo;
+    // Elements are stored inline, one slot per fifo position
+    uint8_t *_slots;
+    size_t _elem_size;
     bool is_closed;
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_t _mutex;
@@ -35,8 +38,8 @@ typedef struct {
 #endif
 } _z_fifo_mt_t;
 
-z_result_t _z_fifo_mt_init(_z_fifo_mt_t *fifo, size_t capacity);
-_z_fifo_mt_t *_z_fifo_mt_new(size_t capacity);
+z_result_t _z_fifo_mt_init(_z_fifo_mt_t *fifo, size_t capacity, size_t elem_size);
+_z_fifo_mt_t *_z_fifo_mt_new(size_t capacity, size_t elem_size);
 
 z_result_t _z_fifo_mt_close(_z_fifo_mt_t *fifo);
 void _z_fifo_mt_clear(_z_fifo_mt_t *fifo, z_element_free_f free_f);
@@ -42,42 +42,66 @@ typedef struct {
 } _z_hashmap_entry_t;
 
 /**
- * A hashmap with generic keys.
+ * A slot of a hashmap.
  *
  * Members:
- *    size_t _capacity: the number of buckets available in the hashmap
- *   _z_list_t **_vals: the linked list containing the values
+ *   size_t _hash: the hash of the entry key
+ *   _z_hashmap_entry_t *_entry: the entry stored in the slot, NULL when the slot is free
+ */
+typedef struct {
+    size_t _hash;
+    _z_hashmap_entry_t *_entry;
+} _z_hashmap_slot_t;
+
+/**
+ * A hashmap with generic keys, using open addressing with Robin Hood linear probing. Entries are kept sorted by
+ * distance to their home slot so that lookups stop as soon as they are further than the probed entry, and removals
+ * shift the following entries back instead of leaving tombstones. The slots are allocated on the first insertion and
+ * doubled when the load factor reaches 3/4.
+ *
+ * Members:
+ *   size_t _capacity: the number of slots of the hashmap, a power of 2
+ *   size_t _len: the number of entries in the hashmap
+ *   _z_hashmap_slot_t *_vals: the slots containing the entries
  *   z_element_hash_f _f_hash: the hash function used to hash keys
  *   z_element_eq_f _f_equals: the function used to compare keys for equality
  */
 typedef struct {
     size_t _capacity;
-    _z_list_t **_vals;
+    size_t _len;
+    _z_hashmap_slot_t *_vals;
     z_element_hash_f _f_hash;
     z_element_eq_f _f_equals;
 } _z_hashmap_t;
 
 /**
- * Iterator for a generic key-value hashmap.
+ * Iterator for a generic key-value hashmap. The entry last returned by the iterator may be removed while iterating,
+ * no other entry may be inserted or removed.
  */
 typedef struct {
     _z_hashmap_entry_t *_entry;
     const _z_hashmap_t *_map;
+    size_t _start;
     size_t _idx;
-    _z_list_t *_list_ptr;
 } _z_hashmap_iterator_t;
 
 void _z_hashmap_init(_z_hashmap_t *map, size_t capacity, z_element_hash_f f_hash, z_element_eq_f f_equals);
 _z_hashmap_t _z_hashmap_make(size_t capacity, z_element_hash_f f_hash, z_element_eq_f f_equals);
 
+// Returns v, or NULL if the entry couldn't be allocated. Without replace, the entry shadows the ones of the same key.
 void *_z_hashmap_insert(_z_hashmap_t *map, void *key, void *val, z_element_free_f f, bool replace);
 void *_z_hashmap_get(const _z_hashmap_t *map, const void *key);
+// Returns a list of the entries of key, latest inserted first, to be freed with _z_list_free(&l, _z_noop_free)
 _z_list_t *_z_hashmap_get_all(const _z_hashmap_t *map, const void *key);
 void _z_hashmap_remove(_z_hashmap_t *map, const void *key, z_element_free_f f);
+void _z_hashmap_remove_filter(_z_hashmap_t *map, const void *key, z_element_eq_f f_equals, z_element_free_f f);
+
+// Moves the entries to at least capacity slots, the map is left untouched if the new slots can't be allocated
+z_result_t _z_hashmap_rehash(_z_hashmap_t *map, size_t capacity);
 
 size_t _z_hashmap_capacity(const _z_hashmap_t *map);
-size_t _z_hashmap_len(const _z_hashmap_t *map);
-bool _z_hashmap_is_empty(const _z_hashmap_t *map);
+static inline size_t _z_hashmap_len(const _z_hashmap_t *map) { return map->_len; }
+static inline bool _z_hashmap_is_empty(const _z_hashmap_t *map) { return map->_len == (size_t)0; }
 
 z_result_t _z_hashmap_copy(_z_hashmap_t *dst, const _z_hashmap_t *src, z_element_clone_f f_c);
 _z_hashmap_t _z_hashmap_clone(const _z_hashmap_t *src, z_element_clone_f f_c, z_element_free_f f_f);
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_COLLECTIONS_KEYEXPR_TREE_H
+#define ZENOH_PICO_COLLECTIONS_KEYEXPR_TREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/hashmap.h"
+#include "zenoh-pico/collections/list.h"
+#include "zenoh-pico/collections/rcu.h"
+#include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/utils/result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define _Z_KEYEXPR_TREE_NODE_CAPACITY 8
+
+enum _z_keyexpr_tree_chunk_e {
+    _Z_KEYEXPR_TREE_CHUNK_VERBATIM = 0,
+    _Z_KEYEXPR_TREE_CHUNK_WILD = 1,         // '*' or chunk containing '$*'
+    _Z_KEYEXPR_TREE_CHUNK_DOUBLE_WILD = 2,  // '**'
+};
+
+/**
+ * A key expression tree node, holding one chunk of the key expressions stored below it.
+ *
+ * Members:
+ *   _z_string_t _chunk: the chunk of the node
+ *   _z_hashmap_t _verbatim: the children with a verbatim chunk, indexed by chunk
+ *   _z_list_t *_wilds: the children with a wildcard chunk
+ *   _z_list_t *_values: the values stored for the key expression ending at this node
+ */
+typedef struct _z_keyexpr_tree_node_t {
+    _z_string_t _chunk;
+    struct _z_keyexpr_tree_node_t *_parent;
+    _z_hashmap_t _verbatim;
+    _z_list_t *_wilds;
+    _z_list_t *_values;
+    uint8_t _kind;
+} _z_keyexpr_tree_node_t;
+
+/**
+ * A tree of key expressions split in chunks, used to find the values whose key expression intersects a given key
+ * expression in time proportional to its depth rather than to the number of stored values.
+ * Values are not owned by the tree. Lookups don't modify the tree, so they can run concurrently with each other.
+ */
+typedef struct {
+    _z_keyexpr_tree_node_t *_root;
+    size_t _len;
+} _z_keyexpr_tree_t;
+
+// Called once per candidate value, candidates are a superset of the intersecting values
+typedef void (*_z_keyexpr_tree_visit_f)(void *val, void *ctx);
+
+void _z_keyexpr_tree_init(_z_keyexpr_tree_t *tree);
+z_result_t _z_keyexpr_tree_insert(_z_keyexpr_tree_t *tree, const _z_string_t *key, void *val);
+bool _z_keyexpr_tree_remove(_z_keyexpr_tree_t *tree, const _z_string_t *key, const void *val);
+// Removes the first value stored for key for which eq(arg, val) holds, and returns it
+void *_z_keyexpr_tree_remove_if(_z_keyexpr_tree_t *tree, const _z_string_t *key, z_element_eq_f eq,
+                                const void *arg);
+void _z_keyexpr_tree_intersect(const _z_keyexpr_tree_t *tree, const _z_string_t *key, _z_keyexpr_tree_visit_f f,
+                               void *ctx);
+static inline size_t _z_keyexpr_tree_len(const _z_keyexpr_tree_t *tree) { return tree->_len; }
+void _z_keyexpr_tree_clear(_z_keyexpr_tree_t *tree);
+
+/**
+ * A key expression tree that readers look up without locking while writers update it.
+ * It keeps two copies of the tree: readers use the one published in an rcu cell, a writer updates the other one,
+ * publishes it and applies the same update to the previous one once its readers left. An update costs the depth of its
+ * key on each copy. Writers are serialized by the tree mutex, so they can wait for the readers without holding the
+ * lock of the data the values come from. Both copies share the values, which are not owned by the tree.
+ */
+typedef struct {
+    _z_keyexpr_tree_t _trees[2];
+    _z_rcu_t _rcu;
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_t _mutex;
+#endif
+} _z_keyexpr_tree_rcu_t;
+
+z_result_t _z_keyexpr_tree_rcu_init(_z_keyexpr_tree_rcu_t *tree);
+z_result_t _z_keyexpr_tree_rcu_insert(_z_keyexpr_tree_rcu_t *tree, const _z_string_t *key, void *val);
+// Once it returns, no lookup can yield the removed value anymore
+void *_z_keyexpr_tree_rcu_remove_if(_z_keyexpr_tree_rcu_t *tree, const _z_string_t *key, z_element_eq_f eq,
+                                    const void *arg);
+// Lookups don't take the tree mutex, f must not update the tree
+void _z_keyexpr_tree_rcu_intersect(_z_keyexpr_tree_rcu_t *tree, const _z_string_t *key, _z_keyexpr_tree_visit_f f,
+                                   void *ctx);
+void _z_keyexpr_tree_rcu_clear(_z_keyexpr_tree_rcu_t *tree);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_COLLECTIONS_KEYEXPR_TREE_H */
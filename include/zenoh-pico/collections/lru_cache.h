@@ -25,38 +25,39 @@
 extern "C" {
 #endif
 
-// Three way comparison function pointer
-typedef int (*_z_lru_val_cmp_f)(const void *first, const void *second);
-
 // Node struct: {node_data; generic type}
 typedef void _z_lru_cache_node_t;
 
 /*-------- Dynamically allocated vector --------*/
 /**
- * A least recently used cache implementation
+ * A least recently used cache implementation. Nodes are chained in a list by recency and indexed by the hash of their
+ * value, which is computed once on insertion, so that lookups, insertions and evictions are O(1).
  */
 typedef struct _z_lru_cache_t {
     size_t capacity;              // Max number of node
     size_t len;                   // Number of node
     _z_lru_cache_node_t *head;    // List head
     _z_lru_cache_node_t *tail;    // List tail
-    _z_lru_cache_node_t **slist;  // Sorted node list
+    _z_lru_cache_node_t **table;  // Hash table buckets, at least capacity of them
+    size_t table_mask;            // Number of buckets - 1, a power of 2 - 1
 } _z_lru_cache_t;
 
 _z_lru_cache_t _z_lru_cache_init(size_t capacity);
-void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f compare);
-z_result_t _z_lru_cache_insert(_z_lru_cache_t *cache, void *value, size_t value_size, _z_lru_val_cmp_f compare);
+void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, z_element_hash_f hash, z_element_eq_f equals);
+// Evicts and clears the least recently used value if the cache is full
+z_result_t _z_lru_cache_insert(_z_lru_cache_t *cache, void *value, size_t value_size, z_element_hash_f hash,
+                               z_element_clear_f clear);
 void _z_lru_cache_clear(_z_lru_cache_t *cache, z_element_clear_f clear);
 void _z_lru_cache_delete(_z_lru_cache_t *cache, z_element_clear_f clear);
 
-#define _Z_LRU_CACHE_DEFINE(name, type, compare_f)                                                                  \
+#define _Z_LRU_CACHE_DEFINE(name, type, hash_f, equals_f)                                                           \
     typedef _z_lru_cache_t name##_lru_cache_t;                                                                      \
     static inline name##_lru_cache_t name##_lru_cache_init(size_t capacity) { return _z_lru_cache_init(capacity); } \
     static inline type *name##_lru_cache_get(name##_lru_cache_t *cache, type *val) {                                \
-        return (type *)_z_lru_cache_get(cache, (void *)val, compare_f);                                             \
+        return (type *)_z_lru_cache_get(cache, (void *)val, hash_f, equals_f);                                      \
     }                                                                                                               \
     static inline z_result_t name##_lru_cache_insert(name##_lru_cache_t *cache, type *val) {                        \
-        return _z_lru_cache_insert(cache, (void *)val, sizeof(type), compare_f);                                    \
+        return _z_lru_cache_insert(cache, (void *)val, sizeof(type), hash_f, name##_elem_clear);                    \
     }                                                                                                               \
     static inline void name##_lru_cache_clear(name##_lru_cache_t *cache) {                                          \
         _z_lru_cache_clear(cache, name##_elem_clear);                                                               \
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+#ifndef ZENOH_PICO_COLLECTIONS_RCU_H
+#define ZENOH_PICO_COLLECTIONS_RCU_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/system/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (Z_FEATURE_MULTI_THREAD == 1) && (ZENOH_C_STANDARD != 99) && !defined(__cplusplus)
+#define _Z_RCU_ATOMIC(X) _Atomic(X)
+#else
+#define _Z_RCU_ATOMIC(X) X
+#endif
+
+/*-------- Read-Copy-Update cell --------*/
+/**
+ * Holds a pointer to an immutable value that readers access without locking while writers replace it.
+ * Readers announce themselves in the counter of the current phase, and a writer that replaced the value flips the phase
+ * and waits for the readers of the previous phases before handing back the previous value to be freed.
+ * Writers must be serialized by the caller, and read sections must not wait on a writer.
+ */
+typedef struct {
+    _Z_RCU_ATOMIC(void *) _val;
+    _Z_RCU_ATOMIC(size_t) _readers[2];
+    _Z_RCU_ATOMIC(uint8_t) _phase;
+} _z_rcu_t;
+
+void _z_rcu_init(_z_rcu_t *rcu, void *val);
+
+// Returns the current value, which stays valid until the matching _z_rcu_read_unlock
+void *_z_rcu_read_lock(_z_rcu_t *rcu, uint8_t *phase);
+void _z_rcu_read_unlock(_z_rcu_t *rcu, uint8_t phase);
+
+// Writer side, returns the current value
+void *_z_rcu_get(_z_rcu_t *rcu);
+// Writer side, publishes val and returns the previous value once no reader can access it anymore
+void *_z_rcu_swap(_z_rcu_t *rcu, void *val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ZENOH_PICO_COLLECTIONS_RCU_H
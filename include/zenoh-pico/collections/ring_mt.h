@@ -27,6 +27,9 @@ extern "C" {
 /*-------- Ring Buffer Multithreaded --------*/
 typedef struct {
     _z_ring_t _ring;
+    // Elements are stored inline, one slot per ring position
+    uint8_t *_slots;
+    size_t _elem_size;
     bool is_closed;
 #if Z_FEATURE_MULTI_THREAD == 1
     _z_mutex_t _mutex;
@@ -34,8 +37,8 @@ typedef struct {
 #endif
 } _z_ring_mt_t;
 
-z_result_t _z_ring_mt_init(_z_ring_mt_t *ring, size_t capacity);
-_z_ring_mt_t *_z_ring_mt_new(size_t capacity);
+z_result_t _z_ring_mt_init(_z_ring_mt_t *ring, size_t capacity, size_t elem_size);
+_z_ring_mt_t *_z_ring_mt_new(size_t capacity, size_t elem_size);
 z_result_t _z_ring_mt_close(_z_ring_mt_t *ring);
 
 void _z_ring_mt_clear(_z_ring_mt_t *ring, z_element_free_f free_f);
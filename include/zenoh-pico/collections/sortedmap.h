@@ -39,25 +39,39 @@ typedef struct {
     void *_val;
 } _z_sortedmap_entry_t;
 
+#define _Z_SORTEDMAP_MAX_LEVEL 16
+
+struct _z_sortedmap_node_t;
+
 /**
- * A sorted map.
+ * A sorted map, implemented as a skip list. Each node is linked on a random number of levels, each level skipping
+ * about 4 times as many nodes as the one below, so that lookups, insertions and removals are O(log n) on average.
+ * The first level links all the nodes in order, iterating and popping the first entry are O(1).
  *
  * Members:
- *   _z_list_t *_vals: a linked list containing the values
+ *   struct _z_sortedmap_node_t *_head: the node linking the first node of each level, allocated on first insertion
+ *   size_t _len: the number of entries in the map
+ *   uint32_t _seed: the state of the generator drawing the levels of the nodes
+ *   uint8_t _level: the number of levels in use
  *   z_element_cmp_f _f_cmp: the function used to compare keys
  */
 typedef struct {
-    _z_list_t *_vals;
+    struct _z_sortedmap_node_t *_head;
+    size_t _len;
+    uint32_t _seed;
+    uint8_t _level;
     z_element_cmp_f _f_cmp;
 } _z_sortedmap_t;
 
 /**
- * Iterator for a generic key-value hashmap.
+ * Iterator for a generic key-value sorted map. The entry last returned by the iterator may be removed while iterating,
+ * no other entry may be inserted or removed.
  */
 typedef struct {
     _z_sortedmap_entry_t *_entry;
     const _z_sortedmap_t *_map;
-    _z_list_t *_list_ptr;
+    struct _z_sortedmap_node_t *_node;
+    struct _z_sortedmap_node_t *_next;
     bool _initialized;
 } _z_sortedmap_iterator_t;
 
@@ -66,11 +80,12 @@ _z_sortedmap_t _z_sortedmap_make(z_element_cmp_f f_cmp);
 
 void *_z_sortedmap_insert(_z_sortedmap_t *map, void *key, void *val, z_element_free_f f, bool replace);
 void *_z_sortedmap_get(const _z_sortedmap_t *map, const void *key);
+// Unlinks the entry with the smallest key, to be freed by the caller like any entry of the map
 _z_sortedmap_entry_t *_z_sortedmap_pop_first(_z_sortedmap_t *map);
 void _z_sortedmap_remove(_z_sortedmap_t *map, const void *key, z_element_free_f f);
 
-size_t _z_sortedmap_len(const _z_sortedmap_t *map);
-bool _z_sortedmap_is_empty(const _z_sortedmap_t *map);
+static inline size_t _z_sortedmap_len(const _z_sortedmap_t *map) { return map->_len; }
+static inline bool _z_sortedmap_is_empty(const _z_sortedmap_t *map) { return map->_len == (size_t)0; }
 
 z_result_t _z_sortedmap_copy(_z_sortedmap_t *dst, const _z_sortedmap_t *src, z_element_clone_f f_c);
 _z_sortedmap_t _z_sortedmap_clone(const _z_sortedmap_t *src, z_element_clone_f f_c, z_element_free_f f_f);
@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+#ifndef ZENOH_PICO_COLLECTIONS_SPSC_MT_H
+#define ZENOH_PICO_COLLECTIONS_SPSC_MT_H
+
+#include <stdint.h>
+
+#include "zenoh-pico/collections/element.h"
+#include "zenoh-pico/system/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (Z_FEATURE_MULTI_THREAD == 1) && (ZENOH_C_STANDARD != 99) && !defined(__cplusplus)
+#define _Z_SPSC_ATOMIC(X) _Atomic X
+#else
+#define _Z_SPSC_ATOMIC(X) X
+#endif
+
+/*-------- Single Consumer Ring Buffer --------*/
+/**
+ * Bounded lock-free ring buffer for one consumer, elements are stored inline.
+ * Callbacks feeding the ring may run on several read tasks at once, so producers claim a position with a compare and
+ * swap on the head, and publish the element through the sequence number of its slot. Each slot sequence is the
+ * position it can be written at, then that position + 1 once written, so the consumer never reads a claimed slot that
+ * isn't written yet. The mutex and condvar are only used to park the consumer when the buffer is empty.
+ * When the buffer is full the pushed element is dropped, so producers never wait on the consumer.
+ */
+typedef struct {
+    uint8_t *_slots;
+    _Z_SPSC_ATOMIC(size_t) * _seqs;
+    size_t _elem_size;
+    size_t _capacity;
+    size_t _mask;
+    _Z_SPSC_ATOMIC(size_t) _head;  // Next write position, claimed by producers
+    _Z_SPSC_ATOMIC(size_t) _tail;  // Next read position, only updated by the consumer
+    _Z_SPSC_ATOMIC(uint8_t) _parked;
+    _Z_SPSC_ATOMIC(uint8_t) _is_closed;
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_t _mutex;
+    _z_condvar_t _cv_not_empty;
+#endif
+} _z_spsc_mt_t;
+
+z_result_t _z_spsc_mt_init(_z_spsc_mt_t *spsc, size_t capacity, size_t elem_size);
+_z_spsc_mt_t *_z_spsc_mt_new(size_t capacity, size_t elem_size);
+z_result_t _z_spsc_mt_close(_z_spsc_mt_t *spsc);
+
+void _z_spsc_mt_clear(_z_spsc_mt_t *spsc, z_element_free_f free_f);
+void _z_spsc_mt_free(_z_spsc_mt_t *spsc, z_element_free_f free_f);
+
+z_result_t _z_spsc_mt_push(const void *src, void *context, z_element_free_f element_free);
+
+z_result_t _z_spsc_mt_pull(void *dst, void *context, z_element_move_f element_move);
+z_result_t _z_spsc_mt_try_pull(void *dst, void *context, z_element_move_f element_move);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ZENOH_PICO_COLLECTIONS_SPSC_MT_H
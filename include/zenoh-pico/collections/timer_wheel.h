@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+#ifndef ZENOH_PICO_COLLECTIONS_TIMER_WHEEL_H
+#define ZENOH_PICO_COLLECTIONS_TIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define _Z_TIMER_WHEEL_SLOT_BITS 5
+#define _Z_TIMER_WHEEL_SLOT_NB (1 << _Z_TIMER_WHEEL_SLOT_BITS)
+#define _Z_TIMER_WHEEL_LEVEL_NB 4
+
+/**
+ * A timer, meant to be embedded in the structure it times out.
+ *
+ * Members:
+ *   _z_timer_wheel_node_t *_next: the next timer of the slot
+ *   _z_timer_wheel_node_t **_pprev: the link pointing to this timer, NULL when the timer is not scheduled
+ *   uint64_t _expiry: the tick at which the timer expires
+ */
+typedef struct _z_timer_wheel_node_t {
+    struct _z_timer_wheel_node_t *_next;
+    struct _z_timer_wheel_node_t **_pprev;
+    uint64_t _expiry;
+} _z_timer_wheel_node_t;
+
+/**
+ * A hierarchical timer wheel. Each level has _Z_TIMER_WHEEL_SLOT_NB slots covering _Z_TIMER_WHEEL_SLOT_NB times the
+ * ticks of a slot of the level below, timers are moved down a level when the wheel reaches their slot. Scheduling and
+ * cancelling a timer are O(1), and advancing the wheel only touches the timers in the slots it goes through.
+ * Timers further than the top level range are kept in its last slot and rescheduled when the wheel reaches it.
+ *
+ * Members:
+ *   _z_timer_wheel_node_t *_slots: the timers of each slot of each level
+ *   uint64_t _now: the next tick to process
+ *   size_t _len: the number of scheduled timers
+ */
+typedef struct {
+    _z_timer_wheel_node_t *_slots[_Z_TIMER_WHEEL_LEVEL_NB][_Z_TIMER_WHEEL_SLOT_NB];
+    uint64_t _now;
+    size_t _len;
+} _z_timer_wheel_t;
+
+typedef void (*_z_timer_wheel_expire_f)(_z_timer_wheel_node_t *node, void *arg);
+
+void _z_timer_wheel_init(_z_timer_wheel_t *tw, uint64_t now);
+// Forgets all the scheduled timers
+void _z_timer_wheel_clear(_z_timer_wheel_t *tw);
+
+// Schedules node to expire at tick expiry, a scheduled node is rescheduled
+void _z_timer_wheel_add(_z_timer_wheel_t *tw, _z_timer_wheel_node_t *node, uint64_t expiry);
+void _z_timer_wheel_remove(_z_timer_wheel_t *tw, _z_timer_wheel_node_t *node);
+// Calls f on every timer expiring up to tick now, each one is removed from the wheel before f is called on it
+void _z_timer_wheel_advance(_z_timer_wheel_t *tw, uint64_t now, _z_timer_wheel_expire_f f, void *arg);
+
+static inline void _z_timer_wheel_node_init(_z_timer_wheel_node_t *node) {
+    node->_next = NULL;
+    node->_pprev = NULL;
+    node->_expiry = 0;
+}
+static inline bool _z_timer_wheel_node_is_scheduled(const _z_timer_wheel_node_t *node) { return node->_pprev != NULL; }
+static inline size_t _z_timer_wheel_len(const _z_timer_wheel_t *tw) { return tw->_len; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ZENOH_PICO_COLLECTIONS_TIMER_WHEEL_H
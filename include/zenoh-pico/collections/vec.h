@@ -105,6 +105,15 @@ static inline _z_svec_t _z_svec_alias_element(void *element) {
     ret._aliased = true;
     return ret;
 }
+// Empty vector storing its elements in memory it doesn't own, it is moved to the heap if it has to grow
+static inline _z_svec_t _z_svec_alias_buf(void *val, size_t capacity) {
+    _z_svec_t ret;
+    ret._capacity = capacity;
+    ret._len = 0;
+    ret._val = val;
+    ret._aliased = true;
+    return ret;
+}
 static inline size_t _z_svec_len(const _z_svec_t *v) { return v->_len; }
 static inline bool _z_svec_is_empty(const _z_svec_t *v) { return v->_len == 0; }
 static inline void *_z_svec_get(const _z_svec_t *v, size_t i, size_t element_size) {
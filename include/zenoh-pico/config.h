@@ -64,6 +64,7 @@
 #define Z_FEATURE_UNICAST_PEER 1
 #define Z_FEATURE_AUTO_RECONNECT 1
 #define Z_FEATURE_MULTICAST_DECLARATIONS 0
+#define Z_FEATURE_SHM 0
 #define Z_FEATURE_PERIODIC_TASKS 0
 
 // End of CMake generation
@@ -157,6 +158,33 @@
 #define Z_CONFIG_ADD_TIMESTAMP_KEY 0x4A
 #define Z_CONFIG_ADD_TIMESTAMP_DEFAULT "false"
 
+/**
+ * A multicast group to join in addition to the session main transport, for example to keep a client link to a router
+ * and exchange local traffic with nearby peers at the same time.
+ * Accepted values : `<locator>` (ex: `"udp/224.0.0.225:7447#iface=eth0"`).
+ * Default value : None.
+ * Multiple values are accepted, up to Z_SESSION_MULTICAST_GROUP_NB.
+ */
+#define Z_CONFIG_MULTICAST_GROUP_KEY 0x57
+
+/**
+ * The maximum size of a message reassembled from fragments, larger messages are dropped.
+ * Accepted values : `<unsigned integer>`.
+ * Default value : Z_FRAG_MAX_SIZE.
+ */
+#define Z_CONFIG_FRAG_MAX_SIZE_KEY 0x58
+
+/**
+ * Hands network messages over to a writer task of the transport instead of sending them from the calling thread.
+ * Congestion control then applies to the depth of the queue, see Z_TX_QUEUE_SIZE. Only client and multicast transports
+ * use it, a unicast transport in peer mode sends from the calling thread. The writer task is started by
+ * zp_start_read_task, with the attributes of the read task.
+ * Accepted values : `false`, `true`.
+ * Default value : `false`.
+ */
+#define Z_CONFIG_TX_QUEUE_KEY 0x59
+#define Z_CONFIG_TX_QUEUE_DEFAULT "false"
+
 /*------------------ TLS configuration properties ------------------*/
 #define Z_CONFIG_TLS_ROOT_CA_CERTIFICATE_KEY 0x4B
 #define Z_CONFIG_TLS_ROOT_CA_CERTIFICATE_BASE64_KEY 0x4C
@@ -197,6 +225,91 @@
  */
 #define Z_RX_CACHE_SIZE 10
 
+/**
+ * Number of rx buffers kept by a transport to replace its rx buffer while a received payload still references it.
+ * Set to 0 to allocate a new buffer each time instead.
+ */
+#define Z_RX_BUFFER_POOL_SIZE 4
+
+/**
+ * Size of the arena of each peer holding the transient data of a received batch while it is dispatched, such as the
+ * expanded key expressions and the matching subscriptions of the samples, in bytes. Allocated on first use, data that
+ * doesn't fit in it is allocated on the heap. Set to 0 to always allocate this data on the heap.
+ */
+#define Z_RX_ARENA_SIZE 1024
+
+/**
+ * Reassemble fragmented messages from references to the rx buffers holding the fragments, the payload is then handed
+ * over as multiple slices. Set to 0 to copy the fragments in a buffer allocated at the maximum message size instead.
+ */
+#define Z_DEFRAG_ZERO_COPY 1
+
+/**
+ * Compute the serial link CRC32 with slice-by-8 lookup tables, 8KiB of constant data.
+ * Set to 0 to compute it bit by bit instead.
+ */
+#define Z_CRC32_SLICE_BY_8 1
+
+/**
+ * Number of reliable frames a multicast transport keeps after sending them, to retransmit those a peer reports missing.
+ * The window is advertised in joins, and as many frames received from such a peer after a missing one are held until it
+ * is retransmitted. Each one holds a copy of up to a batch. Set to 0 to disable retransmissions, reliable frames lost
+ * are then skipped.
+ */
+#define Z_MULTICAST_RETX_WINDOW_SIZE 16
+
+/**
+ * Number of encoded network messages a transport tx queue holds, see Z_CONFIG_TX_QUEUE_KEY. A full queue drops messages
+ * sent with Z_CONGESTION_CONTROL_DROP. Requires Z_FEATURE_MULTI_THREAD, set to 0 to disable tx queues.
+ */
+#define Z_TX_QUEUE_SIZE 32
+
+/**
+ * Size of the ring buffer holding the messages of a transport tx queue, in bytes. A message that doesn't fit in its
+ * free space is queued in a buffer of its own, sized to it.
+ */
+#define Z_TX_QUEUE_BUFFER_SIZE 4096
+
+/**
+ * Time a message sent with Z_CONGESTION_CONTROL_BLOCK waits for room in a full tx queue before being dropped, in
+ * milliseconds.
+ */
+#define Z_TX_QUEUE_BLOCK_TIMEOUT_MS 1000
+
+/**
+ * Number of multicast groups a session can join in addition to its main transport, see Z_CONFIG_MULTICAST_GROUP_KEY.
+ * Each one reserves a transport in the session and a session that joined groups deduplicates the samples it receives.
+ * Set to 0 to keep a single transport per session.
+ */
+#define Z_SESSION_MULTICAST_GROUP_NB 0
+
+/**
+ * Number of buckets of the hash indexes used to look up declared resources by id or by key.
+ */
+#define Z_RESOURCE_INDEX_CAPACITY 64
+
+/**
+ * Number of buckets of the hash index used to look up pending queries by id.
+ */
+#define Z_PENDING_QUERY_INDEX_CAPACITY 64
+
+/**
+ * Minimum size of a shared memory payload to send it by reference to the peers of the same host, smaller ones are
+ * copied in the message as any other payload.
+ */
+#define Z_SHM_THRESHOLD 1024
+
+/**
+ * Number of shared memory segments of other processes a session keeps mapped to receive payloads by reference.
+ */
+#define Z_SHM_SEGMENT_CACHE_SIZE 8
+
+/**
+ * Number of handles on the chunks of a shared memory provider that peers may hold at once. Payloads are copied to the
+ * peers while they are all in use.
+ */
+#define Z_SHM_HANDLE_SLOTS 256
+
 /**
  * Default get timeout in milliseconds.
  */
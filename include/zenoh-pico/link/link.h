@@ -105,7 +105,10 @@ typedef void (*_z_f_link_close)(struct _z_link_t *self);
 typedef size_t (*_z_f_link_write)(const struct _z_link_t *self, const uint8_t *ptr, size_t len,
                                   _z_sys_net_socket_t *socket);
 typedef size_t (*_z_f_link_write_all)(const struct _z_link_t *self, const uint8_t *ptr, size_t len);
+typedef size_t (*_z_f_link_write_vec)(const struct _z_link_t *self, const _z_slice_t *bufs, size_t count,
+                                      _z_sys_net_socket_t *socket);
 typedef size_t (*_z_f_link_read)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr);
+typedef size_t (*_z_f_link_read_vec)(const struct _z_link_t *self, _z_slice_t *bufs, size_t count, _z_slice_t *addrs);
 typedef size_t (*_z_f_link_read_exact)(const struct _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr,
                                        _z_sys_net_socket_t *socket);
 typedef size_t (*_z_f_link_read_socket)(const _z_sys_net_socket_t socket, uint8_t *ptr, size_t len);
@@ -161,7 +164,9 @@ typedef struct _z_link_t {
     _z_f_link_close _close_f;
     _z_f_link_write _write_f;
     _z_f_link_write_all _write_all_f;
+    _z_f_link_write_vec _write_vec_f;  // Optional gather write, NULL if not supported
     _z_f_link_read _read_f;
+    _z_f_link_read_vec _read_vec_f;  // Optional batched datagram read, NULL if not supported
     _z_f_link_read_exact _read_exact_f;
     _z_f_link_read_socket _read_socket_f;
     _z_f_link_free _free_f;
@@ -177,10 +182,17 @@ z_result_t _z_open_link(_z_link_t *zl, const _z_string_t *locator, const _z_conf
 z_result_t _z_listen_link(_z_link_t *zl, const _z_string_t *locator, const _z_config_t *session_cfg);
 
 z_result_t _z_link_send_wbuf(const _z_link_t *zl, const _z_wbuf_t *wbf, _z_sys_net_socket_t *socket);
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+// Sends the slices in a single gather write, the link must provide one
+z_result_t _z_link_send_slices(const _z_link_t *zl, const _z_slice_t *bufs, size_t count, _z_sys_net_socket_t *socket);
+#endif
 size_t _z_link_recv_zbuf(const _z_link_t *zl, _z_zbuf_t *zbf, _z_slice_t *addr);
 size_t _z_link_recv_exact_zbuf(const _z_link_t *zl, _z_zbuf_t *zbf, size_t len, _z_slice_t *addr,
                                _z_sys_net_socket_t *socket);
 size_t _z_link_socket_recv_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, const _z_sys_net_socket_t socket);
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+size_t _z_link_recv_zbuf_vec(const _z_link_t *link, _z_zbuf_t **zbfs, size_t count, _z_slice_t *addrs);
+#endif
 const _z_sys_net_socket_t *_z_link_get_socket(const _z_link_t *link);
 
 #ifdef __cplusplus
@@ -142,13 +142,15 @@ z_result_t _z_undeclare_publisher(_z_publisher_t *pub);
  *     reliability: The message reliability.
  *     source_info: The message source info.
  *     allowed_destination: The allowed destination locality.
+ *     put_header: An optional put header pre-encoded from the other parameters. The caller keeps its ownership.
  * Returns:
  *     ``0`` in case of success, ``-1`` in case of failure.
  */
 z_result_t _z_write(_z_session_t *zn, const _z_keyexpr_t *keyexpr, _z_bytes_t *payload, _z_encoding_t *encoding,
                     const z_sample_kind_t kind, const z_congestion_control_t cong_ctrl, z_priority_t priority,
                     bool is_express, const _z_timestamp_t *timestamp, _z_bytes_t *attachment,
-                    z_reliability_t reliability, const _z_source_info_t *source_info, z_locality_t allowed_destination);
+                    z_reliability_t reliability, const _z_source_info_t *source_info, z_locality_t allowed_destination,
+                    const _z_slice_t *put_header);
 #endif
 
 #if Z_FEATURE_SUBSCRIPTION == 1
@@ -38,6 +38,8 @@ typedef struct _z_publisher_t {
     bool _is_express;
     z_locality_t _allowed_destination;
     _z_write_filter_t _filter;
+    // Push header of puts sent with the publisher options, encoded once at declaration
+    _z_slice_t _put_header;
 } _z_publisher_t;
 
 #if Z_FEATURE_PUBLICATION == 1
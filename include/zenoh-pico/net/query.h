@@ -39,6 +39,7 @@ typedef struct _z_query_t {
     _z_string_t _parameters;
     bool _anyke;
     bool _is_local;
+    _z_transport_common_t *_transport;  // Transport the query came from, replies are sent back on it
 } _z_query_t;
 
 // Warning: None of the sub-types require a non-0 initialization. Add a init function if it changes.
@@ -101,6 +102,7 @@ static inline _z_query_t _z_query_steal_data(_z_value_t *value, _z_keyexpr_t *ke
     ret._attachment = _z_bytes_steal(attachment);
     ret._parameters._slice = _z_slice_steal(parameters);
     ret._anyke = anyke;
+    ret._transport = NULL;
     return ret;
 }
 void _z_queryable_clear(_z_queryable_t *qbl);
@@ -19,13 +19,16 @@
 
 #include "zenoh-pico/collections/element.h"
 #include "zenoh-pico/collections/list.h"
+#include "zenoh-pico/collections/keyexpr_tree.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/session/dedup.h"
 #include "zenoh-pico/session/liveliness.h"
 #include "zenoh-pico/session/matching.h"
 #include "zenoh-pico/session/queryable.h"
 #include "zenoh-pico/session/session.h"
+#include "zenoh-pico/session/shm.h"
 #include "zenoh-pico/session/subscription.h"
 #include "zenoh-pico/utils/config.h"
 #include "zenoh-pico/utils/scheduler.h"
@@ -34,6 +37,10 @@
 extern "C" {
 #endif
 
+#if Z_FEATURE_MULTICAST_TRANSPORT == 1 && Z_SESSION_MULTICAST_GROUP_NB > 0
+#define _Z_SESSION_MULTICAST_GROUPS
+#endif
+
 /**
  * A zenoh-net session.
  */
@@ -45,9 +52,15 @@ typedef struct _z_session_t {
     _z_mutex_t _mutex_inner;
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
-    // Zenoh-pico is considering a single transport per session.
+    // Main transport, the session is closed with it
     z_whatami_t _mode;
     _z_transport_t _tp;
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    // Multicast groups joined in addition to the main transport, unused ones have no transport type
+    _z_transport_t _tp_groups[Z_SESSION_MULTICAST_GROUP_NB];
+    _z_session_dedup_t _dedup;
+    uint32_t _source_sn;
+#endif
 
     // Zenoh PID
     _z_id_t _local_zid;
@@ -60,6 +73,7 @@ typedef struct _z_session_t {
 
     // Session declarations
     _z_resource_slist_t *_local_resources;
+    _z_resource_index_t _local_resources_index;
 
 #if Z_FEATURE_AUTO_RECONNECT == 1
     // Information for session restoring
@@ -67,16 +81,24 @@ typedef struct _z_session_t {
     _z_network_message_slist_t *_declaration_cache;
     z_task_attr_t *_lease_task_attr;
     z_task_attr_t *_read_task_attr;
+    uint8_t _read_task_worker_nb;
 #endif
 
     // Session subscriptions
 #if Z_FEATURE_SUBSCRIPTION == 1
     _z_subscription_rc_slist_t *_subscriptions;
     _z_subscription_rc_slist_t *_liveliness_subscriptions;
+    // Index the subscriptions by key for the rx path, the values are _z_subscription_rc_t clones
+    _z_keyexpr_tree_rcu_t _subscriptions_tree;
+    _z_keyexpr_tree_rcu_t _liveliness_subscriptions_tree;
 #if Z_FEATURE_RX_CACHE == 1
     _z_subscription_lru_cache_t _subscription_cache;
 #endif
 #endif
+#if Z_FEATURE_SHM == 1
+    // Segments of the peers of this host the received shared memory payloads point into
+    _z_shm_segment_cache_t _shm_segments;
+#endif
 
 #if Z_FEATURE_LIVELINESS == 1
     _z_keyexpr_intmap_t _local_tokens;
@@ -90,12 +112,18 @@ typedef struct _z_session_t {
     // Session queryables
 #if Z_FEATURE_QUERYABLE == 1
     _z_session_queryable_rc_slist_t *_local_queryable;
+    // Indexes the queryables by key for the rx path, the values are _z_session_queryable_rc_t clones
+    _z_keyexpr_tree_rcu_t _local_queryable_tree;
 #if Z_FEATURE_RX_CACHE == 1
     _z_queryable_lru_cache_t _queryable_cache;
 #endif
 #endif
 #if Z_FEATURE_QUERY == 1
-    _z_pending_query_slist_t *_pending_queries;
+    _z_pending_query_intmap_t _pending_queries;
+    // Pending query deadlines, in milliseconds since _pending_query_clock plus _pending_query_clock_base
+    _z_timer_wheel_t _pending_query_timers;
+    z_clock_t _pending_query_clock;
+    uint64_t _pending_query_clock_base;
 #endif
 
     // Session interests
@@ -116,6 +144,17 @@ typedef struct _z_session_t {
 #endif
 } _z_session_t;
 
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+static inline bool _z_session_has_groups(const _z_session_t *zn) {
+    for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+        if (zn->_tp_groups[i]._type != _Z_TRANSPORT_NONE) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 /**
  * Open a zenoh-net session
  *
@@ -275,7 +314,7 @@ z_result_t _zp_periodic_task_remove(_z_session_t *z, uint32_t id);
  * Returns:
  *     ``0`` in case of success, ``-1`` in case of failure.
  */
-z_result_t _zp_start_read_task(_z_session_t *z, z_task_attr_t *attr);
+z_result_t _zp_start_read_task(_z_session_t *z, z_task_attr_t *attr, uint8_t worker_nb);
 
 /**
  * Stop the read task. This may result in stopping a thread or a process depending
@@ -22,6 +22,8 @@
 extern "C" {
 #endif
 
+// Encodes the push body up to the put payload
+z_result_t _z_push_body_header_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb);
 z_result_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb);
 z_result_t _z_push_body_decode(_z_push_body_t *body, _z_zbuf_t *zbf, uint8_t header, _z_arc_slice_t *arcs);
 
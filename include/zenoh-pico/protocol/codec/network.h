@@ -24,6 +24,8 @@
 extern "C" {
 #endif
 
+// Encodes the push message up to the put payload
+z_result_t _z_push_header_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg);
 z_result_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg);
 z_result_t _z_push_decode(_z_n_msg_push_t *msg, _z_zbuf_t *zbf, uint8_t header, _z_arc_slice_t *arcs,
                           uintptr_t mapping);
@@ -40,6 +40,7 @@ extern "C" {
 #define _Z_FLAG_Z_X 0x00  // Unused flags are set to zero
 
 #define _Z_FRAG_BUFF_BASE_SIZE 128  // Arbitrary base size of the buffer to encode a fragment message header
+#define _Z_PUT_HEADER_BASE_SIZE 64   // Arbitrary base size of the buffer to encode a publisher put header
 
 // Flags:
 // - X: Reserved
@@ -82,6 +83,10 @@ typedef struct {
     _z_bytes_t _payload;
     _z_encoding_t _encoding;
     _z_bytes_t _attachment;
+#if Z_FEATURE_SHM == 1
+    // The payload holds the location of the data in a shared memory segment
+    bool _is_shm;
+#endif
 } _z_msg_put_t;
 void _z_msg_put_clear(_z_msg_put_t *);
 #define _Z_M_PUT_ID 0x01
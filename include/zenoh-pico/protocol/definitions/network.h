@@ -210,6 +210,8 @@ typedef struct {
     _z_timestamp_t _timestamp;
     _z_n_qos_t _qos;
     _z_push_body_t _body;
+    // Borrowed encoding of the message up to the put payload, used instead of encoding the fields above when set
+    const _z_slice_t *_encoded_header;
 } _z_n_msg_push_t;
 void _z_n_msg_push_clear(_z_n_msg_push_t *msg);
 
@@ -331,6 +333,10 @@ typedef struct {
 } _z_n_msg_oam_t;
 void _z_n_msg_oam_clear(_z_n_msg_oam_t *msg);
 
+// OAM sent by multicast peers to request missing reliable frames, body is a zbuf:
+// ~ target zid:z8+[u8] ~ first sn:z ~ last sn:z ~
+#define _Z_OAM_ID_MULTICAST_NACK 0x0101
+
 /*------------------ Zenoh Message ------------------*/
 typedef union {
     _z_n_msg_declare_t _declare;
@@ -101,6 +101,14 @@ extern "C" {
 #define _Z_CURRENT_PATCH 0x01
 #define _Z_PATCH_HAS_FRAGMENT_MARKERS(patch) (patch >= 1)
 
+/*=============================*/
+/*        Shared memory        */
+/*=============================*/
+/// Used to negotiate the exchange of shared memory payloads between zenoh-pico nodes of the same host,
+/// the extension holds the version followed by the id of the host of the sender
+#define _Z_SHM_VERSION 0x02
+#define _Z_SHM_HOST_ID_LEN 16
+
 /*=============================*/
 /*     Transport Messages      */
 /*=============================*/
@@ -248,6 +256,9 @@ typedef struct {
 #if Z_FEATURE_FRAGMENTATION == 1
     uint8_t _patch;
 #endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    uint16_t _retx_window;
+#endif
 } _z_t_msg_join_t;
 void _z_t_msg_join_clear(_z_t_msg_join_t *msg);
 
@@ -331,6 +342,10 @@ typedef struct {
 #if Z_FEATURE_FRAGMENTATION == 1
     uint8_t _patch;
 #endif
+#if Z_FEATURE_SHM == 1
+    bool _shm;
+    uint8_t _shm_host_id[_Z_SHM_HOST_ID_LEN];
+#endif
 } _z_t_msg_init_t;
 void _z_t_msg_init_clear(_z_t_msg_init_t *msg);
 
@@ -493,6 +508,8 @@ void _z_t_msg_frame_clear(_z_t_msg_frame_t *msg);
 //
 typedef struct {
     _z_slice_t _payload;
+    // Rx buffer the payload points into when decoded, may be null
+    _z_slice_simple_rc_t *_src;
     _z_zint_t _sn;
     bool first;
     bool drop;
@@ -521,8 +538,14 @@ z_reliability_t _z_t_msg_get_reliability(_z_transport_message_t *msg);
 /*------------------ Builders ------------------*/
 _z_transport_message_t _z_t_msg_make_join(z_whatami_t whatami, _z_zint_t lease, _z_id_t zid,
                                           _z_conduit_sn_list_t next_sn);
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+void _z_t_msg_join_set_retx(_z_transport_message_t *msg, uint16_t window);
+#endif
 _z_transport_message_t _z_t_msg_make_init_syn(z_whatami_t whatami, _z_id_t zid);
 _z_transport_message_t _z_t_msg_make_init_ack(z_whatami_t whatami, _z_id_t zid, _z_slice_t cookie);
+#if Z_FEATURE_SHM == 1
+void _z_t_msg_init_set_shm(_z_transport_message_t *msg, const uint8_t *host_id);
+#endif
 _z_transport_message_t _z_t_msg_make_open_syn(_z_zint_t lease, _z_zint_t initial_sn, _z_slice_t cookie);
 _z_transport_message_t _z_t_msg_make_open_ack(_z_zint_t lease, _z_zint_t initial_sn);
 _z_transport_message_t _z_t_msg_make_close(uint8_t reason, bool link_only);
@@ -45,9 +45,14 @@ extern "C" {
 /*=============================*/
 #define _Z_MSG_EXT_ID_JOIN_QOS (0x01 | _Z_MSG_EXT_FLAG_M | _Z_MSG_EXT_ENC_ZBUF)
 #define _Z_MSG_EXT_ID_JOIN_PATCH (0x07 | _Z_MSG_EXT_ENC_ZINT)
+// Number of sent reliable frames a zenoh-pico multicast node keeps to retransmit them
+#define _Z_MSG_EXT_ID_JOIN_RETX (0x0E | _Z_MSG_EXT_ENC_ZINT)
 #define _Z_MSG_EXT_ID_INIT_PATCH (0x07 | _Z_MSG_EXT_ENC_ZINT)
 #define _Z_MSG_EXT_ID_FRAGMENT_FIRST (0x02 | _Z_MSG_EXT_ENC_UNIT)
 #define _Z_MSG_EXT_ID_FRAGMENT_DROP (0x03 | _Z_MSG_EXT_ENC_UNIT)
+// Carries the host id of a zenoh-pico node able to exchange shared memory payloads, distinct from the zenoh shm ext
+#define _Z_MSG_EXT_ID_INIT_SHM (0x0F | _Z_MSG_EXT_ENC_ZBUF)
+#define _Z_MSG_EXT_ID_PUT_SHM (0x02 | _Z_MSG_EXT_ENC_UNIT | _Z_MSG_EXT_FLAG_M)
 
 /*=============================*/
 /*     Extension Encodings     */
@@ -24,6 +24,7 @@
 #include "zenoh-pico/collections/element.h"
 #include "zenoh-pico/collections/slice.h"
 #include "zenoh-pico/collections/vec.h"
+#include "zenoh-pico/config.h"
 #include "zenoh-pico/utils/pointers.h"
 
 #ifdef __cplusplus
@@ -108,9 +109,18 @@ _Z_ELEM_DEFINE(_z_iosli, _z_iosli_t, _z_iosli_size, _z_iosli_clear, _z_iosli_cop
 _Z_SVEC_DEFINE(_z_iosli, _z_iosli_t)
 
 /*------------------ ZBuf ------------------*/
+#if Z_FEATURE_FRAGMENTATION == 1 && Z_DEFRAG_ZERO_COPY == 1
+#define _Z_DEFRAG_CHAINED
+#endif
+
 typedef struct {
     _z_iosli_t _ios;
     _z_slice_simple_rc_t _slice;
+#if defined(_Z_DEFRAG_CHAINED)
+    // Slices following the buffer in a defragmented message, only a bytes field ending the message may extend over them
+    const _z_arc_slice_t *_tail;
+    size_t _tail_len;
+#endif
 } _z_zbuf_t;
 
 static inline size_t _z_zbuf_get_ref_count(const _z_zbuf_t *zbf) { return _z_slice_simple_rc_count(&zbf->_slice); }
@@ -187,6 +197,9 @@ size_t _z_wbuf_len_iosli(const _z_wbuf_t *wbf);
 _z_zbuf_t _z_wbuf_to_zbuf(const _z_wbuf_t *wbf);
 _z_zbuf_t _z_wbuf_moved_as_zbuf(_z_wbuf_t *wbf);
 z_result_t _z_wbuf_siphon(_z_wbuf_t *dst, _z_wbuf_t *src, size_t length);
+// Consumes up to length readable bytes as slices pointing into the buffer, appended to bufs from *count and up to
+// max_count, returns the number of bytes consumed
+size_t _z_wbuf_gather(_z_wbuf_t *wbf, _z_slice_t *bufs, size_t *count, size_t max_count, size_t length);
 
 void _z_wbuf_copy(_z_wbuf_t *dst, const _z_wbuf_t *src);
 void _z_wbuf_reset(_z_wbuf_t *wbf);
@@ -63,6 +63,8 @@ static inline void _z_keyexpr_clear(_z_keyexpr_t *rk) {
     _z_string_clear(&rk->_suffix);
 }
 bool _z_keyexpr_equals(const _z_keyexpr_t *left, const _z_keyexpr_t *right);
+// Hash consistent with _z_keyexpr_equals
+size_t _z_keyexpr_hash(const _z_keyexpr_t *key);
 z_result_t _z_keyexpr_move(_z_keyexpr_t *dst, _z_keyexpr_t *src);
 void _z_keyexpr_free(_z_keyexpr_t **rk);
 
@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_SESSION_DEDUP_H
+#define ZENOH_PICO_SESSION_DEDUP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "zenoh-pico/protocol/core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of sources whose last SNs are remembered, the oldest source is forgotten first
+#define _Z_SESSION_DEDUP_SOURCE_NB 16
+// Number of SNs remembered up to the highest one received from a source
+#define _Z_SESSION_DEDUP_WINDOW 64
+
+// Entity id of the source info a session stamps on its publications once it joined multicast groups. Entity ids start
+// at 1, so the stamp never names an entity and receivers don't hand it to the subscribers as a source info.
+#define _Z_SESSION_DEDUP_EID 0
+
+typedef struct {
+    _z_entity_global_id_t _id;
+    uint32_t _last_sn;
+    uint64_t _received;  // Bit n is set once _last_sn - n was received
+} _z_session_dedup_source_t;
+
+typedef struct {
+    _z_session_dedup_source_t _sources[_Z_SESSION_DEDUP_SOURCE_NB];
+    uint8_t _len;
+    uint8_t _oldest;
+} _z_session_dedup_t;
+
+void _z_session_dedup_init(_z_session_dedup_t *dedup);
+/**
+ * Records a message identified by its source info. Returns false if it was already received, which happens when the
+ * same message reaches the session through several of its transports. Messages without source info or older than the
+ * window are always accepted.
+ */
+bool _z_session_dedup_accept(_z_session_dedup_t *dedup, const _z_source_info_t *info);
+
+static inline bool _z_session_dedup_is_stamp(const _z_source_info_t *info) {
+    return (info->_source_id.eid == _Z_SESSION_DEDUP_EID) && _z_id_check(info->_source_id.zid);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_SESSION_DEDUP_H */
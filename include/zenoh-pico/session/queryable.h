@@ -36,7 +36,8 @@ typedef struct {
 } _z_queryable_cache_data_t;
 
 void _z_queryable_cache_invalidate(_z_session_t *zn);
-int _z_queryable_cache_data_compare(const void *first, const void *second);
+size_t _z_queryable_cache_data_hash(const void *e);
+bool _z_queryable_cache_data_eq(const void *first, const void *second);
 void _z_queryable_cache_data_clear(_z_queryable_cache_data_t *val);
 
 #if Z_FEATURE_QUERYABLE == 1
@@ -46,7 +47,7 @@ void _z_queryable_cache_data_clear(_z_queryable_cache_data_t *val);
 #if Z_FEATURE_RX_CACHE == 1
 _Z_ELEM_DEFINE(_z_queryable, _z_queryable_cache_data_t, _z_noop_size, _z_queryable_cache_data_clear, _z_noop_copy,
                _z_noop_move, _z_noop_eq, _z_noop_cmp, _z_noop_hash)
-_Z_LRU_CACHE_DEFINE(_z_queryable, _z_queryable_cache_data_t, _z_queryable_cache_data_compare)
+_Z_LRU_CACHE_DEFINE(_z_queryable, _z_queryable_cache_data_t, _z_queryable_cache_data_hash, _z_queryable_cache_data_eq)
 #endif
 
 /*------------------ Queryable ------------------*/
@@ -26,12 +26,20 @@ extern "C" {
 /*------------------ Entity ------------------*/
 uint32_t _z_get_entity_id(_z_session_t *zn);
 
+/*------------------ Resource index ------------------*/
+void _z_resource_index_init(_z_resource_index_t *index);
+void _z_resource_index_clear(_z_resource_index_t *index);
+
 /*------------------ Resource ------------------*/
 uint16_t _z_get_resource_id(_z_session_t *zn);
 _z_resource_t *_z_get_resource_by_id(_z_session_t *zn, _z_zint_t rid, _z_transport_peer_common_t *peer);
 _z_resource_t *_z_get_resource_by_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr, _z_transport_peer_common_t *peer);
 _z_keyexpr_t _z_get_expanded_key_from_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
                                           _z_transport_peer_common_t *peer);
+// Same as _z_get_expanded_key_from_key but the key is built in arena when not NULL, it is then only valid as long as
+// the arena isn't reset and the input key is alive
+_z_keyexpr_t _z_get_expanded_key_in_arena(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
+                                          _z_transport_peer_common_t *peer, _z_arena_t *arena);
 uint16_t _z_register_resource(_z_session_t *zn, const _z_keyexpr_t *key, uint16_t id, _z_transport_peer_common_t *peer);
 void _z_unregister_resource(_z_session_t *zn, uint16_t id, _z_transport_peer_common_t *peer);
 void _z_flush_local_resources(_z_session_t *zn);
@@ -20,9 +20,11 @@
 
 #include "zenoh-pico/api/constants.h"
 #include "zenoh-pico/collections/element.h"
+#include "zenoh-pico/collections/intmap.h"
 #include "zenoh-pico/collections/list.h"
 #include "zenoh-pico/collections/refcount.h"
 #include "zenoh-pico/collections/string.h"
+#include "zenoh-pico/collections/timer_wheel.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/transport/manager.h"
@@ -43,6 +45,8 @@ typedef enum {
 
 typedef struct {
     _z_keyexpr_t _key;
+    // Memoized fully expanded key, built once at registration time
+    _z_string_t _expanded;
     uint16_t _id;
     uint16_t _refcount;
 } _z_resource_t;
@@ -141,11 +145,12 @@ typedef struct {
     _z_closure_reply_callback_t _callback;
     _z_drop_handler_t _dropper;
     z_locality_t _allowed_destination;
-    z_clock_t _start_time;
-    uint64_t _timeout;
+    _z_timer_wheel_node_t _timer;
     void *_arg;
     uint8_t _remaining_finals;
     _z_pending_reply_slist_t *_pending_replies;
+    // Pending replies by key, for the consolidation modes that keep one reply per key
+    _z_hashmap_t _pending_replies_index;
     z_query_target_t _target;
     z_consolidation_mode_t _consolidation;
     bool _anykey;
@@ -156,7 +161,7 @@ void _z_pending_query_clear(_z_pending_query_t *res);
 
 _Z_ELEM_DEFINE(_z_pending_query, _z_pending_query_t, _z_noop_size, _z_pending_query_clear, _z_noop_copy, _z_noop_move,
                _z_pending_query_eq, _z_noop_cmp, _z_noop_hash)
-_Z_SLIST_DEFINE(_z_pending_query, _z_pending_query_t, false)
+_Z_INT_MAP_DEFINE(_z_pending_query, _z_pending_query_t)
 
 struct __z_hello_handler_wrapper_t;  // Forward declaration to be used in _z_closure_hello_callback_t
 /**
@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_SESSION_SHM_H
+#define ZENOH_PICO_SESSION_SHM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zenoh-pico/collections/bytes.h"
+#include "zenoh-pico/collections/refcount.h"
+#include "zenoh-pico/collections/vec.h"
+#include "zenoh-pico/config.h"
+#include "zenoh-pico/system/platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if Z_FEATURE_SHM == 1
+
+#define _Z_SHM_SEGMENT_NAME_SIZE 32
+
+/**
+ * A shared memory segment mapped by this process. The segment starts with the slots of the handles given to peers,
+ * followed by chunks each starting with a header holding its size and the number of handles on its data across all the
+ * processes of the host.
+ *
+ * Members:
+ *   uint64_t _id: The random id the segment name is built from, sent to the peers to locate chunks.
+ *   uint8_t *_base: The start of the mapping.
+ *   size_t _size: The size of the mapping.
+ *   size_t _start: The offset of the first chunk.
+ *   size_t _cursor: The offset of the chunk the next allocation starts looking from, only used by the owner.
+ *   uint32_t _slot_nb: The number of handle slots.
+ *   uint32_t _slot_cursor: The slot the next handle starts looking from, only used by the owner.
+ *   bool _is_owner: Whether this process created the segment and allocates chunks in it.
+ *   char _name: The name of the segment.
+ */
+typedef struct {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_t _mutex;
+#endif
+    uint64_t _id;
+    uint8_t *_base;
+    size_t _size;
+    size_t _start;
+    size_t _cursor;
+    uint32_t _slot_nb;
+    uint32_t _slot_cursor;
+    bool _is_owner;
+    char _name[_Z_SHM_SEGMENT_NAME_SIZE];
+} _z_shm_segment_t;
+
+// Unmaps the segment, the owner also removes its name
+void _z_shm_segment_clear(_z_shm_segment_t *seg);
+
+_Z_REFCOUNT_DEFINE(_z_shm_segment, _z_shm_segment)
+
+#define _Z_SHM_NO_SLOT UINT32_MAX
+
+/**
+ * A handle on a chunk, the context of the deleter of the payloads pointing into it. A handle given to a peer is held in
+ * a slot of the segment, so that the peer and this process may both give it back while only the first one releases
+ * the chunk.
+ *
+ * Members:
+ *   _z_shm_segment_rc_t _segment: The segment of the chunk, kept mapped while the handle lives.
+ *   size_t _offset: The offset of the chunk header in the segment.
+ *   uint32_t _slot: The slot of the handle, _Z_SHM_NO_SLOT for the handle of the payload allocated by the provider.
+ *   uint32_t _word: The value of the slot while the handle is held, its lowest bit is set and the others count the
+ * handles the slot held.
+ */
+typedef struct {
+    _z_shm_segment_rc_t _segment;
+    size_t _offset;
+    uint32_t _slot;
+    uint32_t _word;
+} _z_shm_chunk_ref_t;
+
+// Only drop the segment, the handle itself is given back with _z_shm_chunk_ref_release
+void _z_shm_chunk_ref_clear(_z_shm_chunk_ref_t *ref);
+void _z_shm_chunk_ref_copy(_z_shm_chunk_ref_t *dst, const _z_shm_chunk_ref_t *src);
+
+_Z_ELEM_DEFINE(_z_shm_chunk_ref, _z_shm_chunk_ref_t, _z_noop_size, _z_shm_chunk_ref_clear, _z_shm_chunk_ref_copy,
+               _z_noop_move, _z_noop_eq, _z_noop_cmp, _z_noop_hash)
+_Z_SVEC_DEFINE(_z_shm_chunk_ref, _z_shm_chunk_ref_t)
+
+// Takes a handle on the chunk of ref in a free slot to give it to a peer, fails if the slots are all in use
+z_result_t _z_shm_chunk_ref_take(const _z_shm_chunk_ref_t *ref, _z_shm_chunk_ref_t *handle);
+// Gives the handle back, nothing happens if the peer it was given to already did
+void _z_shm_chunk_ref_release(const _z_shm_chunk_ref_t *ref);
+bool _z_shm_chunk_ref_is_held(const _z_shm_chunk_ref_t *ref);
+// Gives back the handles of the vector and empties it
+void _z_shm_chunk_refs_release(_z_shm_chunk_ref_svec_t *refs);
+
+/**
+ * Allocates payloads in a shared memory segment it owns.
+ *
+ * Members:
+ *   _z_shm_segment_rc_t _segment: The segment, released when the provider and all the payloads it allocated are
+ * dropped.
+ */
+typedef struct {
+    _z_shm_segment_rc_t _segment;
+} _z_shm_provider_t;
+
+z_result_t _z_shm_provider_init(_z_shm_provider_t *provider, size_t size);
+void _z_shm_provider_clear(_z_shm_provider_t *provider);
+z_result_t _z_shm_provider_move(_z_shm_provider_t *dst, _z_shm_provider_t *src);
+static inline _z_shm_provider_t _z_shm_provider_null(void) { return (_z_shm_provider_t){0}; }
+static inline bool _z_shm_provider_check(const _z_shm_provider_t *provider) { return provider->_segment._cnt != NULL; }
+// Allocates a payload of len bytes, buf points to its data until it is dropped
+z_result_t _z_shm_provider_alloc(const _z_shm_provider_t *provider, size_t len, _z_bytes_t *bytes, uint8_t **buf);
+
+/**
+ * The segments of other processes recently mapped by a session to receive payloads by reference.
+ *
+ * Members:
+ *   _z_shm_segment_rc_t _segments: The mapped segments, an empty one when the slot is unused.
+ *   size_t _next: The slot replaced by the next segment mapped.
+ */
+typedef struct {
+    _z_shm_segment_rc_t _segments[Z_SHM_SEGMENT_CACHE_SIZE];
+    size_t _next;
+} _z_shm_segment_cache_t;
+
+void _z_shm_segment_cache_init(_z_shm_segment_cache_t *cache);
+void _z_shm_segment_cache_clear(_z_shm_segment_cache_t *cache);
+
+/**
+ * The handles given to a peer it may still hold, this process gives them back when the peer goes away.
+ *
+ * Members:
+ *   _z_shm_chunk_ref_svec_t _refs: The handles, some of them may already be given back by the peer.
+ */
+typedef struct {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_t _mutex;
+#endif
+    _z_shm_chunk_ref_svec_t _refs;
+} _z_shm_ledger_t;
+
+_z_shm_ledger_t *_z_shm_ledger_new(void);
+// Gives back the handles the peer still holds
+void _z_shm_ledger_free(_z_shm_ledger_t **ledger);
+z_result_t _z_shm_ledger_add(_z_shm_ledger_t *ledger, const _z_shm_chunk_ref_t *handle);
+
+// Returns the chunk of a payload worth sending by reference, NULL if the payload must be copied
+const _z_shm_chunk_ref_t *_z_shm_bytes_chunk(const _z_bytes_t *bytes);
+// Encodes the location of the payload data in the segment of its chunk, the location carries a copy of the handle
+z_result_t _z_shm_bytes_to_info(const _z_bytes_t *bytes, const _z_shm_chunk_ref_t *handle, _z_bytes_t *info);
+// Returns the handle a location built by _z_shm_bytes_to_info carries, NULL for other payloads
+const _z_shm_chunk_ref_t *_z_shm_info_handle(const _z_bytes_t *info);
+// Replaces the location of a payload received from a peer by a payload pointing to its data, mapping the segment
+z_result_t _z_shm_bytes_from_info(_z_shm_segment_cache_t *cache, _z_bytes_t *bytes);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_SESSION_SHM_H */
@@ -33,7 +33,12 @@ _Z_REFCOUNT_DEFINE(_z_subscription_rc_svec, _z_subscription_rc_svec)
 typedef struct {
     _z_keyexpr_t ke_in;
     _z_keyexpr_t ke_out;
+#if Z_FEATURE_RX_CACHE == 1
     _z_subscription_rc_svec_rc_t infos;
+#else
+    // Not shared with a cache, it may be stored in the rx arena
+    _z_subscription_rc_svec_t infos;
+#endif
     bool is_remote;
 } _z_subscription_cache_data_t;
 
@@ -43,7 +48,8 @@ static inline _z_subscription_cache_data_t _z_subscription_cache_data_null(void)
 }
 
 void _z_subscription_cache_invalidate(_z_session_t *zn);
-int _z_subscription_cache_data_compare(const void *first, const void *second);
+size_t _z_subscription_cache_data_hash(const void *e);
+bool _z_subscription_cache_data_eq(const void *first, const void *second);
 void _z_subscription_cache_data_clear(_z_subscription_cache_data_t *val);
 
 /*------------------ Subscription ------------------*/
@@ -60,7 +66,8 @@ z_result_t _z_trigger_liveliness_subscriptions_undeclare(_z_session_t *zn, const
 #if Z_FEATURE_RX_CACHE == 1
 _Z_ELEM_DEFINE(_z_subscription, _z_subscription_cache_data_t, _z_noop_size, _z_subscription_cache_data_clear,
                _z_noop_copy, _z_noop_move, _z_noop_eq, _z_noop_cmp, _z_noop_hash)
-_Z_LRU_CACHE_DEFINE(_z_subscription, _z_subscription_cache_data_t, _z_subscription_cache_data_compare)
+_Z_LRU_CACHE_DEFINE(_z_subscription, _z_subscription_cache_data_t, _z_subscription_cache_data_hash,
+                    _z_subscription_cache_data_eq)
 #endif
 
 _z_subscription_rc_t *_z_get_subscription_by_id(_z_session_t *zn, _z_subscriber_kind_t kind, const _z_zint_t id);
@@ -69,7 +76,7 @@ z_result_t _z_trigger_subscriptions_impl(_z_session_t *zn, _z_subscriber_kind_t
                                          _z_bytes_t *payload, _z_encoding_t *encoding, const _z_zint_t sample_kind,
                                          const _z_timestamp_t *timestamp, const _z_n_qos_t qos, _z_bytes_t *attachment,
                                          z_reliability_t reliability, _z_source_info_t *source_info,
-                                         _z_transport_peer_common_t *peer);
+                                         _z_transport_peer_common_t *peer, _z_arena_t *arena);
 void _z_unregister_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_subscription_rc_t *sub);
 void _z_flush_subscriptions(_z_session_t *zn);
 
@@ -78,8 +85,10 @@ static inline z_result_t _z_trigger_subscriptions_put(_z_session_t *zn, _z_keyex
                                                       const _z_n_qos_t qos, _z_bytes_t *attachment,
                                                       z_reliability_t reliability, _z_source_info_t *source_info,
                                                       _z_transport_peer_common_t *peer) {
+    // Samples are only triggered with a peer by its rx task, their transient data goes in its arena
     return _z_trigger_subscriptions_impl(zn, _Z_SUBSCRIBER_KIND_SUBSCRIBER, keyexpr, payload, encoding,
-                                         Z_SAMPLE_KIND_PUT, timestamp, qos, attachment, reliability, source_info, peer);
+                                         Z_SAMPLE_KIND_PUT, timestamp, qos, attachment, reliability, source_info, peer,
+                                         _z_transport_peer_common_rx_arena(peer));
 }
 static inline z_result_t _z_trigger_subscriptions_del(_z_session_t *zn, _z_keyexpr_t *keyexpr,
                                                       const _z_timestamp_t *timestamp, const _z_n_qos_t qos,
@@ -89,7 +98,7 @@ static inline z_result_t _z_trigger_subscriptions_del(_z_session_t *zn, _z_keyex
     _z_bytes_t payload = _z_bytes_null();
     return _z_trigger_subscriptions_impl(zn, _Z_SUBSCRIBER_KIND_SUBSCRIBER, keyexpr, &payload, &encoding,
                                          Z_SAMPLE_KIND_DELETE, timestamp, qos, attachment, reliability, source_info,
-                                         peer);
+                                         peer, _z_transport_peer_common_rx_arena(peer));
 }
 #else   // Z_FEATURE_SUBSCRIPTION == 0
 static inline z_result_t _z_trigger_subscriptions_put(_z_session_t *zn, _z_keyexpr_t *keyexpr, _z_bytes_t *payload,
@@ -506,6 +506,31 @@ z_result_t _z_socket_set_non_blocking(const _z_sys_net_socket_t *sock);
 z_result_t _z_socket_accept(const _z_sys_net_socket_t *sock_in, _z_sys_net_socket_t *sock_out);
 void _z_socket_close(_z_sys_net_socket_t *sock);
 z_result_t _z_socket_wait_event(void *peers, _z_mutex_rec_t *mutex);
+#if defined(_Z_SYS_NET_EVENT_SET)
+z_result_t _z_socket_event_set_init(_z_sys_net_event_set_t *set);
+void _z_socket_event_set_clear(_z_sys_net_event_set_t *set);
+// The context is reported back by _z_socket_event_set_wait when the socket becomes readable
+z_result_t _z_socket_event_set_add(_z_sys_net_event_set_t *set, const _z_sys_net_socket_t *sock, void *ctx);
+void _z_socket_event_set_remove(_z_sys_net_event_set_t *set, const _z_sys_net_socket_t *sock);
+/**
+ * Waits up to Z_CONFIG_SOCKET_TIMEOUT for registered sockets to become readable and stores the contexts of up to max
+ * of them in ready. A timeout isn't an error and reports no socket.
+ */
+z_result_t _z_socket_event_set_wait(_z_sys_net_event_set_t *set, void **ready, size_t max, size_t *count);
+#endif
+
+#if defined(_Z_SYS_SHM)
+/*------------------ Shared memory internal functions ------------------*/
+// Creates and maps a segment of size bytes, fails if a segment with this name already exists
+z_result_t _z_shm_segment_create(const char *name, size_t size, uint8_t **ptr);
+// Maps a segment created by another process
+z_result_t _z_shm_segment_open(const char *name, uint8_t **ptr, size_t *size);
+void _z_shm_segment_unmap(uint8_t *ptr, size_t size);
+// Removes the name of a segment, existing mappings stay valid
+void _z_shm_segment_unlink(const char *name);
+// Fills id with an identifier only shared by the processes running on this host
+z_result_t _z_shm_host_id(uint8_t *id, size_t len);
+#endif
 
 #ifdef __cplusplus
 }
@@ -44,6 +44,13 @@ size_t _z_read_exact_udp_unicast(const _z_sys_net_socket_t sock, uint8_t *ptr, s
 size_t _z_read_udp_unicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len);
 size_t _z_send_udp_unicast(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len,
                            const _z_sys_net_endpoint_t rep);
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_send_vec_udp_unicast(const _z_sys_net_socket_t sock, const _z_slice_t *bufs, size_t count,
+                               const _z_sys_net_endpoint_t rep);
+#endif
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+size_t _z_read_vec_udp_unicast(const _z_sys_net_socket_t sock, _z_slice_t *bufs, size_t count);
+#endif
 
 // Multicast
 z_result_t _z_open_udp_multicast(_z_sys_net_socket_t *sock, const _z_sys_net_endpoint_t rep, _z_sys_net_endpoint_t *lep,
@@ -58,6 +65,14 @@ size_t _z_read_udp_multicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_
                              _z_slice_t *ep);
 size_t _z_send_udp_multicast(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t len,
                              const _z_sys_net_endpoint_t rep);
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_send_vec_udp_multicast(const _z_sys_net_socket_t sock, const _z_slice_t *bufs, size_t count,
+                                 const _z_sys_net_endpoint_t rep);
+#endif
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+size_t _z_read_vec_udp_multicast(const _z_sys_net_socket_t sock, _z_slice_t *bufs, size_t count,
+                                 const _z_sys_net_endpoint_t lep, _z_slice_t *addrs);
+#endif
 #endif
 
 #ifdef __cplusplus
@@ -60,6 +60,28 @@ typedef struct {
     };
 } _z_sys_net_endpoint_t;
 
+// Max number of buffers sent in a single gather write
+#define _Z_SYS_NET_SEND_VEC_MAX 16
+
+#if defined(ZENOH_LINUX)
+// Max number of datagrams received in a single batched read
+#define _Z_SYS_NET_RECV_VEC_MAX 8
+#if Z_FEATURE_MULTI_THREAD == 1
+// Sockets registered once with epoll, waited on without rebuilding a select mask each time
+#define _Z_SYS_NET_EVENT_SET
+// Max number of ready sockets reported by a single wait
+#define _Z_SYS_NET_EVENT_SET_WAIT_MAX 64
+typedef struct {
+    int _fd;
+} _z_sys_net_event_set_t;
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+#endif
+
+#if Z_FEATURE_SHM == 1
+// POSIX shared memory segments, mapped by the processes of a host to pass payloads by reference
+#define _Z_SYS_SHM
+#endif
+
 #ifdef __cplusplus
 }
 #endif
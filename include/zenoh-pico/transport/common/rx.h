@@ -25,6 +25,24 @@ extern "C" {
 /*------------------ Transmission and Reception helpers ------------------*/
 size_t _z_read_stream_size(_z_zbuf_t *zbuf);
 z_result_t _z_link_recv_t_msg(_z_transport_message_t *t_msg, const _z_link_t *zl, _z_sys_net_socket_t *socket);
+// Replaces a rx buffer still referenced by received payloads, pool holds Z_RX_BUFFER_POOL_SIZE buffers to recycle
+z_result_t _z_transport_update_rx_zbuf(_z_zbuf_t *zbf, _z_zbuf_t *pool);
+z_result_t _z_transport_update_rx_buffer(_z_transport_common_t *ztc);
+
+#if Z_FEATURE_FRAGMENTATION == 1
+/*------------------ Defragmentation buffer ------------------*/
+static inline _z_dbuf_t _z_dbuf_null(void) { return (_z_dbuf_t){0}; }
+void _z_dbuf_clear(_z_dbuf_t *dbuf);
+void _z_dbuf_reset(_z_dbuf_t *dbuf);
+z_result_t _z_dbuf_copy(_z_dbuf_t *dst, const _z_dbuf_t *src);
+size_t _z_dbuf_len(const _z_dbuf_t *dbuf);
+// Prepares an empty buffer for a message of up to max_size bytes
+z_result_t _z_dbuf_init(_z_dbuf_t *dbuf, size_t max_size);
+z_result_t _z_dbuf_append(_z_dbuf_t *dbuf, const _z_t_msg_fragment_t *msg);
+// Decodes the reassembled message and empties dbuf, zbf must be cleared once the message has been handled
+z_result_t _z_dbuf_decode(_z_dbuf_t *dbuf, _z_zbuf_t *zbf, _z_network_message_t *msg, _z_arc_slice_t *arcs,
+                          uintptr_t mapping);
+#endif
 
 #ifdef __cplusplus
 }
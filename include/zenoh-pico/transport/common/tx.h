@@ -34,10 +34,31 @@ z_result_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z
 z_result_t _z_transport_tx_send_t_msg(_z_transport_common_t *ztc, const _z_transport_message_t *t_msg,
                                       _z_transport_peer_unicast_slist_t *peers);
 z_result_t _z_transport_tx_send_t_msg_wrapper(_z_transport_common_t *ztc, const _z_transport_message_t *t_msg);
+z_result_t _z_transport_tx_send_n_msg_wrapper(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
+                                              z_reliability_t reliability, z_congestion_control_t cong_ctrl);
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+// Sends again the reliable frames and fragments from first_sn to last_sn still in the transport window
+z_result_t _z_transport_tx_retransmit(_z_transport_common_t *ztc, _z_zint_t first_sn, _z_zint_t last_sn);
+#endif
+#if defined(_Z_TX_QUEUE)
+// Allocates the tx queue of the transport and starts its writer task, network messages are then sent through it
+z_result_t _z_transport_tx_queue_start(_z_transport_common_t *ztc, z_task_attr_t *attr);
+// Stops the writer task, messages still queued are dropped
+void _z_transport_tx_queue_stop(_z_transport_common_t *ztc);
+// Waits up to Z_TX_QUEUE_BLOCK_TIMEOUT_MS for the writer task to be done with the queued messages. On timeout the
+// message the caller was about to send is dropped with Z_CONGESTION_CONTROL_DROP, or fails to send with
+// Z_CONGESTION_CONTROL_BLOCK.
+z_result_t _z_transport_tx_queue_drain(_z_transport_common_t *ztc, z_congestion_control_t cong_ctrl);
+void _z_transport_tx_queue_stats(_z_transport_common_t *ztc, size_t *depth, uint64_t *dropped);
+#endif
 z_result_t _z_send_t_msg(_z_transport_t *zt, const _z_transport_message_t *t_msg);
 z_result_t _z_link_send_t_msg(const _z_link_t *zl, const _z_transport_message_t *t_msg, _z_sys_net_socket_t *socket);
 z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *n_msg, z_reliability_t reliability,
                          z_congestion_control_t cong_ctrl, void *peer);
+// Sends a message on the session transport ztc belongs to, typically to answer on the one a request came from.
+// A NULL ztc sends it like _z_send_n_msg.
+z_result_t _z_send_n_msg_on(_z_session_t *zn, _z_transport_common_t *ztc, const _z_network_message_t *n_msg,
+                            z_reliability_t reliability, z_congestion_control_t cong_ctrl);
 z_result_t _z_send_n_batch(_z_session_t *zn, z_congestion_control_t cong_ctrl);
 
 #ifdef __cplusplus
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZENOH_PICO_MULTICAST_RETX_H
+#define ZENOH_PICO_MULTICAST_RETX_H
+
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/transport/transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+// Time to wait for a retransmission before requesting the missing frames again
+#define _Z_MULTICAST_NACK_RETRY_MS 100
+// Number of requests for the same missing frames before skipping them
+#define _Z_MULTICAST_NACK_RETRY_MAX 3
+
+// Transports keeping a window advertise it in their joins
+static inline bool _z_multicast_retx_enabled(const _z_transport_multicast_t *ztm) {
+    return ztm->_common._retx_window != NULL;
+}
+
+// Missing frames are only requested from peers that advertised a window, others are skipped
+static inline bool _z_multicast_retx_peer_enabled(const _z_transport_peer_multicast_t *entry) {
+    return entry->_retx_window > 0;
+}
+
+typedef enum {
+    _Z_MULTICAST_RETX_SN_DROP,     // Already delivered
+    _Z_MULTICAST_RETX_SN_DELIVER,  // Follows the last delivered one
+    _Z_MULTICAST_RETX_SN_HOLD,     // Follows missing ones, to hold until they are retransmitted
+    _Z_MULTICAST_RETX_SN_SKIP,     // Missing ones were given up on, the held ones must be delivered first
+} _z_multicast_retx_sn_t;
+
+void _z_multicast_retx_peer_init(_z_transport_peer_multicast_t *entry);
+// Applies the window advertised in a join, held frames are dropped if the peer stopped advertising one
+void _z_multicast_retx_peer_set_window(_z_transport_peer_multicast_t *entry, uint16_t window);
+void _z_multicast_retx_peer_clear(_z_transport_peer_multicast_t *entry);
+/**
+ * Checks a reliable SN received from a peer against the last one delivered. When SNs are missing, they are requested
+ * from the peer at most once per retry period and the frame or fragment carrying it must be held. Missing SNs are given
+ * up on once the peer failed to retransmit them or doesn't keep them anymore, the held frames are then delivered with
+ * :c:func:`_z_multicast_retx_next` before checking the SN again.
+ */
+_z_multicast_retx_sn_t _z_multicast_retx_accept_sn(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *entry,
+                                                   _z_zint_t sn, bool *consecutive);
+// Keeps a copy of a frame or fragment payload given _Z_MULTICAST_RETX_SN_HOLD
+z_result_t _z_multicast_retx_hold(_z_transport_peer_multicast_t *entry, uint8_t header, _z_zint_t sn,
+                                  const uint8_t *payload, size_t len, bool first, bool drop);
+/**
+ * Returns the next held frame or fragment to deliver, marking it as delivered, or NULL if it is still missing.
+ * It must be released with :c:func:`_z_multicast_retx_release` once processed.
+ */
+_z_transport_retx_held_t *_z_multicast_retx_next(_z_transport_peer_multicast_t *entry, bool *consecutive);
+void _z_multicast_retx_release(_z_transport_retx_held_t *held);
+// Requests the reliable frames a peer advertised in a join but that weren't received
+void _z_multicast_retx_check_join(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *entry,
+                                  _z_zint_t last_sent_sn);
+z_result_t _z_multicast_retx_handle_nack(_z_transport_multicast_t *ztm, const _z_n_msg_oam_t *oam,
+                                         const _z_id_t *local_zid);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZENOH_PICO_MULTICAST_RETX_H */
@@ -18,13 +18,17 @@
 #include <assert.h>
 #include <stdint.h>
 
+#include "zenoh-pico/collections/arena.h"
+#include "zenoh-pico/collections/bytes.h"
 #include "zenoh-pico/collections/element.h"
+#include "zenoh-pico/collections/hashmap.h"
 #include "zenoh-pico/collections/refcount.h"
 #include "zenoh-pico/collections/slice.h"
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/link/link.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/transport.h"
+#include "zenoh-pico/session/shm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +40,15 @@ enum _z_dbuf_state_e {
     _Z_DBUF_STATE_OVERFLOW = 2,
 };
 
+#if Z_FEATURE_FRAGMENTATION == 1
+#if defined(_Z_DEFRAG_CHAINED)
+// Fragments received so far, as references to the rx buffers holding them
+typedef _z_bytes_t _z_dbuf_t;
+#else
+typedef _z_wbuf_t _z_dbuf_t;
+#endif
+#endif
+
 enum _z_batching_state_e {
     _Z_BATCHING_IDLE = 0,
     _Z_BATCHING_ACTIVE = 1,
@@ -44,26 +57,58 @@ enum _z_batching_state_e {
 // Forward declaration to avoid cyclical include
 typedef _z_slist_t _z_resource_slist_t;
 
+// Hash indexes over a resource list, entries point to the list values and don't own them
+typedef struct {
+    _z_hashmap_t _by_id;
+    _z_hashmap_t _by_key;
+} _z_resource_index_t;
+
 typedef struct {
     _z_id_t _remote_zid;
     z_whatami_t _remote_whatami;
     volatile bool _received;
     _z_resource_slist_t *_remote_resources;
+    _z_resource_index_t _remote_resources_index;
+    // Transient data of the batch being dispatched, only used by the task reading from the peer
+    _z_arena_t _rx_arena;
 #if Z_FEATURE_FRAGMENTATION == 1
     // Defragmentation buffers
     uint8_t _state_reliable;
     uint8_t _state_best_effort;
-    _z_wbuf_t _dbuf_reliable;
-    _z_wbuf_t _dbuf_best_effort;
+    _z_dbuf_t _dbuf_reliable;
+    _z_dbuf_t _dbuf_best_effort;
     // Patch
     uint8_t _patch;
 #endif
+#if Z_FEATURE_SHM == 1
+    // The peer runs on this host and accepts shared memory payloads
+    bool _shm;
+    // Handles on chunks sent to the peer, NULL if it doesn't get any
+    _z_shm_ledger_t *_shm_ledger;
+#endif
 } _z_transport_peer_common_t;
 
+// Only to be called by the task reading from the peer, returns NULL for local messages or if the arena is disabled
+static inline _z_arena_t *_z_transport_peer_common_rx_arena(_z_transport_peer_common_t *peer) {
+    return ((peer != NULL) && (peer->_rx_arena._capacity > 0)) ? &peer->_rx_arena : NULL;
+}
+
 void _z_transport_peer_common_clear(_z_transport_peer_common_t *src);
 void _z_transport_peer_common_copy(_z_transport_peer_common_t *dst, const _z_transport_peer_common_t *src);
 bool _z_transport_peer_common_eq(const _z_transport_peer_common_t *left, const _z_transport_peer_common_t *right);
 
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+// Copy of a reliable frame or fragment received after missing ones, held until they are retransmitted
+typedef struct {
+    _z_zbuf_t _payload;
+    _z_zint_t _sn;
+    // Header of the transport message, 0 if the slot is free
+    uint8_t _header;
+    bool _first;
+    bool _drop;
+} _z_transport_retx_held_t;
+#endif
+
 typedef struct {
     _z_transport_peer_common_t common;
     _z_slice_t _remote_addr;
@@ -72,6 +117,19 @@ typedef struct {
     _z_zint_t _sn_res;
     volatile _z_zint_t _lease;
     volatile _z_zint_t _next_lease;
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    // Number of sent frames the peer advertised it keeps, capped to ours, 0 if it doesn't retransmit
+    uint16_t _retx_window;
+    // Frames received after missing ones, indexed by SN modulo the window
+    _z_transport_retx_held_t *_retx_held;
+    // While set, the missing SNs up to _sn_skip are given up on
+    bool _retx_skip;
+    _z_zint_t _sn_skip;
+    // Last reliable SN requested again from the peer and when
+    _z_zint_t _sn_nack;
+    z_clock_t _nack_time;
+    uint8_t _nack_count;
+#endif
 } _z_transport_peer_multicast_t;
 
 size_t _z_transport_peer_multicast_size(const _z_transport_peer_multicast_t *src);
@@ -117,6 +175,65 @@ _Z_SLIST_DEFINE(_z_transport_peer_unicast, _z_transport_peer_unicast_t, true)
 typedef struct _z_session_t _z_session_t;
 extern void _z_session_clear(_z_session_t *zn);  // Forward declaration to avoid cyclical include
 _Z_REFCOUNT_DEFINE_NO_FROM_VAL(_z_session, _z_session)
+#if Z_FEATURE_BATCHING == 1
+// Network messages batched for a single priority, framed on flush so SNs follow the wire order
+typedef struct {
+    _z_wbuf_t _wbuf;
+    size_t _count;
+    z_reliability_t _reliability;
+#if Z_FEATURE_SHM == 1
+    // Handles on chunks given by the batched messages, given back if they are not sent
+    _z_shm_chunk_ref_svec_t _shm_refs;
+#endif
+} _z_transport_tx_lane_t;
+#endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+// Copy of a sent reliable frame or fragment, as written on the link
+typedef struct {
+    _z_zint_t _sn;
+    uint8_t *_buf;
+    size_t _len;
+    size_t _capacity;
+} _z_transport_retx_entry_t;
+#endif
+#if Z_TX_QUEUE_SIZE > 0 && Z_FEATURE_MULTI_THREAD == 1
+#define _Z_TX_QUEUE
+// Network message encoded by the sending thread, waiting for the writer task
+typedef struct {
+    // Buffer sized to the message if it didn't fit in the free space of the ring, empty otherwise
+    _z_wbuf_t _wbuf;
+    // Position of the message in the ring, it may wrap around its end
+    size_t _offset;
+    size_t _len;
+    z_reliability_t _reliability;
+    bool _express;
+#if Z_FEATURE_SHM == 1
+    // Handle on a chunk given by the message, given back if it is not sent. Its segment is empty if there is none.
+    _z_shm_chunk_ref_t _shm_ref;
+#endif
+} _z_transport_tx_queue_entry_t;
+
+typedef struct {
+    _z_mutex_t _mutex;
+    // Signaled when a message is queued and when the writer stops
+    _z_condvar_t _cv_queued;
+    // Signaled when the writer is done with queued messages
+    _z_condvar_t _cv_sent;
+    _z_task_t *_task;
+    bool _running;
+    // Queued messages start at _head, the writer owns those it's sending until it releases them
+    size_t _head;
+    size_t _len;
+    uint64_t _dropped;
+    // Messages are encoded in the scratch buffer, of a frame capacity, then copied to the ring bytes they take
+    _z_wbuf_t _scratch;
+    uint8_t *_ring;
+    size_t _ring_start;
+    size_t _ring_len;
+    _z_transport_tx_queue_entry_t _entries[Z_TX_QUEUE_SIZE];
+} _z_transport_tx_queue_t;
+#endif
+
 typedef struct {
     _z_session_weak_t _session;
     _z_link_t *_link;
@@ -129,6 +246,10 @@ typedef struct {
     _z_zint_t _sn_tx_best_effort;
     volatile _z_zint_t _lease;
     volatile bool _transmitted;
+#if Z_FEATURE_FRAGMENTATION == 1
+    // Maximum size of a message reassembled from fragments
+    size_t _frag_max_size;
+#endif
 #if Z_FEATURE_MULTI_THREAD == 1
     // TX and RX mutexes
     _z_mutex_t _mutex_rx;
@@ -145,24 +266,74 @@ typedef struct {
 #if Z_FEATURE_BATCHING == 1
     uint8_t _batch_state;
     size_t _batch_count;
+    _z_transport_tx_lane_t _batch_lanes[Z_PRIORITIES_NUM];
+#endif
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    // Rx buffers recycled once the payloads referencing them are dropped
+    _z_zbuf_t _zbuf_pool[Z_RX_BUFFER_POOL_SIZE];
+#endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    // Recently sent reliable frames indexed by SN, only allocated on multicast transports
+    _z_transport_retx_entry_t *_retx_window;
+#endif
+#if defined(_Z_TX_QUEUE)
+    // Network messages waiting for the writer task, NULL if they're sent by the calling thread
+    _z_transport_tx_queue_t *_tx_queue;
+    // Set from the config, the writer task is then started with the read task and its attributes
+    bool _tx_queue_enabled;
 #endif
 } _z_transport_common_t;
 
 // Send function prototype
 typedef z_result_t (*_zp_f_send_tmsg)(_z_transport_common_t *self, const _z_transport_message_t *t_msg);
 
+#if defined(_Z_SYS_NET_EVENT_SET)
 typedef struct {
+    struct _z_transport_unicast_t *_ztu;
+    // Held while processing the ready peers, so they aren't dropped meanwhile by the lease task
+    _z_mutex_t _mutex;
+    // Sockets of the peers assigned to this worker
+    _z_sys_net_event_set_t _event_set;
+    // Incremented on each peer drop, as a wait may still report a dropped peer
+    size_t _event_set_gen;
+    _z_zbuf_t _zbuf;
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    _z_zbuf_t _zbuf_pool[Z_RX_BUFFER_POOL_SIZE];
+#endif
+} _z_transport_unicast_rx_worker_t;
+#endif
+
+typedef struct _z_transport_unicast_t {
     _z_transport_common_t _common;
     // Known valid peers
     _z_transport_peer_unicast_slist_t *_peers;
+#if defined(_Z_SYS_NET_EVENT_SET)
+    // Peer mode read workers, created by the first read task, NULL if they couldn't be created
+    _z_transport_unicast_rx_worker_t *_rx_workers;
+    uint8_t _rx_worker_nb;
+    // Attributes of the extra worker tasks spawned by the read task
+    z_task_attr_t *_rx_worker_attr;
+#endif
 } _z_transport_unicast_t;
 
+#if defined(_Z_SYS_NET_EVENT_SET)
+// Peers are spread across the read workers by hash of their id
+static inline _z_transport_unicast_rx_worker_t *_z_transport_unicast_rx_worker_of(
+    const _z_transport_unicast_t *ztu, const _z_transport_peer_unicast_t *peer) {
+    return &ztu->_rx_workers[_z_id_hash(&peer->common._remote_zid) % ztu->_rx_worker_nb];
+}
+#endif
+
 typedef struct _z_transport_multicast_t {
     _z_transport_common_t _common;
     // Known valid peers
     _z_transport_peer_multicast_slist_t *_peers;
     // T message send function
     _zp_f_send_tmsg _send_f;
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+    // Extra rx buffers for batched datagram reads, allocated on first use
+    _z_zbuf_t _zbuf_ring[_Z_SYS_NET_RECV_VEC_MAX - 1];
+#endif
 } _z_transport_multicast_t;
 
 typedef struct {
@@ -189,6 +360,9 @@ typedef struct {
 #if Z_FEATURE_FRAGMENTATION == 1
     uint8_t _patch;
 #endif
+#if Z_FEATURE_SHM == 1
+    bool _shm;
+#endif
 } _z_transport_unicast_establish_param_t;
 
 typedef struct {
@@ -198,6 +372,11 @@ typedef struct {
 
 z_result_t _z_transport_peer_unicast_add(_z_transport_unicast_t *ztu, _z_transport_unicast_establish_param_t *param,
                                          _z_sys_net_socket_t socket, _z_transport_peer_unicast_t **output_peer);
+/**
+ * Drops the peer following prev in the peer list, or the first one if prev is NULL. The peer mutex must be held, and
+ * the mutex of the read worker owning the peer when there are read workers.
+ */
+void _z_transport_peer_unicast_drop(_z_transport_unicast_t *ztu, _z_transport_peer_unicast_slist_t *prev);
 _z_transport_common_t *_z_transport_get_common(_z_transport_t *zt);
 z_result_t _z_transport_close(_z_transport_t *zt, uint8_t reason);
 void _z_transport_clear(_z_transport_t *zt);
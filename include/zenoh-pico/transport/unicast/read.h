@@ -26,11 +26,22 @@ z_result_t _zp_unicast_stop_read_task(_z_transport_t *zt);
 void *_zp_unicast_read_task(void *ztu_arg);  // The argument is void* to avoid incompatible pointer types in tasks
 
 #if Z_FEATURE_MULTI_THREAD == 1 && Z_FEATURE_UNICAST_TRANSPORT == 1
-z_result_t _zp_unicast_start_read_task(_z_transport_t *zt, z_task_attr_t *attr, _z_task_t *task);
+/**
+ * Starts the read task. In peer mode, worker_nb tasks share the reading of the peers on platforms with socket event
+ * sets, a single task reads them otherwise. The number of workers is fixed by the first start.
+ */
+z_result_t _zp_unicast_start_read_task(_z_transport_t *zt, z_task_attr_t *attr, _z_task_t *task, uint8_t worker_nb);
 #else
-z_result_t _zp_unicast_start_read_task(_z_transport_t *zt, void *attr, void *task);
+z_result_t _zp_unicast_start_read_task(_z_transport_t *zt, void *attr, void *task, uint8_t worker_nb);
 #endif /* Z_FEATURE_MULTI_THREAD == 1 && Z_FEATURE_UNICAST_TRANSPORT == 1 */
 
+#if defined(_Z_SYS_NET_EVENT_SET) && Z_FEATURE_UNICAST_TRANSPORT == 1
+// Holds off the read workers while peers are dropped from outside of them, returns the number of workers locked
+uint8_t _zp_unicast_rx_workers_lock(_z_transport_unicast_t *ztu);
+void _zp_unicast_rx_workers_unlock(_z_transport_unicast_t *ztu, uint8_t locked_nb);
+void _zp_unicast_rx_workers_free(_z_transport_unicast_t *ztu);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -591,6 +591,20 @@ _Z_OWNED_FUNCTIONS_VALUE_IMPL(_z_bytes_t, bytes, _z_bytes_check, _z_bytes_null,
 _Z_OWNED_FUNCTIONS_VALUE_NO_COPY_IMPL(_z_bytes_writer_t, bytes_writer, _z_bytes_writer_check, _z_bytes_writer_empty,
                                       _z_bytes_writer_move, _z_bytes_writer_clear)
 
+#if Z_FEATURE_SHM == 1
+_Z_OWNED_FUNCTIONS_VALUE_NO_COPY_IMPL(_z_shm_provider_t, shm_provider, _z_shm_provider_check, _z_shm_provider_null,
+                                      _z_shm_provider_move, _z_shm_provider_clear)
+
+z_result_t z_shm_provider_new(z_owned_shm_provider_t *provider, size_t size) {
+    return _z_shm_provider_init(&provider->_val, size);
+}
+
+z_result_t z_shm_provider_alloc(const z_loaned_shm_provider_t *provider, size_t len, z_owned_bytes_t *bytes,
+                                uint8_t **data) {
+    return _z_shm_provider_alloc(provider, len, &bytes->_val, data);
+}
+#endif
+
 #if Z_FEATURE_PUBLICATION == 1 || Z_FEATURE_QUERYABLE == 1 || Z_FEATURE_QUERY == 1
 // Convert a user owned bytes payload to an internal bytes payload, returning an empty one if value invalid
 static inline _z_bytes_t *_z_bytes_from_moved(z_moved_bytes_t *bytes) {
@@ -990,7 +1004,7 @@ z_result_t z_put(const z_loaned_session_t *zs, const z_loaned_keyexpr_t *keyexpr
 #endif
     ret = _z_write(_Z_RC_IN_VAL(zs), &keyexpr_aliased, payload_bytes, encoding, Z_SAMPLE_KIND_PUT,
                    opt.congestion_control, opt.priority, opt.is_express, opt.timestamp, attachment_bytes, reliability,
-                   source_info, allowed_destination);
+                   source_info, allowed_destination, NULL);
 
     z_encoding_drop(opt.encoding);
     z_bytes_drop(opt.attachment);
@@ -1024,7 +1038,8 @@ z_result_t z_delete(const z_loaned_session_t *zs, const z_loaned_keyexpr_t *keye
     allowed_destination = opt.allowed_destination;
 #endif
     ret = _z_write(_Z_RC_IN_VAL(zs), &keyexpr_aliased, NULL, NULL, Z_SAMPLE_KIND_DELETE, opt.congestion_control,
-                   opt.priority, opt.is_express, opt.timestamp, NULL, reliability, source_info, allowed_destination);
+                   opt.priority, opt.is_express, opt.timestamp, NULL, reliability, source_info, allowed_destination,
+                   NULL);
 
 #ifdef Z_FEATURE_UNSTABLE_API
     z_source_info_drop(opt.source_info);
@@ -1090,6 +1105,7 @@ z_result_t z_declare_publisher(const z_loaned_session_t *zs, z_owned_publisher_t
         if (final_key._id != Z_RESOURCE_ID_NONE) {
             _z_undeclare_resource(_Z_RC_IN_VAL(zs), final_key._id);
         }
+        _z_slice_clear(&int_pub._put_header);
         return res;
     }
     pub->_val = int_pub;
@@ -1195,9 +1211,11 @@ z_result_t _z_publisher_put_impl(const z_loaned_publisher_t *pub, z_moved_bytes_
 #endif
             !_z_write_filter_active(&pub->_filter)) {
             // Write value
+            // The pre-encoded header holds the publisher encoding
+            const _z_slice_t *put_header = (opt.encoding == NULL) ? &pub->_put_header : NULL;
             ret = _z_write(session, &pub_keyexpr, payload_bytes, &encoding, Z_SAMPLE_KIND_PUT, pub->_congestion_control,
                            pub->_priority, pub->_is_express, opt.timestamp, attachment_bytes, reliability, source_info,
-                           pub->_allowed_destination);
+                           pub->_allowed_destination, put_header);
         }
     } else {
         _Z_ERROR_LOG(_Z_ERR_SESSION_CLOSED);
@@ -1269,7 +1287,7 @@ z_result_t _z_publisher_delete_impl(const z_loaned_publisher_t *pub, const z_pub
         !_z_write_filter_active(&pub->_filter)) {
         ret =
             _z_write(session, &pub_keyexpr, NULL, NULL, Z_SAMPLE_KIND_DELETE, pub->_congestion_control, pub->_priority,
-                     pub->_is_express, opt.timestamp, NULL, reliability, source_info, pub->_allowed_destination);
+                     pub->_is_express, opt.timestamp, NULL, reliability, source_info, pub->_allowed_destination, NULL);
     }
 #if Z_FEATURE_ADVANCED_PUBLICATION == 1
     if (cache != NULL) {
@@ -2265,6 +2283,7 @@ z_result_t z_undeclare_matching_listener(z_moved_matching_listener_t *listener)
 void zp_task_read_options_default(zp_task_read_options_t *options) {
 #if Z_FEATURE_MULTI_THREAD == 1
     options->task_attributes = NULL;
+    options->worker_count = 1;
 #else
     options->__dummy = 0;
 #endif
@@ -2278,7 +2297,7 @@ z_result_t zp_start_read_task(z_loaned_session_t *zs, const zp_task_read_options
     if (options != NULL) {
         opt = *options;
     }
-    return _zp_start_read_task(_Z_RC_IN_VAL(zs), opt.task_attributes);
+    return _zp_start_read_task(_Z_RC_IN_VAL(zs), opt.task_attributes, opt.worker_count);
 #else
     (void)(zs);
     return -1;
@@ -2326,6 +2345,23 @@ z_result_t zp_stop_lease_task(z_loaned_session_t *zs) {
 #endif
 }
 
+#ifdef Z_FEATURE_UNSTABLE_API
+z_result_t zp_tx_queue_stats(const z_loaned_session_t *zs, zp_tx_queue_stats_t *stats) {
+#if defined(_Z_TX_QUEUE)
+    _z_transport_common_t *ztc = _z_transport_get_common(&_Z_RC_IN_VAL(zs)->_tp);
+    if ((ztc == NULL) || (ztc->_tx_queue == NULL)) {
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
+    }
+    _z_transport_tx_queue_stats(ztc, &stats->depth, &stats->dropped);
+    return _Z_RES_OK;
+#else
+    _ZP_UNUSED(zs);
+    _ZP_UNUSED(stats);
+    _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
+#endif
+}
+#endif
+
 #ifdef Z_FEATURE_UNSTABLE_API
 #if Z_FEATURE_PERIODIC_TASKS == 1
 void zp_task_periodic_scheduler_options_default(zp_task_periodic_scheduler_options_t *options) {
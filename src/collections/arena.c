@@ -0,0 +1,39 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/arena.h"
+
+#include "zenoh-pico/system/common/platform.h"
+
+#define _Z_ARENA_ALIGN ((size_t)8)
+
+void *_z_arena_alloc(_z_arena_t *arena, size_t size) {
+    size_t start = (arena->_len + _Z_ARENA_ALIGN - 1) & ~(_Z_ARENA_ALIGN - 1);
+    if ((size == 0) || (start > arena->_capacity) || (size > arena->_capacity - start)) {
+        return NULL;
+    }
+    if (arena->_buf == NULL) {
+        arena->_buf = (uint8_t *)z_malloc(arena->_capacity);
+        if (arena->_buf == NULL) {
+            return NULL;
+        }
+    }
+    arena->_len = start + size;
+    return arena->_buf + start;
+}
+
+void _z_arena_clear(_z_arena_t *arena) {
+    z_free(arena->_buf);
+    *arena = _z_arena_null();
+}
@@ -14,14 +14,23 @@
 
 #include "zenoh-pico/collections/fifo_mt.h"
 
+#include <string.h>
+
 #include "zenoh-pico/protocol/codec/core.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/result.h"
 
 /*-------- Fifo Buffer Multithreaded --------*/
-z_result_t _z_fifo_mt_init(_z_fifo_mt_t *fifo, size_t capacity) {
+z_result_t _z_fifo_mt_init(_z_fifo_mt_t *fifo, size_t capacity, size_t elem_size) {
     _Z_RETURN_IF_ERR(_z_fifo_init(&fifo->_fifo, capacity))
+    // One slot per underlying ring position, including the one kept free
+    fifo->_slots = (uint8_t *)z_malloc(elem_size * fifo->_fifo._ring._capacity);
+    if (fifo->_slots == NULL) {
+        _z_fifo_clear(&fifo->_fifo, NULL);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    fifo->_elem_size = elem_size;
     fifo->is_closed = false;
 
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -33,14 +42,14 @@ z_result_t _z_fifo_mt_init(_z_fifo_mt_t *fifo, size_t capacity) {
     return _Z_RES_OK;
 }
 
-_z_fifo_mt_t *_z_fifo_mt_new(size_t capacity) {
+_z_fifo_mt_t *_z_fifo_mt_new(size_t capacity, size_t elem_size) {
     _z_fifo_mt_t *fifo = (_z_fifo_mt_t *)z_malloc(sizeof(_z_fifo_mt_t));
     if (fifo == NULL) {
         _Z_ERROR("z_malloc failed");
         return NULL;
     }
 
-    z_result_t ret = _z_fifo_mt_init(fifo, capacity);
+    z_result_t ret = _z_fifo_mt_init(fifo, capacity, elem_size);
     if (ret != _Z_RES_OK) {
         _Z_ERROR("_z_fifo_mt_init failed: %i", ret);
         z_free(fifo);
@@ -58,6 +67,8 @@ void _z_fifo_mt_clear(_z_fifo_mt_t *fifo, z_element_free_f free_f) {
 #endif
 
     _z_fifo_clear(&fifo->_fifo, free_f);
+    z_free(fifo->_slots);
+    fifo->_slots = NULL;
 }
 
 void _z_fifo_mt_free(_z_fifo_mt_t *fifo, z_element_free_f free_f) {
@@ -65,6 +76,13 @@ void _z_fifo_mt_free(_z_fifo_mt_t *fifo, z_element_free_f free_f) {
     z_free(fifo);
 }
 
+// Copies an element in the slot of the next write position, fifo must not be full
+static void *_z_fifo_mt_store(_z_fifo_mt_t *f, const void *elem) {
+    uint8_t *slot = &f->_slots[f->_fifo._ring._w_idx * f->_elem_size];
+    memcpy(slot, elem, f->_elem_size);
+    return slot;
+}
+
 z_result_t _z_fifo_mt_push(const void *elem, void *context, z_element_free_f element_free) {
     _ZP_UNUSED(element_free);
     if (elem == NULL || context == NULL) {
@@ -75,17 +93,19 @@ z_result_t _z_fifo_mt_push(const void *elem, void *context, z_element_free_f ele
 
 #if Z_FEATURE_MULTI_THREAD == 1
     _Z_RETURN_IF_ERR(_z_mutex_lock(&f->_mutex))
-    while (elem != NULL) {
-        elem = _z_fifo_push(&f->_fifo, (void *)elem);
-        if (elem != NULL) {
-            _Z_RETURN_IF_ERR(_z_condvar_wait(&f->_cv_not_full, &f->_mutex))
-        } else {
-            _Z_RETURN_IF_ERR(_z_condvar_signal(&f->_cv_not_empty))
-        }
+    while (_z_fifo_is_full(&f->_fifo)) {
+        _Z_RETURN_IF_ERR(_z_condvar_wait(&f->_cv_not_full, &f->_mutex))
     }
+    _z_fifo_push(&f->_fifo, _z_fifo_mt_store(f, elem));
+    _Z_RETURN_IF_ERR(_z_condvar_signal(&f->_cv_not_empty))
     _Z_RETURN_IF_ERR(_z_mutex_unlock(&f->_mutex))
 #else   // Z_FEATURE_MULTI_THREAD == 1
-    _z_fifo_push_drop(&f->_fifo, (void *)elem, element_free);
+    if (_z_fifo_is_full(&f->_fifo)) {
+        void *dropped = (void *)elem;
+        element_free(&dropped);
+    } else {
+        _z_fifo_push(&f->_fifo, _z_fifo_mt_store(f, elem));
+    }
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
     return _Z_RES_OK;
@@ -115,12 +135,13 @@ z_result_t _z_fifo_mt_pull(void *dst, void *context, z_element_move_f element_mo
             if (f->is_closed) break;
             _Z_RETURN_IF_ERR(_z_condvar_wait(&f->_cv_not_empty, &f->_mutex))
         } else {
+            // Move out before releasing the lock, the slot can be reused by the next push
+            element_move(dst, src);
             _Z_RETURN_IF_ERR(_z_condvar_signal(&f->_cv_not_full))
         }
     }
     _Z_RETURN_IF_ERR(_z_mutex_unlock(&f->_mutex))
     if (f->is_closed && src == NULL) return _Z_RES_CHANNEL_CLOSED;
-    element_move(dst, src);
 #else   // Z_FEATURE_MULTI_THREAD == 1
     void *src = _z_fifo_pull(&f->_fifo);
     if (src != NULL) {
@@ -141,20 +162,19 @@ z_result_t _z_fifo_mt_try_pull(void *dst, void *context, z_element_move_f elemen
     _Z_RETURN_IF_ERR(_z_mutex_lock(&f->_mutex))
     src = _z_fifo_pull(&f->_fifo);
     if (src != NULL) {
+        element_move(dst, src);
         _Z_RETURN_IF_ERR(_z_condvar_signal(&f->_cv_not_full))
     }
     _Z_RETURN_IF_ERR(_z_mutex_unlock(&f->_mutex))
 #else   // Z_FEATURE_MULTI_THREAD == 1
     void *src = _z_fifo_pull(&f->_fifo);
-#endif  // Z_FEATURE_MULTI_THREAD == 1
-
     if (src != NULL) {
         element_move(dst, src);
-    } else if (f->is_closed) {
-        return _Z_RES_CHANNEL_CLOSED;
-    } else {
-        return _Z_RES_CHANNEL_NODATA;
     }
+#endif  // Z_FEATURE_MULTI_THREAD == 1
 
+    if (src == NULL) {
+        return f->is_closed ? _Z_RES_CHANNEL_CLOSED : _Z_RES_CHANNEL_NODATA;
+    }
     return _Z_RES_OK;
 }
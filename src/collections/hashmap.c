@@ -21,8 +21,102 @@
 #include "zenoh-pico/utils/logging.h"
 
 /*-------- hashmap --------*/
+// The load factor is kept at or below 3/4, so that probe sequences stay short and always end on a free slot
+#define _Z_HASHMAP_LOAD_NUM 3
+#define _Z_HASHMAP_LOAD_DEN 4
+
+static size_t _z_hashmap_round_capacity(size_t capacity) {
+    size_t ret = 1;
+    while (ret < capacity) {
+        ret <<= 1;
+    }
+    return ret;
+}
+
+static inline bool _z_hashmap_is_overloaded(size_t len, size_t capacity) {
+    return (len * _Z_HASHMAP_LOAD_DEN) > (capacity * _Z_HASHMAP_LOAD_NUM);
+}
+
+// Distance of the entry of slot idx to its home slot
+static inline size_t _z_hashmap_dist(const _z_hashmap_t *map, size_t hash, size_t idx) {
+    return (idx - hash) & (map->_capacity - 1);
+}
+
+static _z_hashmap_slot_t *_z_hashmap_alloc_slots(size_t capacity) {
+    size_t len = capacity * sizeof(_z_hashmap_slot_t);
+    _z_hashmap_slot_t *slots = (_z_hashmap_slot_t *)z_malloc(len);
+    if (slots != NULL) {
+        (void)memset(slots, 0, len);
+    }
+    return slots;
+}
+
+// Places an entry, ahead of the entries of the same key and of the entries closer to their home slot
+static void _z_hashmap_place(_z_hashmap_t *map, size_t hash, _z_hashmap_entry_t *entry) {
+    size_t mask = map->_capacity - 1;
+    size_t idx = hash & mask;
+    size_t dist = 0;
+    while (map->_vals[idx]._entry != NULL) {
+        _z_hashmap_slot_t *slot = &map->_vals[idx];
+        size_t slot_dist = _z_hashmap_dist(map, slot->_hash, idx);
+        if ((slot_dist < dist) ||
+            ((slot_dist == dist) && (slot->_hash == hash) && map->_f_equals(slot->_entry, entry))) {
+            _z_hashmap_slot_t tmp = *slot;
+            slot->_hash = hash;
+            slot->_entry = entry;
+            hash = tmp._hash;
+            entry = tmp._entry;
+            dist = slot_dist;
+        }
+        idx = (idx + 1) & mask;
+        dist++;
+    }
+    map->_vals[idx]._hash = hash;
+    map->_vals[idx]._entry = entry;
+}
+
+// Returns the slot of the first entry of key k accepted by f_equals, or capacity if there is none
+static size_t _z_hashmap_find(const _z_hashmap_t *map, const void *k, z_element_eq_f f_equals) {
+    if (map->_vals == NULL) {
+        return map->_capacity;
+    }
+    _z_hashmap_entry_t e;
+    e._key = (void *)k;  // k will not be mutated by this operation
+    e._val = NULL;
+
+    size_t mask = map->_capacity - 1;
+    size_t hash = map->_f_hash(k);
+    size_t idx = hash & mask;
+    for (size_t dist = 0;; dist++) {
+        const _z_hashmap_slot_t *slot = &map->_vals[idx];
+        if ((slot->_entry == NULL) || (_z_hashmap_dist(map, slot->_hash, idx) < dist)) {
+            return map->_capacity;
+        }
+        if ((slot->_hash == hash) && f_equals(slot->_entry, &e)) {
+            return idx;
+        }
+        idx = (idx + 1) & mask;
+    }
+}
+
+// Removes the entry of slot idx and shifts the following displaced entries back
+static void _z_hashmap_remove_at(_z_hashmap_t *map, size_t idx, z_element_free_f f) {
+    size_t mask = map->_capacity - 1;
+    f((void **)&map->_vals[idx]._entry);
+    size_t next = (idx + 1) & mask;
+    while ((map->_vals[next]._entry != NULL) && (_z_hashmap_dist(map, map->_vals[next]._hash, next) > 0)) {
+        map->_vals[idx] = map->_vals[next];
+        idx = next;
+        next = (next + 1) & mask;
+    }
+    map->_vals[idx]._hash = 0;
+    map->_vals[idx]._entry = NULL;
+    map->_len--;
+}
+
 void _z_hashmap_init(_z_hashmap_t *map, size_t capacity, z_element_hash_f f_hash, z_element_eq_f f_equals) {
-    map->_capacity = capacity;
+    map->_capacity = _z_hashmap_round_capacity(capacity);
+    map->_len = 0;
     map->_vals = NULL;
     map->_f_hash = f_hash;
     map->_f_equals = f_equals;
@@ -36,50 +130,42 @@ _z_hashmap_t _z_hashmap_make(size_t capacity, z_element_hash_f f_hash, z_element
 
 size_t _z_hashmap_capacity(const _z_hashmap_t *map) { return map->_capacity; }
 
-size_t _z_hashmap_len(const _z_hashmap_t *map) {
-    size_t len = 0;
-
-    if (map->_vals != NULL) {
-        for (size_t idx = 0; idx < map->_capacity; idx++) {
-            len = len + _z_list_len(map->_vals[idx]);
-        }
-    }
-
-    return len;
-}
-
 z_result_t _z_hashmap_copy(_z_hashmap_t *dst, const _z_hashmap_t *src, z_element_clone_f f_c) {
     assert((dst != NULL) && (src != NULL) && (dst->_capacity == src->_capacity));
+    dst->_f_hash = src->_f_hash;
+    dst->_f_equals = src->_f_equals;
+    if (src->_vals == NULL) {
+        return _Z_RES_OK;
+    }
+    if (dst->_vals == NULL) {
+        dst->_vals = _z_hashmap_alloc_slots(dst->_capacity);
+        if (dst->_vals == NULL) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+    }
+    // Same capacity and hashes, the entries keep their slots
     for (size_t idx = 0; idx < src->_capacity; idx++) {
-        const _z_list_t *src_list = src->_vals[idx];
-        if (src_list == NULL) {
+        const _z_hashmap_slot_t *slot = &src->_vals[idx];
+        if (slot->_entry == NULL) {
             continue;
         }
-        // Allocate entry
-        dst->_vals[idx] = _z_list_clone(src_list, f_c);
-        if (dst->_vals[idx] == NULL) {
+        _z_hashmap_entry_t *entry = (_z_hashmap_entry_t *)f_c(slot->_entry);
+        if (entry == NULL) {
             _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
         }
+        dst->_vals[idx]._hash = slot->_hash;
+        dst->_vals[idx]._entry = entry;
+        dst->_len++;
     }
-    dst->_f_hash = src->_f_hash;
-    dst->_f_equals = src->_f_equals;
     return _Z_RES_OK;
 }
 
 _z_hashmap_t _z_hashmap_clone(const _z_hashmap_t *src, z_element_clone_f f_c, z_element_free_f f_f) {
-    _z_hashmap_t dst = {
-        ._capacity = src->_capacity, ._vals = NULL, ._f_hash = src->_f_hash, ._f_equals = src->_f_equals};
-    if (src->_vals == NULL) {
-        return dst;
-    }
-    // Lazily allocate and initialize to NULL all the pointers
-    size_t len = dst._capacity * sizeof(_z_list_t *);
-    dst._vals = (_z_list_t **)z_malloc(len);
-    if (dst._vals == NULL) {
-        return dst;
-    }
-    (void)memset(dst._vals, 0, len);
-    // Copy elements
+    _z_hashmap_t dst = {._capacity = src->_capacity,
+                        ._len = 0,
+                        ._vals = NULL,
+                        ._f_hash = src->_f_hash,
+                        ._f_equals = src->_f_equals};
     if (_z_hashmap_copy(&dst, src, f_c) != _Z_RES_OK) {
         // Free the map
         _z_hashmap_clear(&dst, f_f);
@@ -87,80 +173,122 @@ _z_hashmap_t _z_hashmap_clone(const _z_hashmap_t *src, z_element_clone_f f_c, z_
     return dst;
 }
 
-bool _z_hashmap_is_empty(const _z_hashmap_t *map) { return _z_hashmap_len(map) == (size_t)0; }
-
 void _z_hashmap_remove(_z_hashmap_t *map, const void *k, z_element_free_f f) {
-    if (map->_vals != NULL) {
-        size_t idx = map->_f_hash(k) % map->_capacity;
-        _z_hashmap_entry_t e;
-        e._key = (void *)k;  // k will not be mutated by this operation
-        e._val = NULL;
+    size_t idx = _z_hashmap_find(map, k, map->_f_equals);
+    if (idx < map->_capacity) {
+        _z_hashmap_remove_at(map, idx, f);
+    }
+}
 
-        map->_vals[idx] = _z_list_drop_filter(map->_vals[idx], f, map->_f_equals, &e, true);
+// Remove the first entry of the key matching f_equals instead of the map equality function
+void _z_hashmap_remove_filter(_z_hashmap_t *map, const void *k, z_element_eq_f f_equals, z_element_free_f f) {
+    size_t idx = _z_hashmap_find(map, k, f_equals);
+    if (idx < map->_capacity) {
+        _z_hashmap_remove_at(map, idx, f);
     }
 }
 
 void *_z_hashmap_insert(_z_hashmap_t *map, void *k, void *v, z_element_free_f f_f, bool replace) {
     if (map->_vals == NULL) {
-        // Lazily allocate and initialize to NULL all the pointers
-        size_t len = map->_capacity * sizeof(_z_list_t *);
-        map->_vals = (_z_list_t **)z_malloc(len);
-        if (map->_vals != NULL) {
-            (void)memset(map->_vals, 0, len);
+        // Lazily allocate the slots
+        map->_vals = _z_hashmap_alloc_slots(map->_capacity);
+        if (map->_vals == NULL) {
+            return NULL;
         }
     }
+    if (replace) {
+        // Free any old value
+        _z_hashmap_remove(map, k, f_f);
+    }
+    if (_z_hashmap_is_overloaded(map->_len + 1, map->_capacity) &&
+        (_z_hashmap_rehash(map, map->_capacity * 2) != _Z_RES_OK) && (map->_len + 1 >= map->_capacity)) {
+        // Probes need a free slot to stop on
+        return NULL;
+    }
 
-    if (map->_vals != NULL) {
-        if (replace) {
-            // Free any old value
-            _z_hashmap_remove(map, k, f_f);
-        }
-
-        // Insert the element
-        _z_hashmap_entry_t *entry = (_z_hashmap_entry_t *)z_malloc(sizeof(_z_hashmap_entry_t));
-        if (entry != NULL) {
-            entry->_key = k;
-            entry->_val = v;
-
-            size_t idx = map->_f_hash(k) % map->_capacity;
-            map->_vals[idx] = _z_list_push(map->_vals[idx], entry);
-        }
+    // Insert the element
+    _z_hashmap_entry_t *entry = (_z_hashmap_entry_t *)z_malloc(sizeof(_z_hashmap_entry_t));
+    if (entry == NULL) {
+        return NULL;
     }
+    entry->_key = k;
+    entry->_val = v;
+    _z_hashmap_place(map, map->_f_hash(k), entry);
+    map->_len++;
 
     return v;
 }
 
 void *_z_hashmap_get(const _z_hashmap_t *map, const void *k) {
-    void *ret = NULL;
-
-    if (map->_vals != NULL) {
-        size_t idx = map->_f_hash(k) % map->_capacity;
-
-        _z_hashmap_entry_t e;
-        e._key = (void *)k;  // k will not be mutated by this operation
-        e._val = NULL;
+    size_t idx = _z_hashmap_find(map, k, map->_f_equals);
+    return (idx < map->_capacity) ? map->_vals[idx]._entry->_val : NULL;
+}
 
-        _z_list_t *xs = _z_list_find(map->_vals[idx], map->_f_equals, &e);
-        if (xs != NULL) {
-            _z_hashmap_entry_t *h = (_z_hashmap_entry_t *)_z_list_value(xs);
-            ret = h->_val;
+_z_list_t *_z_hashmap_get_all(const _z_hashmap_t *map, const void *k) {
+    size_t idx = _z_hashmap_find(map, k, map->_f_equals);
+    if (idx == map->_capacity) {
+        return NULL;
+    }
+    // Entries of the same key follow each other in the probe sequence, with the ones of other keys in between
+    _z_hashmap_entry_t e;
+    e._key = (void *)k;  // k will not be mutated by this operation
+    e._val = NULL;
+    size_t mask = map->_capacity - 1;
+    size_t hash = map->_vals[idx]._hash;
+    size_t dist = _z_hashmap_dist(map, hash, idx);
+    _z_list_t *xs = NULL;
+    _z_list_t *tail = NULL;
+    while ((map->_vals[idx]._entry != NULL) && (_z_hashmap_dist(map, map->_vals[idx]._hash, idx) >= dist)) {
+        const _z_hashmap_slot_t *slot = &map->_vals[idx];
+        if ((slot->_hash == hash) && map->_f_equals(slot->_entry, &e)) {
+            // Returns the new node on an empty list and tail otherwise
+            _z_list_t *l = _z_list_push_after(tail, slot->_entry);
+            if (l == NULL) {
+                _z_list_free(&xs, _z_noop_free);
+                return NULL;
+            }
+            if (xs == NULL) {
+                xs = l;
+            }
+            tail = (tail == NULL) ? l : _z_list_next(tail);
         }
+        idx = (idx + 1) & mask;
+        dist++;
     }
-
-    return ret;
+    return xs;
 }
 
-_z_list_t *_z_hashmap_get_all(const _z_hashmap_t *map, const void *k) {
-    if (map->_vals != NULL) {
-        size_t idx = map->_f_hash(k) % map->_capacity;
-
-        _z_hashmap_entry_t e;
-        e._key = (void *)k;  // k will not be mutated by this operation
-        e._val = NULL;
-
-        return _z_list_find(map->_vals[idx], map->_f_equals, &e);
+z_result_t _z_hashmap_rehash(_z_hashmap_t *map, size_t capacity) {
+    capacity = _z_hashmap_round_capacity(capacity);
+    while (_z_hashmap_is_overloaded(map->_len, capacity) || (map->_len >= capacity)) {
+        capacity <<= 1;
+    }
+    if (map->_vals == NULL) {
+        map->_capacity = capacity;
+        return _Z_RES_OK;
+    }
+    _z_hashmap_slot_t *vals = _z_hashmap_alloc_slots(capacity);
+    if (vals == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    _z_hashmap_slot_t *old_vals = map->_vals;
+    size_t old_capacity = map->_capacity;
+    map->_vals = vals;
+    map->_capacity = capacity;
+    // Entries are placed ahead of the ones of their key, walk the probe sequences backward from a free slot so that
+    // entries sharing a key keep their order
+    size_t start = 0;
+    while (old_vals[start]._entry != NULL) {
+        start++;
     }
-    return NULL;
+    for (size_t i = 1; i <= old_capacity; i++) {
+        const _z_hashmap_slot_t *slot = &old_vals[(start - i) & (old_capacity - 1)];
+        if (slot->_entry != NULL) {
+            _z_hashmap_place(map, slot->_hash, slot->_entry);
+        }
+    }
+    z_free(old_vals);
+    return _Z_RES_OK;
 }
 
 _z_hashmap_iterator_t _z_hashmap_iterator_make(const _z_hashmap_t *map) {
@@ -172,25 +300,36 @@ _z_hashmap_iterator_t _z_hashmap_iterator_make(const _z_hashmap_t *map) {
 }
 
 bool _z_hashmap_iterator_next(_z_hashmap_iterator_t *iter) {
-    if (iter->_map->_vals == NULL) {
+    const _z_hashmap_t *map = iter->_map;
+    if (map->_vals == NULL) {
         return false;
     }
-
-    while (iter->_idx < iter->_map->_capacity) {
-        if (iter->_list_ptr == NULL) {
-            iter->_list_ptr = iter->_map->_vals[iter->_idx];
-        } else {
-            iter->_list_ptr = _z_list_next(iter->_list_ptr);
+    size_t mask = map->_capacity - 1;
+    size_t offset = iter->_idx;
+    if (offset == 0) {
+        // Start after a free slot: removals shift entries back but never into it, so no entry crosses the start of
+        // the walk and none is returned twice
+        size_t start = 0;
+        while (map->_vals[start]._entry != NULL) {
+            start++;
         }
-        if (iter->_list_ptr == NULL) {
-            iter->_idx++;
-            continue;
+        iter->_start = start;
+        offset = 1;
+    } else if ((iter->_entry != NULL) && (map->_vals[(iter->_start + offset) & mask]._entry == iter->_entry)) {
+        // The previous entry stays in its slot unless it was removed, the next one may have been shifted back into it
+        offset++;
+    }
+    while (offset < map->_capacity) {
+        _z_hashmap_entry_t *entry = map->_vals[(iter->_start + offset) & mask]._entry;
+        if (entry != NULL) {
+            iter->_idx = offset;
+            iter->_entry = entry;
+            return true;
         }
-
-        iter->_entry = iter->_list_ptr->_val;
-
-        return true;
+        offset++;
     }
+    iter->_idx = offset;
+    iter->_entry = NULL;
     return false;
 }
 
@@ -201,12 +340,15 @@ void *_z_hashmap_iterator_value(const _z_hashmap_iterator_t *iter) { return iter
 void _z_hashmap_clear(_z_hashmap_t *map, z_element_free_f f_f) {
     if (map->_vals != NULL) {
         for (size_t idx = 0; idx < map->_capacity; idx++) {
-            _z_list_free(&map->_vals[idx], f_f);
+            if (map->_vals[idx]._entry != NULL) {
+                f_f((void **)&map->_vals[idx]._entry);
+            }
         }
 
         z_free(map->_vals);
         map->_vals = NULL;
     }
+    map->_len = 0;
 }
 
 void _z_hashmap_free(_z_hashmap_t **map, z_element_free_f f) {
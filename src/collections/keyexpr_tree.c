@@ -0,0 +1,435 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/keyexpr_tree.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "zenoh-pico/system/common/platform.h"
+#include "zenoh-pico/utils/hash.h"
+#include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
+
+#define _Z_KEYEXPR_TREE_VISITED_INLINE 16
+
+// Visited nodes are tracked by the lookup itself so that concurrent lookups can share a tree
+typedef struct {
+    const char *key;
+    size_t len;
+    _z_keyexpr_tree_visit_f f;
+    void *ctx;
+    const _z_keyexpr_tree_node_t *visited[_Z_KEYEXPR_TREE_VISITED_INLINE];
+    size_t visited_len;
+    _z_list_t *visited_more;
+} _z_keyexpr_tree_visit_ctx_t;
+
+/*------------------ Chunks ------------------*/
+// A position greater than the key length means there are no more chunks
+static inline size_t _z_keyexpr_tree_chunk_end(const char *key, size_t len, size_t pos) {
+    const char *end = (const char *)memchr(_z_cptr_char_offset(key, (ptrdiff_t)pos), '/', len - pos);
+    return (end == NULL) ? len : (size_t)(end - key);
+}
+
+static uint8_t _z_keyexpr_tree_chunk_kind(const char *chunk, size_t len) {
+    if (len == 0) {
+        return _Z_KEYEXPR_TREE_CHUNK_VERBATIM;
+    }
+    if ((len == 2) && (chunk[0] == '*') && (chunk[1] == '*')) {
+        return _Z_KEYEXPR_TREE_CHUNK_DOUBLE_WILD;
+    }
+    if (memchr(chunk, '*', len) != NULL) {
+        return _Z_KEYEXPR_TREE_CHUNK_WILD;
+    }
+    return _Z_KEYEXPR_TREE_CHUNK_VERBATIM;
+}
+
+/*------------------ Nodes ------------------*/
+static size_t _z_keyexpr_tree_node_hash(const void *key) {
+    const _z_string_t *chunk = &((const _z_keyexpr_tree_node_t *)key)->_chunk;
+    size_t hash = _Z_FNV_OFFSET_BASIS;
+    const uint8_t *data = (const uint8_t *)_z_string_data(chunk);
+    for (size_t i = 0; i < _z_string_len(chunk); i++) {
+        hash = _z_hash_combine(hash, (size_t)data[i]);
+    }
+    return hash;
+}
+
+static bool _z_keyexpr_tree_node_eq(const void *left, const void *right) {
+    const _z_keyexpr_tree_node_t *l = (const _z_keyexpr_tree_node_t *)((const _z_hashmap_entry_t *)left)->_key;
+    const _z_keyexpr_tree_node_t *r = (const _z_keyexpr_tree_node_t *)((const _z_hashmap_entry_t *)right)->_key;
+    return _z_string_equals(&l->_chunk, &r->_chunk);
+}
+
+static bool _z_keyexpr_tree_ptr_eq(const void *left, const void *right) { return left == right; }
+
+static _z_keyexpr_tree_node_t *_z_keyexpr_tree_node_new(_z_keyexpr_tree_node_t *parent, const char *chunk,
+                                                        size_t len) {
+    _z_keyexpr_tree_node_t *node = (_z_keyexpr_tree_node_t *)z_malloc(sizeof(_z_keyexpr_tree_node_t));
+    if (node == NULL) {
+        return NULL;
+    }
+    node->_chunk = _z_string_null();
+    if (len > 0) {
+        node->_chunk = _z_string_copy_from_substr(chunk, len);
+        if (!_z_string_check(&node->_chunk)) {
+            z_free(node);
+            return NULL;
+        }
+    }
+    node->_parent = parent;
+    _z_hashmap_init(&node->_verbatim, _Z_KEYEXPR_TREE_NODE_CAPACITY, _z_keyexpr_tree_node_hash,
+                    _z_keyexpr_tree_node_eq);
+    node->_wilds = NULL;
+    node->_values = NULL;
+    node->_kind = _z_keyexpr_tree_chunk_kind(chunk, len);
+    return node;
+}
+
+static void _z_keyexpr_tree_node_free(_z_keyexpr_tree_node_t **node);
+
+static void _z_keyexpr_tree_node_elem_free(void **e) {
+    _z_keyexpr_tree_node_t *node = (_z_keyexpr_tree_node_t *)*e;
+    _z_keyexpr_tree_node_free(&node);
+    *e = NULL;
+}
+
+static void _z_keyexpr_tree_entry_free(void **e) {
+    _z_hashmap_entry_t *entry = (_z_hashmap_entry_t *)*e;
+    if (entry != NULL) {
+        _z_keyexpr_tree_node_elem_free(&entry->_key);
+        z_free(entry);
+        *e = NULL;
+    }
+}
+
+static void _z_keyexpr_tree_entry_free_shallow(void **e) {
+    z_free(*e);
+    *e = NULL;
+}
+
+static void _z_keyexpr_tree_node_free(_z_keyexpr_tree_node_t **node) {
+    _z_keyexpr_tree_node_t *ptr = *node;
+    if (ptr != NULL) {
+        _z_hashmap_clear(&ptr->_verbatim, _z_keyexpr_tree_entry_free);
+        _z_list_free(&ptr->_wilds, _z_keyexpr_tree_node_elem_free);
+        _z_list_free(&ptr->_values, _z_noop_free);
+        _z_string_clear(&ptr->_chunk);
+        z_free(ptr);
+        *node = NULL;
+    }
+}
+
+static _z_keyexpr_tree_node_t *_z_keyexpr_tree_node_get_child(const _z_keyexpr_tree_node_t *node, const char *chunk,
+                                                              size_t len) {
+    if (_z_keyexpr_tree_chunk_kind(chunk, len) == _Z_KEYEXPR_TREE_CHUNK_VERBATIM) {
+        _z_keyexpr_tree_node_t probe;
+        probe._chunk = _z_string_alias_substr(chunk, len);
+        return (_z_keyexpr_tree_node_t *)_z_hashmap_get(&node->_verbatim, &probe);
+    }
+    _z_string_t target = _z_string_alias_substr(chunk, len);
+    _z_list_t *xs = node->_wilds;
+    while (xs != NULL) {
+        _z_keyexpr_tree_node_t *child = (_z_keyexpr_tree_node_t *)_z_list_value(xs);
+        if (_z_string_equals(&child->_chunk, &target)) {
+            return child;
+        }
+        xs = _z_list_next(xs);
+    }
+    return NULL;
+}
+
+static _z_keyexpr_tree_node_t *_z_keyexpr_tree_node_add_child(_z_keyexpr_tree_node_t *node, const char *chunk,
+                                                              size_t len) {
+    _z_keyexpr_tree_node_t *child = _z_keyexpr_tree_node_new(node, chunk, len);
+    if (child == NULL) {
+        return NULL;
+    }
+    if (child->_kind == _Z_KEYEXPR_TREE_CHUNK_VERBATIM) {
+        _z_hashmap_insert(&node->_verbatim, child, child, _z_keyexpr_tree_entry_free_shallow, false);
+        if (_z_hashmap_get(&node->_verbatim, child) != child) {
+            _z_keyexpr_tree_node_free(&child);
+        }
+    } else {
+        _z_list_t *wilds = _z_list_push(node->_wilds, child);
+        if (wilds == node->_wilds) {
+            _z_keyexpr_tree_node_free(&child);
+        } else {
+            node->_wilds = wilds;
+        }
+    }
+    return child;
+}
+
+static bool _z_keyexpr_tree_node_is_empty(const _z_keyexpr_tree_node_t *node) {
+    return (node->_values == NULL) && (node->_wilds == NULL) && _z_hashmap_is_empty(&node->_verbatim);
+}
+
+static void _z_keyexpr_tree_node_detach(_z_keyexpr_tree_node_t *node) {
+    _z_keyexpr_tree_node_t *parent = node->_parent;
+    if (node->_kind == _Z_KEYEXPR_TREE_CHUNK_VERBATIM) {
+        _z_hashmap_remove(&parent->_verbatim, node, _z_keyexpr_tree_entry_free_shallow);
+    } else {
+        parent->_wilds = _z_list_drop_filter(parent->_wilds, _z_noop_free, _z_keyexpr_tree_ptr_eq, node, true);
+    }
+    _z_keyexpr_tree_node_free(&node);
+}
+
+/*------------------ Tree ------------------*/
+void _z_keyexpr_tree_init(_z_keyexpr_tree_t *tree) {
+    tree->_root = NULL;
+    tree->_len = 0;
+}
+
+z_result_t _z_keyexpr_tree_insert(_z_keyexpr_tree_t *tree, const _z_string_t *key, void *val) {
+    if (tree->_root == NULL) {
+        tree->_root = _z_keyexpr_tree_node_new(NULL, NULL, 0);
+        _Z_RETURN_ERR_OOM_IF_TRUE(tree->_root == NULL);
+    }
+    const char *data = _z_string_data(key);
+    size_t len = _z_string_len(key);
+    _z_keyexpr_tree_node_t *node = tree->_root;
+    size_t pos = (len == 0) ? 1 : 0;
+    while (pos <= len) {
+        size_t end = _z_keyexpr_tree_chunk_end(data, len, pos);
+        const char *chunk = _z_cptr_char_offset(data, (ptrdiff_t)pos);
+        _z_keyexpr_tree_node_t *child = _z_keyexpr_tree_node_get_child(node, chunk, end - pos);
+        if (child == NULL) {
+            child = _z_keyexpr_tree_node_add_child(node, chunk, end - pos);
+            _Z_RETURN_ERR_OOM_IF_TRUE(child == NULL);
+        }
+        node = child;
+        pos = end + 1;
+    }
+    _z_list_t *values = _z_list_push(node->_values, val);
+    _Z_RETURN_ERR_OOM_IF_TRUE(values == node->_values);
+    node->_values = values;
+    tree->_len++;
+    return _Z_RES_OK;
+}
+
+void *_z_keyexpr_tree_remove_if(_z_keyexpr_tree_t *tree, const _z_string_t *key, z_element_eq_f eq,
+                                const void *arg) {
+    if (tree->_root == NULL) {
+        return NULL;
+    }
+    const char *data = _z_string_data(key);
+    size_t len = _z_string_len(key);
+    _z_keyexpr_tree_node_t *node = tree->_root;
+    size_t pos = (len == 0) ? 1 : 0;
+    while ((node != NULL) && (pos <= len)) {
+        size_t end = _z_keyexpr_tree_chunk_end(data, len, pos);
+        node = _z_keyexpr_tree_node_get_child(node, _z_cptr_char_offset(data, (ptrdiff_t)pos), end - pos);
+        pos = end + 1;
+    }
+    _z_list_t *entry = (node != NULL) ? _z_list_find(node->_values, eq, arg) : NULL;
+    if (entry == NULL) {
+        return NULL;
+    }
+    void *val = _z_list_value(entry);
+    node->_values = _z_list_drop_filter(node->_values, _z_noop_free, _z_keyexpr_tree_ptr_eq, val, true);
+    tree->_len--;
+    // Prune the branches left empty
+    while ((node != tree->_root) && _z_keyexpr_tree_node_is_empty(node)) {
+        _z_keyexpr_tree_node_t *parent = node->_parent;
+        _z_keyexpr_tree_node_detach(node);
+        node = parent;
+    }
+    return val;
+}
+
+bool _z_keyexpr_tree_remove(_z_keyexpr_tree_t *tree, const _z_string_t *key, const void *val) {
+    return _z_keyexpr_tree_remove_if(tree, key, _z_keyexpr_tree_ptr_eq, val) != NULL;
+}
+
+// A node can be reached through several paths when '**' are involved, only its first visit reports its values
+static bool _z_keyexpr_tree_mark_visited(_z_keyexpr_tree_visit_ctx_t *ctx, const _z_keyexpr_tree_node_t *node) {
+    for (size_t i = 0; i < ctx->visited_len; i++) {
+        if (ctx->visited[i] == node) {
+            return false;
+        }
+    }
+    if (_z_list_find(ctx->visited_more, _z_keyexpr_tree_ptr_eq, node) != NULL) {
+        return false;
+    }
+    if (ctx->visited_len < _Z_KEYEXPR_TREE_VISITED_INLINE) {
+        ctx->visited[ctx->visited_len++] = node;
+    } else {
+        // Out of memory only means that a later path may report the node again
+        ctx->visited_more = _z_list_push(ctx->visited_more, (void *)node);
+    }
+    return true;
+}
+
+static void _z_keyexpr_tree_collect(_z_keyexpr_tree_visit_ctx_t *ctx, const _z_keyexpr_tree_node_t *node) {
+    if ((node->_values == NULL) || !_z_keyexpr_tree_mark_visited(ctx, node)) {
+        return;
+    }
+    _z_list_t *xs = node->_values;
+    while (xs != NULL) {
+        ctx->f(_z_list_value(xs), ctx->ctx);
+        xs = _z_list_next(xs);
+    }
+}
+
+static void _z_keyexpr_tree_visit(_z_keyexpr_tree_visit_ctx_t *ctx, _z_keyexpr_tree_node_t *node, size_t pos) {
+    if (pos > ctx->len) {
+        _z_keyexpr_tree_collect(ctx, node);
+        // '**' matches zero chunks
+        _z_list_t *xs = node->_wilds;
+        while (xs != NULL) {
+            _z_keyexpr_tree_node_t *child = (_z_keyexpr_tree_node_t *)_z_list_value(xs);
+            if (child->_kind == _Z_KEYEXPR_TREE_CHUNK_DOUBLE_WILD) {
+                _z_keyexpr_tree_visit(ctx, child, pos);
+            }
+            xs = _z_list_next(xs);
+        }
+        return;
+    }
+    size_t end = _z_keyexpr_tree_chunk_end(ctx->key, ctx->len, pos);
+    const char *chunk = _z_cptr_char_offset(ctx->key, (ptrdiff_t)pos);
+    uint8_t kind = _z_keyexpr_tree_chunk_kind(chunk, end - pos);
+    size_t next = end + 1;
+
+    if (kind == _Z_KEYEXPR_TREE_CHUNK_DOUBLE_WILD) {
+        // Incoming '**' matches zero chunks or absorbs the chunk of every child
+        _z_keyexpr_tree_visit(ctx, node, next);
+        _z_hashmap_iterator_t it = _z_hashmap_iterator_make(&node->_verbatim);
+        while (_z_hashmap_iterator_next(&it)) {
+            _z_keyexpr_tree_visit(ctx, (_z_keyexpr_tree_node_t *)_z_hashmap_iterator_key(&it), pos);
+        }
+        _z_list_t *xs = node->_wilds;
+        while (xs != NULL) {
+            _z_keyexpr_tree_visit(ctx, (_z_keyexpr_tree_node_t *)_z_list_value(xs), pos);
+            xs = _z_list_next(xs);
+        }
+        return;
+    }
+    // A '**' node absorbs the incoming chunk
+    if (node->_kind == _Z_KEYEXPR_TREE_CHUNK_DOUBLE_WILD) {
+        _z_keyexpr_tree_visit(ctx, node, next);
+    }
+    if (kind == _Z_KEYEXPR_TREE_CHUNK_WILD) {
+        _z_hashmap_iterator_t it = _z_hashmap_iterator_make(&node->_verbatim);
+        while (_z_hashmap_iterator_next(&it)) {
+            _z_keyexpr_tree_visit(ctx, (_z_keyexpr_tree_node_t *)_z_hashmap_iterator_key(&it), next);
+        }
+    } else {
+        _z_keyexpr_tree_node_t *child = _z_keyexpr_tree_node_get_child(node, chunk, end - pos);
+        if (child != NULL) {
+            _z_keyexpr_tree_visit(ctx, child, next);
+        }
+    }
+    _z_list_t *xs = node->_wilds;
+    while (xs != NULL) {
+        _z_keyexpr_tree_node_t *child = (_z_keyexpr_tree_node_t *)_z_list_value(xs);
+        // '**' matching zero chunks, chunk absorption is handled when visiting it
+        _z_keyexpr_tree_visit(ctx, child, (child->_kind == _Z_KEYEXPR_TREE_CHUNK_DOUBLE_WILD) ? pos : next);
+        xs = _z_list_next(xs);
+    }
+}
+
+void _z_keyexpr_tree_intersect(const _z_keyexpr_tree_t *tree, const _z_string_t *key, _z_keyexpr_tree_visit_f f,
+                               void *ctx) {
+    if (tree->_root == NULL) {
+        return;
+    }
+    _z_keyexpr_tree_visit_ctx_t visit_ctx = {
+        .key = _z_string_data(key), .len = _z_string_len(key), .f = f, .ctx = ctx, .visited_len = 0,
+        .visited_more = NULL};
+    _z_keyexpr_tree_visit(&visit_ctx, tree->_root, (visit_ctx.len == 0) ? 1 : 0);
+    _z_list_free(&visit_ctx.visited_more, _z_noop_free);
+}
+
+void _z_keyexpr_tree_clear(_z_keyexpr_tree_t *tree) {
+    _z_keyexpr_tree_node_free(&tree->_root);
+    tree->_len = 0;
+}
+
+/*------------------ Read-mostly tree ------------------*/
+z_result_t _z_keyexpr_tree_rcu_init(_z_keyexpr_tree_rcu_t *tree) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _Z_RETURN_IF_ERR(_z_mutex_init(&tree->_mutex));
+#endif
+    _z_keyexpr_tree_init(&tree->_trees[0]);
+    _z_keyexpr_tree_init(&tree->_trees[1]);
+    _z_rcu_init(&tree->_rcu, &tree->_trees[0]);
+    return _Z_RES_OK;
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+static void _z_keyexpr_tree_rcu_lock(_z_keyexpr_tree_rcu_t *tree) { _z_mutex_lock(&tree->_mutex); }
+static void _z_keyexpr_tree_rcu_unlock(_z_keyexpr_tree_rcu_t *tree) { _z_mutex_unlock(&tree->_mutex); }
+#else
+static void _z_keyexpr_tree_rcu_lock(_z_keyexpr_tree_rcu_t *tree) { _ZP_UNUSED(tree); }
+static void _z_keyexpr_tree_rcu_unlock(_z_keyexpr_tree_rcu_t *tree) { _ZP_UNUSED(tree); }
+#endif
+
+// Writer side, the copy readers can't access
+static inline _z_keyexpr_tree_t *_z_keyexpr_tree_rcu_spare(_z_keyexpr_tree_rcu_t *tree, _z_keyexpr_tree_t *cur) {
+    return (cur == &tree->_trees[0]) ? &tree->_trees[1] : &tree->_trees[0];
+}
+
+z_result_t _z_keyexpr_tree_rcu_insert(_z_keyexpr_tree_rcu_t *tree, const _z_string_t *key, void *val) {
+    _z_keyexpr_tree_rcu_lock(tree);
+    _z_keyexpr_tree_t *cur = (_z_keyexpr_tree_t *)_z_rcu_get(&tree->_rcu);
+    _z_keyexpr_tree_t *next = _z_keyexpr_tree_rcu_spare(tree, cur);
+    z_result_t ret = _z_keyexpr_tree_insert(next, key, val);
+    if (ret == _Z_RES_OK) {
+        (void)_z_rcu_swap(&tree->_rcu, next);
+        ret = _z_keyexpr_tree_insert(cur, key, val);
+        if (ret != _Z_RES_OK) {
+            // Both copies must hold the same values, take it back out of the published one
+            (void)_z_rcu_swap(&tree->_rcu, cur);
+            (void)_z_keyexpr_tree_remove(next, key, val);
+        }
+    }
+    _z_keyexpr_tree_rcu_unlock(tree);
+    return ret;
+}
+
+void *_z_keyexpr_tree_rcu_remove_if(_z_keyexpr_tree_rcu_t *tree, const _z_string_t *key, z_element_eq_f eq,
+                                    const void *arg) {
+    _z_keyexpr_tree_rcu_lock(tree);
+    _z_keyexpr_tree_t *cur = (_z_keyexpr_tree_t *)_z_rcu_get(&tree->_rcu);
+    _z_keyexpr_tree_t *next = _z_keyexpr_tree_rcu_spare(tree, cur);
+    void *val = _z_keyexpr_tree_remove_if(next, key, eq, arg);
+    if (val != NULL) {
+        (void)_z_rcu_swap(&tree->_rcu, next);
+        (void)_z_keyexpr_tree_remove(cur, key, val);
+    }
+    _z_keyexpr_tree_rcu_unlock(tree);
+    return val;
+}
+
+void _z_keyexpr_tree_rcu_intersect(_z_keyexpr_tree_rcu_t *tree, const _z_string_t *key, _z_keyexpr_tree_visit_f f,
+                                   void *ctx) {
+    uint8_t phase;
+    const _z_keyexpr_tree_t *cur = (const _z_keyexpr_tree_t *)_z_rcu_read_lock(&tree->_rcu, &phase);
+    _z_keyexpr_tree_intersect(cur, key, f, ctx);
+    _z_rcu_read_unlock(&tree->_rcu, phase);
+}
+
+void _z_keyexpr_tree_rcu_clear(_z_keyexpr_tree_rcu_t *tree) {
+    _z_keyexpr_tree_rcu_lock(tree);
+    _z_keyexpr_tree_t *cur = (_z_keyexpr_tree_t *)_z_rcu_get(&tree->_rcu);
+    _z_keyexpr_tree_t *next = _z_keyexpr_tree_rcu_spare(tree, cur);
+    _z_keyexpr_tree_clear(next);
+    (void)_z_rcu_swap(&tree->_rcu, next);
+    _z_keyexpr_tree_clear(cur);
+    _z_keyexpr_tree_rcu_unlock(tree);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&tree->_mutex);
+#endif
+}
@@ -23,13 +23,17 @@
 #include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/result.h"
 
-// Nodes are chained as double linked list for lru insertion/deletion.
+// Nodes are chained as double linked list for lru insertion/deletion, and in the hash table bucket of their value.
 typedef struct _z_lru_cache_node_data_t {
-    _z_lru_cache_node_t *prev;  // List previous node
-    _z_lru_cache_node_t *next;  // List next node
+    _z_lru_cache_node_t *prev;     // List previous node
+    _z_lru_cache_node_t *next;     // List next node
+    _z_lru_cache_node_t *hnext;    // Bucket next node
+    _z_lru_cache_node_t **hpprev;  // Bucket link pointing to the node
+    size_t hash;                   // Hash of the value
 } _z_lru_cache_node_data_t;
 
-#define NODE_DATA_SIZE sizeof(_z_lru_cache_node_data_t)
+// Keep the values 8 bytes aligned on 32 bits targets
+#define NODE_DATA_SIZE ((sizeof(_z_lru_cache_node_data_t) + 7) & ~(size_t)7)
 
 // Generic static functions
 static inline _z_lru_cache_t _z_lru_cache_null(void) { return (_z_lru_cache_t){0}; }
@@ -114,117 +118,72 @@ static void _z_lru_cache_clear_list(_z_lru_cache_t *cache, z_element_clear_f cle
     }
 }
 
-// Sorted list function
-static _z_lru_cache_node_t *_z_lru_cache_search_slist(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f compare,
-                                                      size_t *idx) {
-    int l_idx = 0;
-    int h_idx = (int)cache->len - 1;
-    while (l_idx <= h_idx) {
-        int curr_idx = (l_idx + h_idx) / 2;
-        int res = compare(_z_lru_cache_node_value(cache->slist[curr_idx]), value);
-        if (res == 0) {
-            *idx = (size_t)curr_idx;
-            return cache->slist[curr_idx];
-        } else if (res < 0) {
-            l_idx = curr_idx + 1;
-        } else {
-            h_idx = curr_idx - 1;
-        }
+// Hash table functions
+static size_t _z_lru_cache_table_size(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
     }
-    return NULL;
+    return size;
 }
 
-static int _z_lru_cache_find_position(_z_lru_cache_node_t **slist, _z_lru_val_cmp_f compare, void *node_val,
-                                      size_t slist_size) {
-    int start = 0;
-    int end = (int)slist_size - 1;
-    while (start <= end) {
-        int mid = start + (end - start) / 2;
-        if (compare(_z_lru_cache_node_value(slist[mid]), node_val) < 0) {
-            start = mid + 1;
-        } else {
-            end = mid - 1;
-        }
+static void _z_lru_cache_insert_table_node(_z_lru_cache_t *cache, _z_lru_cache_node_t *node) {
+    _z_lru_cache_node_data_t *node_data = _z_lru_cache_node_data(node);
+    _z_lru_cache_node_t **bucket = &cache->table[node_data->hash & cache->table_mask];
+    node_data->hnext = *bucket;
+    if (node_data->hnext != NULL) {
+        _z_lru_cache_node_data(node_data->hnext)->hpprev = &node_data->hnext;
     }
-    return start;
+    node_data->hpprev = bucket;
+    *bucket = node;
 }
 
-static void _z_lru_cache_move_elem_slist(_z_lru_cache_t *cache, size_t *add_idx_addr, size_t *del_idx_addr) {
-    size_t del_idx = (del_idx_addr == NULL) ? cache->len : *del_idx_addr;
-    size_t add_idx = *add_idx_addr;
-    if (add_idx == del_idx) {
-        return;
-    }
-    // Move elements between the indices on the right
-    if (del_idx >= add_idx) {
-        memmove(&cache->slist[add_idx + 1], &cache->slist[add_idx],
-                (del_idx - add_idx) * sizeof(_z_lru_cache_node_t *));
-    } else {  // Move them on the left
-        // Rightmost value doesn't move unless we have a new maximum
-        if (add_idx != cache->capacity - 1) {
-            *add_idx_addr -= 1;
-            add_idx -= 1;
-        }
-        memmove(&cache->slist[del_idx], &cache->slist[del_idx + 1],
-                (add_idx - del_idx) * sizeof(_z_lru_cache_node_t *));
+static void _z_lru_cache_remove_table_node(_z_lru_cache_node_t *node) {
+    _z_lru_cache_node_data_t *node_data = _z_lru_cache_node_data(node);
+    *node_data->hpprev = node_data->hnext;
+    if (node_data->hnext != NULL) {
+        _z_lru_cache_node_data(node_data->hnext)->hpprev = node_data->hpprev;
     }
 }
 
-static void _z_lru_cache_insert_slist(_z_lru_cache_t *cache, _z_lru_cache_node_t *node, _z_lru_val_cmp_f compare,
-                                      size_t *del_idx) {
-    // Find insert position:
-    if (cache->len == 0) {
-        cache->slist[0] = node;
-        return;
+static _z_lru_cache_node_t *_z_lru_cache_search_table(_z_lru_cache_t *cache, void *value, size_t hash,
+                                                      z_element_eq_f equals) {
+    _z_lru_cache_node_t *node = cache->table[hash & cache->table_mask];
+    while (node != NULL) {
+        _z_lru_cache_node_data_t *node_data = _z_lru_cache_node_data(node);
+        if ((node_data->hash == hash) && equals(_z_lru_cache_node_value(node), value)) {
+            return node;
+        }
+        node = node_data->hnext;
     }
-    void *node_val = _z_lru_cache_node_value(node);
-    size_t pos = (size_t)_z_lru_cache_find_position(cache->slist, compare, node_val, cache->len);
-    // Move elements
-    _z_lru_cache_move_elem_slist(cache, &pos, del_idx);
-    // Store element
-    cache->slist[pos] = node;
-}
-
-static size_t _z_lru_cache_delete_slist(_z_lru_cache_t *cache, _z_lru_cache_node_t *node, _z_lru_val_cmp_f compare) {
-    size_t del_idx = 0;
-    // Don't delete, return the index
-    (void)_z_lru_cache_search_slist(cache, _z_lru_cache_node_value(node), compare, &del_idx);
-    return del_idx;
+    return NULL;
 }
 
 // Main static functions
-static size_t _z_lru_cache_delete_last(_z_lru_cache_t *cache, _z_lru_val_cmp_f compare) {
+static void _z_lru_cache_delete_last(_z_lru_cache_t *cache, z_element_clear_f clear) {
     _z_lru_cache_node_t *last = cache->tail;
     assert(last != NULL);
     _z_lru_cache_remove_list_node(cache, last);
-    size_t del_idx = _z_lru_cache_delete_slist(cache, last, compare);
+    _z_lru_cache_remove_table_node(last);
+    clear(_z_lru_cache_node_value(last));
     z_free(last);
     cache->len--;
-    return del_idx;
-}
-
-static void _z_lru_cache_insert_node(_z_lru_cache_t *cache, _z_lru_cache_node_t *node, _z_lru_val_cmp_f compare,
-                                     size_t *del_idx) {
-    _z_lru_cache_insert_list_node(cache, node);
-    _z_lru_cache_insert_slist(cache, node, compare, del_idx);
-    cache->len++;
-}
-
-static _z_lru_cache_node_t *_z_lru_cache_search_node(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f compare) {
-    size_t idx = 0;
-    return _z_lru_cache_search_slist(cache, value, compare, &idx);
 }
 
 // Public functions
 _z_lru_cache_t _z_lru_cache_init(size_t capacity) {
     _z_lru_cache_t cache = _z_lru_cache_null();
     cache.capacity = capacity;
+    cache.table_mask = _z_lru_cache_table_size(capacity) - 1;
     return cache;
 }
 
-void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f compare) {
+void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, z_element_hash_f hash, z_element_eq_f equals) {
+    if (cache->len == 0) {
+        return NULL;
+    }
     // Lookup if node exists.
-    _z_lru_cache_node_t *node = _z_lru_cache_search_node(cache, value, compare);
+    _z_lru_cache_node_t *node = _z_lru_cache_search_table(cache, value, hash(value), equals);
     if (node == NULL) {
         return NULL;
     }
@@ -233,38 +192,40 @@ void *_z_lru_cache_get(_z_lru_cache_t *cache, void *value, _z_lru_val_cmp_f comp
     return _z_lru_cache_node_value(node);
 }
 
-z_result_t _z_lru_cache_insert(_z_lru_cache_t *cache, void *value, size_t value_size, _z_lru_val_cmp_f compare) {
+z_result_t _z_lru_cache_insert(_z_lru_cache_t *cache, void *value, size_t value_size, z_element_hash_f hash,
+                               z_element_clear_f clear) {
     assert(cache->capacity > 0);
-    // Init slist
-    if (cache->slist == NULL) {
-        cache->slist = (_z_lru_cache_node_t **)z_malloc(cache->capacity * sizeof(void *));
-        if (cache->slist == NULL) {
+    // Init table
+    if (cache->table == NULL) {
+        size_t table_len = (cache->table_mask + 1) * sizeof(_z_lru_cache_node_t *);
+        cache->table = (_z_lru_cache_node_t **)z_malloc(table_len);
+        if (cache->table == NULL) {
             _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
         }
-        memset(cache->slist, 0, cache->capacity * sizeof(void *));
+        memset(cache->table, 0, table_len);
     }
     // Create node
     _z_lru_cache_node_t *node = _z_lru_cache_node_create(value, value_size);
-    size_t *del_idx_addr = NULL;
-    size_t del_idx = 0;
     if (node == NULL) {
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
+    _z_lru_cache_node_data(node)->hash = hash(value);
     // Check capacity
     if (cache->len == cache->capacity) {
         // Delete lru entry
-        del_idx = _z_lru_cache_delete_last(cache, compare);
-        del_idx_addr = &del_idx;
+        _z_lru_cache_delete_last(cache, clear);
     }
     // Update the cache
-    _z_lru_cache_insert_node(cache, node, compare, del_idx_addr);
+    _z_lru_cache_insert_list_node(cache, node);
+    _z_lru_cache_insert_table_node(cache, node);
+    cache->len++;
     return _Z_RES_OK;
 }
 
 void _z_lru_cache_clear(_z_lru_cache_t *cache, z_element_clear_f clear) {
-    // Reset slist
-    if (cache->slist != NULL) {
-        memset(cache->slist, 0, cache->capacity * sizeof(void *));
+    // Reset table
+    if (cache->table != NULL) {
+        memset(cache->table, 0, (cache->table_mask + 1) * sizeof(_z_lru_cache_node_t *));
     }
     // Clear list
     _z_lru_cache_clear_list(cache, clear);
@@ -276,6 +237,6 @@ void _z_lru_cache_clear(_z_lru_cache_t *cache, z_element_clear_f clear) {
 
 void _z_lru_cache_delete(_z_lru_cache_t *cache, z_element_clear_f clear) {
     _z_lru_cache_clear(cache, clear);
-    z_free(cache->slist);
-    cache->slist = NULL;
+    z_free(cache->table);
+    cache->table = NULL;
 }
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/rcu.h"
+
+#if Z_FEATURE_MULTI_THREAD == 1
+#if ZENOH_C_STANDARD != 99
+
+// Sequentially consistent, a reader's counter increment and value load must be ordered with the writer's value store
+// and phase flip
+#include <stdatomic.h>
+#define _Z_RCU_LOAD(p) atomic_load(p)
+#define _Z_RCU_STORE(p, v) atomic_store(p, v)
+#define _Z_RCU_INCR(p) (void)atomic_fetch_add(p, (size_t)1)
+#define _Z_RCU_DECR(p) (void)atomic_fetch_sub(p, (size_t)1)
+
+#elif defined(ZENOH_COMPILER_GCC)
+
+// c99 gcc sync builtin variant
+#define _Z_RCU_LOAD(p) __sync_fetch_and_add(p, 0)
+#define _Z_RCU_STORE(p, v)    \
+    do {                      \
+        __sync_synchronize(); \
+        *(p) = (v);           \
+        __sync_synchronize(); \
+    } while (0)
+#define _Z_RCU_INCR(p) (void)__sync_fetch_and_add(p, (size_t)1)
+#define _Z_RCU_DECR(p) (void)__sync_fetch_and_sub(p, (size_t)1)
+
+#else
+#error "Multi-thread rcu cell in C99 only exists for GCC, use GCC or C11 or deactivate multi-thread"
+#endif
+
+#define _Z_RCU_WAIT_US 10
+
+static void _z_rcu_wait_readers(_z_rcu_t *rcu, uint8_t phase) {
+    while (_Z_RCU_LOAD(&rcu->_readers[phase]) != 0) {
+        z_sleep_us(_Z_RCU_WAIT_US);
+    }
+}
+
+void _z_rcu_init(_z_rcu_t *rcu, void *val) {
+    _Z_RCU_STORE(&rcu->_val, val);
+    _Z_RCU_STORE(&rcu->_readers[0], (size_t)0);
+    _Z_RCU_STORE(&rcu->_readers[1], (size_t)0);
+    _Z_RCU_STORE(&rcu->_phase, (uint8_t)0);
+}
+
+void *_z_rcu_read_lock(_z_rcu_t *rcu, uint8_t *phase) {
+    *phase = _Z_RCU_LOAD(&rcu->_phase);
+    _Z_RCU_INCR(&rcu->_readers[*phase]);
+    return _Z_RCU_LOAD(&rcu->_val);
+}
+
+void _z_rcu_read_unlock(_z_rcu_t *rcu, uint8_t phase) { _Z_RCU_DECR(&rcu->_readers[phase]); }
+
+void *_z_rcu_get(_z_rcu_t *rcu) { return _Z_RCU_LOAD(&rcu->_val); }
+
+void *_z_rcu_swap(_z_rcu_t *rcu, void *val) {
+    void *prev = _Z_RCU_LOAD(&rcu->_val);
+    _Z_RCU_STORE(&rcu->_val, val);
+    uint8_t phase = _Z_RCU_LOAD(&rcu->_phase);
+    // Readers that loaded the phase before the previous flip may have registered in the other counter after the
+    // previous writer stopped waiting on it, and still hold the value that writer published
+    _z_rcu_wait_readers(rcu, (uint8_t)(phase ^ 1));
+    _Z_RCU_STORE(&rcu->_phase, (uint8_t)(phase ^ 1));
+    _z_rcu_wait_readers(rcu, phase);
+    return prev;
+}
+
+#else  // Z_FEATURE_MULTI_THREAD == 0
+void _z_rcu_init(_z_rcu_t *rcu, void *val) {
+    rcu->_val = val;
+    rcu->_readers[0] = 0;
+    rcu->_readers[1] = 0;
+    rcu->_phase = 0;
+}
+
+void *_z_rcu_read_lock(_z_rcu_t *rcu, uint8_t *phase) {
+    *phase = 0;
+    return rcu->_val;
+}
+
+void _z_rcu_read_unlock(_z_rcu_t *rcu, uint8_t phase) {
+    _ZP_UNUSED(rcu);
+    _ZP_UNUSED(phase);
+}
+
+void *_z_rcu_get(_z_rcu_t *rcu) { return rcu->_val; }
+
+void *_z_rcu_swap(_z_rcu_t *rcu, void *val) {
+    void *prev = rcu->_val;
+    rcu->_val = val;
+    return prev;
+}
+#endif  // Z_FEATURE_MULTI_THREAD == 1
@@ -14,13 +14,22 @@
 
 #include "zenoh-pico/collections/ring_mt.h"
 
+#include <string.h>
+
 #include "zenoh-pico/protocol/codec/core.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/utils/logging.h"
 
 /*-------- Ring Buffer Multithreaded --------*/
-z_result_t _z_ring_mt_init(_z_ring_mt_t *ring, size_t capacity) {
+z_result_t _z_ring_mt_init(_z_ring_mt_t *ring, size_t capacity, size_t elem_size) {
     _Z_RETURN_IF_ERR(_z_ring_init(&ring->_ring, capacity))
+    // One slot per ring position, including the one kept free
+    ring->_slots = (uint8_t *)z_malloc(elem_size * ring->_ring._capacity);
+    if (ring->_slots == NULL) {
+        _z_ring_clear(&ring->_ring, NULL);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    ring->_elem_size = elem_size;
 
 #if Z_FEATURE_MULTI_THREAD == 1
     _Z_RETURN_IF_ERR(_z_mutex_init(&ring->_mutex))
@@ -30,14 +39,14 @@ z_result_t _z_ring_mt_init(_z_ring_mt_t *ring, size_t capacity) {
     return _Z_RES_OK;
 }
 
-_z_ring_mt_t *_z_ring_mt_new(size_t capacity) {
+_z_ring_mt_t *_z_ring_mt_new(size_t capacity, size_t elem_size) {
     _z_ring_mt_t *ring = (_z_ring_mt_t *)z_malloc(sizeof(_z_ring_mt_t));
     if (ring == NULL) {
         _Z_ERROR("z_malloc failed");
         return NULL;
     }
 
-    z_result_t ret = _z_ring_mt_init(ring, capacity);
+    z_result_t ret = _z_ring_mt_init(ring, capacity, elem_size);
     if (ret != _Z_RES_OK) {
         _Z_ERROR("_z_ring_mt_init failed: %i", ret);
         return NULL;
@@ -53,6 +62,8 @@ void _z_ring_mt_clear(_z_ring_mt_t *ring, z_element_free_f free_f) {
 #endif
 
     _z_ring_clear(&ring->_ring, free_f);
+    z_free(ring->_slots);
+    ring->_slots = NULL;
 }
 
 void _z_ring_mt_free(_z_ring_mt_t *ring, z_element_free_f free_f) {
@@ -61,6 +72,13 @@ void _z_ring_mt_free(_z_ring_mt_t *ring, z_element_free_f free_f) {
     z_free(ring);
 }
 
+// Copies an element in the slot of the next write position, which is always free
+static void *_z_ring_mt_store(_z_ring_mt_t *r, const void *elem) {
+    uint8_t *slot = &r->_slots[r->_ring._w_idx * r->_elem_size];
+    memcpy(slot, elem, r->_elem_size);
+    return slot;
+}
+
 z_result_t _z_ring_mt_push(const void *elem, void *context, z_element_free_f element_free) {
     if (elem == NULL || context == NULL) {
         _Z_ERROR_RETURN(_Z_ERR_GENERIC);
@@ -72,7 +90,7 @@ z_result_t _z_ring_mt_push(const void *elem, void *context, z_element_free_f ele
     _Z_RETURN_IF_ERR(_z_mutex_lock(&r->_mutex))
 #endif
 
-    _z_ring_push_force_drop(&r->_ring, (void *)elem, element_free);
+    _z_ring_push_force_drop(&r->_ring, _z_ring_mt_store(r, elem), element_free);
 
 #if Z_FEATURE_MULTI_THREAD == 1
     _Z_RETURN_IF_ERR(_z_condvar_signal(&r->_cv_not_empty))
@@ -104,21 +122,23 @@ z_result_t _z_ring_mt_pull(void *dst, void *context, z_element_move_f element_mo
         if (src == NULL) {
             if (r->is_closed) break;
             _Z_RETURN_IF_ERR(_z_condvar_wait(&r->_cv_not_empty, &r->_mutex))
+        } else {
+            // Move out before releasing the lock, the slot can be reused by the next push
+            element_move(dst, src);
         }
     }
     _Z_RETURN_IF_ERR(_z_mutex_unlock(&r->_mutex))
 #else   // Z_FEATURE_MULTI_THREAD == 1
     void *src = _z_ring_pull(&r->_ring);
+    if (src != NULL) {
+        element_move(dst, src);
+    }
 #endif  // Z_FEATURE_MULTI_THREAD == 1
 
     if (r->is_closed && src == NULL) {
         return _Z_RES_CHANNEL_CLOSED;
     }
 
-    if (src != NULL) {
-        element_move(dst, src);
-    }
-
     return _Z_RES_OK;
 }
 
@@ -130,17 +150,16 @@ z_result_t _z_ring_mt_try_pull(void *dst, void *context, z_element_move_f elemen
 #endif
 
     void *src = _z_ring_pull(&r->_ring);
+    if (src != NULL) {
+        element_move(dst, src);
+    }
 
 #if Z_FEATURE_MULTI_THREAD == 1
     _Z_RETURN_IF_ERR(_z_mutex_unlock(&r->_mutex))
 #endif
 
-    if (src != NULL) {
-        element_move(dst, src);
-    } else if (r->is_closed) {
-        return _Z_RES_CHANNEL_CLOSED;
-    } else {
-        return _Z_RES_CHANNEL_NODATA;
+    if (src == NULL) {
+        return r->is_closed ? _Z_RES_CHANNEL_CLOSED : _Z_RES_CHANNEL_NODATA;
     }
     return _Z_RES_OK;
 }
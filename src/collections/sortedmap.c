@@ -21,8 +21,88 @@
 #include "zenoh-pico/utils/logging.h"
 
 /*-------- sortedmap --------*/
+#define _Z_SORTEDMAP_SEED 0x9e3779b9U
+
+/**
+ * A node of the skip list. The entry is its first member, so that freeing an entry frees its node.
+ *
+ * Members:
+ *   _z_sortedmap_entry_t _entry: the entry of the node
+ *   uint8_t _level: the number of levels the node is linked on
+ *   struct _z_sortedmap_node_t *_next: the next node on each level
+ */
+typedef struct _z_sortedmap_node_t {
+    _z_sortedmap_entry_t _entry;
+    uint8_t _level;
+    struct _z_sortedmap_node_t *_next[];
+} _z_sortedmap_node_t;
+
+static _z_sortedmap_node_t *_z_sortedmap_node_new(uint8_t level) {
+    size_t len = sizeof(_z_sortedmap_node_t) + (size_t)level * sizeof(_z_sortedmap_node_t *);
+    _z_sortedmap_node_t *node = (_z_sortedmap_node_t *)z_malloc(len);
+    if (node != NULL) {
+        (void)memset(node, 0, len);
+        node->_level = level;
+    }
+    return node;
+}
+
+static void _z_sortedmap_node_free(_z_sortedmap_node_t *node, z_element_free_f f) {
+    void *entry = &node->_entry;
+    f(&entry);
+}
+
+static bool _z_sortedmap_alloc_head(_z_sortedmap_t *map) {
+    if (map->_head == NULL) {
+        map->_head = _z_sortedmap_node_new(_Z_SORTEDMAP_MAX_LEVEL);
+    }
+    return map->_head != NULL;
+}
+
+// Draws the number of levels of a new node, each level above the first with a probability of 1/4
+static uint8_t _z_sortedmap_random_level(_z_sortedmap_t *map) {
+    uint32_t x = map->_seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    map->_seed = x;
+    uint8_t level = 1;
+    while ((level < _Z_SORTEDMAP_MAX_LEVEL) && ((x & 3U) == 0)) {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+// Returns the first node with a key not lower than k, and fills path with the last node before it on each level
+static _z_sortedmap_node_t *_z_sortedmap_find(const _z_sortedmap_t *map, const void *k, _z_sortedmap_node_t **path) {
+    _z_sortedmap_node_t *node = map->_head;
+    for (size_t l = map->_level; l-- > 0;) {
+        while ((node->_next[l] != NULL) && (map->_f_cmp(node->_next[l]->_entry._key, k) < 0)) {
+            node = node->_next[l];
+        }
+        if (path != NULL) {
+            path[l] = node;
+        }
+    }
+    return node->_next[0];
+}
+
+static void _z_sortedmap_unlink(_z_sortedmap_t *map, _z_sortedmap_node_t *node, _z_sortedmap_node_t **path) {
+    for (size_t l = 0; l < node->_level; l++) {
+        path[l]->_next[l] = node->_next[l];
+    }
+    while ((map->_level > 1) && (map->_head->_next[map->_level - 1] == NULL)) {
+        map->_level--;
+    }
+    map->_len--;
+}
+
 void _z_sortedmap_init(_z_sortedmap_t *map, z_element_cmp_f f_cmp) {
-    map->_vals = NULL;
+    map->_head = NULL;
+    map->_len = 0;
+    map->_seed = _Z_SORTEDMAP_SEED;
+    map->_level = 1;
     map->_f_cmp = f_cmp;
 }
 
@@ -32,27 +112,51 @@ _z_sortedmap_t _z_sortedmap_make(z_element_cmp_f f_cmp) {
     return map;
 }
 
-size_t _z_sortedmap_len(const _z_sortedmap_t *map) { return _z_list_len(map->_vals); }
-
-bool _z_sortedmap_is_empty(const _z_sortedmap_t *map) { return _z_sortedmap_len(map) == (size_t)0; }
-
 z_result_t _z_sortedmap_copy(_z_sortedmap_t *dst, const _z_sortedmap_t *src, z_element_clone_f f_c) {
     assert((dst != NULL) && (src != NULL));
-    if (src->_vals != NULL) {
-        dst->_vals = _z_list_clone(src->_vals, f_c);
-        if (dst->_vals == NULL) {
+    dst->_f_cmp = src->_f_cmp;
+    if (src->_len == 0) {
+        return _Z_RES_OK;
+    }
+    if (!_z_sortedmap_alloc_head(dst)) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    // Append the nodes after the last node of each level, with the same levels as the source
+    _z_sortedmap_node_t *tail[_Z_SORTEDMAP_MAX_LEVEL];
+    _z_sortedmap_node_t *last = dst->_head;
+    for (size_t l = _Z_SORTEDMAP_MAX_LEVEL; l-- > 0;) {
+        while (last->_next[l] != NULL) {
+            last = last->_next[l];
+        }
+        tail[l] = last;
+    }
+    for (const _z_sortedmap_node_t *curr = src->_head->_next[0]; curr != NULL; curr = curr->_next[0]) {
+        _z_sortedmap_node_t *node = _z_sortedmap_node_new(curr->_level);
+        if (node == NULL) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+        _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)f_c(&curr->_entry);
+        if (entry == NULL) {
+            z_free(node);
             _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
         }
+        node->_entry = *entry;
+        z_free(entry);
+        for (size_t l = 0; l < node->_level; l++) {
+            tail[l]->_next[l] = node;
+            tail[l] = node;
+        }
+        if (dst->_level < node->_level) {
+            dst->_level = node->_level;
+        }
+        dst->_len++;
     }
-    dst->_f_cmp = src->_f_cmp;
     return _Z_RES_OK;
 }
 
 _z_sortedmap_t _z_sortedmap_clone(const _z_sortedmap_t *src, z_element_clone_f f_c, z_element_free_f f_f) {
-    _z_sortedmap_t dst = {._vals = NULL, ._f_cmp = src->_f_cmp};
-    if (src->_vals == NULL) {
-        return dst;
-    }
+    _z_sortedmap_t dst = _z_sortedmap_make(src->_f_cmp);
+    dst._seed = src->_seed;
     if (_z_sortedmap_copy(&dst, src, f_c) != _Z_RES_OK) {
         // Free the map
         _z_sortedmap_clear(&dst, f_f);
@@ -61,120 +165,98 @@ _z_sortedmap_t _z_sortedmap_clone(const _z_sortedmap_t *src, z_element_clone_f f
 }
 
 void *_z_sortedmap_insert(_z_sortedmap_t *map, void *k, void *v, z_element_free_f f_f, bool replace) {
-    if (map == NULL) {
+    if ((map == NULL) || !_z_sortedmap_alloc_head(map)) {
         return NULL;
     }
 
-    _z_list_t *prev = NULL;
-    _z_list_t *curr = map->_vals;
-
-    while (curr != NULL) {
-        _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)_z_list_value(curr);
-        int cmp = map->_f_cmp(k, entry->_key);
-
-        if (cmp == 0) {
-            if (!replace) {
-                return NULL;
-            }
-            map->_vals = _z_list_drop_element(map->_vals, prev, f_f);
-            break;
-        } else if (cmp < 0) {
-            break;  // Found insertion point
+    _z_sortedmap_node_t *path[_Z_SORTEDMAP_MAX_LEVEL];
+    _z_sortedmap_node_t *curr = _z_sortedmap_find(map, k, path);
+    if ((curr != NULL) && (map->_f_cmp(k, curr->_entry._key) == 0)) {
+        if (!replace) {
+            return NULL;
         }
-
-        prev = curr;
-        curr = _z_list_next(curr);
+        // The nodes before the replaced one are the nodes before the new one
+        _z_sortedmap_unlink(map, curr, path);
+        _z_sortedmap_node_free(curr, f_f);
     }
 
-    _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)z_malloc(sizeof(_z_sortedmap_entry_t));
-    if (entry == NULL) {
+    uint8_t level = _z_sortedmap_random_level(map);
+    _z_sortedmap_node_t *node = _z_sortedmap_node_new(level);
+    if (node == NULL) {
         return NULL;
     }
-    entry->_key = k;
-    entry->_val = v;
-
-    if (prev == NULL) {
-        map->_vals = _z_list_push(map->_vals, entry);
-        if (map->_vals == NULL) {
-            z_free(entry);
-            return NULL;
-        }
-    } else {
-        _z_list_t *list = _z_list_push_after(prev, entry);
-        if (list == NULL) {
-            z_free(entry);
-            return NULL;
-        }
+    node->_entry._key = k;
+    node->_entry._val = v;
+    for (size_t l = map->_level; l < level; l++) {
+        path[l] = map->_head;
+    }
+    if (map->_level < level) {
+        map->_level = level;
     }
+    for (size_t l = 0; l < level; l++) {
+        node->_next[l] = path[l]->_next[l];
+        path[l]->_next[l] = node;
+    }
+    map->_len++;
 
     return v;
 }
 
 void *_z_sortedmap_get(const _z_sortedmap_t *map, const void *k) {
-    void *ret = NULL;
-
-    if (map->_vals != NULL) {
-        _z_list_t *l = map->_vals;
-        while (l != NULL) {
-            // Check if the key matches
-            _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)_z_list_value(l);
-            if (map->_f_cmp(k, entry->_key) == 0) {
-                ret = entry->_val;
-                break;
-            }
-            l = _z_list_next(l);
-        }
+    if (map->_head == NULL) {
+        return NULL;
+    }
+    _z_sortedmap_node_t *node = _z_sortedmap_find(map, k, NULL);
+    if ((node != NULL) && (map->_f_cmp(k, node->_entry._key) == 0)) {
+        return node->_entry._val;
     }
-    return ret;
+    return NULL;
 }
 
 _z_sortedmap_entry_t *_z_sortedmap_pop_first(_z_sortedmap_t *map) {
-    _z_sortedmap_entry_t *ret = NULL;
-
-    if (map->_vals != NULL) {
-        _z_list_t *l = map->_vals;
-        if (l != NULL) {
-            ret = (_z_sortedmap_entry_t *)_z_list_value(l);
-            map->_vals = _z_list_drop_element(map->_vals, NULL, _z_noop_free);
-        }
+    if ((map->_head == NULL) || (map->_head->_next[0] == NULL)) {
+        return NULL;
     }
-    return ret;
+    _z_sortedmap_node_t *node = map->_head->_next[0];
+    // The first node comes right after the head on all its levels
+    _z_sortedmap_node_t *path[_Z_SORTEDMAP_MAX_LEVEL];
+    for (size_t l = 0; l < node->_level; l++) {
+        path[l] = map->_head;
+    }
+    _z_sortedmap_unlink(map, node, path);
+    return &node->_entry;
 }
 
 void _z_sortedmap_remove(_z_sortedmap_t *map, const void *k, z_element_free_f f) {
-    if (map->_vals != NULL) {
-        _z_list_t *prev = NULL;
-        _z_list_t *curr = map->_vals;
-
-        while (curr != NULL) {
-            _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)_z_list_value(curr);
-            if (map->_f_cmp(k, entry->_key) == 0) {
-                map->_vals = _z_list_drop_element(map->_vals, prev, f);
-                break;
-            }
-            prev = curr;
-            curr = _z_list_next(curr);
-        }
+    if (map->_head == NULL) {
+        return;
+    }
+    _z_sortedmap_node_t *path[_Z_SORTEDMAP_MAX_LEVEL];
+    _z_sortedmap_node_t *node = _z_sortedmap_find(map, k, path);
+    if ((node != NULL) && (map->_f_cmp(k, node->_entry._key) == 0)) {
+        _z_sortedmap_unlink(map, node, path);
+        _z_sortedmap_node_free(node, f);
     }
 }
 
 _z_sortedmap_iterator_t _z_sortedmap_iterator_make(const _z_sortedmap_t *map) {
     _z_sortedmap_iterator_t iter = {0};
     iter._map = map;
-    iter._list_ptr = map->_vals;
     return iter;
 }
 
 bool _z_sortedmap_iterator_next(_z_sortedmap_iterator_t *iter) {
     if (!iter->_initialized) {
-        iter->_list_ptr = iter->_map->_vals;
+        iter->_node = (iter->_map->_head != NULL) ? iter->_map->_head->_next[0] : NULL;
         iter->_initialized = true;
-    } else if (iter->_list_ptr != NULL) {
-        iter->_list_ptr = _z_list_next(iter->_list_ptr);
+    } else {
+        iter->_node = iter->_next;
     }
 
-    if (iter->_list_ptr != NULL) {
-        iter->_entry = (_z_sortedmap_entry_t *)_z_list_value(iter->_list_ptr);
+    if (iter->_node != NULL) {
+        // The returned entry may be removed and its node freed before the next call
+        iter->_next = iter->_node->_next[0];
+        iter->_entry = &iter->_node->_entry;
         return true;
     }
 
@@ -186,10 +268,18 @@ void *_z_sortedmap_iterator_key(const _z_sortedmap_iterator_t *iter) { return it
 void *_z_sortedmap_iterator_value(const _z_sortedmap_iterator_t *iter) { return iter->_entry->_val; }
 
 void _z_sortedmap_clear(_z_sortedmap_t *map, z_element_free_f f_f) {
-    if (map->_vals != NULL) {
-        _z_list_free(&map->_vals, f_f);
-        map->_vals = NULL;
+    if (map->_head != NULL) {
+        _z_sortedmap_node_t *node = map->_head->_next[0];
+        while (node != NULL) {
+            _z_sortedmap_node_t *next = node->_next[0];
+            _z_sortedmap_node_free(node, f_f);
+            node = next;
+        }
+        z_free(map->_head);
+        map->_head = NULL;
     }
+    map->_len = 0;
+    map->_level = 1;
 }
 
 void _z_sortedmap_free(_z_sortedmap_t **map, z_element_free_f f) {
@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/spsc_mt.h"
+
+#include <string.h>
+
+#include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/result.h"
+
+#if Z_FEATURE_MULTI_THREAD == 1
+#if ZENOH_C_STANDARD != 99
+
+#include <stdatomic.h>
+#define _Z_SPSC_LOAD(p) atomic_load_explicit(p, memory_order_acquire)
+#define _Z_SPSC_STORE(p, v) atomic_store_explicit(p, v, memory_order_release)
+#define _Z_SPSC_FENCE() atomic_thread_fence(memory_order_seq_cst)
+// Updates expected with the current value on failure
+#define _Z_SPSC_CAS(p, expected, v) \
+    atomic_compare_exchange_weak_explicit(p, expected, v, memory_order_acq_rel, memory_order_acquire)
+
+#elif defined(ZENOH_COMPILER_GCC)
+
+// c99 gcc sync builtin variant
+#define _Z_SPSC_LOAD(p) __sync_fetch_and_add(p, 0)
+#define _Z_SPSC_STORE(p, v)   \
+    do {                      \
+        __sync_synchronize(); \
+        *(p) = (v);           \
+        __sync_synchronize(); \
+    } while (0)
+#define _Z_SPSC_FENCE() __sync_synchronize()
+static inline bool _z_spsc_cas(size_t *p, size_t *expected, size_t v) {
+    size_t prev = __sync_val_compare_and_swap(p, *expected, v);
+    bool ret = (prev == *expected);
+    *expected = prev;
+    return ret;
+}
+#define _Z_SPSC_CAS(p, expected, v) _z_spsc_cas(p, expected, v)
+
+#else
+#error "Multi-thread spsc ring in C99 only exists for GCC, use GCC or C11 or deactivate multi-thread"
+#endif
+
+#else  // Z_FEATURE_MULTI_THREAD == 0
+#define _Z_SPSC_LOAD(p) (*(p))
+#define _Z_SPSC_STORE(p, v) (*(p) = (v))
+#define _Z_SPSC_FENCE()
+static inline bool _z_spsc_cas(size_t *p, size_t *expected, size_t v) {
+    if (*p != *expected) {
+        *expected = *p;
+        return false;
+    }
+    *p = v;
+    return true;
+}
+#define _Z_SPSC_CAS(p, expected, v) _z_spsc_cas(p, expected, v)
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+static inline void *_z_spsc_mt_slot(_z_spsc_mt_t *s, size_t pos) { return &s->_slots[(pos & s->_mask) * s->_elem_size]; }
+
+// Returns true if the element at the given read position was written
+static inline bool _z_spsc_mt_is_written(_z_spsc_mt_t *s, size_t pos) {
+    return _Z_SPSC_LOAD(&s->_seqs[pos & s->_mask]) == pos + 1;
+}
+
+/*-------- Single Consumer Ring Buffer --------*/
+z_result_t _z_spsc_mt_init(_z_spsc_mt_t *spsc, size_t capacity, size_t elem_size) {
+    // Positions grow unbounded, a power of two slot number keeps their modulo continuous when they wrap
+    size_t slot_nb = 1;
+    while (slot_nb < capacity) {
+        slot_nb <<= 1;
+    }
+    spsc->_capacity = capacity;
+    spsc->_mask = slot_nb - 1;
+    spsc->_elem_size = elem_size;
+    spsc->_slots = (uint8_t *)z_malloc(elem_size * slot_nb);
+    spsc->_seqs = (_Z_SPSC_ATOMIC(size_t) *)z_malloc(sizeof(spsc->_seqs[0]) * slot_nb);
+    if ((spsc->_slots == NULL) || (spsc->_seqs == NULL)) {
+        z_free(spsc->_slots);
+        z_free((void *)spsc->_seqs);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    for (size_t i = 0; i < slot_nb; i++) {
+        _Z_SPSC_STORE(&spsc->_seqs[i], i);
+    }
+    _Z_SPSC_STORE(&spsc->_head, (size_t)0);
+    _Z_SPSC_STORE(&spsc->_tail, (size_t)0);
+    _Z_SPSC_STORE(&spsc->_parked, (uint8_t)0);
+    _Z_SPSC_STORE(&spsc->_is_closed, (uint8_t)0);
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    _Z_RETURN_IF_ERR(_z_mutex_init(&spsc->_mutex))
+    _Z_RETURN_IF_ERR(_z_condvar_init(&spsc->_cv_not_empty))
+#endif
+    return _Z_RES_OK;
+}
+
+_z_spsc_mt_t *_z_spsc_mt_new(size_t capacity, size_t elem_size) {
+    _z_spsc_mt_t *spsc = (_z_spsc_mt_t *)z_malloc(sizeof(_z_spsc_mt_t));
+    if (spsc == NULL) {
+        _Z_ERROR("z_malloc failed");
+        return NULL;
+    }
+
+    z_result_t ret = _z_spsc_mt_init(spsc, capacity, elem_size);
+    if (ret != _Z_RES_OK) {
+        _Z_ERROR("_z_spsc_mt_init failed: %i", ret);
+        z_free(spsc);
+        return NULL;
+    }
+
+    return spsc;
+}
+
+void _z_spsc_mt_clear(_z_spsc_mt_t *spsc, z_element_free_f free_f) {
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&spsc->_mutex);
+    _z_condvar_drop(&spsc->_cv_not_empty);
+#endif
+
+    size_t head = _Z_SPSC_LOAD(&spsc->_head);
+    for (size_t pos = _Z_SPSC_LOAD(&spsc->_tail); pos != head; pos++) {
+        if (_z_spsc_mt_is_written(spsc, pos)) {
+            void *e = _z_spsc_mt_slot(spsc, pos);
+            free_f(&e);
+        }
+    }
+    z_free(spsc->_slots);
+    z_free((void *)spsc->_seqs);
+    spsc->_slots = NULL;
+    spsc->_seqs = NULL;
+    spsc->_capacity = 0;
+}
+
+void _z_spsc_mt_free(_z_spsc_mt_t *spsc, z_element_free_f free_f) {
+    _z_spsc_mt_clear(spsc, free_f);
+    z_free(spsc);
+}
+
+z_result_t _z_spsc_mt_push(const void *elem, void *context, z_element_free_f element_free) {
+    if (elem == NULL || context == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+
+    _z_spsc_mt_t *s = (_z_spsc_mt_t *)context;
+    // Claim a position, its slot is free once the consumer released the element written a lap before
+    size_t pos = _Z_SPSC_LOAD(&s->_head);
+    for (;;) {
+        size_t seq = _Z_SPSC_LOAD(&s->_seqs[pos & s->_mask]);
+        if ((seq != pos) || ((pos - _Z_SPSC_LOAD(&s->_tail)) >= s->_capacity)) {
+            if ((seq == pos) || ((intptr_t)(seq - pos) < 0)) {
+                // Full, the oldest element belongs to the consumer so drop the new one
+                void *dropped = (void *)elem;
+                element_free(&dropped);
+                return _Z_RES_OK;
+            }
+            // Another producer claimed it
+            pos = _Z_SPSC_LOAD(&s->_head);
+        } else if (_Z_SPSC_CAS(&s->_head, &pos, pos + 1)) {
+            break;
+        }
+    }
+    memcpy(_z_spsc_mt_slot(s, pos), elem, s->_elem_size);
+    _Z_SPSC_STORE(&s->_seqs[pos & s->_mask], pos + 1);
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    // Pairs with the consumer parking: either it sees the element written or we see it parked
+    _Z_SPSC_FENCE();
+    if (_Z_SPSC_LOAD(&s->_parked) != 0) {
+        _Z_RETURN_IF_ERR(_z_mutex_lock(&s->_mutex))
+        // Only wake once, the next pushes must not contend with the waking consumer for the lock
+        if (_Z_SPSC_LOAD(&s->_parked) != 0) {
+            _Z_SPSC_STORE(&s->_parked, (uint8_t)0);
+            _Z_RETURN_IF_ERR(_z_condvar_signal(&s->_cv_not_empty))
+        }
+        _Z_RETURN_IF_ERR(_z_mutex_unlock(&s->_mutex))
+    }
+#endif
+    return _Z_RES_OK;
+}
+
+z_result_t _z_spsc_mt_close(_z_spsc_mt_t *spsc) {
+    _Z_SPSC_STORE(&spsc->_is_closed, (uint8_t)1);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _Z_RETURN_IF_ERR(_z_mutex_lock(&spsc->_mutex))
+    _Z_RETURN_IF_ERR(_z_condvar_signal_all(&spsc->_cv_not_empty))
+    _Z_RETURN_IF_ERR(_z_mutex_unlock(&spsc->_mutex))
+#endif
+    return _Z_RES_OK;
+}
+
+// Moves out the oldest element if any, closed state is read first so no element pushed before closing is missed
+static bool _z_spsc_mt_take(_z_spsc_mt_t *s, void *dst, z_element_move_f element_move, bool *is_closed) {
+    *is_closed = _Z_SPSC_LOAD(&s->_is_closed) != 0;
+    size_t tail = _Z_SPSC_LOAD(&s->_tail);
+    // A position claimed by a producer that didn't finish writing it is still empty
+    if (!_z_spsc_mt_is_written(s, tail)) {
+        return false;
+    }
+    element_move(dst, _z_spsc_mt_slot(s, tail));
+    // Free the slot for the position a lap later
+    _Z_SPSC_STORE(&s->_seqs[tail & s->_mask], tail + s->_mask + 1);
+    _Z_SPSC_STORE(&s->_tail, tail + 1);
+    return true;
+}
+
+z_result_t _z_spsc_mt_pull(void *dst, void *context, z_element_move_f element_move) {
+    _z_spsc_mt_t *s = (_z_spsc_mt_t *)context;
+    bool is_closed = false;
+
+#if Z_FEATURE_MULTI_THREAD == 1
+    while (!_z_spsc_mt_take(s, dst, element_move, &is_closed)) {
+        if (is_closed) {
+            return _Z_RES_CHANNEL_CLOSED;
+        }
+        _Z_RETURN_IF_ERR(_z_mutex_lock(&s->_mutex))
+        _Z_SPSC_STORE(&s->_parked, (uint8_t)1);
+        _Z_SPSC_FENCE();
+        if (!_z_spsc_mt_is_written(s, _Z_SPSC_LOAD(&s->_tail)) && (_Z_SPSC_LOAD(&s->_is_closed) == 0)) {
+            _Z_RETURN_IF_ERR(_z_condvar_wait(&s->_cv_not_empty, &s->_mutex))
+        }
+        _Z_SPSC_STORE(&s->_parked, (uint8_t)0);
+        _Z_RETURN_IF_ERR(_z_mutex_unlock(&s->_mutex))
+    }
+#else   // Z_FEATURE_MULTI_THREAD == 1
+    if (!_z_spsc_mt_take(s, dst, element_move, &is_closed) && is_closed) {
+        return _Z_RES_CHANNEL_CLOSED;
+    }
+#endif  // Z_FEATURE_MULTI_THREAD == 1
+
+    return _Z_RES_OK;
+}
+
+z_result_t _z_spsc_mt_try_pull(void *dst, void *context, z_element_move_f element_move) {
+    _z_spsc_mt_t *s = (_z_spsc_mt_t *)context;
+    bool is_closed = false;
+
+    if (!_z_spsc_mt_take(s, dst, element_move, &is_closed)) {
+        return is_closed ? _Z_RES_CHANNEL_CLOSED : _Z_RES_CHANNEL_NODATA;
+    }
+    return _Z_RES_OK;
+}
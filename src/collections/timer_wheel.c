@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/collections/timer_wheel.h"
+
+#include <string.h>
+
+#define _Z_TIMER_WHEEL_SLOT_MASK ((uint64_t)_Z_TIMER_WHEEL_SLOT_NB - 1)
+#define _Z_TIMER_WHEEL_RANGE ((uint64_t)1 << (_Z_TIMER_WHEEL_SLOT_BITS * _Z_TIMER_WHEEL_LEVEL_NB))
+
+void _z_timer_wheel_init(_z_timer_wheel_t *tw, uint64_t now) {
+    (void)memset(tw->_slots, 0, sizeof(tw->_slots));
+    tw->_now = now;
+    tw->_len = 0;
+}
+
+void _z_timer_wheel_clear(_z_timer_wheel_t *tw) {
+    (void)memset(tw->_slots, 0, sizeof(tw->_slots));
+    tw->_len = 0;
+}
+
+static void _z_timer_wheel_link(_z_timer_wheel_node_t **head, _z_timer_wheel_node_t *node) {
+    node->_next = *head;
+    if (node->_next != NULL) {
+        node->_next->_pprev = &node->_next;
+    }
+    node->_pprev = head;
+    *head = node;
+}
+
+static void _z_timer_wheel_unlink(_z_timer_wheel_node_t *node) {
+    *node->_pprev = node->_next;
+    if (node->_next != NULL) {
+        node->_next->_pprev = node->_pprev;
+    }
+    node->_next = NULL;
+    node->_pprev = NULL;
+}
+
+static void _z_timer_wheel_place(_z_timer_wheel_t *tw, _z_timer_wheel_node_t *node) {
+    // Expired timers go in the slot of the next tick
+    uint64_t delta = (node->_expiry > tw->_now) ? node->_expiry - tw->_now : 0;
+    uint64_t expiry = tw->_now + delta;
+    if (delta >= _Z_TIMER_WHEEL_RANGE) {
+        expiry = tw->_now + _Z_TIMER_WHEEL_RANGE - 1;
+        delta = _Z_TIMER_WHEEL_RANGE - 1;
+    }
+    size_t level = 0;
+    while ((level < _Z_TIMER_WHEEL_LEVEL_NB - 1) &&
+           (delta >= ((uint64_t)1 << ((level + 1) * _Z_TIMER_WHEEL_SLOT_BITS)))) {
+        level++;
+    }
+    size_t slot = (size_t)((expiry >> (level * _Z_TIMER_WHEEL_SLOT_BITS)) & _Z_TIMER_WHEEL_SLOT_MASK);
+    _z_timer_wheel_link(&tw->_slots[level][slot], node);
+}
+
+void _z_timer_wheel_add(_z_timer_wheel_t *tw, _z_timer_wheel_node_t *node, uint64_t expiry) {
+    _z_timer_wheel_remove(tw, node);
+    node->_expiry = expiry;
+    _z_timer_wheel_place(tw, node);
+    tw->_len++;
+}
+
+void _z_timer_wheel_remove(_z_timer_wheel_t *tw, _z_timer_wheel_node_t *node) {
+    if (_z_timer_wheel_node_is_scheduled(node)) {
+        _z_timer_wheel_unlink(node);
+        tw->_len--;
+    }
+}
+
+// Moves the timers of the slot the wheel just entered down a level, starting with the lowest level
+static void _z_timer_wheel_cascade(_z_timer_wheel_t *tw) {
+    for (size_t level = 1; level < _Z_TIMER_WHEEL_LEVEL_NB; level++) {
+        size_t slot = (size_t)((tw->_now >> (level * _Z_TIMER_WHEEL_SLOT_BITS)) & _Z_TIMER_WHEEL_SLOT_MASK);
+        _z_timer_wheel_node_t *nodes = tw->_slots[level][slot];
+        tw->_slots[level][slot] = NULL;
+        if (nodes != NULL) {
+            nodes->_pprev = &nodes;
+        }
+        while (nodes != NULL) {
+            _z_timer_wheel_node_t *node = nodes;
+            _z_timer_wheel_unlink(node);
+            _z_timer_wheel_place(tw, node);
+        }
+        // The upper level only moves when this one wraps around
+        if (slot != 0) {
+            break;
+        }
+    }
+}
+
+void _z_timer_wheel_advance(_z_timer_wheel_t *tw, uint64_t now, _z_timer_wheel_expire_f f, void *arg) {
+    while ((tw->_len > 0) && (tw->_now <= now)) {
+        size_t slot = (size_t)(tw->_now & _Z_TIMER_WHEEL_SLOT_MASK);
+        if (slot == 0) {
+            _z_timer_wheel_cascade(tw);
+        }
+        // Detach the slot, so that timers scheduled by f are only considered from the next tick
+        _z_timer_wheel_node_t *expired = tw->_slots[0][slot];
+        tw->_slots[0][slot] = NULL;
+        if (expired != NULL) {
+            expired->_pprev = &expired;
+        }
+        tw->_now++;
+        while (expired != NULL) {
+            _z_timer_wheel_node_t *node = expired;
+            _z_timer_wheel_remove(tw, node);
+            f(node, arg);
+        }
+    }
+    // Nothing to cascade in an empty wheel, skip the remaining ticks
+    if (tw->_now <= now) {
+        tw->_now = now + 1;
+    }
+}
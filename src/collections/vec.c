@@ -230,10 +230,13 @@ z_result_t _z_svec_expand(_z_svec_t *v, z_element_move_f move, size_t element_si
     }
     // Move and clear old data
     __z_svec_move_inner(_val, v->_val, move, v->_len, element_size, use_elem_f);
-    z_free(v->_val);
-    // Update the current vector
+    if (!v->_aliased) {
+        z_free(v->_val);
+    }
+    // Update the current vector, which now owns its storage
     v->_val = _val;
     v->_capacity = _capacity;
+    v->_aliased = false;
     return _Z_RES_OK;
 }
 
@@ -202,7 +202,60 @@ size_t _z_link_socket_recv_zbuf(const _z_link_t *link, _z_zbuf_t *zbf, const _z_
     return rb;
 }
 
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+// Reads up to count datagrams, one per buffer, returns the number of buffers filled or SIZE_MAX on error
+size_t _z_link_recv_zbuf_vec(const _z_link_t *link, _z_zbuf_t **zbfs, size_t count, _z_slice_t *addrs) {
+    _z_slice_t bufs[_Z_SYS_NET_RECV_VEC_MAX];
+    if (count > _Z_SYS_NET_RECV_VEC_MAX) {
+        count = _Z_SYS_NET_RECV_VEC_MAX;
+    }
+    for (size_t i = 0; i < count; i++) {
+        bufs[i] = _z_slice_alias_buf(_z_zbuf_get_wptr(zbfs[i]), _z_zbuf_space_left(zbfs[i]));
+    }
+    size_t rn = link->_read_vec_f(link, bufs, count, addrs);
+    for (size_t i = 0; (rn != SIZE_MAX) && (i < rn); i++) {
+        _z_zbuf_set_wpos(zbfs[i], _z_zbuf_get_wpos(zbfs[i]) + bufs[i].len);
+    }
+    return rn;
+}
+#endif
+
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+static z_result_t _z_link_send_wbuf_vec(const _z_link_t *link, const _z_wbuf_t *wbf, _z_sys_net_socket_t *socket) {
+    _z_slice_t bufs[_Z_SYS_NET_SEND_VEC_MAX];
+    size_t count = 0;
+    for (size_t i = 0; i < _z_wbuf_len_iosli(wbf); i++) {
+        _z_slice_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(wbf, i));
+        if (bs.len > 0) {
+            bufs[count] = bs;
+            count++;
+        }
+    }
+    // Whole buffer goes out in a single call, as one datagram on datagram links
+    return _z_link_send_slices(link, bufs, count, socket);
+}
+
+z_result_t _z_link_send_slices(const _z_link_t *zl, const _z_slice_t *bufs, size_t count, _z_sys_net_socket_t *socket) {
+    size_t len = 0;
+    for (size_t i = 0; i < count; i++) {
+        len += bufs[i].len;
+    }
+    size_t wb = zl->_write_vec_f(zl, bufs, count, socket);
+    if (wb != len) {
+        _Z_ERROR_LOG(_Z_ERR_TRANSPORT_TX_FAILED);
+        return _Z_ERR_TRANSPORT_TX_FAILED;
+    }
+    return _Z_RES_OK;
+}
+#endif
+
 z_result_t _z_link_send_wbuf(const _z_link_t *link, const _z_wbuf_t *wbf, _z_sys_net_socket_t *socket) {
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+    size_t iosli_nb = _z_wbuf_len_iosli(wbf);
+    if ((link->_write_vec_f != NULL) && (iosli_nb > 1) && (iosli_nb <= _Z_SYS_NET_SEND_VEC_MAX)) {
+        return _z_link_send_wbuf_vec(link, wbf, socket);
+    }
+#endif
     z_result_t ret = _Z_RES_OK;
     bool link_is_streamed = link->_cap._flow == Z_LINK_CAP_FLOW_STREAM;
 
@@ -172,10 +172,24 @@ size_t _z_f_link_write_all_udp_multicast(const _z_link_t *self, const uint8_t *p
     return _z_send_udp_multicast(self->_socket._udp._msock, ptr, len, self->_socket._udp._rep);
 }
 
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_f_link_write_vec_udp_multicast(const _z_link_t *self, const _z_slice_t *bufs, size_t count,
+                                         _z_sys_net_socket_t *socket) {
+    _ZP_UNUSED(socket);
+    return _z_send_vec_udp_multicast(self->_socket._udp._msock, bufs, count, self->_socket._udp._rep);
+}
+#endif
+
 size_t _z_f_link_read_udp_multicast(const _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr) {
     return _z_read_udp_multicast(self->_socket._udp._sock, ptr, len, self->_socket._udp._lep, addr);
 }
 
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+size_t _z_f_link_read_vec_udp_multicast(const _z_link_t *self, _z_slice_t *bufs, size_t count, _z_slice_t *addrs) {
+    return _z_read_vec_udp_multicast(self->_socket._udp._sock, bufs, count, self->_socket._udp._lep, addrs);
+}
+#endif
+
 size_t _z_f_link_read_exact_udp_multicast(const _z_link_t *self, uint8_t *ptr, size_t len, _z_slice_t *addr,
                                           _z_sys_net_socket_t *socket) {
     _ZP_UNUSED(socket);
@@ -211,7 +225,17 @@ z_result_t _z_new_link_udp_multicast(_z_link_t *zl, _z_endpoint_t endpoint) {
 
     zl->_write_f = _z_f_link_write_udp_multicast;
     zl->_write_all_f = _z_f_link_write_all_udp_multicast;
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+    zl->_write_vec_f = _z_f_link_write_vec_udp_multicast;
+#else
+    zl->_write_vec_f = NULL;
+#endif
     zl->_read_f = _z_f_link_read_udp_multicast;
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+    zl->_read_vec_f = _z_f_link_read_vec_udp_multicast;
+#else
+    zl->_read_vec_f = NULL;
+#endif
     zl->_read_exact_f = _z_f_link_read_exact_udp_multicast;
     zl->_read_socket_f = _z_noop_link_read_socket;
 
@@ -93,6 +93,17 @@ size_t _z_f_link_write_all_tcp(const _z_link_t *zl, const uint8_t *ptr, size_t l
     return _z_send_tcp(zl->_socket._tcp._sock, ptr, len);
 }
 
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+size_t _z_f_link_write_vec_tcp(const _z_link_t *zl, const _z_slice_t *bufs, size_t count,
+                               _z_sys_net_socket_t *socket) {
+    if (socket != NULL) {
+        return _z_send_vec_tcp(*socket, bufs, count);
+    } else {
+        return _z_send_vec_tcp(zl->_socket._tcp._sock, bufs, count);
+    }
+}
+#endif
+
 size_t _z_f_link_read_tcp(const _z_link_t *zl, uint8_t *ptr, size_t len, _z_slice_t *addr) {
     _ZP_UNUSED(addr);
     return _z_read_tcp(zl->_socket._tcp._sock, ptr, len);
@@ -167,7 +178,13 @@ z_result_t _z_new_link_tcp(_z_link_t *zl, _z_endpoint_t *endpoint) {
 
     zl->_write_f = _z_f_link_write_tcp;
     zl->_write_all_f = _z_f_link_write_all_tcp;
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+    zl->_write_vec_f = _z_f_link_write_vec_tcp;
+#else
+    zl->_write_vec_f = NULL;
+#endif
     zl->_read_f = _z_f_link_read_tcp;
+    zl->_read_vec_f = NULL;
     zl->_read_exact_f = _z_f_link_read_exact_tcp;
     zl->_read_socket_f = _z_f_link_tcp_read_socket;
     return ret;
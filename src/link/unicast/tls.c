@@ -221,7 +221,9 @@ z_result_t _z_new_link_tls(_z_link_t *zl, _z_endpoint_t *endpoint, const _z_conf
     zl->_close_f = _z_f_link_close_tls;
     zl->_write_f = _z_f_link_write_tls;
     zl->_write_all_f = _z_f_link_write_all_tls;
+    zl->_write_vec_f = NULL;
     zl->_read_f = _z_f_link_read_tls;
+    zl->_read_vec_f = NULL;
     zl->_read_exact_f = _z_f_link_read_exact_tls;
     zl->_read_socket_f = _z_f_link_tls_read_socket;
     zl->_free_f = _z_f_link_free_tls;
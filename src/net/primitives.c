@@ -26,6 +26,7 @@
 #include "zenoh-pico/net/matching.h"
 #include "zenoh-pico/net/sample.h"
 #include "zenoh-pico/net/session.h"
+#include "zenoh-pico/protocol/codec/network.h"
 #include "zenoh-pico/protocol/core.h"
 #include "zenoh-pico/protocol/definitions/declarations.h"
 #include "zenoh-pico/protocol/definitions/interest.h"
@@ -160,6 +161,29 @@ _z_keyexpr_t _z_update_keyexpr_to_declared(_z_session_t *zs, _z_keyexpr_t keyexp
 
 #if Z_FEATURE_PUBLICATION == 1
 /*------------------  Publisher Declaration ------------------*/
+// Encodes the push header of the puts without timestamp, attachment nor source info, empty if it can't be encoded
+static _z_slice_t _z_publisher_encode_put_header(const _z_publisher_t *pub) {
+    _z_keyexpr_t keyexpr;
+    _z_keyexpr_alias_from_user_defined(&keyexpr, &pub->_key);
+    _z_n_qos_t qos = _z_n_qos_make(pub->_is_express, pub->_congestion_control == Z_CONGESTION_CONTROL_BLOCK,
+                                   pub->_priority);
+    _z_network_message_t msg;
+    _z_n_msg_make_push_put(&msg, &keyexpr, NULL, &pub->_encoding, qos, NULL, NULL, pub->reliability, NULL);
+
+    _z_slice_t ret = _z_slice_null();
+    _z_wbuf_t wbf = _z_wbuf_make(_Z_PUT_HEADER_BASE_SIZE, true);
+    if (_z_push_header_encode(&wbf, &msg._body._push) == _Z_RES_OK) {
+        _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+        _z_slice_t encoded = _z_slice_alias_buf(_z_zbuf_start(&zbf), _z_zbuf_len(&zbf));
+        if (_z_slice_copy(&ret, &encoded) != _Z_RES_OK) {
+            ret = _z_slice_null();
+        }
+        _z_zbuf_clear(&zbf);
+    }
+    _z_wbuf_clear(&wbf);
+    return ret;
+}
+
 _z_publisher_t _z_declare_publisher(const _z_session_rc_t *zn, _z_keyexpr_t keyexpr, _z_encoding_t *encoding,
                                     z_congestion_control_t congestion_control, z_priority_t priority, bool is_express,
                                     z_reliability_t reliability, z_locality_t allowed_destination) {
@@ -176,6 +200,7 @@ _z_publisher_t _z_declare_publisher(const _z_session_rc_t *zn, _z_keyexpr_t keye
     ret._encoding = encoding == NULL ? _z_encoding_null() : _z_encoding_steal(encoding);
     ret._allowed_destination = allowed_destination;
     ret._filter = (_z_write_filter_t){0};
+    ret._put_header = _z_publisher_encode_put_header(&ret);
     return ret;
 }
 
@@ -189,6 +214,7 @@ z_result_t _z_undeclare_publisher(_z_publisher_t *pub) {
     _z_keyexpr_clear(&pub->_key);
     _z_session_weak_drop(&pub->_zn);
     _z_encoding_clear(&pub->_encoding);
+    _z_slice_clear(&pub->_put_header);
     *pub = _z_publisher_null();
     return _Z_RES_OK;
 }
@@ -197,19 +223,40 @@ z_result_t _z_undeclare_publisher(_z_publisher_t *pub) {
 z_result_t _z_write(_z_session_t *zn, const _z_keyexpr_t *keyexpr, _z_bytes_t *payload, _z_encoding_t *encoding,
                     z_sample_kind_t kind, z_congestion_control_t cong_ctrl, z_priority_t priority, bool is_express,
                     const _z_timestamp_t *timestamp, _z_bytes_t *attachment, z_reliability_t reliability,
-                    const _z_source_info_t *source_info, z_locality_t allowed_destination) {
+                    const _z_source_info_t *source_info, z_locality_t allowed_destination,
+                    const _z_slice_t *put_header) {
     z_result_t ret = _Z_RES_OK;
     _z_qos_t qos = _z_n_qos_make(is_express, cong_ctrl == Z_CONGESTION_CONTROL_BLOCK, priority);
 
     if (_z_locality_allows_remote(allowed_destination)) {
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+        // Receivers reached both through the main transport and a group drop the copy based on the source info. The
+        // stamp is only put on the wire, local subscribers and remote ones don't see it as a source info.
+        const _z_source_info_t *wire_info = source_info;
+        _z_source_info_t group_info;
+        if (((source_info == NULL) || !_z_source_info_check(source_info)) && _z_session_has_groups(zn)) {
+            group_info._source_id = (_z_entity_global_id_t){.zid = zn->_local_zid, .eid = _Z_SESSION_DEDUP_EID};
+            _z_session_mutex_lock(zn);
+            group_info._source_sn = zn->_source_sn++;
+            _z_session_mutex_unlock(zn);
+            wire_info = &group_info;
+        }
+#else
+        const _z_source_info_t *wire_info = source_info;
+#endif
         _z_network_message_t msg;
         switch (kind) {
             case Z_SAMPLE_KIND_PUT:
                 _z_n_msg_make_push_put(&msg, keyexpr, payload, encoding, qos, timestamp, attachment, reliability,
-                                       source_info);
+                                       wire_info);
+                // The header is only encoded for the puts without these fields
+                if ((put_header != NULL) && _z_slice_check(put_header) && (timestamp == NULL) &&
+                    ((attachment == NULL) || !_z_bytes_check(attachment)) && (wire_info == NULL)) {
+                    msg._body._push._encoded_header = put_header;
+                }
                 break;
             case Z_SAMPLE_KIND_DELETE:
-                _z_n_msg_make_push_del(&msg, keyexpr, qos, timestamp, reliability, source_info);
+                _z_n_msg_make_push_del(&msg, keyexpr, qos, timestamp, reliability, wire_info);
                 break;
             default:
                 _Z_ERROR_RETURN(_Z_ERR_GENERIC);
@@ -456,7 +503,8 @@ z_result_t _z_send_reply(const _z_query_t *query, const _z_session_rc_t *zsrc, c
             _Z_ERROR_RETURN(_Z_ERR_GENERIC);
     }
     // Send message on network
-    if (_z_send_n_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) != _Z_RES_OK) {
+    if (_z_send_n_msg_on(zn, query->_transport, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) !=
+        _Z_RES_OK) {
         _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
     }
     // Freeing z_msg is unnecessary, as all of its components are aliased
@@ -479,7 +527,8 @@ z_result_t _z_send_reply_err(const _z_query_t *query, const _z_session_rc_t *zsr
     _z_n_msg_make_reply_err(&msg, &zn->_local_zid, query->_request_id, Z_RELIABILITY_DEFAULT, qos, payload, encoding,
                             &source_info);
     // Send message on network
-    if (_z_send_n_msg(zn, &msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) != _Z_RES_OK) {
+    if (_z_send_n_msg_on(zn, query->_transport, &msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK) !=
+        _Z_RES_OK) {
         _Z_ERROR_LOG(_Z_ERR_TRANSPORT_TX_FAILED);
         ret = _Z_ERR_TRANSPORT_TX_FAILED;
     }
@@ -552,10 +601,12 @@ z_result_t _z_query(_z_session_t *zn, const _z_keyexpr_t *keyexpr, const char *p
     // Add the pending query to the current session
     _z_zint_t qid = _z_get_query_id(zn);
     _z_session_mutex_lock(zn);
-    _Z_CLEAN_RETURN_IF_ERR(_z_unsafe_register_pending_query(zn, qid), _z_session_mutex_unlock(zn));
-    // Create the pending query object
-    _z_pending_query_t *pq = _z_pending_query_slist_value(zn->_pending_queries);
-    pq->_id = qid;
+    _z_pending_query_t *pq = _z_unsafe_register_pending_query(zn, qid, timeout_ms);
+    if (pq == NULL) {
+        _z_session_mutex_unlock(zn);
+        return _Z_ERR_ENTITY_DECLARATION_FAILED;
+    }
+    // Fill the pending query object
     pq->_key = __unsafe_z_get_expanded_key_from_key(zn, keyexpr, false, NULL);
     pq->_target = target;
     pq->_consolidation = consolidation;
@@ -566,8 +617,6 @@ z_result_t _z_query(_z_session_t *zn, const _z_keyexpr_t *keyexpr, const char *p
     pq->_pending_replies = NULL;
     pq->_allowed_destination = allowed_destination;
     pq->_arg = arg;
-    pq->_timeout = timeout_ms;
-    pq->_start_time = z_clock_now();
     // Count how many finals we expect: one for the local path (if handled_locally)
     // and one for the remote path (if remote is allowed). Keep at least 1 to avoid stuck pending.
 #if Z_FEATURE_LOCAL_QUERYABLE == 1
@@ -583,22 +632,23 @@ z_result_t _z_query(_z_session_t *zn, const _z_keyexpr_t *keyexpr, const char *p
     _z_slice_t params =
         (parameters == NULL) ? _z_slice_null() : _z_slice_alias_buf((uint8_t *)parameters, parameters_len);
 
+    // The pending query may be finalized by a reply as soon as the query is sent, only its id is used from here
     if (remote_possible) {
         _z_zenoh_message_t z_msg;
-        _z_n_msg_make_query(&z_msg, keyexpr, &params, pq->_id, Z_RELIABILITY_DEFAULT, pq->_consolidation, payload,
-                            encoding, timeout_ms, attachment, qos, &source_info);
+        _z_n_msg_make_query(&z_msg, keyexpr, &params, qid, Z_RELIABILITY_DEFAULT, consolidation, payload, encoding,
+                            timeout_ms, attachment, qos, &source_info);
 
         if (_z_send_n_msg(zn, &z_msg, Z_RELIABILITY_RELIABLE, _z_n_qos_get_congestion_control(qos), NULL) !=
             _Z_RES_OK) {
-            _z_unregister_pending_query(zn, pq);
+            _z_unregister_pending_query(zn, qid);
             _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
         }
     }
 
 #if Z_FEATURE_LOCAL_QUERYABLE == 1
     if (allow_local) {
-        _Z_RETURN_IF_ERR(_z_session_deliver_query_locally(zn, keyexpr, &params, pq->_consolidation, payload, encoding,
-                                                          attachment, &source_info, pq->_id, timeout_ms, qos));
+        _Z_RETURN_IF_ERR(_z_session_deliver_query_locally(zn, keyexpr, &params, consolidation, payload, encoding,
+                                                          attachment, &source_info, qid, timeout_ms, qos));
     }
 #endif
     return _Z_RES_OK;
@@ -42,7 +42,7 @@ z_result_t _z_query_send_reply_final(_z_query_t *q) {
     } else {
         _z_zenoh_message_t z_msg;
         _z_n_msg_make_response_final(&z_msg, q->_request_id);
-        ret = _z_send_n_msg(session, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL);
+        ret = _z_send_n_msg_on(session, q->_transport, &z_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK);
         _z_msg_clear(&z_msg);
     }
 
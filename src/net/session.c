@@ -151,6 +151,39 @@ static z_result_t _z_open_inner(_z_session_rc_t *zs, _z_string_t *locator, const
     return ret;
 }
 
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+static z_result_t _z_open_groups(_z_session_rc_t *zs, const _z_config_t *config, const _z_id_t *zid) {
+    _z_session_t *zn = _Z_RC_IN_VAL(zs);
+    _z_string_svec_t locators = _z_string_svec_null();
+    z_result_t ret = _z_config_get_all(config, &locators, Z_CONFIG_MULTICAST_GROUP_KEY);
+    size_t len = _z_string_svec_len(&locators);
+    if (len > Z_SESSION_MULTICAST_GROUP_NB) {
+        _Z_ERROR("Can't join more than %d multicast groups", Z_SESSION_MULTICAST_GROUP_NB);
+        _Z_ERROR_LOG(_Z_ERR_CONFIG_LOCATOR_INVALID);
+        ret = _Z_ERR_CONFIG_LOCATOR_INVALID;
+    }
+    for (size_t i = 0; (ret == _Z_RES_OK) && (i < len); i++) {
+        _z_transport_t *zt = &zn->_tp_groups[i];
+        // Groups stay joined while the main transport reconnects
+        if (zt->_type != _Z_TRANSPORT_NONE) {
+            continue;
+        }
+        ret = _z_new_transport(zt, zid, _z_string_svec_get(&locators, i), Z_WHATAMI_PEER, _Z_PEER_OP_LISTEN, config);
+        if ((ret == _Z_RES_OK) && (zt->_type != _Z_TRANSPORT_MULTICAST_TYPE)) {
+            _Z_ERROR("Multicast group locators must use a multicast link");
+            _z_transport_clear(zt);
+            _Z_ERROR_LOG(_Z_ERR_CONFIG_LOCATOR_INVALID);
+            ret = _Z_ERR_CONFIG_LOCATOR_INVALID;
+        }
+        if (ret == _Z_RES_OK) {
+            _z_transport_get_common(zt)->_session = _z_session_rc_clone_as_weak(zs);
+        }
+    }
+    _z_string_svec_clear(&locators);
+    return ret;
+}
+#endif
+
 z_result_t _z_open(_z_session_rc_t *zn, _z_config_t *config, const _z_id_t *zid) {
     z_result_t ret = _Z_RES_OK;
     _Z_RC_IN_VAL(zn)->_tp._type = _Z_TRANSPORT_NONE;
@@ -203,6 +236,11 @@ z_result_t _z_open(_z_session_rc_t *zn, _z_config_t *config, const _z_id_t *zid)
         }
     }
     _z_string_svec_clear(&locators);
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    if (ret == _Z_RES_OK) {
+        ret = _z_open_groups(zn, config, zid);
+    }
+#endif
     return ret;
 }
 
@@ -233,7 +271,7 @@ z_result_t _z_reopen(_z_session_rc_t *zn) {
         if (ret != _Z_RES_OK) {
             return ret;
         }
-        ret = _zp_start_read_task(zs, zs->_read_task_attr);
+        ret = _zp_start_read_task(zs, zs->_read_task_attr, zs->_read_task_worker_nb);
         if (ret != _Z_RES_OK) {
             return ret;
         }
@@ -379,16 +417,49 @@ _z_config_t *_z_info(const _z_session_t *zn) {
             default:
                 break;
         }
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+        for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+            if (zn->_tp_groups[i]._type == _Z_TRANSPORT_MULTICAST_TYPE) {
+                _zp_multicast_info_session(&zn->_tp_groups[i], ps);
+            }
+        }
+#endif
     }
 
     return ps;
 }
 
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+// Applies a transport function to the main transport then to the joined groups, returns the first error
+static z_result_t _z_session_foreach_transport(_z_session_t *zn, z_result_t (*f)(_z_transport_t *zt)) {
+    z_result_t ret = f(&zn->_tp);
+    for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+        if (zn->_tp_groups[i]._type != _Z_TRANSPORT_NONE) {
+            z_result_t res = f(&zn->_tp_groups[i]);
+            ret = (ret == _Z_RES_OK) ? res : ret;
+        }
+    }
+    return ret;
+}
+
+static z_result_t _z_read_all(_z_transport_t *zt) { return _z_read(zt, false); }
+
+static z_result_t _z_read_single(_z_transport_t *zt) { return _z_read(zt, true); }
+
+z_result_t _zp_read(_z_session_t *zn, bool single_read) {
+    return _z_session_foreach_transport(zn, single_read ? _z_read_single : _z_read_all);
+}
+
+z_result_t _zp_send_keep_alive(_z_session_t *zn) { return _z_session_foreach_transport(zn, _z_send_keep_alive); }
+
+z_result_t _zp_send_join(_z_session_t *zn) { return _z_session_foreach_transport(zn, _z_send_join); }
+#else
 z_result_t _zp_read(_z_session_t *zn, bool single_read) { return _z_read(&zn->_tp, single_read); }
 
 z_result_t _zp_send_keep_alive(_z_session_t *zn) { return _z_send_keep_alive(&zn->_tp); }
 
 z_result_t _zp_send_join(_z_session_t *zn) { return _z_send_join(&zn->_tp); }
+#endif
 
 #ifdef Z_FEATURE_UNSTABLE_API
 #if Z_FEATURE_PERIODIC_TASKS == 1
@@ -408,7 +479,76 @@ z_result_t _zp_periodic_task_remove(_z_session_t *zn, uint32_t id) {
 #endif
 
 #if Z_FEATURE_MULTI_THREAD == 1
-z_result_t _zp_start_read_task(_z_session_t *zn, z_task_attr_t *attr) {
+#if defined(_Z_TX_QUEUE)
+// Starts the writer task of the tx queue if the config enabled it, it runs with the attributes of the read task
+static z_result_t _zp_start_tx_queue_task(_z_transport_t *zt, z_task_attr_t *attr) {
+    _z_transport_common_t *ztc = _z_transport_get_common(zt);
+    if ((ztc == NULL) || !ztc->_tx_queue_enabled || (ztc->_tx_queue != NULL)) {
+        return _Z_RES_OK;
+    }
+    return _z_transport_tx_queue_start(ztc, attr);
+}
+#endif
+
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+static z_result_t _zp_start_group_read_tasks(_z_session_t *zn, z_task_attr_t *attr) {
+    for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+        _z_transport_t *zt = &zn->_tp_groups[i];
+        // Group tasks keep running while the main transport reconnects
+        if ((zt->_type == _Z_TRANSPORT_NONE) || zt->_transport._multicast._common._read_task_running) {
+            continue;
+        }
+        _z_task_t *task = (_z_task_t *)z_malloc(sizeof(_z_task_t));
+        if (task == NULL) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+        z_result_t ret = _zp_multicast_start_read_task(zt, attr, task);
+        if (ret != _Z_RES_OK) {
+            z_free(task);
+            return ret;
+        }
+#if defined(_Z_TX_QUEUE)
+        _Z_RETURN_IF_ERR(_zp_start_tx_queue_task(zt, attr));
+#endif
+    }
+    return _Z_RES_OK;
+}
+
+static z_result_t _zp_start_group_lease_tasks(_z_session_t *zn, z_task_attr_t *attr) {
+    for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+        _z_transport_t *zt = &zn->_tp_groups[i];
+        if ((zt->_type == _Z_TRANSPORT_NONE) || zt->_transport._multicast._common._lease_task_running) {
+            continue;
+        }
+        _z_task_t *task = (_z_task_t *)z_malloc(sizeof(_z_task_t));
+        if (task == NULL) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+        z_result_t ret = _zp_multicast_start_lease_task(&zt->_transport._multicast, attr, task);
+        if (ret != _Z_RES_OK) {
+            z_free(task);
+            return ret;
+        }
+    }
+    return _Z_RES_OK;
+}
+
+static void _zp_stop_group_tasks(_z_session_t *zn, bool read) {
+    for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+        _z_transport_t *zt = &zn->_tp_groups[i];
+        if (zt->_type == _Z_TRANSPORT_NONE) {
+            continue;
+        }
+        if (read) {
+            _zp_multicast_stop_read_task(zt);
+        } else {
+            _zp_multicast_stop_lease_task(&zt->_transport._multicast);
+        }
+    }
+}
+#endif
+
+z_result_t _zp_start_read_task(_z_session_t *zn, z_task_attr_t *attr, uint8_t worker_nb) {
     z_result_t ret = _Z_RES_OK;
     // Allocate task
     _z_task_t *task = (_z_task_t *)z_malloc(sizeof(_z_task_t));
@@ -419,7 +559,7 @@ z_result_t _zp_start_read_task(_z_session_t *zn, z_task_attr_t *attr) {
     // Call transport function
     switch (zn->_tp._type) {
         case _Z_TRANSPORT_UNICAST_TYPE:
-            ret = _zp_unicast_start_read_task(&zn->_tp, attr, task);
+            ret = _zp_unicast_start_read_task(&zn->_tp, attr, task, worker_nb);
             break;
         case _Z_TRANSPORT_MULTICAST_TYPE:
             ret = _zp_multicast_start_read_task(&zn->_tp, attr, task);
@@ -438,8 +578,19 @@ z_result_t _zp_start_read_task(_z_session_t *zn, z_task_attr_t *attr) {
 #if Z_FEATURE_AUTO_RECONNECT == 1
     } else {
         zn->_read_task_attr = attr;
+        zn->_read_task_worker_nb = worker_nb;
 #endif
     }
+#if defined(_Z_TX_QUEUE)
+    if (ret == _Z_RES_OK) {
+        ret = _zp_start_tx_queue_task(&zn->_tp, attr);
+    }
+#endif
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    if (ret == _Z_RES_OK) {
+        ret = _zp_start_group_read_tasks(zn, attr);
+    }
+#endif
     return ret;
 }
 
@@ -475,6 +626,11 @@ z_result_t _zp_start_lease_task(_z_session_t *zn, z_task_attr_t *attr) {
         zn->_lease_task_attr = attr;
 #endif
     }
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    if (ret == _Z_RES_OK) {
+        ret = _zp_start_group_lease_tasks(zn, attr);
+    }
+#endif
     return ret;
 }
 
@@ -521,6 +677,9 @@ z_result_t _zp_stop_read_task(_z_session_t *zn) {
             ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
             break;
     }
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    _zp_stop_group_tasks(zn, true);
+#endif
     return ret;
 }
 
@@ -542,6 +701,9 @@ z_result_t _zp_stop_lease_task(_z_session_t *zn) {
             ret = _Z_ERR_TRANSPORT_NOT_AVAILABLE;
             break;
     }
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    _zp_stop_group_tasks(zn, false);
+#endif
     return ret;
 }
 
@@ -249,7 +249,43 @@ z_result_t _z_slice_encode(_z_wbuf_t *wbf, const _z_slice_t *bs) {
     return _z_slice_val_encode(wbf, bs);
 }
 
+#if defined(_Z_DEFRAG_CHAINED)
+// Decodes a bytes field that ends the message, from the rest of the buffer and the slices following it
+static z_result_t _z_bytes_decode_chained(_z_bytes_t *bs, _z_zbuf_t *zbf) {
+    _z_zint_t len = 0;
+    _Z_RETURN_IF_ERR(_z_zsize_decode(&len, zbf));
+    size_t head_len = _z_zbuf_len(zbf);
+    size_t total = head_len;
+    for (size_t i = 0; i < zbf->_tail_len; i++) {
+        total += _z_arc_slice_len(&zbf->_tail[i]);
+    }
+    if (len != total) {
+        _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+    }
+    *bs = _z_bytes_null();
+    if (head_len > 0) {
+        size_t offset = _z_ptr_u8_diff(_z_zbuf_start(zbf), _z_slice_simple_rc_value(&zbf->_slice)->start);
+        _z_arc_slice_t s = _z_arc_slice_wrap_slice_rc(&zbf->_slice, offset, head_len);
+        _Z_RETURN_IF_ERR(_z_bytes_append_slice(bs, &s));
+    }
+    for (size_t i = 0; i < zbf->_tail_len; i++) {
+        _z_arc_slice_t s;
+        _z_arc_slice_copy(&s, &zbf->_tail[i]);
+        _Z_CLEAN_RETURN_IF_ERR(_z_bytes_append_slice(bs, &s), _z_bytes_drop(bs));
+    }
+    _z_zbuf_set_rpos(zbf, _z_zbuf_get_wpos(zbf));
+    zbf->_tail = NULL;
+    zbf->_tail_len = 0;
+    return _Z_RES_OK;
+}
+#endif
+
 z_result_t _z_bytes_decode(_z_bytes_t *bs, _z_zbuf_t *zbf, _z_arc_slice_t *arcs) {
+#if defined(_Z_DEFRAG_CHAINED)
+    if (zbf->_tail_len > 0) {
+        return _z_bytes_decode_chained(bs, zbf);
+    }
+#endif
     // Decode slice
     _z_slice_t s;
     _Z_RETURN_IF_ERR(_z_slice_decode(&s, zbf));
@@ -166,7 +166,7 @@ z_result_t _z_msg_ext_vec_push_callback(_z_msg_ext_t *extension, _z_msg_ext_vec_
     }
     *ext = *extension;
     *extension = _z_msg_ext_make_unit(0);
-    _z_msg_ext_vec_append(extensions, extension);
+    _z_msg_ext_vec_append(extensions, ext);
     return 0;
 }
 z_result_t _z_msg_ext_vec_decode(_z_msg_ext_vec_t *extensions, _z_zbuf_t *zbf) {
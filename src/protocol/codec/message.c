@@ -34,6 +34,7 @@
 #include "zenoh-pico/protocol/iobuf.h"
 #include "zenoh-pico/protocol/keyexpr.h"
 #include "zenoh-pico/utils/logging.h"
+#include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/result.h"
 
 /*=============================*/
@@ -254,16 +255,21 @@ z_result_t _z_source_info_encode_ext(_z_wbuf_t *wbf, const _z_source_info_t *inf
 }
 
 /*------------------ Push Body Field ------------------*/
-z_result_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
+z_result_t _z_push_body_header_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
     uint8_t header = pshb->_is_put ? _Z_MID_Z_PUT : _Z_MID_Z_DEL;
     bool has_source_info = _z_id_check(pshb->_body._put._commons._source_info._source_id.zid) ||
                            pshb->_body._put._commons._source_info._source_sn != 0 ||
                            pshb->_body._put._commons._source_info._source_id.eid != 0;
 
     bool has_attachment = pshb->_is_put && _z_bytes_check(&pshb->_body._put._attachment);
+#if Z_FEATURE_SHM == 1
+    bool has_shm = pshb->_is_put && pshb->_body._put._is_shm;
+#else
+    bool has_shm = false;
+#endif
     bool has_timestamp = _z_timestamp_check(&pshb->_body._put._commons._timestamp);
     bool has_encoding = false;
-    if (has_source_info || has_attachment) {
+    if (has_source_info || has_shm || has_attachment) {
         header |= _Z_FLAG_Z_Z;
     }
     if (pshb->_is_put) {
@@ -289,21 +295,56 @@ z_result_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
     }
 
     if (has_source_info) {
-        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZBUF | 0x01 | (has_attachment ? _Z_FLAG_Z_Z : 0)));
+        _Z_RETURN_IF_ERR(
+            _z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZBUF | 0x01 | ((has_shm || has_attachment) ? _Z_FLAG_Z_Z : 0)));
         _Z_RETURN_IF_ERR(_z_source_info_encode_ext(wbf, &pshb->_body._put._commons._source_info));
     }
+    if (has_shm) {
+        _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_PUT_SHM | (has_attachment ? _Z_FLAG_Z_Z : 0)));
+    }
     if (has_attachment) {
         _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ENC_ZBUF | 0x03));
         _Z_RETURN_IF_ERR(_z_bytes_encode(wbf, &pshb->_body._put._attachment));
     }
+
+    return _Z_RES_OK;
+}
+z_result_t _z_push_body_encode(_z_wbuf_t *wbf, const _z_push_body_t *pshb) {
+    _Z_RETURN_IF_ERR(_z_push_body_header_encode(wbf, pshb));
     if (pshb->_is_put) {
         _Z_RETURN_IF_ERR(_z_bytes_encode(wbf, &pshb->_body._put._payload));
     }
-
     return _Z_RES_OK;
 }
+typedef struct {
+    _z_push_body_t *pshb;
+    _z_zbuf_t *zbf;
+} _z_push_body_decode_ctx_t;
+
+// Attachments received in a rx buffer reference it like the payload rather than being copied
+static z_result_t _z_attachment_decode(_z_bytes_t *attachment, _z_slice_t *s, _z_zbuf_t *zbf) {
+    if (_z_slice_is_alloced(s)) {
+        _z_slice_t owned = _z_slice_steal(s);
+        return _z_bytes_from_slice(attachment, &owned);
+    }
+    const _z_slice_t *buf = _z_slice_simple_rc_is_null(&zbf->_slice) ? NULL : _z_slice_simple_rc_value(&zbf->_slice);
+    if ((buf != NULL) && (s->start >= buf->start) && (s->start + s->len <= buf->start + buf->len)) {
+        _z_arc_slice_t arc_s = _z_arc_slice_wrap_slice_rc(&zbf->_slice, _z_ptr_u8_diff(s->start, buf->start), s->len);
+        *attachment = _z_bytes_null();
+        z_result_t ret = _z_bytes_append_slice(attachment, &arc_s);
+        if (ret != _Z_RES_OK) {
+            _z_arc_slice_drop(&arc_s);
+        }
+        return ret;
+    }
+    _z_slice_t copy;
+    _Z_RETURN_IF_ERR(_z_slice_copy(&copy, s));
+    return _z_bytes_from_slice(attachment, &copy);
+}
+
 z_result_t _z_push_body_decode_extensions(_z_msg_ext_t *extension, void *ctx) {
-    _z_push_body_t *pshb = (_z_push_body_t *)ctx;
+    _z_push_body_decode_ctx_t *dctx = (_z_push_body_decode_ctx_t *)ctx;
+    _z_push_body_t *pshb = dctx->pshb;
     z_result_t ret = _Z_RES_OK;
     switch (_Z_EXT_FULL_ID(extension->_header)) {
         case _Z_MSG_EXT_ENC_ZBUF | 0x01: {
@@ -312,15 +353,15 @@ z_result_t _z_push_body_decode_extensions(_z_msg_ext_t *extension, void *ctx) {
             break;
         }
         case _Z_MSG_EXT_ENC_ZBUF | 0x03: {  // Attachment
-            _z_slice_t s;
-            if (_z_slice_is_alloced(&extension->_body._zbuf._val)) {
-                s = _z_slice_steal(&extension->_body._zbuf._val);
-            } else {
-                _Z_RETURN_IF_ERR(_z_slice_copy(&s, &extension->_body._zbuf._val));
-            }
-            ret = _z_bytes_from_slice(&pshb->_body._put._attachment, &s);
+            ret = _z_attachment_decode(&pshb->_body._put._attachment, &extension->_body._zbuf._val, dctx->zbf);
+            break;
+        }
+#if Z_FEATURE_SHM == 1
+        case _Z_MSG_EXT_ID_PUT_SHM: {
+            pshb->_body._put._is_shm = true;
             break;
         }
+#endif
         default:
             if (_Z_HAS_FLAG(extension->_header, _Z_MSG_EXT_FLAG_M)) {
                 ret = _z_msg_ext_unknown_error(extension, 0x08);
@@ -331,9 +372,13 @@ z_result_t _z_push_body_decode_extensions(_z_msg_ext_t *extension, void *ctx) {
 
 z_result_t _z_push_body_decode(_z_push_body_t *pshb, _z_zbuf_t *zbf, uint8_t header, _z_arc_slice_t *arcs) {
     z_result_t ret = _Z_RES_OK;
+    _z_push_body_decode_ctx_t ctx = {.pshb = pshb, .zbf = zbf};
     switch (_Z_MID(header)) {
         case _Z_MID_Z_PUT: {
             pshb->_is_put = true;
+#if Z_FEATURE_SHM == 1
+            pshb->_body._put._is_shm = false;
+#endif
             if (_Z_HAS_FLAG(header, _Z_FLAG_Z_P_T)) {
                 _Z_RETURN_IF_ERR(_z_timestamp_decode(&pshb->_body._put._commons._timestamp, zbf));
             }
@@ -341,7 +386,7 @@ z_result_t _z_push_body_decode(_z_push_body_t *pshb, _z_zbuf_t *zbf, uint8_t hea
                 _Z_RETURN_IF_ERR(_z_encoding_decode(&pshb->_body._put._encoding, zbf));
             }
             if ((ret == _Z_RES_OK) && _Z_HAS_FLAG(header, _Z_FLAG_Z_Z)) {
-                _Z_RETURN_IF_ERR(_z_msg_ext_decode_iter(zbf, _z_push_body_decode_extensions, pshb));
+                _Z_RETURN_IF_ERR(_z_msg_ext_decode_iter(zbf, _z_push_body_decode_extensions, &ctx));
             }
             if (ret == _Z_RES_OK) {
                 _Z_RETURN_IF_ERR(_z_bytes_decode(&pshb->_body._put._payload, zbf, arcs));
@@ -354,7 +399,7 @@ z_result_t _z_push_body_decode(_z_push_body_t *pshb, _z_zbuf_t *zbf, uint8_t hea
                 _Z_RETURN_IF_ERR(_z_timestamp_decode(&pshb->_body._put._commons._timestamp, zbf));
             }
             if ((ret == _Z_RES_OK) && _Z_HAS_FLAG(header, _Z_FLAG_Z_Z)) {
-                _Z_RETURN_IF_ERR(_z_msg_ext_decode_iter(zbf, _z_push_body_decode_extensions, pshb));
+                _Z_RETURN_IF_ERR(_z_msg_ext_decode_iter(zbf, _z_push_body_decode_extensions, &ctx));
             }
             break;
         }
@@ -38,7 +38,7 @@
 
 /*------------------ Push Message ------------------*/
 
-z_result_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
+z_result_t _z_push_header_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
     uint8_t header = _Z_MID_N_PUSH | (_z_keyexpr_is_local(&msg->_key) ? _Z_FLAG_N_REQUEST_M : 0);
     bool has_suffix = _z_keyexpr_has_suffix(&msg->_key);
     bool has_qos_ext = msg->_qos._val != _Z_N_QOS_DEFAULT._val;
@@ -62,8 +62,27 @@ z_result_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
         _Z_RETURN_IF_ERR(_z_timestamp_encode_ext(wbf, &msg->_timestamp));
     }
 
-    _Z_RETURN_IF_ERR(_z_push_body_encode(wbf, &msg->_body));
+    return _z_push_body_header_encode(wbf, &msg->_body);
+}
 
+static inline bool _z_push_has_encoded_header(const _z_n_msg_push_t *msg) {
+#if Z_FEATURE_SHM == 1
+    if (msg->_body._body._put._is_shm) {
+        return false;
+    }
+#endif
+    return (msg->_encoded_header != NULL) && msg->_body._is_put;
+}
+
+z_result_t _z_push_encode(_z_wbuf_t *wbf, const _z_n_msg_push_t *msg) {
+    if (_z_push_has_encoded_header(msg)) {
+        _Z_RETURN_IF_ERR(_z_wbuf_write_bytes(wbf, msg->_encoded_header->start, 0, msg->_encoded_header->len));
+    } else {
+        _Z_RETURN_IF_ERR(_z_push_header_encode(wbf, msg));
+    }
+    if (msg->_body._is_put) {
+        _Z_RETURN_IF_ERR(_z_bytes_encode(wbf, &msg->_body._body._put._payload));
+    }
     return _Z_RES_OK;
 }
 
@@ -96,6 +115,7 @@ z_result_t _z_push_decode(_z_n_msg_push_t *msg, _z_zbuf_t *zbf, uint8_t header,
                           uintptr_t mapping) {
     z_result_t ret = _Z_RES_OK;
     msg->_qos = _Z_N_QOS_DEFAULT;
+    msg->_encoded_header = NULL;
     ret |= _z_keyexpr_decode(&msg->_key, zbf, _Z_HAS_FLAG(header, _Z_FLAG_N_PUSH_N),
                              _Z_HAS_FLAG(header, _Z_FLAG_N_PUSH_M), mapping);
     if ((ret == _Z_RES_OK) && _Z_HAS_FLAG(header, _Z_FLAG_N_Z)) {
@@ -16,6 +16,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "zenoh-pico/collections/slice.h"
 #include "zenoh-pico/protocol/codec/core.h"
@@ -67,10 +68,16 @@ z_result_t _z_join_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_join_t
     bool has_patch = msg->_patch != _Z_NO_PATCH;
 #else
     bool has_patch = false;
+#endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    bool has_retx = msg->_retx_window > 0;
+#else
+    bool has_retx = false;
 #endif
     if (msg->_next_sn._is_qos) {
         if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
-            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_QOS | _Z_MSG_EXT_MORE(has_patch)));
+            _Z_RETURN_IF_ERR(
+                _z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_QOS | _Z_MSG_EXT_MORE(has_patch || has_retx)));
             size_t len = 0;
             for (uint8_t i = 0; (i < Z_PRIORITIES_NUM) && (ret == _Z_RES_OK); i++) {
                 len += _z_zint_len(msg->_next_sn._val._qos[i]._reliable) +
@@ -89,7 +96,7 @@ z_result_t _z_join_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_join_t
 #if Z_FEATURE_FRAGMENTATION == 1
     if (has_patch) {
         if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
-            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_PATCH));
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_PATCH | _Z_MSG_EXT_MORE(has_retx)));
             _Z_RETURN_IF_ERR(_z_zint64_encode(wbf, msg->_patch));
         } else {
             _Z_DEBUG("Attempted to serialize Patch extension, but the header extension flag was unset");
@@ -97,6 +104,17 @@ z_result_t _z_join_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_join_t
         }
     }
 #endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    if (has_retx) {
+        if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_RETX));
+            _Z_RETURN_IF_ERR(_z_zint64_encode(wbf, msg->_retx_window));
+        } else {
+            _Z_DEBUG("Attempted to serialize Retx extension, but the header extension flag was unset");
+            ret |= _Z_ERR_MESSAGE_SERIALIZATION_FAILED;
+        }
+    }
+#endif
 
     return ret;
 }
@@ -114,6 +132,10 @@ z_result_t _z_join_decode_ext(_z_msg_ext_t *extension, void *ctx) {
 #if Z_FEATURE_FRAGMENTATION == 1
     } else if (_Z_EXT_FULL_ID(extension->_header) == _Z_MSG_EXT_ID_JOIN_PATCH) {
         msg->_patch = (uint8_t)extension->_body._zint._val;
+#endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    } else if (_Z_EXT_FULL_ID(extension->_header) == _Z_MSG_EXT_ID_JOIN_RETX) {
+        msg->_retx_window = (uint16_t)extension->_body._zint._val;
 #endif
     } else if (_Z_MSG_EXT_IS_MANDATORY(extension->_header)) {
         _Z_ERROR_LOG(_Z_ERR_MESSAGE_EXTENSION_MANDATORY_AND_UNKNOWN);
@@ -203,10 +225,15 @@ z_result_t _z_init_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_init_t
         _Z_RETURN_IF_ERR(_z_slice_encode(wbf, &msg->_cookie))
     }
 
+#if Z_FEATURE_SHM == 1
+    bool has_shm = msg->_shm;
+#else
+    bool has_shm = false;
+#endif
 #if Z_FEATURE_FRAGMENTATION == 1
     if (msg->_patch != _Z_NO_PATCH) {
         if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
-            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_JOIN_PATCH));
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_INIT_PATCH | _Z_MSG_EXT_MORE(has_shm)));
             _Z_RETURN_IF_ERR(_z_zint64_encode(wbf, msg->_patch));
         } else {
             _Z_DEBUG("Attempted to serialize Patch extension, but the header extension flag was unset");
@@ -214,6 +241,21 @@ z_result_t _z_init_encode(_z_wbuf_t *wbf, uint8_t header, const _z_t_msg_init_t
         }
     }
 #endif
+#if Z_FEATURE_SHM == 1
+    if (has_shm) {
+        if (_Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_MSG_EXT_ID_INIT_SHM));
+            _Z_RETURN_IF_ERR(_z_zsize_encode(wbf, 1 + _Z_SHM_HOST_ID_LEN));
+            _Z_RETURN_IF_ERR(_z_uint8_encode(wbf, _Z_SHM_VERSION));
+            _Z_RETURN_IF_ERR(_z_wbuf_write_bytes(wbf, msg->_shm_host_id, 0, _Z_SHM_HOST_ID_LEN));
+        } else {
+            _Z_DEBUG("Attempted to serialize Shm extension, but the header extension flag was unset");
+            ret |= _Z_ERR_MESSAGE_SERIALIZATION_FAILED;
+        }
+    }
+#else
+    _ZP_UNUSED(has_shm);
+#endif
 
     return ret;
 }
@@ -226,6 +268,16 @@ z_result_t _z_init_decode_ext(_z_msg_ext_t *extension, void *ctx) {
     } else if (_Z_EXT_FULL_ID(extension->_header) == _Z_MSG_EXT_ID_INIT_PATCH) {
         _z_t_msg_init_t *msg = (_z_t_msg_init_t *)ctx;
         msg->_patch = (uint8_t)extension->_body._zint._val;
+#endif
+#if Z_FEATURE_SHM == 1
+    } else if (_Z_EXT_FULL_ID(extension->_header) == _Z_MSG_EXT_ID_INIT_SHM) {
+        // Unknown versions are ignored, the session then copies the payloads
+        _z_t_msg_init_t *msg = (_z_t_msg_init_t *)ctx;
+        const _z_slice_t *body = &extension->_body._zbuf._val;
+        if ((body->len == 1 + _Z_SHM_HOST_ID_LEN) && (body->start[0] == _Z_SHM_VERSION)) {
+            msg->_shm = true;
+            memcpy(msg->_shm_host_id, &body->start[1], _Z_SHM_HOST_ID_LEN);
+        }
 #endif
     } else if (_Z_MSG_EXT_IS_MANDATORY(extension->_header)) {
         _Z_ERROR_LOG(_Z_ERR_MESSAGE_EXTENSION_MANDATORY_AND_UNKNOWN);
@@ -276,6 +328,9 @@ z_result_t _z_init_decode(_z_t_msg_init_t *msg, _z_zbuf_t *zbf, uint8_t header)
     }
 #if Z_FEATURE_FRAGMENTATION == 1
     msg->_patch = _Z_NO_PATCH;
+#endif
+#if Z_FEATURE_SHM == 1
+    msg->_shm = false;
 #endif
     if ((ret == _Z_RES_OK) && _Z_HAS_FLAG(header, _Z_FLAG_T_Z)) {
         ret |= _z_msg_ext_decode_iter(zbf, _z_init_decode_ext, msg);
@@ -460,6 +515,7 @@ z_result_t _z_fragment_decode(_z_t_msg_fragment_t *msg, _z_zbuf_t *zbf, uint8_t
         ret |= _z_msg_ext_decode_iter(zbf, _z_fragment_decode_ext, msg);
     }
     msg->_payload = _z_slice_alias_buf((uint8_t *)_z_zbuf_start(zbf), _z_zbuf_len(zbf));
+    msg->_src = &zbf->_slice;
     zbf->_ios._r_pos = zbf->_ios._w_pos;
 
     return ret;
@@ -61,15 +61,15 @@ z_result_t _zp_config_insert_string(_z_config_t *ps, uint8_t key, const _z_strin
 char *_z_config_get(const _z_config_t *ps, uint8_t key) { return _z_str_intmap_get(ps, key); }
 
 z_result_t _z_config_get_all(const _z_config_t *ps, _z_string_svec_t *locators, uint8_t key) {
+    z_result_t ret = _Z_RES_OK;
     _z_list_t *cfg_list = _z_str_intmap_get_all(ps, key);
-    while (cfg_list != NULL) {
-        _z_int_void_map_entry_t *entry = (_z_int_void_map_entry_t *)_z_list_value(cfg_list);
-        char *val = (char *)entry->_val;
-        _z_string_t s = _z_string_copy_from_str(val);
-        _Z_RETURN_IF_ERR(_z_string_svec_append(locators, &s, true));
-        cfg_list = _z_list_next(cfg_list);
+    for (_z_list_t *xs = cfg_list; (xs != NULL) && (ret == _Z_RES_OK); xs = _z_list_next(xs)) {
+        _z_int_void_map_entry_t *entry = (_z_int_void_map_entry_t *)_z_list_value(xs);
+        _z_string_t s = _z_string_copy_from_str((char *)entry->_val);
+        ret = _z_string_svec_append(locators, &s, true);
     }
-    return _Z_RES_OK;
+    _z_list_free(&cfg_list, _z_noop_free);
+    return ret;
 }
 
 /*------------------ int-string map ------------------*/
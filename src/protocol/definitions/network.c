@@ -210,6 +210,7 @@ void _z_n_msg_make_push_put(_z_network_message_t *dst, const _z_keyexpr_t *key,
     dst->_body._push._key = *key;
     dst->_body._push._qos = qos;
     dst->_body._push._timestamp = _z_timestamp_null();
+    dst->_body._push._encoded_header = NULL;
     dst->_body._push._body._is_put = true;
     dst->_body._push._body._body._put._commons._timestamp = (timestamp == NULL) ? _z_timestamp_null() : *timestamp;
     dst->_body._push._body._body._put._commons._source_info =
@@ -217,6 +218,9 @@ void _z_n_msg_make_push_put(_z_network_message_t *dst, const _z_keyexpr_t *key,
     dst->_body._push._body._body._put._payload = (payload == NULL) ? _z_bytes_null() : *payload;
     dst->_body._push._body._body._put._encoding = (encoding == NULL) ? _z_encoding_null() : *encoding;
     dst->_body._push._body._body._put._attachment = (attachment == NULL) ? _z_bytes_null() : *attachment;
+#if Z_FEATURE_SHM == 1
+    dst->_body._push._body._body._put._is_shm = false;
+#endif
 }
 
 void _z_n_msg_make_push_del(_z_network_message_t *dst, const _z_keyexpr_t *key, _z_n_qos_t qos,
@@ -227,6 +231,7 @@ void _z_n_msg_make_push_del(_z_network_message_t *dst, const _z_keyexpr_t *key,
     dst->_body._push._key = *key;
     dst->_body._push._qos = qos;
     dst->_body._push._timestamp = _z_timestamp_null();
+    dst->_body._push._encoded_header = NULL;
     dst->_body._push._body._is_put = false;
     dst->_body._push._body._body._del._commons._timestamp = (timestamp == NULL) ? _z_timestamp_null() : *timestamp;
     dst->_body._push._body._body._del._commons._source_info =
@@ -254,6 +259,9 @@ void _z_n_msg_make_reply_ok_put(_z_network_message_t *dst, const _z_id_t *zid, _
     dst->_body._response._body._reply._body._body._put._encoding = (encoding == NULL) ? _z_encoding_null() : *encoding;
     dst->_body._response._body._reply._body._body._put._attachment =
         (attachment == NULL) ? _z_bytes_null() : *attachment;
+#if Z_FEATURE_SHM == 1
+    dst->_body._response._body._reply._body._body._put._is_shm = false;
+#endif
     dst->_body._response._ext_qos = qos;
     dst->_body._response._ext_timestamp = _z_timestamp_null();
     dst->_body._response._ext_responder._eid = 0;
@@ -308,6 +316,8 @@ void _z_n_msg_make_interest(_z_network_message_t *msg, _z_interest_t interest) {
 
 static z_result_t _z_n_msg_push_copy(_z_network_message_t *dst, const _z_network_message_t *src) {
     memcpy(dst, src, sizeof(_z_network_message_t));
+    // The copy may outlive the publisher owning the encoded header
+    dst->_body._push._encoded_header = NULL;
     _Z_RETURN_IF_ERR(_z_keyexpr_copy(&dst->_body._push._key, &src->_body._push._key));
     return _z_push_body_copy(&dst->_body._push._body, &src->_body._push._body);
 }
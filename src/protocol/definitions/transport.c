@@ -109,6 +109,9 @@ _z_transport_message_t _z_t_msg_make_join(z_whatami_t whatami, _z_zint_t lease,
 #if Z_FEATURE_FRAGMENTATION == 1
     msg._body._join._patch = _Z_CURRENT_PATCH;
 #endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    msg._body._join._retx_window = 0;
+#endif
 
     if ((lease % 1000) == 0) {
         _Z_SET_FLAG(msg._header, _Z_FLAG_T_JOIN_T);
@@ -131,6 +134,13 @@ _z_transport_message_t _z_t_msg_make_join(z_whatami_t whatami, _z_zint_t lease,
     return msg;
 }
 
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+void _z_t_msg_join_set_retx(_z_transport_message_t *msg, uint16_t window) {
+    msg->_body._join._retx_window = window;
+    _Z_SET_FLAG(msg->_header, _Z_FLAG_T_Z);
+}
+#endif
+
 /*------------------ Init Message ------------------*/
 _z_transport_message_t _z_t_msg_make_init_syn(z_whatami_t whatami, _z_id_t zid) {
     _z_transport_message_t msg;
@@ -146,6 +156,9 @@ _z_transport_message_t _z_t_msg_make_init_syn(z_whatami_t whatami, _z_id_t zid)
 #if Z_FEATURE_FRAGMENTATION == 1
     msg._body._init._patch = _Z_CURRENT_PATCH;
 #endif
+#if Z_FEATURE_SHM == 1
+    msg._body._init._shm = false;
+#endif
 
     if ((msg._body._init._batch_size != _Z_DEFAULT_UNICAST_BATCH_SIZE) ||
         (msg._body._init._seq_num_res != _Z_DEFAULT_RESOLUTION_SIZE) ||
@@ -177,6 +190,9 @@ _z_transport_message_t _z_t_msg_make_init_ack(z_whatami_t whatami, _z_id_t zid,
 #if Z_FEATURE_FRAGMENTATION == 1
     msg._body._init._patch = _Z_CURRENT_PATCH;
 #endif
+#if Z_FEATURE_SHM == 1
+    msg._body._init._shm = false;
+#endif
 
     if ((msg._body._init._batch_size != _Z_DEFAULT_UNICAST_BATCH_SIZE) ||
         (msg._body._init._seq_num_res != _Z_DEFAULT_RESOLUTION_SIZE) ||
@@ -192,6 +208,14 @@ _z_transport_message_t _z_t_msg_make_init_ack(z_whatami_t whatami, _z_id_t zid,
     return msg;
 }
 
+#if Z_FEATURE_SHM == 1
+void _z_t_msg_init_set_shm(_z_transport_message_t *msg, const uint8_t *host_id) {
+    msg->_body._init._shm = true;
+    memcpy(msg->_body._init._shm_host_id, host_id, _Z_SHM_HOST_ID_LEN);
+    _Z_SET_FLAG(msg->_header, _Z_FLAG_T_Z);
+}
+#endif
+
 /*------------------ Open Message ------------------*/
 _z_transport_message_t _z_t_msg_make_open_syn(_z_zint_t lease, _z_zint_t initial_sn, _z_slice_t cookie) {
     _z_transport_message_t msg;
@@ -288,6 +312,7 @@ _z_transport_message_t _z_t_msg_make_fragment(_z_zint_t sn, _z_slice_t payload,
 
     msg._body._fragment._sn = sn;
     msg._body._fragment._payload = payload;
+    msg._body._fragment._src = NULL;
     if (first || drop) {
         _Z_SET_FLAG(msg._header, _Z_FLAG_T_Z);
     }
@@ -300,6 +325,7 @@ _z_transport_message_t _z_t_msg_make_fragment(_z_zint_t sn, _z_slice_t payload,
 void _z_t_msg_copy_fragment(_z_t_msg_fragment_t *clone, _z_t_msg_fragment_t *msg) {
     clone->_payload = msg->_payload;
     _z_slice_copy(&clone->_payload, &msg->_payload);
+    clone->_src = NULL;
     clone->first = msg->first;
     clone->drop = msg->drop;
 }
@@ -314,6 +340,9 @@ void _z_t_msg_copy_join(_z_t_msg_join_t *clone, _z_t_msg_join_t *msg) {
     clone->_next_sn = msg->_next_sn;
 #if Z_FEATURE_FRAGMENTATION == 1
     clone->_patch = msg->_patch;
+#endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    clone->_retx_window = msg->_retx_window;
 #endif
     memcpy(clone->_zid.id, msg->_zid.id, 16);
 }
@@ -331,6 +360,10 @@ void _z_t_msg_copy_init(_z_t_msg_init_t *clone, _z_t_msg_init_t *msg) {
 #if Z_FEATURE_FRAGMENTATION == 1
     clone->_patch = msg->_patch;
 #endif
+#if Z_FEATURE_SHM == 1
+    clone->_shm = msg->_shm;
+    memcpy(clone->_shm_host_id, msg->_shm_host_id, _Z_SHM_HOST_ID_LEN);
+#endif
 }
 
 void _z_t_msg_copy_open(_z_t_msg_open_t *clone, _z_t_msg_open_t *msg) {
@@ -135,7 +135,7 @@ _z_zbuf_t _z_zbuf_make(size_t capacity) {
 
 _z_zbuf_t _z_zbuf_view(_z_zbuf_t *zbf, size_t length) {
     assert(_z_iosli_readable(&zbf->_ios) >= length);
-    _z_zbuf_t v;
+    _z_zbuf_t v = _z_zbuf_null();
     v._ios = _z_iosli_wrap(_z_zbuf_get_rptr(zbf), length, 0, length);
     v._slice = zbf->_slice;
     return v;
@@ -505,6 +505,27 @@ z_result_t _z_wbuf_siphon(_z_wbuf_t *dst, _z_wbuf_t *src, size_t length) {
     return ret;
 }
 
+size_t _z_wbuf_gather(_z_wbuf_t *wbf, _z_slice_t *bufs, size_t *count, size_t max_count, size_t length) {
+    size_t len = 0;
+    while ((len < length) && (*count < max_count)) {
+        _z_iosli_t *ios = _z_wbuf_get_iosli(wbf, wbf->_r_idx);
+        size_t readable = _z_iosli_readable(ios);
+        if (readable == (size_t)0) {
+            if (wbf->_r_idx >= wbf->_w_idx) {
+                break;
+            }
+            wbf->_r_idx++;
+            continue;
+        }
+        size_t to_read = (readable <= length - len) ? readable : length - len;
+        bufs[*count] = _z_slice_alias_buf(_z_ptr_u8_offset(ios->_buf, (ptrdiff_t)ios->_r_pos), to_read);
+        (*count)++;
+        ios->_r_pos += to_read;
+        len += to_read;
+    }
+    return len;
+}
+
 void _z_wbuf_copy(_z_wbuf_t *dst, const _z_wbuf_t *src) {
     dst->_r_idx = src->_r_idx;
     dst->_w_idx = src->_w_idx;
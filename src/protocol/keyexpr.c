@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/utils/hash.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/string.h"
@@ -143,6 +144,18 @@ bool _z_keyexpr_equals(const _z_keyexpr_t *left, const _z_keyexpr_t *right) {
     return true;
 }
 
+size_t _z_keyexpr_hash(const _z_keyexpr_t *key) {
+    size_t hash = _z_hash_combine((size_t)_Z_FNV_OFFSET_BASIS, (size_t)key->_id);
+    hash = _z_hash_combine(hash, (size_t)key->_mapping);
+    if (_z_keyexpr_has_suffix(key)) {
+        const uint8_t *data = (const uint8_t *)_z_string_data(&key->_suffix);
+        for (size_t i = 0; i < _z_string_len(&key->_suffix); i++) {
+            hash = _z_hash_combine(hash, (size_t)data[i]);
+        }
+    }
+    return hash;
+}
+
 void _z_keyexpr_alias_from_user_defined(_z_keyexpr_t *dst, const _z_keyexpr_t *src) {
     if ((src->_id != Z_RESOURCE_ID_NONE) || !_z_keyexpr_has_suffix(src)) {
         dst->_id = src->_id;
@@ -156,9 +156,7 @@ typedef struct {
 
 z_result_t ___z_cancellation_token_remove_pending_query(void *arg) {
     __z_cancellation_token_remove_pending_query_arg *typed_arg = (__z_cancellation_token_remove_pending_query_arg *)arg;
-    _z_pending_query_t pq = {0};
-    pq._id = typed_arg->qid;
-    _z_unregister_pending_query(_Z_RC_IN_VAL(&typed_arg->zn), &pq);
+    _z_unregister_pending_query(_Z_RC_IN_VAL(&typed_arg->zn), typed_arg->qid);
     return _Z_RES_OK;
 }
 
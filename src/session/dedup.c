@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/session/dedup.h"
+
+#include <string.h>
+
+void _z_session_dedup_init(_z_session_dedup_t *dedup) { (void)memset(dedup, 0, sizeof(_z_session_dedup_t)); }
+
+static _z_session_dedup_source_t *_z_session_dedup_get_source(_z_session_dedup_t *dedup,
+                                                              const _z_entity_global_id_t *id) {
+    for (uint8_t i = 0; i < dedup->_len; i++) {
+        if (_z_entity_global_id_eq(&dedup->_sources[i]._id, id)) {
+            return &dedup->_sources[i];
+        }
+    }
+    return NULL;
+}
+
+static void _z_session_dedup_add_source(_z_session_dedup_t *dedup, const _z_source_info_t *info) {
+    _z_session_dedup_source_t *src;
+    if (dedup->_len < _Z_SESSION_DEDUP_SOURCE_NB) {
+        src = &dedup->_sources[dedup->_len++];
+    } else {
+        src = &dedup->_sources[dedup->_oldest];
+        dedup->_oldest = (uint8_t)((dedup->_oldest + 1) % _Z_SESSION_DEDUP_SOURCE_NB);
+    }
+    src->_id = info->_source_id;
+    src->_last_sn = info->_source_sn;
+    src->_received = 1;
+}
+
+bool _z_session_dedup_accept(_z_session_dedup_t *dedup, const _z_source_info_t *info) {
+    if (!_z_source_info_check(info)) {
+        return true;
+    }
+    _z_session_dedup_source_t *src = _z_session_dedup_get_source(dedup, &info->_source_id);
+    if (src == NULL) {
+        _z_session_dedup_add_source(dedup, info);
+        return true;
+    }
+    // Wrapping difference, newer SNs are less than half the SN space ahead
+    uint32_t ahead = info->_source_sn - src->_last_sn;
+    if ((ahead != 0) && (ahead < UINT32_MAX / 2)) {
+        src->_received = (ahead < _Z_SESSION_DEDUP_WINDOW) ? ((src->_received << ahead) | 1) : 1;
+        src->_last_sn = info->_source_sn;
+        return true;
+    }
+    uint32_t behind = src->_last_sn - info->_source_sn;
+    if (behind >= _Z_SESSION_DEDUP_WINDOW) {
+        // Can't tell, the window is left untouched so that it keeps filtering the recent SNs
+        return true;
+    }
+    uint64_t bit = (uint64_t)1 << behind;
+    if ((src->_received & bit) != 0) {
+        return false;
+    }
+    src->_received |= bit;
+    return true;
+}
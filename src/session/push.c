@@ -18,14 +18,69 @@
 #include "zenoh-pico/api/primitives.h"
 #include "zenoh-pico/collections/slice.h"
 #include "zenoh-pico/config.h"
+#include "zenoh-pico/session/dedup.h"
+#include "zenoh-pico/session/shm.h"
 #include "zenoh-pico/session/subscription.h"
+#include "zenoh-pico/session/utils.h"
 #include "zenoh-pico/utils/logging.h"
 
+#if Z_FEATURE_SHM == 1
+// Replaces a shared memory payload by the data it points to. It is resolved before the sample may be discarded: the
+// payload then holds the handle the sender took on the chunk for this session, and dropping it gives it back.
+static z_result_t _z_push_resolve_shm(_z_session_t *zn, _z_n_msg_push_t *push, _z_transport_peer_common_t *peer,
+                                      bool *dropped) {
+    *dropped = false;
+    if (!push->_body._is_put || !push->_body._body._put._is_shm) {
+        return _Z_RES_OK;
+    }
+    // Only the peers of this host that negotiated it may send shared memory payloads
+    if ((peer == NULL) || !peer->_shm) {
+        _z_n_msg_push_clear(push);
+        _Z_ERROR_RETURN(_Z_ERR_MESSAGE_UNEXPECTED);
+    }
+    _z_session_mutex_lock(zn);
+    z_result_t ret = _z_shm_bytes_from_info(&zn->_shm_segments, &push->_body._body._put._payload);
+    _z_session_mutex_unlock(zn);
+    if (ret != _Z_RES_OK) {
+        // The segment may be gone with its process, drop the sample rather than the session
+        _Z_INFO("Dropping shared memory sample that could not be mapped");
+        _z_n_msg_push_clear(push);
+        *dropped = true;
+    }
+    return _Z_RES_OK;
+}
+#endif
+
 #if Z_FEATURE_SUBSCRIPTION == 1
 z_result_t _z_trigger_push(_z_session_t *zn, _z_n_msg_push_t *push, z_reliability_t reliability,
                            _z_transport_peer_common_t *peer) {
     z_result_t ret = _Z_RES_OK;
 
+#if Z_FEATURE_SHM == 1
+    bool dropped = false;
+    _Z_RETURN_IF_ERR(_z_push_resolve_shm(zn, push, peer, &dropped));
+    if (dropped) {
+        return _Z_RES_OK;
+    }
+#endif
+    _z_source_info_t *info = push->_body._is_put ? &push->_body._body._put._commons._source_info
+                                                 : &push->_body._body._del._commons._source_info;
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    // The same sample may reach the session through the main transport and a multicast group
+    if (_z_session_has_groups(zn)) {
+        _z_session_mutex_lock(zn);
+        bool accepted = _z_session_dedup_accept(&zn->_dedup, info);
+        _z_session_mutex_unlock(zn);
+        if (!accepted) {
+            _z_n_msg_push_clear(push);
+            return _Z_RES_OK;
+        }
+    }
+#endif
+    // The stamp of a sender that joined groups is only meant for deduplication, it wasn't set by the publisher
+    if (_z_session_dedup_is_stamp(info)) {
+        *info = _z_source_info_null();
+    }
     // Memory cleaning must be done in the feature layer
     if (push->_body._is_put) {
         _z_msg_put_t *put = &push->_body._body._put;
@@ -42,10 +97,20 @@ z_result_t _z_trigger_push(_z_session_t *zn, _z_n_msg_push_t *push, z_reliabilit
 #else
 z_result_t _z_trigger_push(_z_session_t *zn, _z_n_msg_push_t *push, z_reliability_t reliability,
                            _z_transport_peer_common_t *peer) {
+    _ZP_UNUSED(reliability);
+#if Z_FEATURE_SHM == 1
+    // The sample is discarded, a shared memory payload still has to give back the handle taken for this session
+    bool dropped = false;
+    _Z_RETURN_IF_ERR(_z_push_resolve_shm(zn, push, peer, &dropped));
+    if (!dropped) {
+        _z_n_msg_push_clear(push);
+    }
+    return _Z_RES_OK;
+#else
     _ZP_UNUSED(zn);
     _ZP_UNUSED(push);
-    _ZP_UNUSED(reliability);
     _ZP_UNUSED(peer);
     return _Z_RES_OK;
+#endif
 }
 #endif
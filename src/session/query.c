@@ -15,6 +15,7 @@
 #include "zenoh-pico/session/query.h"
 
 #include <stddef.h>
+#include <string.h>
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/net/reply.h"
@@ -22,15 +23,60 @@
 #include "zenoh-pico/protocol/keyexpr.h"
 #include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/utils/hash.h"
 #include "zenoh-pico/utils/locality.h"
 #include "zenoh-pico/utils/logging.h"
 
 #if Z_FEATURE_QUERY == 1
+/*------------------ Pending reply index ------------------*/
+// Index entries use the pending reply itself as key, lookups are done with a stack probe reply
+static const _z_string_t *_z_pending_reply_index_key(const _z_pending_reply_t *pen_rep) {
+    return &pen_rep->_reply.data._result.sample.keyexpr._suffix;
+}
+
+static size_t _z_pending_reply_index_hash(const void *key) {
+    const _z_string_t *str = _z_pending_reply_index_key((const _z_pending_reply_t *)key);
+    size_t hash = _Z_FNV_OFFSET_BASIS;
+    const uint8_t *data = (const uint8_t *)_z_string_data(str);
+    for (size_t i = 0; i < _z_string_len(str); i++) {
+        hash = _z_hash_combine(hash, (size_t)data[i]);
+    }
+    return hash;
+}
+
+static bool _z_pending_reply_index_eq(const void *left, const void *right) {
+    const _z_pending_reply_t *l = (const _z_pending_reply_t *)((const _z_hashmap_entry_t *)left)->_key;
+    const _z_pending_reply_t *r = (const _z_pending_reply_t *)((const _z_hashmap_entry_t *)right)->_key;
+    return _z_string_equals(_z_pending_reply_index_key(l), _z_pending_reply_index_key(r));
+}
+
+static void _z_pending_reply_index_entry_free(void **e) {
+    z_free(*e);
+    *e = NULL;
+}
+
+static void _z_pending_reply_index_clear(_z_pending_query_t *pen_qry) {
+    _z_hashmap_clear(&pen_qry->_pending_replies_index, _z_pending_reply_index_entry_free);
+}
+
+static _z_pending_reply_t *__z_pending_query_get_reply(const _z_pending_query_t *pen_qry,
+                                                       const _z_keyexpr_t *keyexpr) {
+    _z_pending_reply_t probe;
+    probe._reply.data._result.sample.keyexpr = *keyexpr;  // Shallow copy, probe is never cleared
+    return (_z_pending_reply_t *)_z_hashmap_get(&pen_qry->_pending_replies_index, &probe);
+}
+
+static bool __z_pending_query_index_reply(_z_pending_query_t *pen_qry, _z_pending_reply_t *pen_rep) {
+    return _z_hashmap_insert(&pen_qry->_pending_replies_index, pen_rep, pen_rep, _z_pending_reply_index_entry_free,
+                             false) != NULL;
+}
+
 void _z_pending_query_clear(_z_pending_query_t *pen_qry) {
     if (pen_qry->_dropper != NULL) {
         pen_qry->_dropper(pen_qry->_arg);
     }
     _z_keyexpr_clear(&pen_qry->_key);
+    _z_pending_reply_index_clear(pen_qry);
     _z_pending_reply_slist_free(&pen_qry->_pending_replies);
     pen_qry->_allowed_destination = z_locality_default();
     pen_qry->_remaining_finals = 0;
@@ -38,52 +84,66 @@ void _z_pending_query_clear(_z_pending_query_t *pen_qry) {
 
 bool _z_pending_query_eq(const _z_pending_query_t *one, const _z_pending_query_t *two) { return one->_id == two->_id; }
 
-static bool _z_pending_query_timeout(const _z_pending_query_t *foo, const _z_pending_query_t *pq) {
-    _ZP_UNUSED(foo);
-    bool result = z_clock_elapsed_ms((z_clock_t *)&pq->_start_time) >= pq->_timeout;
-    if (result) {
-        _Z_INFO("Dropping query because of timeout");
+// z_clock_elapsed_ms may wrap around within days on 32 bits targets, the clock is moved forward long before that
+#define _Z_PENDING_QUERY_CLOCK_REBASE_MS (1UL << 30)
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static uint64_t __unsafe_z_pending_query_now_ms(_z_session_t *zn) {
+    unsigned long elapsed = z_clock_elapsed_ms(&zn->_pending_query_clock);
+    if (elapsed >= _Z_PENDING_QUERY_CLOCK_REBASE_MS) {
+        z_clock_advance_ms(&zn->_pending_query_clock, elapsed);
+        zn->_pending_query_clock_base += elapsed;
+        elapsed = 0;
     }
-    return result;
+    return zn->_pending_query_clock_base + elapsed;
+}
+
+void _z_pending_queries_init(_z_session_t *zn) {
+    _z_int_void_map_init(&zn->_pending_queries, Z_PENDING_QUERY_INDEX_CAPACITY);
+    zn->_pending_query_clock = z_clock_now();
+    zn->_pending_query_clock_base = 0;
+    _z_timer_wheel_init(&zn->_pending_query_timers, 0);
+}
+
+/**
+ * This function is unsafe because it operates in potentially concurrent data.
+ * Make sure that the following mutexes are locked before calling this function:
+ *  - zn->_mutex_inner
+ */
+static void __unsafe_z_drop_pending_query(_z_session_t *zn, _z_pending_query_t *pen_qry) {
+    _z_timer_wheel_remove(&zn->_pending_query_timers, &pen_qry->_timer);
+    _z_pending_query_intmap_remove(&zn->_pending_queries, (size_t)pen_qry->_id);
+}
+
+static void _z_pending_query_expire(_z_timer_wheel_node_t *timer, void *arg) {
+    _z_pending_query_t *pen_qry = (_z_pending_query_t *)((uint8_t *)timer - offsetof(_z_pending_query_t, _timer));
+    _Z_INFO("Dropping query because of timeout");
+    __unsafe_z_drop_pending_query((_z_session_t *)arg, pen_qry);
 }
 
 void _z_pending_query_process_timeout(_z_session_t *zn) {
     // Lock session
     _z_session_mutex_lock(zn);
     // Drop all queries with timeout elapsed
-    zn->_pending_queries =
-        _z_pending_query_slist_drop_first_filter(zn->_pending_queries, _z_pending_query_timeout, NULL);
+    _z_timer_wheel_advance(&zn->_pending_query_timers, __unsafe_z_pending_query_now_ms(zn), _z_pending_query_expire,
+                           zn);
     _z_session_mutex_unlock(zn);
 }
 
 /*------------------ Query ------------------*/
 _z_zint_t _z_get_query_id(_z_session_t *zn) { return zn->_query_id++; }
 
-_z_pending_query_t *__z_get_pending_query_by_id(_z_pending_query_slist_t *pqls, const _z_zint_t id) {
-    _z_pending_query_t *ret = NULL;
-
-    _z_pending_query_slist_t *xs = pqls;
-    while (xs != NULL) {
-        _z_pending_query_t *pql = _z_pending_query_slist_value(xs);
-        if (pql->_id == id) {
-            ret = pql;
-            break;
-        }
-
-        xs = _z_pending_query_slist_next(xs);
-    }
-
-    return ret;
-}
-
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
  *  - zn->_mutex_inner
  */
 _z_pending_query_t *__unsafe__z_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id) {
-    _z_pending_query_slist_t *pqls = zn->_pending_queries;
-    return __z_get_pending_query_by_id(pqls, id);
+    return _z_pending_query_intmap_get(&zn->_pending_queries, (size_t)id);
 }
 
 _z_pending_query_t *_z_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t id) {
@@ -95,18 +155,30 @@ _z_pending_query_t *_z_get_pending_query_by_id(_z_session_t *zn, const _z_zint_t
     return pql;
 }
 
-z_result_t _z_unsafe_register_pending_query(_z_session_t *zn, _z_zint_t id) {
-    z_result_t ret = _Z_RES_OK;
-
-    _z_pending_query_t *pql = __unsafe__z_get_pending_query_by_id(zn, id);
-    if (pql == NULL) {  // Register query only if a pending one with the same ID does not exist
-        zn->_pending_queries = _z_pending_query_slist_push_empty(zn->_pending_queries);
-    } else {
+_z_pending_query_t *_z_unsafe_register_pending_query(_z_session_t *zn, _z_zint_t id, uint64_t timeout_ms) {
+    if (__unsafe__z_get_pending_query_by_id(zn, id) != NULL) {
+        // Register query only if a pending one with the same ID does not exist
         _Z_ERROR_LOG(_Z_ERR_ENTITY_DECLARATION_FAILED);
-        ret = _Z_ERR_ENTITY_DECLARATION_FAILED;
+        return NULL;
     }
-
-    return ret;
+    _z_pending_query_t *pen_qry = (_z_pending_query_t *)z_malloc(sizeof(_z_pending_query_t));
+    if (pen_qry == NULL) {
+        _Z_ERROR_LOG(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        return NULL;
+    }
+    (void)memset(pen_qry, 0, sizeof(_z_pending_query_t));
+    pen_qry->_id = id;
+    _z_hashmap_init(&pen_qry->_pending_replies_index, _Z_DEFAULT_HASHMAP_CAPACITY, _z_pending_reply_index_hash,
+                    _z_pending_reply_index_eq);
+    _z_timer_wheel_node_init(&pen_qry->_timer);
+    if (_z_pending_query_intmap_insert(&zn->_pending_queries, (size_t)id, pen_qry) == NULL) {
+        _Z_ERROR_LOG(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        z_free(pen_qry);
+        return NULL;
+    }
+    _z_timer_wheel_add(&zn->_pending_query_timers, &pen_qry->_timer,
+                       __unsafe_z_pending_query_now_ms(zn) + timeout_ms);
+    return pen_qry;
 }
 
 static z_result_t _z_trigger_query_reply_partial_inner(_z_session_t *zn, const _z_zint_t id,
@@ -135,26 +207,9 @@ static z_result_t _z_trigger_query_reply_partial_inner(_z_session_t *zn, const _
     // Process monotonic & latest consolidation mode
     if ((pen_qry->_consolidation == Z_CONSOLIDATION_MODE_LATEST) ||
         (pen_qry->_consolidation == Z_CONSOLIDATION_MODE_MONOTONIC)) {
-        bool drop = false;
-        _z_pending_reply_slist_t *curr_node = pen_qry->_pending_replies;
-        _z_pending_reply_t *pen_rep = NULL;
-
-        // Verify if this is a newer reply, free the old one in case it is
-        while (curr_node != NULL) {
-            pen_rep = _z_pending_reply_slist_value(curr_node);
-            // Check if this is the same resource key
-            if (_z_string_equals(&pen_rep->_reply.data._result.sample.keyexpr._suffix,
-                                 &reply.data._result.sample.keyexpr._suffix)) {
-                if (msg->_commons._timestamp.time <= pen_rep->_tstamp.time) {
-                    drop = true;
-                } else {
-                    pen_qry->_pending_replies = _z_pending_reply_slist_drop_first_filter(pen_qry->_pending_replies,
-                                                                                         _z_pending_reply_eq, pen_rep);
-                }
-                break;
-            }
-            curr_node = _z_pending_reply_slist_next(curr_node);
-        }
+        // Verify if this is a newer reply than the one stored for the same key
+        _z_pending_reply_t *pen_rep = __z_pending_query_get_reply(pen_qry, &reply.data._result.sample.keyexpr);
+        bool drop = (pen_rep != NULL) && (msg->_commons._timestamp.time <= pen_rep->_tstamp.time);
         if (!drop) {
             // Cache most recent reply
             _z_pending_reply_t tmp_rep;
@@ -172,7 +227,26 @@ static z_result_t _z_trigger_query_reply_partial_inner(_z_session_t *zn, const _
                                        _z_session_mutex_unlock(zn));
             }
             tmp_rep._tstamp = _z_timestamp_duplicate(&msg->_commons._timestamp);
-            pen_qry->_pending_replies = _z_pending_reply_slist_push(pen_qry->_pending_replies, &tmp_rep);
+            if (pen_rep != NULL) {
+                // Replace the older reply in place, its index entry keeps pointing to it
+                _z_pending_reply_clear(pen_rep);
+                *pen_rep = tmp_rep;
+            } else {
+                _z_pending_reply_slist_t *pen_reps = _z_pending_reply_slist_push(pen_qry->_pending_replies, &tmp_rep);
+                if (pen_reps == pen_qry->_pending_replies) {
+                    _z_pending_reply_clear(&tmp_rep);
+                    _z_reply_clear(&reply);
+                    _z_session_mutex_unlock(zn);
+                    _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+                }
+                if (!__z_pending_query_index_reply(pen_qry, _z_pending_reply_slist_value(pen_reps))) {
+                    (void)_z_pending_reply_slist_pop(pen_reps);
+                    _z_reply_clear(&reply);
+                    _z_session_mutex_unlock(zn);
+                    _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+                }
+                pen_qry->_pending_replies = pen_reps;
+            }
             _Z_DEBUG("stored reply for id=%jd consolidation=%d", (intmax_t)id, pen_qry->_consolidation);
         }
     }
@@ -237,6 +311,7 @@ z_result_t _z_trigger_query_reply_final(_z_session_t *zn, _z_zint_t id) {
     bool do_finalize = (pen_qry->_remaining_finals == 0);
 
     if (pen_qry->_consolidation == Z_CONSOLIDATION_MODE_LATEST && do_finalize) {
+        _z_pending_reply_index_clear(pen_qry);
         while (pen_qry->_pending_replies != NULL) {
             _z_pending_reply_t *pen_rep = _z_pending_reply_slist_value(pen_qry->_pending_replies);
 
@@ -249,24 +324,27 @@ z_result_t _z_trigger_query_reply_final(_z_session_t *zn, _z_zint_t id) {
     // Finalize query if requested: drop pending query and trigger dropper callback,
     // which is equivalent to a reply with FINAL.
     if (do_finalize) {
-        zn->_pending_queries =
-            _z_pending_query_slist_drop_first_filter(zn->_pending_queries, _z_pending_query_eq, pen_qry);
+        __unsafe_z_drop_pending_query(zn, pen_qry);
     }
     _z_session_mutex_unlock(zn);
     return _Z_RES_OK;
 }
 
-void _z_unregister_pending_query(_z_session_t *zn, _z_pending_query_t *pen_qry) {
+void _z_unregister_pending_query(_z_session_t *zn, _z_zint_t id) {
     _z_session_mutex_lock(zn);
 
-    zn->_pending_queries = _z_pending_query_slist_drop_first_filter(zn->_pending_queries, _z_pending_query_eq, pen_qry);
+    _z_pending_query_t *pen_qry = __unsafe__z_get_pending_query_by_id(zn, id);
+    if (pen_qry != NULL) {
+        __unsafe_z_drop_pending_query(zn, pen_qry);
+    }
 
     _z_session_mutex_unlock(zn);
 }
 
 void _z_flush_pending_queries(_z_session_t *zn) {
     _z_session_mutex_lock(zn);
-    _z_pending_query_slist_free(&zn->_pending_queries);
+    _z_timer_wheel_clear(&zn->_pending_query_timers);
+    _z_pending_query_intmap_clear(&zn->_pending_queries);
     _z_session_mutex_unlock(zn);
 }
 #else
@@ -25,6 +25,7 @@
 #include "zenoh-pico/protocol/keyexpr.h"
 #include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/utils/hash.h"
 #include "zenoh-pico/utils/locality.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/pointers.h"
@@ -50,13 +51,16 @@ void _z_queryable_cache_invalidate(_z_session_t *zn) {
 }
 
 #if Z_FEATURE_RX_CACHE == 1
-int _z_queryable_cache_data_compare(const void *first, const void *second) {
+size_t _z_queryable_cache_data_hash(const void *e) {
+    const _z_queryable_cache_data_t *data = (const _z_queryable_cache_data_t *)e;
+    return _z_hash_combine(_z_keyexpr_hash(&data->ke_in), (size_t)data->is_remote);
+}
+
+bool _z_queryable_cache_data_eq(const void *first, const void *second) {
     const _z_queryable_cache_data_t *first_data = (const _z_queryable_cache_data_t *)first;
     const _z_queryable_cache_data_t *second_data = (const _z_queryable_cache_data_t *)second;
-    if (first_data->is_remote != second_data->is_remote) {
-        return (int)first_data->is_remote - (int)second_data->is_remote;
-    }
-    return _z_keyexpr_compare(&first_data->ke_in, &second_data->ke_in);
+    return (first_data->is_remote == second_data->is_remote) &&
+           _z_keyexpr_equals(&first_data->ke_in, &second_data->ke_in);
 }
 #endif  // Z_FEATURE_RX_CACHE == 1
 
@@ -106,44 +110,49 @@ static _z_session_queryable_rc_t *__unsafe_z_get_session_queryable_by_id(_z_sess
     return __z_get_session_queryable_by_id(qles, id);
 }
 
-/**
- * This function is unsafe because it operates in potentially concurrent data.
- * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
- */
-static z_result_t __unsafe_z_get_session_queryables_by_key(_z_session_t *zn, const _z_keyexpr_t *key, bool is_remote,
-                                                           _z_session_queryable_rc_svec_t *qle_infos) {
-    _z_session_queryable_rc_slist_t *qles = zn->_local_queryable;
+typedef struct {
+    const _z_keyexpr_t *key;
+    bool is_remote;
+    _z_session_queryable_rc_svec_t *qle_infos;
+    z_result_t ret;
+} _z_session_queryable_match_ctx_t;
+
+static void _z_session_queryable_match_candidate(void *val, void *arg) {
+    _z_session_queryable_match_ctx_t *ctx = (_z_session_queryable_match_ctx_t *)arg;
+    _z_session_queryable_rc_t *qle = (_z_session_queryable_rc_t *)val;
+    const _z_session_queryable_t *qle_val = _Z_RC_IN_VAL(qle);
+    if (ctx->ret != _Z_RES_OK) {
+        return;
+    }
+    bool origin_allowed = ctx->is_remote ? _z_locality_allows_remote(qle_val->_allowed_origin)
+                                         : _z_locality_allows_local(qle_val->_allowed_origin);
+    // Tree yields candidates, the exact intersection check is still needed for wildcard chunks
+    if (origin_allowed && _z_keyexpr_suffix_intersects(&qle_val->_key, ctx->key)) {
+        _z_session_queryable_rc_t qle_clone = _z_session_queryable_rc_clone(qle);
+        ctx->ret = _z_session_queryable_rc_svec_append(ctx->qle_infos, &qle_clone, true);
+    }
+}
 
+// Reads the published copy of the tree, doesn't need the session mutex
+static z_result_t _z_get_session_queryables_by_key(_z_session_t *zn, const _z_keyexpr_t *key, bool is_remote,
+                                                   _z_session_queryable_rc_svec_t *qle_infos) {
     *qle_infos = _z_session_queryable_rc_svec_make(_Z_QLEINFOS_VEC_SIZE);
     _Z_RETURN_ERR_OOM_IF_TRUE(qle_infos->_val == NULL);
-    _z_session_queryable_rc_slist_t *xs = qles;
-    while (xs != NULL) {
-        // Parse queryable list
-        _z_session_queryable_rc_t *qle = _z_session_queryable_rc_slist_value(xs);
-        const _z_session_queryable_t *qle_val = _Z_RC_IN_VAL(qle);
-        bool origin_allowed = is_remote ? _z_locality_allows_remote(qle_val->_allowed_origin)
-                                        : _z_locality_allows_local(qle_val->_allowed_origin);
-        if (origin_allowed && _z_keyexpr_suffix_intersects(&qle_val->_key, key)) {
-            _z_session_queryable_rc_t qle_clone = _z_session_queryable_rc_clone(qle);
-            _Z_CLEAN_RETURN_IF_ERR(_z_session_queryable_rc_svec_append(qle_infos, &qle_clone, true),
-                                   _z_session_queryable_rc_svec_clear(qle_infos));
-        }
-        xs = _z_session_queryable_rc_slist_next(xs);
+    _z_session_queryable_match_ctx_t ctx = {
+        .key = key, .is_remote = is_remote, .qle_infos = qle_infos, .ret = _Z_RES_OK};
+    _z_keyexpr_tree_rcu_intersect(&zn->_local_queryable_tree, &key->_suffix, _z_session_queryable_match_candidate,
+                                  &ctx);
+    if (ctx.ret != _Z_RES_OK) {
+        _z_session_queryable_rc_svec_clear(qle_infos);
     }
-    return _Z_RES_OK;
+    return ctx.ret;
 }
 
-/**
- * This function is unsafe because it operates in potentially concurrent data.
- * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
- */
-static z_result_t __unsafe_z_get_session_queryables_rc_by_key(_z_session_t *zn, const _z_keyexpr_t *key, bool is_remote,
-                                                              _z_session_queryable_rc_svec_rc_t *qle_infos) {
+static z_result_t _z_get_session_queryables_rc_by_key(_z_session_t *zn, const _z_keyexpr_t *key, bool is_remote,
+                                                      _z_session_queryable_rc_svec_rc_t *qle_infos) {
     *qle_infos = _z_session_queryable_rc_svec_rc_new_undefined();
     z_result_t ret = !_Z_RC_IS_NULL(qle_infos) ? _Z_RES_OK : _Z_ERR_SYSTEM_OUT_OF_MEMORY;
-    _Z_SET_IF_OK(ret, __unsafe_z_get_session_queryables_by_key(zn, key, is_remote, _Z_RC_IN_VAL(qle_infos)));
+    _Z_SET_IF_OK(ret, _z_get_session_queryables_by_key(zn, key, is_remote, _Z_RC_IN_VAL(qle_infos)));
     if (ret != _Z_RES_OK) {
         _z_session_queryable_rc_svec_rc_drop(qle_infos);
     }
@@ -169,7 +178,20 @@ _z_session_queryable_rc_t *_z_register_session_queryable(_z_session_t *zn, _z_se
     zn->_local_queryable = _z_session_queryable_rc_slist_push_empty(zn->_local_queryable);
     ret = _z_session_queryable_rc_slist_value(zn->_local_queryable);
     *ret = _z_session_queryable_rc_new_from_val(q);
+    if (_Z_RC_IS_NULL(ret)) {
+        zn->_local_queryable = _z_session_queryable_rc_slist_pop(zn->_local_queryable);
+        ret = NULL;
+    }
     _z_session_mutex_unlock(zn);
+    // The tree points to the stored queryable, which stays in place until it is unregistered
+    if ((ret != NULL) &&
+        (_z_keyexpr_tree_rcu_insert(&zn->_local_queryable_tree, &_Z_RC_IN_VAL(ret)->_key._suffix, ret) != _Z_RES_OK)) {
+        _z_session_mutex_lock(zn);
+        zn->_local_queryable =
+            _z_session_queryable_rc_slist_drop_first_filter(zn->_local_queryable, _z_session_queryable_rc_eq, ret);
+        _z_session_mutex_unlock(zn);
+        ret = NULL;
+    }
 
 #if Z_FEATURE_LOCAL_QUERYABLE == 1
     if (ret != NULL && _z_locality_allows_local(q->_allowed_origin)) {
@@ -184,15 +206,14 @@ _z_session_queryable_rc_t *_z_register_session_queryable(_z_session_t *zn, _z_se
 static z_result_t _z_session_queryable_get_infos(_z_session_t *zn, _z_queryable_cache_data_t *infos,
                                                  _z_transport_peer_common_t *peer) {
     infos->is_remote = (peer != NULL);
-    _z_session_mutex_lock(zn);
-    _z_queryable_cache_data_t *cache_entry = NULL;
     z_result_t ret = _Z_RES_OK;
 #if Z_FEATURE_RX_CACHE == 1
-    cache_entry = _z_queryable_lru_cache_get(&zn->_queryable_cache, infos);
+    // The cache is shared with the other rx tasks and invalidated by declarations
+    _z_session_mutex_lock(zn);
+    _z_queryable_cache_data_t *cache_entry = _z_queryable_lru_cache_get(&zn->_queryable_cache, infos);
     if (cache_entry != NULL && cache_entry->is_remote != infos->is_remote) {
         cache_entry = NULL;
     }
-#endif
     if (cache_entry != NULL) {  // Copy cache entry
         infos->infos = _z_session_queryable_rc_svec_rc_clone(&cache_entry->infos);
         ret = _z_keyexpr_copy(&infos->ke_out, &cache_entry->ke_out);
@@ -203,9 +224,7 @@ static z_result_t _z_session_queryable_get_infos(_z_session_t *zn, _z_queryable_
         // to make a copy of ke to account for such events
         infos->ke_out = __unsafe_z_get_expanded_key_from_key(zn, &infos->ke_in, false, peer);
         ret = _z_keyexpr_has_suffix(&infos->ke_out) ? _Z_RES_OK : _Z_ERR_KEYEXPR_UNKNOWN;
-        _Z_SET_IF_OK(ret,
-                     __unsafe_z_get_session_queryables_rc_by_key(zn, &infos->ke_out, infos->is_remote, &infos->infos));
-#if Z_FEATURE_RX_CACHE == 1
+        _Z_SET_IF_OK(ret, _z_get_session_queryables_rc_by_key(zn, &infos->ke_out, infos->is_remote, &infos->infos));
         // Update cache
         _z_queryable_cache_data_t cache_storage = _z_queryable_cache_data_null();
         cache_storage.infos = _z_session_queryable_rc_svec_rc_clone(&infos->infos);
@@ -216,12 +235,19 @@ static z_result_t _z_session_queryable_get_infos(_z_session_t *zn, _z_queryable_
         if (ret != _Z_RES_OK) {
             _z_queryable_cache_data_clear(&cache_storage);
         }
-#endif
     }
+    _z_session_mutex_unlock(zn);
+#else
+    _Z_DEBUG("Resolving %d - %.*s on mapping 0x%x", infos->ke_in._id, (int)_z_string_len(&infos->ke_in._suffix),
+             _z_string_data(&infos->ke_in._suffix), (unsigned int)infos->ke_in._mapping);
+    // Only keys declared with an id need the session mutex, to read the resources
+    infos->ke_out = _z_get_expanded_key_from_key(zn, &infos->ke_in, peer);
+    ret = _z_keyexpr_has_suffix(&infos->ke_out) ? _Z_RES_OK : _Z_ERR_KEYEXPR_UNKNOWN;
+    _Z_SET_IF_OK(ret, _z_get_session_queryables_rc_by_key(zn, &infos->ke_out, infos->is_remote, &infos->infos));
+#endif
     if (ret != _Z_RES_OK) {
         _z_queryable_cache_data_clear(infos);
     }
-    _z_session_mutex_unlock(zn);
     return ret;
 }
 
@@ -257,6 +283,7 @@ z_result_t _z_trigger_queryables(_z_transport_common_t *transport, _z_msg_query_
     *_Z_RC_IN_VAL(&query) = _z_query_steal_data(&msgq->_ext_value, &qle_infos.ke_out, &msgq->_parameters,
                                                 &transport->_session, qid, &msgq->_ext_attachment, anyke);
     _Z_RC_IN_VAL(&query)->_is_local = peer == NULL;
+    _Z_RC_IN_VAL(&query)->_transport = transport;
 
     // Parse session_queryable svec
     for (size_t i = 0; i < qle_nb; i++) {
@@ -279,6 +306,9 @@ void _z_unregister_session_queryable(_z_session_t *zn, _z_session_queryable_rc_t
     _z_session_queryable_t *qle_val = _Z_RC_IN_VAL(qle);
     _z_write_filter_notify_queryable(zn, &qle_val->_key, qle_val->_allowed_origin, qle_val->_complete, false);
 #endif
+    // The stored queryable is only dropped once the rx path can't reach it through the tree
+    (void)_z_keyexpr_tree_rcu_remove_if(&zn->_local_queryable_tree, &_Z_RC_IN_VAL(qle)->_key._suffix,
+                                        (z_element_eq_f)_z_session_queryable_rc_eq, qle);
     _z_session_mutex_lock(zn);
 
     zn->_local_queryable =
@@ -288,6 +318,7 @@ void _z_unregister_session_queryable(_z_session_t *zn, _z_session_queryable_rc_t
 }
 
 void _z_flush_session_queryable(_z_session_t *zn) {
+    _z_keyexpr_tree_rcu_clear(&zn->_local_queryable_tree);
     _z_session_mutex_lock(zn);
 
     _z_session_queryable_rc_slist_free(&zn->_local_queryable);
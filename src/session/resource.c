@@ -16,6 +16,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "zenoh-pico/api/types.h"
 #include "zenoh-pico/config.h"
@@ -24,12 +25,16 @@
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/session/utils.h"
 #include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/hash.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/pointers.h"
 
 bool _z_resource_eq(const _z_resource_t *other, const _z_resource_t *this_) { return this_->_id == other->_id; }
 
-void _z_resource_clear(_z_resource_t *res) { _z_keyexpr_clear(&res->_key); }
+void _z_resource_clear(_z_resource_t *res) {
+    _z_string_clear(&res->_expanded);
+    _z_keyexpr_clear(&res->_key);
+}
 
 size_t _z_resource_size(_z_resource_t *p) {
     _ZP_UNUSED(p);
@@ -38,6 +43,11 @@ size_t _z_resource_size(_z_resource_t *p) {
 
 void _z_resource_copy(_z_resource_t *dst, const _z_resource_t *src) {
     _z_keyexpr_copy(&dst->_key, &src->_key);
+    if (dst->_key._id == Z_RESOURCE_ID_NONE) {
+        dst->_expanded = _z_string_alias(dst->_key._suffix);
+    } else {
+        _z_string_copy(&dst->_expanded, &src->_expanded);
+    }
     dst->_id = src->_id;
     dst->_refcount = src->_refcount;
 }
@@ -53,120 +63,146 @@ void _z_resource_free(_z_resource_t **res) {
     }
 }
 
-/*------------------ Entity ------------------*/
-uint32_t _z_get_entity_id(_z_session_t *zn) { return zn->_entity_id++; }
-
-uint16_t _z_get_resource_id(_z_session_t *zn) { return zn->_resource_id++; }
+/*------------------ Resource index ------------------*/
+// Index entries use the indexed resource itself as key, lookups are done with a stack probe resource
+static size_t _z_resource_index_id_hash(const void *key) {
+    const _z_resource_t *res = (const _z_resource_t *)key;
+    return _z_hash_combine((size_t)res->_id, (size_t)res->_key._mapping);
+}
 
-/*------------------ Resource ------------------*/
-_z_resource_t *__z_get_resource_by_id(_z_resource_slist_t *rl, uintptr_t mapping, const _z_zint_t id) {
-    _z_resource_t *ret = NULL;
-
-    _z_resource_slist_t *xs = rl;
-    while (xs != NULL) {
-        _z_resource_t *r = _z_resource_slist_value(xs);
-        if (r->_id == id && r->_key._mapping == mapping) {
-            ret = r;
-            break;
-        }
+static bool _z_resource_index_id_eq(const void *left, const void *right) {
+    const _z_resource_t *l = (const _z_resource_t *)((const _z_hashmap_entry_t *)left)->_key;
+    const _z_resource_t *r = (const _z_resource_t *)((const _z_hashmap_entry_t *)right)->_key;
+    return (l->_id == r->_id) && (l->_key._mapping == r->_key._mapping);
+}
 
-        xs = _z_resource_slist_next(xs);
+static size_t _z_resource_index_key_hash(const void *key) {
+    const _z_keyexpr_t *ke = &((const _z_resource_t *)key)->_key;
+    size_t hash = _z_hash_combine(_Z_FNV_OFFSET_BASIS, (size_t)ke->_id);
+    hash = _z_hash_combine(hash, (size_t)ke->_mapping);
+    const uint8_t *data = (const uint8_t *)_z_string_data(&ke->_suffix);
+    for (size_t i = 0; i < _z_string_len(&ke->_suffix); i++) {
+        hash = _z_hash_combine(hash, (size_t)data[i]);
     }
+    return hash;
+}
 
-    return ret;
+static bool _z_resource_index_key_eq(const void *left, const void *right) {
+    const _z_resource_t *l = (const _z_resource_t *)((const _z_hashmap_entry_t *)left)->_key;
+    const _z_resource_t *r = (const _z_resource_t *)((const _z_hashmap_entry_t *)right)->_key;
+    return _z_keyexpr_equals(&l->_key, &r->_key);
 }
 
-_z_resource_t *__z_get_resource_by_key(_z_resource_slist_t *rl, const _z_keyexpr_t *keyexpr) {
-    _z_resource_t *ret = NULL;
-    _z_resource_slist_t *xs = rl;
-    while (xs != NULL) {
-        _z_resource_t *r = _z_resource_slist_value(xs);
-        if (_z_keyexpr_equals(&r->_key, keyexpr)) {
-            ret = r;
-            break;
-        }
+static bool _z_resource_index_ptr_eq(const void *left, const void *right) {
+    return ((const _z_hashmap_entry_t *)left)->_key == ((const _z_hashmap_entry_t *)right)->_key;
+}
 
-        xs = _z_resource_slist_next(xs);
-    }
+static void _z_resource_index_entry_free(void **e) {
+    z_free(*e);
+    *e = NULL;
+}
 
-    return ret;
+void _z_resource_index_init(_z_resource_index_t *index) {
+    _z_hashmap_init(&index->_by_id, Z_RESOURCE_INDEX_CAPACITY, _z_resource_index_id_hash, _z_resource_index_id_eq);
+    _z_hashmap_init(&index->_by_key, Z_RESOURCE_INDEX_CAPACITY, _z_resource_index_key_hash, _z_resource_index_key_eq);
 }
 
-static _z_keyexpr_t __z_get_expanded_key_from_key(_z_resource_slist_t *xs, const _z_keyexpr_t *keyexpr,
-                                                  bool force_alias) {
-    _z_zint_t id = keyexpr->_id;
+void _z_resource_index_clear(_z_resource_index_t *index) {
+    _z_hashmap_clear(&index->_by_id, _z_resource_index_entry_free);
+    _z_hashmap_clear(&index->_by_key, _z_resource_index_entry_free);
+}
+
+static void _z_resource_index_add(_z_resource_index_t *index, _z_resource_t *res) {
+    // Push instead of replacing so that the latest resource declared for a key shadows the older ones
+    _z_hashmap_insert(&index->_by_id, res, res, _z_resource_index_entry_free, false);
+    _z_hashmap_insert(&index->_by_key, res, res, _z_resource_index_entry_free, false);
+}
 
+static void _z_resource_index_remove(_z_resource_index_t *index, _z_resource_t *res) {
+    _z_hashmap_remove_filter(&index->_by_id, res, _z_resource_index_ptr_eq, _z_resource_index_entry_free);
+    _z_hashmap_remove_filter(&index->_by_key, res, _z_resource_index_ptr_eq, _z_resource_index_entry_free);
+}
+
+/*------------------ Entity ------------------*/
+uint32_t _z_get_entity_id(_z_session_t *zn) { return zn->_entity_id++; }
+
+uint16_t _z_get_resource_id(_z_session_t *zn) { return zn->_resource_id++; }
+
+/*------------------ Resource ------------------*/
+static _z_resource_t *__z_get_resource_by_id(const _z_resource_index_t *index, uintptr_t mapping,
+                                             const _z_zint_t id) {
+    _z_resource_t probe;
+    probe._id = (uint16_t)id;
+    probe._key._mapping = mapping;
+    if ((_z_zint_t)probe._id != id) {
+        return NULL;
+    }
+    return (_z_resource_t *)_z_hashmap_get(&index->_by_id, &probe);
+}
+
+static _z_resource_t *__z_get_resource_by_key(const _z_resource_index_t *index, const _z_keyexpr_t *keyexpr) {
+    _z_resource_t probe;
+    probe._key = *keyexpr;  // Shallow copy, probe is never cleared
+    return (_z_resource_t *)_z_hashmap_get(&index->_by_key, &probe);
+}
+
+// A key expanded in an arena is transient, it aliases the arena or the input key when it is already expanded
+static _z_keyexpr_t __z_get_expanded_key_from_key(const _z_resource_index_t *index, const _z_keyexpr_t *keyexpr,
+                                                  bool force_alias, _z_arena_t *arena) {
     // Check if ke is already expanded
-    if (id == Z_RESOURCE_ID_NONE) {
+    if (keyexpr->_id == Z_RESOURCE_ID_NONE) {
         if (!_z_keyexpr_has_suffix(keyexpr)) {
             return _z_keyexpr_null();
         }
         // Keyexpr can be aliased from a rx buffer
-        if (force_alias) {
+        if (force_alias || (arena != NULL)) {
             return _z_keyexpr_alias(keyexpr);
         } else {
             return _z_keyexpr_duplicate(keyexpr);
         }
     }
-
-    // Need to build the complete resource name, by recursively look at RIDs
-    // Resource names are looked up from right to left
+    // Resources memoize their expanded key, so only the suffix needs to be appended
     _z_keyexpr_t ret = _z_keyexpr_null();
-    _z_string_list_t *strs = NULL;
-    size_t len = 0;
-
-    // Append suffix as the right-most segment
-    if (_z_keyexpr_has_suffix(keyexpr)) {
-        len = len + _z_string_len(&keyexpr->_suffix);
-        strs = _z_string_list_push(strs, (_z_string_t *)&keyexpr->_suffix);
+    _z_resource_t *res = __z_get_resource_by_id(index, keyexpr->_mapping, keyexpr->_id);
+    if (res == NULL) {
+        return ret;
     }
-    // Recursively go through all the RIDs
-    while (id != Z_RESOURCE_ID_NONE) {
-        _z_resource_t *res = __z_get_resource_by_id(xs, keyexpr->_mapping, id);
-        if (res == NULL) {
-            len = 0;
-            break;
-        }
-        if (_z_keyexpr_has_suffix(&res->_key)) {
-            len = len + _z_string_len(&res->_key._suffix);
-            strs = _z_string_list_push(strs, &res->_key._suffix);
-        }
-        id = res->_key._id;
+    size_t prefix_len = _z_string_len(&res->_expanded);
+    size_t suffix_len = _z_keyexpr_has_suffix(keyexpr) ? _z_string_len(&keyexpr->_suffix) : 0;
+    if ((prefix_len + suffix_len) == (size_t)0) {
+        return ret;
     }
-    // Copy the data
-    if (len != (size_t)0) {
-        ret._suffix = _z_string_preallocate(len);
-        if (_z_keyexpr_has_suffix(&ret)) {
-            char *curr_ptr = (char *)_z_string_data(&ret._suffix);
-
-            // Concatenate all the partial resource names
-            _z_string_list_t *xstr = strs;
-            while (xstr != NULL) {
-                _z_string_t *s = _z_string_list_value(xstr);
-                memcpy(curr_ptr, _z_string_data(s), _z_string_len(s));
-                curr_ptr = _z_ptr_char_offset(curr_ptr, (ptrdiff_t)_z_string_len(s));
-                xstr = _z_string_list_next(xstr);
-            }
+    char *curr_ptr = (arena != NULL) ? (char *)_z_arena_alloc(arena, prefix_len + suffix_len) : NULL;
+    if (curr_ptr != NULL) {
+        ret._suffix = _z_string_alias_substr(curr_ptr, prefix_len + suffix_len);
+    } else {
+        ret._suffix = _z_string_preallocate(prefix_len + suffix_len);
+        if (!_z_keyexpr_has_suffix(&ret)) {
+            return ret;
         }
+        curr_ptr = (char *)_z_string_data(&ret._suffix);
+    }
+    if (prefix_len != (size_t)0) {
+        memcpy(curr_ptr, _z_string_data(&res->_expanded), prefix_len);
+    }
+    if (suffix_len != (size_t)0) {
+        memcpy(_z_ptr_char_offset(curr_ptr, (ptrdiff_t)prefix_len), _z_string_data(&keyexpr->_suffix), suffix_len);
     }
-    // Warning: list must be released with _z_list_free(&strs, _z_noop_free) or will release the suffix as well
-    _z_list_free(&strs, _z_noop_free);
     return ret;
 }
 
+static _z_resource_index_t *__unsafe_z_get_resource_index(_z_session_t *zn, _z_transport_peer_common_t *peer) {
+    return (peer == NULL) ? &zn->_local_resources_index : &peer->_remote_resources_index;
+}
+
 /**
  * This function is unsafe because it operates in potentially concurrent data.
  * Make sure that the following mutexes are locked before calling this function:
  *  - zn->_mutex_inner
  */
 static _z_resource_t *__unsafe_z_get_resource_by_id(_z_session_t *zn, _z_zint_t id, _z_transport_peer_common_t *peer) {
-    _z_resource_slist_t *decls = zn->_local_resources;
-    uintptr_t mapping = _Z_KEYEXPR_MAPPING_LOCAL;
-    if (peer != NULL) {
-        decls = peer->_remote_resources;
-        mapping = (uintptr_t)peer;
-    }
-    return __z_get_resource_by_id(decls, mapping, id);
+    uintptr_t mapping = (peer == NULL) ? _Z_KEYEXPR_MAPPING_LOCAL : (uintptr_t)peer;
+    return __z_get_resource_by_id(__unsafe_z_get_resource_index(zn, peer), mapping, id);
 }
 
 /**
@@ -176,8 +212,15 @@ static _z_resource_t *__unsafe_z_get_resource_by_id(_z_session_t *zn, _z_zint_t
  */
 _z_resource_t *__unsafe_z_get_resource_by_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
                                               _z_transport_peer_common_t *peer) {
-    _z_resource_slist_t *decls = _z_keyexpr_is_local(keyexpr) ? zn->_local_resources : peer->_remote_resources;
-    return __z_get_resource_by_key(decls, keyexpr);
+    _z_resource_index_t *index =
+        _z_keyexpr_is_local(keyexpr) ? &zn->_local_resources_index : &peer->_remote_resources_index;
+    return __z_get_resource_by_key(index, keyexpr);
+}
+
+static _z_resource_index_t *__unsafe_z_get_key_resource_index(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
+                                                              _z_transport_peer_common_t *peer) {
+    return (_z_keyexpr_is_local(keyexpr) || (peer == NULL)) ? &zn->_local_resources_index
+                                                            : &peer->_remote_resources_index;
 }
 
 /**
@@ -187,9 +230,8 @@ _z_resource_t *__unsafe_z_get_resource_by_key(_z_session_t *zn, const _z_keyexpr
  */
 _z_keyexpr_t __unsafe_z_get_expanded_key_from_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr, bool force_alias,
                                                   _z_transport_peer_common_t *peer) {
-    _z_resource_slist_t *decls =
-        (_z_keyexpr_is_local(keyexpr) || (peer == NULL)) ? zn->_local_resources : peer->_remote_resources;
-    return __z_get_expanded_key_from_key(decls, keyexpr, force_alias);
+    return __z_get_expanded_key_from_key(__unsafe_z_get_key_resource_index(zn, keyexpr, peer), keyexpr, force_alias,
+                                         NULL);
 }
 
 _z_resource_t *_z_get_resource_by_id(_z_session_t *zn, _z_zint_t rid, _z_transport_peer_common_t *peer) {
@@ -214,8 +256,18 @@ _z_resource_t *_z_get_resource_by_key(_z_session_t *zn, const _z_keyexpr_t *keye
 
 _z_keyexpr_t _z_get_expanded_key_from_key(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
                                           _z_transport_peer_common_t *peer) {
+    return _z_get_expanded_key_in_arena(zn, keyexpr, peer, NULL);
+}
+
+_z_keyexpr_t _z_get_expanded_key_in_arena(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
+                                          _z_transport_peer_common_t *peer, _z_arena_t *arena) {
+    // Already expanded keys don't use the resources
+    if (keyexpr->_id == Z_RESOURCE_ID_NONE) {
+        return __z_get_expanded_key_from_key(NULL, keyexpr, false, arena);
+    }
     _z_session_mutex_lock(zn);
-    _z_keyexpr_t res = __unsafe_z_get_expanded_key_from_key(zn, keyexpr, false, peer);
+    _z_keyexpr_t res =
+        __z_get_expanded_key_from_key(__unsafe_z_get_key_resource_index(zn, keyexpr, peer), keyexpr, false, arena);
 
     _z_session_mutex_unlock(zn);
 
@@ -229,16 +281,24 @@ uint16_t _z_register_resource(_z_session_t *zn, const _z_keyexpr_t *key, uint16_
     uintptr_t mapping = (peer == NULL) ? _Z_KEYEXPR_MAPPING_LOCAL : (uintptr_t)peer;
     uintptr_t parent_mapping = key->_mapping;
     _z_keyexpr_t full_ke = _z_keyexpr_alias(key);
+    bool full_ke_owned = false;
+    _z_resource_t *parent = NULL;
     _Z_DEBUG("registering: key: %.*s id: %d, mapping: %d", (int)_z_string_len(&key->_suffix),
              _z_string_data(&key->_suffix), id, (unsigned int)mapping);
 
     _z_session_mutex_lock(zn);
     if (key->_id != Z_RESOURCE_ID_NONE) {
         if (parent_mapping == mapping) {
-            _z_resource_t *parent = __unsafe_z_get_resource_by_id(zn, key->_id, peer);
+            parent = __unsafe_z_get_resource_by_id(zn, key->_id, peer);
+            if (parent == NULL) {
+                _z_session_mutex_unlock(zn);
+                _Z_ERROR("Unknown parent resource id: %d", (int)key->_id);
+                return Z_RESOURCE_ID_NONE;
+            }
             parent->_refcount++;
         } else {
             full_ke = __unsafe_z_get_expanded_key_from_key(zn, key, false, peer);
+            full_ke_owned = true;
         }
     }
     ret = full_ke._id;
@@ -253,9 +313,32 @@ uint16_t _z_register_resource(_z_session_t *zn, const _z_keyexpr_t *key, uint16_
             res = _z_resource_slist_value(zn->_local_resources);
         }
         res->_refcount = 1;
-        _z_keyexpr_copy(&res->_key, &full_ke);
+        if (full_ke_owned) {
+            res->_key = full_ke;
+            full_ke_owned = false;
+        } else {
+            _z_keyexpr_copy(&res->_key, &full_ke);
+        }
+        // Memoize the expanded key, aliasing the suffix when there is no prefix to prepend
+        if (parent == NULL) {
+            res->_expanded = _z_string_alias(res->_key._suffix);
+        } else {
+            size_t prefix_len = _z_string_len(&parent->_expanded);
+            size_t suffix_len = _z_string_len(&res->_key._suffix);
+            res->_expanded = _z_string_preallocate(prefix_len + suffix_len);
+            if (_z_string_check(&res->_expanded)) {
+                char *curr_ptr = (char *)_z_string_data(&res->_expanded);
+                memcpy(curr_ptr, _z_string_data(&parent->_expanded), prefix_len);
+                memcpy(_z_ptr_char_offset(curr_ptr, (ptrdiff_t)prefix_len), _z_string_data(&res->_key._suffix),
+                       suffix_len);
+            }
+        }
         ret = (id == Z_RESOURCE_ID_NONE) ? _z_get_resource_id(zn) : id;
         res->_id = ret;
+        _z_resource_index_add(__unsafe_z_get_resource_index(zn, peer), res);
+    }
+    if (full_ke_owned) {
+        _z_keyexpr_clear(&full_ke);
     }
     _z_session_mutex_unlock(zn);
 
@@ -272,28 +355,28 @@ void _z_unregister_resource(_z_session_t *zn, uint16_t id, _z_transport_peer_com
     _Z_DEBUG("unregistering: id %d, mapping: %d", id, (unsigned int)mapping);
     _z_session_mutex_lock(zn);
     _z_resource_slist_t **resources = is_local ? &zn->_local_resources : &peer->_remote_resources;
+    _z_resource_index_t *index = __unsafe_z_get_resource_index(zn, peer);
     while (id != 0) {
+        _z_resource_t *value = __z_get_resource_by_id(index, mapping, id);
+        if (value == NULL) {
+            break;
+        }
+        value->_refcount--;
+        if (value->_refcount != 0) {
+            break;
+        }
+        id = value->_key._id;
+        mapping = value->_key._mapping;
+        _z_resource_index_remove(index, value);
+        // Find the node holding the resource to drop it
         _z_resource_slist_t *prev = NULL;
         _z_resource_slist_t *head = *resources;
-        while (head != NULL) {
-            _z_resource_t *value = _z_resource_slist_value(head);
-
-            if ((value != NULL) && (value->_id == id) && (value->_key._mapping == mapping)) {
-                value->_refcount--;
-                if (value->_refcount == 0) {
-                    id = value->_key._id;
-                    mapping = value->_key._mapping;
-                    *resources = _z_resource_slist_drop_element(*resources, prev);
-                } else {
-                    id = 0;
-                }
-                break;
-            }
+        while ((head != NULL) && (_z_resource_slist_value(head) != value)) {
             prev = head;
             head = _z_resource_slist_next(head);
         }
-        if (head == NULL) {
-            id = 0;
+        if (head != NULL) {
+            *resources = _z_resource_slist_drop_element(*resources, prev);
         }
     }
     _z_session_mutex_unlock(zn);
@@ -301,6 +384,7 @@ void _z_unregister_resource(_z_session_t *zn, uint16_t id, _z_transport_peer_com
 
 void _z_flush_local_resources(_z_session_t *zn) {
     _z_session_mutex_lock(zn);
+    _z_resource_index_clear(&zn->_local_resources_index);
     _z_resource_slist_free(&zn->_local_resources);
     _z_session_mutex_unlock(zn);
 }
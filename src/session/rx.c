@@ -121,7 +121,8 @@ static z_result_t _z_handle_request(_z_transport_common_t *transport, _z_n_msg_r
 #endif
             _z_network_message_t final;
             _z_n_msg_make_response_final(&final, req->_rid);
-            z_result_t ret = _z_send_n_msg(zn, &final, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL);
+            z_result_t ret =
+                _z_send_n_msg_on(zn, transport, &final, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK);
 #if Z_FEATURE_SUBSCRIPTION == 0
             _z_n_msg_request_clear(req);
 #endif
@@ -137,7 +138,8 @@ static z_result_t _z_handle_request(_z_transport_common_t *transport, _z_n_msg_r
 #endif
             _z_network_message_t final;
             _z_n_msg_make_response_final(&final, req->_rid);
-            z_result_t ret = _z_send_n_msg(zn, &final, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL);
+            z_result_t ret =
+                _z_send_n_msg_on(zn, transport, &final, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK);
 #if Z_FEATURE_SUBSCRIPTION == 0
             _z_n_msg_request_clear(req);
 #endif
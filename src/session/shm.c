@@ -0,0 +1,575 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/session/shm.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/protocol/codec/core.h"
+#include "zenoh-pico/protocol/definitions/transport.h"
+#include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/utils/logging.h"
+
+#if Z_FEATURE_SHM == 1
+
+#if !defined(_Z_SYS_SHM)
+#error "Z_FEATURE_SHM requires a platform providing shared memory segments"
+#endif
+
+// The chunk reference counts are shared with other processes, they are atomic even without multi-thread support
+#if ZENOH_C_STANDARD != 99
+
+#include <stdatomic.h>
+#define _Z_SHM_ATOMIC(X) _Atomic(X)
+#define _Z_SHM_LOAD(p) atomic_load(p)
+#define _Z_SHM_STORE(p, v) atomic_store(p, v)
+#define _Z_SHM_ADD(p, v) (void)atomic_fetch_add(p, v)
+#define _Z_SHM_SUB(p, v) (void)atomic_fetch_sub(p, v)
+#define _Z_SHM_CAS(p, e, d) _z_shm_cas(p, e, d)
+
+static inline bool _z_shm_cas(_Atomic(uint32_t) *p, uint32_t expected, uint32_t desired) {
+    return atomic_compare_exchange_strong(p, &expected, desired);
+}
+
+#elif defined(ZENOH_COMPILER_GCC)
+
+// c99 gcc sync builtin variant
+#define _Z_SHM_ATOMIC(X) X
+#define _Z_SHM_LOAD(p) __sync_fetch_and_add(p, 0)
+#define _Z_SHM_STORE(p, v)    \
+    do {                      \
+        __sync_synchronize(); \
+        *(p) = (v);           \
+        __sync_synchronize(); \
+    } while (0)
+#define _Z_SHM_ADD(p, v) (void)__sync_fetch_and_add(p, v)
+#define _Z_SHM_SUB(p, v) (void)__sync_fetch_and_sub(p, v)
+#define _Z_SHM_CAS(p, e, d) __sync_bool_compare_and_swap(p, e, d)
+
+#else
+#error "Shared memory in C99 only exists for GCC, use GCC or C11 or deactivate shared memory"
+#endif
+
+// Headers and chunks are aligned on cache lines, so that the reference counts of two chunks never share one
+#define _Z_SHM_ALIGN 64
+#define _Z_SHM_ALIGN_UP(x) (((x) + (_Z_SHM_ALIGN - 1)) & ~((size_t)_Z_SHM_ALIGN - 1))
+#define _Z_SHM_MAGIC 0x7a707368  // "zpsh"
+#define _Z_SHM_INFO_SIZE (6 * 10)
+
+typedef struct {
+    uint32_t _magic;
+    uint32_t _version;
+    uint64_t _size;
+    uint32_t _slot_nb;
+    uint32_t _reserved;
+} _z_shm_segment_header_t;
+
+typedef struct {
+    // Handles on the chunk data across all the processes, the chunk is free when it drops to 0
+    _Z_SHM_ATOMIC(uint32_t) _refcount;
+    uint32_t _reserved;
+    // Size of the chunk including its header, only written by the owner of the segment
+    uint64_t _size;
+} _z_shm_chunk_header_t;
+
+#define _Z_SHM_SEGMENT_HEADER_SIZE _Z_SHM_ALIGN_UP(sizeof(_z_shm_segment_header_t))
+#define _Z_SHM_CHUNK_HEADER_SIZE _Z_SHM_ALIGN_UP(sizeof(_z_shm_chunk_header_t))
+#define _Z_SHM_SLOTS_SIZE(nb) _Z_SHM_ALIGN_UP((size_t)(nb) * sizeof(uint32_t))
+
+static inline _z_shm_chunk_header_t *_z_shm_chunk_header(const _z_shm_segment_t *seg, size_t offset) {
+    return (_z_shm_chunk_header_t *)(void *)&seg->_base[offset];
+}
+
+// Slots follow the segment header, a slot holding a handle has its lowest bit set
+static inline _Z_SHM_ATOMIC(uint32_t) * _z_shm_slot(const _z_shm_segment_t *seg, uint32_t slot) {
+    return (_Z_SHM_ATOMIC(uint32_t) *)(void *)&seg->_base[_Z_SHM_SEGMENT_HEADER_SIZE + (size_t)slot * sizeof(uint32_t)];
+}
+
+static inline uint8_t *_z_shm_chunk_data(const _z_shm_segment_t *seg, size_t offset) {
+    return &seg->_base[offset + _Z_SHM_CHUNK_HEADER_SIZE];
+}
+
+static void _z_shm_segment_name(char *name, uint64_t id) {
+    (void)snprintf(name, _Z_SHM_SEGMENT_NAME_SIZE, "/zp_shm_%016" PRIx64, id);
+}
+
+void _z_shm_segment_clear(_z_shm_segment_t *seg) {
+    if (seg->_base != NULL) {
+        _z_shm_segment_unmap(seg->_base, seg->_size);
+        seg->_base = NULL;
+    }
+    if (seg->_is_owner) {
+        _z_shm_segment_unlink(seg->_name);
+#if Z_FEATURE_MULTI_THREAD == 1
+        _z_mutex_drop(&seg->_mutex);
+#endif
+        seg->_is_owner = false;
+    }
+}
+
+/*------------------ Provider ------------------*/
+z_result_t _z_shm_provider_init(_z_shm_provider_t *provider, size_t size) {
+    *provider = _z_shm_provider_null();
+    size = _Z_SHM_ALIGN_UP(size);
+    if (size == 0) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    _z_shm_segment_t seg = {0};
+    seg._slot_nb = Z_SHM_HANDLE_SLOTS;
+    seg._start = _Z_SHM_SEGMENT_HEADER_SIZE + _Z_SHM_SLOTS_SIZE(seg._slot_nb);
+    seg._size = seg._start + _Z_SHM_CHUNK_HEADER_SIZE + size;
+    z_random_fill(&seg._id, sizeof(seg._id));
+    _z_shm_segment_name(seg._name, seg._id);
+    _Z_RETURN_IF_ERR(_z_shm_segment_create(seg._name, seg._size, &seg._base));
+    seg._is_owner = true;
+#if Z_FEATURE_MULTI_THREAD == 1
+    z_result_t ret = _z_mutex_init(&seg._mutex);
+    if (ret != _Z_RES_OK) {
+        _z_shm_segment_unmap(seg._base, seg._size);
+        _z_shm_segment_unlink(seg._name);
+        return ret;
+    }
+#endif
+    _z_shm_segment_header_t *header = (_z_shm_segment_header_t *)(void *)seg._base;
+    header->_version = _Z_SHM_VERSION;
+    header->_size = seg._size;
+    header->_slot_nb = seg._slot_nb;
+    header->_magic = _Z_SHM_MAGIC;
+    for (uint32_t i = 0; i < seg._slot_nb; i++) {
+        _Z_SHM_STORE(_z_shm_slot(&seg, i), 0);
+    }
+    // A single free chunk covers the segment
+    seg._cursor = seg._start;
+    _z_shm_chunk_header_t *chunk = _z_shm_chunk_header(&seg, seg._cursor);
+    chunk->_size = seg._size - seg._start;
+    _Z_SHM_STORE(&chunk->_refcount, 0);
+
+    provider->_segment = _z_shm_segment_rc_new_from_val(&seg);
+    if (provider->_segment._cnt == NULL) {
+        _z_shm_segment_clear(&seg);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
+
+void _z_shm_provider_clear(_z_shm_provider_t *provider) { _z_shm_segment_rc_drop(&provider->_segment); }
+
+z_result_t _z_shm_provider_move(_z_shm_provider_t *dst, _z_shm_provider_t *src) {
+    *dst = *src;
+    *src = _z_shm_provider_null();
+    return _Z_RES_OK;
+}
+
+// Merges the free chunks following the free chunk at offset into it
+static void _z_shm_segment_coalesce(_z_shm_segment_t *seg, size_t offset) {
+    _z_shm_chunk_header_t *chunk = _z_shm_chunk_header(seg, offset);
+    size_t next = offset + (size_t)chunk->_size;
+    while (next < seg->_size) {
+        _z_shm_chunk_header_t *free_chunk = _z_shm_chunk_header(seg, next);
+        if ((_Z_SHM_LOAD(&free_chunk->_refcount) != 0) || (free_chunk->_size < _Z_SHM_CHUNK_HEADER_SIZE) ||
+            (free_chunk->_size > seg->_size - next)) {
+            break;
+        }
+        chunk->_size += free_chunk->_size;
+        next = offset + (size_t)chunk->_size;
+    }
+    // The cursor must stay on a chunk boundary
+    if ((seg->_cursor > offset) && (seg->_cursor < next)) {
+        seg->_cursor = offset;
+    }
+}
+
+// Next fit: looks for a free chunk of at least size bytes from the cursor, returns its offset or 0 if there is none
+static size_t _z_shm_segment_alloc_chunk(_z_shm_segment_t *seg, size_t size) {
+    size_t start = seg->_cursor;
+    size_t offset = start;
+    bool wrapped = false;
+    while (!wrapped || (offset < start)) {
+        _z_shm_chunk_header_t *chunk = _z_shm_chunk_header(seg, offset);
+        // Other processes map the segment writable, do not trust it
+        if ((chunk->_size < _Z_SHM_CHUNK_HEADER_SIZE) || (chunk->_size > seg->_size - offset)) {
+            _Z_ERROR("Corrupted shared memory segment %s", seg->_name);
+            return 0;
+        }
+        if (_Z_SHM_LOAD(&chunk->_refcount) == 0) {
+            _z_shm_segment_coalesce(seg, offset);
+            if (chunk->_size >= size) {
+                // Split the chunk if the remainder can hold some data
+                if (chunk->_size - size > _Z_SHM_CHUNK_HEADER_SIZE) {
+                    _z_shm_chunk_header_t *rest = _z_shm_chunk_header(seg, offset + size);
+                    rest->_size = chunk->_size - size;
+                    _Z_SHM_STORE(&rest->_refcount, 0);
+                    chunk->_size = size;
+                }
+                _Z_SHM_STORE(&chunk->_refcount, 1);
+                seg->_cursor = offset + (size_t)chunk->_size;
+                if (seg->_cursor >= seg->_size) {
+                    seg->_cursor = seg->_start;
+                }
+                return offset;
+            }
+        }
+        offset += (size_t)chunk->_size;
+        if (offset >= seg->_size) {
+            offset = seg->_start;
+            wrapped = true;
+        }
+    }
+    return 0;
+}
+
+/*------------------ Handles ------------------*/
+void _z_shm_chunk_ref_clear(_z_shm_chunk_ref_t *ref) { _z_shm_segment_rc_drop(&ref->_segment); }
+
+void _z_shm_chunk_ref_copy(_z_shm_chunk_ref_t *dst, const _z_shm_chunk_ref_t *src) {
+    *dst = *src;
+    dst->_segment = _z_shm_segment_rc_clone(&src->_segment);
+}
+
+z_result_t _z_shm_chunk_ref_take(const _z_shm_chunk_ref_t *ref, _z_shm_chunk_ref_t *handle) {
+    _z_shm_segment_t *seg = ref->_segment._val;
+    uint32_t slot = _Z_SHM_NO_SLOT;
+    uint32_t word = 0;
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_lock(&seg->_mutex);
+#endif
+    // Only the owner fills slots, the peers only empty those holding the handle they got
+    for (uint32_t i = 0; i < seg->_slot_nb; i++) {
+        uint32_t curr = (seg->_slot_cursor + i) % seg->_slot_nb;
+        uint32_t value = _Z_SHM_LOAD(_z_shm_slot(seg, curr));
+        if ((value & 1u) == 0) {
+            slot = curr;
+            word = (value + 2u) | 1u;
+            _Z_SHM_STORE(_z_shm_slot(seg, slot), word);
+            seg->_slot_cursor = (curr + 1) % seg->_slot_nb;
+            break;
+        }
+    }
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&seg->_mutex);
+#endif
+    if (slot == _Z_SHM_NO_SLOT) {
+        return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    }
+    _Z_SHM_ADD(&_z_shm_chunk_header(seg, ref->_offset)->_refcount, 1);
+    handle->_segment = _z_shm_segment_rc_clone(&ref->_segment);
+    handle->_offset = ref->_offset;
+    handle->_slot = slot;
+    handle->_word = word;
+    return _Z_RES_OK;
+}
+
+void _z_shm_chunk_ref_release(const _z_shm_chunk_ref_t *ref) {
+    const _z_shm_segment_t *seg = ref->_segment._val;
+    // Emptying the slot is the right to release the chunk, whoever of the peer or the sender gets it first
+    if ((ref->_slot != _Z_SHM_NO_SLOT) && !_Z_SHM_CAS(_z_shm_slot(seg, ref->_slot), ref->_word, ref->_word & ~1u)) {
+        return;
+    }
+    _Z_SHM_SUB(&_z_shm_chunk_header(seg, ref->_offset)->_refcount, 1);
+}
+
+bool _z_shm_chunk_ref_is_held(const _z_shm_chunk_ref_t *ref) {
+    return (ref->_slot == _Z_SHM_NO_SLOT) || (_Z_SHM_LOAD(_z_shm_slot(ref->_segment._val, ref->_slot)) == ref->_word);
+}
+
+void _z_shm_chunk_refs_release(_z_shm_chunk_ref_svec_t *refs) {
+    for (size_t i = 0; i < _z_shm_chunk_ref_svec_len(refs); i++) {
+        _z_shm_chunk_ref_release(_z_shm_chunk_ref_svec_get(refs, i));
+    }
+    _z_shm_chunk_ref_svec_reset(refs);
+}
+
+// Deleter of the payloads pointing into a chunk
+static void _z_shm_chunk_ref_delete(void *data, void *context) {
+    _ZP_UNUSED(data);
+    _z_shm_chunk_ref_t *ref = (_z_shm_chunk_ref_t *)context;
+    _z_shm_chunk_ref_release(ref);
+    _z_shm_chunk_ref_clear(ref);
+    z_free(ref);
+}
+
+// Wraps len bytes of the chunk data from start in a payload holding a handle on the chunk
+static z_result_t _z_shm_chunk_to_bytes(const _z_shm_segment_rc_t *segment, size_t offset, uint32_t slot,
+                                        uint32_t word, size_t start, size_t len, _z_bytes_t *bytes) {
+    _z_shm_chunk_ref_t *ref = (_z_shm_chunk_ref_t *)z_malloc(sizeof(_z_shm_chunk_ref_t));
+    if (ref == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    ref->_segment = _z_shm_segment_rc_clone(segment);
+    ref->_offset = offset;
+    ref->_slot = slot;
+    ref->_word = word;
+    _z_slice_t s = _z_slice_from_buf_custom_deleter(&_z_shm_chunk_data(segment->_val, offset)[start], len,
+                                                    _z_delete_context_create(_z_shm_chunk_ref_delete, ref));
+    z_result_t ret = _z_bytes_from_slice(bytes, &s);
+    if (ret != _Z_RES_OK) {
+        _z_shm_chunk_ref_clear(ref);
+        z_free(ref);
+    }
+    return ret;
+}
+
+/*------------------ Ledger ------------------*/
+_z_shm_ledger_t *_z_shm_ledger_new(void) {
+    _z_shm_ledger_t *ledger = (_z_shm_ledger_t *)z_malloc(sizeof(_z_shm_ledger_t));
+    if (ledger == NULL) {
+        return NULL;
+    }
+#if Z_FEATURE_MULTI_THREAD == 1
+    if (_z_mutex_init(&ledger->_mutex) != _Z_RES_OK) {
+        z_free(ledger);
+        return NULL;
+    }
+#endif
+    ledger->_refs = _z_shm_chunk_ref_svec_null();
+    return ledger;
+}
+
+void _z_shm_ledger_free(_z_shm_ledger_t **ledger) {
+    _z_shm_ledger_t *ptr = *ledger;
+    if (ptr == NULL) {
+        return;
+    }
+    _z_shm_chunk_refs_release(&ptr->_refs);
+    _z_shm_chunk_ref_svec_clear(&ptr->_refs);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&ptr->_mutex);
+#endif
+    z_free(ptr);
+    *ledger = NULL;
+}
+
+// Forgets the handles the peer gave back
+static void _z_shm_ledger_prune(_z_shm_ledger_t *ledger) {
+    size_t len = 0;
+    for (size_t i = 0; i < _z_shm_chunk_ref_svec_len(&ledger->_refs); i++) {
+        _z_shm_chunk_ref_t *ref = _z_shm_chunk_ref_svec_get_mut(&ledger->_refs, i);
+        if (!_z_shm_chunk_ref_is_held(ref)) {
+            _z_shm_chunk_ref_clear(ref);
+        } else {
+            *_z_shm_chunk_ref_svec_get_mut(&ledger->_refs, len) = *ref;
+            len++;
+        }
+    }
+    ledger->_refs._len = len;
+}
+
+z_result_t _z_shm_ledger_add(_z_shm_ledger_t *ledger, const _z_shm_chunk_ref_t *handle) {
+    _z_shm_chunk_ref_t ref;
+    _z_shm_chunk_ref_copy(&ref, handle);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_lock(&ledger->_mutex);
+#endif
+    // Make room before growing, the ledger only keeps the handles still held
+    if (_z_shm_chunk_ref_svec_len(&ledger->_refs) == ledger->_refs._capacity) {
+        _z_shm_ledger_prune(ledger);
+    }
+    z_result_t ret = _z_shm_chunk_ref_svec_append(&ledger->_refs, &ref, false);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&ledger->_mutex);
+#endif
+    if (ret != _Z_RES_OK) {
+        _z_shm_chunk_ref_clear(&ref);
+    }
+    return ret;
+}
+
+z_result_t _z_shm_provider_alloc(const _z_shm_provider_t *provider, size_t len, _z_bytes_t *bytes, uint8_t **buf) {
+    *bytes = _z_bytes_null();
+    if (!_z_shm_provider_check(provider) || (len == 0)) {
+        _Z_ERROR_RETURN(_Z_ERR_INVALID);
+    }
+    _z_shm_segment_t *seg = provider->_segment._val;
+    size_t size = _Z_SHM_ALIGN_UP(_Z_SHM_CHUNK_HEADER_SIZE + len);
+    if (size > seg->_size) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_lock(&seg->_mutex);
+#endif
+    size_t offset = _z_shm_segment_alloc_chunk(seg, size);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_unlock(&seg->_mutex);
+#endif
+    if (offset == 0) {
+        _Z_INFO("No free chunk of %zu bytes in shared memory segment %s", len, seg->_name);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    z_result_t ret = _z_shm_chunk_to_bytes(&provider->_segment, offset, _Z_SHM_NO_SLOT, 0, 0, len, bytes);
+    if (ret != _Z_RES_OK) {
+        _Z_SHM_STORE(&_z_shm_chunk_header(seg, offset)->_refcount, 0);
+        return ret;
+    }
+    *buf = _z_shm_chunk_data(seg, offset);
+    return _Z_RES_OK;
+}
+
+/*------------------ Transmission ------------------*/
+const _z_shm_chunk_ref_t *_z_shm_bytes_chunk(const _z_bytes_t *bytes) {
+    if ((_z_bytes_num_slices(bytes) != 1) || (_z_bytes_len(bytes) < Z_SHM_THRESHOLD)) {
+        return NULL;
+    }
+    const _z_slice_t *s = _z_slice_simple_rc_value(&_z_bytes_get_slice(bytes, 0)->slice);
+    if (s->_delete_context.deleter != _z_shm_chunk_ref_delete) {
+        return NULL;
+    }
+    // Handles are given in the slots of the segment owner, a received payload is forwarded by copy
+    const _z_shm_chunk_ref_t *ref = (const _z_shm_chunk_ref_t *)s->_delete_context.context;
+    return ref->_segment._val->_is_owner ? ref : NULL;
+}
+
+// A location sent to a peer and the handle given with it
+typedef struct {
+    _z_shm_chunk_ref_t _handle;
+    uint8_t _buf[_Z_SHM_INFO_SIZE];
+} _z_shm_info_t;
+
+static void _z_shm_info_delete(void *data, void *context) {
+    _ZP_UNUSED(data);
+    _z_shm_info_t *info = (_z_shm_info_t *)context;
+    _z_shm_chunk_ref_clear(&info->_handle);
+    z_free(info);
+}
+
+z_result_t _z_shm_bytes_to_info(const _z_bytes_t *bytes, const _z_shm_chunk_ref_t *handle, _z_bytes_t *info) {
+    const _z_shm_segment_t *seg = handle->_segment._val;
+    const _z_arc_slice_t *arc = _z_bytes_get_slice(bytes, 0);
+    size_t start = (size_t)(_z_arc_slice_data(arc) - _z_shm_chunk_data(seg, handle->_offset));
+    _z_shm_info_t *loc = (_z_shm_info_t *)z_malloc(sizeof(_z_shm_info_t));
+    if (loc == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    size_t len = 0;
+    len += _z_zint64_encode_buf(&loc->_buf[len], seg->_id);
+    len += _z_zsize_encode_buf(&loc->_buf[len], handle->_offset);
+    len += _z_zsize_encode_buf(&loc->_buf[len], start);
+    len += _z_zsize_encode_buf(&loc->_buf[len], _z_arc_slice_len(arc));
+    len += _z_zint64_encode_buf(&loc->_buf[len], handle->_slot);
+    len += _z_zint64_encode_buf(&loc->_buf[len], handle->_word);
+    _z_shm_chunk_ref_copy(&loc->_handle, handle);
+    _z_slice_t s =
+        _z_slice_from_buf_custom_deleter(loc->_buf, len, _z_delete_context_create(_z_shm_info_delete, loc));
+    z_result_t ret = _z_bytes_from_slice(info, &s);
+    if (ret != _Z_RES_OK) {
+        _z_shm_chunk_ref_clear(&loc->_handle);
+        z_free(loc);
+    }
+    return ret;
+}
+
+const _z_shm_chunk_ref_t *_z_shm_info_handle(const _z_bytes_t *info) {
+    if (_z_bytes_num_slices(info) != 1) {
+        return NULL;
+    }
+    const _z_slice_t *s = _z_slice_simple_rc_value(&_z_bytes_get_slice(info, 0)->slice);
+    if (s->_delete_context.deleter != _z_shm_info_delete) {
+        return NULL;
+    }
+    return &((const _z_shm_info_t *)s->_delete_context.context)->_handle;
+}
+
+/*------------------ Reception ------------------*/
+void _z_shm_segment_cache_init(_z_shm_segment_cache_t *cache) {
+    for (size_t i = 0; i < Z_SHM_SEGMENT_CACHE_SIZE; i++) {
+        cache->_segments[i] = _z_shm_segment_rc_null();
+    }
+    cache->_next = 0;
+}
+
+void _z_shm_segment_cache_clear(_z_shm_segment_cache_t *cache) {
+    for (size_t i = 0; i < Z_SHM_SEGMENT_CACHE_SIZE; i++) {
+        _z_shm_segment_rc_drop(&cache->_segments[i]);
+    }
+    cache->_next = 0;
+}
+
+// Maps a segment of another process, the cached segment it replaces stays mapped as long as payloads point into it
+static const _z_shm_segment_rc_t *_z_shm_segment_cache_get(_z_shm_segment_cache_t *cache, uint64_t id) {
+    for (size_t i = 0; i < Z_SHM_SEGMENT_CACHE_SIZE; i++) {
+        if ((cache->_segments[i]._cnt != NULL) && (cache->_segments[i]._val->_id == id)) {
+            return &cache->_segments[i];
+        }
+    }
+    _z_shm_segment_t seg = {0};
+    seg._id = id;
+    _z_shm_segment_name(seg._name, id);
+    if (_z_shm_segment_open(seg._name, &seg._base, &seg._size) != _Z_RES_OK) {
+        return NULL;
+    }
+    const _z_shm_segment_header_t *header = (const _z_shm_segment_header_t *)(void *)seg._base;
+    if ((seg._size < _Z_SHM_SEGMENT_HEADER_SIZE) || (header->_magic != _Z_SHM_MAGIC) ||
+        (header->_version != _Z_SHM_VERSION) || (header->_size != seg._size) ||
+        (_Z_SHM_SLOTS_SIZE(header->_slot_nb) > seg._size - _Z_SHM_SEGMENT_HEADER_SIZE)) {
+        _Z_ERROR("Invalid shared memory segment %s", seg._name);
+        _z_shm_segment_clear(&seg);
+        return NULL;
+    }
+    seg._slot_nb = header->_slot_nb;
+    seg._start = _Z_SHM_SEGMENT_HEADER_SIZE + _Z_SHM_SLOTS_SIZE(seg._slot_nb);
+    _z_shm_segment_rc_t rc = _z_shm_segment_rc_new_from_val(&seg);
+    if (rc._cnt == NULL) {
+        _z_shm_segment_clear(&seg);
+        return NULL;
+    }
+    _z_shm_segment_rc_t *slot = &cache->_segments[cache->_next];
+    _z_shm_segment_rc_drop(slot);
+    *slot = rc;
+    cache->_next = (cache->_next + 1) % Z_SHM_SEGMENT_CACHE_SIZE;
+    return slot;
+}
+
+z_result_t _z_shm_bytes_from_info(_z_shm_segment_cache_t *cache, _z_bytes_t *bytes) {
+    uint8_t buf[_Z_SHM_INFO_SIZE];
+    size_t len = _z_bytes_len(bytes);
+    if (len > sizeof(buf)) {
+        _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+    }
+    len = _z_bytes_to_buf(bytes, buf, len);
+    _z_zbuf_t zbf = _z_slice_as_zbuf(_z_slice_alias_buf(buf, len));
+    uint64_t id = 0;
+    uint64_t offset = 0;
+    uint64_t start = 0;
+    uint64_t data_len = 0;
+    uint32_t slot = 0;
+    uint32_t word = 0;
+    _Z_RETURN_IF_ERR(_z_zint64_decode(&id, &zbf));
+    _Z_RETURN_IF_ERR(_z_zint64_decode(&offset, &zbf));
+    _Z_RETURN_IF_ERR(_z_zint64_decode(&start, &zbf));
+    _Z_RETURN_IF_ERR(_z_zint64_decode(&data_len, &zbf));
+    _Z_RETURN_IF_ERR(_z_zint32_decode(&slot, &zbf));
+    _Z_RETURN_IF_ERR(_z_zint32_decode(&word, &zbf));
+
+    const _z_shm_segment_rc_t *segment = _z_shm_segment_cache_get(cache, id);
+    if (segment == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_GENERIC);
+    }
+    // The peer holds a handle on the chunk for us in a slot, its data must lie in the segment
+    size_t size = segment->_val->_size;
+    if ((slot >= segment->_val->_slot_nb) || ((word & 1u) == 0) || (offset < segment->_val->_start) ||
+        ((offset % _Z_SHM_ALIGN) != 0) || (data_len == 0) ||
+        (offset > size - _Z_SHM_CHUNK_HEADER_SIZE) || (start > size - _Z_SHM_CHUNK_HEADER_SIZE - offset) ||
+        (data_len > size - _Z_SHM_CHUNK_HEADER_SIZE - offset - start)) {
+        _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+    }
+    _z_bytes_t payload;
+    _Z_RETURN_IF_ERR(
+        _z_shm_chunk_to_bytes(segment, (size_t)offset, slot, word, (size_t)start, (size_t)data_len, &payload));
+    _z_bytes_drop(bytes);
+    *bytes = payload;
+    return _Z_RES_OK;
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/session.h"
 #include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/utils/hash.h"
 #include "zenoh-pico/utils/locality.h"
 #include "zenoh-pico/utils/logging.h"
 
@@ -46,18 +47,25 @@ void _z_subscription_cache_invalidate(_z_session_t *zn) {
 }
 
 #if Z_FEATURE_RX_CACHE == 1
-int _z_subscription_cache_data_compare(const void *first, const void *second) {
+size_t _z_subscription_cache_data_hash(const void *e) {
+    const _z_subscription_cache_data_t *data = (const _z_subscription_cache_data_t *)e;
+    return _z_hash_combine(_z_keyexpr_hash(&data->ke_in), (size_t)data->is_remote);
+}
+
+bool _z_subscription_cache_data_eq(const void *first, const void *second) {
     const _z_subscription_cache_data_t *first_data = (const _z_subscription_cache_data_t *)first;
     const _z_subscription_cache_data_t *second_data = (const _z_subscription_cache_data_t *)second;
-    if (first_data->is_remote != second_data->is_remote) {
-        return (int)first_data->is_remote - (int)second_data->is_remote;
-    }
-    return _z_keyexpr_compare(&first_data->ke_in, &second_data->ke_in);
+    return (first_data->is_remote == second_data->is_remote) &&
+           _z_keyexpr_equals(&first_data->ke_in, &second_data->ke_in);
 }
 #endif  // Z_FEATURE_RX_CACHE == 1
 
 void _z_subscription_cache_data_clear(_z_subscription_cache_data_t *val) {
+#if Z_FEATURE_RX_CACHE == 1
     _z_subscription_rc_svec_rc_drop(&val->infos);
+#else
+    _z_subscription_rc_svec_clear(&val->infos);
+#endif
     _z_keyexpr_clear(&val->ke_in);
     _z_keyexpr_clear(&val->ke_out);
 }
@@ -102,52 +110,67 @@ _z_subscription_rc_t *__unsafe_z_get_subscription_by_id(_z_session_t *zn, _z_sub
     return __z_get_subscription_by_id(subs, id);
 }
 
-/**
- * This function is unsafe because it operates in potentially concurrent data.
- * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
- */
-static z_result_t __unsafe_z_get_subscriptions_by_key(_z_session_t *zn, _z_subscriber_kind_t kind,
-                                                      const _z_keyexpr_t *key, bool is_remote,
-                                                      _z_subscription_rc_svec_t *sub_infos) {
-    _z_subscription_rc_slist_t *subs =
-        (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) ? zn->_subscriptions : zn->_liveliness_subscriptions;
+static inline _z_keyexpr_tree_rcu_t *_z_get_subscriptions_tree(_z_session_t *zn, _z_subscriber_kind_t kind) {
+    return (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) ? &zn->_subscriptions_tree : &zn->_liveliness_subscriptions_tree;
+}
 
-    *sub_infos = _z_subscription_rc_svec_make(_Z_SUBINFOS_VEC_SIZE);
-    _Z_RETURN_ERR_OOM_IF_TRUE(sub_infos->_val == NULL);
-    _z_subscription_rc_slist_t *xs = subs;
-    while (xs != NULL) {
-        // Parse subscription list
-        _z_subscription_rc_t *sub = _z_subscription_rc_slist_value(xs);
-        const _z_subscription_t *sub_val = _Z_RC_IN_VAL(sub);
-        bool origin_allowed = is_remote ? _z_locality_allows_remote(sub_val->_allowed_origin)
-                                        : _z_locality_allows_local(sub_val->_allowed_origin);
-        if (origin_allowed && _z_keyexpr_suffix_intersects(&sub_val->_key, key)) {
-            _z_subscription_rc_t sub_clone = _z_subscription_rc_clone(sub);
-            _Z_CLEAN_RETURN_IF_ERR(_z_subscription_rc_svec_append(sub_infos, &sub_clone, true),
-                                   _z_subscription_rc_svec_clear(sub_infos));
-        }
-        xs = _z_subscription_rc_slist_next(xs);
+typedef struct {
+    const _z_keyexpr_t *key;
+    bool is_remote;
+    _z_subscription_rc_svec_t *sub_infos;
+    z_result_t ret;
+} _z_subscription_match_ctx_t;
+
+static void _z_subscription_match_candidate(void *val, void *arg) {
+    _z_subscription_match_ctx_t *ctx = (_z_subscription_match_ctx_t *)arg;
+    _z_subscription_rc_t *sub = (_z_subscription_rc_t *)val;
+    const _z_subscription_t *sub_val = _Z_RC_IN_VAL(sub);
+    if (ctx->ret != _Z_RES_OK) {
+        return;
+    }
+    bool origin_allowed = ctx->is_remote ? _z_locality_allows_remote(sub_val->_allowed_origin)
+                                         : _z_locality_allows_local(sub_val->_allowed_origin);
+    // Tree yields candidates, the exact intersection check is still needed for wildcard chunks
+    if (origin_allowed && _z_keyexpr_suffix_intersects(&sub_val->_key, ctx->key)) {
+        _z_subscription_rc_t sub_clone = _z_subscription_rc_clone(sub);
+        // Rc handles are moved bitwise when the list grows, their element move is a noop
+        ctx->ret = _z_subscription_rc_svec_append(ctx->sub_infos, &sub_clone, false);
     }
-    return _Z_RES_OK;
 }
 
-/**
- * This function is unsafe because it operates in potentially concurrent data.
- * Make sure that the following mutexes are locked before calling this function:
- *  - zn->_mutex_inner
- */
-static z_result_t __unsafe_z_get_subscriptions_rc_by_key(_z_session_t *zn, _z_subscriber_kind_t kind,
-                                                         const _z_keyexpr_t *key, bool is_remote,
-                                                         _z_subscription_rc_svec_rc_t *sub_infos) {
+// Reads the published copy of the tree, doesn't need the session mutex. With an arena the list is transient, its
+// storage is only valid until the arena is reset.
+static z_result_t _z_get_subscriptions_by_key(_z_session_t *zn, _z_subscriber_kind_t kind, const _z_keyexpr_t *key,
+                                              bool is_remote, _z_subscription_rc_svec_t *sub_infos,
+                                              _z_arena_t *arena) {
+    void *buf = (arena != NULL) ? _z_arena_alloc(arena, _Z_SUBINFOS_VEC_SIZE * sizeof(_z_subscription_rc_t)) : NULL;
+    if (buf != NULL) {
+        *sub_infos = _z_svec_alias_buf(buf, _Z_SUBINFOS_VEC_SIZE);
+    } else {
+        *sub_infos = _z_subscription_rc_svec_make(_Z_SUBINFOS_VEC_SIZE);
+        _Z_RETURN_ERR_OOM_IF_TRUE(sub_infos->_val == NULL);
+    }
+    _z_subscription_match_ctx_t ctx = {.key = key, .is_remote = is_remote, .sub_infos = sub_infos, .ret = _Z_RES_OK};
+    _z_keyexpr_tree_rcu_intersect(_z_get_subscriptions_tree(zn, kind), &key->_suffix, _z_subscription_match_candidate,
+                                  &ctx);
+    if (ctx.ret != _Z_RES_OK) {
+        _z_subscription_rc_svec_clear(sub_infos);
+    }
+    return ctx.ret;
+}
+
+#if Z_FEATURE_RX_CACHE == 1
+static z_result_t _z_get_subscriptions_rc_by_key(_z_session_t *zn, _z_subscriber_kind_t kind, const _z_keyexpr_t *key,
+                                                 bool is_remote, _z_subscription_rc_svec_rc_t *sub_infos) {
     *sub_infos = _z_subscription_rc_svec_rc_new_undefined();
     z_result_t ret = !_Z_RC_IS_NULL(sub_infos) ? _Z_RES_OK : _Z_ERR_SYSTEM_OUT_OF_MEMORY;
-    _Z_SET_IF_OK(ret, __unsafe_z_get_subscriptions_by_key(zn, kind, key, is_remote, _Z_RC_IN_VAL(sub_infos)));
+    _Z_SET_IF_OK(ret, _z_get_subscriptions_by_key(zn, kind, key, is_remote, _Z_RC_IN_VAL(sub_infos), NULL));
     if (ret != _Z_RES_OK) {
         _z_subscription_rc_svec_rc_drop(sub_infos);
     }
     return _Z_RES_OK;
 }
+#endif
 
 _z_subscription_rc_t *_z_get_subscription_by_id(_z_session_t *zn, _z_subscriber_kind_t kind, const _z_zint_t id) {
     _z_session_mutex_lock(zn);
@@ -173,7 +196,30 @@ _z_subscription_rc_t *_z_register_subscription(_z_session_t *zn, _z_subscriber_k
         ret = _z_subscription_rc_slist_value(zn->_liveliness_subscriptions);
     }
     *ret = _z_subscription_rc_new_from_val(s);
+    if (_Z_RC_IS_NULL(ret)) {
+        if (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
+            zn->_subscriptions = _z_subscription_rc_slist_pop(zn->_subscriptions);
+        } else {
+            zn->_liveliness_subscriptions = _z_subscription_rc_slist_pop(zn->_liveliness_subscriptions);
+        }
+        ret = NULL;
+    }
     _z_session_mutex_unlock(zn);
+    // The tree points to the stored subscription, which stays in place until it is unregistered
+    if ((ret != NULL) &&
+        (_z_keyexpr_tree_rcu_insert(_z_get_subscriptions_tree(zn, kind), &_Z_RC_IN_VAL(ret)->_key._suffix, ret) !=
+         _Z_RES_OK)) {
+        _z_session_mutex_lock(zn);
+        if (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
+            zn->_subscriptions =
+                _z_subscription_rc_slist_drop_first_filter(zn->_subscriptions, _z_subscription_rc_eq, ret);
+        } else {
+            zn->_liveliness_subscriptions =
+                _z_subscription_rc_slist_drop_first_filter(zn->_liveliness_subscriptions, _z_subscription_rc_eq, ret);
+        }
+        _z_session_mutex_unlock(zn);
+        ret = NULL;
+    }
 
 #if Z_FEATURE_LOCAL_SUBSCRIBER == 1
     if (ret != NULL && kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
@@ -197,7 +243,7 @@ z_result_t _z_trigger_liveliness_subscriptions_declare(_z_session_t *zn, const _
     _z_source_info_t source_info = _z_source_info_null();
     return _z_trigger_subscriptions_impl(zn, _Z_SUBSCRIBER_KIND_LIVELINESS_SUBSCRIBER, &key, &payload, &encoding,
                                          Z_SAMPLE_KIND_PUT, timestamp, _Z_N_QOS_DEFAULT, &attachment,
-                                         Z_RELIABILITY_RELIABLE, &source_info, peer);
+                                         Z_RELIABILITY_RELIABLE, &source_info, peer, NULL);
 }
 
 z_result_t _z_trigger_liveliness_subscriptions_undeclare(_z_session_t *zn, const _z_keyexpr_t *keyexpr,
@@ -210,21 +256,23 @@ z_result_t _z_trigger_liveliness_subscriptions_undeclare(_z_session_t *zn, const
     _z_source_info_t source_info = _z_source_info_null();
     return _z_trigger_subscriptions_impl(zn, _Z_SUBSCRIBER_KIND_LIVELINESS_SUBSCRIBER, &key, &payload, &encoding,
                                          Z_SAMPLE_KIND_DELETE, timestamp, _Z_N_QOS_DEFAULT, &attachment,
-                                         Z_RELIABILITY_RELIABLE, &source_info, peer);
+                                         Z_RELIABILITY_RELIABLE, &source_info, peer, NULL);
 }
 
 static z_result_t _z_subscription_get_infos(_z_session_t *zn, _z_subscriber_kind_t kind,
-                                            _z_subscription_cache_data_t *infos, _z_transport_peer_common_t *peer) {
+                                            _z_subscription_cache_data_t *infos, _z_transport_peer_common_t *peer,
+                                            _z_arena_t *arena) {
     infos->is_remote = (peer != NULL);
-    _z_session_mutex_lock(zn);
-    _z_subscription_cache_data_t *cache_entry = NULL;
     z_result_t ret = _Z_RES_OK;
 #if Z_FEATURE_RX_CACHE == 1
-    cache_entry = _z_subscription_lru_cache_get(&zn->_subscription_cache, infos);
+    // Cached data outlives the batch, it isn't stored in the arena
+    _ZP_UNUSED(arena);
+    // The cache is shared with the other rx tasks and invalidated by declarations
+    _z_session_mutex_lock(zn);
+    _z_subscription_cache_data_t *cache_entry = _z_subscription_lru_cache_get(&zn->_subscription_cache, infos);
     if (cache_entry != NULL && cache_entry->is_remote != infos->is_remote) {
         cache_entry = NULL;
     }
-#endif
     if (cache_entry != NULL) {  // Copy cache entry
         infos->infos = _z_subscription_rc_svec_rc_clone(&cache_entry->infos);
         ret = _z_keyexpr_copy(&infos->ke_out, &cache_entry->ke_out);
@@ -234,9 +282,7 @@ static z_result_t _z_subscription_get_infos(_z_session_t *zn, _z_subscriber_kind
         infos->ke_out = __unsafe_z_get_expanded_key_from_key(zn, &infos->ke_in, false, peer);
         ret = _z_keyexpr_has_suffix(&infos->ke_out) ? _Z_RES_OK : _Z_ERR_KEYEXPR_UNKNOWN;
         // Get subscription list
-        _Z_SET_IF_OK(ret,
-                     __unsafe_z_get_subscriptions_rc_by_key(zn, kind, &infos->ke_out, infos->is_remote, &infos->infos));
-#if Z_FEATURE_RX_CACHE == 1
+        _Z_SET_IF_OK(ret, _z_get_subscriptions_rc_by_key(zn, kind, &infos->ke_out, infos->is_remote, &infos->infos));
         _z_subscription_cache_data_t cache_storage = _z_subscription_cache_data_null();
         cache_storage.infos = _z_subscription_rc_svec_rc_clone(&infos->infos);
         cache_storage.is_remote = infos->is_remote;
@@ -246,12 +292,19 @@ static z_result_t _z_subscription_get_infos(_z_session_t *zn, _z_subscriber_kind
         if (ret != _Z_RES_OK) {
             _z_subscription_cache_data_clear(&cache_storage);
         }
-#endif
     }
+    _z_session_mutex_unlock(zn);
+#else
+    _Z_DEBUG("Resolving %d - %.*s on mapping 0x%x", infos->ke_in._id, (int)_z_string_len(&infos->ke_in._suffix),
+             _z_string_data(&infos->ke_in._suffix), (unsigned int)infos->ke_in._mapping);
+    // Only keys declared with an id need the session mutex, to read the resources
+    infos->ke_out = _z_get_expanded_key_in_arena(zn, &infos->ke_in, peer, arena);
+    ret = _z_keyexpr_has_suffix(&infos->ke_out) ? _Z_RES_OK : _Z_ERR_KEYEXPR_UNKNOWN;
+    _Z_SET_IF_OK(ret, _z_get_subscriptions_by_key(zn, kind, &infos->ke_out, infos->is_remote, &infos->infos, arena));
+#endif
     if (ret != _Z_RES_OK) {
         _z_subscription_cache_data_clear(infos);
     }
-    _z_session_mutex_unlock(zn);
     return ret;
 }
 
@@ -259,13 +312,18 @@ z_result_t _z_trigger_subscriptions_impl(_z_session_t *zn, _z_subscriber_kind_t
                                          _z_bytes_t *payload, _z_encoding_t *encoding, const _z_zint_t sample_kind,
                                          const _z_timestamp_t *timestamp, const _z_n_qos_t qos, _z_bytes_t *attachment,
                                          z_reliability_t reliability, _z_source_info_t *source_info,
-                                         _z_transport_peer_common_t *peer) {
+                                         _z_transport_peer_common_t *peer, _z_arena_t *arena) {
     _z_subscription_cache_data_t sub_infos = _z_subscription_cache_data_null();
     // Retrieve sub infos
     sub_infos.ke_in = _z_keyexpr_steal(keyexpr);
-    _Z_CLEAN_RETURN_IF_ERR(_z_subscription_get_infos(zn, sub_kind, &sub_infos, peer), _z_encoding_clear(encoding);
-                           _z_bytes_drop(payload); _z_bytes_drop(attachment); _z_source_info_clear(source_info););
+    _Z_CLEAN_RETURN_IF_ERR(_z_subscription_get_infos(zn, sub_kind, &sub_infos, peer, arena),
+                           _z_encoding_clear(encoding); _z_bytes_drop(payload); _z_bytes_drop(attachment);
+                           _z_source_info_clear(source_info););
+#if Z_FEATURE_RX_CACHE == 1
     const _z_subscription_rc_svec_t *subs = _Z_RC_IN_VAL(&sub_infos.infos);
+#else
+    const _z_subscription_rc_svec_t *subs = &sub_infos.infos;
+#endif
     size_t sub_nb = _z_subscription_rc_svec_len(subs);
     _Z_DEBUG("Triggering %ju subs for key %d - %.*s", (uintmax_t)sub_nb, sub_infos.ke_out._id,
              (int)_z_string_len(&sub_infos.ke_out._suffix), _z_string_data(&sub_infos.ke_out._suffix));
@@ -306,6 +364,9 @@ void _z_unregister_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_
         _z_write_filter_notify_subscriber(zn, &sub_val->_key, sub_val->_allowed_origin, false);
     }
 #endif
+    // The stored subscription is only dropped once the rx path can't reach it through the tree
+    (void)_z_keyexpr_tree_rcu_remove_if(_z_get_subscriptions_tree(zn, kind), &_Z_RC_IN_VAL(sub)->_key._suffix,
+                                        (z_element_eq_f)_z_subscription_rc_eq, sub);
     _z_session_mutex_lock(zn);
 
     if (kind == _Z_SUBSCRIBER_KIND_SUBSCRIBER) {
@@ -319,6 +380,8 @@ void _z_unregister_subscription(_z_session_t *zn, _z_subscriber_kind_t kind, _z_
 }
 
 void _z_flush_subscriptions(_z_session_t *zn) {
+    _z_keyexpr_tree_rcu_clear(&zn->_subscriptions_tree);
+    _z_keyexpr_tree_rcu_clear(&zn->_liveliness_subscriptions_tree);
     _z_session_mutex_lock(zn);
 
     _z_subscription_rc_slist_free(&zn->_subscriptions);
@@ -65,6 +65,13 @@ z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid) {
 #endif
     zn->_mode = Z_WHATAMI_CLIENT;
     zn->_tp._type = _Z_TRANSPORT_NONE;
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+        zn->_tp_groups[i]._type = _Z_TRANSPORT_NONE;
+    }
+    _z_session_dedup_init(&zn->_dedup);
+    zn->_source_sn = 0;
+#endif
     // Initialize the counters to 1
     zn->_entity_id = 1;
     zn->_resource_id = 1;
@@ -77,21 +84,28 @@ z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid) {
 
     // Initialize the data structs
     zn->_local_resources = NULL;
+    _z_resource_index_init(&zn->_local_resources_index);
 #if Z_FEATURE_SUBSCRIPTION == 1
     zn->_subscriptions = NULL;
     zn->_liveliness_subscriptions = NULL;
+    _Z_SET_IF_OK(ret, _z_keyexpr_tree_rcu_init(&zn->_subscriptions_tree));
+    _Z_SET_IF_OK(ret, _z_keyexpr_tree_rcu_init(&zn->_liveliness_subscriptions_tree));
 #if Z_FEATURE_RX_CACHE == 1
     zn->_subscription_cache = _z_subscription_lru_cache_init(Z_RX_CACHE_SIZE);
 #endif
 #endif
+#if Z_FEATURE_SHM == 1
+    _z_shm_segment_cache_init(&zn->_shm_segments);
+#endif
 #if Z_FEATURE_QUERYABLE == 1
     zn->_local_queryable = NULL;
+    _Z_SET_IF_OK(ret, _z_keyexpr_tree_rcu_init(&zn->_local_queryable_tree));
 #if Z_FEATURE_RX_CACHE == 1
     zn->_queryable_cache = _z_queryable_lru_cache_init(Z_RX_CACHE_SIZE);
 #endif
 #endif
 #if Z_FEATURE_QUERY == 1
-    zn->_pending_queries = NULL;
+    _z_pending_queries_init(zn);
 #endif
 
 #if Z_FEATURE_LIVELINESS == 1
@@ -124,6 +138,15 @@ z_result_t _z_session_init(_z_session_t *zn, const _z_id_t *zid) {
 }
 
 void _z_session_clear(_z_session_t *zn) {
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    // Groups are left first, they stay joined even if the main transport was lost
+    for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+        if (zn->_tp_groups[i]._type != _Z_TRANSPORT_NONE) {
+            _z_transport_close(&zn->_tp_groups[i], _Z_CLOSE_GENERIC);
+            _z_transport_clear(&zn->_tp_groups[i]);
+        }
+    }
+#endif
     if (!_z_session_is_closed(zn)) {
 #if Z_FEATURE_MULTI_THREAD == 1
         _zp_stop_read_task(zn);
@@ -153,6 +176,9 @@ void _z_session_clear(_z_session_t *zn) {
         _z_subscription_lru_cache_delete(&zn->_subscription_cache);
 #endif
 #endif
+#if Z_FEATURE_SHM == 1
+        _z_shm_segment_cache_clear(&zn->_shm_segments);
+#endif
 #if Z_FEATURE_QUERYABLE == 1
         _z_flush_session_queryable(zn);
 #if Z_FEATURE_RX_CACHE == 1
@@ -191,6 +217,13 @@ z_result_t _z_session_close(_z_session_t *zn, uint8_t reason) {
 
     if (zn != NULL) {
         ret = _z_transport_close(&zn->_tp, reason);
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+        for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+            if (zn->_tp_groups[i]._type != _Z_TRANSPORT_NONE) {
+                _z_transport_close(&zn->_tp_groups[i], reason);
+            }
+        }
+#endif
     }
 
     return ret;
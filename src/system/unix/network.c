@@ -12,6 +12,10 @@
 //   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
 //
 
+#if defined(ZENOH_LINUX) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // Needed for recvmmsg
+#endif
+
 #include <arpa/inet.h>
 #include <assert.h>
 #include <errno.h>
@@ -26,7 +30,12 @@
 #include <stddef.h>
 #include <string.h>
 #include <sys/ioctl.h>
+#if defined(ZENOH_LINUX)
+#include <sys/epoll.h>
+#endif
+#include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "zenoh-pico/collections/string.h"
@@ -161,6 +170,108 @@ z_result_t _z_socket_wait_event(void *peers, _z_mutex_rec_t *mutex) {
 }
 #endif
 
+#if defined(_Z_SYS_NET_EVENT_SET)
+z_result_t _z_socket_event_set_init(_z_sys_net_event_set_t *set) {
+    set->_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (set->_fd < 0) {
+        _Z_DEBUG("Errno: %d\n", errno);
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    return _Z_RES_OK;
+}
+
+void _z_socket_event_set_clear(_z_sys_net_event_set_t *set) {
+    if (set->_fd >= 0) {
+        close(set->_fd);
+        set->_fd = -1;
+    }
+}
+
+z_result_t _z_socket_event_set_add(_z_sys_net_event_set_t *set, const _z_sys_net_socket_t *sock, void *ctx) {
+    struct epoll_event event;
+    (void)memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = ctx;
+    if (epoll_ctl(set->_fd, EPOLL_CTL_ADD, sock->_fd, &event) < 0) {
+        _Z_DEBUG("Errno: %d\n", errno);
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    return _Z_RES_OK;
+}
+
+void _z_socket_event_set_remove(_z_sys_net_event_set_t *set, const _z_sys_net_socket_t *sock) {
+    // Closing the socket also removes it, fails harmlessly if it was never added
+    (void)epoll_ctl(set->_fd, EPOLL_CTL_DEL, sock->_fd, NULL);
+}
+
+z_result_t _z_socket_event_set_wait(_z_sys_net_event_set_t *set, void **ready, size_t max, size_t *count) {
+    struct epoll_event events[_Z_SYS_NET_EVENT_SET_WAIT_MAX];
+    if (max > _Z_SYS_NET_EVENT_SET_WAIT_MAX) {
+        max = _Z_SYS_NET_EVENT_SET_WAIT_MAX;
+    }
+    *count = 0;
+    int result = epoll_wait(set->_fd, events, (int)max, Z_CONFIG_SOCKET_TIMEOUT);
+    if (result < 0) {
+        _Z_DEBUG("Errno: %d\n", errno);
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
+    for (int i = 0; i < result; i++) {
+        ready[i] = events[i].data.ptr;
+    }
+    *count = (size_t)result;
+    return _Z_RES_OK;
+}
+#endif
+
+#if Z_FEATURE_LINK_TCP == 1 || Z_FEATURE_LINK_UDP_MULTICAST == 1 || Z_FEATURE_LINK_UDP_UNICAST == 1
+static size_t _z_send_vec(int fd, const _z_slice_t *bufs, size_t count, struct sockaddr *addr, socklen_t addrlen,
+                          int flags) {
+    if (count > _Z_SYS_NET_SEND_VEC_MAX) {
+        return SIZE_MAX;
+    }
+    struct iovec iov[_Z_SYS_NET_SEND_VEC_MAX];
+    for (size_t i = 0; i < count; i++) {
+        iov[i].iov_base = (void *)bufs[i].start;
+        iov[i].iov_len = bufs[i].len;
+    }
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = addr;
+    msg.msg_namelen = addrlen;
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+    return (size_t)sendmsg(fd, &msg, flags);
+}
+#endif
+
+#if (Z_FEATURE_LINK_UDP_MULTICAST == 1 || Z_FEATURE_LINK_UDP_UNICAST == 1) && defined(_Z_SYS_NET_RECV_VEC_MAX)
+static size_t _z_read_vec(int fd, _z_slice_t *bufs, size_t count, struct sockaddr_storage *raddrs) {
+    if (count > _Z_SYS_NET_RECV_VEC_MAX) {
+        count = _Z_SYS_NET_RECV_VEC_MAX;
+    }
+    struct iovec iov[_Z_SYS_NET_RECV_VEC_MAX];
+    struct mmsghdr msgs[_Z_SYS_NET_RECV_VEC_MAX];
+    (void)memset(msgs, 0, sizeof(msgs));
+    for (size_t i = 0; i < count; i++) {
+        iov[i].iov_base = (void *)bufs[i].start;
+        iov[i].iov_len = bufs[i].len;
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &raddrs[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+    }
+    // Block until the first datagram arrives, then only take the ones already queued
+    int rb = recvmmsg(fd, msgs, (unsigned int)count, MSG_WAITFORONE, NULL);
+    if (rb < 0) {
+        return SIZE_MAX;
+    }
+    for (int i = 0; i < rb; i++) {
+        bufs[i].len = msgs[i].msg_len;
+    }
+    return (size_t)rb;
+}
+#endif
+
 #if Z_FEATURE_LINK_TCP == 1
 /*------------------ TCP sockets ------------------*/
 z_result_t _z_create_endpoint_tcp(_z_sys_net_endpoint_t *ep, const char *s_address, const char *s_port) {
@@ -381,6 +492,14 @@ size_t _z_send_tcp(const _z_sys_net_socket_t sock, const uint8_t *ptr, size_t le
     return send(sock._fd, ptr, len, 0);
 #endif
 }
+
+size_t _z_send_vec_tcp(const _z_sys_net_socket_t sock, const _z_slice_t *bufs, size_t count) {
+#if defined(ZENOH_LINUX)
+    return _z_send_vec(sock._fd, bufs, count, NULL, 0, MSG_NOSIGNAL);
+#else
+    return _z_send_vec(sock._fd, bufs, count, NULL, 0, 0);
+#endif
+}
 #endif
 
 #if Z_FEATURE_LINK_UDP_UNICAST == 1 || Z_FEATURE_LINK_UDP_MULTICAST == 1
@@ -463,6 +582,13 @@ size_t _z_read_udp_unicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t
     return (size_t)rb;
 }
 
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+size_t _z_read_vec_udp_unicast(const _z_sys_net_socket_t sock, _z_slice_t *bufs, size_t count) {
+    struct sockaddr_storage raddrs[_Z_SYS_NET_RECV_VEC_MAX];
+    return _z_read_vec(sock._fd, bufs, count, raddrs);
+}
+#endif
+
 size_t _z_read_exact_udp_unicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len) {
     size_t n = 0;
     uint8_t *pos = &ptr[0];
@@ -485,6 +611,11 @@ size_t _z_send_udp_unicast(const _z_sys_net_socket_t sock, const uint8_t *ptr, s
                            const _z_sys_net_endpoint_t rep) {
     return (size_t)sendto(sock._fd, ptr, len, 0, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
 }
+
+size_t _z_send_vec_udp_unicast(const _z_sys_net_socket_t sock, const _z_slice_t *bufs, size_t count,
+                               const _z_sys_net_endpoint_t rep) {
+    return _z_send_vec(sock._fd, bufs, count, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen, 0);
+}
 #endif
 
 #if Z_FEATURE_LINK_UDP_MULTICAST == 1
@@ -778,6 +909,42 @@ void _z_close_udp_multicast(_z_sys_net_socket_t *sockrecv, _z_sys_net_socket_t *
     }
 }
 
+// Returns false for datagrams sent by the local endpoint, fills addr with the sender address otherwise
+static bool _z_udp_multicast_accept_addr(const _z_sys_net_endpoint_t lep, const struct sockaddr_storage *raddr,
+                                         _z_slice_t *addr) {
+    if (lep._iptcp->ai_family == AF_INET) {
+        struct sockaddr_in *a = ((struct sockaddr_in *)lep._iptcp->ai_addr);
+        const struct sockaddr_in *b = ((const struct sockaddr_in *)raddr);
+        if ((a->sin_port == b->sin_port) && (a->sin_addr.s_addr == b->sin_addr.s_addr)) {
+            return false;
+        }
+        // If addr is not NULL, it means that the rep was requested by the upper-layers
+        if (addr != NULL) {
+            assert(addr->len >= sizeof(in_addr_t) + sizeof(in_port_t));
+            addr->len = sizeof(in_addr_t) + sizeof(in_port_t);
+            (void)memcpy((uint8_t *)addr->start, &b->sin_addr.s_addr, sizeof(in_addr_t));
+            (void)memcpy((uint8_t *)(addr->start + sizeof(in_addr_t)), &b->sin_port, sizeof(in_port_t));
+        }
+        return true;
+    } else if (lep._iptcp->ai_family == AF_INET6) {
+        struct sockaddr_in6 *a = ((struct sockaddr_in6 *)lep._iptcp->ai_addr);
+        const struct sockaddr_in6 *b = ((const struct sockaddr_in6 *)raddr);
+        if ((a->sin6_port == b->sin6_port) &&
+            (memcmp(a->sin6_addr.s6_addr, b->sin6_addr.s6_addr, sizeof(struct in6_addr)) == 0)) {
+            return false;
+        }
+        // If addr is not NULL, it means that the rep was requested by the upper-layers
+        if (addr != NULL) {
+            assert(addr->len >= sizeof(struct in6_addr) + sizeof(in_port_t));
+            addr->len = sizeof(struct in6_addr) + sizeof(in_port_t);
+            (void)memcpy((uint8_t *)addr->start, &b->sin6_addr.s6_addr, sizeof(struct in6_addr));
+            (void)memcpy((uint8_t *)(addr->start + sizeof(struct in6_addr)), &b->sin6_port, sizeof(in_port_t));
+        }
+        return true;
+    }
+    return false;  // FIXME: support error report on invalid packet to the upper layer
+}
+
 size_t _z_read_udp_multicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len, const _z_sys_net_endpoint_t lep,
                              _z_slice_t *addr) {
     struct sockaddr_storage raddr;
@@ -789,42 +956,26 @@ size_t _z_read_udp_multicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_
         if (rb < (ssize_t)0) {
             return SIZE_MAX;
         }
-
-        if (lep._iptcp->ai_family == AF_INET) {
-            struct sockaddr_in *a = ((struct sockaddr_in *)lep._iptcp->ai_addr);
-            struct sockaddr_in *b = ((struct sockaddr_in *)&raddr);
-            if (!((a->sin_port == b->sin_port) && (a->sin_addr.s_addr == b->sin_addr.s_addr))) {
-                // If addr is not NULL, it means that the rep was requested by the upper-layers
-                if (addr != NULL) {
-                    assert(addr->len >= sizeof(in_addr_t) + sizeof(in_port_t));
-                    addr->len = sizeof(in_addr_t) + sizeof(in_port_t);
-                    (void)memcpy((uint8_t *)addr->start, &b->sin_addr.s_addr, sizeof(in_addr_t));
-                    (void)memcpy((uint8_t *)(addr->start + sizeof(in_addr_t)), &b->sin_port, sizeof(in_port_t));
-                }
-                break;
-            }
-        } else if (lep._iptcp->ai_family == AF_INET6) {
-            struct sockaddr_in6 *a = ((struct sockaddr_in6 *)lep._iptcp->ai_addr);
-            struct sockaddr_in6 *b = ((struct sockaddr_in6 *)&raddr);
-            if (!((a->sin6_port == b->sin6_port) &&
-                  (memcmp(a->sin6_addr.s6_addr, b->sin6_addr.s6_addr, sizeof(struct in6_addr)) == 0))) {
-                // If addr is not NULL, it means that the rep was requested by the upper-layers
-                if (addr != NULL) {
-                    assert(addr->len >= sizeof(struct in6_addr) + sizeof(in_port_t));
-                    addr->len = sizeof(struct in6_addr) + sizeof(in_port_t);
-                    (void)memcpy((uint8_t *)addr->start, &b->sin6_addr.s6_addr, sizeof(struct in6_addr));
-                    (void)memcpy((uint8_t *)(addr->start + sizeof(struct in6_addr)), &b->sin6_port, sizeof(in_port_t));
-                }
-                break;
-            }
-        } else {
-            continue;  // FIXME: support error report on invalid packet to the upper layer
-        }
-    } while (1);
+    } while (!_z_udp_multicast_accept_addr(lep, &raddr, addr));
 
     return (size_t)rb;
 }
 
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+size_t _z_read_vec_udp_multicast(const _z_sys_net_socket_t sock, _z_slice_t *bufs, size_t count,
+                                 const _z_sys_net_endpoint_t lep, _z_slice_t *addrs) {
+    struct sockaddr_storage raddrs[_Z_SYS_NET_RECV_VEC_MAX];
+    size_t rn = _z_read_vec(sock._fd, bufs, count, raddrs);
+    for (size_t i = 0; (rn != SIZE_MAX) && (i < rn); i++) {
+        // Datagrams sent by the local endpoint are reported empty
+        if (!_z_udp_multicast_accept_addr(lep, &raddrs[i], (addrs != NULL) ? &addrs[i] : NULL)) {
+            bufs[i].len = 0;
+        }
+    }
+    return rn;
+}
+#endif
+
 size_t _z_read_exact_udp_multicast(const _z_sys_net_socket_t sock, uint8_t *ptr, size_t len,
                                    const _z_sys_net_endpoint_t lep, _z_slice_t *addr) {
     size_t n = 0;
@@ -849,6 +1000,11 @@ size_t _z_send_udp_multicast(const _z_sys_net_socket_t sock, const uint8_t *ptr,
     return (size_t)sendto(sock._fd, ptr, len, 0, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen);
 }
 
+size_t _z_send_vec_udp_multicast(const _z_sys_net_socket_t sock, const _z_slice_t *bufs, size_t count,
+                                 const _z_sys_net_endpoint_t rep) {
+    return _z_send_vec(sock._fd, bufs, count, rep._iptcp->ai_addr, rep._iptcp->ai_addrlen, 0);
+}
+
 #endif
 
 #if Z_FEATURE_LINK_BLUETOOTH == 1
@@ -13,10 +13,12 @@
 //
 
 #include <errno.h>
+#include <fcntl.h>
 #include <pthread.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #include "zenoh-pico/utils/result.h"
@@ -26,11 +28,14 @@
 #include <sys/time.h>
 #endif
 
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/system/common/system_error.h"
 #include "zenoh-pico/system/platform.h"
+#include "zenoh-pico/utils/logging.h"
 
 /*------------------ Random ------------------*/
 uint8_t z_random_u8(void) {
@@ -322,3 +327,95 @@ z_result_t _z_get_time_since_epoch(_z_time_since_epoch *t) {
     t->nanos = (uint32_t)now.tv_usec * 1000;
     return 0;
 }
+
+#if defined(_Z_SYS_SHM)
+/*------------------ Shared memory ------------------*/
+z_result_t _z_shm_segment_create(const char *name, size_t size, uint8_t **ptr) {
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        _Z_ERROR("Failed to create shared memory segment %s: %d", name, errno);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_GENERIC);
+    }
+    z_result_t ret = _Z_RES_OK;
+    if (ftruncate(fd, (off_t)size) != 0) {
+        _Z_ERROR_LOG(_Z_ERR_SYSTEM_GENERIC);
+        ret = _Z_ERR_SYSTEM_GENERIC;
+    } else {
+        void *p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            _Z_ERROR_LOG(_Z_ERR_SYSTEM_GENERIC);
+            ret = _Z_ERR_SYSTEM_GENERIC;
+        } else {
+            *ptr = (uint8_t *)p;
+        }
+    }
+    close(fd);
+    if (ret != _Z_RES_OK) {
+        shm_unlink(name);
+    }
+    return ret;
+}
+
+z_result_t _z_shm_segment_open(const char *name, uint8_t **ptr, size_t *size) {
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        _Z_ERROR("Failed to open shared memory segment %s: %d", name, errno);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_GENERIC);
+    }
+    z_result_t ret = _Z_RES_OK;
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size <= 0)) {
+        _Z_ERROR_LOG(_Z_ERR_SYSTEM_GENERIC);
+        ret = _Z_ERR_SYSTEM_GENERIC;
+    } else {
+        void *p = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            _Z_ERROR_LOG(_Z_ERR_SYSTEM_GENERIC);
+            ret = _Z_ERR_SYSTEM_GENERIC;
+        } else {
+            *ptr = (uint8_t *)p;
+            *size = (size_t)st.st_size;
+        }
+    }
+    close(fd);
+    return ret;
+}
+
+void _z_shm_segment_unmap(uint8_t *ptr, size_t size) { munmap(ptr, size); }
+
+void _z_shm_segment_unlink(const char *name) { shm_unlink(name); }
+
+z_result_t _z_shm_host_id(uint8_t *id, size_t len) {
+    memset(id, 0, len);
+#if defined(ZENOH_LINUX)
+    // Changes on every boot, unlike the machine id that images may share
+    FILE *f = fopen("/proc/sys/kernel/random/boot_id", "r");
+    if (f == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_GENERIC);
+    }
+    size_t i = 0;
+    int c = fgetc(f);
+    while ((c != EOF) && (i < 2 * len)) {
+        int digit = -1;
+        if ((c >= '0') && (c <= '9')) {
+            digit = c - '0';
+        } else if ((c >= 'a') && (c <= 'f')) {
+            digit = c - 'a' + 10;
+        }
+        if (digit >= 0) {
+            id[i / 2] = (uint8_t)(id[i / 2] | (digit << ((i % 2 == 0) ? 4 : 0)));
+            i++;
+        }
+        c = fgetc(f);
+    }
+    fclose(f);
+    if (i == 0) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_GENERIC);
+    }
+#else
+    long host = gethostid();
+    memcpy(id, &host, (sizeof(host) < len) ? sizeof(host) : len);
+#endif
+    return _Z_RES_OK;
+}
+#endif
@@ -16,6 +16,7 @@
 
 #include <stddef.h>
 
+#include "zenoh-pico/protocol/codec/network.h"
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/transport/multicast/rx.h"
 #include "zenoh-pico/transport/unicast/rx.h"
@@ -32,6 +33,198 @@ size_t _z_read_stream_size(_z_zbuf_t *zbuf) {
     return _z_host_le_load16(stream_size);
 }
 
+#if Z_RX_BUFFER_POOL_SIZE > 0
+// Takes a pooled buffer that is no longer referenced outside of the pool
+static bool _z_transport_rx_pool_take(_z_zbuf_t *pool, size_t capacity, _z_zbuf_t *zbf) {
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE; i++) {
+        _z_zbuf_t *pooled = &pool[i];
+        if ((_z_zbuf_capacity(pooled) == capacity) && (_z_zbuf_get_ref_count(pooled) == 1)) {
+            *zbf = *pooled;
+            *pooled = _z_zbuf_null();
+            _z_zbuf_reset(zbf);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Keeps a buffer still referenced by payloads until they are dropped
+static bool _z_transport_rx_pool_park(_z_zbuf_t *pool, _z_zbuf_t *zbf) {
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE; i++) {
+        if (_z_zbuf_capacity(&pool[i]) == 0) {
+            pool[i] = *zbf;
+            *zbf = _z_zbuf_null();
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+z_result_t _z_transport_update_rx_zbuf(_z_zbuf_t *zbf, _z_zbuf_t *pool) {
+    // Check if user or defragment buffer took ownership of buffer
+    if (_z_zbuf_get_ref_count(zbf) == 1) {
+        return _Z_RES_OK;
+    }
+    size_t capacity = _z_zbuf_capacity(zbf);
+    _z_zbuf_t new_zbuf = _z_zbuf_null();
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    if (!_z_transport_rx_pool_take(pool, capacity, &new_zbuf)) {
+        new_zbuf = _z_zbuf_make(capacity);
+    }
+#else
+    _ZP_UNUSED(pool);
+    new_zbuf = _z_zbuf_make(capacity);
+#endif
+    if (_z_zbuf_capacity(&new_zbuf) != capacity) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    // Recopy leftover bytes
+    if (_z_zbuf_len(zbf) > 0) {
+        _z_zbuf_copy_bytes(&new_zbuf, zbf);
+    }
+    // Drop buffer & update, unless it can be recycled later
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    if (!_z_transport_rx_pool_park(pool, zbf)) {
+        _z_zbuf_clear(zbf);
+    }
+#else
+    _z_zbuf_clear(zbf);
+#endif
+    *zbf = new_zbuf;
+    return _Z_RES_OK;
+}
+
+z_result_t _z_transport_update_rx_buffer(_z_transport_common_t *ztc) {
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    return _z_transport_update_rx_zbuf(&ztc->_zbuf, ztc->_zbuf_pool);
+#else
+    return _z_transport_update_rx_zbuf(&ztc->_zbuf, NULL);
+#endif
+}
+
+#if Z_FEATURE_FRAGMENTATION == 1
+/*------------------ Defragmentation buffer ------------------*/
+#if defined(_Z_DEFRAG_CHAINED)
+void _z_dbuf_clear(_z_dbuf_t *dbuf) { _z_bytes_drop(dbuf); }
+
+void _z_dbuf_reset(_z_dbuf_t *dbuf) { _z_arc_slice_svec_reset(&dbuf->_slices); }
+
+z_result_t _z_dbuf_copy(_z_dbuf_t *dst, const _z_dbuf_t *src) { return _z_bytes_copy(dst, src); }
+
+size_t _z_dbuf_len(const _z_dbuf_t *dbuf) { return _z_bytes_len(dbuf); }
+
+z_result_t _z_dbuf_init(_z_dbuf_t *dbuf, size_t max_size) {
+    _ZP_UNUSED(max_size);
+    *dbuf = _z_bytes_null();
+    return _Z_RES_OK;
+}
+
+z_result_t _z_dbuf_append(_z_dbuf_t *dbuf, const _z_t_msg_fragment_t *msg) {
+    size_t len = msg->_payload.len;
+    if (len == 0) {
+        return _Z_RES_OK;
+    }
+    _z_arc_slice_t s;
+    // Fragments filling less than half of their rx buffer are copied, so a message doesn't hold many mostly empty ones
+    if ((msg->_src != NULL) && !_z_slice_simple_rc_is_null(msg->_src) &&
+        (len * 2 >= _z_slice_simple_rc_value(msg->_src)->len)) {
+        size_t offset = _z_ptr_u8_diff(msg->_payload.start, _z_slice_simple_rc_value(msg->_src)->start);
+        s = _z_arc_slice_wrap_slice_rc(msg->_src, offset, len);
+    } else {
+        _z_slice_t copy = _z_slice_copy_from_buf(msg->_payload.start, len);
+        if (!_z_slice_check(&copy)) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+        s = _z_arc_slice_wrap(&copy, 0, len);
+        if (_z_arc_slice_is_empty(&s)) {
+            _z_slice_clear(&copy);
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+    }
+    return _z_bytes_append_slice(dbuf, &s);
+}
+
+// Decodes the message from a copy of all the fragments in a single buffer
+static z_result_t _z_dbuf_decode_copy(const _z_dbuf_t *dbuf, _z_zbuf_t *zbf, _z_network_message_t *msg,
+                                      _z_arc_slice_t *arcs, uintptr_t mapping) {
+    size_t len = _z_bytes_len(dbuf);
+    *zbf = _z_zbuf_make(len);
+    if (_z_zbuf_capacity(zbf) != len) {
+        _Z_ERROR("Not enough memory to allocate transport defragmentation buffer");
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    _z_zbuf_set_wpos(zbf, _z_bytes_to_buf(dbuf, _z_zbuf_get_wptr(zbf), len));
+    return _z_network_message_decode(msg, zbf, arcs, mapping);
+}
+
+z_result_t _z_dbuf_decode(_z_dbuf_t *dbuf, _z_zbuf_t *zbf, _z_network_message_t *msg, _z_arc_slice_t *arcs,
+                          uintptr_t mapping) {
+    *zbf = _z_zbuf_null();
+    size_t nb = _z_bytes_num_slices(dbuf);
+    if (nb == 0) {
+        _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+    }
+    // Decode in place from the first fragment, only a payload ending the message may extend over the next ones
+    const _z_arc_slice_t *head = _z_bytes_get_slice(dbuf, 0);
+    zbf->_ios = _z_iosli_wrap(_z_arc_slice_data(head), _z_arc_slice_len(head), 0, _z_arc_slice_len(head));
+    zbf->_slice = _z_slice_simple_rc_clone(&head->slice);
+    zbf->_tail = _z_bytes_get_slice(dbuf, 1);
+    zbf->_tail_len = nb - 1;
+    z_result_t ret = _z_network_message_decode(msg, zbf, arcs, mapping);
+    zbf->_tail = NULL;
+    zbf->_tail_len = 0;
+    if ((ret != _Z_RES_OK) && (nb > 1)) {
+        // Other fields span several fragments
+        _z_n_msg_clear(msg);
+        *msg = (_z_network_message_t){0};
+        _z_arc_slice_drop(arcs);
+        _z_zbuf_clear(zbf);
+        ret = _z_dbuf_decode_copy(dbuf, zbf, msg, arcs, mapping);
+    }
+    // What the message references is now held by the decoding buffer and the payload
+    _z_dbuf_clear(dbuf);
+    return ret;
+}
+#else
+void _z_dbuf_clear(_z_dbuf_t *dbuf) { _z_wbuf_clear(dbuf); }
+
+void _z_dbuf_reset(_z_dbuf_t *dbuf) { _z_wbuf_reset(dbuf); }
+
+z_result_t _z_dbuf_copy(_z_dbuf_t *dst, const _z_dbuf_t *src) {
+    _z_wbuf_copy(dst, src);
+    return _Z_RES_OK;
+}
+
+size_t _z_dbuf_len(const _z_dbuf_t *dbuf) { return _z_wbuf_len(dbuf); }
+
+z_result_t _z_dbuf_init(_z_dbuf_t *dbuf, size_t max_size) {
+    *dbuf = _z_wbuf_make(max_size, false);
+    if (_z_wbuf_capacity(dbuf) != max_size) {
+        _Z_ERROR("Not enough memory to allocate transport defragmentation buffer");
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
+
+z_result_t _z_dbuf_append(_z_dbuf_t *dbuf, const _z_t_msg_fragment_t *msg) {
+    return _z_wbuf_write_bytes(dbuf, msg->_payload.start, 0, msg->_payload.len);
+}
+
+z_result_t _z_dbuf_decode(_z_dbuf_t *dbuf, _z_zbuf_t *zbf, _z_network_message_t *msg, _z_arc_slice_t *arcs,
+                          uintptr_t mapping) {
+    // Convert the defragmentation buffer into a decoding buffer
+    *zbf = _z_wbuf_moved_as_zbuf(dbuf);
+    if (_z_zbuf_capacity(zbf) == 0) {
+        _Z_ERROR("Failed to convert defragmentation buffer into a decoding buffer!");
+        _z_wbuf_clear(dbuf);
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _z_network_message_decode(msg, zbf, arcs, mapping);
+}
+#endif
+#endif
+
 z_result_t _z_link_recv_t_msg(_z_transport_message_t *t_msg, const _z_link_t *zl, _z_sys_net_socket_t *socket) {
     z_result_t ret = _Z_RES_OK;
 
@@ -17,11 +17,15 @@
 
 #include "zenoh-pico/link/link.h"
 #include "zenoh-pico/system/common/platform.h"
+#include "zenoh-pico/transport/common/tx.h"
 #include "zenoh-pico/transport/unicast/accept.h"
 #include "zenoh-pico/utils/result.h"
 
 void _z_common_transport_clear(_z_transport_common_t *ztc, bool detach_tasks) {
 #if Z_FEATURE_MULTI_THREAD == 1
+#if defined(_Z_TX_QUEUE)
+    _z_transport_tx_queue_stop(ztc);
+#endif
     // Clean up tasks
     if (ztc->_read_task != NULL) {
         ztc->_read_task_running = false;
@@ -55,7 +59,31 @@ void _z_common_transport_clear(_z_transport_common_t *ztc, bool detach_tasks) {
 
     // Clean up the buffers
     _z_wbuf_clear(&ztc->_wbuf);
+#if Z_FEATURE_BATCHING == 1
+    for (uint8_t i = 0; i < Z_PRIORITIES_NUM; i++) {
+        _z_wbuf_clear(&ztc->_batch_lanes[i]._wbuf);
+#if Z_FEATURE_SHM == 1
+        // Batched messages that were never sent give back their handles
+        _z_shm_chunk_refs_release(&ztc->_batch_lanes[i]._shm_refs);
+        _z_shm_chunk_ref_svec_clear(&ztc->_batch_lanes[i]._shm_refs);
+#endif
+    }
+#endif
     _z_zbuf_clear(&ztc->_zbuf);
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE; i++) {
+        _z_zbuf_clear(&ztc->_zbuf_pool[i]);
+    }
+#endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    if (ztc->_retx_window != NULL) {
+        for (size_t i = 0; i < Z_MULTICAST_RETX_WINDOW_SIZE; i++) {
+            z_free(ztc->_retx_window[i]._buf);
+        }
+        z_free(ztc->_retx_window);
+        ztc->_retx_window = NULL;
+    }
+#endif
 
     _z_link_free(&ztc->_link);
     _z_session_weak_drop(&ztc->_session);
@@ -19,6 +19,7 @@
 #include "zenoh-pico/protocol/codec/network.h"
 #include "zenoh-pico/protocol/codec/transport.h"
 #include "zenoh-pico/protocol/definitions/transport.h"
+#include "zenoh-pico/session/shm.h"
 #include "zenoh-pico/transport/raweth/tx.h"
 #include "zenoh-pico/transport/transport.h"
 #include "zenoh-pico/transport/utils.h"
@@ -45,6 +46,8 @@ static inline bool _z_transport_tx_get_express_status(const _z_network_message_t
             return _Z_HAS_FLAG(msg->_body._request._ext_qos._val, _Z_N_QOS_IS_EXPRESS_FLAG);
         case _Z_N_RESPONSE:
             return _Z_HAS_FLAG(msg->_body._response._ext_qos._val, _Z_N_QOS_IS_EXPRESS_FLAG);
+        case _Z_N_OAM:
+            return _Z_HAS_FLAG(msg->_body._oam._ext_qos._val, _Z_N_QOS_IS_EXPRESS_FLAG);
         default:
             return false;
     }
@@ -61,40 +64,172 @@ static _z_zint_t _z_transport_tx_get_sn(_z_transport_common_t *ztc, z_reliabilit
     return sn;
 }
 
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+// Keep a copy of the reliable frame or fragment in the tx buffer so it can be retransmitted
+static void _z_transport_tx_retx_store(_z_transport_common_t *ztc, z_reliability_t reliability, _z_zint_t sn) {
+    if ((ztc->_retx_window == NULL) || (reliability != Z_RELIABILITY_RELIABLE)) {
+        return;
+    }
+    _z_transport_retx_entry_t *entry = &ztc->_retx_window[sn % Z_MULTICAST_RETX_WINDOW_SIZE];
+    size_t len = _z_wbuf_len(&ztc->_wbuf);
+    if (entry->_capacity < len) {
+        uint8_t *buf = (uint8_t *)z_realloc(entry->_buf, len);
+        if (buf == NULL) {
+            // Frame can't be retransmitted, the peers will skip it after their retries
+            entry->_len = 0;
+            return;
+        }
+        entry->_buf = buf;
+        entry->_capacity = len;
+    }
+    size_t pos = 0;
+    for (size_t i = 0; i < _z_wbuf_len_iosli(&ztc->_wbuf); i++) {
+        _z_slice_t bs = _z_iosli_to_bytes(_z_wbuf_get_iosli(&ztc->_wbuf, i));
+        memcpy(&entry->_buf[pos], bs.start, bs.len);
+        pos += bs.len;
+    }
+    entry->_sn = sn;
+    entry->_len = len;
+}
+
+z_result_t _z_transport_tx_retransmit(_z_transport_common_t *ztc, _z_zint_t first_sn, _z_zint_t last_sn) {
+    if (ztc->_retx_window == NULL) {
+        return _Z_RES_OK;
+    }
+    // SNs older than the window size already left it
+    if (((last_sn - first_sn) & ztc->_sn_res) >= Z_MULTICAST_RETX_WINDOW_SIZE) {
+        first_sn = (last_sn - (Z_MULTICAST_RETX_WINDOW_SIZE - 1)) & ztc->_sn_res;
+    }
+    _z_transport_tx_mutex_lock(ztc, true);
+    z_result_t ret = _Z_RES_OK;
+    _z_zint_t sn = first_sn;
+    for (size_t i = 0; (i < Z_MULTICAST_RETX_WINDOW_SIZE) && (ret == _Z_RES_OK); i++) {
+        const _z_transport_retx_entry_t *entry = &ztc->_retx_window[sn % Z_MULTICAST_RETX_WINDOW_SIZE];
+        if ((entry->_len > 0) && (entry->_sn == sn)) {
+            _z_wbuf_reset(&ztc->_wbuf);
+            ret = _z_wbuf_write_bytes(&ztc->_wbuf, entry->_buf, 0, entry->_len);
+            _Z_SET_IF_OK(ret, _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, NULL));
+        } else {
+            _Z_DEBUG("Reliable frame %ju can't be retransmitted, it left the window", (uintmax_t)sn);
+        }
+        if (sn == last_sn) {
+            break;
+        }
+        sn = _z_sn_increment(ztc->_sn_res, sn);
+    }
+    _z_transport_tx_mutex_unlock(ztc);
+    return ret;
+}
+#else
+static void _z_transport_tx_retx_store(_z_transport_common_t *ztc, z_reliability_t reliability, _z_zint_t sn) {
+    _ZP_UNUSED(ztc);
+    _ZP_UNUSED(reliability);
+    _ZP_UNUSED(sn);
+}
+#endif
+
+#if Z_FEATURE_SHM == 1
+// The handle on a chunk a put by reference gives to its peer, NULL for other messages
+static const _z_shm_chunk_ref_t *_z_transport_tx_shm_handle(const _z_network_message_t *n_msg) {
+    if ((n_msg->_tag != _Z_N_PUSH) || !n_msg->_body._push._body._is_put ||
+        !n_msg->_body._push._body._body._put._is_shm) {
+        return NULL;
+    }
+    return _z_shm_info_handle(&n_msg->_body._push._body._body._put._payload);
+}
+#endif
+
 #if Z_FEATURE_FRAGMENTATION == 1
+// Copies the next fragment of the encoded message in the tx buffer and sends it
+static z_result_t _z_transport_tx_copy_fragment(_z_transport_common_t *ztc, _z_wbuf_t *frag_buff,
+                                                z_reliability_t reliability, _z_zint_t sn, bool is_first,
+                                                _z_transport_peer_unicast_slist_t *peers) {
+    z_result_t ret = __unsafe_z_serialize_zenoh_fragment(&ztc->_wbuf, frag_buff, reliability, sn, is_first);
+    if (ret != _Z_RES_OK) {
+        _Z_ERROR("Fragment serialization failed with err %d", ret);
+        return ret;
+    }
+    __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+    _z_transport_tx_retx_store(ztc, reliability, sn);
+    if (peers == NULL) {
+        return _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, NULL);
+    }
+    for (_z_transport_peer_unicast_slist_t *l = peers; l != NULL; l = _z_transport_peer_unicast_slist_next(l)) {
+        // Send on peer socket
+        _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, &_z_transport_peer_unicast_slist_value(l)->_socket);
+    }
+    return _Z_RES_OK;
+}
+
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+// Whether fragments can be sent straight from the encoded message, whose payloads are referenced rather than copied
+static bool _z_transport_tx_can_gather_fragments(const _z_transport_common_t *ztc, z_reliability_t reliability) {
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    // The retransmission window keeps a copy of the tx buffer
+    if ((ztc->_retx_window != NULL) && (reliability == Z_RELIABILITY_RELIABLE)) {
+        return false;
+    }
+#else
+    _ZP_UNUSED(reliability);
+#endif
+    return ztc->_link->_write_vec_f != NULL;
+}
+
+// Sends the fragment header from the tx buffer followed by the next slices of the encoded message in a gather write
+static z_result_t _z_transport_tx_gather_fragment(_z_transport_common_t *ztc, _z_wbuf_t *frag_buff,
+                                                  z_reliability_t reliability, _z_zint_t sn, bool is_first,
+                                                  _z_transport_peer_unicast_slist_t *peers) {
+    size_t w_pos = _z_wbuf_get_wpos(&ztc->_wbuf);
+    _z_transport_message_t f_hdr = _z_t_msg_make_fragment_header(sn, reliability, false, is_first, false);
+    _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &f_hdr));
+    _z_slice_t bufs[_Z_SYS_NET_SEND_VEC_MAX];
+    size_t count = 1;
+    size_t len = _z_wbuf_gather(frag_buff, bufs, &count, _Z_SYS_NET_SEND_VEC_MAX, _z_wbuf_space_left(&ztc->_wbuf));
+    if (_z_wbuf_len(frag_buff) == 0) {
+        // The header size doesn't depend on the final flag
+        _z_wbuf_set_wpos(&ztc->_wbuf, w_pos);
+        f_hdr = _z_t_msg_make_fragment_header(sn, reliability, true, is_first, false);
+        _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &f_hdr));
+    }
+    if (ztc->_link->_cap._flow == Z_LINK_CAP_FLOW_STREAM) {
+        size_t frag_len = _z_wbuf_len(&ztc->_wbuf) - _Z_MSG_LEN_ENC_SIZE + len;
+        _z_wbuf_put(&ztc->_wbuf, _z_get_u16_lsb((uint_fast16_t)frag_len), 0);
+        _z_wbuf_put(&ztc->_wbuf, _z_get_u16_msb((uint_fast16_t)frag_len), 1);
+    }
+    bufs[0] = _z_iosli_to_bytes(_z_wbuf_get_iosli(&ztc->_wbuf, 0));
+    if (peers == NULL) {
+        return _z_link_send_slices(ztc->_link, bufs, count, NULL);
+    }
+    for (_z_transport_peer_unicast_slist_t *l = peers; l != NULL; l = _z_transport_peer_unicast_slist_next(l)) {
+        _z_link_send_slices(ztc->_link, bufs, count, &_z_transport_peer_unicast_slist_value(l)->_socket);
+    }
+    return _Z_RES_OK;
+}
+#endif
+
+// Sends the encoded message in frag_buff as fragments
 static z_result_t _z_transport_tx_send_fragment_inner(_z_transport_common_t *ztc, _z_wbuf_t *frag_buff,
-                                                      const _z_network_message_t *n_msg, z_reliability_t reliability,
-                                                      _z_zint_t first_sn, _z_transport_peer_unicast_slist_t *peers) {
+                                                      z_reliability_t reliability, _z_zint_t first_sn,
+                                                      _z_transport_peer_unicast_slist_t *peers) {
     bool is_first = true;
     _z_zint_t sn = first_sn;
-    // Encode message on temp buffer
-    _Z_RETURN_IF_ERR(_z_network_message_encode(frag_buff, n_msg));
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+    bool gather = _z_transport_tx_can_gather_fragments(ztc, reliability);
+#endif
     // Fragment message
     while (_z_wbuf_len(frag_buff) > 0) {
         // Get fragment sequence number
         if (!is_first) {
             sn = _z_transport_tx_get_sn(ztc, reliability);
         }
-        // Serialize fragment
         __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
-        z_result_t ret = __unsafe_z_serialize_zenoh_fragment(&ztc->_wbuf, frag_buff, reliability, sn, is_first);
-        if (ret != _Z_RES_OK) {
-            _Z_ERROR("Fragment serialization failed with err %d", ret);
-            return ret;
-        }
-        // Send fragment
-        __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
-        if (peers == NULL) {
-            _Z_RETURN_IF_ERR(_z_link_send_wbuf(ztc->_link, &ztc->_wbuf, NULL));
-        } else {
-            _z_transport_peer_unicast_slist_t *curr_list = peers;
-            while (curr_list != NULL) {
-                _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
-                // Send on peer socket
-                _z_link_send_wbuf(ztc->_link, &ztc->_wbuf, &curr_peer->_socket);
-                curr_list = _z_transport_peer_unicast_slist_next(curr_list);
-            }
-        }
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+        z_result_t ret = gather ? _z_transport_tx_gather_fragment(ztc, frag_buff, reliability, sn, is_first, peers)
+                                : _z_transport_tx_copy_fragment(ztc, frag_buff, reliability, sn, is_first, peers);
+#else
+        z_result_t ret = _z_transport_tx_copy_fragment(ztc, frag_buff, reliability, sn, is_first, peers);
+#endif
+        _Z_RETURN_IF_ERR(ret);
         ztc->_transmitted = true;  // Tell session we transmitted data
         is_first = false;
     }
@@ -106,8 +241,10 @@ static z_result_t _z_transport_tx_send_fragment(_z_transport_common_t *ztc, cons
                                                 _z_transport_peer_unicast_slist_t *peers) {
     // Create an expandable wbuf for fragmentation
     _z_wbuf_t frag_buff = _z_wbuf_make(_Z_FRAG_BUFF_BASE_SIZE, true);
+    // Encode message on temp buffer, payload slices are referenced and only copied once into the fragments
+    z_result_t ret = _z_network_message_encode(&frag_buff, n_msg);
     // Send message as fragments
-    z_result_t ret = _z_transport_tx_send_fragment_inner(ztc, &frag_buff, n_msg, reliability, first_sn, peers);
+    _Z_SET_IF_OK(ret, _z_transport_tx_send_fragment_inner(ztc, &frag_buff, reliability, first_sn, peers));
     // Clear the buffer as it's no longer required
     _z_wbuf_clear(&frag_buff);
     return ret;
@@ -127,17 +264,7 @@ static z_result_t _z_transport_tx_send_fragment(_z_transport_common_t *ztc, cons
 }
 #endif
 
-static inline bool _z_transport_tx_batch_has_data(_z_transport_common_t *ztc) {
-#if Z_FEATURE_BATCHING == 1
-    return (ztc->_batch_state == _Z_BATCHING_ACTIVE) && (ztc->_batch_count > 0);
-#else
-    _ZP_UNUSED(ztc);
-    return false;
-#endif
-}
-
-static z_result_t _z_transport_tx_flush_buffer(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
-    __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+static z_result_t _z_transport_tx_send_buffer(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
     // Send network message
     if (peers == NULL) {
         _Z_RETURN_IF_ERR(_z_link_send_wbuf(ztc->_link, &ztc->_wbuf, NULL));
@@ -151,114 +278,190 @@ static z_result_t _z_transport_tx_flush_buffer(_z_transport_common_t *ztc, _z_tr
         }
     }
     ztc->_transmitted = true;  // Tell session we transmitted data
-#if Z_FEATURE_BATCHING == 1
-    ztc->_batch_count = 0;
-#endif
     return _Z_RES_OK;
 }
 
-static z_result_t _z_transport_tx_flush_or_incr_batch(_z_transport_common_t *ztc,
-                                                      _z_transport_peer_unicast_slist_t *peers) {
+static z_result_t _z_transport_tx_flush_buffer(_z_transport_common_t *ztc, _z_transport_peer_unicast_slist_t *peers) {
+    __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+    return _z_transport_tx_send_buffer(ztc, peers);
+}
+
+static z_result_t _z_transport_tx_flush_frame(_z_transport_common_t *ztc, z_reliability_t reliability, _z_zint_t sn,
+                                              _z_transport_peer_unicast_slist_t *peers) {
+    __unsafe_z_finalize_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+    _z_transport_tx_retx_store(ztc, reliability, sn);
+    return _z_transport_tx_send_buffer(ztc, peers);
+}
+
+#if Z_FEATURE_BATCHING == 1 || defined(_Z_TX_QUEUE)
+// Room left for network messages in a frame of the tx buffer
+static size_t _z_transport_tx_frame_capacity(const _z_transport_common_t *ztc) {
+    // Leave room for the length prefix and the frame header
+    size_t reserved = (size_t)1 + _z_zint_len(ztc->_sn_res);
+    if (ztc->_link->_cap._flow == Z_LINK_CAP_FLOW_STREAM) {
+        reserved += _Z_MSG_LEN_ENC_SIZE;
+    }
+    return _z_wbuf_capacity(&ztc->_wbuf) - reserved;
+}
+#endif
+
 #if Z_FEATURE_BATCHING == 1
-    if (ztc->_batch_state == _Z_BATCHING_ACTIVE) {
-        // Increment batch count
-        ztc->_batch_count++;
+static inline z_priority_t _z_transport_tx_get_priority(const _z_network_message_t *msg) {
+    switch (msg->_tag) {
+        case _Z_N_DECLARE:
+            return _z_n_qos_get_priority(msg->_body._declare._ext_qos);
+        case _Z_N_PUSH:
+            return _z_n_qos_get_priority(msg->_body._push._qos);
+        case _Z_N_REQUEST:
+            return _z_n_qos_get_priority(msg->_body._request._ext_qos);
+        case _Z_N_RESPONSE:
+            return _z_n_qos_get_priority(msg->_body._response._ext_qos);
+        default:
+            return Z_PRIORITY_DEFAULT;
+    }
+}
+
+static z_result_t _z_transport_tx_lane_init(_z_transport_common_t *ztc, _z_transport_tx_lane_t *lane) {
+    if (_z_wbuf_capacity(&lane->_wbuf) > 0) {
         return _Z_RES_OK;
-    } else {
-        return _z_transport_tx_flush_buffer(ztc, peers);
     }
-#else
-    return _z_transport_tx_flush_buffer(ztc, peers);
-#endif
+    // Frame header is added on flush
+    size_t capacity = _z_transport_tx_frame_capacity(ztc);
+    lane->_wbuf = _z_wbuf_make(capacity, false);
+    if (_z_wbuf_capacity(&lane->_wbuf) != capacity) {
+        _z_wbuf_clear(&lane->_wbuf);
+        _Z_ERROR("Not enough memory to allocate transport batch lane");
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
 }
 
-static z_result_t _z_transport_tx_batch_overflow(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
-                                                 z_reliability_t reliability, _z_zint_t sn, size_t prev_wpos,
-                                                 _z_transport_peer_unicast_slist_t *peers) {
-#if Z_FEATURE_BATCHING == 1
-    // Remove partially encoded data
-    _z_wbuf_set_wpos(&ztc->_wbuf, prev_wpos);
-    // Send batch
-    _Z_RETURN_IF_ERR(_z_transport_tx_flush_buffer(ztc, peers));
-    // Init buffer
+static z_result_t _z_transport_tx_flush_lane(_z_transport_common_t *ztc, _z_transport_tx_lane_t *lane,
+                                             _z_transport_peer_unicast_slist_t *peers) {
+    if (lane->_count == 0) {
+        return _Z_RES_OK;
+    }
+    // SN is taken on flush so that it follows the order frames are sent in
     __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
-    sn = _z_transport_tx_get_sn(ztc, reliability);
+    z_reliability_t reliability = lane->_reliability;
+    _z_zint_t sn = _z_transport_tx_get_sn(ztc, reliability);
     _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, reliability);
-    _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &t_msg));
-    // Retry encode
-    z_result_t ret = _z_network_message_encode(&ztc->_wbuf, n_msg);
+    z_result_t ret = _z_transport_message_encode(&ztc->_wbuf, &t_msg);
+    _Z_SET_IF_OK(ret, _z_wbuf_siphon(&ztc->_wbuf, &lane->_wbuf, _z_wbuf_len(&lane->_wbuf)));
+    // Lane content is consumed whatever the outcome
+    ztc->_batch_count -= lane->_count;
+    lane->_count = 0;
+    _z_wbuf_reset(&lane->_wbuf);
+    _Z_SET_IF_OK(ret, _z_transport_tx_flush_frame(ztc, reliability, sn, peers));
+#if Z_FEATURE_SHM == 1
+    // Handles sent with the frame are now the peer's to give back
     if (ret != _Z_RES_OK) {
-        // Message still doesn't fit in buffer, send as fragments
+        _z_shm_chunk_refs_release(&lane->_shm_refs);
+    }
+    _z_shm_chunk_ref_svec_reset(&lane->_shm_refs);
+#endif
+    return ret;
+}
+
+// Drain lanes up to the given priority, highest priority first
+static z_result_t _z_transport_tx_flush_lanes(_z_transport_common_t *ztc, z_priority_t max_priority,
+                                              _z_transport_peer_unicast_slist_t *peers) {
+    for (uint8_t i = 0; i <= (uint8_t)max_priority; i++) {
+        _Z_RETURN_IF_ERR(_z_transport_tx_flush_lane(ztc, &ztc->_batch_lanes[i], peers));
+    }
+    return _Z_RES_OK;
+}
+
+static z_result_t _z_transport_tx_batch_n_msg(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
+                                              z_reliability_t reliability, _z_transport_peer_unicast_slist_t *peers) {
+    z_priority_t priority = _z_transport_tx_get_priority(n_msg);
+    _z_transport_tx_lane_t *lane = &ztc->_batch_lanes[priority];
+    _Z_RETURN_IF_ERR(_z_transport_tx_lane_init(ztc, lane));
+    // A frame carries a single reliability
+    if ((lane->_count > 0) && (lane->_reliability != reliability)) {
+        _Z_RETURN_IF_ERR(_z_transport_tx_flush_lane(ztc, lane, peers));
+    }
+    // Try encoding the network message
+    size_t prev_wpos = _z_wbuf_get_wpos(&lane->_wbuf);
+    z_result_t ret = _z_network_message_encode(&lane->_wbuf, n_msg);
+    if ((ret != _Z_RES_OK) && (lane->_count > 0)) {
+        // Lane is too full for message, remove partially encoded data, send it and retry
+        _z_wbuf_set_wpos(&lane->_wbuf, prev_wpos);
+        _Z_RETURN_IF_ERR(_z_transport_tx_flush_lane(ztc, lane, peers));
+        ret = _z_network_message_encode(&lane->_wbuf, n_msg);
+    }
+    if (ret != _Z_RES_OK) {
+        // Message doesn't fit in a batch, send pending higher priority traffic first then the fragments
+        _z_wbuf_reset(&lane->_wbuf);
+        _Z_RETURN_IF_ERR(_z_transport_tx_flush_lanes(ztc, priority, peers));
+        _z_zint_t sn = _z_transport_tx_get_sn(ztc, reliability);
         return _z_transport_tx_send_fragment(ztc, n_msg, reliability, sn, peers);
-    } else {
-        if (_z_transport_tx_get_express_status(n_msg)) {
-            // Send immediately
-            return _z_transport_tx_flush_buffer(ztc, peers);
-        } else {
-            // Increment batch
-            ztc->_batch_count++;
+    }
+    lane->_reliability = reliability;
+    lane->_count++;
+    ztc->_batch_count++;
+#if Z_FEATURE_SHM == 1
+    const _z_shm_chunk_ref_t *handle = _z_transport_tx_shm_handle(n_msg);
+    if (handle != NULL) {
+        _z_shm_chunk_ref_t ref;
+        _z_shm_chunk_ref_copy(&ref, handle);
+        // Without it the handle is only given back with the peer if the batch is lost
+        if (_z_shm_chunk_ref_svec_append(&lane->_shm_refs, &ref, false) != _Z_RES_OK) {
+            _z_shm_chunk_ref_clear(&ref);
         }
     }
-    return _Z_RES_OK;
-#else
-    _ZP_UNUSED(ztc);
-    _ZP_UNUSED(n_msg);
-    _ZP_UNUSED(reliability);
-    _ZP_UNUSED(sn);
-    _ZP_UNUSED(prev_wpos);
-    _ZP_UNUSED(peers);
-    return _Z_RES_OK;
 #endif
+    if (_z_transport_tx_get_express_status(n_msg)) {
+        // Send immediately
+        return _z_transport_tx_flush_lanes(ztc, Z_PRIORITY_BACKGROUND, peers);
+    }
+    return _Z_RES_OK;
 }
+#endif
 
-static inline size_t _z_transport_tx_save_wpos(_z_wbuf_t *wbuf) {
+static inline z_result_t _z_transport_tx_flush_batch(_z_transport_common_t *ztc,
+                                                     _z_transport_peer_unicast_slist_t *peers) {
 #if Z_FEATURE_BATCHING == 1
-    return _z_wbuf_get_wpos(wbuf);
+    if (ztc->_batch_count > 0) {
+        return _z_transport_tx_flush_lanes(ztc, Z_PRIORITY_BACKGROUND, peers);
+    }
+    return _Z_RES_OK;
 #else
-    _ZP_UNUSED(wbuf);
-    return 0;
+    _ZP_UNUSED(ztc);
+    _ZP_UNUSED(peers);
+    return _Z_RES_OK;
 #endif
 }
 
 static z_result_t _z_transport_tx_send_n_msg_inner(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
                                                    z_reliability_t reliability,
                                                    _z_transport_peer_unicast_slist_t *peers) {
-    // Init buffer
-    _z_zint_t sn = 0;
-    bool batch_has_data = _z_transport_tx_batch_has_data(ztc);
-    if (!batch_has_data) {
-        __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
-        sn = _z_transport_tx_get_sn(ztc, reliability);
-        _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, reliability);
-        _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &t_msg));
+#if Z_FEATURE_BATCHING == 1
+    if (ztc->_batch_state == _Z_BATCHING_ACTIVE) {
+        return _z_transport_tx_batch_n_msg(ztc, n_msg, reliability, peers);
     }
+#endif
+    // Send pending batch first to keep ordering
+    _Z_RETURN_IF_ERR(_z_transport_tx_flush_batch(ztc, peers));
+    // Init buffer
+    __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+    _z_zint_t sn = _z_transport_tx_get_sn(ztc, reliability);
+    _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, reliability);
+    _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, &t_msg));
     // Try encoding the network message
-    size_t prev_wpos = _z_transport_tx_save_wpos(&ztc->_wbuf);
     z_result_t ret = _z_network_message_encode(&ztc->_wbuf, n_msg);
     if (ret == _Z_RES_OK) {
-        if (_z_transport_tx_get_express_status(n_msg)) {
-            // Send immediately
-            return _z_transport_tx_flush_buffer(ztc, peers);
-        } else {
-            // Flush buffer or increase batch
-            return _z_transport_tx_flush_or_incr_batch(ztc, peers);
-        }
-    } else if (!batch_has_data) {
+        return _z_transport_tx_flush_frame(ztc, reliability, sn, peers);
+    } else {
         // Message doesn't fit in buffer, send as fragments
         return _z_transport_tx_send_fragment(ztc, n_msg, reliability, sn, peers);
-    } else {
-        // Buffer is too full for message
-        return _z_transport_tx_batch_overflow(ztc, n_msg, reliability, sn, prev_wpos, peers);
     }
 }
 
 static z_result_t _z_transport_tx_send_t_msg_inner(_z_transport_common_t *ztc, const _z_transport_message_t *t_msg,
                                                    _z_transport_peer_unicast_slist_t *peers) {
     // Send batch if needed
-    bool batch_has_data = _z_transport_tx_batch_has_data(ztc);
-    if (batch_has_data) {
-        _Z_RETURN_IF_ERR(_z_transport_tx_flush_buffer(ztc, peers));
-    }
+    _Z_RETURN_IF_ERR(_z_transport_tx_flush_batch(ztc, peers));
     // Encode transport message
     __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
     _Z_RETURN_IF_ERR(_z_transport_message_encode(&ztc->_wbuf, t_msg));
@@ -270,6 +473,10 @@ z_result_t _z_transport_tx_send_t_msg(_z_transport_common_t *ztc, const _z_trans
                                       _z_transport_peer_unicast_slist_t *peers) {
     z_result_t ret = _Z_RES_OK;
     _Z_DEBUG("Send session message");
+#if defined(_Z_TX_QUEUE)
+    // Messages queued before, like the last puts before a close, go out first
+    _Z_RETURN_IF_ERR(_z_transport_tx_queue_drain(ztc, Z_CONGESTION_CONTROL_BLOCK));
+#endif
     // If sending to a peer list, make sure the peer mutex is locked
     _z_transport_tx_mutex_lock(ztc, true);
 
@@ -283,11 +490,349 @@ z_result_t _z_transport_tx_send_t_msg_wrapper(_z_transport_common_t *ztc, const
     return _z_transport_tx_send_t_msg(ztc, t_msg, NULL);
 }
 
+#if defined(_Z_TX_QUEUE)
+/*------------------ Transmission queue ------------------*/
+// Copies the encoded message in the free space of the ring, or in a buffer sized to it if it doesn't fit
+static z_result_t _z_transport_tx_queue_store(_z_transport_tx_queue_t *txq, _z_transport_tx_queue_entry_t *entry,
+                                              _z_wbuf_t *src) {
+    size_t len = _z_wbuf_len(src);
+    entry->_len = len;
+    if (len <= Z_TX_QUEUE_BUFFER_SIZE - txq->_ring_len) {
+        entry->_offset = (txq->_ring_start + txq->_ring_len) % Z_TX_QUEUE_BUFFER_SIZE;
+        size_t first = Z_TX_QUEUE_BUFFER_SIZE - entry->_offset;
+        first = (len < first) ? len : first;
+        // Buffers that don't expand are a single slice
+        const uint8_t *bytes = _z_wbuf_get_iosli(src, 0)->_buf;
+        memcpy(&txq->_ring[entry->_offset], bytes, first);
+        memcpy(txq->_ring, bytes + first, len - first);
+        txq->_ring_len += len;
+        return _Z_RES_OK;
+    }
+    entry->_wbuf = _z_wbuf_make(len, false);
+    if (_z_wbuf_capacity(&entry->_wbuf) != len) {
+        _z_wbuf_clear(&entry->_wbuf);
+        _Z_ERROR("Not enough memory to allocate transport tx queue entry");
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _z_wbuf_siphon(&entry->_wbuf, src, len);
+}
+
+// Encodes the message in a queue entry, a message larger than a frame gets a buffer of its own to be fragmented
+static z_result_t _z_transport_tx_queue_encode(_z_transport_common_t *ztc, _z_transport_tx_queue_entry_t *entry,
+                                               const _z_network_message_t *n_msg) {
+    _z_transport_tx_queue_t *txq = ztc->_tx_queue;
+    size_t capacity = _z_transport_tx_frame_capacity(ztc);
+    if (_z_wbuf_capacity(&txq->_scratch) != capacity) {
+        _z_wbuf_clear(&txq->_scratch);
+        txq->_scratch = _z_wbuf_make(capacity, false);
+        if (_z_wbuf_capacity(&txq->_scratch) != capacity) {
+            _z_wbuf_clear(&txq->_scratch);
+            _Z_ERROR("Not enough memory to allocate transport tx queue buffer");
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+    }
+    _z_wbuf_reset(&txq->_scratch);
+    if (_z_network_message_encode(&txq->_scratch, n_msg) == _Z_RES_OK) {
+        return _z_transport_tx_queue_store(txq, entry, &txq->_scratch);
+    }
+#if Z_FEATURE_FRAGMENTATION == 1
+    // An expandable buffer only references large payloads, they are copied as the sender may drop them on return
+    _z_wbuf_t frag_buff = _z_wbuf_make(_Z_FRAG_BUFF_BASE_SIZE, true);
+    z_result_t ret = _z_network_message_encode(&frag_buff, n_msg);
+    if (ret == _Z_RES_OK) {
+        size_t len = _z_wbuf_len(&frag_buff);
+        entry->_len = len;
+        entry->_wbuf = _z_wbuf_make(len, false);
+        if (_z_wbuf_capacity(&entry->_wbuf) != len) {
+            _z_wbuf_clear(&entry->_wbuf);
+            _Z_ERROR_LOG(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+        } else {
+            ret = _z_wbuf_siphon(&entry->_wbuf, &frag_buff, len);
+        }
+    }
+    _z_wbuf_clear(&frag_buff);
+    return ret;
+#else
+    _Z_INFO("Sending the message required fragmentation feature that is deactivated.");
+    _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NO_SPACE);
+#endif
+}
+
+// Appends the queued message to the frame being written
+static z_result_t _z_transport_tx_queue_write(_z_transport_common_t *ztc, _z_transport_tx_queue_entry_t *entry) {
+    if (_z_wbuf_capacity(&entry->_wbuf) > 0) {
+        return _z_wbuf_siphon(&ztc->_wbuf, &entry->_wbuf, entry->_len);
+    }
+    const uint8_t *ring = ztc->_tx_queue->_ring;
+    size_t first = Z_TX_QUEUE_BUFFER_SIZE - entry->_offset;
+    first = (entry->_len < first) ? entry->_len : first;
+    _Z_RETURN_IF_ERR(_z_wbuf_write_bytes(&ztc->_wbuf, ring, entry->_offset, first));
+    return _z_wbuf_write_bytes(&ztc->_wbuf, ring, 0, entry->_len - first);
+}
+
+// Gives back the ring bytes or the buffer of messages the writer is done with, the first written ones were sent
+static void _z_transport_tx_queue_release(_z_transport_tx_queue_t *txq, size_t head, size_t nb, size_t written) {
+    for (size_t i = 0; i < nb; i++) {
+        _z_transport_tx_queue_entry_t *entry = &txq->_entries[(head + i) % Z_TX_QUEUE_SIZE];
+#if Z_FEATURE_SHM == 1
+        if (entry->_shm_ref._segment._cnt != NULL) {
+            if (i >= written) {
+                _z_shm_chunk_ref_release(&entry->_shm_ref);
+            }
+            _z_shm_chunk_ref_clear(&entry->_shm_ref);
+        }
+#else
+        _ZP_UNUSED(written);
+#endif
+        if (_z_wbuf_capacity(&entry->_wbuf) > 0) {
+            _z_wbuf_clear(&entry->_wbuf);
+        } else {
+            txq->_ring_start = (txq->_ring_start + entry->_len) % Z_TX_QUEUE_BUFFER_SIZE;
+            txq->_ring_len -= entry->_len;
+        }
+    }
+}
+
+static z_result_t _z_transport_tx_queue_push(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
+                                             z_reliability_t reliability, z_congestion_control_t cong_ctrl) {
+    _z_transport_tx_queue_t *txq = ztc->_tx_queue;
+    _z_mutex_lock(&txq->_mutex);
+    if ((txq->_len == Z_TX_QUEUE_SIZE) && (cong_ctrl == Z_CONGESTION_CONTROL_BLOCK)) {
+        z_clock_t deadline = z_clock_now();
+        z_clock_advance_ms(&deadline, Z_TX_QUEUE_BLOCK_TIMEOUT_MS);
+        while (txq->_running && (txq->_len == Z_TX_QUEUE_SIZE)) {
+            if (_z_condvar_wait_until(&txq->_cv_sent, &txq->_mutex, &deadline) != _Z_RES_OK) {
+                break;
+            }
+        }
+    }
+    if (!txq->_running || (txq->_len == Z_TX_QUEUE_SIZE)) {
+        txq->_dropped++;
+        _z_mutex_unlock(&txq->_mutex);
+        _Z_INFO("Dropping zenoh message because of congestion control");
+        _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+    }
+    _z_transport_tx_queue_entry_t *entry = &txq->_entries[(txq->_head + txq->_len) % Z_TX_QUEUE_SIZE];
+    z_result_t ret = _z_transport_tx_queue_encode(ztc, entry, n_msg);
+    if (ret == _Z_RES_OK) {
+        entry->_reliability = reliability;
+        entry->_express = _z_transport_tx_get_express_status(n_msg);
+#if Z_FEATURE_SHM == 1
+        const _z_shm_chunk_ref_t *handle = _z_transport_tx_shm_handle(n_msg);
+        if (handle != NULL) {
+            _z_shm_chunk_ref_copy(&entry->_shm_ref, handle);
+        }
+#endif
+        txq->_len++;
+        _z_condvar_signal(&txq->_cv_queued);
+    }
+    _z_mutex_unlock(&txq->_mutex);
+    return ret;
+}
+
+// Sends nb queued messages from head, batching consecutive ones of the same reliability in frames. Returns the number
+// of messages written before the first failure.
+static size_t _z_transport_tx_queue_send(_z_transport_common_t *ztc, size_t head, size_t nb) {
+    _z_transport_tx_queue_t *txq = ztc->_tx_queue;
+    bool in_frame = false;
+    z_reliability_t reliability = Z_RELIABILITY_RELIABLE;
+    _z_zint_t sn = 0;
+    z_result_t ret = _Z_RES_OK;
+    size_t written = 0;
+    for (size_t i = 0; i < nb; i++) {
+        _z_transport_tx_queue_entry_t *entry = &txq->_entries[(head + i) % Z_TX_QUEUE_SIZE];
+        size_t len = entry->_len;
+        if (in_frame && ((entry->_reliability != reliability) || (len > _z_wbuf_space_left(&ztc->_wbuf)))) {
+            _Z_SET_IF_OK(ret, _z_transport_tx_flush_frame(ztc, reliability, sn, NULL));
+            written = (ret == _Z_RES_OK) ? i : written;
+            in_frame = false;
+        }
+        if (len > _z_transport_tx_frame_capacity(ztc)) {
+#if Z_FEATURE_FRAGMENTATION == 1
+            sn = _z_transport_tx_get_sn(ztc, entry->_reliability);
+            _Z_SET_IF_OK(ret, _z_transport_tx_send_fragment_inner(ztc, &entry->_wbuf, entry->_reliability, sn, NULL));
+            written = (ret == _Z_RES_OK) ? i + 1 : written;
+#endif
+            continue;
+        }
+        if (!in_frame) {
+            reliability = entry->_reliability;
+            __unsafe_z_prepare_wbuf(&ztc->_wbuf, ztc->_link->_cap._flow);
+            sn = _z_transport_tx_get_sn(ztc, reliability);
+            _z_transport_message_t t_msg = _z_t_msg_make_frame_header(sn, reliability);
+            _Z_SET_IF_OK(ret, _z_transport_message_encode(&ztc->_wbuf, &t_msg));
+            in_frame = true;
+        }
+        _Z_SET_IF_OK(ret, _z_transport_tx_queue_write(ztc, entry));
+        if (entry->_express) {
+            _Z_SET_IF_OK(ret, _z_transport_tx_flush_frame(ztc, reliability, sn, NULL));
+            written = (ret == _Z_RES_OK) ? i + 1 : written;
+            in_frame = false;
+        }
+    }
+    if (in_frame) {
+        _Z_SET_IF_OK(ret, _z_transport_tx_flush_frame(ztc, reliability, sn, NULL));
+        written = (ret == _Z_RES_OK) ? nb : written;
+    }
+    if (ret != _Z_RES_OK) {
+        _Z_INFO("Failed to send queued messages with err %d", ret);
+    }
+    return written;
+}
+
+static void *_z_transport_tx_queue_task(void *ztc_arg) {
+    _z_transport_common_t *ztc = (_z_transport_common_t *)ztc_arg;
+    _z_transport_tx_queue_t *txq = ztc->_tx_queue;
+    _z_mutex_lock(&txq->_mutex);
+    while (txq->_running) {
+        if (txq->_len == 0) {
+            _z_condvar_wait(&txq->_cv_queued, &txq->_mutex);
+            continue;
+        }
+        // Senders only write past the queued messages, those are sent without holding the queue
+        size_t head = txq->_head;
+        size_t nb = txq->_len;
+        _z_mutex_unlock(&txq->_mutex);
+        _z_transport_tx_mutex_lock(ztc, true);
+        size_t written = _z_transport_tx_queue_send(ztc, head, nb);
+        _z_transport_tx_mutex_unlock(ztc);
+        _z_mutex_lock(&txq->_mutex);
+        _z_transport_tx_queue_release(txq, head, nb, written);
+        txq->_head = (head + nb) % Z_TX_QUEUE_SIZE;
+        txq->_len -= nb;
+        _z_condvar_signal_all(&txq->_cv_sent);
+    }
+    // Messages still queued are dropped
+    _z_transport_tx_queue_release(txq, txq->_head, txq->_len, 0);
+    txq->_dropped += txq->_len;
+    txq->_head = (txq->_head + txq->_len) % Z_TX_QUEUE_SIZE;
+    txq->_len = 0;
+    _z_condvar_signal_all(&txq->_cv_sent);
+    _z_mutex_unlock(&txq->_mutex);
+    return NULL;
+}
+
+z_result_t _z_transport_tx_queue_start(_z_transport_common_t *ztc, z_task_attr_t *attr) {
+    _z_transport_tx_queue_t *txq = (_z_transport_tx_queue_t *)z_malloc(sizeof(_z_transport_tx_queue_t));
+    if (txq == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    memset(txq, 0, sizeof(_z_transport_tx_queue_t));
+    for (size_t i = 0; i < Z_TX_QUEUE_SIZE; i++) {
+        txq->_entries[i]._wbuf = _z_wbuf_null();
+    }
+    txq->_scratch = _z_wbuf_null();
+    txq->_ring = (uint8_t *)z_malloc(Z_TX_QUEUE_BUFFER_SIZE);
+    txq->_task = (_z_task_t *)z_malloc(sizeof(_z_task_t));
+    z_result_t ret = ((txq->_task != NULL) && (txq->_ring != NULL)) ? _Z_RES_OK : _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+    _Z_SET_IF_OK(ret, _z_mutex_init(&txq->_mutex));
+    _Z_SET_IF_OK(ret, _z_condvar_init(&txq->_cv_queued));
+    _Z_SET_IF_OK(ret, _z_condvar_init(&txq->_cv_sent));
+    if (ret == _Z_RES_OK) {
+        txq->_running = true;
+        ztc->_tx_queue = txq;
+        if (_z_task_init(txq->_task, attr, _z_transport_tx_queue_task, ztc) != _Z_RES_OK) {
+            ztc->_tx_queue = NULL;
+            _z_condvar_drop(&txq->_cv_sent);
+            _z_condvar_drop(&txq->_cv_queued);
+            _z_mutex_drop(&txq->_mutex);
+            ret = _Z_ERR_SYSTEM_TASK_FAILED;
+        }
+    }
+    if (ret != _Z_RES_OK) {
+        z_free(txq->_task);
+        z_free(txq->_ring);
+        z_free(txq);
+        _Z_ERROR_RETURN(ret);
+    }
+    return _Z_RES_OK;
+}
+
+void _z_transport_tx_queue_stop(_z_transport_common_t *ztc) {
+    _z_transport_tx_queue_t *txq = ztc->_tx_queue;
+    if (txq == NULL) {
+        return;
+    }
+    _z_mutex_lock(&txq->_mutex);
+    txq->_running = false;
+    _z_condvar_signal_all(&txq->_cv_queued);
+    _z_mutex_unlock(&txq->_mutex);
+    // The writer never clears its own transport, it can always be joined
+    _z_task_join(txq->_task);
+    _z_task_free(&txq->_task);
+    _z_wbuf_clear(&txq->_scratch);
+    z_free(txq->_ring);
+    _z_condvar_drop(&txq->_cv_sent);
+    _z_condvar_drop(&txq->_cv_queued);
+    _z_mutex_drop(&txq->_mutex);
+    z_free(txq);
+    ztc->_tx_queue = NULL;
+}
+
+z_result_t _z_transport_tx_queue_drain(_z_transport_common_t *ztc, z_congestion_control_t cong_ctrl) {
+    _z_transport_tx_queue_t *txq = ztc->_tx_queue;
+    if (txq == NULL) {
+        return _Z_RES_OK;
+    }
+    _z_mutex_lock(&txq->_mutex);
+    z_clock_t deadline = z_clock_now();
+    z_clock_advance_ms(&deadline, Z_TX_QUEUE_BLOCK_TIMEOUT_MS);
+    while (txq->_len > 0) {
+        if (_z_condvar_wait_until(&txq->_cv_sent, &txq->_mutex, &deadline) != _Z_RES_OK) {
+            break;
+        }
+    }
+    bool drained = (txq->_len == 0);
+    if (!drained && (cong_ctrl == Z_CONGESTION_CONTROL_DROP)) {
+        txq->_dropped++;
+    }
+    _z_mutex_unlock(&txq->_mutex);
+    if (drained) {
+        return _Z_RES_OK;
+    }
+    if (cong_ctrl == Z_CONGESTION_CONTROL_DROP) {
+        _Z_INFO("Dropping zenoh message because of congestion control");
+    } else {
+        _Z_ERROR("Tx queue writer stalled for %ums, message not sent", (unsigned)Z_TX_QUEUE_BLOCK_TIMEOUT_MS);
+    }
+    _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_TX_FAILED);
+}
+
+void _z_transport_tx_queue_stats(_z_transport_common_t *ztc, size_t *depth, uint64_t *dropped) {
+    _z_transport_tx_queue_t *txq = ztc->_tx_queue;
+    _z_mutex_lock(&txq->_mutex);
+    *depth = txq->_len;
+    *dropped = txq->_dropped;
+    _z_mutex_unlock(&txq->_mutex);
+}
+
+static inline bool _z_transport_tx_queue_accepts(const _z_transport_common_t *ztc,
+                                                 const _z_transport_peer_unicast_slist_t *peers) {
+#if Z_FEATURE_BATCHING == 1
+    // A batch is sent by the thread that fills it
+    if (ztc->_batch_state == _Z_BATCHING_ACTIVE) {
+        return false;
+    }
+#endif
+    // Messages for a list of unicast peers are sent from the calling thread, which holds the peers meanwhile, so the
+    // queue only carries the messages of client and multicast transports
+    return (ztc->_tx_queue != NULL) && (peers == NULL);
+}
+#endif
+
 static z_result_t _z_transport_tx_send_n_msg(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
                                              z_reliability_t reliability, z_congestion_control_t cong_ctrl,
                                              _z_transport_peer_unicast_slist_t *peers) {
     z_result_t ret = _Z_RES_OK;
     _Z_DEBUG("Send network message");
+#if defined(_Z_TX_QUEUE)
+    if (_z_transport_tx_queue_accepts(ztc, peers)) {
+        return _z_transport_tx_queue_push(ztc, n_msg, reliability, cong_ctrl);
+    }
+    // Messages sent from this thread go after those already queued
+    _Z_RETURN_IF_ERR(_z_transport_tx_queue_drain(ztc, cong_ctrl));
+#endif
 
     // Acquire the lock and drop the message if needed
     if (!_z_transport_batch_hold_tx_mutex()) {
@@ -305,6 +850,11 @@ static z_result_t _z_transport_tx_send_n_msg(_z_transport_common_t *ztc, const _
     return ret;
 }
 
+z_result_t _z_transport_tx_send_n_msg_wrapper(_z_transport_common_t *ztc, const _z_network_message_t *n_msg,
+                                              z_reliability_t reliability, z_congestion_control_t cong_ctrl) {
+    return _z_transport_tx_send_n_msg(ztc, n_msg, reliability, cong_ctrl, NULL);
+}
+
 static z_result_t _z_transport_tx_send_n_batch(_z_transport_common_t *ztc, z_congestion_control_t cong_ctrl,
                                                _z_transport_peer_unicast_slist_t *peers) {
 #if Z_FEATURE_BATCHING == 1
@@ -321,7 +871,7 @@ static z_result_t _z_transport_tx_send_n_batch(_z_transport_common_t *ztc, z_con
         }
         // Send batch
         _Z_DEBUG("Send network batch");
-        ret = _z_transport_tx_flush_buffer(ztc, peers);
+        ret = _z_transport_tx_flush_batch(ztc, peers);
         if (!_z_transport_batch_hold_tx_mutex()) {
             _z_transport_tx_mutex_unlock(ztc);
         }
@@ -462,8 +1012,7 @@ z_result_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z
     do {
         size_t w_pos = _z_wbuf_get_wpos(dst);  // Mark the buffer for the writing operation
 
-        _z_transport_message_t f_hdr =
-            _z_t_msg_make_fragment_header(sn, reliability == Z_RELIABILITY_RELIABLE, is_final, first, false);
+        _z_transport_message_t f_hdr = _z_t_msg_make_fragment_header(sn, reliability, is_final, first, false);
         ret = _z_transport_message_encode(dst, &f_hdr);  // Encode the frame header
         if (ret == _Z_RES_OK) {
             size_t space_left = _z_wbuf_space_left(dst);
@@ -484,8 +1033,108 @@ z_result_t __unsafe_z_serialize_zenoh_fragment(_z_wbuf_t *dst, _z_wbuf_t *src, z
     return ret;
 }
 
-z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *z_msg, z_reliability_t reliability,
-                         z_congestion_control_t cong_ctrl, void *peer) {
+#if Z_FEATURE_SHM == 1
+// Sends a put by reference to its chunk to a single peer with a handle of its own, the ledger of the peer gives it
+// back if the peer goes away still holding it
+static z_result_t _z_send_n_msg_shm_ref(_z_transport_common_t *ztc, const _z_network_message_t *z_msg,
+                                        const _z_shm_chunk_ref_t *chunk, z_reliability_t reliability,
+                                        z_congestion_control_t cong_ctrl, const _z_transport_peer_unicast_t *peer,
+                                        _z_transport_peer_unicast_slist_t *dst) {
+    _z_shm_chunk_ref_t handle;
+    if (_z_shm_chunk_ref_take(chunk, &handle) != _Z_RES_OK) {
+        _Z_DEBUG("No free shared memory handle, copying the payload");
+        return _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl, dst);
+    }
+    _z_network_message_t shm_msg = *z_msg;
+    _z_msg_put_t *put = &shm_msg._body._push._body._body._put;
+    z_result_t ret = _z_shm_bytes_to_info(&z_msg->_body._push._body._body._put._payload, &handle, &put->_payload);
+    if (ret == _Z_RES_OK) {
+        put->_is_shm = true;
+        ret = _z_shm_ledger_add(peer->common._shm_ledger, &handle);
+        // A message batched or queued holds the handle until it is written
+        _Z_SET_IF_OK(ret, _z_transport_tx_send_n_msg(ztc, &shm_msg, reliability, cong_ctrl, dst));
+        _z_bytes_drop(&put->_payload);
+    }
+    if (ret != _Z_RES_OK) {
+        _z_shm_chunk_ref_release(&handle);
+    }
+    _z_shm_chunk_ref_clear(&handle);
+    return ret;
+}
+
+// Sends a put of a shared memory payload by reference to the peers of this host and by copy to the others
+static z_result_t _z_send_n_msg_shm(_z_transport_common_t *ztc, const _z_network_message_t *z_msg,
+                                    const _z_shm_chunk_ref_t *chunk, z_reliability_t reliability,
+                                    z_congestion_control_t cong_ctrl, _z_transport_peer_unicast_slist_t *peers,
+                                    bool is_client) {
+    uint32_t shm_nb = 0;
+    uint32_t nb = 0;
+    for (_z_transport_peer_unicast_slist_t *l = peers; l != NULL; l = _z_transport_peer_unicast_slist_next(l)) {
+        nb++;
+        shm_nb += (_z_transport_peer_unicast_slist_value(l)->common._shm_ledger != NULL) ? 1 : 0;
+    }
+    _z_transport_peer_unicast_slist_t *dst = is_client ? NULL : peers;
+    if (shm_nb == 0) {
+        return _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl, dst);
+    }
+    if (nb == 1) {
+        return _z_send_n_msg_shm_ref(ztc, z_msg, chunk, reliability, cong_ctrl,
+                                     _z_transport_peer_unicast_slist_value(peers), dst);
+    }
+#if Z_FEATURE_BATCHING == 1
+    // A batch goes to the peers of the send that flushes it, it can't carry a handle for each of them
+    if (ztc->_batch_state == _Z_BATCHING_ACTIVE) {
+        return _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl, dst);
+    }
+#endif
+    // Each peer of this host gets its own handle, the others share a copy. The lists hold copies of the peers like
+    // single peer sends do.
+    _z_transport_peer_unicast_slist_t *copy_peers = NULL;
+    z_result_t ret = _Z_RES_OK;
+    for (_z_transport_peer_unicast_slist_t *l = peers; l != NULL; l = _z_transport_peer_unicast_slist_next(l)) {
+        const _z_transport_peer_unicast_t *peer = _z_transport_peer_unicast_slist_value(l);
+        bool by_ref = peer->common._shm_ledger != NULL;
+        _z_transport_peer_unicast_slist_t *node = _z_transport_peer_unicast_slist_push_empty(by_ref ? NULL : copy_peers);
+        if (node == NULL) {
+            _Z_ERROR_LOG(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+            ret = _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+            break;
+        }
+        memcpy(_z_transport_peer_unicast_slist_value(node), peer, sizeof(_z_transport_peer_unicast_t));
+        if (by_ref) {
+            z_result_t ref_ret = _z_send_n_msg_shm_ref(ztc, z_msg, chunk, reliability, cong_ctrl, peer, node);
+            ret = (ret == _Z_RES_OK) ? ref_ret : ret;
+            z_free(node);
+        } else {
+            copy_peers = node;
+        }
+    }
+    if (copy_peers != NULL) {
+        z_result_t copy_ret = _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl, copy_peers);
+        ret = (ret == _Z_RES_OK) ? copy_ret : ret;
+    }
+    _z_slist_free(&copy_peers, _z_noop_clear);
+    return ret;
+}
+#endif
+
+// Sends to the peers of a unicast transport, a client sends to its router through the link
+static z_result_t _z_send_n_msg_unicast(_z_transport_common_t *ztc, const _z_network_message_t *z_msg,
+                                        z_reliability_t reliability, z_congestion_control_t cong_ctrl,
+                                        _z_transport_peer_unicast_slist_t *peers, bool is_client) {
+#if Z_FEATURE_SHM == 1
+    if ((z_msg->_tag == _Z_N_PUSH) && z_msg->_body._push._body._is_put) {
+        const _z_shm_chunk_ref_t *chunk = _z_shm_bytes_chunk(&z_msg->_body._push._body._body._put._payload);
+        if (chunk != NULL) {
+            return _z_send_n_msg_shm(ztc, z_msg, chunk, reliability, cong_ctrl, peers, is_client);
+        }
+    }
+#endif
+    return _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl, is_client ? NULL : peers);
+}
+
+static z_result_t _z_send_n_msg_main(_z_session_t *zn, const _z_network_message_t *z_msg, z_reliability_t reliability,
+                                     z_congestion_control_t cong_ctrl, void *peer) {
 #if defined(Z_LOOPBACK_TESTING)
     if (_z_send_n_msg_override != NULL) {
         bool handled = false;
@@ -501,14 +1150,15 @@ z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *z_msg, z_
         case _Z_TRANSPORT_UNICAST_TYPE: {
             _z_transport_common_t *ztc = &zn->_tp._transport._unicast._common;
             if (zn->_mode == Z_WHATAMI_CLIENT) {
-                ret = _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl, NULL);
+                ret = _z_send_n_msg_unicast(ztc, z_msg, reliability, cong_ctrl, zn->_tp._transport._unicast._peers,
+                                            true);
             } else if (!_z_transport_peer_unicast_slist_is_empty(zn->_tp._transport._unicast._peers)) {
                 if (!_z_transport_batch_hold_peer_mutex()) {
                     _z_transport_peer_mutex_lock(ztc);
                 }
                 if (peer == NULL) {
-                    ret = _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl,
-                                                     zn->_tp._transport._unicast._peers);
+                    ret = _z_send_n_msg_unicast(ztc, z_msg, reliability, cong_ctrl,
+                                                zn->_tp._transport._unicast._peers, false);
                 } else {
                     // Send to a single peer, convert to peer list
                     _z_transport_peer_unicast_slist_t *dst_list = _z_transport_peer_unicast_slist_push_empty(NULL);
@@ -516,7 +1166,7 @@ z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *z_msg, z_
                         memcpy(_z_transport_peer_unicast_slist_value(dst_list), (_z_transport_peer_unicast_t *)peer,
                                sizeof(_z_transport_peer_unicast_t));
                         // Send message
-                        ret = _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl, dst_list);
+                        ret = _z_send_n_msg_unicast(ztc, z_msg, reliability, cong_ctrl, dst_list, false);
                         z_free(dst_list);
                     }
                 }
@@ -540,6 +1190,60 @@ z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *z_msg, z_
     return ret;
 }
 
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+static z_result_t _z_send_n_msg_group(_z_transport_t *zt, const _z_network_message_t *z_msg,
+                                      z_reliability_t reliability, z_congestion_control_t cong_ctrl) {
+    // Peers only process frames from a node once they received its join, nobody listens to a group without peers.
+    // Beyond that a group gets all the data: the subscribers of its peers aren't known, multicast declarations are
+    // optional and not replayed to the peers that join later.
+    if (_z_transport_peer_multicast_slist_is_empty(zt->_transport._multicast._peers)) {
+        return _Z_RES_OK;
+    }
+    return _z_transport_tx_send_n_msg(&zt->_transport._multicast._common, z_msg, reliability, cong_ctrl, NULL);
+}
+
+static bool _z_send_n_msg_to_groups(const _z_network_message_t *z_msg) {
+    // A query completes on its first final response while every peer of a group answers one, so they stay on the
+    // main transport
+    return z_msg->_tag != _Z_N_REQUEST || z_msg->_body._request._tag != _Z_REQUEST_QUERY;
+}
+#endif
+
+z_result_t _z_send_n_msg(_z_session_t *zn, const _z_network_message_t *z_msg, z_reliability_t reliability,
+                         z_congestion_control_t cong_ctrl, void *peer) {
+    z_result_t ret = _z_send_n_msg_main(zn, z_msg, reliability, cong_ctrl, peer);
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    // Messages for a given peer are for a main transport peer
+    if ((peer == NULL) && _z_send_n_msg_to_groups(z_msg)) {
+        for (size_t i = 0; i < Z_SESSION_MULTICAST_GROUP_NB; i++) {
+            if (zn->_tp_groups[i]._type == _Z_TRANSPORT_MULTICAST_TYPE) {
+                z_result_t res = _z_send_n_msg_group(&zn->_tp_groups[i], z_msg, reliability, cong_ctrl);
+                ret = (ret == _Z_RES_OK) ? res : ret;
+            }
+        }
+    }
+#endif
+    return ret;
+}
+
+z_result_t _z_send_n_msg_on(_z_session_t *zn, _z_transport_common_t *ztc, const _z_network_message_t *z_msg,
+                            z_reliability_t reliability, z_congestion_control_t cong_ctrl) {
+#if defined(_Z_SESSION_MULTICAST_GROUPS)
+    for (size_t i = 0; (ztc != NULL) && (i < Z_SESSION_MULTICAST_GROUP_NB); i++) {
+        if ((zn->_tp_groups[i]._type == _Z_TRANSPORT_MULTICAST_TYPE) &&
+            (ztc == &zn->_tp_groups[i]._transport._multicast._common)) {
+            return _z_transport_tx_send_n_msg(ztc, z_msg, reliability, cong_ctrl, NULL);
+        }
+    }
+    if (ztc != NULL) {
+        return _z_send_n_msg_main(zn, z_msg, reliability, cong_ctrl, NULL);
+    }
+#else
+    _ZP_UNUSED(ztc);
+#endif
+    return _z_send_n_msg(zn, z_msg, reliability, cong_ctrl, NULL);
+}
+
 z_result_t _z_send_n_batch(_z_session_t *zn, z_congestion_control_t cong_ctrl) {
     z_result_t ret = _Z_RES_OK;
     // Call transport function
@@ -17,11 +17,14 @@
 #include <stddef.h>
 #include <stdlib.h>
 
+#include "zenoh-pico/collections/string.h"
 #include "zenoh-pico/link/link.h"
 #include "zenoh-pico/system/common/platform.h"
+#include "zenoh-pico/transport/common/tx.h"
 #include "zenoh-pico/transport/multicast/transport.h"
 #include "zenoh-pico/transport/unicast/accept.h"
 #include "zenoh-pico/transport/unicast/transport.h"
+#include "zenoh-pico/utils/config.h"
 
 static z_result_t _z_new_transport_client(_z_transport_t *zt, const _z_string_t *locator, const _z_id_t *local_zid,
                                           const _z_config_t *session_cfg) {
@@ -151,7 +154,28 @@ z_result_t _z_new_transport(_z_transport_t *zt, const _z_id_t *bs, const _z_stri
     } else {
         ret = _z_new_transport_peer(zt, locator, bs, peer_op, session_cfg);
     }
-
+#if Z_FEATURE_FRAGMENTATION == 1
+    if ((ret == _Z_RES_OK) && (session_cfg != NULL)) {
+        char *opt_as_str = _z_config_get(session_cfg, Z_CONFIG_FRAG_MAX_SIZE_KEY);
+        if (opt_as_str != NULL) {
+            size_t frag_max_size = (size_t)strtoul(opt_as_str, NULL, 10);
+            _z_transport_common_t *ztc = _z_transport_get_common(zt);
+            if ((ztc != NULL) && (frag_max_size > 0)) {
+                ztc->_frag_max_size = frag_max_size;
+            }
+        }
+    }
+#endif
+#if defined(_Z_TX_QUEUE)
+    if ((ret == _Z_RES_OK) && (session_cfg != NULL)) {
+        char *opt_as_str = _z_config_get(session_cfg, Z_CONFIG_TX_QUEUE_KEY);
+        if (opt_as_str == NULL) {
+            opt_as_str = (char *)Z_CONFIG_TX_QUEUE_DEFAULT;
+        }
+        // The writer task is started by _zp_start_read_task, with the same task attributes
+        _z_transport_get_common(zt)->_tx_queue_enabled = _z_str_eq(opt_as_str, "true");
+    }
+#endif
     return ret;
 }
 
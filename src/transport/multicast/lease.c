@@ -21,6 +21,7 @@
 #include "zenoh-pico/session/query.h"
 #include "zenoh-pico/session/utils.h"
 #include "zenoh-pico/transport/multicast/lease.h"
+#include "zenoh-pico/transport/multicast/retx.h"
 #include "zenoh-pico/transport/multicast/transport.h"
 #include "zenoh-pico/utils/logging.h"
 #include "zenoh-pico/utils/result.h"
@@ -35,6 +36,11 @@ z_result_t _zp_multicast_send_join(_z_transport_multicast_t *ztm) {
 
     _z_id_t zid = _z_transport_common_get_session(&ztm->_common)->_local_zid;
     _z_transport_message_t jsm = _z_t_msg_make_join(Z_WHATAMI_PEER, Z_TRANSPORT_LEASE, zid, next_sn);
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    if (_z_multicast_retx_enabled(ztm)) {
+        _z_t_msg_join_set_retx(&jsm, Z_MULTICAST_RETX_WINDOW_SIZE);
+    }
+#endif
 
     return ztm->_send_f(&ztm->_common, &jsm);
 }
@@ -28,6 +28,89 @@
 
 #define _Z_MULTICAST_ADDR_BUFF_SIZE 32  // Arbitrary size that must be able to contain any link address.
 
+static z_result_t _zp_multicast_decode_messages(_z_transport_multicast_t *ztm, size_t to_read, _z_slice_t *addr) {
+    // Wrap the main buffer to_read bytes
+    _z_zbuf_t zbuf = _z_zbuf_view(&ztm->_common._zbuf, to_read);
+
+    while (_z_zbuf_len(&zbuf) > 0) {
+        // Decode one session message
+        _z_transport_message_t t_msg;
+        z_result_t ret = _z_transport_message_decode(&t_msg, &zbuf);
+        if (ret == _Z_RES_OK) {
+            ret = _z_multicast_handle_transport_message(ztm, &t_msg, addr);
+
+            if (ret != _Z_RES_OK) {
+                _Z_ERROR("Dropping message due to processing error: %d", ret);
+                break;
+            }
+        } else {
+            _Z_ERROR("Connection closed due to malformed message: %d", ret);
+            return ret;
+        }
+    }
+    // Move the read position of the read buffer
+    _z_zbuf_set_rpos(&ztm->_common._zbuf, _z_zbuf_get_rpos(&ztm->_common._zbuf) + to_read);
+    if (_z_multicast_update_rx_buffer(ztm) != _Z_RES_OK) {
+        _Z_ERROR("Connection closed due to lack of memory to allocate rx buffer");
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
+
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+static inline void _zp_multicast_swap_zbuf(_z_zbuf_t *a, _z_zbuf_t *b) {
+    _z_zbuf_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+// Reads all the datagrams available on the link in a single call and processes them in order
+static z_result_t _zp_multicast_process_datagrams(_z_transport_multicast_t *ztm, _z_slice_t *addr) {
+    _z_zbuf_t *zbfs[_Z_SYS_NET_RECV_VEC_MAX];
+    _z_slice_t addrs[_Z_SYS_NET_RECV_VEC_MAX];
+    uint8_t addr_buffs[_Z_SYS_NET_RECV_VEC_MAX - 1][_Z_MULTICAST_ADDR_BUFF_SIZE];
+
+    // The main buffer is the first slot of the ring
+    zbfs[0] = &ztm->_common._zbuf;
+    addrs[0] = *addr;
+    size_t count = 1;
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(ztm->_zbuf_ring); i++) {
+        if (_z_zbuf_capacity(&ztm->_zbuf_ring[i]) == 0) {
+            ztm->_zbuf_ring[i] = _z_zbuf_make(Z_BATCH_MULTICAST_SIZE);
+            if (_z_zbuf_capacity(&ztm->_zbuf_ring[i]) == 0) {
+                break;  // Read fewer datagrams at once if memory is short
+            }
+        }
+        zbfs[count] = &ztm->_zbuf_ring[i];
+        addrs[count] = _z_slice_alias_buf(addr_buffs[i], sizeof(addr_buffs[i]));
+        count++;
+    }
+    for (size_t i = 0; i < count; i++) {
+        _z_zbuf_reset(zbfs[i]);
+    }
+    size_t rn = _z_link_recv_zbuf_vec(ztm->_common._link, zbfs, count, addrs);
+    if (rn == SIZE_MAX) {
+        return _Z_NO_DATA_PROCESSED;
+    }
+    z_result_t ret = _Z_RES_OK;
+    for (size_t i = 0; (ret == _Z_RES_OK) && (i < rn); i++) {
+        size_t to_read = _z_zbuf_len(zbfs[i]);
+        if (to_read == 0) {
+            continue;
+        }
+        // Swap the datagram in as main buffer so decoding and rx buffer update stay the same
+        if (i > 0) {
+            _zp_multicast_swap_zbuf(&ztm->_common._zbuf, zbfs[i]);
+        }
+        ret = _zp_multicast_decode_messages(ztm, to_read, &addrs[i]);
+        if (i > 0) {
+            _zp_multicast_swap_zbuf(&ztm->_common._zbuf, zbfs[i]);
+        }
+    }
+    return ret;
+}
+#endif
+
 static z_result_t _zp_multicast_process_messages(_z_transport_multicast_t *ztm, _z_slice_t *addr) {
     size_t to_read = 0;
 
@@ -54,6 +137,11 @@ static z_result_t _zp_multicast_process_messages(_z_transport_multicast_t *ztm,
             }
             break;
         case Z_LINK_CAP_FLOW_DATAGRAM:
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+            if (ztm->_common._link->_read_vec_f != NULL) {
+                return _zp_multicast_process_datagrams(ztm, addr);
+            }
+#endif
             _z_zbuf_compact(&ztm->_common._zbuf);
             to_read = _z_link_recv_zbuf(ztm->_common._link, &ztm->_common._zbuf, addr);
             if (to_read == SIZE_MAX) {
@@ -63,32 +151,7 @@ static z_result_t _zp_multicast_process_messages(_z_transport_multicast_t *ztm,
         default:
             break;
     }
-    // Wrap the main buffer to_read bytes
-    _z_zbuf_t zbuf = _z_zbuf_view(&ztm->_common._zbuf, to_read);
-
-    while (_z_zbuf_len(&zbuf) > 0) {
-        // Decode one session message
-        _z_transport_message_t t_msg;
-        z_result_t ret = _z_transport_message_decode(&t_msg, &zbuf);
-        if (ret == _Z_RES_OK) {
-            ret = _z_multicast_handle_transport_message(ztm, &t_msg, addr);
-
-            if (ret != _Z_RES_OK) {
-                _Z_ERROR("Dropping message due to processing error: %d", ret);
-                return _Z_RES_OK;
-            }
-        } else {
-            _Z_ERROR("Connection closed due to malformed message: %d", ret);
-            return ret;
-        }
-    }
-    // Move the read position of the read buffer
-    _z_zbuf_set_rpos(&ztm->_common._zbuf, _z_zbuf_get_rpos(&ztm->_common._zbuf) + to_read);
-    if (_z_multicast_update_rx_buffer(ztm) != _Z_RES_OK) {
-        _Z_ERROR("Connection closed due to lack of memory to allocate rx buffer");
-        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-    }
-    return _Z_RES_OK;
+    return _zp_multicast_decode_messages(ztm, to_read, addr);
 }
 
 z_result_t _zp_multicast_read(_z_transport_multicast_t *ztm, bool single_read) {
@@ -0,0 +1,279 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include "zenoh-pico/transport/multicast/retx.h"
+
+#include <string.h>
+
+#include "zenoh-pico/protocol/codec/core.h"
+#include "zenoh-pico/transport/common/tx.h"
+#include "zenoh-pico/transport/utils.h"
+#include "zenoh-pico/utils/logging.h"
+
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+
+// Length prefixed zid followed by two SNs
+#define _Z_MULTICAST_NACK_BODY_SIZE (1 + 16 + 2 * 10)
+
+static z_result_t _z_multicast_retx_send_nack(_z_transport_multicast_t *ztm,
+                                              const _z_transport_peer_multicast_t *entry, _z_zint_t first_sn,
+                                              _z_zint_t last_sn) {
+    _Z_DEBUG("Requesting reliable frames %ju to %ju again", (uintmax_t)first_sn, (uintmax_t)last_sn);
+    _z_wbuf_t wbf = _z_wbuf_make(_Z_MULTICAST_NACK_BODY_SIZE, false);
+    if (_z_wbuf_capacity(&wbf) != _Z_MULTICAST_NACK_BODY_SIZE) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    _z_slice_t zid = _z_slice_alias_buf(entry->common._remote_zid.id, _z_id_len(entry->common._remote_zid));
+    z_result_t ret = _z_slice_encode(&wbf, &zid);
+    _Z_SET_IF_OK(ret, _z_zsize_encode(&wbf, first_sn));
+    _Z_SET_IF_OK(ret, _z_zsize_encode(&wbf, last_sn));
+    if (ret == _Z_RES_OK) {
+        _z_network_message_t n_msg = {0};
+        n_msg._tag = _Z_N_OAM;
+        n_msg._reliability = Z_RELIABILITY_BEST_EFFORT;
+        n_msg._body._oam._id = _Z_OAM_ID_MULTICAST_NACK;
+        n_msg._body._oam._ext_qos = _z_n_qos_make(true, false, _Z_PRIORITY_CONTROL);
+        n_msg._body._oam._ext_timestamp = _z_timestamp_null();
+        n_msg._body._oam._enc = _Z_OAM_BODY_ZBUF;
+        n_msg._body._oam._body._zbuf._val = _z_iosli_to_bytes(_z_wbuf_get_iosli(&wbf, 0));
+        // A request lost to congestion is sent again on the next retry
+        ret = _z_transport_tx_send_n_msg_wrapper(&ztm->_common, &n_msg, Z_RELIABILITY_BEST_EFFORT,
+                                                 Z_CONGESTION_CONTROL_DROP);
+    }
+    _z_wbuf_clear(&wbf);
+    return ret;
+}
+
+// Requests each range of SNs missing up to last_sn, the ones held are received already
+static void _z_multicast_retx_send_nacks(_z_transport_multicast_t *ztm, const _z_transport_peer_multicast_t *entry,
+                                         _z_zint_t last_sn) {
+    _z_zint_t sn = entry->_sn_rx_sns._val._plain._reliable;
+    bool missing = false;
+    _z_zint_t first_missing_sn = 0;
+    do {
+        sn = _z_sn_increment(entry->_sn_res, sn);
+        const _z_transport_retx_held_t *held =
+            (entry->_retx_held != NULL) ? &entry->_retx_held[sn % Z_MULTICAST_RETX_WINDOW_SIZE] : NULL;
+        bool is_held = (held != NULL) && (held->_header != 0) && (held->_sn == sn);
+        if (!is_held && !missing) {
+            first_missing_sn = sn;
+            missing = true;
+        } else if (is_held && missing) {
+            _z_multicast_retx_send_nack(ztm, entry, first_missing_sn, _z_sn_decrement(entry->_sn_res, sn));
+            missing = false;
+        }
+    } while (sn != last_sn);
+    if (missing) {
+        _z_multicast_retx_send_nack(ztm, entry, first_missing_sn, last_sn);
+    }
+}
+
+// Requests the SNs missing up to last_sn once per retry period, returns true once they are given up on
+static bool _z_multicast_retx_request(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *entry,
+                                      _z_zint_t last_sn) {
+    if ((entry->_nack_count > 0) && (z_clock_elapsed_ms(&entry->_nack_time) < _Z_MULTICAST_NACK_RETRY_MS)) {
+        // Gaps found since the last request are part of the next one
+        return false;
+    }
+    if (entry->_nack_count < _Z_MULTICAST_NACK_RETRY_MAX) {
+        _z_multicast_retx_send_nacks(ztm, entry, last_sn);
+        entry->_sn_nack = last_sn;
+        entry->_nack_time = z_clock_now();
+        entry->_nack_count++;
+        return false;
+    }
+    _Z_INFO("Reliable messages lost because the peer didn't retransmit them");
+    return true;
+}
+
+static void _z_multicast_retx_skip(_z_transport_peer_multicast_t *entry, _z_zint_t last_sn) {
+    entry->_retx_skip = true;
+    entry->_sn_skip = last_sn;
+    entry->_nack_count = 0;
+}
+
+// Updates the pending request once the last delivered SN moved forward
+static void _z_multicast_retx_delivered(_z_transport_peer_multicast_t *entry, _z_zint_t sn) {
+    entry->_sn_rx_sns._val._plain._reliable = sn;
+    if (entry->_nack_count > 0) {
+        if (_z_sn_precedes(entry->_sn_res, sn, entry->_sn_nack)) {
+            // Retransmissions are coming, wait for the rest before requesting it again
+            entry->_nack_time = z_clock_now();
+        } else {
+            entry->_nack_count = 0;
+        }
+    }
+}
+
+static void _z_multicast_retx_release_all(_z_transport_peer_multicast_t *entry) {
+    if (entry->_retx_held != NULL) {
+        for (size_t i = 0; i < Z_MULTICAST_RETX_WINDOW_SIZE; i++) {
+            _z_multicast_retx_release(&entry->_retx_held[i]);
+        }
+    }
+    entry->_retx_skip = false;
+    entry->_nack_count = 0;
+}
+
+void _z_multicast_retx_peer_init(_z_transport_peer_multicast_t *entry) {
+    entry->_retx_window = 0;
+    entry->_retx_held = NULL;
+    entry->_retx_skip = false;
+    entry->_sn_skip = entry->_sn_rx_sns._val._plain._reliable;
+    entry->_sn_nack = entry->_sn_rx_sns._val._plain._reliable;
+    entry->_nack_time = z_clock_now();
+    entry->_nack_count = 0;
+}
+
+void _z_multicast_retx_peer_set_window(_z_transport_peer_multicast_t *entry, uint16_t window) {
+    if (window > Z_MULTICAST_RETX_WINDOW_SIZE) {
+        window = Z_MULTICAST_RETX_WINDOW_SIZE;
+    }
+    if (window < entry->_retx_window) {
+        if (entry->_retx_held != NULL) {
+            _Z_INFO("Reliable messages dropped because the peer changed its retransmission window");
+        }
+        _z_multicast_retx_release_all(entry);
+    }
+    entry->_retx_window = window;
+}
+
+void _z_multicast_retx_peer_clear(_z_transport_peer_multicast_t *entry) {
+    _z_multicast_retx_release_all(entry);
+    z_free(entry->_retx_held);
+    entry->_retx_held = NULL;
+}
+
+_z_multicast_retx_sn_t _z_multicast_retx_accept_sn(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *entry,
+                                                   _z_zint_t sn, bool *consecutive) {
+    _z_zint_t last_sn = entry->_sn_rx_sns._val._plain._reliable;
+    if (!_z_sn_precedes(entry->_sn_res, last_sn, sn)) {
+        // Already delivered, likely retransmitted for another peer
+        return _Z_MULTICAST_RETX_SN_DROP;
+    }
+    *consecutive = _z_sn_consecutive(entry->_sn_res, last_sn, sn);
+    if (*consecutive) {
+        _z_multicast_retx_delivered(entry, sn);
+        return _Z_MULTICAST_RETX_SN_DELIVER;
+    }
+    if (((sn - last_sn) & entry->_sn_res) > entry->_retx_window) {
+        // The peer doesn't keep the first missing frames anymore, nor is there room to hold this one
+        _Z_INFO("Reliable messages lost because they are out of the retransmission window");
+        _z_multicast_retx_skip(entry, (sn - entry->_retx_window) & entry->_sn_res);
+        return _Z_MULTICAST_RETX_SN_SKIP;
+    }
+    _z_zint_t missing_sn = _z_sn_decrement(entry->_sn_res, sn);
+    if (_z_multicast_retx_request(ztm, entry, missing_sn)) {
+        _z_multicast_retx_skip(entry, missing_sn);
+        return _Z_MULTICAST_RETX_SN_SKIP;
+    }
+    return _Z_MULTICAST_RETX_SN_HOLD;
+}
+
+z_result_t _z_multicast_retx_hold(_z_transport_peer_multicast_t *entry, uint8_t header, _z_zint_t sn,
+                                  const uint8_t *payload, size_t len, bool first, bool drop) {
+    if (entry->_retx_held == NULL) {
+        entry->_retx_held =
+            (_z_transport_retx_held_t *)z_malloc(Z_MULTICAST_RETX_WINDOW_SIZE * sizeof(_z_transport_retx_held_t));
+        if (entry->_retx_held == NULL) {
+            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+        }
+        (void)memset(entry->_retx_held, 0, Z_MULTICAST_RETX_WINDOW_SIZE * sizeof(_z_transport_retx_held_t));
+    }
+    // Held SNs are within the window following the last delivered one, so a used slot is for the same SN
+    _z_transport_retx_held_t *held = &entry->_retx_held[sn % Z_MULTICAST_RETX_WINDOW_SIZE];
+    if (held->_header != 0) {
+        return _Z_RES_OK;
+    }
+    held->_payload = _z_zbuf_make(len);
+    if (_z_zbuf_capacity(&held->_payload) != len) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    if (len > 0) {
+        _z_iosli_write_bytes(&held->_payload._ios, payload, 0, len);
+    }
+    held->_sn = sn;
+    held->_header = header;
+    held->_first = first;
+    held->_drop = drop;
+    return _Z_RES_OK;
+}
+
+_z_transport_retx_held_t *_z_multicast_retx_next(_z_transport_peer_multicast_t *entry, bool *consecutive) {
+    *consecutive = true;
+    while (true) {
+        _z_zint_t last_sn = entry->_sn_rx_sns._val._plain._reliable;
+        _z_zint_t sn = _z_sn_increment(entry->_sn_res, last_sn);
+        _z_transport_retx_held_t *held =
+            (entry->_retx_held != NULL) ? &entry->_retx_held[sn % Z_MULTICAST_RETX_WINDOW_SIZE] : NULL;
+        if ((held != NULL) && (held->_header != 0) && (held->_sn == sn)) {
+            _z_multicast_retx_delivered(entry, sn);
+            return held;
+        }
+        if (!entry->_retx_skip || !_z_sn_precedes(entry->_sn_res, last_sn, entry->_sn_skip)) {
+            entry->_retx_skip = false;
+            return NULL;
+        }
+        entry->_sn_rx_sns._val._plain._reliable = sn;
+        *consecutive = false;
+    }
+}
+
+void _z_multicast_retx_release(_z_transport_retx_held_t *held) {
+    if (held->_header != 0) {
+        _z_zbuf_clear(&held->_payload);
+        held->_header = 0;
+    }
+}
+
+void _z_multicast_retx_check_join(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *entry,
+                                  _z_zint_t last_sent_sn) {
+    _z_zint_t last_sn = entry->_sn_rx_sns._val._plain._reliable;
+    if (last_sn == last_sent_sn) {
+        // Nothing is missing when the peer didn't send anything new
+        return;
+    }
+    if (!_z_sn_precedes(entry->_sn_res, last_sn, last_sent_sn)) {
+        // The peer restarted its SNs, what is held belongs to the previous ones
+        _z_multicast_retx_release_all(entry);
+        entry->_sn_rx_sns._val._plain._reliable = last_sent_sn;
+    } else if (((last_sent_sn - last_sn) & entry->_sn_res) > entry->_retx_window) {
+        _Z_INFO("Reliable messages lost because they are out of the retransmission window");
+        _z_multicast_retx_skip(entry, (last_sent_sn - entry->_retx_window) & entry->_sn_res);
+    } else if (_z_multicast_retx_request(ztm, entry, last_sent_sn)) {
+        _z_multicast_retx_skip(entry, last_sent_sn);
+    }
+}
+
+z_result_t _z_multicast_retx_handle_nack(_z_transport_multicast_t *ztm, const _z_n_msg_oam_t *oam,
+                                         const _z_id_t *local_zid) {
+    if (oam->_enc != _Z_OAM_BODY_ZBUF) {
+        _Z_ERROR_RETURN(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
+    }
+    _z_zbuf_t zbf = _z_slice_as_zbuf(oam->_body._zbuf._val);
+    _z_slice_t zid = _z_slice_null();
+    _z_zint_t first_sn = 0;
+    _z_zint_t last_sn = 0;
+    _Z_RETURN_IF_ERR(_z_slice_decode(&zid, &zbf));
+    _Z_RETURN_IF_ERR(_z_zsize_decode(&first_sn, &zbf));
+    _Z_RETURN_IF_ERR(_z_zsize_decode(&last_sn, &zbf));
+    // Requests are received by all the peers, only the targeted one answers
+    if ((zid.len != _z_id_len(*local_zid)) || (memcmp(zid.start, local_zid->id, zid.len) != 0)) {
+        return _Z_RES_OK;
+    }
+    _Z_DEBUG("Retransmitting reliable frames %ju to %ju", (uintmax_t)first_sn, (uintmax_t)last_sn);
+    return _z_transport_tx_retransmit(&ztm->_common, first_sn, last_sn);
+}
+
+#endif  // Z_MULTICAST_RETX_WINDOW_SIZE > 0
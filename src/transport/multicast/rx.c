@@ -23,7 +23,9 @@
 #include "zenoh-pico/protocol/definitions/network.h"
 #include "zenoh-pico/protocol/definitions/transport.h"
 #include "zenoh-pico/protocol/iobuf.h"
+#include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/multicast/retx.h"
 #include "zenoh-pico/transport/multicast/rx.h"
 #include "zenoh-pico/transport/multicast/transport.h"
 #include "zenoh-pico/transport/utils.h"
@@ -118,111 +120,72 @@ static _z_transport_peer_multicast_t *_z_find_peer_entry(_z_transport_peer_multi
     return ret;
 }
 
-static z_result_t _z_multicast_handle_frame(_z_transport_multicast_t *ztm, uint8_t header, _z_t_msg_frame_t *msg,
-                                            _z_transport_peer_multicast_t *entry) {
-    // Check peer
-    if (entry == NULL) {
-        _Z_INFO("Dropping _Z_FRAME from unknown peer");
-        _z_t_msg_frame_clear(msg);
-        return _Z_RES_OK;
-    }
-    // Note that we receive data from peer
-    entry->common._received = true;
-
-    z_reliability_t tmsg_reliability;
-    // Check if the SN is correct
-    if (_Z_HAS_FLAG(header, _Z_FLAG_T_FRAME_R)) {
-        tmsg_reliability = Z_RELIABILITY_RELIABLE;
-        // @TODO: amend once reliability is in place. For the time being only
-        //        monotonic SNs are ensured
-        if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, msg->_sn)) {
-            entry->_sn_rx_sns._val._plain._reliable = msg->_sn;
-        } else {
-#if Z_FEATURE_FRAGMENTATION == 1
-            entry->common._state_reliable = _Z_DBUF_STATE_NULL;
-            _z_wbuf_clear(&entry->common._dbuf_reliable);
-#endif
-            _Z_INFO("Reliable message dropped because it is out of order");
-            _z_t_msg_frame_clear(msg);
-            return _Z_RES_OK;
-        }
-    } else {
-        tmsg_reliability = Z_RELIABILITY_BEST_EFFORT;
-        if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._best_effort, msg->_sn)) {
-            entry->_sn_rx_sns._val._plain._best_effort = msg->_sn;
-        } else {
+// Returns false if the reliable frame or fragment must be dropped, used for peers that don't retransmit
+static bool _z_multicast_check_reliable_sn(_z_transport_peer_multicast_t *entry, _z_zint_t sn, bool *consecutive) {
+    // Without retransmissions only monotonic SNs are ensured
+    if (!_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, sn)) {
 #if Z_FEATURE_FRAGMENTATION == 1
-            entry->common._state_best_effort = _Z_DBUF_STATE_NULL;
-            _z_wbuf_clear(&entry->common._dbuf_best_effort);
+        entry->common._state_reliable = _Z_DBUF_STATE_NULL;
+        _z_dbuf_clear(&entry->common._dbuf_reliable);
 #endif
-            _Z_INFO("Best effort message dropped because it is out of order");
-            _z_t_msg_frame_clear(msg);
-            return _Z_RES_OK;
-        }
+        _Z_INFO("Reliable message dropped because it is out of order");
+        return false;
     }
+    *consecutive = _z_sn_consecutive(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, sn);
+    entry->_sn_rx_sns._val._plain._reliable = sn;
+    return true;
+}
+
+static z_result_t _z_multicast_process_frame(_z_transport_multicast_t *ztm, _z_zbuf_t *payload,
+                                             z_reliability_t tmsg_reliability, _z_transport_peer_multicast_t *entry) {
     // Handle all the zenoh message, one by one
     // From this point, memory cleaning must be handled by the network message layer
     _z_network_message_t curr_nmsg = {0};
     _z_arc_slice_t arcs = _z_arc_slice_empty();
-    while (_z_zbuf_len(msg->_payload) > 0) {
-        _Z_RETURN_IF_ERR(_z_network_message_decode(&curr_nmsg, msg->_payload, &arcs, (uintptr_t)&entry->common));
+    _z_arena_t *arena = &entry->common._rx_arena;
+    while (_z_zbuf_len(payload) > 0) {
+        _Z_CLEAN_RETURN_IF_ERR(_z_network_message_decode(&curr_nmsg, payload, &arcs, (uintptr_t)&entry->common),
+                               _z_arena_reset(arena));
         curr_nmsg._reliability = tmsg_reliability;
-        _Z_RETURN_IF_ERR(_z_handle_network_message(&ztm->_common, &curr_nmsg, &entry->common));
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+        // Retransmission requests are handled by the transport
+        if ((curr_nmsg._tag == _Z_N_OAM) && (curr_nmsg._body._oam._id == _Z_OAM_ID_MULTICAST_NACK)) {
+            z_result_t ret = _z_multicast_retx_handle_nack(
+                ztm, &curr_nmsg._body._oam, &_z_transport_common_get_session(&ztm->_common)->_local_zid);
+            _z_n_msg_oam_clear(&curr_nmsg._body._oam);
+            _Z_CLEAN_RETURN_IF_ERR(ret, _z_arena_reset(arena));
+            continue;
+        }
+#endif
+        _Z_CLEAN_RETURN_IF_ERR(_z_handle_network_message(&ztm->_common, &curr_nmsg, &entry->common),
+                               _z_arena_reset(arena));
     }
+    // Nothing references the transient data of the batch once it is dispatched
+    _z_arena_reset(arena);
     return _Z_RES_OK;
 }
 
-static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *ztm, uint8_t header,
-                                                     _z_t_msg_fragment_t *msg, _z_transport_peer_multicast_t *entry) {
+static z_result_t _z_multicast_process_fragment(_z_transport_multicast_t *ztm, uint8_t header,
+                                                const _z_t_msg_fragment_t *msg, _z_transport_peer_multicast_t *entry,
+                                                bool consecutive) {
     z_result_t ret = _Z_RES_OK;
 #if Z_FEATURE_FRAGMENTATION == 1
-    // Check peer
-    if (entry == NULL) {
-        _Z_INFO("Dropping Z_FRAGMENT from unknown peer");
-        return _Z_RES_OK;
-    }
-    // Note that we receive data from the peer
-    entry->common._received = true;
-
-    _z_wbuf_t *dbuf;
+    _z_dbuf_t *dbuf;
     uint8_t *dbuf_state;
     z_reliability_t tmsg_reliability;
-    bool consecutive;
 
     // Select the right defragmentation buffer
     if (_Z_HAS_FLAG(header, _Z_FLAG_T_FRAME_R)) {
         tmsg_reliability = Z_RELIABILITY_RELIABLE;
-        // Check SN
-        // @TODO: amend once reliability is in place. For the time being only
-        //        monotonic SNs are ensured
-        if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, msg->_sn)) {
-            consecutive = _z_sn_consecutive(entry->_sn_res, entry->_sn_rx_sns._val._plain._reliable, msg->_sn);
-            entry->_sn_rx_sns._val._plain._reliable = msg->_sn;
-            dbuf = &entry->common._dbuf_reliable;
-            dbuf_state = &entry->common._state_reliable;
-        } else {
-            _z_wbuf_clear(&entry->common._dbuf_reliable);
-            entry->common._state_reliable = _Z_DBUF_STATE_NULL;
-            _Z_INFO("Reliable message dropped because it is out of order");
-            return _Z_RES_OK;
-        }
+        dbuf = &entry->common._dbuf_reliable;
+        dbuf_state = &entry->common._state_reliable;
     } else {
         tmsg_reliability = Z_RELIABILITY_BEST_EFFORT;
-        // Check SN
-        if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._best_effort, msg->_sn)) {
-            consecutive = _z_sn_consecutive(entry->_sn_res, entry->_sn_rx_sns._val._plain._best_effort, msg->_sn);
-            entry->_sn_rx_sns._val._plain._best_effort = msg->_sn;
-            dbuf = &entry->common._dbuf_best_effort;
-            dbuf_state = &entry->common._state_best_effort;
-        } else {
-            _z_wbuf_clear(&entry->common._dbuf_best_effort);
-            entry->common._state_best_effort = _Z_DBUF_STATE_NULL;
-            _Z_INFO("Best effort message dropped because it is out of order");
-            return _Z_RES_OK;
-        }
+        dbuf = &entry->common._dbuf_best_effort;
+        dbuf_state = &entry->common._state_best_effort;
     }
-    if (!consecutive && (_z_wbuf_len(dbuf) > 0)) {
-        _z_wbuf_clear(dbuf);
+    if (!consecutive && (_z_dbuf_len(dbuf) > 0)) {
+        _z_dbuf_clear(dbuf);
         *dbuf_state = _Z_DBUF_STATE_NULL;
         _Z_INFO("Defragmentation buffer dropped because non-consecutive fragments received");
         return _Z_RES_OK;
@@ -230,33 +193,29 @@ static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *z
     // Handle fragment markers
     if (_Z_PATCH_HAS_FRAGMENT_MARKERS(entry->common._patch)) {
         if (msg->first) {
-            _z_wbuf_reset(dbuf);
-        } else if (_z_wbuf_len(dbuf) == 0) {
+            _z_dbuf_reset(dbuf);
+        } else if (_z_dbuf_len(dbuf) == 0) {
             _Z_INFO("First fragment received without the first marker");
             return _Z_RES_OK;
         }
         if (msg->drop) {
-            _z_wbuf_reset(dbuf);
+            _z_dbuf_reset(dbuf);
             return _Z_RES_OK;
         }
     }
     // Allocate buffer if needed
     if (*dbuf_state == _Z_DBUF_STATE_NULL) {
-        *dbuf = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
-        if (_z_wbuf_capacity(dbuf) != Z_FRAG_MAX_SIZE) {
-            _Z_ERROR("Not enough memory to allocate peer defragmentation buffer");
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
+        _Z_RETURN_IF_ERR(_z_dbuf_init(dbuf, ztm->_common._frag_max_size));
         *dbuf_state = _Z_DBUF_STATE_INIT;
     }
     // Process fragment data
     if (*dbuf_state == _Z_DBUF_STATE_INIT) {
         // Check overflow
-        if ((_z_wbuf_len(dbuf) + msg->_payload.len) > Z_FRAG_MAX_SIZE) {
+        if ((_z_dbuf_len(dbuf) + msg->_payload.len) > ztm->_common._frag_max_size) {
             *dbuf_state = _Z_DBUF_STATE_OVERFLOW;
         } else {
             // Fill buffer
-            _z_wbuf_write_bytes(dbuf, msg->_payload.start, 0, msg->_payload.len);
+            _Z_RETURN_IF_ERR(_z_dbuf_append(dbuf, msg));
         }
     }
     // Process final fragment
@@ -264,45 +223,177 @@ static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *z
         // Drop message if it exceeds the fragmentation size
         if (*dbuf_state == _Z_DBUF_STATE_OVERFLOW) {
             _Z_INFO("Fragment dropped because defragmentation buffer has overflown");
-            _z_wbuf_clear(dbuf);
+            _z_dbuf_clear(dbuf);
             *dbuf_state = _Z_DBUF_STATE_NULL;
             return _Z_RES_OK;
         }
-        // Convert the defragmentation buffer into a decoding buffer
-        _z_zbuf_t zbf = _z_wbuf_moved_as_zbuf(dbuf);
-        if (_z_zbuf_capacity(&zbf) == 0) {
-            _Z_ERROR("Failed to convert defragmentation buffer into a decoding buffer!");
-            _z_wbuf_clear(dbuf);
-            *dbuf_state = _Z_DBUF_STATE_NULL;
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
         // Decode message
         _z_zenoh_message_t zm = {0};
         _z_arc_slice_t arcs = _z_arc_slice_empty();
-        ret = _z_network_message_decode(&zm, &zbf, &arcs, (uintptr_t)&entry->common);
+        _z_zbuf_t zbf;
+        ret = _z_dbuf_decode(dbuf, &zbf, &zm, &arcs, (uintptr_t)&entry->common);
+        *dbuf_state = _Z_DBUF_STATE_NULL;
         zm._reliability = tmsg_reliability;
         if (ret == _Z_RES_OK) {
             // Memory clear of the network message data must be handled by the network message layer
             _z_handle_network_message(&ztm->_common, &zm, &entry->common);
-        } else {
+            _z_arena_reset(&entry->common._rx_arena);
+        } else if (ret != _Z_ERR_SYSTEM_OUT_OF_MEMORY) {
             _Z_INFO("Failed to decode defragmented message");
             _Z_ERROR_LOG(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
             ret = _Z_ERR_MESSAGE_DESERIALIZATION_FAILED;
         }
         // Free the decoding buffer
         _z_zbuf_clear(&zbf);
-        *dbuf_state = _Z_DBUF_STATE_NULL;
     }
 #else
     _ZP_UNUSED(ztm);
     _ZP_UNUSED(header);
     _ZP_UNUSED(msg);
     _ZP_UNUSED(entry);
+    _ZP_UNUSED(consecutive);
     _Z_INFO("Fragment dropped because fragmentation feature is deactivated");
 #endif
     return ret;
 }
 
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+// Processes the held frames and fragments that can be delivered
+static z_result_t _z_multicast_process_held(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *entry) {
+    z_result_t ret = _Z_RES_OK;
+    bool consecutive;
+    _z_transport_retx_held_t *held;
+    while ((ret == _Z_RES_OK) && ((held = _z_multicast_retx_next(entry, &consecutive)) != NULL)) {
+        if (_Z_MID(held->_header) == _Z_MID_T_FRAME) {
+            ret = _z_multicast_process_frame(ztm, &held->_payload, Z_RELIABILITY_RELIABLE, entry);
+        } else {
+            _z_t_msg_fragment_t msg = {0};
+            msg._payload = _z_slice_alias_buf(_z_zbuf_get_rptr(&held->_payload), _z_zbuf_len(&held->_payload));
+            msg._src = &held->_payload._slice;
+            msg._sn = held->_sn;
+            msg.first = held->_first;
+            msg.drop = held->_drop;
+            ret = _z_multicast_process_fragment(ztm, held->_header, &msg, entry, consecutive);
+        }
+        _z_multicast_retx_release(held);
+    }
+    return ret;
+}
+
+// Checks the SN of a reliable frame or fragment from a peer that retransmits, holding it if it follows missing ones
+static z_result_t _z_multicast_accept_retx_sn(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *entry,
+                                              uint8_t header, _z_zint_t sn, const _z_slice_t *payload, bool first,
+                                              bool drop, bool *deliver, bool *consecutive) {
+    _z_multicast_retx_sn_t res;
+    while ((res = _z_multicast_retx_accept_sn(ztm, entry, sn, consecutive)) == _Z_MULTICAST_RETX_SN_SKIP) {
+        _Z_RETURN_IF_ERR(_z_multicast_process_held(ztm, entry));
+    }
+    *deliver = (res == _Z_MULTICAST_RETX_SN_DELIVER);
+    if (res == _Z_MULTICAST_RETX_SN_HOLD) {
+        return _z_multicast_retx_hold(entry, header, sn, payload->start, payload->len, first, drop);
+    }
+    return _Z_RES_OK;
+}
+#endif
+
+static z_result_t _z_multicast_handle_frame(_z_transport_multicast_t *ztm, uint8_t header, _z_t_msg_frame_t *msg,
+                                            _z_transport_peer_multicast_t *entry) {
+    // Check peer
+    if (entry == NULL) {
+        _Z_INFO("Dropping _Z_FRAME from unknown peer");
+        _z_t_msg_frame_clear(msg);
+        return _Z_RES_OK;
+    }
+    // Note that we receive data from peer
+    entry->common._received = true;
+
+    z_reliability_t tmsg_reliability;
+    // Check if the SN is correct
+    if (_Z_HAS_FLAG(header, _Z_FLAG_T_FRAME_R)) {
+        tmsg_reliability = Z_RELIABILITY_RELIABLE;
+        bool consecutive;
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+        if (_z_multicast_retx_peer_enabled(entry)) {
+            bool deliver = false;
+            _z_slice_t payload = _z_slice_alias_buf(_z_zbuf_get_rptr(msg->_payload), _z_zbuf_len(msg->_payload));
+            z_result_t ret = _z_multicast_accept_retx_sn(ztm, entry, header, msg->_sn, &payload, false, false,
+                                                         &deliver, &consecutive);
+            if (deliver) {
+                _Z_SET_IF_OK(ret, _z_multicast_process_frame(ztm, msg->_payload, tmsg_reliability, entry));
+                _Z_SET_IF_OK(ret, _z_multicast_process_held(ztm, entry));
+            } else {
+                _z_t_msg_frame_clear(msg);
+            }
+            return ret;
+        }
+#endif
+        if (!_z_multicast_check_reliable_sn(entry, msg->_sn, &consecutive)) {
+            _z_t_msg_frame_clear(msg);
+            return _Z_RES_OK;
+        }
+    } else {
+        tmsg_reliability = Z_RELIABILITY_BEST_EFFORT;
+        if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._best_effort, msg->_sn)) {
+            entry->_sn_rx_sns._val._plain._best_effort = msg->_sn;
+        } else {
+#if Z_FEATURE_FRAGMENTATION == 1
+            entry->common._state_best_effort = _Z_DBUF_STATE_NULL;
+            _z_dbuf_clear(&entry->common._dbuf_best_effort);
+#endif
+            _Z_INFO("Best effort message dropped because it is out of order");
+            _z_t_msg_frame_clear(msg);
+            return _Z_RES_OK;
+        }
+    }
+    return _z_multicast_process_frame(ztm, msg->_payload, tmsg_reliability, entry);
+}
+
+static z_result_t _z_multicast_handle_fragment_inner(_z_transport_multicast_t *ztm, uint8_t header,
+                                                     _z_t_msg_fragment_t *msg, _z_transport_peer_multicast_t *entry) {
+#if Z_FEATURE_FRAGMENTATION == 1
+    // Check peer
+    if (entry == NULL) {
+        _Z_INFO("Dropping Z_FRAGMENT from unknown peer");
+        return _Z_RES_OK;
+    }
+    // Note that we receive data from the peer
+    entry->common._received = true;
+
+    bool consecutive;
+    // Check SN
+    if (_Z_HAS_FLAG(header, _Z_FLAG_T_FRAME_R)) {
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+        if (_z_multicast_retx_peer_enabled(entry)) {
+            bool deliver = false;
+            z_result_t ret = _z_multicast_accept_retx_sn(ztm, entry, header, msg->_sn, &msg->_payload, msg->first,
+                                                         msg->drop, &deliver, &consecutive);
+            if (deliver) {
+                _Z_SET_IF_OK(ret, _z_multicast_process_fragment(ztm, header, msg, entry, consecutive));
+                _Z_SET_IF_OK(ret, _z_multicast_process_held(ztm, entry));
+            }
+            return ret;
+        }
+#endif
+        if (!_z_multicast_check_reliable_sn(entry, msg->_sn, &consecutive)) {
+            return _Z_RES_OK;
+        }
+    } else {
+        if (_z_sn_precedes(entry->_sn_res, entry->_sn_rx_sns._val._plain._best_effort, msg->_sn)) {
+            consecutive = _z_sn_consecutive(entry->_sn_res, entry->_sn_rx_sns._val._plain._best_effort, msg->_sn);
+            entry->_sn_rx_sns._val._plain._best_effort = msg->_sn;
+        } else {
+            _z_dbuf_clear(&entry->common._dbuf_best_effort);
+            entry->common._state_best_effort = _Z_DBUF_STATE_NULL;
+            _Z_INFO("Best effort message dropped because it is out of order");
+            return _Z_RES_OK;
+        }
+    }
+    return _z_multicast_process_fragment(ztm, header, msg, entry, consecutive);
+#else
+    return _z_multicast_process_fragment(ztm, header, msg, entry, true);
+#endif
+}
+
 static z_result_t _z_multicast_handle_fragment(_z_transport_multicast_t *ztm, uint8_t header, _z_t_msg_fragment_t *msg,
                                                _z_transport_peer_multicast_t *entry) {
     z_result_t ret = _z_multicast_handle_fragment_inner(ztm, header, msg, entry);
@@ -331,6 +422,10 @@ static z_result_t _z_multicast_handle_join_inner(_z_transport_multicast_t *ztm,
         entry->_remote_addr = _z_slice_duplicate(addr);
         _z_conduit_sn_list_copy(&entry->_sn_rx_sns, &msg->_next_sn);
         _z_conduit_sn_list_decrement(entry->_sn_res, &entry->_sn_rx_sns);
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+        _z_multicast_retx_peer_init(entry);
+        _z_multicast_retx_peer_set_window(entry, msg->_retx_window);
+#endif
         // Update lease time (set as ms during)
         entry->_lease = msg->_lease;
         entry->_next_lease = entry->_lease;
@@ -338,12 +433,18 @@ static z_result_t _z_multicast_handle_join_inner(_z_transport_multicast_t *ztm,
         entry->common._remote_whatami = msg->_whatami;
         entry->common._received = true;
         entry->common._remote_resources = NULL;
+        _z_resource_index_init(&entry->common._remote_resources_index);
+        entry->common._rx_arena = _z_arena_make(Z_RX_ARENA_SIZE);
 #if Z_FEATURE_FRAGMENTATION == 1
         entry->common._patch = msg->_patch < _Z_CURRENT_PATCH ? msg->_patch : _Z_CURRENT_PATCH;
         entry->common._state_reliable = _Z_DBUF_STATE_NULL;
         entry->common._state_best_effort = _Z_DBUF_STATE_NULL;
-        entry->common._dbuf_reliable = _z_wbuf_null();
-        entry->common._dbuf_best_effort = _z_wbuf_null();
+        entry->common._dbuf_reliable = _z_dbuf_null();
+        entry->common._dbuf_best_effort = _z_dbuf_null();
+#endif
+#if Z_FEATURE_SHM == 1
+        entry->common._shm = false;
+        entry->common._shm_ledger = NULL;
 #endif
     } else {  // Existing peer
         // Note that we receive data from the peer
@@ -356,11 +457,24 @@ static z_result_t _z_multicast_handle_join_inner(_z_transport_multicast_t *ztm,
             _z_transport_peer_multicast_slist_drop_first_filter(ztm->_peers, _z_transport_peer_multicast_eq, entry);
             return _Z_RES_OK;
         }
+        // Update lease time (set as ms during)
+        entry->_lease = msg->_lease;
         // Update SNs
+        _z_zint_t last_reliable_sn = entry->_sn_rx_sns._val._plain._reliable;
         _z_conduit_sn_list_copy(&entry->_sn_rx_sns, &msg->_next_sn);
         _z_conduit_sn_list_decrement(entry->_sn_res, &entry->_sn_rx_sns);
-        // Update lease time (set as ms during)
-        entry->_lease = msg->_lease;
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+        _z_multicast_retx_peer_set_window(entry, msg->_retx_window);
+        if (_z_multicast_retx_peer_enabled(entry)) {
+            // Reliable frames sent before the join but not received are requested instead of skipped
+            _z_zint_t last_sent_sn = entry->_sn_rx_sns._val._plain._reliable;
+            entry->_sn_rx_sns._val._plain._reliable = last_reliable_sn;
+            _z_multicast_retx_check_join(ztm, entry, last_sent_sn);
+            return _z_multicast_process_held(ztm, entry);
+        }
+#else
+        _ZP_UNUSED(last_reliable_sn);
+#endif
     }
     return _Z_RES_OK;
 }
@@ -438,23 +552,7 @@ z_result_t _z_multicast_handle_transport_message(_z_transport_multicast_t *ztm,
 }
 
 z_result_t _z_multicast_update_rx_buffer(_z_transport_multicast_t *ztm) {
-    // Check if user or defragment buffer took ownership of buffer
-    if (_z_zbuf_get_ref_count(&ztm->_common._zbuf) != 1) {
-        // Allocate a new buffer
-        _z_zbuf_t new_zbuf = _z_zbuf_make(Z_BATCH_MULTICAST_SIZE);
-        if (_z_zbuf_capacity(&new_zbuf) != Z_BATCH_MULTICAST_SIZE) {
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
-        // Recopy leftover bytes
-        size_t leftovers = _z_zbuf_len(&ztm->_common._zbuf);
-        if (leftovers > 0) {
-            _z_zbuf_copy_bytes(&new_zbuf, &ztm->_common._zbuf);
-        }
-        // Drop buffer & update
-        _z_zbuf_clear(&ztm->_common._zbuf);
-        ztm->_common._zbuf = new_zbuf;
-    }
-    return _Z_RES_OK;
+    return _z_transport_update_rx_buffer(&ztm->_common);
 }
 
 #else
@@ -52,6 +52,29 @@ z_result_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
 #if Z_FEATURE_BATCHING == 1
     ztm->_common._batch_state = _Z_BATCHING_IDLE;
     ztm->_common._batch_count = 0;
+    for (uint8_t i = 0; i < Z_PRIORITIES_NUM; i++) {
+        ztm->_common._batch_lanes[i] = (_z_transport_tx_lane_t){0};
+    }
+#endif
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE; i++) {
+        ztm->_common._zbuf_pool[i] = _z_zbuf_null();
+    }
+#endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    ztm->_common._retx_window = NULL;
+#endif
+#if Z_FEATURE_FRAGMENTATION == 1
+    ztm->_common._frag_max_size = Z_FRAG_MAX_SIZE;
+#endif
+#if defined(_Z_TX_QUEUE)
+    ztm->_common._tx_queue = NULL;
+    ztm->_common._tx_queue_enabled = false;
+#endif
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(ztm->_zbuf_ring); i++) {
+        ztm->_zbuf_ring[i] = _z_zbuf_null();
+    }
 #endif
 
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -106,6 +129,20 @@ z_result_t _z_multicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
         // Initialize peer list
         ztm->_peers = _z_transport_peer_multicast_slist_new();
 
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+        // Raweth transport has its own tx path and doesn't answer retransmission requests
+        if (zt->_type == _Z_TRANSPORT_MULTICAST_TYPE) {
+            ztm->_common._retx_window = (_z_transport_retx_entry_t *)z_malloc(Z_MULTICAST_RETX_WINDOW_SIZE *
+                                                                              sizeof(_z_transport_retx_entry_t));
+            if (ztm->_common._retx_window == NULL) {
+                _Z_ERROR("Not enough memory to allocate transport retransmission window, frames won't be resent");
+            } else {
+                (void)memset(ztm->_common._retx_window, 0,
+                             Z_MULTICAST_RETX_WINDOW_SIZE * sizeof(_z_transport_retx_entry_t));
+            }
+        }
+#endif
+
 #if Z_FEATURE_MULTI_THREAD == 1
         // Tasks
         ztm->_common._accept_task_running = NULL;
@@ -141,6 +178,12 @@ z_result_t _z_multicast_open_peer(_z_transport_multicast_establish_param_t *para
 
     _z_id_t zid = *local_zid;
     _z_transport_message_t jsm = _z_t_msg_make_join(Z_WHATAMI_PEER, Z_TRANSPORT_LEASE, zid, next_sn);
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    // Only the multicast transport keeps its sent frames, see _z_multicast_transport_create
+    if (zl->_cap._transport == Z_LINK_CAP_TRANSPORT_MULTICAST) {
+        _z_t_msg_join_set_retx(&jsm, Z_MULTICAST_RETX_WINDOW_SIZE);
+    }
+#endif
 
     // Encode and send the message
     _Z_DEBUG("Sending Z_JOIN message");
@@ -190,6 +233,11 @@ z_result_t _z_multicast_transport_close(_z_transport_multicast_t *ztm, uint8_t r
 void _z_multicast_transport_clear(_z_transport_multicast_t *ztm, bool detach_tasks) {
     _z_common_transport_clear(&ztm->_common, detach_tasks);
     _z_transport_peer_multicast_slist_free(&ztm->_peers);
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+    for (size_t i = 0; i < _ZP_ARRAY_SIZE(ztm->_zbuf_ring); i++) {
+        _z_zbuf_clear(&ztm->_zbuf_ring[i]);
+    }
+#endif
 }
 
 #else
@@ -13,29 +13,43 @@
 //
 
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/session/resource.h"
 #include "zenoh-pico/session/session.h"
+#include "zenoh-pico/transport/common/rx.h"
+#include "zenoh-pico/transport/multicast/retx.h"
 #include "zenoh-pico/transport/transport.h"
 #include "zenoh-pico/transport/utils.h"
 
 void _z_transport_peer_common_clear(_z_transport_peer_common_t *src) {
 #if Z_FEATURE_FRAGMENTATION == 1
-    _z_wbuf_clear(&src->_dbuf_reliable);
-    _z_wbuf_clear(&src->_dbuf_best_effort);
+    _z_dbuf_clear(&src->_dbuf_reliable);
+    _z_dbuf_clear(&src->_dbuf_best_effort);
+#endif
+#if Z_FEATURE_SHM == 1
+    // The peer may not have dropped the payloads it got by reference
+    _z_shm_ledger_free(&src->_shm_ledger);
 #endif
     src->_remote_zid = _z_id_empty();
+    _z_arena_clear(&src->_rx_arena);
+    _z_resource_index_clear(&src->_remote_resources_index);
     _z_resource_slist_free(&src->_remote_resources);
 }
 void _z_transport_peer_common_copy(_z_transport_peer_common_t *dst, const _z_transport_peer_common_t *src) {
 #if Z_FEATURE_FRAGMENTATION == 1
     dst->_state_reliable = src->_state_reliable;
     dst->_state_best_effort = src->_state_best_effort;
-    _z_wbuf_copy(&dst->_dbuf_reliable, &src->_dbuf_reliable);
-    _z_wbuf_copy(&dst->_dbuf_best_effort, &src->_dbuf_best_effort);
+    _z_dbuf_copy(&dst->_dbuf_reliable, &src->_dbuf_reliable);
+    _z_dbuf_copy(&dst->_dbuf_best_effort, &src->_dbuf_best_effort);
     dst->_patch = src->_patch;
+#endif
+#if Z_FEATURE_SHM == 1
+    dst->_shm = src->_shm;
+    dst->_shm_ledger = NULL;
 #endif
     dst->_received = src->_received;
     dst->_remote_zid = src->_remote_zid;
     dst->_remote_whatami = src->_remote_whatami;
+    dst->_rx_arena = _z_arena_make(Z_RX_ARENA_SIZE);
 }
 
 bool _z_transport_peer_common_eq(const _z_transport_peer_common_t *left, const _z_transport_peer_common_t *right) {
@@ -43,6 +57,9 @@ bool _z_transport_peer_common_eq(const _z_transport_peer_common_t *left, const _
 }
 
 void _z_transport_peer_multicast_clear(_z_transport_peer_multicast_t *src) {
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    _z_multicast_retx_peer_clear(src);
+#endif
     _z_slice_clear(&src->_remote_addr);
     _z_transport_peer_common_clear(&src->common);
 }
@@ -52,6 +69,15 @@ void _z_transport_peer_multicast_copy(_z_transport_peer_multicast_t *dst, const
     _z_conduit_sn_list_copy(&dst->_sn_rx_sns, &src->_sn_rx_sns);
     dst->_lease = src->_lease;
     dst->_next_lease = src->_next_lease;
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    dst->_retx_window = src->_retx_window;
+    dst->_retx_held = NULL;
+    dst->_retx_skip = false;
+    dst->_sn_skip = src->_sn_skip;
+    dst->_sn_nack = src->_sn_nack;
+    dst->_nack_time = src->_nack_time;
+    dst->_nack_count = src->_nack_count;
+#endif
     _z_slice_copy(&dst->_remote_addr, &src->_remote_addr);
     _z_transport_peer_common_copy(&dst->common, &src->common);
 }
@@ -111,12 +137,33 @@ z_result_t _z_transport_peer_unicast_add(_z_transport_unicast_t *ztu, _z_transpo
     peer->common._remote_whatami = param->_remote_whatami;
     peer->common._received = true;
     peer->common._remote_resources = NULL;
+    _z_resource_index_init(&peer->common._remote_resources_index);
+    peer->common._rx_arena = _z_arena_make(Z_RX_ARENA_SIZE);
 #if Z_FEATURE_FRAGMENTATION == 1
     peer->common._patch = param->_patch < _Z_CURRENT_PATCH ? param->_patch : _Z_CURRENT_PATCH;
     peer->common._state_reliable = _Z_DBUF_STATE_NULL;
     peer->common._state_best_effort = _Z_DBUF_STATE_NULL;
-    peer->common._dbuf_reliable = _z_wbuf_null();
-    peer->common._dbuf_best_effort = _z_wbuf_null();
+    peer->common._dbuf_reliable = _z_dbuf_null();
+    peer->common._dbuf_best_effort = _z_dbuf_null();
+#endif
+#if Z_FEATURE_SHM == 1
+    peer->common._shm = param->_shm;
+    peer->common._shm_ledger = NULL;
+    // A handle sent in a lost datagram would only come back with the peer, references only go over streams
+    if (param->_shm && (ztu->_common._link->_cap._flow == Z_LINK_CAP_FLOW_STREAM)) {
+        peer->common._shm_ledger = _z_shm_ledger_new();
+    }
+#endif
+#if defined(_Z_SYS_NET_EVENT_SET)
+    // Peers added before the read workers exist are registered when they are created
+    if ((ztu->_rx_workers != NULL) &&
+        (_z_socket_event_set_add(&_z_transport_unicast_rx_worker_of(ztu, peer)->_event_set, &socket, peer) !=
+         _Z_RES_OK)) {
+        // The peer would never be read, it was never reported by a wait either
+        ztu->_peers = _z_transport_peer_unicast_slist_drop_element(ztu->_peers, NULL);
+        _z_transport_peer_mutex_unlock(&ztu->_common);
+        _Z_ERROR_RETURN(_Z_ERR_GENERIC);
+    }
 #endif
     _z_transport_peer_mutex_unlock(&ztu->_common);
 
@@ -125,3 +172,16 @@ z_result_t _z_transport_peer_unicast_add(_z_transport_unicast_t *ztu, _z_transpo
     }
     return _Z_RES_OK;
 }
+
+void _z_transport_peer_unicast_drop(_z_transport_unicast_t *ztu, _z_transport_peer_unicast_slist_t *prev) {
+#if defined(_Z_SYS_NET_EVENT_SET)
+    _z_transport_peer_unicast_slist_t *node = (prev == NULL) ? ztu->_peers : _z_transport_peer_unicast_slist_next(prev);
+    if ((node != NULL) && (ztu->_rx_workers != NULL)) {
+        _z_transport_peer_unicast_t *peer = _z_transport_peer_unicast_slist_value(node);
+        _z_transport_unicast_rx_worker_t *worker = _z_transport_unicast_rx_worker_of(ztu, peer);
+        _z_socket_event_set_remove(&worker->_event_set, &peer->_socket);
+        worker->_event_set_gen++;
+    }
+#endif
+    ztu->_peers = _z_transport_peer_unicast_slist_drop_element(ztu->_peers, prev);
+}
@@ -113,23 +113,7 @@ z_result_t _z_raweth_recv_t_msg(_z_transport_multicast_t *ztm, _z_transport_mess
 }
 
 z_result_t _z_raweth_update_rx_buff(_z_transport_multicast_t *ztm) {
-    // Check if user or defragment buffer took ownership of buffer
-    if (_z_zbuf_get_ref_count(&ztm->_common._zbuf) != 1) {
-        // Allocate a new buffer
-        _z_zbuf_t new_zbuf = _z_zbuf_make(Z_BATCH_MULTICAST_SIZE);
-        if (_z_zbuf_capacity(&new_zbuf) != Z_BATCH_MULTICAST_SIZE) {
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
-        // Recopy leftover bytes
-        size_t leftovers = _z_zbuf_len(&ztm->_common._zbuf);
-        if (leftovers > 0) {
-            _z_zbuf_copy_bytes(&new_zbuf, &ztm->_common._zbuf);
-        }
-        // Drop buffer & update
-        _z_zbuf_clear(&ztm->_common._zbuf);
-        ztm->_common._zbuf = new_zbuf;
-    }
-    return _Z_RES_OK;
+    return _z_transport_update_rx_buffer(&ztm->_common);
 }
 
 #else
@@ -20,6 +20,7 @@
 
 #include "zenoh-pico/config.h"
 #include "zenoh-pico/protocol/core.h"
+#include "zenoh-pico/transport/common/tx.h"
 #include "zenoh-pico/transport/transport.h"
 #include "zenoh-pico/transport/unicast/transport.h"
 #include "zenoh-pico/utils/logging.h"
@@ -91,6 +92,13 @@ bool _z_transport_start_batching(_z_transport_t *zt) {
     if (ztc->_batch_state == _Z_BATCHING_ACTIVE) {
         return false;
     }
+#if defined(_Z_TX_QUEUE)
+    // Batched messages are sent after those already queued. The writer task sends them with the tx mutex, so this is
+    // done before batching holds it.
+    if (_z_transport_tx_queue_drain(ztc, Z_CONGESTION_CONTROL_BLOCK) != _Z_RES_OK) {
+        return false;
+    }
+#endif
     ztc->_batch_count = 0;
     ztc->_batch_state = _Z_BATCHING_ACTIVE;
 
@@ -20,6 +20,7 @@
 #include "zenoh-pico/system/common/platform.h"
 #include "zenoh-pico/transport/common/tx.h"
 #include "zenoh-pico/transport/transport.h"
+#include "zenoh-pico/transport/unicast/read.h"
 #include "zenoh-pico/transport/unicast/transport.h"
 #include "zenoh-pico/utils/logging.h"
 
@@ -115,6 +116,9 @@ void *_zp_unicast_lease_task(void *ztu_arg) {
             if (next_lease <= 0) {
                 _z_transport_peer_unicast_slist_t *prev = NULL;
                 _z_transport_peer_unicast_slist_t *prev_drop = NULL;
+#if defined(_Z_SYS_NET_EVENT_SET)
+                uint8_t locked_workers = _zp_unicast_rx_workers_lock(ztu);
+#endif
                 _z_transport_peer_mutex_lock(&ztu->_common);
                 _z_transport_peer_unicast_slist_t *curr_list = ztu->_peers;
                 while (curr_list != NULL) {
@@ -140,10 +144,13 @@ void *_zp_unicast_lease_task(void *ztu_arg) {
                         _z_subscription_cache_invalidate(zs);
                         _z_queryable_cache_invalidate(zs);
                         _z_interest_peer_disconnected(zs, &curr_peer->common);
-                        ztu->_peers = _z_transport_peer_unicast_slist_drop_element(ztu->_peers, prev_drop);
+                        _z_transport_peer_unicast_drop(ztu, prev_drop);
                     }
                 }
                 _z_transport_peer_mutex_unlock(&ztu->_common);
+#if defined(_Z_SYS_NET_EVENT_SET)
+                _zp_unicast_rx_workers_unlock(ztu, locked_workers);
+#endif
                 next_lease = (int)ztu->_common._lease;
             }
             if (next_keep_alive <= 0) {
@@ -30,16 +30,23 @@
 #define _Z_UNICAST_PEER_READ_STATUS_SOCKET_CLOSED -2
 #define _Z_UNICAST_PEER_READ_STATUS_CRITICAL_ERROR -3
 
+// Recycled rx buffers of a transport or read worker
+#if Z_RX_BUFFER_POOL_SIZE > 0
+#define _Z_UNICAST_RX_POOL(owner) ((owner)->_zbuf_pool)
+#else
+#define _Z_UNICAST_RX_POOL(owner) NULL
+#endif
+
 #if Z_FEATURE_UNICAST_TRANSPORT == 1
 
 static z_result_t _z_unicast_process_messages(_z_transport_unicast_t *ztu, _z_transport_peer_unicast_t *peer,
-                                              size_t to_read) {
+                                              _z_zbuf_t *zbf, _z_zbuf_t *pool, size_t to_read) {
     // Wrap the main buffer to_read bytes
     _z_zbuf_t zbuf;
     if (peer->flow_state == _Z_FLOW_STATE_READY) {
         zbuf = _z_zbuf_view(&peer->flow_buff, to_read);
     } else {
-        zbuf = _z_zbuf_view(&ztu->_common._zbuf, to_read);
+        zbuf = _z_zbuf_view(zbf, to_read);
     }
 
     peer->common._received = true;
@@ -64,10 +71,10 @@ static z_result_t _z_unicast_process_messages(_z_transport_unicast_t *ztu, _z_tr
     if (peer->flow_state == _Z_FLOW_STATE_READY) {
         _z_zbuf_set_rpos(&peer->flow_buff, _z_zbuf_get_rpos(&peer->flow_buff) + to_read);
     } else {
-        _z_zbuf_set_rpos(&ztu->_common._zbuf, _z_zbuf_get_rpos(&ztu->_common._zbuf) + to_read);
+        _z_zbuf_set_rpos(zbf, _z_zbuf_get_rpos(zbf) + to_read);
     }
 
-    if (_z_unicast_update_rx_buffer(ztu) != _Z_RES_OK) {
+    if (_z_transport_update_rx_zbuf(zbf, pool) != _Z_RES_OK) {
         _Z_ERROR("Connection closed due to lack of memory to allocate rx buffer");
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
     }
@@ -130,7 +137,8 @@ z_result_t _zp_unicast_read(_z_transport_unicast_t *ztu, bool single_read) {
         // Retrieve data if any
         if (_z_unicast_client_read(ztu, curr_peer, &to_read)) {
             // Process data
-            _Z_RETURN_IF_ERR(_z_unicast_process_messages(ztu, curr_peer, to_read))
+            _Z_RETURN_IF_ERR(_z_unicast_process_messages(ztu, curr_peer, &ztu->_common._zbuf,
+                                                         _Z_UNICAST_RX_POOL(&ztu->_common), to_read))
         } else {
             return _Z_NO_DATA_PROCESSED;
         }
@@ -148,17 +156,17 @@ z_result_t _zp_unicast_read(_z_transport_unicast_t *ztu, bool single_read) {
 
 #if Z_FEATURE_MULTI_THREAD == 1 && Z_FEATURE_UNICAST_TRANSPORT == 1
 
-static z_result_t _z_unicast_handle_remaining_data(_z_transport_unicast_t *ztu, _z_transport_peer_unicast_t *peer,
-                                                   size_t extra_size, size_t *to_read, bool *message_to_process) {
+static z_result_t _z_unicast_handle_remaining_data(_z_zbuf_t *zbf, _z_transport_peer_unicast_t *peer, size_t extra_size,
+                                                   size_t *to_read, bool *message_to_process) {
     *message_to_process = false;
     if (extra_size < _Z_MSG_LEN_ENC_SIZE) {
         peer->flow_state = _Z_FLOW_STATE_PENDING_SIZE;
-        peer->flow_curr_size = _z_zbuf_read(&ztu->_common._zbuf);
+        peer->flow_curr_size = _z_zbuf_read(zbf);
         return _Z_RES_OK;
     }
     // Get stream size
-    *to_read = _z_read_stream_size(&ztu->_common._zbuf);
-    if (_z_zbuf_len(&ztu->_common._zbuf) < *to_read) {
+    *to_read = _z_read_stream_size(zbf);
+    if (_z_zbuf_len(zbf) < *to_read) {
         peer->flow_state = _Z_FLOW_STATE_PENDING_DATA;
         peer->flow_curr_size = (uint16_t)*to_read;
         peer->flow_buff = _z_zbuf_make(peer->flow_curr_size);
@@ -166,14 +174,15 @@ static z_result_t _z_unicast_handle_remaining_data(_z_transport_unicast_t *ztu,
             _Z_ERROR("Not enough memory to allocate flow state buffer");
             _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
         }
-        _z_zbuf_copy_bytes(&peer->flow_buff, &ztu->_common._zbuf);
+        _z_zbuf_copy_bytes(&peer->flow_buff, zbf);
         return _Z_RES_OK;
     }
     *message_to_process = true;
     return _Z_RES_OK;
 }
 
-static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_transport_peer_unicast_t *peer, size_t *to_read) {
+static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_zbuf_t *zbf, _z_transport_peer_unicast_t *peer,
+                                size_t *to_read) {
     // If we receive fragmented data we have to store it on a separate buffer
     size_t read_size = 0;
     switch (ztu->_common._link->_cap._flow) {
@@ -185,22 +194,22 @@ static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_transport_peer_u
                     _z_zbuf_clear(&peer->flow_buff);  // fall through
                 default:                              // fall through
                 case _Z_FLOW_STATE_INACTIVE:
-                    read_size = _z_link_socket_recv_zbuf(ztu->_common._link, &ztu->_common._zbuf, peer->_socket);
+                    read_size = _z_link_socket_recv_zbuf(ztu->_common._link, zbf, peer->_socket);
                     if (read_size == 0) {
                         _Z_DEBUG("Socket closed");
                         return _Z_UNICAST_PEER_READ_STATUS_SOCKET_CLOSED;
                     } else if (read_size == SIZE_MAX) {
                         return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
                     }
-                    if (_z_zbuf_len(&ztu->_common._zbuf) < _Z_MSG_LEN_ENC_SIZE) {
+                    if (_z_zbuf_len(zbf) < _Z_MSG_LEN_ENC_SIZE) {
                         peer->flow_state = _Z_FLOW_STATE_PENDING_SIZE;
-                        peer->flow_curr_size = _z_zbuf_read(&ztu->_common._zbuf);
+                        peer->flow_curr_size = _z_zbuf_read(zbf);
                         return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
                     }
                     // Get stream size
-                    *to_read = _z_read_stream_size(&ztu->_common._zbuf);
+                    *to_read = _z_read_stream_size(zbf);
                     // Read data if needed
-                    read_size = _z_zbuf_len(&ztu->_common._zbuf);
+                    read_size = _z_zbuf_len(zbf);
                     if (read_size < *to_read) {
                         peer->flow_state = _Z_FLOW_STATE_PENDING_DATA;
                         peer->flow_curr_size = (uint16_t)*to_read;
@@ -209,28 +218,28 @@ static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_transport_peer_u
                             _Z_ERROR("Not enough memory to allocate flow state buffer");
                             return _Z_UNICAST_PEER_READ_STATUS_CRITICAL_ERROR;
                         }
-                        _z_zbuf_copy_bytes(&peer->flow_buff, &ztu->_common._zbuf);
+                        _z_zbuf_copy_bytes(&peer->flow_buff, zbf);
                         return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
                     }
                     break;
                 case _Z_FLOW_STATE_PENDING_SIZE:
-                    read_size = _z_link_socket_recv_zbuf(ztu->_common._link, &ztu->_common._zbuf, peer->_socket);
+                    read_size = _z_link_socket_recv_zbuf(ztu->_common._link, zbf, peer->_socket);
                     if (read_size == 0) {
                         _Z_DEBUG("Socket closed");
                         return _Z_UNICAST_PEER_READ_STATUS_SOCKET_CLOSED;
                     } else if (read_size == SIZE_MAX) {
                         return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
                     }
-                    peer->flow_curr_size += (uint16_t)(_z_zbuf_read(&ztu->_common._zbuf) << 8);
+                    peer->flow_curr_size += (uint16_t)(_z_zbuf_read(zbf) << 8);
                     *to_read = peer->flow_curr_size;
-                    if (_z_zbuf_len(&ztu->_common._zbuf) < *to_read) {
+                    if (_z_zbuf_len(zbf) < *to_read) {
                         peer->flow_state = _Z_FLOW_STATE_PENDING_DATA;
                         peer->flow_buff = _z_zbuf_make(peer->flow_curr_size);
                         if (_z_zbuf_capacity(&peer->flow_buff) != peer->flow_curr_size) {
                             _Z_ERROR("Not enough memory to allocate flow state buffer");
                             return _Z_UNICAST_PEER_READ_STATUS_CRITICAL_ERROR;
                         }
-                        _z_zbuf_copy_bytes(&peer->flow_buff, &ztu->_common._zbuf);
+                        _z_zbuf_copy_bytes(&peer->flow_buff, zbf);
                         return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
                     }
                     break;
@@ -253,7 +262,7 @@ static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_transport_peer_u
 
             break;
         case Z_LINK_CAP_FLOW_DATAGRAM:
-            *to_read = _z_link_socket_recv_zbuf(ztu->_common._link, &ztu->_common._zbuf, peer->_socket);
+            *to_read = _z_link_socket_recv_zbuf(ztu->_common._link, zbf, peer->_socket);
             if (*to_read == SIZE_MAX) {
                 return _Z_UNICAST_PEER_READ_STATUS_PENDING_DATA;
             }
@@ -264,44 +273,63 @@ static int _z_unicast_peer_read(_z_transport_unicast_t *ztu, _z_transport_peer_u
     return _Z_UNICAST_PEER_READ_STATUS_OK;
 }
 
+// Reads and processes the data pending on a peer socket, drop_peer is set if the peer must be dropped
+static z_result_t _zp_unicast_process_peer(_z_transport_unicast_t *ztu, _z_zbuf_t *zbf, _z_zbuf_t *pool,
+                                           _z_transport_peer_unicast_t *curr_peer, bool *drop_peer) {
+    size_t to_read = 0;
+    // Read data from socket
+    int res = _z_unicast_peer_read(ztu, zbf, curr_peer, &to_read);
+    if (res == _Z_UNICAST_PEER_READ_STATUS_OK) {  // Messages to process
+        bool message_to_process = false;
+        do {
+            message_to_process = false;
+            // Process one message
+            if (_z_unicast_process_messages(ztu, curr_peer, zbf, pool, to_read) != _Z_RES_OK) {
+                // Failed to process, drop peer
+                _Z_ERROR("Dropping peer due to processing error");
+                *drop_peer = true;
+                break;
+            } else if (curr_peer->flow_state != _Z_FLOW_STATE_READY) {
+                // Process remaining data
+                size_t extra_data = _z_zbuf_len(zbf);
+                if (extra_data > 0) {
+                    _Z_RETURN_IF_ERR(
+                        _z_unicast_handle_remaining_data(zbf, curr_peer, extra_data, &to_read, &message_to_process));
+                }
+            }
+        } while (message_to_process);
+    } else if (res == _Z_UNICAST_PEER_READ_STATUS_SOCKET_CLOSED) {
+        *drop_peer = true;
+    } else if (res == _Z_UNICAST_PEER_READ_STATUS_CRITICAL_ERROR) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    return _Z_RES_OK;
+}
+
+static void _zp_unicast_drop_peer(_z_transport_unicast_t *ztu, _z_transport_peer_unicast_t *curr_peer,
+                                  _z_transport_peer_unicast_slist_t *prev_drop) {
+    _Z_DEBUG("Dropping peer");
+    _z_session_t *zs = _z_transport_common_get_session(&ztu->_common);
+    _z_subscription_cache_invalidate(zs);
+    _z_queryable_cache_invalidate(zs);
+    _z_interest_peer_disconnected(zs, &curr_peer->common);
+    _z_transport_peer_unicast_drop(ztu, prev_drop);
+}
+
 static z_result_t _zp_unicast_process_peer_event(_z_transport_unicast_t *ztu) {
     _z_transport_peer_mutex_lock(&ztu->_common);
     _z_transport_peer_unicast_slist_t *curr_list = ztu->_peers;
     _z_transport_peer_unicast_slist_t *prev = NULL;
-    _z_transport_peer_unicast_slist_t *prev_drop = NULL;
-    size_t to_read = 0;
     while (curr_list != NULL) {
         bool drop_peer = false;
         _z_transport_peer_unicast_t *curr_peer = _z_transport_peer_unicast_slist_value(curr_list);
         if (curr_peer->_pending) {
             curr_peer->_pending = false;
-            // Read data from socket
-            int res = _z_unicast_peer_read(ztu, curr_peer, &to_read);
-            if (res == _Z_UNICAST_PEER_READ_STATUS_OK) {  // Messages to process
-                bool message_to_process = false;
-                do {
-                    message_to_process = false;
-                    // Process one message
-                    if (_z_unicast_process_messages(ztu, curr_peer, to_read) != _Z_RES_OK) {
-                        // Failed to process, drop peer
-                        _Z_ERROR("Dropping peer due to processing error");
-                        drop_peer = true;
-                        prev_drop = prev;
-                        break;
-                    } else if (curr_peer->flow_state != _Z_FLOW_STATE_READY) {
-                        // Process remaining data
-                        size_t extra_data = _z_zbuf_len(&ztu->_common._zbuf);
-                        if (extra_data > 0) {
-                            _Z_RETURN_IF_ERR(_z_unicast_handle_remaining_data(ztu, curr_peer, extra_data, &to_read,
-                                                                              &message_to_process));
-                        }
-                    }
-                } while (message_to_process);
-            } else if (res == _Z_UNICAST_PEER_READ_STATUS_SOCKET_CLOSED) {
-                drop_peer = true;
-                prev_drop = prev;
-            } else if (res == _Z_UNICAST_PEER_READ_STATUS_CRITICAL_ERROR) {
-                _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+            z_result_t ret = _zp_unicast_process_peer(ztu, &ztu->_common._zbuf, _Z_UNICAST_RX_POOL(&ztu->_common),
+                                                      curr_peer, &drop_peer);
+            if (ret != _Z_RES_OK) {
+                _z_transport_peer_mutex_unlock(&ztu->_common);
+                return ret;
             }
         }
         // Update previous only if current node is not dropped
@@ -312,12 +340,7 @@ static z_result_t _zp_unicast_process_peer_event(_z_transport_unicast_t *ztu) {
         curr_list = _z_transport_peer_unicast_slist_next(curr_list);
         // Drop peer if needed
         if (drop_peer) {
-            _Z_DEBUG("Dropping peer");
-            _z_session_t *zs = _z_transport_common_get_session(&ztu->_common);
-            _z_subscription_cache_invalidate(zs);
-            _z_queryable_cache_invalidate(zs);
-            _z_interest_peer_disconnected(zs, &curr_peer->common);
-            ztu->_peers = _z_transport_peer_unicast_slist_drop_element(ztu->_peers, prev_drop);
+            _zp_unicast_drop_peer(ztu, curr_peer, prev);
         }
         _z_zbuf_reset(&ztu->_common._zbuf);
     }
@@ -325,6 +348,214 @@ static z_result_t _zp_unicast_process_peer_event(_z_transport_unicast_t *ztu) {
     return _Z_RES_OK;
 }
 
+#if defined(_Z_SYS_NET_EVENT_SET)
+// Returns the list node preceding peer, sets found to false if peer isn't in the list anymore
+static _z_transport_peer_unicast_slist_t *_zp_unicast_find_prev_peer(_z_transport_unicast_t *ztu,
+                                                                     const _z_transport_peer_unicast_t *peer,
+                                                                     bool *found) {
+    _z_transport_peer_unicast_slist_t *prev = NULL;
+    _z_transport_peer_unicast_slist_t *curr_list = ztu->_peers;
+    while (curr_list != NULL) {
+        if (_z_transport_peer_unicast_slist_value(curr_list) == peer) {
+            *found = true;
+            return prev;
+        }
+        prev = curr_list;
+        curr_list = _z_transport_peer_unicast_slist_next(curr_list);
+    }
+    *found = false;
+    return NULL;
+}
+
+// Waits for and processes the ready sockets of the worker peers only, instead of scanning all peers
+static z_result_t _zp_unicast_rx_worker_process(_z_transport_unicast_rx_worker_t *worker) {
+    _z_transport_unicast_t *ztu = worker->_ztu;
+    void *ready[_Z_SYS_NET_EVENT_SET_WAIT_MAX];
+    size_t count = 0;
+    _z_mutex_lock(&worker->_mutex);
+    size_t gen = worker->_event_set_gen;
+    _z_mutex_unlock(&worker->_mutex);
+    if (_z_socket_event_set_wait(&worker->_event_set, ready, _Z_SYS_NET_EVENT_SET_WAIT_MAX, &count) != _Z_RES_OK) {
+        return _Z_RES_OK;  // Might need to process errors other than timeout
+    }
+    // The worker mutex keeps its peers from being dropped, the peer list may still grow
+    _z_mutex_lock(&worker->_mutex);
+    bool dropped = (worker->_event_set_gen != gen);
+    for (size_t i = 0; i < count; i++) {
+        _z_transport_peer_unicast_t *curr_peer = (_z_transport_peer_unicast_t *)ready[i];
+        bool found = true;
+        if (dropped) {
+            // Peers dropped during the wait must not be accessed, and a new peer allocated at the same address may
+            // belong to another worker which would process it concurrently
+            _z_transport_peer_mutex_lock(&ztu->_common);
+            _zp_unicast_find_prev_peer(ztu, curr_peer, &found);
+            found = found && (_z_transport_unicast_rx_worker_of(ztu, curr_peer) == worker);
+            _z_transport_peer_mutex_unlock(&ztu->_common);
+        }
+        if (!found) {
+            continue;
+        }
+        bool drop_peer = false;
+        z_result_t ret =
+            _zp_unicast_process_peer(ztu, &worker->_zbuf, _Z_UNICAST_RX_POOL(worker), curr_peer, &drop_peer);
+        if (ret != _Z_RES_OK) {
+            _z_mutex_unlock(&worker->_mutex);
+            return ret;
+        }
+        if (drop_peer) {
+            // Only a dropped peer pays for a list scan
+            _z_transport_peer_mutex_lock(&ztu->_common);
+            _z_transport_peer_unicast_slist_t *prev_drop = _zp_unicast_find_prev_peer(ztu, curr_peer, &found);
+            _zp_unicast_drop_peer(ztu, curr_peer, prev_drop);
+            _z_transport_peer_mutex_unlock(&ztu->_common);
+        }
+        _z_zbuf_reset(&worker->_zbuf);
+    }
+    _z_mutex_unlock(&worker->_mutex);
+    return _Z_RES_OK;
+}
+
+static void *_zp_unicast_rx_worker_task(void *worker_arg) {
+    _z_transport_unicast_rx_worker_t *worker = (_z_transport_unicast_rx_worker_t *)worker_arg;
+    _z_transport_unicast_t *ztu = worker->_ztu;
+    while (ztu->_common._read_task_running) {
+        if (_zp_unicast_rx_worker_process(worker) != _Z_RES_OK) {
+            ztu->_common._read_task_running = false;
+        }
+    }
+    return NULL;
+}
+
+// Runs the first worker in the read task along with the extra ones, until the read task is stopped
+static void _zp_unicast_rx_workers_run(_z_transport_unicast_t *ztu) {
+    size_t extra_nb = (size_t)ztu->_rx_worker_nb - 1;
+    _z_task_t *tasks = NULL;
+    size_t started = 0;
+    if (extra_nb > 0) {
+        tasks = (_z_task_t *)z_malloc(extra_nb * sizeof(_z_task_t));
+        if (tasks == NULL) {
+            _Z_ERROR("Failed to allocate read workers, their peers won't be read");
+            extra_nb = 0;
+        }
+    }
+    for (; started < extra_nb; started++) {
+        if (_z_task_init(&tasks[started], ztu->_rx_worker_attr, _zp_unicast_rx_worker_task,
+                         &ztu->_rx_workers[started + 1]) != _Z_RES_OK) {
+            _Z_ERROR("Failed to start read worker, its peers won't be read");
+            break;
+        }
+    }
+    _zp_unicast_rx_worker_task(&ztu->_rx_workers[0]);
+    for (size_t i = 0; i < started; i++) {
+        _z_task_join(&tasks[i]);
+    }
+    z_free(tasks);
+}
+
+static void _zp_unicast_rx_worker_clear(_z_transport_unicast_rx_worker_t *worker) {
+    _z_socket_event_set_clear(&worker->_event_set);
+    _z_mutex_drop(&worker->_mutex);
+    _z_zbuf_clear(&worker->_zbuf);
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE; i++) {
+        _z_zbuf_clear(&worker->_zbuf_pool[i]);
+    }
+#endif
+}
+
+static z_result_t _zp_unicast_rx_worker_init(_z_transport_unicast_t *ztu, _z_transport_unicast_rx_worker_t *worker) {
+    worker->_ztu = ztu;
+    worker->_event_set_gen = 0;
+    worker->_zbuf = _z_zbuf_make(_z_zbuf_capacity(&ztu->_common._zbuf));
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE; i++) {
+        worker->_zbuf_pool[i] = _z_zbuf_null();
+    }
+#endif
+    if (_z_zbuf_capacity(&worker->_zbuf) != _z_zbuf_capacity(&ztu->_common._zbuf)) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    _Z_CLEAN_RETURN_IF_ERR(_z_socket_event_set_init(&worker->_event_set), _z_zbuf_clear(&worker->_zbuf));
+    _Z_CLEAN_RETURN_IF_ERR(_z_mutex_init(&worker->_mutex), _z_zbuf_clear(&worker->_zbuf);
+                           _z_socket_event_set_clear(&worker->_event_set));
+    return _Z_RES_OK;
+}
+
+// Creates the read workers and registers the sockets of the peers already known
+static z_result_t _zp_unicast_rx_workers_create(_z_transport_unicast_t *ztu, uint8_t worker_nb) {
+    _z_transport_unicast_rx_worker_t *workers =
+        (_z_transport_unicast_rx_worker_t *)z_malloc(worker_nb * sizeof(_z_transport_unicast_rx_worker_t));
+    if (workers == NULL) {
+        _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
+    }
+    z_result_t ret = _Z_RES_OK;
+    uint8_t init_nb = 0;
+    while ((init_nb < worker_nb) && (ret == _Z_RES_OK)) {
+        ret = _zp_unicast_rx_worker_init(ztu, &workers[init_nb]);
+        if (ret == _Z_RES_OK) {
+            init_nb++;
+        }
+    }
+    if (ret != _Z_RES_OK) {
+        for (uint8_t i = 0; i < init_nb; i++) {
+            _zp_unicast_rx_worker_clear(&workers[i]);
+        }
+        z_free(workers);
+        return ret;
+    }
+    _z_transport_peer_mutex_lock(&ztu->_common);
+    ztu->_rx_workers = workers;
+    ztu->_rx_worker_nb = worker_nb;
+    _z_transport_peer_unicast_slist_t *curr_list = ztu->_peers;
+    while ((curr_list != NULL) && (ret == _Z_RES_OK)) {
+        _z_transport_peer_unicast_t *peer = _z_transport_peer_unicast_slist_value(curr_list);
+        ret = _z_socket_event_set_add(&_z_transport_unicast_rx_worker_of(ztu, peer)->_event_set, &peer->_socket, peer);
+        curr_list = _z_transport_peer_unicast_slist_next(curr_list);
+    }
+    if (ret != _Z_RES_OK) {
+        // Registered sockets go away with the event sets
+        ztu->_rx_workers = NULL;
+        ztu->_rx_worker_nb = 0;
+        for (uint8_t i = 0; i < worker_nb; i++) {
+            _zp_unicast_rx_worker_clear(&workers[i]);
+        }
+        z_free(workers);
+    }
+    _z_transport_peer_mutex_unlock(&ztu->_common);
+    return ret;
+}
+
+uint8_t _zp_unicast_rx_workers_lock(_z_transport_unicast_t *ztu) {
+    // Workers are never removed once created, but may be created meanwhile
+    _z_transport_peer_mutex_lock(&ztu->_common);
+    _z_transport_unicast_rx_worker_t *workers = ztu->_rx_workers;
+    uint8_t worker_nb = (workers != NULL) ? ztu->_rx_worker_nb : 0;
+    _z_transport_peer_mutex_unlock(&ztu->_common);
+    for (uint8_t i = 0; i < worker_nb; i++) {
+        _z_mutex_lock(&workers[i]._mutex);
+    }
+    return worker_nb;
+}
+
+void _zp_unicast_rx_workers_unlock(_z_transport_unicast_t *ztu, uint8_t locked_nb) {
+    for (uint8_t i = locked_nb; i > 0; i--) {
+        _z_mutex_unlock(&ztu->_rx_workers[i - 1]._mutex);
+    }
+}
+
+void _zp_unicast_rx_workers_free(_z_transport_unicast_t *ztu) {
+    if (ztu->_rx_workers == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < ztu->_rx_worker_nb; i++) {
+        _zp_unicast_rx_worker_clear(&ztu->_rx_workers[i]);
+    }
+    z_free(ztu->_rx_workers);
+    ztu->_rx_workers = NULL;
+    ztu->_rx_worker_nb = 0;
+}
+#endif
+
 void *_zp_unicast_read_task(void *ztu_arg) {
     _z_transport_unicast_t *ztu = (_z_transport_unicast_t *)ztu_arg;
 
@@ -339,6 +570,13 @@ void *_zp_unicast_read_task(void *ztu_arg) {
         curr_peer = _z_transport_peer_unicast_slist_value(ztu->_peers);
         assert(curr_peer != NULL);
     }
+#if Z_FEATURE_UNICAST_PEER == 1 && defined(_Z_SYS_NET_EVENT_SET)
+    if ((mode == Z_WHATAMI_PEER) && (ztu->_rx_workers != NULL)) {
+        _zp_unicast_rx_workers_run(ztu);
+        _z_mutex_unlock(&ztu->_common._mutex_rx);
+        return NULL;
+    }
+#endif
     while (ztu->_common._read_task_running) {
 #if Z_FEATURE_UNICAST_PEER == 1
         if (mode == Z_WHATAMI_PEER) {
@@ -365,7 +603,8 @@ void *_zp_unicast_read_task(void *ztu_arg) {
                 continue;
             }
             // Process data
-            if (_z_unicast_process_messages(ztu, curr_peer, to_read) != _Z_RES_OK) {
+            if (_z_unicast_process_messages(ztu, curr_peer, &ztu->_common._zbuf, _Z_UNICAST_RX_POOL(&ztu->_common),
+                                            to_read) != _Z_RES_OK) {
                 ztu->_common._read_task_running = false;
                 continue;
             }
@@ -375,17 +614,28 @@ void *_zp_unicast_read_task(void *ztu_arg) {
     return NULL;
 }
 
-z_result_t _zp_unicast_start_read_task(_z_transport_t *zt, z_task_attr_t *attr, _z_task_t *task) {
+z_result_t _zp_unicast_start_read_task(_z_transport_t *zt, z_task_attr_t *attr, _z_task_t *task, uint8_t worker_nb) {
+    _z_transport_unicast_t *ztu = &zt->_transport._unicast;
+#if Z_FEATURE_UNICAST_PEER == 1 && defined(_Z_SYS_NET_EVENT_SET)
+    if ((_z_transport_common_get_session(&ztu->_common)->_mode == Z_WHATAMI_PEER) && (ztu->_rx_workers == NULL)) {
+        if (_zp_unicast_rx_workers_create(ztu, (worker_nb > 0) ? worker_nb : 1) != _Z_RES_OK) {
+            _Z_INFO("Failed to create read workers, peer sockets will be polled by a single task");
+        }
+    }
+    ztu->_rx_worker_attr = attr;
+#else
+    _ZP_UNUSED(worker_nb);
+#endif
     // Init memory
     (void)memset(task, 0, sizeof(_z_task_t));
-    zt->_transport._unicast._common._read_task_running = true;  // Init before z_task_init for concurrency issue
+    ztu->_common._read_task_running = true;  // Init before z_task_init for concurrency issue
     // Init task
-    if (_z_task_init(task, attr, _zp_unicast_read_task, &zt->_transport._unicast) != _Z_RES_OK) {
-        zt->_transport._unicast._common._read_task_running = false;
+    if (_z_task_init(task, attr, _zp_unicast_read_task, ztu) != _Z_RES_OK) {
+        ztu->_common._read_task_running = false;
         _Z_ERROR_RETURN(_Z_ERR_SYSTEM_TASK_FAILED);
     }
     // Attach task
-    zt->_transport._unicast._common._read_task = task;
+    ztu->_common._read_task = task;
     return _Z_RES_OK;
 }
 
@@ -401,10 +651,11 @@ void *_zp_unicast_read_task(void *ztu_arg) {
     return NULL;
 }
 
-z_result_t _zp_unicast_start_read_task(_z_transport_t *zt, void *attr, void *task) {
+z_result_t _zp_unicast_start_read_task(_z_transport_t *zt, void *attr, void *task, uint8_t worker_nb) {
     _ZP_UNUSED(zt);
     _ZP_UNUSED(attr);
     _ZP_UNUSED(task);
+    _ZP_UNUSED(worker_nb);
     _Z_ERROR_RETURN(_Z_ERR_TRANSPORT_NOT_AVAILABLE);
 }
 
@@ -102,7 +102,7 @@ static z_result_t _z_unicast_handle_frame(_z_transport_unicast_t *ztu, uint8_t h
             peer->_sn_rx_reliable = msg->_sn;
         } else {
 #if Z_FEATURE_FRAGMENTATION == 1
-            _z_wbuf_clear(&peer->common._dbuf_reliable);
+            _z_dbuf_clear(&peer->common._dbuf_reliable);
             peer->common._state_reliable = _Z_DBUF_STATE_NULL;
 #endif
             _Z_INFO("Reliable message dropped because it is out of order");
@@ -115,7 +115,7 @@ static z_result_t _z_unicast_handle_frame(_z_transport_unicast_t *ztu, uint8_t h
             peer->_sn_rx_best_effort = msg->_sn;
         } else {
 #if Z_FEATURE_FRAGMENTATION == 1
-            _z_wbuf_clear(&peer->common._dbuf_best_effort);
+            _z_dbuf_clear(&peer->common._dbuf_best_effort);
             peer->common._state_best_effort = _Z_DBUF_STATE_NULL;
 #endif
             _Z_INFO("Best effort message dropped because it is out of order");
@@ -127,11 +127,16 @@ static z_result_t _z_unicast_handle_frame(_z_transport_unicast_t *ztu, uint8_t h
     // From this point, memory cleaning must be handled by the network message layer
     _z_network_message_t curr_nmsg = {0};
     _z_arc_slice_t arcs = _z_arc_slice_empty();
+    _z_arena_t *arena = &peer->common._rx_arena;
     while (_z_zbuf_len(msg->_payload) > 0) {
-        _Z_RETURN_IF_ERR(_z_network_message_decode(&curr_nmsg, msg->_payload, &arcs, (uintptr_t)&peer->common));
+        _Z_CLEAN_RETURN_IF_ERR(_z_network_message_decode(&curr_nmsg, msg->_payload, &arcs, (uintptr_t)&peer->common),
+                               _z_arena_reset(arena));
         curr_nmsg._reliability = tmsg_reliability;
-        _Z_RETURN_IF_ERR(_z_handle_network_message(&ztu->_common, &curr_nmsg, &peer->common));
+        _Z_CLEAN_RETURN_IF_ERR(_z_handle_network_message(&ztu->_common, &curr_nmsg, &peer->common),
+                               _z_arena_reset(arena));
     }
+    // Nothing references the transient data of the batch once it is dispatched
+    _z_arena_reset(arena);
     return _Z_RES_OK;
 }
 
@@ -139,7 +144,7 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
                                                    _z_t_msg_fragment_t *msg, _z_transport_peer_unicast_t *peer) {
     z_result_t ret = _Z_RES_OK;
 #if Z_FEATURE_FRAGMENTATION == 1
-    _z_wbuf_t *dbuf;
+    _z_dbuf_t *dbuf;
     uint8_t *dbuf_state;
     z_reliability_t tmsg_reliability;
     bool consecutive;
@@ -156,7 +161,7 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
             dbuf = &peer->common._dbuf_reliable;
             dbuf_state = &peer->common._state_reliable;
         } else {
-            _z_wbuf_clear(&peer->common._dbuf_reliable);
+            _z_dbuf_clear(&peer->common._dbuf_reliable);
             peer->common._state_reliable = _Z_DBUF_STATE_NULL;
             _Z_INFO("Reliable message dropped because it is out of order");
             return _Z_RES_OK;
@@ -170,15 +175,15 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
             dbuf = &peer->common._dbuf_best_effort;
             dbuf_state = &peer->common._state_best_effort;
         } else {
-            _z_wbuf_clear(&peer->common._dbuf_best_effort);
+            _z_dbuf_clear(&peer->common._dbuf_best_effort);
             peer->common._state_best_effort = _Z_DBUF_STATE_NULL;
             _Z_INFO("Best effort message dropped because it is out of order");
             return _Z_RES_OK;
         }
     }
     // Check consecutive SN
-    if (!consecutive && _z_wbuf_len(dbuf) > 0) {
-        _z_wbuf_clear(dbuf);
+    if (!consecutive && _z_dbuf_len(dbuf) > 0) {
+        _z_dbuf_clear(dbuf);
         *dbuf_state = _Z_DBUF_STATE_NULL;
         _Z_INFO("Defragmentation buffer dropped because non-consecutive fragments received");
         return _Z_RES_OK;
@@ -186,33 +191,29 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
     // Handle fragment markers
     if (_Z_PATCH_HAS_FRAGMENT_MARKERS(peer->common._patch)) {
         if (msg->first) {
-            _z_wbuf_reset(dbuf);
-        } else if (_z_wbuf_len(dbuf) == 0) {
+            _z_dbuf_reset(dbuf);
+        } else if (_z_dbuf_len(dbuf) == 0) {
             _Z_INFO("First fragment received without the start marker");
             return _Z_RES_OK;
         }
         if (msg->drop) {
-            _z_wbuf_reset(dbuf);
+            _z_dbuf_reset(dbuf);
             return _Z_RES_OK;
         }
     }
     // Allocate buffer if needed
     if (*dbuf_state == _Z_DBUF_STATE_NULL) {
-        *dbuf = _z_wbuf_make(Z_FRAG_MAX_SIZE, false);
-        if (_z_wbuf_capacity(dbuf) != Z_FRAG_MAX_SIZE) {
-            _Z_ERROR("Not enough memory to allocate transport defragmentation buffer");
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
+        _Z_RETURN_IF_ERR(_z_dbuf_init(dbuf, ztu->_common._frag_max_size));
         *dbuf_state = _Z_DBUF_STATE_INIT;
     }
     // Process fragment data
     if (*dbuf_state == _Z_DBUF_STATE_INIT) {
         // Check overflow
-        if ((_z_wbuf_len(dbuf) + msg->_payload.len) > Z_FRAG_MAX_SIZE) {
+        if ((_z_dbuf_len(dbuf) + msg->_payload.len) > ztu->_common._frag_max_size) {
             *dbuf_state = _Z_DBUF_STATE_OVERFLOW;
         } else {
             // Fill buffer
-            _z_wbuf_write_bytes(dbuf, msg->_payload.start, 0, msg->_payload.len);
+            _Z_RETURN_IF_ERR(_z_dbuf_append(dbuf, msg));
         }
     }
     // Process final fragment
@@ -220,34 +221,28 @@ static z_result_t _z_unicast_handle_fragment_inner(_z_transport_unicast_t *ztu,
         // Drop message if it exceeds the fragmentation size
         if (*dbuf_state == _Z_DBUF_STATE_OVERFLOW) {
             _Z_INFO("Fragment dropped because defragmentation buffer has overflown");
-            _z_wbuf_clear(dbuf);
+            _z_dbuf_clear(dbuf);
             *dbuf_state = _Z_DBUF_STATE_NULL;
             return _Z_RES_OK;
         }
-        // Convert the defragmentation buffer into a decoding buffer
-        _z_zbuf_t zbf = _z_wbuf_moved_as_zbuf(dbuf);
-        if (_z_zbuf_capacity(&zbf) == 0) {
-            _Z_ERROR("Failed to convert defragmentation buffer into a decoding buffer!");
-            _z_wbuf_clear(dbuf);
-            *dbuf_state = _Z_DBUF_STATE_NULL;
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
         // Decode message
         _z_zenoh_message_t zm = {0};
         _z_arc_slice_t arcs = _z_arc_slice_empty();
-        ret = _z_network_message_decode(&zm, &zbf, &arcs, (uintptr_t)&peer->common);
+        _z_zbuf_t zbf;
+        ret = _z_dbuf_decode(dbuf, &zbf, &zm, &arcs, (uintptr_t)&peer->common);
+        *dbuf_state = _Z_DBUF_STATE_NULL;
         zm._reliability = tmsg_reliability;
         if (ret == _Z_RES_OK) {
             // Memory clear of the network message data must be handled by the network message layer
             _z_handle_network_message(&ztu->_common, &zm, &peer->common);
-        } else {
+            _z_arena_reset(&peer->common._rx_arena);
+        } else if (ret != _Z_ERR_SYSTEM_OUT_OF_MEMORY) {
             _Z_INFO("Failed to decode defragmented message");
             _Z_ERROR_LOG(_Z_ERR_MESSAGE_DESERIALIZATION_FAILED);
             ret = _Z_ERR_MESSAGE_DESERIALIZATION_FAILED;
         }
         // Free the decoding buffer
         _z_zbuf_clear(&zbf);
-        *dbuf_state = _Z_DBUF_STATE_NULL;
     }
 #else
     _ZP_UNUSED(ztu);
@@ -318,24 +313,7 @@ z_result_t _z_unicast_handle_transport_message(_z_transport_unicast_t *ztu, _z_t
 }
 
 z_result_t _z_unicast_update_rx_buffer(_z_transport_unicast_t *ztu) {
-    // Check if user or defragment buffer took ownership of buffer
-    if (_z_zbuf_get_ref_count(&ztu->_common._zbuf) != 1) {
-        // Allocate a new buffer
-        size_t buff_capacity = _z_zbuf_capacity(&ztu->_common._zbuf);
-        _z_zbuf_t new_zbuf = _z_zbuf_make(buff_capacity);
-        if (_z_zbuf_capacity(&new_zbuf) != buff_capacity) {
-            _Z_ERROR_RETURN(_Z_ERR_SYSTEM_OUT_OF_MEMORY);
-        }
-        // Recopy leftover bytes
-        size_t leftovers = _z_zbuf_len(&ztu->_common._zbuf);
-        if (leftovers > 0) {
-            _z_zbuf_copy_bytes(&new_zbuf, &ztu->_common._zbuf);
-        }
-        // Drop buffer & update
-        _z_zbuf_clear(&ztu->_common._zbuf);
-        ztu->_common._zbuf = new_zbuf;
-    }
-    return _Z_RES_OK;
+    return _z_transport_update_rx_buffer(&ztu->_common);
 }
 
 #else
@@ -24,6 +24,7 @@
 #include "zenoh-pico/transport/common/rx.h"
 #include "zenoh-pico/transport/common/tx.h"
 #include "zenoh-pico/transport/transport.h"
+#include "zenoh-pico/transport/unicast/read.h"
 #include "zenoh-pico/transport/unicast/transport.h"
 #include "zenoh-pico/transport/utils.h"
 #include "zenoh-pico/utils/logging.h"
@@ -35,6 +36,24 @@ static z_result_t _z_unicast_transport_create_inner(_z_transport_unicast_t *ztu,
 #if Z_FEATURE_BATCHING == 1
     ztu->_common._batch_state = _Z_BATCHING_IDLE;
     ztu->_common._batch_count = 0;
+    for (uint8_t i = 0; i < Z_PRIORITIES_NUM; i++) {
+        ztu->_common._batch_lanes[i] = (_z_transport_tx_lane_t){0};
+    }
+#endif
+#if Z_RX_BUFFER_POOL_SIZE > 0
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE; i++) {
+        ztu->_common._zbuf_pool[i] = _z_zbuf_null();
+    }
+#endif
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    ztu->_common._retx_window = NULL;
+#endif
+#if Z_FEATURE_FRAGMENTATION == 1
+    ztu->_common._frag_max_size = Z_FRAG_MAX_SIZE;
+#endif
+#if defined(_Z_TX_QUEUE)
+    ztu->_common._tx_queue = NULL;
+    ztu->_common._tx_queue_enabled = false;
 #endif
 
 #if Z_FEATURE_MULTI_THREAD == 1
@@ -101,9 +120,23 @@ z_result_t _z_unicast_transport_create(_z_transport_t *zt, _z_link_t *zl,
     return ret;
 }
 
+#if Z_FEATURE_SHM == 1
+// Shared memory payloads are only exchanged with the nodes announcing the same host id
+static bool _z_unicast_shm_host_match(const _z_t_msg_init_t *remote, const uint8_t *local_host_id) {
+    return remote->_shm && (memcmp(remote->_shm_host_id, local_host_id, _Z_SHM_HOST_ID_LEN) == 0);
+}
+#endif
+
 static z_result_t _z_unicast_handshake_open(_z_transport_unicast_establish_param_t *param, const _z_link_t *zl,
                                             const _z_id_t *local_zid, z_whatami_t mode, _z_sys_net_socket_t *socket) {
     _z_transport_message_t ism = _z_t_msg_make_init_syn(mode, *local_zid);
+#if Z_FEATURE_SHM == 1
+    uint8_t host_id[_Z_SHM_HOST_ID_LEN];
+    param->_shm = false;
+    if (_z_shm_host_id(host_id, _Z_SHM_HOST_ID_LEN) == _Z_RES_OK) {
+        _z_t_msg_init_set_shm(&ism, host_id);
+    }
+#endif
     param->_seq_num_res = ism._body._init._seq_num_res;  // The announced sn resolution
     param->_req_id_res = ism._body._init._req_id_res;    // The announced req id resolution
     param->_batch_size = ism._body._init._batch_size;    // The announced batch size
@@ -153,6 +186,9 @@ static z_result_t _z_unicast_handshake_open(_z_transport_unicast_establish_param
         _Z_ERROR_LOG(_Z_ERR_GENERIC);
         ret = _Z_ERR_GENERIC;
     }
+#endif
+#if Z_FEATURE_SHM == 1
+    param->_shm = ism._body._init._shm && _z_unicast_shm_host_match(&iam._body._init, host_id);
 #endif
     if (ret != _Z_RES_OK) {
         _z_t_msg_clear(&iam);
@@ -243,6 +279,14 @@ z_result_t _z_unicast_handshake_listen(_z_transport_unicast_establish_param_t *p
     if (iam._body._init._patch > tmsg._body._init._patch) {
         iam._body._init._patch = tmsg._body._init._patch;
     }
+#endif
+#if Z_FEATURE_SHM == 1
+    uint8_t host_id[_Z_SHM_HOST_ID_LEN];
+    param->_shm = (_z_shm_host_id(host_id, _Z_SHM_HOST_ID_LEN) == _Z_RES_OK) &&
+                  _z_unicast_shm_host_match(&tmsg._body._init, host_id);
+    if (param->_shm) {
+        _z_t_msg_init_set_shm(&iam, host_id);
+    }
 #endif
     param->_seq_num_res = iam._body._init._seq_num_res;
     param->_req_id_res = iam._body._init._req_id_res;
@@ -330,6 +374,9 @@ z_result_t _z_unicast_transport_close(_z_transport_unicast_t *ztu, uint8_t reaso
 void _z_unicast_transport_clear(_z_transport_unicast_t *ztu, bool detach_tasks) {
     _z_common_transport_clear(&ztu->_common, detach_tasks);
     _z_transport_peer_unicast_slist_free(&ztu->_peers);
+#if defined(_Z_SYS_NET_EVENT_SET)
+    _zp_unicast_rx_workers_free(ztu);
+#endif
 }
 
 #else
@@ -14,8 +14,306 @@
 
 #include "zenoh-pico/utils/checksum.h"
 
+#include "zenoh-pico/config.h"
+
 #define __CRC_POLYNOMIAL 0x04C11DB7
 
+#if Z_CRC32_SLICE_BY_8 == 1
+// Generated from __CRC_POLYNOMIAL, entry [k][b] is the crc contribution of byte b followed by k bytes
+static const uint32_t _z_crc32_table[8][256] = {
+    {
+        0x00000000, 0x06233697, 0x05C45641, 0x03E760D6, 0x020A97ED, 0x0429A17A, 0x07CEC1AC, 0x01EDF73B,
+        0x04152FDA, 0x0236194D, 0x01D1799B, 0x07F24F0C, 0x061FB837, 0x003C8EA0, 0x03DBEE76, 0x05F8D8E1,
+        0x01A864DB, 0x078B524C, 0x046C329A, 0x024F040D, 0x03A2F336, 0x0581C5A1, 0x0666A577, 0x004593E0,
+        0x05BD4B01, 0x039E7D96, 0x00791D40, 0x065A2BD7, 0x07B7DCEC, 0x0194EA7B, 0x02738AAD, 0x0450BC3A,
+        0x0350C9B6, 0x0573FF21, 0x06949FF7, 0x00B7A960, 0x015A5E5B, 0x077968CC, 0x049E081A, 0x02BD3E8D,
+        0x0745E66C, 0x0166D0FB, 0x0281B02D, 0x04A286BA, 0x054F7181, 0x036C4716, 0x008B27C0, 0x06A81157,
+        0x02F8AD6D, 0x04DB9BFA, 0x073CFB2C, 0x011FCDBB, 0x00F23A80, 0x06D10C17, 0x05366CC1, 0x03155A56,
+        0x06ED82B7, 0x00CEB420, 0x0329D4F6, 0x050AE261, 0x04E7155A, 0x02C423CD, 0x0123431B, 0x0700758C,
+        0x06A1936C, 0x0082A5FB, 0x0365C52D, 0x0546F3BA, 0x04AB0481, 0x02883216, 0x016F52C0, 0x074C6457,
+        0x02B4BCB6, 0x04978A21, 0x0770EAF7, 0x0153DC60, 0x00BE2B5B, 0x069D1DCC, 0x057A7D1A, 0x03594B8D,
+        0x0709F7B7, 0x012AC120, 0x02CDA1F6, 0x04EE9761, 0x0503605A, 0x032056CD, 0x00C7361B, 0x06E4008C,
+        0x031CD86D, 0x053FEEFA, 0x06D88E2C, 0x00FBB8BB, 0x01164F80, 0x07357917, 0x04D219C1, 0x02F12F56,
+        0x05F15ADA, 0x03D26C4D, 0x00350C9B, 0x06163A0C, 0x07FBCD37, 0x01D8FBA0, 0x023F9B76, 0x041CADE1,
+        0x01E47500, 0x07C74397, 0x04202341, 0x020315D6, 0x03EEE2ED, 0x05CDD47A, 0x062AB4AC, 0x0009823B,
+        0x04593E01, 0x027A0896, 0x019D6840, 0x07BE5ED7, 0x0653A9EC, 0x00709F7B, 0x0397FFAD, 0x05B4C93A,
+        0x004C11DB, 0x066F274C, 0x0588479A, 0x03AB710D, 0x02468636, 0x0465B0A1, 0x0782D077, 0x01A1E6E0,
+        0x04C11DB7, 0x02E22B20, 0x01054BF6, 0x07267D61, 0x06CB8A5A, 0x00E8BCCD, 0x030FDC1B, 0x052CEA8C,
+        0x00D4326D, 0x06F704FA, 0x0510642C, 0x033352BB, 0x02DEA580, 0x04FD9317, 0x071AF3C1, 0x0139C556,
+        0x0569796C, 0x034A4FFB, 0x00AD2F2D, 0x068E19BA, 0x0763EE81, 0x0140D816, 0x02A7B8C0, 0x04848E57,
+        0x017C56B6, 0x075F6021, 0x04B800F7, 0x029B3660, 0x0376C15B, 0x0555F7CC, 0x06B2971A, 0x0091A18D,
+        0x0791D401, 0x01B2E296, 0x02558240, 0x0476B4D7, 0x059B43EC, 0x03B8757B, 0x005F15AD, 0x067C233A,
+        0x0384FBDB, 0x05A7CD4C, 0x0640AD9A, 0x00639B0D, 0x018E6C36, 0x07AD5AA1, 0x044A3A77, 0x02690CE0,
+        0x0639B0DA, 0x001A864D, 0x03FDE69B, 0x05DED00C, 0x04332737, 0x021011A0, 0x01F77176, 0x07D447E1,
+        0x022C9F00, 0x040FA997, 0x07E8C941, 0x01CBFFD6, 0x002608ED, 0x06053E7A, 0x05E25EAC, 0x03C1683B,
+        0x02608EDB, 0x0443B84C, 0x07A4D89A, 0x0187EE0D, 0x006A1936, 0x06492FA1, 0x05AE4F77, 0x038D79E0,
+        0x0675A101, 0x00569796, 0x03B1F740, 0x0592C1D7, 0x047F36EC, 0x025C007B, 0x01BB60AD, 0x0798563A,
+        0x03C8EA00, 0x05EBDC97, 0x060CBC41, 0x002F8AD6, 0x01C27DED, 0x07E14B7A, 0x04062BAC, 0x02251D3B,
+        0x07DDC5DA, 0x01FEF34D, 0x0219939B, 0x043AA50C, 0x05D75237, 0x03F464A0, 0x00130476, 0x063032E1,
+        0x0130476D, 0x071371FA, 0x04F4112C, 0x02D727BB, 0x033AD080, 0x0519E617, 0x06FE86C1, 0x00DDB056,
+        0x052568B7, 0x03065E20, 0x00E13EF6, 0x06C20861, 0x072FFF5A, 0x010CC9CD, 0x02EBA91B, 0x04C89F8C,
+        0x009823B6, 0x06BB1521, 0x055C75F7, 0x037F4360, 0x0292B45B, 0x04B182CC, 0x0756E21A, 0x0175D48D,
+        0x048D0C6C, 0x02AE3AFB, 0x01495A2D, 0x076A6CBA, 0x06879B81, 0x00A4AD16, 0x0343CDC0, 0x0560FB57
+    },
+    {
+        0x00000000, 0x0482AD61, 0x008761AD, 0x0405CCCC, 0x010EC35A, 0x058C6E3B, 0x0189A2F7, 0x050B0F96,
+        0x021D86B4, 0x069F2BD5, 0x029AE719, 0x06184A78, 0x031345EE, 0x0791E88F, 0x03942443, 0x07168922,
+        0x043B0D68, 0x00B9A009, 0x04BC6CC5, 0x003EC1A4, 0x0535CE32, 0x01B76353, 0x05B2AF9F, 0x013002FE,
+        0x06268BDC, 0x02A426BD, 0x06A1EA71, 0x02234710, 0x07284886, 0x03AAE5E7, 0x07AF292B, 0x032D844A,
+        0x01F421BF, 0x05768CDE, 0x01734012, 0x05F1ED73, 0x00FAE2E5, 0x04784F84, 0x007D8348, 0x04FF2E29,
+        0x03E9A70B, 0x076B0A6A, 0x036EC6A6, 0x07EC6BC7, 0x02E76451, 0x0665C930, 0x026005FC, 0x06E2A89D,
+        0x05CF2CD7, 0x014D81B6, 0x05484D7A, 0x01CAE01B, 0x04C1EF8D, 0x004342EC, 0x04468E20, 0x00C42341,
+        0x07D2AA63, 0x03500702, 0x0755CBCE, 0x03D766AF, 0x06DC6939, 0x025EC458, 0x065B0894, 0x02D9A5F5,
+        0x03E8437E, 0x076AEE1F, 0x036F22D3, 0x07ED8FB2, 0x02E68024, 0x06642D45, 0x0261E189, 0x06E34CE8,
+        0x01F5C5CA, 0x057768AB, 0x0172A467, 0x05F00906, 0x00FB0690, 0x0479ABF1, 0x007C673D, 0x04FECA5C,
+        0x07D34E16, 0x0351E377, 0x07542FBB, 0x03D682DA, 0x06DD8D4C, 0x025F202D, 0x065AECE1, 0x02D84180,
+        0x05CEC8A2, 0x014C65C3, 0x0549A90F, 0x01CB046E, 0x04C00BF8, 0x0042A699, 0x04476A55, 0x00C5C734,
+        0x021C62C1, 0x069ECFA0, 0x029B036C, 0x0619AE0D, 0x0312A19B, 0x07900CFA, 0x0395C036, 0x07176D57,
+        0x0001E475, 0x04834914, 0x008685D8, 0x040428B9, 0x010F272F, 0x058D8A4E, 0x01884682, 0x050AEBE3,
+        0x06276FA9, 0x02A5C2C8, 0x06A00E04, 0x0222A365, 0x0729ACF3, 0x03AB0192, 0x07AECD5E, 0x032C603F,
+        0x043AE91D, 0x00B8447C, 0x04BD88B0, 0x003F25D1, 0x05342A47, 0x01B68726, 0x05B34BEA, 0x0131E68B,
+        0x07D086FC, 0x03522B9D, 0x0757E751, 0x03D54A30, 0x06DE45A6, 0x025CE8C7, 0x0659240B, 0x02DB896A,
+        0x05CD0048, 0x014FAD29, 0x054A61E5, 0x01C8CC84, 0x04C3C312, 0x00416E73, 0x0444A2BF, 0x00C60FDE,
+        0x03EB8B94, 0x076926F5, 0x036CEA39, 0x07EE4758, 0x02E548CE, 0x0667E5AF, 0x02622963, 0x06E08402,
+        0x01F60D20, 0x0574A041, 0x01716C8D, 0x05F3C1EC, 0x00F8CE7A, 0x047A631B, 0x007FAFD7, 0x04FD02B6,
+        0x0624A743, 0x02A60A22, 0x06A3C6EE, 0x02216B8F, 0x072A6419, 0x03A8C978, 0x07AD05B4, 0x032FA8D5,
+        0x043921F7, 0x00BB8C96, 0x04BE405A, 0x003CED3B, 0x0537E2AD, 0x01B54FCC, 0x05B08300, 0x01322E61,
+        0x021FAA2B, 0x069D074A, 0x0298CB86, 0x061A66E7, 0x03116971, 0x0793C410, 0x039608DC, 0x0714A5BD,
+        0x00022C9F, 0x048081FE, 0x00854D32, 0x0407E053, 0x010CEFC5, 0x058E42A4, 0x018B8E68, 0x05092309,
+        0x0438C582, 0x00BA68E3, 0x04BFA42F, 0x003D094E, 0x053606D8, 0x01B4ABB9, 0x05B16775, 0x0133CA14,
+        0x06254336, 0x02A7EE57, 0x06A2229B, 0x02208FFA, 0x072B806C, 0x03A92D0D, 0x07ACE1C1, 0x032E4CA0,
+        0x0003C8EA, 0x0481658B, 0x0084A947, 0x04060426, 0x010D0BB0, 0x058FA6D1, 0x018A6A1D, 0x0508C77C,
+        0x021E4E5E, 0x069CE33F, 0x02992FF3, 0x061B8292, 0x03108D04, 0x07922065, 0x0397ECA9, 0x071541C8,
+        0x05CCE43D, 0x014E495C, 0x054B8590, 0x01C928F1, 0x04C22767, 0x00408A06, 0x044546CA, 0x00C7EBAB,
+        0x07D16289, 0x0353CFE8, 0x07560324, 0x03D4AE45, 0x06DFA1D3, 0x025D0CB2, 0x0658C07E, 0x02DA6D1F,
+        0x01F7E955, 0x05754434, 0x017088F8, 0x05F22599, 0x00F92A0F, 0x047B876E, 0x007E4BA2, 0x04FCE6C3,
+        0x03EA6FE1, 0x0768C280, 0x036D0E4C, 0x07EFA32D, 0x02E4ACBB, 0x066601DA, 0x0263CD16, 0x06E16077
+    },
+    {
+        0x00000000, 0x03D6EEE0, 0x07ADDDC0, 0x047B3320, 0x06D980EF, 0x050F6E0F, 0x01745D2F, 0x02A2B3CF,
+        0x04313AB1, 0x07E7D451, 0x039CE771, 0x004A0991, 0x02E8BA5E, 0x013E54BE, 0x0545679E, 0x0693897E,
+        0x01E04E0D, 0x0236A0ED, 0x064D93CD, 0x059B7D2D, 0x0739CEE2, 0x04EF2002, 0x00941322, 0x0342FDC2,
+        0x05D174BC, 0x06079A5C, 0x027CA97C, 0x01AA479C, 0x0308F453, 0x00DE1AB3, 0x04A52993, 0x0773C773,
+        0x03C09C1A, 0x001672FA, 0x046D41DA, 0x07BBAF3A, 0x05191CF5, 0x06CFF215, 0x02B4C135, 0x01622FD5,
+        0x07F1A6AB, 0x0427484B, 0x005C7B6B, 0x038A958B, 0x01282644, 0x02FEC8A4, 0x0685FB84, 0x05531564,
+        0x0220D217, 0x01F63CF7, 0x058D0FD7, 0x065BE137, 0x04F952F8, 0x072FBC18, 0x03548F38, 0x008261D8,
+        0x0611E8A6, 0x05C70646, 0x01BC3566, 0x026ADB86, 0x00C86849, 0x031E86A9, 0x0765B589, 0x04B35B69,
+        0x07813834, 0x0457D6D4, 0x002CE5F4, 0x03FA0B14, 0x0158B8DB, 0x028E563B, 0x06F5651B, 0x05238BFB,
+        0x03B00285, 0x0066EC65, 0x041DDF45, 0x07CB31A5, 0x0569826A, 0x06BF6C8A, 0x02C45FAA, 0x0112B14A,
+        0x06617639, 0x05B798D9, 0x01CCABF9, 0x021A4519, 0x00B8F6D6, 0x036E1836, 0x07152B16, 0x04C3C5F6,
+        0x02504C88, 0x0186A268, 0x05FD9148, 0x062B7FA8, 0x0489CC67, 0x075F2287, 0x032411A7, 0x00F2FF47,
+        0x0441A42E, 0x07974ACE, 0x03EC79EE, 0x003A970E, 0x029824C1, 0x014ECA21, 0x0535F901, 0x06E317E1,
+        0x00709E9F, 0x03A6707F, 0x07DD435F, 0x040BADBF, 0x06A91E70, 0x057FF090, 0x0104C3B0, 0x02D22D50,
+        0x05A1EA23, 0x067704C3, 0x020C37E3, 0x01DAD903, 0x03786ACC, 0x00AE842C, 0x04D5B70C, 0x070359EC,
+        0x0190D092, 0x02463E72, 0x063D0D52, 0x05EBE3B2, 0x0749507D, 0x049FBE9D, 0x00E48DBD, 0x0332635D,
+        0x06804B07, 0x0556A5E7, 0x012D96C7, 0x02FB7827, 0x0059CBE8, 0x038F2508, 0x07F41628, 0x0422F8C8,
+        0x02B171B6, 0x01679F56, 0x051CAC76, 0x06CA4296, 0x0468F159, 0x07BE1FB9, 0x03C52C99, 0x0013C279,
+        0x0760050A, 0x04B6EBEA, 0x00CDD8CA, 0x031B362A, 0x01B985E5, 0x026F6B05, 0x06145825, 0x05C2B6C5,
+        0x03513FBB, 0x0087D15B, 0x04FCE27B, 0x072A0C9B, 0x0588BF54, 0x065E51B4, 0x02256294, 0x01F38C74,
+        0x0540D71D, 0x069639FD, 0x02ED0ADD, 0x013BE43D, 0x039957F2, 0x004FB912, 0x04348A32, 0x07E264D2,
+        0x0171EDAC, 0x02A7034C, 0x06DC306C, 0x050ADE8C, 0x07A86D43, 0x047E83A3, 0x0005B083, 0x03D35E63,
+        0x04A09910, 0x077677F0, 0x030D44D0, 0x00DBAA30, 0x027919FF, 0x01AFF71F, 0x05D4C43F, 0x06022ADF,
+        0x0091A3A1, 0x03474D41, 0x073C7E61, 0x04EA9081, 0x0648234E, 0x059ECDAE, 0x01E5FE8E, 0x0233106E,
+        0x01017333, 0x02D79DD3, 0x06ACAEF3, 0x057A4013, 0x07D8F3DC, 0x040E1D3C, 0x00752E1C, 0x03A3C0FC,
+        0x05304982, 0x06E6A762, 0x029D9442, 0x014B7AA2, 0x03E9C96D, 0x003F278D, 0x044414AD, 0x0792FA4D,
+        0x00E13D3E, 0x0337D3DE, 0x074CE0FE, 0x049A0E1E, 0x0638BDD1, 0x05EE5331, 0x01956011, 0x02438EF1,
+        0x04D0078F, 0x0706E96F, 0x037DDA4F, 0x00AB34AF, 0x02098760, 0x01DF6980, 0x05A45AA0, 0x0672B440,
+        0x02C1EF29, 0x011701C9, 0x056C32E9, 0x06BADC09, 0x04186FC6, 0x07CE8126, 0x03B5B206, 0x00635CE6,
+        0x06F0D598, 0x05263B78, 0x015D0858, 0x028BE6B8, 0x00295577, 0x03FFBB97, 0x078488B7, 0x04526657,
+        0x0321A124, 0x00F74FC4, 0x048C7CE4, 0x075A9204, 0x05F821CB, 0x062ECF2B, 0x0255FC0B, 0x018312EB,
+        0x07109B95, 0x04C67575, 0x00BD4655, 0x036BA8B5, 0x01C91B7A, 0x021FF59A, 0x0664C6BA, 0x05B2285A
+    },
+    {
+        0x00000000, 0x01339183, 0x02672306, 0x0354B285, 0x04CE460C, 0x05FDD78F, 0x06A9650A, 0x079AF489,
+        0x001EB777, 0x012D26F4, 0x02799471, 0x034A05F2, 0x04D0F17B, 0x05E360F8, 0x06B7D27D, 0x078443FE,
+        0x003D6EEE, 0x010EFF6D, 0x025A4DE8, 0x0369DC6B, 0x04F328E2, 0x05C0B961, 0x06940BE4, 0x07A79A67,
+        0x0023D999, 0x0110481A, 0x0244FA9F, 0x03776B1C, 0x04ED9F95, 0x05DE0E16, 0x068ABC93, 0x07B92D10,
+        0x007ADDDC, 0x01494C5F, 0x021DFEDA, 0x032E6F59, 0x04B49BD0, 0x05870A53, 0x06D3B8D6, 0x07E02955,
+        0x00646AAB, 0x0157FB28, 0x020349AD, 0x0330D82E, 0x04AA2CA7, 0x0599BD24, 0x06CD0FA1, 0x07FE9E22,
+        0x0047B332, 0x017422B1, 0x02209034, 0x031301B7, 0x0489F53E, 0x05BA64BD, 0x06EED638, 0x07DD47BB,
+        0x00590445, 0x016A95C6, 0x023E2743, 0x030DB6C0, 0x04974249, 0x05A4D3CA, 0x06F0614F, 0x07C3F0CC,
+        0x00F5BBB8, 0x01C62A3B, 0x029298BE, 0x03A1093D, 0x043BFDB4, 0x05086C37, 0x065CDEB2, 0x076F4F31,
+        0x00EB0CCF, 0x01D89D4C, 0x028C2FC9, 0x03BFBE4A, 0x04254AC3, 0x0516DB40, 0x064269C5, 0x0771F846,
+        0x00C8D556, 0x01FB44D5, 0x02AFF650, 0x039C67D3, 0x0406935A, 0x053502D9, 0x0661B05C, 0x075221DF,
+        0x00D66221, 0x01E5F3A2, 0x02B14127, 0x0382D0A4, 0x0418242D, 0x052BB5AE, 0x067F072B, 0x074C96A8,
+        0x008F6664, 0x01BCF7E7, 0x02E84562, 0x03DBD4E1, 0x04412068, 0x0572B1EB, 0x0626036E, 0x071592ED,
+        0x0091D113, 0x01A24090, 0x02F6F215, 0x03C56396, 0x045F971F, 0x056C069C, 0x0638B419, 0x070B259A,
+        0x00B2088A, 0x01819909, 0x02D52B8C, 0x03E6BA0F, 0x047C4E86, 0x054FDF05, 0x061B6D80, 0x0728FC03,
+        0x00ACBFFD, 0x019F2E7E, 0x02CB9CFB, 0x03F80D78, 0x0462F9F1, 0x05516872, 0x0605DAF7, 0x07364B74,
+        0x01EB7770, 0x00D8E6F3, 0x038C5476, 0x02BFC5F5, 0x0525317C, 0x0416A0FF, 0x0742127A, 0x067183F9,
+        0x01F5C007, 0x00C65184, 0x0392E301, 0x02A17282, 0x053B860B, 0x04081788, 0x075CA50D, 0x066F348E,
+        0x01D6199E, 0x00E5881D, 0x03B13A98, 0x0282AB1B, 0x05185F92, 0x042BCE11, 0x077F7C94, 0x064CED17,
+        0x01C8AEE9, 0x00FB3F6A, 0x03AF8DEF, 0x029C1C6C, 0x0506E8E5, 0x04357966, 0x0761CBE3, 0x06525A60,
+        0x0191AAAC, 0x00A23B2F, 0x03F689AA, 0x02C51829, 0x055FECA0, 0x046C7D23, 0x0738CFA6, 0x060B5E25,
+        0x018F1DDB, 0x00BC8C58, 0x03E83EDD, 0x02DBAF5E, 0x05415BD7, 0x0472CA54, 0x072678D1, 0x0615E952,
+        0x01ACC442, 0x009F55C1, 0x03CBE744, 0x02F876C7, 0x0562824E, 0x045113CD, 0x0705A148, 0x063630CB,
+        0x01B27335, 0x0081E2B6, 0x03D55033, 0x02E6C1B0, 0x057C3539, 0x044FA4BA, 0x071B163F, 0x062887BC,
+        0x011ECCC8, 0x002D5D4B, 0x0379EFCE, 0x024A7E4D, 0x05D08AC4, 0x04E31B47, 0x07B7A9C2, 0x06843841,
+        0x01007BBF, 0x0033EA3C, 0x036758B9, 0x0254C93A, 0x05CE3DB3, 0x04FDAC30, 0x07A91EB5, 0x069A8F36,
+        0x0123A226, 0x001033A5, 0x03448120, 0x027710A3, 0x05EDE42A, 0x04DE75A9, 0x078AC72C, 0x06B956AF,
+        0x013D1551, 0x000E84D2, 0x035A3657, 0x0269A7D4, 0x05F3535D, 0x04C0C2DE, 0x0794705B, 0x06A7E1D8,
+        0x01641114, 0x00578097, 0x03033212, 0x0230A391, 0x05AA5718, 0x0499C69B, 0x07CD741E, 0x06FEE59D,
+        0x017AA663, 0x004937E0, 0x031D8565, 0x022E14E6, 0x05B4E06F, 0x048771EC, 0x07D3C369, 0x06E052EA,
+        0x01597FFA, 0x006AEE79, 0x033E5CFC, 0x020DCD7F, 0x059739F6, 0x04A4A875, 0x07F01AF0, 0x06C38B73,
+        0x0147C88D, 0x0074590E, 0x0320EB8B, 0x02137A08, 0x05898E81, 0x04BA1F02, 0x07EEAD87, 0x06DD3C04
+    },
+    {
+        0x00000000, 0x07274EF0, 0x07CCA68F, 0x00EBE87F, 0x061B7671, 0x013C3881, 0x01D7D0FE, 0x06F09E0E,
+        0x05B4D78D, 0x0293997D, 0x02787102, 0x055F3FF2, 0x03AFA1FC, 0x0488EF0C, 0x04630773, 0x03444983,
+        0x02EB9475, 0x05CCDA85, 0x052732FA, 0x02007C0A, 0x04F0E204, 0x03D7ACF4, 0x033C448B, 0x041B0A7B,
+        0x075F43F8, 0x00780D08, 0x0093E577, 0x07B4AB87, 0x01443589, 0x06637B79, 0x06889306, 0x01AFDDF6,
+        0x05D728EA, 0x02F0661A, 0x021B8E65, 0x053CC095, 0x03CC5E9B, 0x04EB106B, 0x0400F814, 0x0327B6E4,
+        0x0063FF67, 0x0744B197, 0x07AF59E8, 0x00881718, 0x06788916, 0x015FC7E6, 0x01B42F99, 0x06936169,
+        0x073CBC9F, 0x001BF26F, 0x00F01A10, 0x07D754E0, 0x0127CAEE, 0x0600841E, 0x06EB6C61, 0x01CC2291,
+        0x02886B12, 0x05AF25E2, 0x0544CD9D, 0x0263836D, 0x04931D63, 0x03B45393, 0x035FBBEC, 0x0478F51C,
+        0x022C6ABB, 0x050B244B, 0x05E0CC34, 0x02C782C4, 0x04371CCA, 0x0310523A, 0x03FBBA45, 0x04DCF4B5,
+        0x0798BD36, 0x00BFF3C6, 0x00541BB9, 0x07735549, 0x0183CB47, 0x06A485B7, 0x064F6DC8, 0x01682338,
+        0x00C7FECE, 0x07E0B03E, 0x070B5841, 0x002C16B1, 0x06DC88BF, 0x01FBC64F, 0x01102E30, 0x063760C0,
+        0x05732943, 0x025467B3, 0x02BF8FCC, 0x0598C13C, 0x03685F32, 0x044F11C2, 0x04A4F9BD, 0x0383B74D,
+        0x07FB4251, 0x00DC0CA1, 0x0037E4DE, 0x0710AA2E, 0x01E03420, 0x06C77AD0, 0x062C92AF, 0x010BDC5F,
+        0x024F95DC, 0x0568DB2C, 0x05833353, 0x02A47DA3, 0x0454E3AD, 0x0373AD5D, 0x03984522, 0x04BF0BD2,
+        0x0510D624, 0x023798D4, 0x02DC70AB, 0x05FB3E5B, 0x030BA055, 0x042CEEA5, 0x04C706DA, 0x03E0482A,
+        0x00A401A9, 0x07834F59, 0x0768A726, 0x004FE9D6, 0x06BF77D8, 0x01983928, 0x0173D157, 0x06549FA7,
+        0x0458D576, 0x037F9B86, 0x039473F9, 0x04B33D09, 0x0243A307, 0x0564EDF7, 0x058F0588, 0x02A84B78,
+        0x01EC02FB, 0x06CB4C0B, 0x0620A474, 0x0107EA84, 0x07F7748A, 0x00D03A7A, 0x003BD205, 0x071C9CF5,
+        0x06B34103, 0x01940FF3, 0x017FE78C, 0x0658A97C, 0x00A83772, 0x078F7982, 0x076491FD, 0x0043DF0D,
+        0x0307968E, 0x0420D87E, 0x04CB3001, 0x03EC7EF1, 0x051CE0FF, 0x023BAE0F, 0x02D04670, 0x05F70880,
+        0x018FFD9C, 0x06A8B36C, 0x06435B13, 0x016415E3, 0x07948BED, 0x00B3C51D, 0x00582D62, 0x077F6392,
+        0x043B2A11, 0x031C64E1, 0x03F78C9E, 0x04D0C26E, 0x02205C60, 0x05071290, 0x05ECFAEF, 0x02CBB41F,
+        0x036469E9, 0x04432719, 0x04A8CF66, 0x038F8196, 0x057F1F98, 0x02585168, 0x02B3B917, 0x0594F7E7,
+        0x06D0BE64, 0x01F7F094, 0x011C18EB, 0x063B561B, 0x00CBC815, 0x07EC86E5, 0x07076E9A, 0x0020206A,
+        0x0674BFCD, 0x0153F13D, 0x01B81942, 0x069F57B2, 0x006FC9BC, 0x0748874C, 0x07A36F33, 0x008421C3,
+        0x03C06840, 0x04E726B0, 0x040CCECF, 0x032B803F, 0x05DB1E31, 0x02FC50C1, 0x0217B8BE, 0x0530F64E,
+        0x049F2BB8, 0x03B86548, 0x03538D37, 0x0474C3C7, 0x02845DC9, 0x05A31339, 0x0548FB46, 0x026FB5B6,
+        0x012BFC35, 0x060CB2C5, 0x06E75ABA, 0x01C0144A, 0x07308A44, 0x0017C4B4, 0x00FC2CCB, 0x07DB623B,
+        0x03A39727, 0x0484D9D7, 0x046F31A8, 0x03487F58, 0x05B8E156, 0x029FAFA6, 0x027447D9, 0x05530929,
+        0x061740AA, 0x01300E5A, 0x01DBE625, 0x06FCA8D5, 0x000C36DB, 0x072B782B, 0x07C09054, 0x00E7DEA4,
+        0x01480352, 0x066F4DA2, 0x0684A5DD, 0x01A3EB2D, 0x07537523, 0x00743BD3, 0x009FD3AC, 0x07B89D5C,
+        0x04FCD4DF, 0x03DB9A2F, 0x03307250, 0x04173CA0, 0x02E7A2AE, 0x05C0EC5E, 0x052B0421, 0x020C4AD1
+    },
+    {
+        0x00000000, 0x009F04F8, 0x013E09F0, 0x01A10D08, 0x027C13E0, 0x02E31718, 0x03421A10, 0x03DD1EE8,
+        0x04F827C0, 0x04672338, 0x05C62E30, 0x05592AC8, 0x06843420, 0x061B30D8, 0x07BA3DD0, 0x07253928,
+        0x007274EF, 0x00ED7017, 0x014C7D1F, 0x01D379E7, 0x020E670F, 0x029163F7, 0x03306EFF, 0x03AF6A07,
+        0x048A532F, 0x041557D7, 0x05B45ADF, 0x052B5E27, 0x06F640CF, 0x06694437, 0x07C8493F, 0x07574DC7,
+        0x00E4E9DE, 0x007BED26, 0x01DAE02E, 0x0145E4D6, 0x0298FA3E, 0x0207FEC6, 0x03A6F3CE, 0x0339F736,
+        0x041CCE1E, 0x0483CAE6, 0x0522C7EE, 0x05BDC316, 0x0660DDFE, 0x06FFD906, 0x075ED40E, 0x07C1D0F6,
+        0x00969D31, 0x000999C9, 0x01A894C1, 0x01379039, 0x02EA8ED1, 0x02758A29, 0x03D48721, 0x034B83D9,
+        0x046EBAF1, 0x04F1BE09, 0x0550B301, 0x05CFB7F9, 0x0612A911, 0x068DADE9, 0x072CA0E1, 0x07B3A419,
+        0x01C9D3BC, 0x0156D744, 0x00F7DA4C, 0x0068DEB4, 0x03B5C05C, 0x032AC4A4, 0x028BC9AC, 0x0214CD54,
+        0x0531F47C, 0x05AEF084, 0x040FFD8C, 0x0490F974, 0x074DE79C, 0x07D2E364, 0x0673EE6C, 0x06ECEA94,
+        0x01BBA753, 0x0124A3AB, 0x0085AEA3, 0x001AAA5B, 0x03C7B4B3, 0x0358B04B, 0x02F9BD43, 0x0266B9BB,
+        0x05438093, 0x05DC846B, 0x047D8963, 0x04E28D9B, 0x073F9373, 0x07A0978B, 0x06019A83, 0x069E9E7B,
+        0x012D3A62, 0x01B23E9A, 0x00133392, 0x008C376A, 0x03512982, 0x03CE2D7A, 0x026F2072, 0x02F0248A,
+        0x05D51DA2, 0x054A195A, 0x04EB1452, 0x047410AA, 0x07A90E42, 0x07360ABA, 0x069707B2, 0x0608034A,
+        0x015F4E8D, 0x01C04A75, 0x0061477D, 0x00FE4385, 0x03235D6D, 0x03BC5995, 0x021D549D, 0x02825065,
+        0x05A7694D, 0x05386DB5, 0x049960BD, 0x04066445, 0x07DB7AAD, 0x07447E55, 0x06E5735D, 0x067A77A5,
+        0x0393A778, 0x030CA380, 0x02ADAE88, 0x0232AA70, 0x01EFB498, 0x0170B060, 0x00D1BD68, 0x004EB990,
+        0x076B80B8, 0x07F48440, 0x06558948, 0x06CA8DB0, 0x05179358, 0x058897A0, 0x04299AA8, 0x04B69E50,
+        0x03E1D397, 0x037ED76F, 0x02DFDA67, 0x0240DE9F, 0x019DC077, 0x0102C48F, 0x00A3C987, 0x003CCD7F,
+        0x0719F457, 0x0786F0AF, 0x0627FDA7, 0x06B8F95F, 0x0565E7B7, 0x05FAE34F, 0x045BEE47, 0x04C4EABF,
+        0x03774EA6, 0x03E84A5E, 0x02494756, 0x02D643AE, 0x010B5D46, 0x019459BE, 0x003554B6, 0x00AA504E,
+        0x078F6966, 0x07106D9E, 0x06B16096, 0x062E646E, 0x05F37A86, 0x056C7E7E, 0x04CD7376, 0x0452778E,
+        0x03053A49, 0x039A3EB1, 0x023B33B9, 0x02A43741, 0x017929A9, 0x01E62D51, 0x00472059, 0x00D824A1,
+        0x07FD1D89, 0x07621971, 0x06C31479, 0x065C1081, 0x05810E69, 0x051E0A91, 0x04BF0799, 0x04200361,
+        0x025A74C4, 0x02C5703C, 0x03647D34, 0x03FB79CC, 0x00266724, 0x00B963DC, 0x01186ED4, 0x01876A2C,
+        0x06A25304, 0x063D57FC, 0x079C5AF4, 0x07035E0C, 0x04DE40E4, 0x0441441C, 0x05E04914, 0x057F4DEC,
+        0x0228002B, 0x02B704D3, 0x031609DB, 0x03890D23, 0x005413CB, 0x00CB1733, 0x016A1A3B, 0x01F51EC3,
+        0x06D027EB, 0x064F2313, 0x07EE2E1B, 0x07712AE3, 0x04AC340B, 0x043330F3, 0x05923DFB, 0x050D3903,
+        0x02BE9D1A, 0x022199E2, 0x038094EA, 0x031F9012, 0x00C28EFA, 0x005D8A02, 0x01FC870A, 0x016383F2,
+        0x0646BADA, 0x06D9BE22, 0x0778B32A, 0x07E7B7D2, 0x043AA93A, 0x04A5ADC2, 0x0504A0CA, 0x059BA432,
+        0x02CCE9F5, 0x0253ED0D, 0x03F2E005, 0x036DE4FD, 0x00B0FA15, 0x002FFEED, 0x018EF3E5, 0x0111F71D,
+        0x0634CE35, 0x06ABCACD, 0x070AC7C5, 0x0795C33D, 0x0448DDD5, 0x04D7D92D, 0x0576D425, 0x05E9D0DD
+    },
+    {
+        0x00000000, 0x048D9368, 0x00991DBF, 0x04148ED7, 0x01323B7E, 0x05BFA816, 0x01AB26C1, 0x0526B5A9,
+        0x026476FC, 0x06E9E594, 0x02FD6B43, 0x0670F82B, 0x03564D82, 0x07DBDEEA, 0x03CF503D, 0x0742C355,
+        0x04C8EDF8, 0x00457E90, 0x0451F047, 0x00DC632F, 0x05FAD686, 0x017745EE, 0x0563CB39, 0x01EE5851,
+        0x06AC9B04, 0x0221086C, 0x063586BB, 0x02B815D3, 0x079EA07A, 0x03133312, 0x0707BDC5, 0x038A2EAD,
+        0x0013E09F, 0x049E73F7, 0x008AFD20, 0x04076E48, 0x0121DBE1, 0x05AC4889, 0x01B8C65E, 0x05355536,
+        0x02779663, 0x06FA050B, 0x02EE8BDC, 0x066318B4, 0x0345AD1D, 0x07C83E75, 0x03DCB0A2, 0x075123CA,
+        0x04DB0D67, 0x00569E0F, 0x044210D8, 0x00CF83B0, 0x05E93619, 0x0164A571, 0x05702BA6, 0x01FDB8CE,
+        0x06BF7B9B, 0x0232E8F3, 0x06266624, 0x02ABF54C, 0x078D40E5, 0x0300D38D, 0x07145D5A, 0x0399CE32,
+        0x0027C13E, 0x04AA5256, 0x00BEDC81, 0x04334FE9, 0x0115FA40, 0x05986928, 0x018CE7FF, 0x05017497,
+        0x0243B7C2, 0x06CE24AA, 0x02DAAA7D, 0x06573915, 0x03718CBC, 0x07FC1FD4, 0x03E89103, 0x0765026B,
+        0x04EF2CC6, 0x0062BFAE, 0x04763179, 0x00FBA211, 0x05DD17B8, 0x015084D0, 0x05440A07, 0x01C9996F,
+        0x068B5A3A, 0x0206C952, 0x06124785, 0x029FD4ED, 0x07B96144, 0x0334F22C, 0x07207CFB, 0x03ADEF93,
+        0x003421A1, 0x04B9B2C9, 0x00AD3C1E, 0x0420AF76, 0x01061ADF, 0x058B89B7, 0x019F0760, 0x05129408,
+        0x0250575D, 0x06DDC435, 0x02C94AE2, 0x0644D98A, 0x03626C23, 0x07EFFF4B, 0x03FB719C, 0x0776E2F4,
+        0x04FCCC59, 0x00715F31, 0x0465D1E6, 0x00E8428E, 0x05CEF727, 0x0143644F, 0x0557EA98, 0x01DA79F0,
+        0x0698BAA5, 0x021529CD, 0x0601A71A, 0x028C3472, 0x07AA81DB, 0x032712B3, 0x07339C64, 0x03BE0F0C,
+        0x004F827C, 0x04C21114, 0x00D69FC3, 0x045B0CAB, 0x017DB902, 0x05F02A6A, 0x01E4A4BD, 0x056937D5,
+        0x022BF480, 0x06A667E8, 0x02B2E93F, 0x063F7A57, 0x0319CFFE, 0x07945C96, 0x0380D241, 0x070D4129,
+        0x04876F84, 0x000AFCEC, 0x041E723B, 0x0093E153, 0x05B554FA, 0x0138C792, 0x052C4945, 0x01A1DA2D,
+        0x06E31978, 0x026E8A10, 0x067A04C7, 0x02F797AF, 0x07D12206, 0x035CB16E, 0x07483FB9, 0x03C5ACD1,
+        0x005C62E3, 0x04D1F18B, 0x00C57F5C, 0x0448EC34, 0x016E599D, 0x05E3CAF5, 0x01F74422, 0x057AD74A,
+        0x0238141F, 0x06B58777, 0x02A109A0, 0x062C9AC8, 0x030A2F61, 0x0787BC09, 0x039332DE, 0x071EA1B6,
+        0x04948F1B, 0x00191C73, 0x040D92A4, 0x008001CC, 0x05A6B465, 0x012B270D, 0x053FA9DA, 0x01B23AB2,
+        0x06F0F9E7, 0x027D6A8F, 0x0669E458, 0x02E47730, 0x07C2C299, 0x034F51F1, 0x075BDF26, 0x03D64C4E,
+        0x00684342, 0x04E5D02A, 0x00F15EFD, 0x047CCD95, 0x015A783C, 0x05D7EB54, 0x01C36583, 0x054EF6EB,
+        0x020C35BE, 0x0681A6D6, 0x02952801, 0x0618BB69, 0x033E0EC0, 0x07B39DA8, 0x03A7137F, 0x072A8017,
+        0x04A0AEBA, 0x002D3DD2, 0x0439B305, 0x00B4206D, 0x059295C4, 0x011F06AC, 0x050B887B, 0x01861B13,
+        0x06C4D846, 0x02494B2E, 0x065DC5F9, 0x02D05691, 0x07F6E338, 0x037B7050, 0x076FFE87, 0x03E26DEF,
+        0x007BA3DD, 0x04F630B5, 0x00E2BE62, 0x046F2D0A, 0x014998A3, 0x05C40BCB, 0x01D0851C, 0x055D1674,
+        0x021FD521, 0x06924649, 0x0286C89E, 0x060B5BF6, 0x032DEE5F, 0x07A07D37, 0x03B4F3E0, 0x07396088,
+        0x04B34E25, 0x003EDD4D, 0x042A539A, 0x00A7C0F2, 0x0581755B, 0x010CE633, 0x051868E4, 0x0195FB8C,
+        0x06D738D9, 0x025AABB1, 0x064E2566, 0x02C3B60E, 0x07E503A7, 0x036890CF, 0x077C1E18, 0x03F18D70
+    },
+    {
+        0x00000000, 0x01E0F893, 0x03C1F126, 0x022109B5, 0x0783E24C, 0x06631ADF, 0x0442136A, 0x05A2EBF9,
+        0x0685FFF7, 0x07650764, 0x05440ED1, 0x04A4F642, 0x01061DBB, 0x00E6E528, 0x02C7EC9D, 0x0327140E,
+        0x0489C481, 0x05693C12, 0x074835A7, 0x06A8CD34, 0x030A26CD, 0x02EADE5E, 0x00CBD7EB, 0x012B2F78,
+        0x020C3B76, 0x03ECC3E5, 0x01CDCA50, 0x002D32C3, 0x058FD93A, 0x046F21A9, 0x064E281C, 0x07AED08F,
+        0x0091B26D, 0x01714AFE, 0x0350434B, 0x02B0BBD8, 0x07125021, 0x06F2A8B2, 0x04D3A107, 0x05335994,
+        0x06144D9A, 0x07F4B509, 0x05D5BCBC, 0x0435442F, 0x0197AFD6, 0x00775745, 0x02565EF0, 0x03B6A663,
+        0x041876EC, 0x05F88E7F, 0x07D987CA, 0x06397F59, 0x039B94A0, 0x027B6C33, 0x005A6586, 0x01BA9D15,
+        0x029D891B, 0x037D7188, 0x015C783D, 0x00BC80AE, 0x051E6B57, 0x04FE93C4, 0x06DF9A71, 0x073F62E2,
+        0x012364DA, 0x00C39C49, 0x02E295FC, 0x03026D6F, 0x06A08696, 0x07407E05, 0x056177B0, 0x04818F23,
+        0x07A69B2D, 0x064663BE, 0x04676A0B, 0x05879298, 0x00257961, 0x01C581F2, 0x03E48847, 0x020470D4,
+        0x05AAA05B, 0x044A58C8, 0x066B517D, 0x078BA9EE, 0x02294217, 0x03C9BA84, 0x01E8B331, 0x00084BA2,
+        0x032F5FAC, 0x02CFA73F, 0x00EEAE8A, 0x010E5619, 0x04ACBDE0, 0x054C4573, 0x076D4CC6, 0x068DB455,
+        0x01B2D6B7, 0x00522E24, 0x02732791, 0x0393DF02, 0x063134FB, 0x07D1CC68, 0x05F0C5DD, 0x04103D4E,
+        0x07372940, 0x06D7D1D3, 0x04F6D866, 0x051620F5, 0x00B4CB0C, 0x0154339F, 0x03753A2A, 0x0295C2B9,
+        0x053B1236, 0x04DBEAA5, 0x06FAE310, 0x071A1B83, 0x02B8F07A, 0x035808E9, 0x0179015C, 0x0099F9CF,
+        0x03BEEDC1, 0x025E1552, 0x007F1CE7, 0x019FE474, 0x043D0F8D, 0x05DDF71E, 0x07FCFEAB, 0x061C0638,
+        0x0246C9B4, 0x03A63127, 0x01873892, 0x0067C001, 0x05C52BF8, 0x0425D36B, 0x0604DADE, 0x07E4224D,
+        0x04C33643, 0x0523CED0, 0x0702C765, 0x06E23FF6, 0x0340D40F, 0x02A02C9C, 0x00812529, 0x0161DDBA,
+        0x06CF0D35, 0x072FF5A6, 0x050EFC13, 0x04EE0480, 0x014CEF79, 0x00AC17EA, 0x028D1E5F, 0x036DE6CC,
+        0x004AF2C2, 0x01AA0A51, 0x038B03E4, 0x026BFB77, 0x07C9108E, 0x0629E81D, 0x0408E1A8, 0x05E8193B,
+        0x02D77BD9, 0x0337834A, 0x01168AFF, 0x00F6726C, 0x05549995, 0x04B46106, 0x069568B3, 0x07759020,
+        0x0452842E, 0x05B27CBD, 0x07937508, 0x06738D9B, 0x03D16662, 0x02319EF1, 0x00109744, 0x01F06FD7,
+        0x065EBF58, 0x07BE47CB, 0x059F4E7E, 0x047FB6ED, 0x01DD5D14, 0x003DA587, 0x021CAC32, 0x03FC54A1,
+        0x00DB40AF, 0x013BB83C, 0x031AB189, 0x02FA491A, 0x0758A2E3, 0x06B85A70, 0x049953C5, 0x0579AB56,
+        0x0365AD6E, 0x028555FD, 0x00A45C48, 0x0144A4DB, 0x04E64F22, 0x0506B7B1, 0x0727BE04, 0x06C74697,
+        0x05E05299, 0x0400AA0A, 0x0621A3BF, 0x07C15B2C, 0x0263B0D5, 0x03834846, 0x01A241F3, 0x0042B960,
+        0x07EC69EF, 0x060C917C, 0x042D98C9, 0x05CD605A, 0x006F8BA3, 0x018F7330, 0x03AE7A85, 0x024E8216,
+        0x01699618, 0x00896E8B, 0x02A8673E, 0x03489FAD, 0x06EA7454, 0x070A8CC7, 0x052B8572, 0x04CB7DE1,
+        0x03F41F03, 0x0214E790, 0x0035EE25, 0x01D516B6, 0x0477FD4F, 0x059705DC, 0x07B60C69, 0x0656F4FA,
+        0x0571E0F4, 0x04911867, 0x06B011D2, 0x0750E941, 0x02F202B8, 0x0312FA2B, 0x0133F39E, 0x00D30B0D,
+        0x077DDB82, 0x069D2311, 0x04BC2AA4, 0x055CD237, 0x00FE39CE, 0x011EC15D, 0x033FC8E8, 0x02DF307B,
+        0x01F82475, 0x0018DCE6, 0x0239D553, 0x03D92DC0, 0x067BC639, 0x079B3EAA, 0x05BA371F, 0x045ACF8C
+    }
+};
+
+uint32_t _z_crc32(const uint8_t *message, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    // Bytes are assembled explicitly so the result doesn't depend on alignment or endianness
+    while (len >= (size_t)8) {
+        uint32_t lo = crc ^ ((uint32_t)message[0] | ((uint32_t)message[1] << 8) | ((uint32_t)message[2] << 16) |
+                             ((uint32_t)message[3] << 24));
+        crc = _z_crc32_table[7][lo & 0xFF] ^ _z_crc32_table[6][(lo >> 8) & 0xFF] ^
+              _z_crc32_table[5][(lo >> 16) & 0xFF] ^ _z_crc32_table[4][lo >> 24] ^ _z_crc32_table[3][message[4]] ^
+              _z_crc32_table[2][message[5]] ^ _z_crc32_table[1][message[6]] ^ _z_crc32_table[0][message[7]];
+        message += 8;
+        len -= 8;
+    }
+    for (size_t i = 0; i < len; i++) {
+        crc = (crc >> 8) ^ _z_crc32_table[0][(crc ^ (uint32_t)message[i]) & 0xFF];
+    }
+    return ~crc;
+}
+
+#else
 uint32_t _z_crc32(const uint8_t *message, size_t len) {
     uint32_t crc = 0xFFFFFFFF;
     for (size_t i = 0; i < len; i++) {
@@ -26,3 +324,4 @@ uint32_t _z_crc32(const uint8_t *message, size_t len) {
     }
     return ~crc;
 }
+#endif
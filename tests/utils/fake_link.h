@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#ifndef ZP_FAKE_LINK_H
+#define ZP_FAKE_LINK_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "zenoh-pico/link/link.h"
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/protocol/codec/transport.h"
+#include "zenoh-pico/system/common/platform.h"
+#include "zenoh-pico/transport/transport.h"
+#include "zenoh-pico/transport/utils.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+// A datagram link whose writes are kept in memory, for tests of what a transport sends
+
+#define FAKE_LINK_DATAGRAM_MAX 64
+
+// Copies of the datagrams written on fake links, in order
+static _z_slice_t fake_link_datagrams[FAKE_LINK_DATAGRAM_MAX];
+static size_t fake_link_datagram_nb = 0;
+static size_t fake_link_write_calls = 0;
+static size_t fake_link_write_vec_calls = 0;
+// A stalled link holds the sender in its write, like a slow peer would
+static atomic_bool fake_link_stalled = false;
+static atomic_bool fake_link_writing = false;
+
+static inline void fake_link_push(const uint8_t *ptr, size_t len) {
+    assert(fake_link_datagram_nb < FAKE_LINK_DATAGRAM_MAX);
+    fake_link_datagrams[fake_link_datagram_nb] = _z_slice_copy_from_buf(ptr, len);
+    fake_link_datagram_nb++;
+}
+
+static inline size_t fake_link_write(const _z_link_t *self, const uint8_t *ptr, size_t len,
+                                     _z_sys_net_socket_t *socket) {
+    _ZP_UNUSED(self);
+    _ZP_UNUSED(socket);
+    fake_link_writing = true;
+    while (fake_link_stalled) {
+        z_sleep_ms(1);
+    }
+    fake_link_push(ptr, len);
+    fake_link_write_calls++;
+    fake_link_writing = false;
+    return len;
+}
+
+// A gather write makes a single datagram
+static inline size_t fake_link_write_vec(const _z_link_t *self, const _z_slice_t *bufs, size_t count,
+                                         _z_sys_net_socket_t *socket) {
+    _ZP_UNUSED(self);
+    _ZP_UNUSED(socket);
+    size_t len = 0;
+    for (size_t i = 0; i < count; i++) {
+        assert(bufs[i].len > 0);
+        len += bufs[i].len;
+    }
+    uint8_t *buf = (uint8_t *)z_malloc(len);
+    assert(buf != NULL);
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(&buf[pos], bufs[i].start, bufs[i].len);
+        pos += bufs[i].len;
+    }
+    fake_link_push(buf, len);
+    z_free(buf);
+    fake_link_write_vec_calls++;
+    return len;
+}
+
+static inline void fake_link_reset(void) {
+    for (size_t i = 0; i < fake_link_datagram_nb; i++) {
+        _z_slice_clear(&fake_link_datagrams[i]);
+    }
+    fake_link_datagram_nb = 0;
+    fake_link_write_calls = 0;
+    fake_link_write_vec_calls = 0;
+    fake_link_stalled = false;
+    fake_link_writing = false;
+}
+
+// Waits for a write held by a stalled link
+static inline void fake_link_wait_writing(void) {
+    while (!fake_link_writing) {
+        z_sleep_ms(1);
+    }
+}
+
+// Copies the written bytes one datagram after the other in dst, returns their length
+static inline size_t fake_link_join(uint8_t *dst, size_t size) {
+    size_t len = 0;
+    for (size_t i = 0; i < fake_link_datagram_nb; i++) {
+        assert(len + fake_link_datagrams[i].len <= size);
+        memcpy(&dst[len], fake_link_datagrams[i].start, fake_link_datagrams[i].len);
+        len += fake_link_datagrams[i].len;
+    }
+    return len;
+}
+
+static inline void fake_link_init(_z_link_t *zl, uint16_t mtu) {
+    memset(zl, 0, sizeof(_z_link_t));
+    zl->_write_f = fake_link_write;
+    zl->_mtu = mtu;
+    zl->_cap._flow = Z_LINK_CAP_FLOW_DATAGRAM;
+    zl->_cap._transport = Z_LINK_CAP_TRANSPORT_MULTICAST;
+}
+
+// Sets up the tx side of a zeroed multicast transport sending on a fake link, with a write buffer of the link mtu
+static inline void fake_link_transport_setup(_z_transport_common_t *ztc, _z_link_t *zl, uint16_t mtu) {
+    fake_link_init(zl, mtu);
+    ztc->_link = zl;
+    ztc->_wbuf = _z_wbuf_make(mtu, false);
+    ztc->_sn_res = _z_sn_max(Z_SN_RESOLUTION);
+#if Z_FEATURE_MULTI_THREAD == 1
+    assert(_z_mutex_init(&ztc->_mutex_tx) == _Z_RES_OK);
+#endif
+    fake_link_reset();
+}
+
+static inline void fake_link_transport_teardown(_z_transport_common_t *ztc) {
+    _z_wbuf_clear(&ztc->_wbuf);
+#if Z_FEATURE_BATCHING == 1
+    for (uint8_t i = 0; i < Z_PRIORITIES_NUM; i++) {
+        _z_wbuf_clear(&ztc->_batch_lanes[i]._wbuf);
+    }
+#endif
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&ztc->_mutex_tx);
+#endif
+    fake_link_reset();
+}
+
+// Decodes the frame a datagram carries and its network messages, cleared by the caller. Returns their number.
+static inline size_t fake_link_decode_frame(size_t idx, _z_zint_t *sn, _z_network_message_t *msgs, size_t max_msgs) {
+    assert(idx < fake_link_datagram_nb);
+    _z_zbuf_t zbf = _z_slice_as_zbuf(fake_link_datagrams[idx]);
+    _z_transport_message_t t_msg;
+    assert(_z_transport_message_decode(&t_msg, &zbf) == _Z_RES_OK);
+    assert(_Z_MID(t_msg._header) == _Z_MID_T_FRAME);
+    *sn = t_msg._body._frame._sn;
+    size_t nb = 0;
+    while (_z_zbuf_len(&zbf) > 0) {
+        assert(nb < max_msgs);
+        msgs[nb] = (_z_network_message_t){0};
+        _z_arc_slice_t arcs = _z_arc_slice_empty();
+        assert(_z_network_message_decode(&msgs[nb], &zbf, &arcs, 0) == _Z_RES_OK);
+        nb++;
+    }
+    return nb;
+}
+
+#endif  // ZP_FAKE_LINK_H
@@ -184,6 +184,87 @@ void sample_ring_channel_test_over_size(void) {
     z_drop(z_move(handler));
 }
 
+void sample_spsc_channel_test_over_size(void) {
+    z_owned_closure_sample_t closure;
+    z_owned_spsc_handler_sample_t handler;
+    z_spsc_channel_sample_new(&closure, &handler, 3);
+
+    char buf[100];
+    TRY_RECV(handler, buf)
+    assert(strcmp(buf, "nodata") == 0);
+
+    SEND(closure, "v1")
+    SEND(closure, "v22")
+    SEND(closure, "v333")
+    SEND(closure, "v4444")
+
+    // Newest sample is dropped when full
+    RECV(handler, buf)
+    assert(strcmp(buf, "v1") == 0);
+    RECV(handler, buf)
+    assert(strcmp(buf, "v22") == 0);
+    SEND(closure, "v55555")
+    RECV(handler, buf)
+    assert(strcmp(buf, "v333") == 0);
+    RECV(handler, buf)
+    assert(strcmp(buf, "v55555") == 0);
+    TRY_RECV(handler, buf)
+    assert(strcmp(buf, "nodata") == 0);
+
+    // Samples sent before closing are still received
+    SEND(closure, "v6")
+    z_drop(z_move(closure));
+    RECV(handler, buf)
+    assert(strcmp(buf, "v6") == 0);
+    RECV(handler, buf)
+    assert(strcmp(buf, "closed") == 0);
+
+    z_drop(z_move(handler));
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+#define SPSC_SENDER_NB 4
+#define SPSC_SEND_NB 10000
+
+static void *spsc_sender(void *arg) {
+    z_owned_closure_sample_t *closure = (z_owned_closure_sample_t *)arg;
+    for (size_t i = 0; i < SPSC_SEND_NB; i++) {
+        SEND(*closure, "v")
+    }
+    return NULL;
+}
+
+void sample_spsc_channel_test_concurrent_senders(void) {
+    // A subscriber callback may be called from several read tasks at once
+    z_owned_closure_sample_t closure;
+    z_owned_spsc_handler_sample_t handler;
+    z_spsc_channel_sample_new(&closure, &handler, SPSC_SENDER_NB * SPSC_SEND_NB);
+
+    z_owned_task_t tasks[SPSC_SENDER_NB];
+    for (size_t i = 0; i < SPSC_SENDER_NB; i++) {
+        assert(z_task_init(&tasks[i], NULL, spsc_sender, &closure) == Z_OK);
+    }
+    for (size_t i = 0; i < SPSC_SENDER_NB; i++) {
+        z_task_join(z_move(tasks[i]));
+    }
+    z_drop(z_move(closure));
+
+    char buf[100];
+    size_t received = 0;
+    for (;;) {
+        RECV(handler, buf)
+        if (strcmp(buf, "closed") == 0) {
+            break;
+        }
+        assert(strcmp(buf, "v") == 0);
+        received++;
+    }
+    assert(received == SPSC_SENDER_NB * SPSC_SEND_NB);
+
+    z_drop(z_move(handler));
+}
+#endif
+
 void zero_size_test(void) {
     z_owned_closure_sample_t closure;
 
@@ -198,6 +279,12 @@ void zero_size_test(void) {
     assert(z_ring_channel_sample_new(&closure, &ring_handler, 1) == Z_OK);
     z_drop(z_move(closure));
     z_drop(z_move(ring_handler));
+
+    z_owned_spsc_handler_sample_t spsc_handler;
+    assert(z_spsc_channel_sample_new(&closure, &spsc_handler, 0) != Z_OK);
+    assert(z_spsc_channel_sample_new(&closure, &spsc_handler, 1) == Z_OK);
+    z_drop(z_move(closure));
+    z_drop(z_move(spsc_handler));
 }
 
 int main(void) {
@@ -205,5 +292,9 @@ int main(void) {
     sample_fifo_channel_test_try_recv();
     sample_ring_channel_test_in_size();
     sample_ring_channel_test_over_size();
+    sample_spsc_channel_test_over_size();
+#if Z_FEATURE_MULTI_THREAD == 1
+    sample_spsc_channel_test_concurrent_senders();
+#endif
     zero_size_test();
 }
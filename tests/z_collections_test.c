@@ -15,6 +15,7 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "zenoh-pico/collections/fifo.h"
 #include "zenoh-pico/collections/lifo.h"
@@ -611,6 +612,21 @@ void sorted_map_iterator_deletion_test(void) {
         _z_str__z_str_sortedmap_iterator_next(&iter);
         _z_str__z_str_sortedmap_remove(&map, key);
     }
+
+    // Removing the entry just returned, before moving to the next one
+    _z_str__z_str_sortedmap_insert(&map, _z_str_clone("2"), _z_str_clone("B"));
+    _z_str__z_str_sortedmap_insert(&map, _z_str_clone("1"), _z_str_clone("A"));
+    _z_str__z_str_sortedmap_insert(&map, _z_str_clone("3"), _z_str_clone("C"));
+    iter = _z_str__z_str_sortedmap_iterator_make(&map);
+    const char *expected[] = {"1", "2", "3"};
+    size_t n = 0;
+    while (_z_str__z_str_sortedmap_iterator_next(&iter)) {
+        assert(strcmp(_z_str__z_str_sortedmap_iterator_key(&iter), expected[n]) == 0);
+        _z_str__z_str_sortedmap_remove(&map, expected[n]);
+        n++;
+    }
+    assert(n == 3);
+    assert(_z_str__z_str_sortedmap_is_empty(&map));
     _z_str__z_str_sortedmap_clear(&map);
 }
 
@@ -707,6 +723,56 @@ void sorted_map_stress_test(void) {
     _z_str__z_str_sortedmap_clear(&map);
 }
 
+#define SORTED_MAP_RANDOM_KEY_NB 1000
+
+// Compares the map with a plain array over random insertions and removals
+void sorted_map_random_test(void) {
+    static bool present[SORTED_MAP_RANDOM_KEY_NB];
+    memset(present, 0, sizeof(present));
+    _z_str__z_str_sortedmap_t map = _z_str__z_str_sortedmap_make();
+    size_t len = 0;
+    char key[16];
+    srand(11);
+    for (size_t round = 0; round < 20000; round++) {
+        int k = rand() % SORTED_MAP_RANDOM_KEY_NB;
+        snprintf(key, sizeof(key), "%05d", k);
+        if (rand() % 3 != 0) {
+            assert(_z_str__z_str_sortedmap_insert(&map, _z_str_clone(key), _z_str_clone(key)) != NULL);
+            len += present[k] ? 0 : 1;
+            present[k] = true;
+        } else {
+            _z_str__z_str_sortedmap_remove(&map, key);
+            len -= present[k] ? 1 : 0;
+            present[k] = false;
+        }
+        assert(_z_str__z_str_sortedmap_len(&map) == len);
+    }
+    for (int k = 0; k < SORTED_MAP_RANDOM_KEY_NB; k++) {
+        snprintf(key, sizeof(key), "%05d", k);
+        char *val = _z_str__z_str_sortedmap_get(&map, key);
+        assert((val != NULL) == present[k]);
+        assert((val == NULL) || (strcmp(val, key) == 0));
+    }
+
+    // Clones keep the order, entries are popped in order
+    _z_str__z_str_sortedmap_t clone = _z_str__z_str_sortedmap_clone(&map);
+    _z_str__z_str_sortedmap_clear(&map);
+    assert(_z_str__z_str_sortedmap_len(&clone) == len);
+    int prev = -1;
+    _z_str__z_str_sortedmap_entry_t *entry = _z_str__z_str_sortedmap_pop_first(&clone);
+    while (entry != NULL) {
+        int k = atoi(_z_str__z_str_sortedmap_entry_key(entry));
+        assert((k > prev) && present[k]);
+        prev = k;
+        len--;
+        _z_str__z_str_sortedmap_entry_free(&entry);
+        entry = _z_str__z_str_sortedmap_pop_first(&clone);
+    }
+    assert(len == 0);
+    assert(_z_str__z_str_sortedmap_is_empty(&clone));
+    _z_str__z_str_sortedmap_clear(&clone);
+}
+
 int main(void) {
     ring_test();
     ring_test_init_free();
@@ -730,4 +796,5 @@ int main(void) {
     sorted_map_copy_move_test();
     sorted_map_free_test();
     sorted_map_stress_test();
+    sorted_map_random_test();
 }
@@ -121,6 +121,178 @@ void str_vec_list_intmap_test(void) {
     z_free(s);
 }
 
+void hashmap_rehash_test(void) {
+    printf(">>> hashmap rehash\r\n");
+    _z_str_intmap_t map = _z_str_intmap_make();
+    size_t len = 200;
+    char s[64];
+    for (size_t i = 0; i < len; i++) {
+        snprintf(s, sizeof(s), "%zu", i);
+        _z_str_intmap_insert(&map, i, _z_str_clone(s));
+    }
+    // The map grew with the entries, keeping a load factor of at most 3/4
+    assert(_z_str_intmap_capacity(&map) == 512);
+    // Entries sharing a key keep their order, the latest pushed one shadows the others
+    _z_str_intmap_insert_push(&map, 7, _z_str_clone("shadow"));
+
+    // Capacities are rounded up to a power of 2 large enough for the entries
+    size_t capacities[] = {1024, 3, 300};
+    size_t expected[] = {1024, 512, 512};
+    for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++) {
+        assert(_z_hashmap_rehash(&map, capacities[c]) == _Z_RES_OK);
+        assert(_z_str_intmap_capacity(&map) == expected[c]);
+        assert(_z_str_intmap_len(&map) == len + 1);
+        for (size_t i = 0; i < len; i++) {
+            snprintf(s, sizeof(s), "%zu", i);
+            assert(_z_str_eq((i == 7) ? "shadow" : s, _z_str_intmap_get(&map, i)));
+        }
+    }
+    _z_str_intmap_remove(&map, 7);
+    assert(_z_str_eq("7", _z_str_intmap_get(&map, 7)));
+    _z_str_intmap_clear(&map);
+    assert(_z_str_intmap_is_empty(&map));
+
+    // Rehashing an empty map only changes the slots it allocates
+    map = _z_str_intmap_make();
+    assert(_z_hashmap_rehash(&map, 5) == _Z_RES_OK);
+    _z_str_intmap_insert(&map, 12, _z_str_clone("12"));
+    assert(_z_str_intmap_capacity(&map) == 8);
+    assert(_z_str_eq("12", _z_str_intmap_get(&map, 12)));
+    _z_str_intmap_clear(&map);
+}
+
+void hashmap_probing_test(void) {
+    printf(">>> hashmap probing\r\n");
+    // Keys sharing their home slot, and others displaced by them, to exercise the probe sequences
+    _z_str_intmap_t map = _z_str_intmap_make();
+    size_t capacity = _z_str_intmap_capacity(&map);
+    size_t keys[] = {3, 3 + 16, 4, 3 + 32, 5, 15, 15 + 16, 0};
+    size_t keys_nb = sizeof(keys) / sizeof(keys[0]);
+    char s[64];
+    for (size_t i = 0; i < keys_nb; i++) {
+        snprintf(s, sizeof(s), "%zu", keys[i]);
+        _z_str_intmap_insert(&map, keys[i], _z_str_clone(s));
+    }
+    assert(_z_str_intmap_capacity(&map) == capacity);
+    assert(_z_str_intmap_len(&map) == keys_nb);
+    for (size_t i = 0; i < keys_nb; i++) {
+        snprintf(s, sizeof(s), "%zu", keys[i]);
+        assert(_z_str_eq(s, _z_str_intmap_get(&map, keys[i])));
+    }
+    assert(_z_str_intmap_get(&map, 3 + 48) == NULL);
+    assert(_z_str_intmap_get(&map, 1) == NULL);
+
+    // Removals shift the displaced entries back, the remaining ones are still found
+    for (size_t i = 0; i < keys_nb; i++) {
+        _z_str_intmap_remove(&map, keys[i]);
+        assert(_z_str_intmap_get(&map, keys[i]) == NULL);
+        assert(_z_str_intmap_len(&map) == keys_nb - i - 1);
+        for (size_t j = i + 1; j < keys_nb; j++) {
+            snprintf(s, sizeof(s), "%zu", keys[j]);
+            assert(_z_str_eq(s, _z_str_intmap_get(&map, keys[j])));
+        }
+    }
+    assert(_z_str_intmap_is_empty(&map));
+
+    // All the entries of a key are returned, latest pushed first
+    _z_str_intmap_insert_push(&map, 3, _z_str_clone("a"));
+    _z_str_intmap_insert(&map, 3 + 16, _z_str_clone("x"));
+    _z_str_intmap_insert_push(&map, 3, _z_str_clone("b"));
+    _z_str_intmap_insert_push(&map, 3, _z_str_clone("c"));
+    _z_list_t *all = _z_str_intmap_get_all(&map, 3);
+    const char *expected[] = {"c", "b", "a"};
+    size_t n = 0;
+    for (_z_list_t *xs = all; xs != NULL; xs = _z_list_next(xs)) {
+        _z_int_void_map_entry_t *entry = (_z_int_void_map_entry_t *)_z_list_value(xs);
+        assert(*(size_t *)entry->_key == 3);
+        assert(_z_str_eq(expected[n], (char *)entry->_val));
+        n++;
+    }
+    assert(n == 3);
+    _z_list_free(&all, _z_noop_free);
+    assert(_z_str_intmap_get_all(&map, 4) == NULL);
+
+    // Replacing a key only replaces its latest entry
+    _z_str_intmap_insert(&map, 3, _z_str_clone("d"));
+    assert(_z_str_intmap_len(&map) == 4);
+    assert(_z_str_eq("d", _z_str_intmap_get(&map, 3)));
+    _z_str_intmap_remove(&map, 3);
+    assert(_z_str_eq("b", _z_str_intmap_get(&map, 3)));
+
+    // Clones keep the entries and their order
+    _z_str_intmap_t clone = _z_str_intmap_clone(&map);
+    assert(_z_str_intmap_len(&clone) == 3);
+    assert(_z_str_eq("b", _z_str_intmap_get(&clone, 3)));
+    assert(_z_str_eq("x", _z_str_intmap_get(&clone, 3 + 16)));
+    _z_str_intmap_clear(&clone);
+    _z_str_intmap_clear(&map);
+
+    // Removing the entry of the last slot shifts back the one that wrapped around into slot 0, it isn't returned twice
+    _z_str_intmap_insert(&map, 15, _z_str_clone("15"));
+    _z_str_intmap_insert(&map, 15 + 16, _z_str_clone("31"));
+    _z_str_intmap_insert(&map, 1, _z_str_clone("1"));
+    size_t returned = 0;
+    _z_str_intmap_iterator_t it = _z_str_intmap_iterator_make(&map);
+    while (_z_str_intmap_iterator_next(&it)) {
+        if (_z_str_intmap_iterator_key(&it) == 15) {
+            _z_str_intmap_remove(&map, 15);
+        }
+        returned++;
+    }
+    assert(returned == 3);
+    assert(_z_str_intmap_len(&map) == 2);
+    assert(_z_str_eq("31", _z_str_intmap_get(&map, 15 + 16)));
+    _z_str_intmap_clear(&map);
+}
+
+void hashmap_random_test(void) {
+    printf(">>> hashmap random\r\n");
+    // Compares the map with a plain array over random insertions and removals of a small key range
+#define RANDOM_KEY_NB 512
+    static bool present[RANDOM_KEY_NB];
+    memset(present, 0, sizeof(present));
+    _z_str_intmap_t map = _z_str_intmap_make();
+    size_t len = 0;
+    char s[64];
+    srand(7);
+    for (size_t round = 0; round < 20000; round++) {
+        size_t k = (size_t)rand() % RANDOM_KEY_NB;
+        if (rand() % 3 != 0) {
+            snprintf(s, sizeof(s), "%zu", k);
+            assert(_z_str_intmap_insert(&map, k, _z_str_clone(s)) != NULL);
+            len += present[k] ? 0 : 1;
+            present[k] = true;
+        } else {
+            _z_str_intmap_remove(&map, k);
+            len -= present[k] ? 1 : 0;
+            present[k] = false;
+        }
+        assert(_z_str_intmap_len(&map) == len);
+        if (round % 1000 == 0) {
+            for (size_t i = 0; i < RANDOM_KEY_NB; i++) {
+                assert((_z_str_intmap_get(&map, i) != NULL) == present[i]);
+            }
+            size_t it_len = 0;
+            _z_str_intmap_iterator_t it = _z_str_intmap_iterator_make(&map);
+            while (_z_str_intmap_iterator_next(&it)) {
+                assert(present[_z_str_intmap_iterator_key(&it)]);
+                it_len++;
+            }
+            assert(it_len == len);
+        }
+    }
+    // Removing the entries while iterating over them
+    _z_str_intmap_iterator_t it = _z_str_intmap_iterator_make(&map);
+    while (_z_str_intmap_iterator_next(&it)) {
+        _z_str_intmap_remove(&map, _z_str_intmap_iterator_key(&it));
+        len--;
+    }
+    assert(len == 0);
+    assert(_z_str_intmap_is_empty(&map));
+    _z_str_intmap_clear(&map);
+#undef RANDOM_KEY_NB
+}
+
 void _z_slice_custom_deleter(void *data, void *context) {
     _ZP_UNUSED(data);
     size_t *cnt = (size_t *)context;
@@ -227,6 +399,9 @@ void z_id_to_string_test(void) {
 
 int main(void) {
     str_vec_list_intmap_test();
+    hashmap_rehash_test();
+    hashmap_probing_test();
+    hashmap_random_test();
     z_slice_custom_delete_test();
     z_string_array_test();
     z_id_to_string_test();
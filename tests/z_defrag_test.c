@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/transport/common/rx.h"
+#include "zenoh-pico/transport/transport.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#define PAYLOAD_SIZE 600
+#define MAX_CHUNKS 16
+
+#if Z_FEATURE_FRAGMENTATION == 1
+
+static uint8_t payload_data[PAYLOAD_SIZE];
+
+// Encodes a put message and returns it as a single contiguous buffer
+static _z_zbuf_t encode_put(void) {
+    for (size_t i = 0; i < PAYLOAD_SIZE; i++) {
+        payload_data[i] = (uint8_t)(i * 7);
+    }
+    _z_bytes_t payload;
+    assert(_z_bytes_from_buf(&payload, payload_data, PAYLOAD_SIZE) == _Z_RES_OK);
+    _z_keyexpr_t key = _z_rid_with_suffix(0, "test/defrag");
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_put(&n_msg, &key, &payload, NULL, _Z_N_QOS_DEFAULT, NULL, NULL, Z_RELIABILITY_RELIABLE,
+                           NULL);
+    _z_wbuf_t wbf = _z_wbuf_make(PAYLOAD_SIZE * 2, false);
+    assert(_z_network_message_encode(&wbf, &n_msg) == _Z_RES_OK);
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    _z_wbuf_clear(&wbf);
+    _z_bytes_drop(&payload);
+    return zbf;
+}
+
+// Splits the encoded message over fragments received in rx buffers of rx_size bytes, the first one being first_len
+static void fill(_z_dbuf_t *dbuf, const _z_zbuf_t *msg, size_t first_len, size_t chunk_len, size_t rx_size) {
+    const uint8_t *data = _z_zbuf_start(msg);
+    size_t len = _z_zbuf_len(msg);
+    _z_zbuf_t rx[MAX_CHUNKS];
+    size_t nb = 0;
+    assert(_z_dbuf_init(dbuf, len) == _Z_RES_OK);
+    for (size_t offset = 0; offset < len; nb++) {
+        assert(nb < MAX_CHUNKS);
+        size_t n = (nb == 0) ? first_len : chunk_len;
+        n = (n < len - offset) ? n : len - offset;
+        rx[nb] = _z_zbuf_make(rx_size);
+        assert(_z_zbuf_capacity(&rx[nb]) == rx_size);
+        memcpy(_z_zbuf_get_wptr(&rx[nb]), data + offset, n);
+        _z_t_msg_fragment_t frag = {0};
+        frag._payload = _z_slice_alias_buf(_z_zbuf_get_wptr(&rx[nb]), n);
+        frag._src = &rx[nb]._slice;
+        assert(_z_dbuf_append(dbuf, &frag) == _Z_RES_OK);
+        offset += n;
+    }
+    assert(_z_dbuf_len(dbuf) == len);
+    // Rx buffers are recycled by the transport, the defragmentation buffer must not depend on them
+    for (size_t i = 0; i < nb; i++) {
+        _z_zbuf_clear(&rx[i]);
+    }
+}
+
+static void check(_z_dbuf_t *dbuf, size_t expected_slices) {
+    _z_network_message_t n_msg = {0};
+    _z_arc_slice_t arcs = _z_arc_slice_empty();
+    _z_zbuf_t zbf;
+    assert(_z_dbuf_decode(dbuf, &zbf, &n_msg, &arcs, 0) == _Z_RES_OK);
+    assert(_z_dbuf_len(dbuf) == 0);
+    assert(n_msg._tag == _Z_N_PUSH);
+    assert(n_msg._body._push._body._is_put);
+    const _z_bytes_t *payload = &n_msg._body._push._body._body._put._payload;
+    assert(_z_bytes_len(payload) == PAYLOAD_SIZE);
+    assert(_z_bytes_num_slices(payload) == expected_slices);
+    uint8_t out[PAYLOAD_SIZE];
+    assert(_z_bytes_to_buf(payload, out, PAYLOAD_SIZE) == PAYLOAD_SIZE);
+    assert(memcmp(out, payload_data, PAYLOAD_SIZE) == 0);
+    _z_n_msg_clear(&n_msg);
+    _z_zbuf_clear(&zbf);
+}
+
+static void test_reassemble(void) {
+    _z_zbuf_t msg = encode_put();
+    _z_dbuf_t dbuf = _z_dbuf_null();
+    fill(&dbuf, &msg, 200, 200, 256);
+#if defined(_Z_DEFRAG_CHAINED)
+    // Payload is referenced from the retained fragments
+    check(&dbuf, (_z_zbuf_len(&msg) + 199) / 200);
+#else
+    check(&dbuf, 1);
+#endif
+    _z_dbuf_clear(&dbuf);
+    _z_zbuf_clear(&msg);
+}
+
+static void test_small_fragments(void) {
+    _z_zbuf_t msg = encode_put();
+    _z_dbuf_t dbuf = _z_dbuf_null();
+    // Fragments filling little of their rx buffer are copied
+    fill(&dbuf, &msg, 100, 100, 1024);
+#if defined(_Z_DEFRAG_CHAINED)
+    check(&dbuf, (_z_zbuf_len(&msg) + 99) / 100);
+#else
+    check(&dbuf, 1);
+#endif
+    _z_dbuf_clear(&dbuf);
+    _z_zbuf_clear(&msg);
+}
+
+static void test_split_header(void) {
+    _z_zbuf_t msg = encode_put();
+    _z_dbuf_t dbuf = _z_dbuf_null();
+    // Header spans two fragments, message is decoded from a contiguous copy
+    fill(&dbuf, &msg, 3, 200, 256);
+    check(&dbuf, 1);
+    _z_dbuf_clear(&dbuf);
+    _z_zbuf_clear(&msg);
+}
+
+int main(void) {
+    test_reassemble();
+    test_small_fragments();
+    test_split_header();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_FRAGMENTATION\n");
+    return 0;
+}
+#endif
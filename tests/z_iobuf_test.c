@@ -609,6 +609,45 @@ void test_wbuf_wrap_bytes(void) {
     printf("Ok\n");
 }
 
+void test_wbuf_gather(void) {
+    printf("Testing wbuf_gather... ");
+    uint8_t val[VAL_SIZE];
+    memset(val, 0xaa, sizeof(val));
+    uint8_t payload[PAYLOAD_SIZE];
+    memset(payload, 0x55, sizeof(payload));
+    _z_wbuf_t wbf = _z_wbuf_make(PAYLOAD_SIZE, true);
+    _z_wbuf_write_bytes(&wbf, val, 0, sizeof(val));
+    _z_wbuf_wrap_bytes(&wbf, payload, 0, sizeof(payload));
+    _z_wbuf_write_bytes(&wbf, val, 0, 4);
+    size_t total = _z_wbuf_len(&wbf);
+
+    // Stops at the requested length, in the middle of the wrapped payload
+    _z_slice_t bufs[4];
+    size_t count = 0;
+    assert(_z_wbuf_gather(&wbf, bufs, &count, 4, VAL_SIZE + 10) == VAL_SIZE + 10);
+    assert(count == 2);
+    assert(bufs[0].len == VAL_SIZE && bufs[0].start[0] == 0xaa);
+    assert(bufs[1].len == 10 && bufs[1].start == payload);
+    assert(_z_wbuf_len(&wbf) == total - VAL_SIZE - 10);
+
+    // Stops when the slice array is full
+    count = 3;
+    assert(_z_wbuf_gather(&wbf, bufs, &count, 4, total) == PAYLOAD_SIZE - 10);
+    assert(count == 4);
+    assert(bufs[3].start == payload + 10);
+
+    // Consumes the rest
+    count = 0;
+    assert(_z_wbuf_gather(&wbf, bufs, &count, 4, total) == 4);
+    assert(count == 1 && bufs[0].start[0] == 0xaa);
+    assert(_z_wbuf_len(&wbf) == 0);
+    count = 0;
+    assert(_z_wbuf_gather(&wbf, bufs, &count, 4, total) == 0);
+    assert(count == 0);
+    _z_wbuf_clear(&wbf);
+    printf("Ok\n");
+}
+
 /*=============================*/
 /*            Main             */
 /*=============================*/
@@ -634,4 +673,5 @@ int main(void) {
         wbuf_reusable_write_zbuf_read();
     }
     test_wbuf_wrap_bytes();
+    test_wbuf_gather();
 }
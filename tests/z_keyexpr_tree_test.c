@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/collections/keyexpr_tree.h"
+#include "zenoh-pico/protocol/keyexpr.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#define KEY_NB 9
+
+static const char *keys[KEY_NB] = {
+    "a/b/c", "a/b", "a/*/c", "a/**", "**", "a/b$*/c", "x/y/z", "a/**/c", "a/b/c/d",
+};
+
+typedef struct {
+    size_t count[KEY_NB];
+} visit_ctx_t;
+
+static void visit(void *val, void *arg) {
+    visit_ctx_t *ctx = (visit_ctx_t *)arg;
+    size_t idx = (size_t)((const char **)val - keys);
+    ctx->count[idx]++;
+}
+
+// Candidates must be a superset of the intersecting keys, each reported once
+static void check_query(_z_keyexpr_tree_t *tree, const char *query, const bool *stored) {
+    visit_ctx_t ctx = {0};
+    _z_string_t q = _z_string_alias_str(query);
+    _z_keyexpr_tree_intersect(tree, &q, visit, &ctx);
+    for (size_t i = 0; i < KEY_NB; i++) {
+        assert(ctx.count[i] <= 1);
+        _z_keyexpr_t left = _z_rid_with_suffix(0, keys[i]);
+        _z_keyexpr_t right = _z_rid_with_suffix(0, query);
+        bool expected = stored[i] && _z_keyexpr_suffix_intersects(&left, &right);
+        if (expected && ctx.count[i] == 0) {
+            printf("Missing %s for query %s\n", keys[i], query);
+            assert(false);
+        }
+    }
+}
+
+static void test_intersect(void) {
+    _z_keyexpr_tree_t tree;
+    _z_keyexpr_tree_init(&tree);
+    bool stored[KEY_NB] = {0};
+    for (size_t i = 0; i < KEY_NB; i++) {
+        _z_string_t k = _z_string_alias_str(keys[i]);
+        assert(_z_keyexpr_tree_insert(&tree, &k, (void *)&keys[i]) == _Z_RES_OK);
+        stored[i] = true;
+    }
+    assert(_z_keyexpr_tree_len(&tree) == KEY_NB);
+
+    const char *queries[] = {"a/b/c", "a/b", "a/x/c", "a/bb/c", "x/y/z", "a/*", "*/b/**", "**", "a/b/c/d", "b"};
+    for (size_t i = 0; i < sizeof(queries) / sizeof(queries[0]); i++) {
+        check_query(&tree, queries[i], stored);
+    }
+
+    // Verbatim lookups don't report unrelated branches
+    visit_ctx_t ctx = {0};
+    _z_string_t q = _z_string_alias_str("x/y/z");
+    _z_keyexpr_tree_intersect(&tree, &q, visit, &ctx);
+    assert(ctx.count[6] == 1 && ctx.count[0] == 0 && ctx.count[1] == 0);
+
+    // Removal prunes the branch and only drops the given value
+    for (size_t i = 0; i < KEY_NB; i += 2) {
+        _z_string_t k = _z_string_alias_str(keys[i]);
+        assert(_z_keyexpr_tree_remove(&tree, &k, (void *)&keys[i]));
+        assert(!_z_keyexpr_tree_remove(&tree, &k, (void *)&keys[i]));
+        stored[i] = false;
+    }
+    assert(_z_keyexpr_tree_len(&tree) == KEY_NB / 2);
+    for (size_t i = 0; i < sizeof(queries) / sizeof(queries[0]); i++) {
+        check_query(&tree, queries[i], stored);
+    }
+    _z_keyexpr_tree_clear(&tree);
+    assert(_z_keyexpr_tree_len(&tree) == 0);
+}
+
+static void count_visit(void *val, void *arg) {
+    _ZP_UNUSED(arg);
+    (*(size_t *)val)++;
+}
+
+static void test_duplicates(void) {
+    _z_keyexpr_tree_t tree;
+    _z_keyexpr_tree_init(&tree);
+    int v1 = 1, v2 = 2;
+    _z_string_t k = _z_string_alias_str("demo/example/**");
+    assert(_z_keyexpr_tree_insert(&tree, &k, &v1) == _Z_RES_OK);
+    assert(_z_keyexpr_tree_insert(&tree, &k, &v2) == _Z_RES_OK);
+    assert(_z_keyexpr_tree_len(&tree) == 2);
+    assert(_z_keyexpr_tree_remove(&tree, &k, &v1));
+    assert(_z_keyexpr_tree_len(&tree) == 1);
+    _z_keyexpr_tree_clear(&tree);
+}
+
+// More matching nodes than the lookup tracks inline, each value is still reported once
+static void test_many_matches(void) {
+    _z_keyexpr_tree_t tree;
+    _z_keyexpr_tree_init(&tree);
+    enum { MATCH_NB = 40 };
+    char key_bufs[MATCH_NB][16];
+    size_t count[MATCH_NB] = {0};
+    for (size_t i = 0; i < MATCH_NB; i++) {
+        snprintf(key_bufs[i], sizeof(key_bufs[i]), "k/%zu/**", i);
+        _z_string_t k = _z_string_alias_str(key_bufs[i]);
+        assert(_z_keyexpr_tree_insert(&tree, &k, &count[i]) == _Z_RES_OK);
+    }
+    const char *queries[] = {"**", "k/**", "k/*/a/b"};
+    for (size_t j = 0; j < sizeof(queries) / sizeof(queries[0]); j++) {
+        memset(count, 0, sizeof(count));
+        _z_string_t q = _z_string_alias_str(queries[j]);
+        _z_keyexpr_tree_intersect(&tree, &q, count_visit, NULL);
+        for (size_t i = 0; i < MATCH_NB; i++) {
+            assert(count[i] == 1);
+        }
+    }
+    _z_keyexpr_tree_clear(&tree);
+}
+
+static bool int_eq(const void *left, const void *right) { return *(const int *)left == *(const int *)right; }
+
+// Both copies of the tree are updated, whichever one is published
+static void test_rcu(void) {
+    _z_keyexpr_tree_rcu_t tree;
+    assert(_z_keyexpr_tree_rcu_init(&tree) == _Z_RES_OK);
+    size_t counts[3] = {0};
+    _z_string_t k = _z_string_alias_str("a/b");
+    _z_string_t q = _z_string_alias_str("a/*");
+    for (size_t i = 0; i < 3; i++) {
+        assert(_z_keyexpr_tree_rcu_insert(&tree, &k, &counts[i]) == _Z_RES_OK);
+    }
+    for (size_t j = 0; j < 2; j++) {
+        memset(counts, 0, sizeof(counts));
+        _z_keyexpr_tree_rcu_intersect(&tree, &q, count_visit, NULL);
+        assert((counts[0] == 1) && (counts[1] == 1) && (counts[2] == 1));
+        assert(_z_keyexpr_tree_len(&tree._trees[0]) == _z_keyexpr_tree_len(&tree._trees[1]));
+    }
+    int v1 = 1, v2 = 2, probe = 2;
+    _z_string_t k2 = _z_string_alias_str("a/c");
+    assert(_z_keyexpr_tree_rcu_insert(&tree, &k2, &v1) == _Z_RES_OK);
+    assert(_z_keyexpr_tree_rcu_insert(&tree, &k2, &v2) == _Z_RES_OK);
+    assert(_z_keyexpr_tree_rcu_remove_if(&tree, &k2, int_eq, &probe) == &v2);
+    assert(_z_keyexpr_tree_rcu_remove_if(&tree, &k2, int_eq, &probe) == NULL);
+    assert(_z_keyexpr_tree_len(&tree._trees[0]) == 4);
+    assert(_z_keyexpr_tree_len(&tree._trees[1]) == 4);
+    _z_keyexpr_tree_rcu_clear(&tree);
+}
+
+int main(void) {
+    test_intersect();
+    test_duplicates();
+    test_many_matches();
+    test_rcu();
+    return 0;
+}
@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/fake_link.h"
+#include "zenoh-pico/link/link.h"
+#include "zenoh-pico/protocol/iobuf.h"
+#if defined(ZENOH_LINUX) || defined(ZENOH_MACOS) || defined(ZENOH_BSD)
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "zenoh-pico/system/link/tcp.h"
+#include "zenoh-pico/system/link/udp.h"
+#endif
+
+#undef NDEBUG
+#include <assert.h>
+
+#define OUT_SIZE 256
+
+// Header, wrapped payload then trailer, as built by the codec on expandable buffers
+static _z_wbuf_t make_wrapped_wbuf(const uint8_t *payload, size_t payload_len) {
+    _z_wbuf_t wbf = _z_wbuf_make(16, true);
+    assert(_z_wbuf_write_bytes(&wbf, (const uint8_t *)"head", 0, 4) == _Z_RES_OK);
+    assert(_z_wbuf_wrap_bytes(&wbf, payload, 0, payload_len) == _Z_RES_OK);
+    assert(_z_wbuf_write_bytes(&wbf, (const uint8_t *)"tail", 0, 4) == _Z_RES_OK);
+    assert(_z_wbuf_len_iosli(&wbf) > 1);
+    return wbf;
+}
+
+static void check_output(const uint8_t *payload, size_t payload_len) {
+    uint8_t out[OUT_SIZE];
+    size_t out_len = fake_link_join(out, OUT_SIZE);
+    assert(out_len == payload_len + 8);
+    assert(memcmp(out, "head", 4) == 0);
+    assert(memcmp(&out[4], payload, payload_len) == 0);
+    assert(memcmp(&out[4 + payload_len], "tail", 4) == 0);
+}
+
+static void test_send_wbuf_fallback(void) {
+    uint8_t payload[64];
+    memset(payload, 0xab, sizeof(payload));
+    _z_link_t link = {0};
+    link._write_f = fake_link_write;
+    link._cap._flow = Z_LINK_CAP_FLOW_DATAGRAM;
+
+    fake_link_reset();
+    _z_wbuf_t wbf = make_wrapped_wbuf(payload, sizeof(payload));
+    assert(_z_link_send_wbuf(&link, &wbf, NULL) == _Z_RES_OK);
+    assert(fake_link_write_calls > 1);
+    check_output(payload, sizeof(payload));
+    _z_wbuf_clear(&wbf);
+    fake_link_reset();
+}
+
+static void test_send_wbuf_vec(void) {
+    uint8_t payload[64];
+    memset(payload, 0xcd, sizeof(payload));
+    _z_link_t link = {0};
+    link._write_f = fake_link_write;
+    link._write_vec_f = fake_link_write_vec;
+    link._cap._flow = Z_LINK_CAP_FLOW_DATAGRAM;
+
+    fake_link_reset();
+    _z_wbuf_t wbf = make_wrapped_wbuf(payload, sizeof(payload));
+    assert(_z_link_send_wbuf(&link, &wbf, NULL) == _Z_RES_OK);
+#if defined(_Z_SYS_NET_SEND_VEC_MAX)
+    // Whole buffer goes out in a single gather write
+    assert(fake_link_write_vec_calls == 1);
+    assert(fake_link_write_calls == 0);
+#endif
+    check_output(payload, sizeof(payload));
+
+    // Single slice buffers keep using the plain write
+    fake_link_reset();
+    _z_wbuf_t flat = _z_wbuf_make(16, false);
+    assert(_z_wbuf_write_bytes(&flat, (const uint8_t *)"flat", 0, 4) == _Z_RES_OK);
+    assert(_z_link_send_wbuf(&link, &flat, NULL) == _Z_RES_OK);
+    assert(fake_link_write_calls == 1 && fake_link_write_vec_calls == 0);
+    _z_wbuf_clear(&flat);
+    _z_wbuf_clear(&wbf);
+    fake_link_reset();
+}
+
+static void test_send_vec_socket(void) {
+#if defined(_Z_SYS_NET_SEND_VEC_MAX) && Z_FEATURE_LINK_TCP == 1
+    int fds[2];
+    assert(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    _z_sys_net_socket_t sock = {0};
+    sock._fd = fds[0];
+    _z_slice_t bufs[3] = {
+        _z_slice_alias_buf((const uint8_t *)"abc", 3),
+        _z_slice_alias_buf((const uint8_t *)"defgh", 5),
+        _z_slice_alias_buf((const uint8_t *)"i", 1),
+    };
+    assert(_z_send_vec_tcp(sock, bufs, 3) == 9);
+    char rcv[16] = {0};
+    assert(read(fds[1], rcv, sizeof(rcv)) == 9);
+    assert(memcmp(rcv, "abcdefghi", 9) == 0);
+    close(fds[0]);
+    close(fds[1]);
+#endif
+}
+
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+static size_t fake_read_vec(const _z_link_t *self, _z_slice_t *bufs, size_t count, _z_slice_t *addrs) {
+    _ZP_UNUSED(self);
+    _ZP_UNUSED(addrs);
+    // Three datagrams are pending, the second one is empty
+    size_t n = (count < 3) ? count : 3;
+    for (size_t i = 0; i < n; i++) {
+        size_t len = (i == 1) ? 0 : i + 1;
+        assert(bufs[i].len >= len);
+        memset((uint8_t *)bufs[i].start, (int)i, len);
+        bufs[i].len = len;
+    }
+    return n;
+}
+#endif
+
+static void test_recv_zbuf_vec(void) {
+#if defined(_Z_SYS_NET_RECV_VEC_MAX)
+    _z_link_t link = {0};
+    link._read_vec_f = fake_read_vec;
+    link._cap._flow = Z_LINK_CAP_FLOW_DATAGRAM;
+
+    _z_zbuf_t zbfs[4];
+    _z_zbuf_t *pzbfs[4];
+    for (size_t i = 0; i < 4; i++) {
+        zbfs[i] = _z_zbuf_make(16);
+        pzbfs[i] = &zbfs[i];
+    }
+    assert(_z_link_recv_zbuf_vec(&link, pzbfs, 4, NULL) == 3);
+    assert(_z_zbuf_len(&zbfs[0]) == 1 && _z_zbuf_read(&zbfs[0]) == 0);
+    assert(_z_zbuf_len(&zbfs[1]) == 0);
+    assert(_z_zbuf_len(&zbfs[2]) == 3 && _z_zbuf_read(&zbfs[2]) == 2);
+    assert(_z_zbuf_len(&zbfs[3]) == 0);
+    for (size_t i = 0; i < 4; i++) {
+        _z_zbuf_clear(&zbfs[i]);
+    }
+#endif
+}
+
+static void test_read_vec_socket(void) {
+#if defined(_Z_SYS_NET_RECV_VEC_MAX) && Z_FEATURE_LINK_UDP_UNICAST == 1
+    int fds[2];
+    assert(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) == 0);
+    assert(write(fds[1], "abc", 3) == 3);
+    assert(write(fds[1], "defgh", 5) == 5);
+    _z_sys_net_socket_t sock = {0};
+    sock._fd = fds[0];
+
+    uint8_t rcv[4][8];
+    _z_slice_t bufs[4];
+    for (size_t i = 0; i < 4; i++) {
+        bufs[i] = _z_slice_alias_buf(rcv[i], sizeof(rcv[i]));
+    }
+    // All queued datagrams come out of a single call
+    assert(_z_read_vec_udp_unicast(sock, bufs, 4) == 2);
+    assert(bufs[0].len == 3 && memcmp(rcv[0], "abc", 3) == 0);
+    assert(bufs[1].len == 5 && memcmp(rcv[1], "defgh", 5) == 0);
+    close(fds[0]);
+    close(fds[1]);
+#endif
+}
+
+int main(void) {
+    test_send_wbuf_fallback();
+    test_send_wbuf_vec();
+    test_send_vec_socket();
+    test_recv_zbuf_vec();
+    test_read_vec_socket();
+    return 0;
+}
@@ -115,6 +115,12 @@ static void query_dropper(void *arg) {
     atomic_fetch_add_explicit(&g_query_drop_callback_count, 1, memory_order_relaxed);
 }
 
+static _z_pending_query_t *first_pending_query(void) {
+    _z_pending_query_intmap_iterator_t it = _z_pending_query_intmap_iterator_make(&g_session._pending_queries);
+    assert(_z_pending_query_intmap_iterator_next(&it));
+    return _z_pending_query_intmap_iterator_value(&it);
+}
+
 static void add_fake_peer(void) {
     // Add a fake peer to simulate a remote connection
     g_session._tp._transport._unicast._peers =
@@ -361,7 +367,7 @@ static void test_query_local_only_single(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_intmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, queryable_rc);
     cleanup_local_resource(&keyexpr, &expanded, rid);
@@ -434,7 +440,8 @@ static void test_put_local_and_remote(void) {
     // Session-local only delivery should not touch transport
     z_result_t res =
         _z_write(&g_session, &keyexpr, &payload, &encoding, Z_SAMPLE_KIND_PUT, Z_CONGESTION_CONTROL_BLOCK,
-                 Z_PRIORITY_DEFAULT, false, &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info, Z_LOCALITY_SESSION_LOCAL);
+                 Z_PRIORITY_DEFAULT, false, &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info, Z_LOCALITY_SESSION_LOCAL,
+                 NULL);
     assert(res == _Z_RES_OK);
     assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
@@ -443,7 +450,7 @@ static void test_put_local_and_remote(void) {
     atomic_store_explicit(&g_local_put_delivery_count, 0, memory_order_relaxed);
     atomic_store_explicit(&g_network_send_count, 0, memory_order_relaxed);
     res = _z_write(&g_session, &keyexpr, &payload, &encoding, Z_SAMPLE_KIND_PUT, Z_CONGESTION_CONTROL_BLOCK,
-                   Z_PRIORITY_DEFAULT, false, &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info, Z_LOCALITY_ANY);
+                   Z_PRIORITY_DEFAULT, false, &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info, Z_LOCALITY_ANY, NULL);
     assert(res == _Z_RES_OK);
     assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
@@ -489,7 +496,7 @@ static void test_query_local_only_multiple(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_intmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, queryable_secondary);
     _z_unregister_session_queryable(&g_session, queryable_primary);
@@ -527,7 +534,7 @@ static void test_query_local_and_remote(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_intmap_is_empty(&g_session._pending_queries));
 
     atomic_store_explicit(&g_local_query_delivery_count, 0, memory_order_relaxed);
     atomic_store_explicit(&g_query_reply_callback_count, 0, memory_order_relaxed);
@@ -544,10 +551,10 @@ static void test_query_local_and_remote(void) {
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_network_final_send_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries != NULL);
+    assert(!_z_pending_query_intmap_is_empty(&g_session._pending_queries));
 
     // Simulate REPLY from remote queryable
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     _z_zint_t request_id = pq->_id;
 
     const char remote_data[] = "remote-response";
@@ -572,7 +579,7 @@ static void test_query_local_and_remote(void) {
     // will be delivered on RESPONSE_FINAL
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 0);
-    assert(g_session._pending_queries != NULL);
+    assert(!_z_pending_query_intmap_is_empty(&g_session._pending_queries));
 
     // Receiving RESPONSE_FINAL from remote queryable
     _z_network_message_t final_msg;
@@ -583,7 +590,7 @@ static void test_query_local_and_remote(void) {
     // Remote reply delivered, query finalized
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_intmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, queryable_primary);
     cleanup_local_resource(&keyexpr, &expanded, rid);
@@ -634,7 +641,7 @@ static void test_query_local_and_remote_via_api(void) {
                 z_move(r_closure), &gopt);
     assert(res == Z_OK);
 
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     assert(pq != NULL);
     _z_zint_t request_id = pq->_id;
 
@@ -663,7 +670,7 @@ static void test_query_local_and_remote_via_api(void) {
 
     assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 1);
     assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_intmap_is_empty(&g_session._pending_queries));
 
     z_moved_queryable_t *mq = z_queryable_move(&queryable);
     z_queryable_drop(mq);
@@ -698,7 +705,7 @@ static void test_put_remote_only_destination(void) {
 
     z_result_t res =
         _z_write(&g_session, &keyexpr, &payload, &encoding, Z_SAMPLE_KIND_PUT, Z_CONGESTION_CONTROL_BLOCK,
-                 Z_PRIORITY_DEFAULT, false, &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info, Z_LOCALITY_REMOTE);
+                 Z_PRIORITY_DEFAULT, false, &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info, Z_LOCALITY_REMOTE, NULL);
     assert(res == _Z_RES_OK);
     assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
@@ -734,7 +741,7 @@ static void test_subscriber_remote_only_origin(void) {
 
     z_result_t res =
         _z_write(&g_session, &keyexpr, &payload, &encoding, Z_SAMPLE_KIND_PUT, Z_CONGESTION_CONTROL_BLOCK,
-                 Z_PRIORITY_DEFAULT, false, &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info, Z_LOCALITY_ANY);
+                 Z_PRIORITY_DEFAULT, false, &ts, NULL, Z_RELIABILITY_RELIABLE, &source_info, Z_LOCALITY_ANY, NULL);
     assert(res == _Z_RES_OK);
     assert(atomic_load_explicit(&g_local_put_delivery_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
@@ -773,13 +780,13 @@ static void test_query_remote_only_destination(void) {
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
 
     // Clean pending query by simulating RESPONSE_FINAL
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     assert(pq != NULL);
     _z_network_message_t final_msg;
     _z_n_msg_make_response_final(&final_msg, pq->_id);
     res = _z_handle_network_message(&g_fake_transport, &final_msg, NULL);
     assert(res == _Z_RES_OK);
-    assert(g_session._pending_queries == NULL);
+    assert(_z_pending_query_intmap_is_empty(&g_session._pending_queries));
 
     _z_unregister_session_queryable(&g_session, queryable_rc);
     cleanup_local_resource(&keyexpr, &expanded, rid);
@@ -787,6 +794,139 @@ static void test_query_remote_only_destination(void) {
     cleanup_session();
 }
 
+static void test_query_timeout(void) {
+    setup_session();
+    add_fake_peer();
+
+    _z_keyexpr_t keyexpr = _z_keyexpr_null();
+    _z_keyexpr_t expanded = _z_keyexpr_null();
+    uint16_t rid = 0;
+    create_local_resource("zenoh-pico/tests/local/query/timeout", &keyexpr, &expanded, &rid);
+
+    atomic_store_explicit(&g_query_drop_callback_count, 0, memory_order_relaxed);
+
+    _z_n_qos_t qos = _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT);
+    _z_zint_t short_id = 0;
+    _z_zint_t long_id = 0;
+    assert(_z_query(&g_session, &keyexpr, NULL, 0, Z_QUERY_TARGET_DEFAULT, Z_CONSOLIDATION_MODE_LATEST, NULL, NULL,
+                    query_reply_callback, query_dropper, NULL, 50, NULL, qos, Z_LOCALITY_REMOTE,
+                    &short_id) == _Z_RES_OK);
+    assert(_z_query(&g_session, &keyexpr, NULL, 0, Z_QUERY_TARGET_DEFAULT, Z_CONSOLIDATION_MODE_LATEST, NULL, NULL,
+                    query_reply_callback, query_dropper, NULL, 60000, NULL, qos, Z_LOCALITY_REMOTE,
+                    &long_id) == _Z_RES_OK);
+    assert(_z_pending_query_intmap_len(&g_session._pending_queries) == 2);
+    assert(_z_timer_wheel_len(&g_session._pending_query_timers) == 2);
+
+    _z_pending_query_process_timeout(&g_session);
+    assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 0);
+
+    // Only the query whose timeout elapsed is dropped
+    z_sleep_ms(100);
+    _z_pending_query_process_timeout(&g_session);
+    assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
+    assert(_z_get_pending_query_by_id(&g_session, short_id) == NULL);
+    assert(_z_get_pending_query_by_id(&g_session, long_id) != NULL);
+
+    // A finalized query no longer has a deadline
+    _z_network_message_t final_msg;
+    _z_n_msg_make_response_final(&final_msg, long_id);
+    assert(_z_handle_network_message(&g_fake_transport, &final_msg, NULL) == _Z_RES_OK);
+    assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 2);
+    assert(_z_pending_query_intmap_is_empty(&g_session._pending_queries));
+    assert(_z_timer_wheel_len(&g_session._pending_query_timers) == 0);
+
+    cleanup_local_resource(&keyexpr, &expanded, rid);
+
+    cleanup_session();
+}
+
+#define CONSOLIDATION_KEY_NB 500
+
+static atomic_uint g_query_stale_reply_count = 0;
+
+static void query_latest_reply_callback(_z_reply_t *reply, void *arg) {
+    uint64_t newest = *(uint64_t *)arg;
+    if (reply->data._result.sample.timestamp.time != newest) {
+        atomic_fetch_add_explicit(&g_query_stale_reply_count, 1, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&g_query_reply_callback_count, 1, memory_order_relaxed);
+}
+
+static void send_remote_reply(_z_zint_t request_id, size_t key_idx, uint64_t time) {
+    char key_str[64];
+    snprintf(key_str, sizeof(key_str), "zenoh-pico/tests/local/query/consolidation/%zu", key_idx);
+    _z_keyexpr_t ke = _z_keyexpr_null();
+    ke._id = Z_RESOURCE_ID_NONE;
+    ke._mapping = _Z_KEYEXPR_MAPPING_LOCAL;
+    ke._suffix = _z_string_copy_from_str(key_str);
+
+    const char data[] = "remote-response";
+    _z_bytes_t payload = _z_bytes_null();
+    assert(_z_bytes_from_buf(&payload, (const uint8_t *)data, sizeof(data) - 1) == _Z_RES_OK);
+    _z_id_t remote_zid = _z_id_empty();
+    _z_encoding_t encoding = _z_encoding_null();
+    _z_timestamp_t timestamp = _z_timestamp_null();
+    timestamp.time = time;
+    _z_source_info_t source_info = _z_source_info_null();
+    _z_n_qos_t qos = _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT);
+
+    _z_network_message_t reply_msg;
+    _z_n_msg_make_reply_ok_put(&reply_msg, &remote_zid, request_id, &ke, Z_RELIABILITY_RELIABLE,
+                               Z_CONSOLIDATION_MODE_DEFAULT, qos, &timestamp, &source_info, &payload, &encoding, NULL);
+    assert(_z_handle_network_message(&g_fake_transport, &reply_msg, NULL) == _Z_RES_OK);
+}
+
+static void test_query_latest_consolidation_many_keys(void) {
+    setup_session();
+    add_fake_peer();
+
+    _z_keyexpr_t keyexpr = _z_keyexpr_null();
+    _z_keyexpr_t expanded = _z_keyexpr_null();
+    uint16_t rid = 0;
+    create_local_resource("zenoh-pico/tests/local/query/consolidation/**", &keyexpr, &expanded, &rid);
+
+    atomic_store_explicit(&g_query_reply_callback_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_query_drop_callback_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_query_stale_reply_count, 0, memory_order_relaxed);
+
+    uint64_t newest = 2;
+    _z_n_qos_t qos = _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT);
+    _z_zint_t query_id = 0;
+    assert(_z_query(&g_session, &keyexpr, NULL, 0, Z_QUERY_TARGET_DEFAULT, Z_CONSOLIDATION_MODE_LATEST, NULL, NULL,
+                    query_latest_reply_callback, query_dropper, &newest, 1000, NULL, qos, Z_LOCALITY_REMOTE,
+                    &query_id) == _Z_RES_OK);
+
+    // Each key gets replaced by a newer reply, then an older one that must be ignored
+    for (size_t i = 0; i < CONSOLIDATION_KEY_NB; i++) {
+        send_remote_reply(query_id, i, 1);
+    }
+    for (size_t i = 0; i < CONSOLIDATION_KEY_NB; i++) {
+        send_remote_reply(query_id, i, newest);
+    }
+    for (size_t i = 0; i < CONSOLIDATION_KEY_NB; i++) {
+        send_remote_reply(query_id, i, 1);
+    }
+    assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == 0);
+    _z_pending_query_t *pq = _z_get_pending_query_by_id(&g_session, query_id);
+    assert(pq != NULL);
+    assert(_z_hashmap_len(&pq->_pending_replies_index) == CONSOLIDATION_KEY_NB);
+    assert(_z_pending_reply_slist_len(pq->_pending_replies) == CONSOLIDATION_KEY_NB);
+    // The index grew with the replies
+    assert(_z_hashmap_capacity(&pq->_pending_replies_index) >= CONSOLIDATION_KEY_NB);
+
+    _z_network_message_t final_msg;
+    _z_n_msg_make_response_final(&final_msg, query_id);
+    assert(_z_handle_network_message(&g_fake_transport, &final_msg, NULL) == _Z_RES_OK);
+    assert(atomic_load_explicit(&g_query_reply_callback_count, memory_order_relaxed) == CONSOLIDATION_KEY_NB);
+    assert(atomic_load_explicit(&g_query_stale_reply_count, memory_order_relaxed) == 0);
+    assert(atomic_load_explicit(&g_query_drop_callback_count, memory_order_relaxed) == 1);
+    assert(_z_pending_query_intmap_is_empty(&g_session._pending_queries));
+
+    cleanup_local_resource(&keyexpr, &expanded, rid);
+
+    cleanup_session();
+}
+
 static void test_queryable_remote_only_origin(void) {
     setup_session();
     add_fake_peer();
@@ -811,7 +951,7 @@ static void test_queryable_remote_only_origin(void) {
     assert(atomic_load_explicit(&g_local_query_delivery_count, memory_order_relaxed) == 0);
     assert(atomic_load_explicit(&g_network_send_count, memory_order_relaxed) == 1);
 
-    _z_pending_query_t *pq = _z_pending_query_slist_value(g_session._pending_queries);
+    _z_pending_query_t *pq = first_pending_query();
     assert(pq != NULL);
     _z_network_message_t final_msg2;
     _z_n_msg_make_response_final(&final_msg2, pq->_id);
@@ -837,6 +977,8 @@ int main(void) {
     test_put_remote_only_destination();
     test_subscriber_remote_only_origin();
     test_query_remote_only_destination();
+    test_query_timeout();
+    test_query_latest_consolidation_many_keys();
     test_queryable_remote_only_origin();
     return 0;
 }
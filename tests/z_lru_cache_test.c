@@ -29,21 +29,20 @@ typedef struct _dummy_t {
     int foo;
 } _dummy_t;
 
-int _dummy_compare(const void *first, const void *second) {
-    _dummy_t *d_first = (_dummy_t *)first;
-    _dummy_t *d_second = (_dummy_t *)second;
+size_t _dummy_hash(const void *e) { return (size_t)((const _dummy_t *)e)->foo; }
 
-    if (d_first->foo == d_second->foo) {
-        return 0;
-    } else if (d_first->foo > d_second->foo) {
-        return 1;
-    }
-    return -1;
+bool _dummy_eq(const void *first, const void *second) {
+    return ((const _dummy_t *)first)->foo == ((const _dummy_t *)second)->foo;
 }
 
-static inline void _dummy_elem_clear(void *e) { _z_noop_clear((_dummy_t *)e); }
+static size_t _dummy_cleared = 0;
+
+static inline void _dummy_elem_clear(void *e) {
+    _z_noop_clear((_dummy_t *)e);
+    _dummy_cleared++;
+}
 
-_Z_LRU_CACHE_DEFINE(_dummy, _dummy_t, _dummy_compare)
+_Z_LRU_CACHE_DEFINE(_dummy, _dummy_t, _dummy_hash, _dummy_eq)
 
 void test_lru_init(void) {
     _dummy_lru_cache_t dcache = _dummy_lru_cache_init(CACHE_CAPACITY);
@@ -51,17 +50,19 @@ void test_lru_init(void) {
     assert(dcache.len == 0);
     assert(dcache.head == NULL);
     assert(dcache.tail == NULL);
-    assert(dcache.slist == NULL);
+    assert(dcache.table == NULL);
+    // At least a bucket per node
+    assert(dcache.table_mask + 1 == 16);
 }
 
 void test_lru_cache_insert(void) {
     _dummy_lru_cache_t dcache = _dummy_lru_cache_init(CACHE_CAPACITY);
 
     _dummy_t v0 = {0};
-    assert(dcache.slist == NULL);
+    assert(dcache.table == NULL);
     assert(_dummy_lru_cache_get(&dcache, &v0) == NULL);
     assert(_dummy_lru_cache_insert(&dcache, &v0) == 0);
-    assert(dcache.slist != NULL);
+    assert(dcache.table != NULL);
     _dummy_t *res = _dummy_lru_cache_get(&dcache, &v0);
     assert(res != NULL);
     assert(res->foo == v0.foo);
@@ -90,7 +91,7 @@ void test_lru_cache_clear(void) {
     _dummy_lru_cache_clear(&dcache);
     assert(dcache.capacity == CACHE_CAPACITY);
     assert(dcache.len == 0);
-    assert(dcache.slist != NULL);
+    assert(dcache.table != NULL);
     assert(dcache.head == NULL);
     assert(dcache.tail == NULL);
     for (size_t i = 0; i < CACHE_CAPACITY; i++) {
@@ -103,12 +104,14 @@ void test_lru_cache_deletion(void) {
     _dummy_lru_cache_t dcache = _dummy_lru_cache_init(CACHE_CAPACITY);
 
     _dummy_t data[CACHE_CAPACITY + 1] = {0};
+    _dummy_cleared = 0;
     for (size_t i = 0; i < CACHE_CAPACITY + 1; i++) {
         data[i].foo = (int)i;
         assert(_dummy_lru_cache_insert(&dcache, &data[i]) == 0);
     }
-    // Check value deleted
+    // Check value deleted, and cleared
     assert(_dummy_lru_cache_get(&dcache, &data[0]) == NULL);
+    assert(_dummy_cleared == 1);
     // Check remaining value
     for (size_t i = 1; i < CACHE_CAPACITY + 1; i++) {
         _dummy_t *res = _dummy_lru_cache_get(&dcache, &data[i]);
@@ -206,53 +209,36 @@ void test_lru_cache_random_val(void) {
     _dummy_lru_cache_delete(&dcache);
 }
 
-#if 0
-#define BENCH_THRESHOLD 1000000
-
-void test_search_benchmark(size_t capacity) {
-    _dummy_lru_cache_t dcache = _dummy_lru_cache_init(capacity);
-    _dummy_t data[capacity];
-    memset(data, 0, capacity * sizeof(_dummy_t));
-
-    srand(0x55);
-    // Insert data
+// Values sharing a bucket are told apart, and evicted in lru order
+void test_lru_cache_collisions(void) {
+    _dummy_lru_cache_t dcache = _dummy_lru_cache_init(CACHE_CAPACITY);
+    size_t buckets = dcache.table_mask + 1;
+    _dummy_t data[2 * CACHE_CAPACITY] = {0};
     for (size_t i = 0; i < _ZP_ARRAY_SIZE(data); i++) {
-        data[i].foo = rand();
+        data[i].foo = (int)(i * buckets);
+    }
+    for (size_t i = 0; i < CACHE_CAPACITY; i++) {
         assert(_dummy_lru_cache_insert(&dcache, &data[i]) == 0);
     }
-    z_clock_t measure_start = z_clock_now();
-    for (size_t get_cnt = 0; get_cnt <= BENCH_THRESHOLD; get_cnt++) {
-        int i = rand() % (int)_ZP_ARRAY_SIZE(data);
-        _dummy_t *src = &data[i];
-        _dummy_t *res = _dummy_lru_cache_get(&dcache, src);
-        assert(res != NULL);
+    for (size_t i = 0; i < CACHE_CAPACITY; i += 2) {
+        assert(_dummy_lru_cache_get(&dcache, &data[i])->foo == data[i].foo);
     }
-    unsigned long elapsed_us = z_clock_elapsed_us(&measure_start);
-    printf("Time to search: %ld\n", elapsed_us);
-}
-
-void test_insert_benchmark(size_t capacity) {
-    _dummy_lru_cache_t dcache = _dummy_lru_cache_init(capacity);
-
-    srand(0x55);
-    // Insert data
-    z_clock_t measure_start = z_clock_now();
-    for (size_t get_cnt = 0; get_cnt <= BENCH_THRESHOLD; get_cnt++) {
-        _dummy_t data = {.foo = rand()};
-        assert(_dummy_lru_cache_insert(&dcache, &data) == 0);
+    for (size_t i = CACHE_CAPACITY; i < CACHE_CAPACITY + CACHE_CAPACITY / 2; i++) {
+        assert(_dummy_lru_cache_get(&dcache, &data[i]) == NULL);
+        assert(_dummy_lru_cache_insert(&dcache, &data[i]) == 0);
     }
-    unsigned long elapsed_us = z_clock_elapsed_us(&measure_start);
-    printf("Time to insert: %ld\n", elapsed_us);
-}
-
-void test_benchmark(void) {
-    for (size_t i = 1; i <= BENCH_THRESHOLD; i *= 10) {
-        printf("Capacity: %ld\n", i);
-        test_search_benchmark(i);
-        test_insert_benchmark(i);
+    // The odd values were the least recently used ones
+    for (size_t i = 0; i < CACHE_CAPACITY + CACHE_CAPACITY / 2; i++) {
+        _dummy_t *res = _dummy_lru_cache_get(&dcache, &data[i]);
+        if ((i < CACHE_CAPACITY) && (i % 2 == 1)) {
+            assert(res == NULL);
+        } else {
+            assert((res != NULL) && (res->foo == data[i].foo));
+        }
     }
+    assert(dcache.len == CACHE_CAPACITY);
+    _dummy_lru_cache_delete(&dcache);
 }
-#endif
 
 int main(void) {
     test_lru_init();
@@ -261,8 +247,6 @@ int main(void) {
     test_lru_cache_deletion();
     test_lru_cache_update();
     test_lru_cache_random_val();
-#if 0
-    test_benchmark();
-#endif
+    test_lru_cache_collisions();
     return 0;
 }
@@ -1308,12 +1308,16 @@ _z_push_body_t gen_push_body(void) {
     _z_source_info_t sinfo = gen_bool() ? gen_source_info() : _z_source_info_null();
     _z_m_push_commons_t commons = {._source_info = sinfo, ._timestamp = ts};
     if (isput) {
-        return (_z_push_body_t){._is_put = true,
-                                ._body._put = {
-                                    ._commons = commons,
-                                    ._payload = gen_bytes(64),
-                                    ._encoding = gen_encoding(),
-                                }};
+        _z_push_body_t body = {._is_put = true,
+                               ._body._put = {
+                                   ._commons = commons,
+                                   ._payload = gen_bytes(64),
+                                   ._encoding = gen_encoding(),
+                               }};
+#if Z_FEATURE_SHM == 1
+        body._body._put._is_shm = gen_bool();
+#endif
+        return body;
     } else {
         return (_z_push_body_t){._is_put = false, ._body._del = {._commons = commons}};
     }
@@ -1326,6 +1330,9 @@ void assert_eq_push_body(const _z_push_body_t *left, const _z_push_body_t *right
         assert_eq_encoding(&left->_body._put._encoding, &right->_body._put._encoding);
         assert_eq_timestamp(&left->_body._put._commons._timestamp, &right->_body._put._commons._timestamp);
         assert_eq_source_info(&left->_body._put._commons._source_info, &right->_body._put._commons._source_info);
+#if Z_FEATURE_SHM == 1
+        assert(left->_body._put._is_shm == right->_body._put._is_shm);
+#endif
     } else {
         assert_eq_timestamp(&left->_body._del._commons._timestamp, &right->_body._del._commons._timestamp);
         assert_eq_source_info(&left->_body._del._commons._source_info, &right->_body._del._commons._source_info);
@@ -1488,6 +1495,41 @@ void push_message(void) {
     _z_wbuf_clear(&wbf);
 }
 
+void push_encoded_header_message(void) {
+    printf("\n>> Push message with encoded header\n");
+    _z_n_msg_push_t expected = gen_push();
+    // Encode the header once
+    _z_wbuf_t hdr_wbf = gen_wbuf(UINT16_MAX);
+    assert(_z_push_header_encode(&hdr_wbf, &expected) == _Z_RES_OK);
+    _z_zbuf_t hdr_zbf = _z_wbuf_to_zbuf(&hdr_wbf);
+    _z_slice_t hdr = _z_slice_alias_buf(_z_zbuf_start(&hdr_zbf), _z_zbuf_len(&hdr_zbf));
+    // The message is encoded the same with and without it
+    _z_wbuf_t wbf = gen_wbuf(UINT16_MAX);
+    assert(_z_push_encode(&wbf, &expected) == _Z_RES_OK);
+    _z_wbuf_t hdr_msg_wbf = gen_wbuf(UINT16_MAX);
+    expected._encoded_header = &hdr;
+    assert(_z_push_encode(&hdr_msg_wbf, &expected) == _Z_RES_OK);
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+    _z_zbuf_t hdr_msg_zbf = _z_wbuf_to_zbuf(&hdr_msg_wbf);
+    assert(_z_zbuf_len(&zbf) == _z_zbuf_len(&hdr_msg_zbf));
+    assert(memcmp(_z_zbuf_start(&zbf), _z_zbuf_start(&hdr_msg_zbf), _z_zbuf_len(&zbf)) == 0);
+
+    _z_n_msg_push_t decoded = {0};
+    _z_arc_slice_t arcs = {0};
+    uint8_t header = _z_zbuf_read(&hdr_msg_zbf);
+    assert(_Z_RES_OK == _z_push_decode(&decoded, &hdr_msg_zbf, header, &arcs, _Z_KEYEXPR_MAPPING_LOCAL));
+    assert(decoded._encoded_header == NULL);
+    assert_eq_push(&expected, &decoded);
+    _z_n_msg_push_clear(&decoded);
+    _z_n_msg_push_clear(&expected);
+    _z_zbuf_clear(&hdr_msg_zbf);
+    _z_zbuf_clear(&zbf);
+    _z_zbuf_clear(&hdr_zbf);
+    _z_wbuf_clear(&hdr_msg_wbf);
+    _z_wbuf_clear(&wbf);
+    _z_wbuf_clear(&hdr_wbf);
+}
+
 _z_n_msg_request_t gen_request(void) {
     _z_qos_t qos_default = {._val = 5};
     _z_n_msg_request_t request = {
@@ -1711,7 +1753,14 @@ _z_transport_message_t gen_join(void) {
         conduit._val._plain._best_effort = gen_zint();
         conduit._val._plain._reliable = gen_zint();
     }
-    return _z_t_msg_make_join(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zint(), gen_zid(), conduit);
+    _z_transport_message_t t_msg =
+        _z_t_msg_make_join(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zint(), gen_zid(), conduit);
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    if (gen_bool()) {
+        _z_t_msg_join_set_retx(&t_msg, gen_uint16());
+    }
+#endif
+    return t_msg;
 }
 void assert_eq_join(const _z_t_msg_join_t *left, const _z_t_msg_join_t *right) {
     assert(memcmp(left->_zid.id, right->_zid.id, 16) == 0);
@@ -1731,6 +1780,9 @@ void assert_eq_join(const _z_t_msg_join_t *left, const _z_t_msg_join_t *right) {
         assert(left->_next_sn._val._plain._best_effort == right->_next_sn._val._plain._best_effort);
         assert(left->_next_sn._val._plain._reliable == right->_next_sn._val._plain._reliable);
     }
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+    assert(left->_retx_window == right->_retx_window);
+#endif
 }
 void join_message(void) {
     printf("\n>> Join message\n");
@@ -1749,11 +1801,20 @@ void join_message(void) {
 }
 
 _z_transport_message_t gen_init(void) {
+    _z_transport_message_t msg;
     if (gen_bool()) {
-        return _z_t_msg_make_init_syn(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zid());
+        msg = _z_t_msg_make_init_syn(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zid());
     } else {
-        return _z_t_msg_make_init_ack(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zid(), gen_slice(16));
+        msg = _z_t_msg_make_init_ack(_z_whatami_from_uint8((gen_uint8() % 3)), gen_zid(), gen_slice(16));
     }
+#if Z_FEATURE_SHM == 1
+    if (gen_bool()) {
+        uint8_t host_id[_Z_SHM_HOST_ID_LEN];
+        z_random_fill(host_id, sizeof(host_id));
+        _z_t_msg_init_set_shm(&msg, host_id);
+    }
+#endif
+    return msg;
 }
 void assert_eq_init(const _z_t_msg_init_t *left, const _z_t_msg_init_t *right) {
     assert(left->_batch_size == right->_batch_size);
@@ -1763,6 +1824,12 @@ void assert_eq_init(const _z_t_msg_init_t *left, const _z_t_msg_init_t *right) {
     assert(memcmp(left->_zid.id, right->_zid.id, 16) == 0);
     assert(left->_version == right->_version);
     assert(left->_whatami == right->_whatami);
+#if Z_FEATURE_SHM == 1
+    assert(left->_shm == right->_shm);
+    if (left->_shm) {
+        assert(memcmp(left->_shm_host_id, right->_shm_host_id, _Z_SHM_HOST_ID_LEN) == 0);
+    }
+#endif
 }
 void init_message(void) {
     printf("\n>> Init message\n");
@@ -2171,6 +2238,7 @@ int main(void) {
 
         // Network messages
         push_message();
+        push_encoded_header_message();
         request_message();
         response_message();
         response_final_message();
@@ -0,0 +1,336 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/fake_link.h"
+#include "zenoh-pico/protocol/codec/core.h"
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/protocol/codec/transport.h"
+#include "zenoh-pico/transport/common/transport.h"
+#include "zenoh-pico/transport/common/tx.h"
+#include "zenoh-pico/transport/multicast/retx.h"
+#include "zenoh-pico/transport/utils.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_MULTICAST_RETX_WINDOW_SIZE > 0
+
+static void setup(_z_transport_multicast_t *ztm, _z_link_t *zl) {
+    memset(ztm, 0, sizeof(_z_transport_multicast_t));
+    fake_link_transport_setup(&ztm->_common, zl, Z_BATCH_MULTICAST_SIZE);
+    ztm->_common._retx_window =
+        (_z_transport_retx_entry_t *)z_malloc(Z_MULTICAST_RETX_WINDOW_SIZE * sizeof(_z_transport_retx_entry_t));
+    assert(ztm->_common._retx_window != NULL);
+    memset(ztm->_common._retx_window, 0, Z_MULTICAST_RETX_WINDOW_SIZE * sizeof(_z_transport_retx_entry_t));
+}
+
+static void teardown(_z_transport_multicast_t *ztm) {
+    for (size_t i = 0; i < Z_MULTICAST_RETX_WINDOW_SIZE; i++) {
+        z_free(ztm->_common._retx_window[i]._buf);
+    }
+    z_free(ztm->_common._retx_window);
+    fake_link_transport_teardown(&ztm->_common);
+}
+
+static void send_oam(_z_transport_multicast_t *ztm, z_reliability_t reliability) {
+    _z_network_message_t n_msg = {0};
+    n_msg._tag = _Z_N_OAM;
+    n_msg._body._oam._id = 0x42;
+    n_msg._body._oam._ext_qos = _Z_N_QOS_DEFAULT;
+    n_msg._body._oam._ext_timestamp = _z_timestamp_null();
+    n_msg._body._oam._enc = _Z_OAM_BODY_UNIT;
+    assert(_z_transport_tx_send_n_msg_wrapper(&ztm->_common, &n_msg, reliability, Z_CONGESTION_CONTROL_BLOCK) ==
+           _Z_RES_OK);
+}
+
+// Decodes the single frame of a datagram, returns its SN
+static _z_zint_t frame_sn(const _z_slice_t *datagram, bool *is_reliable) {
+    _z_zbuf_t zbf = _z_slice_as_zbuf(*datagram);
+    _z_transport_message_t t_msg;
+    assert(_z_transport_message_decode(&t_msg, &zbf) == _Z_RES_OK);
+    assert(_Z_MID(t_msg._header) == _Z_MID_T_FRAME);
+    _z_zint_t sn = t_msg._body._frame._sn;
+    *is_reliable = _Z_HAS_FLAG(t_msg._header, _Z_FLAG_T_FRAME_R);
+    _z_t_msg_clear(&t_msg);
+    return sn;
+}
+
+// Decodes the retransmission request carried by a datagram
+static void decode_nack(const _z_slice_t *datagram, _z_network_message_t *n_msg) {
+    _z_zbuf_t zbf = _z_slice_as_zbuf(*datagram);
+    _z_transport_message_t t_msg;
+    assert(_z_transport_message_decode(&t_msg, &zbf) == _Z_RES_OK);
+    assert(_Z_MID(t_msg._header) == _Z_MID_T_FRAME);
+    assert(!_Z_HAS_FLAG(t_msg._header, _Z_FLAG_T_FRAME_R));
+    _z_arc_slice_t arcs = _z_arc_slice_empty();
+    assert(_z_network_message_decode(n_msg, t_msg._body._frame._payload, &arcs, 0) == _Z_RES_OK);
+    assert(n_msg->_tag == _Z_N_OAM);
+    assert(n_msg->_body._oam._id == _Z_OAM_ID_MULTICAST_NACK);
+    _z_t_msg_clear(&t_msg);
+}
+
+static void assert_nack(const _z_slice_t *datagram, _z_zint_t first_sn, _z_zint_t last_sn) {
+    _z_network_message_t n_msg = {0};
+    decode_nack(datagram, &n_msg);
+    _z_zbuf_t zbf = _z_slice_as_zbuf(n_msg._body._oam._body._zbuf._val);
+    _z_slice_t zid = _z_slice_null();
+    _z_zint_t sn = 0;
+    assert(_z_slice_decode(&zid, &zbf) == _Z_RES_OK);
+    assert(_z_zsize_decode(&sn, &zbf) == _Z_RES_OK);
+    assert(sn == first_sn);
+    assert(_z_zsize_decode(&sn, &zbf) == _Z_RES_OK);
+    assert(sn == last_sn);
+    _z_n_msg_clear(&n_msg);
+}
+
+// Forwards a datagram carrying a retransmission request to the sender
+static void forward_nack(const _z_slice_t *datagram, _z_transport_multicast_t *sender, const _z_id_t *sender_zid) {
+    _z_network_message_t n_msg = {0};
+    decode_nack(datagram, &n_msg);
+    assert(_z_multicast_retx_handle_nack(sender, &n_msg._body._oam, sender_zid) == _Z_RES_OK);
+    _z_n_msg_clear(&n_msg);
+}
+
+// Receives a reliable frame, holding it as the receiving task would
+static _z_multicast_retx_sn_t receive(_z_transport_multicast_t *ztm, _z_transport_peer_multicast_t *entry,
+                                      _z_zint_t sn) {
+    bool consecutive;
+    _z_multicast_retx_sn_t res = _z_multicast_retx_accept_sn(ztm, entry, sn, &consecutive);
+    if (res == _Z_MULTICAST_RETX_SN_HOLD) {
+        uint8_t payload = (uint8_t)sn;
+        assert(_z_multicast_retx_hold(entry, _Z_MID_T_FRAME, sn, &payload, 1, false, false) == _Z_RES_OK);
+    }
+    return res;
+}
+
+// Delivers the held frames that can be, checks their SNs and returns their number
+static size_t deliver_held(_z_transport_peer_multicast_t *entry, _z_zint_t first_sn, bool first_consecutive) {
+    size_t nb = 0;
+    bool consecutive;
+    _z_transport_retx_held_t *held;
+    while ((held = _z_multicast_retx_next(entry, &consecutive)) != NULL) {
+        if (nb == 0) {
+            assert(held->_sn == first_sn);
+            assert(consecutive == first_consecutive);
+        }
+        assert(_z_zbuf_len(&held->_payload) == 1);
+        assert(_z_zbuf_read(&held->_payload) == (uint8_t)held->_sn);
+        assert(entry->_sn_rx_sns._val._plain._reliable == held->_sn);
+        _z_multicast_retx_release(held);
+        nb++;
+    }
+    return nb;
+}
+
+static void test_window(void) {
+    printf("Test: retransmission window\n");
+    _z_link_t zl;
+    _z_transport_multicast_t ztm;
+    setup(&ztm, &zl);
+    _z_id_t zid = {.id = {1, 2, 3, 4}};
+    _z_id_t other_zid = {.id = {5, 6, 7, 8}};
+
+    send_oam(&ztm, Z_RELIABILITY_RELIABLE);
+    send_oam(&ztm, Z_RELIABILITY_BEST_EFFORT);
+    send_oam(&ztm, Z_RELIABILITY_RELIABLE);
+    send_oam(&ztm, Z_RELIABILITY_RELIABLE);
+    assert(fake_link_datagram_nb == 4);
+    _z_slice_t sent[4];
+    for (size_t i = 0; i < 4; i++) {
+        sent[i] = fake_link_datagrams[i];
+    }
+    fake_link_datagram_nb = 0;
+
+    // Reliable frames are sent again as they were
+    assert(_z_transport_tx_retransmit(&ztm._common, 1, 2) == _Z_RES_OK);
+    assert(fake_link_datagram_nb == 2);
+    assert(_z_slice_eq(&fake_link_datagrams[0], &sent[2]));
+    assert(_z_slice_eq(&fake_link_datagrams[1], &sent[3]));
+    fake_link_reset();
+
+    // Requests for other peers are ignored
+    _z_n_msg_oam_t oam = {0};
+    uint8_t body[] = {4, 1, 2, 3, 4, 0, 0};
+    oam._id = _Z_OAM_ID_MULTICAST_NACK;
+    oam._enc = _Z_OAM_BODY_ZBUF;
+    oam._body._zbuf._val = _z_slice_alias_buf(body, sizeof(body));
+    assert(_z_multicast_retx_handle_nack(&ztm, &oam, &other_zid) == _Z_RES_OK);
+    assert(fake_link_datagram_nb == 0);
+    assert(_z_multicast_retx_handle_nack(&ztm, &oam, &zid) == _Z_RES_OK);
+    assert(fake_link_datagram_nb == 1);
+    assert(_z_slice_eq(&fake_link_datagrams[0], &sent[0]));
+    fake_link_reset();
+
+    // Frames pushed out of the window aren't sent anymore
+    for (size_t i = 0; i < Z_MULTICAST_RETX_WINDOW_SIZE; i++) {
+        send_oam(&ztm, Z_RELIABILITY_RELIABLE);
+    }
+    fake_link_reset();
+    assert(_z_transport_tx_retransmit(&ztm._common, 0, 2) == _Z_RES_OK);
+    assert(fake_link_datagram_nb == 0);
+    assert(_z_transport_tx_retransmit(&ztm._common, 0, Z_MULTICAST_RETX_WINDOW_SIZE + 2) == _Z_RES_OK);
+    assert(fake_link_datagram_nb == Z_MULTICAST_RETX_WINDOW_SIZE);
+    bool is_reliable;
+    assert(frame_sn(&fake_link_datagrams[0], &is_reliable) == 3);
+    assert(is_reliable);
+
+    for (size_t i = 0; i < 4; i++) {
+        _z_slice_clear(&sent[i]);
+    }
+    teardown(&ztm);
+}
+
+static void test_gap(void) {
+    printf("Test: gap detection\n");
+    _z_link_t sender_zl;
+    _z_transport_multicast_t sender;
+    setup(&sender, &sender_zl);
+    _z_link_t receiver_zl;
+    _z_transport_multicast_t receiver;
+    setup(&receiver, &receiver_zl);
+    _z_id_t sender_zid = {.id = {1, 2, 3, 4}};
+
+    // Sender already sent SNs up to 10
+    sender._common._sn_tx_reliable = 11;
+    for (size_t i = 0; i < 4; i++) {
+        send_oam(&sender, Z_RELIABILITY_RELIABLE);
+    }
+    fake_link_reset();
+
+    _z_transport_peer_multicast_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry._sn_res = sender._common._sn_res;
+    entry._sn_rx_sns._val._plain._reliable = 10;
+    entry.common._remote_zid = sender_zid;
+    _z_multicast_retx_peer_init(&entry);
+    // Peers that don't advertise a window aren't asked for retransmissions
+    _z_multicast_retx_peer_set_window(&entry, 0);
+    assert(!_z_multicast_retx_peer_enabled(&entry));
+    _z_multicast_retx_peer_set_window(&entry, UINT16_MAX);
+    assert(_z_multicast_retx_peer_enabled(&entry));
+    assert(entry._retx_window == Z_MULTICAST_RETX_WINDOW_SIZE);
+
+    // 11 and 12 are lost, 13 is held and triggers a request for them
+    assert(receive(&receiver, &entry, 13) == _Z_MULTICAST_RETX_SN_HOLD);
+    assert(fake_link_datagram_nb == 1);
+    assert_nack(&fake_link_datagrams[0], 11, 12);
+    _z_slice_t nack = fake_link_datagrams[0];
+    fake_link_datagram_nb = 0;
+    // Next one is held without requesting again in the same retry period
+    assert(receive(&receiver, &entry, 14) == _Z_MULTICAST_RETX_SN_HOLD);
+    assert(fake_link_datagram_nb == 0);
+    assert(deliver_held(&entry, 0, true) == 0);
+
+    // Sender answers the request, the held frames follow the retransmitted ones
+    forward_nack(&nack, &sender, &sender_zid);
+    _z_slice_clear(&nack);
+    assert(fake_link_datagram_nb == 2);
+    for (size_t i = 0; i < fake_link_datagram_nb; i++) {
+        bool is_reliable;
+        _z_zint_t sn = frame_sn(&fake_link_datagrams[i], &is_reliable);
+        assert(is_reliable);
+        assert(sn == 11 + i);
+        assert(receive(&receiver, &entry, sn) == _Z_MULTICAST_RETX_SN_DELIVER);
+        assert(deliver_held(&entry, 13, true) == i * 2);
+    }
+    fake_link_reset();
+    assert(entry._sn_rx_sns._val._plain._reliable == 14);
+    assert(entry._nack_count == 0);
+
+    // Duplicates are dropped without requests
+    assert(receive(&receiver, &entry, 12) == _Z_MULTICAST_RETX_SN_DROP);
+    assert(receive(&receiver, &entry, 14) == _Z_MULTICAST_RETX_SN_DROP);
+    assert(fake_link_datagram_nb == 0);
+
+    // Each missing range is requested once per retry period
+    assert(receive(&receiver, &entry, 16) == _Z_MULTICAST_RETX_SN_HOLD);
+    assert(fake_link_datagram_nb == 1);
+    assert_nack(&fake_link_datagrams[0], 15, 15);
+    fake_link_reset();
+    assert(receive(&receiver, &entry, 18) == _Z_MULTICAST_RETX_SN_HOLD);
+    assert(fake_link_datagram_nb == 0);
+    z_sleep_ms(_Z_MULTICAST_NACK_RETRY_MS + 10);
+    assert(receive(&receiver, &entry, 19) == _Z_MULTICAST_RETX_SN_HOLD);
+    assert(fake_link_datagram_nb == 2);
+    assert_nack(&fake_link_datagrams[0], 15, 15);
+    assert_nack(&fake_link_datagrams[1], 17, 17);
+    fake_link_reset();
+
+    // Missing frames are skipped once the sender failed to retransmit them
+    for (size_t i = 2; i < _Z_MULTICAST_NACK_RETRY_MAX; i++) {
+        z_sleep_ms(_Z_MULTICAST_NACK_RETRY_MS + 10);
+        assert(receive(&receiver, &entry, 20) == _Z_MULTICAST_RETX_SN_HOLD);
+        assert(fake_link_datagram_nb == 2);
+        fake_link_reset();
+    }
+    z_sleep_ms(_Z_MULTICAST_NACK_RETRY_MS + 10);
+    assert(receive(&receiver, &entry, 21) == _Z_MULTICAST_RETX_SN_SKIP);
+    assert(deliver_held(&entry, 16, false) == 4);
+    assert(entry._sn_rx_sns._val._plain._reliable == 20);
+    assert(receive(&receiver, &entry, 21) == _Z_MULTICAST_RETX_SN_DELIVER);
+    assert(fake_link_datagram_nb == 0);
+
+    // Frames the sender doesn't keep anymore are skipped without requests
+    assert(receive(&receiver, &entry, 23) == _Z_MULTICAST_RETX_SN_HOLD);
+    fake_link_reset();
+    _z_zint_t sn = 22 + Z_MULTICAST_RETX_WINDOW_SIZE;
+    assert(receive(&receiver, &entry, sn) == _Z_MULTICAST_RETX_SN_SKIP);
+    assert(fake_link_datagram_nb == 0);
+    assert(deliver_held(&entry, 23, false) == 1);
+    assert(entry._sn_rx_sns._val._plain._reliable == 23);
+    assert(receive(&receiver, &entry, sn) == _Z_MULTICAST_RETX_SN_HOLD);
+    assert(fake_link_datagram_nb == 1);
+    assert_nack(&fake_link_datagrams[0], 24, sn - 1);
+    fake_link_reset();
+
+    // Frames announced by a join but not received are requested
+    _z_multicast_retx_peer_clear(&entry);
+    _z_multicast_retx_peer_init(&entry);
+    _z_multicast_retx_peer_set_window(&entry, Z_MULTICAST_RETX_WINDOW_SIZE);
+    entry._sn_rx_sns._val._plain._reliable = 20;
+    _z_multicast_retx_check_join(&receiver, &entry, 20);
+    assert(fake_link_datagram_nb == 0);
+    _z_multicast_retx_check_join(&receiver, &entry, 22);
+    assert(fake_link_datagram_nb == 1);
+    assert_nack(&fake_link_datagrams[0], 21, 22);
+    assert(entry._sn_rx_sns._val._plain._reliable == 20);
+    fake_link_reset();
+    // Unless the peer restarted its SNs
+    assert(receive(&receiver, &entry, 22) == _Z_MULTICAST_RETX_SN_HOLD);
+    _z_multicast_retx_check_join(&receiver, &entry, 5);
+    assert(fake_link_datagram_nb == 0);
+    assert(entry._sn_rx_sns._val._plain._reliable == 5);
+    assert(deliver_held(&entry, 0, true) == 0);
+
+    _z_multicast_retx_peer_clear(&entry);
+    teardown(&sender);
+    teardown(&receiver);
+}
+
+int main(void) {
+    test_window();
+    test_gap();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_MULTICAST_RETX_WINDOW_SIZE > 0\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Compares the handoff rate of the fifo and spsc channel collections between producer tasks and one consumer.
+// Elements are plain integers so only the synchronization cost is measured, no element is lost.
+// Usage: z_perf_channel [msg_nb] [capacity] [producer_nb], capacity defaults to msg_nb so producers are never held
+// back, and a single producer is used by default
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/collections/fifo_mt.h"
+#include "zenoh-pico/collections/spsc_mt.h"
+
+#if Z_FEATURE_MULTI_THREAD == 1
+
+typedef z_result_t (*push_f)(const void *src, void *context, z_element_free_f element_free);
+typedef z_result_t (*pull_f)(void *dst, void *context, z_element_move_f element_move);
+
+#define PRODUCER_MAX 16
+// Elements carry the producer index in their high bits, so the order of each producer can be checked
+#define PRODUCER_SHIFT 56
+
+typedef struct {
+    void *collection;
+    push_f push;
+    z_result_t (*close)(void *collection);
+    size_t msg_nb;
+    size_t producer_nb;
+    // Number of producers still running, the last one closes the collection
+    _z_mutex_t mutex;
+    size_t running;
+} producer_arg_t;
+
+typedef struct {
+    producer_arg_t *arg;
+    uint64_t id;
+} producer_t;
+
+// The spsc channel drops the pushed element when full, the producer retries it instead
+static _Thread_local bool _dropped = false;
+
+static void elem_free(void **e) {
+    _dropped = true;
+    *e = NULL;
+}
+
+static void elem_move(void *dst, void *src) { memcpy(dst, src, sizeof(uint64_t)); }
+
+static z_result_t fifo_close(void *collection) { return _z_fifo_mt_close((_z_fifo_mt_t *)collection); }
+static z_result_t spsc_close(void *collection) { return _z_spsc_mt_close((_z_spsc_mt_t *)collection); }
+
+static void *producer_task(void *ctx) {
+    producer_t *producer = (producer_t *)ctx;
+    producer_arg_t *arg = producer->arg;
+    size_t msg_nb = arg->msg_nb / arg->producer_nb;
+    for (uint64_t i = 0; i < msg_nb; i++) {
+        uint64_t value = (producer->id << PRODUCER_SHIFT) | i;
+        _dropped = false;
+        if (arg->push(&value, arg->collection, elem_free) != _Z_RES_OK) {
+            printf("Failed to push element\n");
+            exit(-1);
+        }
+        while (_dropped) {
+            // Let the consumer catch up before retrying
+            z_sleep_us(0);
+            _dropped = false;
+            arg->push(&value, arg->collection, elem_free);
+        }
+    }
+    _z_mutex_lock(&arg->mutex);
+    if (--arg->running == 0) {
+        arg->close(arg->collection);
+    }
+    _z_mutex_unlock(&arg->mutex);
+    return NULL;
+}
+
+static void run(const char *name, producer_arg_t *arg, pull_f pull, size_t capacity) {
+    size_t received = 0;
+    uint64_t expected[PRODUCER_MAX] = {0};
+    producer_t producers[PRODUCER_MAX];
+    _z_task_t tasks[PRODUCER_MAX];
+    _z_mutex_init(&arg->mutex);
+    arg->running = arg->producer_nb;
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < arg->producer_nb; i++) {
+        producers[i].arg = arg;
+        producers[i].id = i;
+        _z_task_init(&tasks[i], NULL, producer_task, &producers[i]);
+    }
+    for (;;) {
+        uint64_t value = UINT64_MAX;
+        z_result_t ret = pull(&value, arg->collection, elem_move);
+        if (ret == _Z_RES_CHANNEL_CLOSED) {
+            break;
+        }
+        uint64_t id = value >> PRODUCER_SHIFT;
+        if ((ret != _Z_RES_OK) || (id >= arg->producer_nb) ||
+            ((value & ((1ULL << PRODUCER_SHIFT) - 1)) != expected[id])) {
+            printf("Unexpected element %llx\n", (unsigned long long)value);
+            exit(-1);
+        }
+        expected[id]++;
+        received++;
+    }
+    unsigned long elapsed_us = z_clock_elapsed_us(&start);
+    for (size_t i = 0; i < arg->producer_nb; i++) {
+        _z_task_join(&tasks[i]);
+    }
+    _z_mutex_drop(&arg->mutex);
+    printf("%s channel, producers: %zu, capacity: %zu, msg nb: %zu, time us: %lu, msg/s: %.0f\n", name,
+           arg->producer_nb, capacity, received, elapsed_us,
+           (double)received * 1000000.0 / (double)(elapsed_us > 0 ? elapsed_us : 1));
+}
+
+int main(int argc, char **argv) {
+    size_t msg_nb = 2000000;
+    if (argc > 1) {
+        msg_nb = (size_t)atoi(argv[1]);
+    }
+    size_t capacity = msg_nb;
+    if (argc > 2) {
+        capacity = (size_t)atoi(argv[2]);
+    }
+    if (capacity == 0) {
+        printf("Capacity must be at least 1\n");
+        return -1;
+    }
+    size_t producer_nb = 1;
+    if (argc > 3) {
+        producer_nb = (size_t)atoi(argv[3]);
+    }
+    if ((producer_nb == 0) || (producer_nb > PRODUCER_MAX)) {
+        printf("Producer number must be between 1 and %d\n", PRODUCER_MAX);
+        return -1;
+    }
+
+    _z_fifo_mt_t fifo;
+    if (_z_fifo_mt_init(&fifo, capacity, sizeof(uint64_t)) != _Z_RES_OK) {
+        printf("Failed to create fifo channel\n");
+        return -1;
+    }
+    producer_arg_t fifo_arg = {
+        .collection = &fifo, .push = _z_fifo_mt_push, .close = fifo_close, .msg_nb = msg_nb, .producer_nb = producer_nb};
+    run("Fifo", &fifo_arg, _z_fifo_mt_pull, capacity);
+    _z_fifo_mt_clear(&fifo, elem_free);
+
+    _z_spsc_mt_t spsc;
+    if (_z_spsc_mt_init(&spsc, capacity, sizeof(uint64_t)) != _Z_RES_OK) {
+        printf("Failed to create spsc channel\n");
+        return -1;
+    }
+    producer_arg_t spsc_arg = {
+        .collection = &spsc, .push = _z_spsc_mt_push, .close = spsc_close, .msg_nb = msg_nb, .producer_nb = producer_nb};
+    run("Spsc", &spsc_arg, _z_spsc_mt_pull, capacity);
+    _z_spsc_mt_clear(&spsc, elem_free);
+    return 0;
+}
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_MULTI_THREAD\n");
+    return 0;
+}
+#endif
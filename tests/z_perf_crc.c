@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Compares the serial link CRC32 throughput of the bit by bit reference against _z_crc32.
+// Usage: z_perf_crc [frame_size]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/utils/checksum.h"
+
+#define TOTAL_BYTES (64 * 1024 * 1024)
+#define MAX_FRAME_SIZE 65536
+
+static uint32_t crc32_bitwise(const uint8_t *message, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc = crc ^ (uint32_t)message[i];
+        for (uint8_t j = 0; j < (uint8_t)8; j++) {
+            crc = (crc >> 1) ^ ((uint32_t)0x04C11DB7 & (uint32_t)(-(int32_t)(crc & (uint32_t)1)));
+        }
+    }
+    return ~crc;
+}
+
+static void run(const char *name, uint32_t (*crc_f)(const uint8_t *, size_t), const uint8_t *frame,
+                size_t frame_size) {
+    size_t frame_nb = TOTAL_BYTES / frame_size;
+    volatile uint32_t acc = 0;
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < frame_nb; i++) {
+        acc ^= crc_f(frame, frame_size);
+    }
+    unsigned long elapsed_us = z_clock_elapsed_us(&start);
+    double bytes = (double)frame_nb * (double)frame_size;
+    printf("%s crc, frame size: %zu, bytes: %.0f, time us: %lu, ns/byte: %.3f, MB/s: %.1f\n", name, frame_size, bytes,
+           elapsed_us, (double)elapsed_us * 1000.0 / bytes, bytes / (double)(elapsed_us > 0 ? elapsed_us : 1));
+    (void)acc;
+}
+
+int main(int argc, char **argv) {
+    static uint8_t frame[MAX_FRAME_SIZE];
+    size_t frame_size = 1024;
+    if (argc > 1) {
+        frame_size = (size_t)atoi(argv[1]);
+    }
+    if ((frame_size == 0) || (frame_size > MAX_FRAME_SIZE)) {
+        printf("Frame size must be between 1 and %d\n", MAX_FRAME_SIZE);
+        return -1;
+    }
+    for (size_t i = 0; i < frame_size; i++) {
+        frame[i] = (uint8_t)rand();
+    }
+    if (crc32_bitwise(frame, frame_size) != _z_crc32(frame, frame_size)) {
+        printf("Crc mismatch\n");
+        return -1;
+    }
+    run("Bitwise", crc32_bitwise, frame, frame_size);
+    run("Library", _z_crc32, frame, frame_size);
+    return 0;
+}
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Measures the cost of _z_lru_cache_t hits and misses for capacities of 16 to 4096 entries, looking up string keys
+// the way the rx cache looks up key expressions. A miss is followed by the insertion that evicts the oldest entry.
+// Usage: z_perf_lru_cache [ops_nb]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/collections/lru_cache.h"
+#include "zenoh-pico/utils/hash.h"
+
+#define KEY_SIZE 32
+#define MIN_CAPACITY 16
+#define MAX_CAPACITY 4096
+
+typedef struct {
+    char key[KEY_SIZE];
+} perf_entry_t;
+
+static size_t perf_entry_hash(const void *e) {
+    size_t hash = _Z_FNV_OFFSET_BASIS;
+    for (const char *c = ((const perf_entry_t *)e)->key; *c != '\0'; c++) {
+        hash = _z_hash_combine(hash, (size_t)(uint8_t)*c);
+    }
+    return hash;
+}
+
+static bool perf_entry_eq(const void *left, const void *right) {
+    return strcmp(((const perf_entry_t *)left)->key, ((const perf_entry_t *)right)->key) == 0;
+}
+
+static inline void perf_elem_clear(void *e) { _z_noop_clear((perf_entry_t *)e); }
+
+_Z_LRU_CACHE_DEFINE(perf, perf_entry_t, perf_entry_hash, perf_entry_eq)
+
+static void make_entry(perf_entry_t *e, size_t i) { (void)snprintf(e->key, KEY_SIZE, "demo/example/key/%zu", i); }
+
+static void run(size_t capacity, size_t nb) {
+    perf_lru_cache_t cache = perf_lru_cache_init(capacity);
+    perf_entry_t e;
+    for (size_t i = 0; i < capacity; i++) {
+        make_entry(&e, i);
+        (void)perf_lru_cache_insert(&cache, &e);
+    }
+
+    volatile size_t found = 0;
+    srand(1);
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < nb; i++) {
+        make_entry(&e, (size_t)rand() % capacity);
+        found += (perf_lru_cache_get(&cache, &e) != NULL) ? 1 : 0;
+    }
+    unsigned long hit_us = z_clock_elapsed_us(&start);
+
+    size_t next = capacity;
+    start = z_clock_now();
+    for (size_t i = 0; i < nb; i++) {
+        make_entry(&e, next++);
+        if (perf_lru_cache_get(&cache, &e) == NULL) {
+            (void)perf_lru_cache_insert(&cache, &e);
+        }
+    }
+    unsigned long miss_us = z_clock_elapsed_us(&start);
+
+    printf("Capacity: %zu, ops: %zu, hit ns/op: %.1f, miss ns/op: %.1f\n", capacity, nb,
+           (double)hit_us * 1000.0 / (double)nb, (double)miss_us * 1000.0 / (double)nb);
+    perf_lru_cache_delete(&cache);
+    (void)found;
+}
+
+int main(int argc, char **argv) {
+    size_t nb = 200000;
+    if (argc > 1) {
+        nb = (size_t)atoi(argv[1]);
+    }
+    if (nb == 0) {
+        printf("Operation number must be positive\n");
+        return -1;
+    }
+    for (size_t capacity = MIN_CAPACITY; capacity <= MAX_CAPACITY; capacity *= 4) {
+        run(capacity, nb);
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Compares the encoding of publisher puts field by field against the header pre-encoded by the publisher, for 8 to 64
+// byte payloads. Puts are encoded in a batch buffer, reset when full, so only the encoding cost is measured.
+// Usage: z_perf_put_encode [msg_nb]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/protocol/definitions/message.h"
+
+#define BATCH_SIZE 65535
+#define PAYLOAD_MAX 64
+
+// Put of a declared key expression like z_pub_thr sends, with a non default encoding
+static void make_put(_z_network_message_t *msg, _z_keyexpr_t *key, _z_bytes_t *payload, _z_encoding_t *encoding) {
+    _z_qos_t qos = _z_n_qos_make(false, false, Z_PRIORITY_DEFAULT);
+    _z_n_msg_make_push_put(msg, key, payload, encoding, qos, NULL, NULL, Z_RELIABILITY_RELIABLE, NULL);
+}
+
+static unsigned long run(const _z_network_message_t *msg, _z_wbuf_t *wbf, size_t msg_nb) {
+    _z_wbuf_reset(wbf);
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < msg_nb; i++) {
+        if (_z_wbuf_space_left(wbf) < 128) {
+            _z_wbuf_reset(wbf);
+        }
+        if (_z_network_message_encode(wbf, msg) != _Z_RES_OK) {
+            printf("Encoding failed\n");
+            exit(-1);
+        }
+    }
+    return z_clock_elapsed_us(&start);
+}
+
+int main(int argc, char **argv) {
+    size_t msg_nb = 10000000;
+    if (argc > 1) {
+        msg_nb = (size_t)atol(argv[1]);
+    }
+    if (msg_nb == 0) {
+        printf("Message number must be positive\n");
+        return -1;
+    }
+    _z_keyexpr_t key = _z_rid_with_suffix(1, NULL);
+    _z_encoding_t encoding = _z_encoding_wrap(10, NULL);
+    _z_wbuf_t wbf = _z_wbuf_make(BATCH_SIZE, false);
+
+    // Template built like the publisher declaration does
+    _z_network_message_t msg;
+    make_put(&msg, &key, NULL, &encoding);
+    _z_wbuf_t hdr = _z_wbuf_make(_Z_PUT_HEADER_BASE_SIZE, true);
+    if (_z_push_header_encode(&hdr, &msg._body._push) != _Z_RES_OK) {
+        printf("Header encoding failed\n");
+        return -1;
+    }
+    _z_zbuf_t hdr_zbf = _z_wbuf_to_zbuf(&hdr);
+    _z_slice_t put_header = _z_slice_alias_buf(_z_zbuf_start(&hdr_zbf), _z_zbuf_len(&hdr_zbf));
+
+    uint8_t data[PAYLOAD_MAX];
+    memset(data, 1, PAYLOAD_MAX);
+    for (size_t size = 8; size <= PAYLOAD_MAX; size *= 2) {
+        _z_bytes_t payload;
+        if (_z_bytes_from_buf(&payload, data, size) != _Z_RES_OK) {
+            return -1;
+        }
+        _z_network_message_t fields;
+        make_put(&fields, &key, &payload, &encoding);
+        _z_network_message_t templated = fields;
+        templated._body._push._encoded_header = &put_header;
+
+        // Both encode the same bytes
+        _z_wbuf_reset(&wbf);
+        _z_wbuf_t check = _z_wbuf_make(BATCH_SIZE, false);
+        bool same = (_z_network_message_encode(&wbf, &fields) == _Z_RES_OK) &&
+                    (_z_network_message_encode(&check, &templated) == _Z_RES_OK);
+        size_t len = _z_wbuf_len(&wbf);
+        same = same && (len == _z_wbuf_len(&check)) && (memcmp(_z_wbuf_get_iosli(&wbf, 0)->_buf,
+                                                            _z_wbuf_get_iosli(&check, 0)->_buf, len) == 0);
+        _z_wbuf_clear(&check);
+        if (!same) {
+            printf("Encodings differ for a %zu byte payload\n", size);
+            return -1;
+        }
+
+        unsigned long fields_us = run(&fields, &wbf, msg_nb);
+        unsigned long templated_us = run(&templated, &wbf, msg_nb);
+        printf("Payload: %zu bytes, message: %zu bytes, fields ns/msg: %.1f, template ns/msg: %.1f\n", size, len,
+               (double)fields_us * 1000.0 / (double)msg_nb, (double)templated_us * 1000.0 / (double)msg_nb);
+        _z_bytes_drop(&payload);
+    }
+    _z_zbuf_clear(&hdr_zbf);
+    _z_wbuf_clear(&hdr);
+    _z_wbuf_clear(&wbf);
+    _z_encoding_clear(&encoding);
+    return 0;
+}
@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Compares the datagram receive rate of single reads against batched reads over UDP loopback.
+// Usage: z_perf_recv [msg_size]
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/system/link/udp.h"
+
+#if defined(_Z_SYS_NET_RECV_VEC_MAX) && Z_FEATURE_LINK_UDP_UNICAST == 1
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define BURST_SIZE 64
+#define ROUND_NB 5000
+#define MAX_MSG_SIZE 1024
+
+static bool open_loopback_pair(int *rx, int *tx) {
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+    (void)memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+
+    *rx = socket(AF_INET, SOCK_DGRAM, 0);
+    *tx = socket(AF_INET, SOCK_DGRAM, 0);
+    if ((*rx < 0) || (*tx < 0)) {
+        return false;
+    }
+    if ((bind(*rx, (struct sockaddr *)&addr, addrlen) < 0) ||
+        (getsockname(*rx, (struct sockaddr *)&addr, &addrlen) < 0) ||
+        (connect(*tx, (struct sockaddr *)&addr, addrlen) < 0)) {
+        return false;
+    }
+    return true;
+}
+
+static void send_burst(int tx, const uint8_t *payload, size_t len) {
+    for (size_t i = 0; i < BURST_SIZE; i++) {
+        if (send(tx, payload, len, 0) != (ssize_t)len) {
+            printf("Failed to send datagram\n");
+            exit(-1);
+        }
+    }
+}
+
+static void run(int rx, int tx, size_t msg_size, bool batched) {
+    static uint8_t payload[MAX_MSG_SIZE];
+    static uint8_t rcv[_Z_SYS_NET_RECV_VEC_MAX][MAX_MSG_SIZE];
+    _z_sys_net_socket_t sock = {0};
+    sock._fd = rx;
+    unsigned long elapsed_us = 0;
+    unsigned long syscalls = 0;
+
+    for (size_t r = 0; r < ROUND_NB; r++) {
+        // Only the receive side is timed, the burst is already queued on the socket
+        send_burst(tx, payload, msg_size);
+        size_t received = 0;
+        z_clock_t start = z_clock_now();
+        while (received < BURST_SIZE) {
+            size_t rn = 0;
+            if (batched) {
+                _z_slice_t bufs[_Z_SYS_NET_RECV_VEC_MAX];
+                for (size_t i = 0; i < _Z_SYS_NET_RECV_VEC_MAX; i++) {
+                    bufs[i] = _z_slice_alias_buf(rcv[i], sizeof(rcv[i]));
+                }
+                rn = _z_read_vec_udp_unicast(sock, bufs, _Z_SYS_NET_RECV_VEC_MAX);
+            } else {
+                rn = (_z_read_udp_unicast(sock, rcv[0], sizeof(rcv[0])) == SIZE_MAX) ? SIZE_MAX : 1;
+            }
+            if (rn == SIZE_MAX) {
+                printf("Failed to receive datagram\n");
+                exit(-1);
+            }
+            received += rn;
+            syscalls++;
+        }
+        elapsed_us += z_clock_elapsed_us(&start);
+    }
+    unsigned long msg_nb = (unsigned long)BURST_SIZE * ROUND_NB;
+    printf("%s read, msg size: %zu, msg nb: %lu, syscalls: %lu, time us: %lu, msg/s: %.0f\n",
+           batched ? "Batched" : "Single", msg_size, msg_nb, syscalls, elapsed_us,
+           (double)msg_nb * 1000000.0 / (double)(elapsed_us > 0 ? elapsed_us : 1));
+}
+
+int main(int argc, char **argv) {
+    size_t msg_size = 32;
+    if (argc > 1) {
+        msg_size = (size_t)atoi(argv[1]);
+    }
+    if ((msg_size == 0) || (msg_size > MAX_MSG_SIZE)) {
+        printf("Message size must be between 1 and %d\n", MAX_MSG_SIZE);
+        return -1;
+    }
+    int rx = -1;
+    int tx = -1;
+    if (!open_loopback_pair(&rx, &tx)) {
+        printf("Failed to open loopback sockets\n");
+        return -1;
+    }
+    run(rx, tx, msg_size, false);
+    run(rx, tx, msg_size, true);
+    close(rx);
+    close(tx);
+    return 0;
+}
+#else
+int main(void) {
+    printf(
+        "Missing config token to build this test. This test requires: batched datagram reads and "
+        "Z_FEATURE_LINK_UDP_UNICAST\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Compares the sorted list the sorted map used to be against _z_sortedmap_t, buffering out of order sequence numbers
+// the way the advanced subscriber does while it waits for missed samples.
+// Usage: z_perf_sortedmap [pending_nb]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/collections/list.h"
+#include "zenoh-pico/collections/sortedmap.h"
+
+#define MAX_PENDING_NB (1024 * 1024)
+
+static int cmp_u32(const void *left, const void *right) {
+    uint32_t l = *(const uint32_t *)left;
+    uint32_t r = *(const uint32_t *)right;
+    return (l < r) ? -1 : ((l > r) ? 1 : 0);
+}
+
+static void free_entry(void **e) {
+    z_free(*e);
+    *e = NULL;
+}
+
+/*------------------ Sorted list reference ------------------*/
+static void list_insert(_z_list_t **xs, uint32_t *k) {
+    _z_list_t *prev = NULL;
+    _z_list_t *curr = *xs;
+    while ((curr != NULL) && (cmp_u32(k, ((_z_sortedmap_entry_t *)_z_list_value(curr))->_key) > 0)) {
+        prev = curr;
+        curr = _z_list_next(curr);
+    }
+    _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)z_malloc(sizeof(_z_sortedmap_entry_t));
+    entry->_key = k;
+    entry->_val = k;
+    if (prev == NULL) {
+        *xs = _z_list_push(*xs, entry);
+    } else {
+        (void)_z_list_push_after(prev, entry);
+    }
+}
+
+static void *list_get(const _z_list_t *xs, const uint32_t *k) {
+    for (; xs != NULL; xs = _z_list_next(xs)) {
+        _z_sortedmap_entry_t *entry = (_z_sortedmap_entry_t *)_z_list_value(xs);
+        if (cmp_u32(k, entry->_key) == 0) {
+            return entry->_val;
+        }
+    }
+    return NULL;
+}
+
+static void list_pop_first(_z_list_t **xs) { *xs = _z_list_drop_element(*xs, NULL, free_entry); }
+
+/*------------------ Benchmark ------------------*/
+static void report(const char *name, const char *op, size_t nb, unsigned long elapsed_us) {
+    printf("%s %s, ops: %zu, time us: %lu, ns/op: %.1f\n", name, op, nb, elapsed_us,
+           (double)elapsed_us * 1000.0 / (double)nb);
+}
+
+static void run_list(uint32_t *keys, size_t nb) {
+    _z_list_t *xs = NULL;
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < nb; i++) {
+        list_insert(&xs, &keys[i]);
+    }
+    report("List", "insert", nb, z_clock_elapsed_us(&start));
+
+    volatile size_t found = 0;
+    start = z_clock_now();
+    for (uint32_t sn = 0; sn < (uint32_t)nb; sn++) {
+        found += (list_get(xs, &sn) != NULL) ? 1 : 0;
+    }
+    report("List", "get", nb, z_clock_elapsed_us(&start));
+
+    start = z_clock_now();
+    while (xs != NULL) {
+        list_pop_first(&xs);
+    }
+    report("List", "pop_first", nb, z_clock_elapsed_us(&start));
+    (void)found;
+}
+
+static void run_map(uint32_t *keys, size_t nb) {
+    _z_sortedmap_t map = _z_sortedmap_make(cmp_u32);
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < nb; i++) {
+        (void)_z_sortedmap_insert(&map, &keys[i], &keys[i], free_entry, true);
+    }
+    report("Map", "insert", nb, z_clock_elapsed_us(&start));
+
+    volatile size_t found = 0;
+    start = z_clock_now();
+    for (uint32_t sn = 0; sn < (uint32_t)nb; sn++) {
+        found += (_z_sortedmap_get(&map, &sn) != NULL) ? 1 : 0;
+    }
+    report("Map", "get", nb, z_clock_elapsed_us(&start));
+
+    start = z_clock_now();
+    _z_sortedmap_entry_t *entry = _z_sortedmap_pop_first(&map);
+    while (entry != NULL) {
+        z_free(entry);
+        entry = _z_sortedmap_pop_first(&map);
+    }
+    report("Map", "pop_first", nb, z_clock_elapsed_us(&start));
+    _z_sortedmap_clear(&map, free_entry);
+    (void)found;
+}
+
+int main(int argc, char **argv) {
+    size_t nb = 4096;
+    if (argc > 1) {
+        nb = (size_t)atoi(argv[1]);
+    }
+    if ((nb == 0) || (nb > MAX_PENDING_NB)) {
+        printf("Pending number must be between 1 and %d\n", MAX_PENDING_NB);
+        return -1;
+    }
+    // Sequence numbers arriving out of order, each one displaced by up to a few hundred positions
+    uint32_t *keys = (uint32_t *)z_malloc(nb * sizeof(uint32_t));
+    if (keys == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i < nb; i++) {
+        keys[i] = (uint32_t)i;
+    }
+    srand(3);
+    for (size_t i = 0; i < nb; i++) {
+        size_t j = i + ((size_t)rand() % 256);
+        if (j < nb) {
+            uint32_t tmp = keys[i];
+            keys[i] = keys[j];
+            keys[j] = tmp;
+        }
+    }
+    run_list(keys, nb);
+    run_map(keys, nb);
+    z_free(keys);
+    return 0;
+}
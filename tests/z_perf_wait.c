@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+// Compares the cost of waking up on one ready peer socket among many, between the select mask rebuilt on each wait
+// and the sockets registered once in an event set.
+// Usage: z_perf_wait [peer_nb], peer_nb defaults to 500 and is limited by FD_SETSIZE for the select wait
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/transport/transport.h"
+
+#if defined(_Z_SYS_NET_EVENT_SET) && Z_FEATURE_UNICAST_TRANSPORT == 1
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define ROUND_NB 20000
+
+static void fail(const char *msg) {
+    printf("%s\n", msg);
+    exit(-1);
+}
+
+static void wake_peer(int *writers, size_t peer_nb, size_t round) {
+    uint8_t byte = 0;
+    if (write(writers[round % peer_nb], &byte, 1) != 1) {
+        fail("Failed to write to peer socket");
+    }
+}
+
+static void drain_peer(const _z_transport_peer_unicast_t *peer) {
+    uint8_t byte = 0;
+    if (read(peer->_socket._fd, &byte, 1) != 1) {
+        fail("Failed to read from peer socket");
+    }
+}
+
+static void run_select(_z_transport_peer_unicast_slist_t **peers, int *writers, size_t peer_nb) {
+    _z_mutex_rec_t mutex;
+    _z_mutex_rec_init(&mutex);
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < ROUND_NB; i++) {
+        wake_peer(writers, peer_nb, i);
+        if (_z_socket_wait_event(peers, &mutex) != _Z_RES_OK) {
+            fail("Select wait failed");
+        }
+        size_t pending = 0;
+        _z_transport_peer_unicast_slist_t *curr = *peers;
+        while (curr != NULL) {
+            _z_transport_peer_unicast_t *peer = _z_transport_peer_unicast_slist_value(curr);
+            if (peer->_pending) {
+                peer->_pending = false;
+                drain_peer(peer);
+                pending++;
+            }
+            curr = _z_transport_peer_unicast_slist_next(curr);
+        }
+        if (pending != 1) {
+            fail("Unexpected number of pending peers");
+        }
+    }
+    unsigned long elapsed_us = z_clock_elapsed_us(&start);
+    _z_mutex_rec_drop(&mutex);
+    printf("Select wait, peer nb: %zu, wakeups: %d, time us: %lu, us/wakeup: %.2f\n", peer_nb, ROUND_NB, elapsed_us,
+           (double)elapsed_us / ROUND_NB);
+}
+
+static void run_event_set(_z_transport_peer_unicast_slist_t *peers, int *writers, size_t peer_nb) {
+    _z_sys_net_event_set_t set;
+    if (_z_socket_event_set_init(&set) != _Z_RES_OK) {
+        fail("Failed to create event set");
+    }
+    for (_z_transport_peer_unicast_slist_t *curr = peers; curr != NULL;
+         curr = _z_transport_peer_unicast_slist_next(curr)) {
+        _z_transport_peer_unicast_t *peer = _z_transport_peer_unicast_slist_value(curr);
+        if (_z_socket_event_set_add(&set, &peer->_socket, peer) != _Z_RES_OK) {
+            fail("Failed to register peer socket");
+        }
+    }
+    void *ready[_Z_SYS_NET_EVENT_SET_WAIT_MAX];
+    z_clock_t start = z_clock_now();
+    for (size_t i = 0; i < ROUND_NB; i++) {
+        wake_peer(writers, peer_nb, i);
+        size_t count = 0;
+        if (_z_socket_event_set_wait(&set, ready, _Z_SYS_NET_EVENT_SET_WAIT_MAX, &count) != _Z_RES_OK) {
+            fail("Event set wait failed");
+        }
+        if (count != 1) {
+            fail("Unexpected number of ready peers");
+        }
+        drain_peer((_z_transport_peer_unicast_t *)ready[0]);
+    }
+    unsigned long elapsed_us = z_clock_elapsed_us(&start);
+    _z_socket_event_set_clear(&set);
+    printf("Event set wait, peer nb: %zu, wakeups: %d, time us: %lu, us/wakeup: %.2f\n", peer_nb, ROUND_NB,
+           elapsed_us, (double)elapsed_us / ROUND_NB);
+}
+
+int main(int argc, char **argv) {
+    size_t peer_nb = 500;
+    if (argc > 1) {
+        peer_nb = (size_t)atoi(argv[1]);
+    }
+    if (peer_nb == 0) {
+        printf("Peer nb must be at least 1\n");
+        return -1;
+    }
+    int *writers = (int *)z_malloc(peer_nb * sizeof(int));
+    if (writers == NULL) {
+        fail("Out of memory");
+    }
+    _z_transport_peer_unicast_slist_t *peers = _z_transport_peer_unicast_slist_new();
+    int max_fd = 0;
+    for (size_t i = 0; i < peer_nb; i++) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+            fail("Failed to create socket pair, the open file limit may be too low");
+        }
+        peers = _z_transport_peer_unicast_slist_push_empty(peers);
+        _z_transport_peer_unicast_t *peer = _z_transport_peer_unicast_slist_value(peers);
+        (void)memset(peer, 0, sizeof(_z_transport_peer_unicast_t));
+        peer->flow_buff = _z_zbuf_null();
+        _z_resource_index_init(&peer->common._remote_resources_index);
+        peer->_socket._fd = fds[0];
+        writers[i] = fds[1];
+        max_fd = (fds[1] > max_fd) ? fds[1] : max_fd;
+    }
+
+    if (max_fd < FD_SETSIZE) {
+        run_select(&peers, writers, peer_nb);
+    } else {
+        printf("Select wait skipped, socket numbers exceed FD_SETSIZE\n");
+    }
+    run_event_set(peers, writers, peer_nb);
+
+    _z_transport_peer_unicast_slist_free(&peers);
+    for (size_t i = 0; i < peer_nb; i++) {
+        close(writers[i]);
+    }
+    z_free(writers);
+    return 0;
+}
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: _Z_SYS_NET_EVENT_SET\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/collections/rcu.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#define VALUE_MAGIC 0x5a5a5a5aU
+
+typedef struct {
+    uint32_t magic;
+    size_t version;
+} value_t;
+
+static value_t *value_new(size_t version) {
+    value_t *val = (value_t *)z_malloc(sizeof(value_t));
+    assert(val != NULL);
+    val->magic = VALUE_MAGIC;
+    val->version = version;
+    return val;
+}
+
+// Values are poisoned before being freed so that a reader still holding one fails
+static void value_free(value_t *val) {
+    val->magic = 0;
+    z_free(val);
+}
+
+static void test_swap(void) {
+    printf("test_swap\n");
+    _z_rcu_t rcu;
+    _z_rcu_init(&rcu, NULL);
+    uint8_t phase;
+    assert(_z_rcu_read_lock(&rcu, &phase) == NULL);
+    _z_rcu_read_unlock(&rcu, phase);
+
+    value_t *v1 = value_new(1);
+    assert(_z_rcu_swap(&rcu, v1) == NULL);
+    assert(_z_rcu_get(&rcu) == v1);
+    assert(_z_rcu_read_lock(&rcu, &phase) == v1);
+    _z_rcu_read_unlock(&rcu, phase);
+
+    value_t *v2 = value_new(2);
+    assert(_z_rcu_swap(&rcu, v2) == v1);
+    value_free(v1);
+    assert(_z_rcu_swap(&rcu, NULL) == v2);
+    value_free(v2);
+}
+
+#if Z_FEATURE_MULTI_THREAD == 1
+#define READER_NB 3
+#define SWAP_NB 2000
+
+typedef struct {
+    _z_rcu_t rcu;
+    volatile bool stop;
+    size_t reads[READER_NB];
+} shared_t;
+
+typedef struct {
+    shared_t *shared;
+    size_t idx;
+} reader_arg_t;
+
+static void *reader_task(void *arg) {
+    reader_arg_t *reader = (reader_arg_t *)arg;
+    shared_t *shared = reader->shared;
+    size_t last_version = 0;
+    while (!shared->stop) {
+        uint8_t phase;
+        const value_t *val = (const value_t *)_z_rcu_read_lock(&shared->rcu, &phase);
+        assert(val != NULL);
+        assert(val->magic == VALUE_MAGIC);
+        // Published versions are never seen going backwards
+        assert(val->version >= last_version);
+        last_version = val->version;
+        _z_rcu_read_unlock(&shared->rcu, phase);
+        shared->reads[reader->idx]++;
+    }
+    return NULL;
+}
+
+static void test_concurrent_readers(void) {
+    printf("test_concurrent_readers\n");
+    shared_t shared;
+    memset(&shared, 0, sizeof(shared));
+    _z_rcu_init(&shared.rcu, value_new(0));
+
+    _z_task_t tasks[READER_NB];
+    reader_arg_t args[READER_NB];
+    for (size_t i = 0; i < READER_NB; i++) {
+        args[i].shared = &shared;
+        args[i].idx = i;
+        assert(_z_task_init(&tasks[i], NULL, reader_task, &args[i]) == _Z_RES_OK);
+    }
+    for (size_t i = 1; i <= SWAP_NB; i++) {
+        value_t *prev = (value_t *)_z_rcu_swap(&shared.rcu, value_new(i));
+        assert(prev->version == i - 1);
+        value_free(prev);
+        // Let all the readers overlap with the writer, even on a single core
+        z_sleep_us(50);
+    }
+    shared.stop = true;
+    for (size_t i = 0; i < READER_NB; i++) {
+        _z_task_join(&tasks[i]);
+        printf("Reader %zu, reads: %zu\n", i, shared.reads[i]);
+    }
+    value_free((value_t *)_z_rcu_swap(&shared.rcu, NULL));
+}
+#endif
+
+int main(void) {
+    test_swap();
+#if Z_FEATURE_MULTI_THREAD == 1
+    test_concurrent_readers();
+#endif
+    return 0;
+}
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/protocol/keyexpr.h"
+#include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/transport.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#define RESOURCE_NB 1000
+
+static bool keyexpr_is(const _z_keyexpr_t *ke, const char *expected) {
+    return (_z_string_len(&ke->_suffix) == strlen(expected)) &&
+           (strncmp(_z_string_data(&ke->_suffix), expected, strlen(expected)) == 0);
+}
+
+static void test_local_resources(void) {
+    _z_session_t zn;
+    _z_id_t zid = _z_id_empty();
+    assert(_z_session_init(&zn, &zid) == _Z_RES_OK);
+
+    _z_keyexpr_t root = _z_rid_with_suffix(Z_RESOURCE_ID_NONE, "demo/example");
+    uint16_t root_id = _z_register_resource(&zn, &root, Z_RESOURCE_ID_NONE, NULL);
+    assert(root_id != Z_RESOURCE_ID_NONE);
+
+    _z_keyexpr_t child = _z_rid_with_suffix(root_id, "/child");
+    uint16_t child_id = _z_register_resource(&zn, &child, Z_RESOURCE_ID_NONE, NULL);
+    assert(child_id != Z_RESOURCE_ID_NONE);
+
+    // Lookups by id and by key
+    _z_resource_t *res = _z_get_resource_by_id(&zn, child_id, NULL);
+    assert(res != NULL && res->_id == child_id);
+    res = _z_get_resource_by_key(&zn, &root, NULL);
+    assert(res != NULL && res->_id == root_id);
+    res = _z_get_resource_by_key(&zn, &child, NULL);
+    assert(res != NULL && res->_id == child_id);
+    assert(_z_get_resource_by_id(&zn, 0xffff, NULL) == NULL);
+
+    // Expansion goes through the memoized parent key
+    _z_keyexpr_t ke = _z_rid_with_suffix(child_id, "/leaf");
+    _z_keyexpr_t expanded = _z_get_expanded_key_from_key(&zn, &ke, NULL);
+    assert(keyexpr_is(&expanded, "demo/example/child/leaf"));
+    _z_keyexpr_clear(&expanded);
+    _z_keyexpr_clear(&ke);
+    ke = _z_rid_with_suffix(child_id, NULL);
+    expanded = _z_get_expanded_key_from_key(&zn, &ke, NULL);
+    assert(keyexpr_is(&expanded, "demo/example/child"));
+    _z_keyexpr_clear(&expanded);
+
+    // Many resources remain reachable
+    char buf[32];
+    for (int i = 0; i < RESOURCE_NB; i++) {
+        snprintf(buf, sizeof(buf), "many/%d", i);
+        _z_keyexpr_t k = _z_rid_with_suffix(Z_RESOURCE_ID_NONE, buf);
+        uint16_t id = _z_register_resource(&zn, &k, Z_RESOURCE_ID_NONE, NULL);
+        assert(id != Z_RESOURCE_ID_NONE);
+        _z_keyexpr_clear(&k);
+    }
+    for (int i = 0; i < RESOURCE_NB; i++) {
+        snprintf(buf, sizeof(buf), "many/%d", i);
+        _z_keyexpr_t k = _z_rid_with_suffix(Z_RESOURCE_ID_NONE, buf);
+        res = _z_get_resource_by_key(&zn, &k, NULL);
+        assert(res != NULL);
+        assert(_z_get_resource_by_id(&zn, res->_id, NULL) == res);
+        _z_keyexpr_clear(&k);
+    }
+
+    // Unregistering the child releases its reference on the parent
+    _z_unregister_resource(&zn, child_id, NULL);
+    assert(_z_get_resource_by_id(&zn, child_id, NULL) == NULL);
+    res = _z_get_resource_by_id(&zn, root_id, NULL);
+    assert(res != NULL && res->_refcount == 1);
+    _z_unregister_resource(&zn, root_id, NULL);
+    assert(_z_get_resource_by_id(&zn, root_id, NULL) == NULL);
+    assert(_z_get_resource_by_key(&zn, &root, NULL) == NULL);
+
+    _z_keyexpr_clear(&child);
+    _z_keyexpr_clear(&root);
+    _z_flush_local_resources(&zn);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&zn._mutex_inner);
+#endif
+}
+
+static void test_remote_resources(void) {
+    _z_session_t zn;
+    _z_id_t zid = _z_id_empty();
+    assert(_z_session_init(&zn, &zid) == _Z_RES_OK);
+
+    _z_transport_peer_common_t peer = {0};
+    _z_resource_index_init(&peer._remote_resources_index);
+
+    // Keys decoded from a peer carry its mapping
+    _z_keyexpr_t root = _z_rid_with_suffix(Z_RESOURCE_ID_NONE, "remote/root");
+    root._mapping = (uintptr_t)&peer;
+    assert(_z_register_resource(&zn, &root, 10, &peer) == 10);
+    _z_keyexpr_t child = _z_rid_with_suffix(10, "/child");
+    child._mapping = (uintptr_t)&peer;
+    assert(_z_register_resource(&zn, &child, 11, &peer) == 11);
+
+    // Remote ids don't collide with local ones
+    assert(_z_get_resource_by_id(&zn, 11, NULL) == NULL);
+    _z_resource_t *res = _z_get_resource_by_id(&zn, 11, &peer);
+    assert(res != NULL);
+
+    _z_keyexpr_t ke = _z_rid_with_suffix(11, "/leaf");
+    ke._mapping = (uintptr_t)&peer;
+    _z_keyexpr_t expanded = _z_get_expanded_key_from_key(&zn, &ke, &peer);
+    assert(keyexpr_is(&expanded, "remote/root/child/leaf"));
+    _z_keyexpr_clear(&expanded);
+
+    _z_unregister_resource(&zn, 11, &peer);
+    _z_unregister_resource(&zn, 10, &peer);
+    assert(_z_get_resource_by_id(&zn, 10, &peer) == NULL);
+    assert(peer._remote_resources == NULL);
+
+    _z_keyexpr_clear(&child);
+    _z_keyexpr_clear(&root);
+    _z_transport_peer_common_clear(&peer);
+#if Z_FEATURE_MULTI_THREAD == 1
+    _z_mutex_drop(&zn._mutex_inner);
+#endif
+}
+
+int main(void) {
+    test_local_resources();
+    test_remote_resources();
+    return 0;
+}
@@ -0,0 +1,257 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/collections/arena.h"
+#include "zenoh-pico/collections/vec.h"
+#include "zenoh-pico/net/sample.h"
+#include "zenoh-pico/protocol/codec/network.h"
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/session/resource.h"
+#include "zenoh-pico/session/session.h"
+#include "zenoh-pico/session/subscription.h"
+#include "zenoh-pico/session/utils.h"
+#include "zenoh-pico/transport/transport.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if (Z_FEATURE_SUBSCRIPTION == 1) && (Z_FEATURE_RX_CACHE == 0) && (Z_RX_ARENA_SIZE > 0)
+
+// Heap allocations are counted by wrapping malloc, which is only possible with glibc and without sanitizers
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define SANITIZED
+#endif
+#endif
+#if defined(__GLIBC__) && !defined(SANITIZED) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#define COUNT_ALLOCATIONS
+extern void *__libc_malloc(size_t size);
+static volatile bool counting = false;
+static size_t alloc_nb = 0;
+
+void *malloc(size_t size) {
+    if (counting) {
+        alloc_nb++;
+    }
+    return __libc_malloc(size);
+}
+#endif
+
+#define KEY_ID 10
+#define SUB_NB 6
+
+static _z_session_t zn;
+static _z_session_rc_t zn_rc;
+static _z_transport_common_t transport;
+static _z_link_t link;
+static _z_transport_peer_common_t peer;
+
+static size_t delivered = 0;
+static bool key_in_arena = false;
+static bool retain = false;
+static _z_sample_t retained;
+
+static void sample_callback(_z_sample_t *sample, void *arg) {
+    _ZP_UNUSED(arg);
+    delivered++;
+    const uint8_t *key = (const uint8_t *)_z_string_data(&sample->keyexpr._suffix);
+    key_in_arena = (peer._rx_arena._buf != NULL) && (key >= peer._rx_arena._buf) &&
+                   (key < peer._rx_arena._buf + peer._rx_arena._capacity);
+    if (retain) {
+        // Keeping a sample copies what it references in the arena
+        assert(_z_sample_copy(&retained, sample) == _Z_RES_OK);
+    }
+}
+
+static void test_arena(void) {
+    _z_arena_t arena = _z_arena_make(64);
+    assert(_z_arena_alloc(&arena, 0) == NULL);
+    assert(arena._buf == NULL);
+    uint8_t *first = (uint8_t *)_z_arena_alloc(&arena, 3);
+    assert(first != NULL);
+    uint8_t *second = (uint8_t *)_z_arena_alloc(&arena, 8);
+    assert(second == first + 8);
+    assert(_z_arena_len(&arena) == 16);
+    assert(_z_arena_alloc(&arena, 49) == NULL);
+    assert(_z_arena_alloc(&arena, 48) == first + 16);
+    assert(_z_arena_alloc(&arena, 1) == NULL);
+    _z_arena_reset(&arena);
+    assert(_z_arena_len(&arena) == 0);
+    assert(_z_arena_alloc(&arena, 64) == first);
+    _z_arena_clear(&arena);
+    assert(arena._buf == NULL && arena._capacity == 0);
+
+    arena = _z_arena_make(0);
+    assert(_z_arena_alloc(&arena, 1) == NULL);
+    assert(arena._buf == NULL);
+}
+
+static void test_svec_promotion(void) {
+    uint32_t storage[2];
+    _z_svec_t v = _z_svec_alias_buf(storage, 2);
+    for (uint32_t i = 0; i < 5; i++) {
+        assert(_z_svec_append(&v, &i, NULL, sizeof(uint32_t), false) == _Z_RES_OK);
+        // Growing moves the vector out of the storage it doesn't own
+        assert(v._aliased == (i < 2));
+    }
+    assert(v._val != storage);
+    for (uint32_t i = 0; i < 5; i++) {
+        assert(*(uint32_t *)_z_svec_get(&v, i, sizeof(uint32_t)) == i);
+    }
+    _z_svec_clear(&v, NULL, sizeof(uint32_t));
+}
+
+static void setup(void) {
+    _z_id_t zid;
+    _z_session_generate_zid(&zid, Z_ZID_LENGTH);
+    assert(_z_session_init(&zn, &zid) == _Z_RES_OK);
+    zn_rc = _z_session_rc_new(&zn);
+    assert(!_Z_RC_IS_NULL(&zn_rc));
+    transport._session = _z_session_rc_clone_as_weak(&zn_rc);
+    transport._link = &link;
+    _z_resource_index_init(&peer._remote_resources_index);
+
+    _z_keyexpr_t declared = _z_rid_with_suffix(Z_RESOURCE_ID_NONE, "demo/remote");
+    declared._mapping = (uintptr_t)&peer;
+    assert(_z_register_resource(&zn, &declared, KEY_ID, &peer) == KEY_ID);
+    _z_keyexpr_clear(&declared);
+}
+
+static void add_subscription(uint32_t id) {
+    _z_subscription_t sub = {0};
+    _z_keyexpr_t key = _z_rid_with_suffix(Z_RESOURCE_ID_NONE, "demo/**");
+    sub._id = id;
+    assert(_z_keyexpr_copy(&sub._key, &key) == _Z_RES_OK);
+    assert(_z_keyexpr_copy(&sub._declared_key, &key) == _Z_RES_OK);
+    sub._allowed_origin = Z_LOCALITY_ANY;
+    sub._callback = sample_callback;
+    assert(_z_register_subscription(&zn, _Z_SUBSCRIBER_KIND_SUBSCRIBER, &sub) != NULL);
+}
+
+// Decodes and dispatches a put like the rx task of the peer would, returns the number of heap allocations it took
+static size_t receive_put(_z_keyexpr_t *key) {
+    uint8_t data[16] = {0};
+    _z_bytes_t payload;
+    assert(_z_bytes_from_buf(&payload, data, sizeof(data)) == _Z_RES_OK);
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_put(&n_msg, key, &payload, NULL, _Z_N_QOS_DEFAULT, NULL, NULL, Z_RELIABILITY_RELIABLE, NULL);
+    _z_wbuf_t wbf = _z_wbuf_make(Z_BATCH_UNICAST_SIZE, false);
+    assert(_z_network_message_encode(&wbf, &n_msg) == _Z_RES_OK);
+    _z_bytes_drop(&payload);
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+
+#if defined(COUNT_ALLOCATIONS)
+    alloc_nb = 0;
+    counting = true;
+#endif
+    _z_network_message_t decoded = {0};
+    _z_arc_slice_t arcs = _z_arc_slice_empty();
+    assert(_z_network_message_decode(&decoded, &zbf, &arcs, (uintptr_t)&peer) == _Z_RES_OK);
+    decoded._reliability = Z_RELIABILITY_RELIABLE;
+    assert(_z_handle_network_message(&transport, &decoded, &peer) == _Z_RES_OK);
+    _z_arena_reset(&peer._rx_arena);
+    size_t ret = 0;
+#if defined(COUNT_ALLOCATIONS)
+    counting = false;
+    ret = alloc_nb;
+#endif
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&wbf);
+    return ret;
+}
+
+static void test_dispatch(const char *name, _z_keyexpr_t key) {
+    // Without arena everything the dispatch of a sample needs is allocated
+    peer._rx_arena = _z_arena_make(0);
+    receive_put(&key);
+    delivered = 0;
+    size_t before = receive_put(&key);
+    assert(delivered == 1);
+    assert(!key_in_arena);
+
+    peer._rx_arena = _z_arena_make(Z_RX_ARENA_SIZE);
+    // The arena itself is allocated on first use
+    receive_put(&key);
+    delivered = 0;
+    size_t after = receive_put(&key);
+    assert(delivered == 1);
+#if defined(COUNT_ALLOCATIONS)
+    printf("Heap allocations per received put with %s: %zu without rx arena, %zu with it\n", name, before, after);
+    assert(after == 0);
+    assert(after < before);
+#else
+    _ZP_UNUSED(name);
+    _ZP_UNUSED(before);
+    _ZP_UNUSED(after);
+#endif
+    _z_arena_clear(&peer._rx_arena);
+}
+
+static void test_retained_sample(void) {
+    peer._rx_arena = _z_arena_make(Z_RX_ARENA_SIZE);
+    _z_keyexpr_t key = _z_rid_with_suffix(KEY_ID, "/leaf");
+    retain = true;
+    retained = _z_sample_null();
+    receive_put(&key);
+    retain = false;
+    assert(key_in_arena);
+    // The next batch reuses the arena, the retained sample doesn't depend on it
+    memset(peer._rx_arena._buf, 0, peer._rx_arena._capacity);
+    assert(_z_string_len(&retained.keyexpr._suffix) == strlen("demo/remote/leaf"));
+    assert(strncmp(_z_string_data(&retained.keyexpr._suffix), "demo/remote/leaf", strlen("demo/remote/leaf")) == 0);
+    assert(_z_bytes_len(&retained.payload) == 16);
+    _z_sample_clear(&retained);
+    _z_arena_clear(&peer._rx_arena);
+}
+
+static void test_many_subscriptions(void) {
+    // More matching subscriptions than the list initially holds, it is moved to the heap as it grows
+    for (uint32_t id = 2; id <= SUB_NB; id++) {
+        add_subscription(id);
+    }
+    peer._rx_arena = _z_arena_make(Z_RX_ARENA_SIZE);
+    _z_keyexpr_t key = _z_rid_with_suffix(KEY_ID, "/leaf");
+    delivered = 0;
+    receive_put(&key);
+    assert(delivered == SUB_NB);
+    _z_arena_clear(&peer._rx_arena);
+}
+
+int main(void) {
+    test_arena();
+    test_svec_promotion();
+    setup();
+    add_subscription(1);
+    test_dispatch("a full key", _z_rid_with_suffix(Z_RESOURCE_ID_NONE, "demo/example/test"));
+    test_dispatch("a declared key", _z_rid_with_suffix(KEY_ID, "/leaf"));
+    test_retained_sample();
+    test_many_subscriptions();
+    _z_session_clear(&zn);
+    _z_transport_peer_common_clear(&peer);
+    return 0;
+}
+
+#else
+int main(void) {
+    printf(
+        "Missing config token to build this test. This test requires: Z_FEATURE_SUBSCRIPTION, Z_RX_ARENA_SIZE > 0 and "
+        "no Z_FEATURE_RX_CACHE\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico/transport/common/rx.h"
+#include "zenoh-pico/transport/transport.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#define BUFF_SIZE 64
+
+#if Z_RX_BUFFER_POOL_SIZE > 0
+
+static void setup(_z_transport_common_t *ztc) {
+    memset(ztc, 0, sizeof(_z_transport_common_t));
+    ztc->_zbuf = _z_zbuf_make(BUFF_SIZE);
+    assert(_z_zbuf_capacity(&ztc->_zbuf) == BUFF_SIZE);
+}
+
+static void teardown(_z_transport_common_t *ztc) {
+    _z_zbuf_clear(&ztc->_zbuf);
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE; i++) {
+        _z_zbuf_clear(&ztc->_zbuf_pool[i]);
+    }
+}
+
+// Simulates a payload kept alive by the application
+static _z_slice_simple_rc_t hold(_z_transport_common_t *ztc) { return _z_slice_simple_rc_clone(&ztc->_zbuf._slice); }
+
+static void test_unreferenced(void) {
+    _z_transport_common_t ztc;
+    setup(&ztc);
+    const uint8_t *buf = _z_zbuf_start(&ztc._zbuf);
+    assert(_z_transport_update_rx_buffer(&ztc) == _Z_RES_OK);
+    assert(_z_zbuf_start(&ztc._zbuf) == buf);
+    teardown(&ztc);
+}
+
+static void test_recycle(void) {
+    _z_transport_common_t ztc;
+    setup(&ztc);
+    const uint8_t *first = _z_zbuf_start(&ztc._zbuf);
+
+    // Buffer is replaced while a payload references it, leftovers follow
+    _z_slice_simple_rc_t payload = hold(&ztc);
+    assert(_z_zbuf_len(&ztc._zbuf) == 0);
+    _z_iosli_write_bytes(&ztc._zbuf._ios, (const uint8_t *)"abcd", 0, 4);
+    _z_zbuf_set_rpos(&ztc._zbuf, 2);
+    assert(_z_transport_update_rx_buffer(&ztc) == _Z_RES_OK);
+    const uint8_t *second = _z_zbuf_start(&ztc._zbuf);
+    assert(second != first);
+    assert(_z_zbuf_len(&ztc._zbuf) == 2);
+    assert(_z_zbuf_read(&ztc._zbuf) == 'c');
+    assert(_z_zbuf_read(&ztc._zbuf) == 'd');
+
+    // Once the payload is dropped the first buffer is reused
+    _z_slice_simple_rc_drop(&payload);
+    payload = hold(&ztc);
+    assert(_z_transport_update_rx_buffer(&ztc) == _Z_RES_OK);
+    assert(_z_zbuf_start(&ztc._zbuf) == first);
+    assert(_z_zbuf_len(&ztc._zbuf) == 0);
+
+    // And the second one in turn
+    _z_slice_simple_rc_drop(&payload);
+    payload = hold(&ztc);
+    assert(_z_transport_update_rx_buffer(&ztc) == _Z_RES_OK);
+    assert(_z_zbuf_start(&ztc._zbuf) == second);
+    _z_slice_simple_rc_drop(&payload);
+    teardown(&ztc);
+}
+
+static void test_pool_full(void) {
+    _z_transport_common_t ztc;
+    setup(&ztc);
+    _z_slice_simple_rc_t payloads[Z_RX_BUFFER_POOL_SIZE + 2];
+    // Payloads outliving the pool capacity still get fresh buffers
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE + 2; i++) {
+        payloads[i] = hold(&ztc);
+        assert(_z_transport_update_rx_buffer(&ztc) == _Z_RES_OK);
+        assert(_z_zbuf_capacity(&ztc._zbuf) == BUFF_SIZE);
+        assert(_z_zbuf_get_ref_count(&ztc._zbuf) == 1);
+    }
+    for (size_t i = 0; i < Z_RX_BUFFER_POOL_SIZE + 2; i++) {
+        _z_slice_simple_rc_drop(&payloads[i]);
+    }
+    teardown(&ztc);
+}
+
+int main(void) {
+    test_unreferenced();
+    test_recycle();
+    test_pool_full();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_RX_BUFFER_POOL_SIZE > 0\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/session/dedup.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if defined(_Z_SESSION_MULTICAST_GROUPS) && Z_FEATURE_SUBSCRIPTION == 1 && Z_FEATURE_PUBLICATION == 1 && \
+    Z_FEATURE_UNICAST_PEER == 1 && Z_FEATURE_LOCAL_SUBSCRIBER == 0
+
+#define LISTEN_LOCATOR "tcp/127.0.0.1:7458"
+#define GROUP_LOCATOR "udp/224.0.0.225:7458#iface=lo"
+#define MSG_NB 20
+#define TIMEOUT_S 10
+
+static _z_source_info_t make_info(uint8_t zid, uint32_t sn) {
+    _z_source_info_t info = _z_source_info_null();
+    info._source_id.zid.id[0] = zid;
+    info._source_sn = sn;
+    return info;
+}
+
+static bool accept_sn(_z_session_dedup_t *dedup, uint8_t zid, uint32_t sn) {
+    _z_source_info_t info = make_info(zid, sn);
+    return _z_session_dedup_accept(dedup, &info);
+}
+
+static void test_dedup(void) {
+    printf("test_dedup\n");
+    _z_session_dedup_t dedup;
+    _z_session_dedup_init(&dedup);
+
+    // Messages without source info can't be told apart
+    _z_source_info_t none = _z_source_info_null();
+    assert(_z_session_dedup_accept(&dedup, &none));
+    assert(_z_session_dedup_accept(&dedup, &none));
+
+    assert(accept_sn(&dedup, 1, 10));
+    assert(!accept_sn(&dedup, 1, 10));
+    // Out of order within the window
+    assert(accept_sn(&dedup, 1, 12));
+    assert(accept_sn(&dedup, 1, 11));
+    assert(!accept_sn(&dedup, 1, 11));
+    assert(!accept_sn(&dedup, 1, 12));
+    // Sources are tracked separately
+    assert(accept_sn(&dedup, 2, 11));
+    assert(!accept_sn(&dedup, 2, 11));
+    // Older than the window
+    assert(accept_sn(&dedup, 1, 12 + _Z_SESSION_DEDUP_WINDOW));
+    assert(accept_sn(&dedup, 1, 12));
+    // Wrap around
+    assert(accept_sn(&dedup, 3, UINT32_MAX));
+    assert(accept_sn(&dedup, 3, 0));
+    assert(!accept_sn(&dedup, 3, UINT32_MAX));
+    assert(!accept_sn(&dedup, 3, 0));
+
+    // The oldest source is forgotten once the table is full
+    for (uint8_t i = 0; i < _Z_SESSION_DEDUP_SOURCE_NB; i++) {
+        assert(accept_sn(&dedup, (uint8_t)(100 + i), 5));
+    }
+    assert(accept_sn(&dedup, 1, 10));
+    assert(!accept_sn(&dedup, (uint8_t)(100 + _Z_SESSION_DEDUP_SOURCE_NB - 1), 5));
+}
+
+typedef struct {
+    _z_mutex_t mutex;
+    size_t msg_nb;
+    size_t info_nb;
+} _rx_ctx_t;
+
+static void sample_handler(z_loaned_sample_t *sample, void *arg) {
+    _rx_ctx_t *ctx = (_rx_ctx_t *)arg;
+    _z_mutex_lock(&ctx->mutex);
+    ctx->msg_nb++;
+    if (_z_source_info_check(&sample->source_info)) {
+        ctx->info_nb++;
+    }
+    _z_mutex_unlock(&ctx->mutex);
+}
+
+static size_t received(_rx_ctx_t *ctx) {
+    _z_mutex_lock(&ctx->mutex);
+    size_t msg_nb = ctx->msg_nb;
+    _z_mutex_unlock(&ctx->mutex);
+    return msg_nb;
+}
+
+static bool group_joined(const z_owned_session_t *s) {
+    _z_transport_multicast_t *ztm = &_Z_RC_IN_VAL(z_loan(*s))->_tp_groups[0]._transport._multicast;
+    _z_transport_peer_mutex_lock(&ztm->_common);
+    bool joined = ztm->_peers != NULL;
+    _z_transport_peer_mutex_unlock(&ztm->_common);
+    return joined;
+}
+
+static void open_peer(z_owned_session_t *s, uint8_t locator_key, const char *locator) {
+    z_owned_config_t config;
+    z_config_default(&config);
+    zp_config_insert(z_loan_mut(config), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(config), locator_key, locator);
+    zp_config_insert(z_loan_mut(config), Z_CONFIG_MULTICAST_GROUP_KEY, GROUP_LOCATOR);
+    assert(z_open(s, z_move(config), NULL) == Z_OK);
+    assert(zp_start_read_task(z_loan_mut(*s), NULL) == Z_OK);
+    assert(zp_start_lease_task(z_loan_mut(*s), NULL) == Z_OK);
+}
+
+static void test_group_delivery(void) {
+    printf("test_group_delivery\n");
+    _rx_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    assert(_z_mutex_init(&ctx.mutex) == _Z_RES_OK);
+
+    z_owned_session_t s1, s2;
+    open_peer(&s1, Z_CONFIG_LISTEN_KEY, LISTEN_LOCATOR);
+    open_peer(&s2, Z_CONFIG_CONNECT_KEY, LISTEN_LOCATOR);
+    assert(_Z_RC_IN_VAL(z_loan(s1))->_tp_groups[0]._type == _Z_TRANSPORT_MULTICAST_TYPE);
+    assert(_Z_RC_IN_VAL(z_loan(s2))->_tp_groups[0]._type == _Z_TRANSPORT_MULTICAST_TYPE);
+
+    z_view_keyexpr_t ke;
+    z_view_keyexpr_from_str_unchecked(&ke, "test/groups");
+    z_owned_closure_sample_t callback;
+    z_closure(&callback, sample_handler, NULL, &ctx);
+    assert(z_declare_background_subscriber(z_loan(s1), z_loan(ke), z_move(callback), NULL) == Z_OK);
+    // Wait for the sessions to discover each other in the group, joins are sent every Z_JOIN_INTERVAL
+    z_clock_t start = z_clock_now();
+    while ((!group_joined(&s1) || !group_joined(&s2)) && (z_clock_elapsed_s(&start) < TIMEOUT_S)) {
+        z_sleep_ms(10);
+    }
+    assert(group_joined(&s1) && group_joined(&s2));
+    // Wait for the subscriber declaration to reach the other session
+    z_sleep_s(1);
+
+    for (size_t i = 0; i < MSG_NB; i++) {
+        z_owned_bytes_t payload;
+        z_bytes_copy_from_str(&payload, "group data");
+        assert(z_put(z_loan(s2), z_loan(ke), z_move(payload), NULL) == Z_OK);
+    }
+    start = z_clock_now();
+    while ((received(&ctx) < MSG_NB) && (z_clock_elapsed_s(&start) < TIMEOUT_S)) {
+        z_sleep_ms(10);
+    }
+    // Copies received through the group must have been dropped
+    z_sleep_ms(500);
+    printf("Received: %zu\n", received(&ctx));
+    assert(received(&ctx) == MSG_NB);
+    // The stamp used to deduplicate isn't a source info set by the publisher
+    assert(ctx.info_nb == 0);
+
+    z_drop(z_move(s2));
+    z_drop(z_move(s1));
+    _z_mutex_drop(&ctx.mutex);
+}
+
+int main(void) {
+    test_dedup();
+    test_group_delivery();
+    return 0;
+}
+#else
+int main(void) {
+    printf(
+        "Missing config token to build this test. This test requires: Z_FEATURE_MULTICAST_TRANSPORT, "
+        "Z_SESSION_MULTICAST_GROUP_NB, Z_FEATURE_SUBSCRIPTION, Z_FEATURE_PUBLICATION, Z_FEATURE_UNICAST_PEER and not "
+        "Z_FEATURE_LOCAL_SUBSCRIBER\n");
+    return 0;
+}
+#endif
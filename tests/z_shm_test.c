@@ -0,0 +1,293 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/protocol/codec/core.h"
+#include "zenoh-pico/session/shm.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_SHM == 1
+
+#define SEGMENT_SIZE (16 * 1024)
+
+static void fill(uint8_t *data, size_t len, uint8_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (uint8_t)(seed + i);
+    }
+}
+
+static bool check(const z_loaned_bytes_t *bytes, size_t len, uint8_t seed) {
+    if (z_bytes_len(bytes) != len) {
+        return false;
+    }
+    uint8_t *buf = (uint8_t *)z_malloc(len);
+    assert(buf != NULL);
+    z_bytes_reader_t reader = z_bytes_get_reader(bytes);
+    assert(z_bytes_reader_read(&reader, buf, len) == len);
+    bool ok = true;
+    for (size_t i = 0; i < len; i++) {
+        ok = ok && (buf[i] == (uint8_t)(seed + i));
+    }
+    z_free(buf);
+    return ok;
+}
+
+static void test_alloc(void) {
+    printf("test_alloc\n");
+    z_owned_shm_provider_t provider;
+    assert(z_shm_provider_new(&provider, SEGMENT_SIZE) == Z_OK);
+
+    z_owned_bytes_t a, b;
+    uint8_t *data;
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), 100, &a, &data) == Z_OK);
+    fill(data, 100, 1);
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), 4000, &b, &data) == Z_OK);
+    fill(data, 4000, 2);
+    assert(check(z_loan(a), 100, 1));
+    assert(check(z_loan(b), 4000, 2));
+
+    // Payloads outlive the provider
+    z_shm_provider_drop(z_shm_provider_move(&provider));
+    assert(check(z_loan(b), 4000, 2));
+    z_drop(z_move(a));
+    z_drop(z_move(b));
+
+    assert(z_shm_provider_new(&provider, 0) != Z_OK);
+}
+
+static void test_exhaustion(void) {
+    printf("test_exhaustion\n");
+    z_owned_shm_provider_t provider;
+    assert(z_shm_provider_new(&provider, SEGMENT_SIZE) == Z_OK);
+    z_owned_bytes_t payloads[SEGMENT_SIZE / 64];
+    uint8_t *data;
+    size_t nb = 0;
+    while (z_shm_provider_alloc(z_shm_provider_loan(&provider), 1000, &payloads[nb], &data) == Z_OK) {
+        fill(data, 1000, (uint8_t)nb);
+        nb++;
+    }
+    assert(nb > 0 && nb < SEGMENT_SIZE / 1000);
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), SEGMENT_SIZE + 1, &payloads[nb], &data) != Z_OK);
+
+    // Dropped chunks are reused
+    z_drop(z_move(payloads[0]));
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), 1000, &payloads[0], &data) == Z_OK);
+    fill(data, 1000, 0);
+    for (size_t i = 0; i < nb; i++) {
+        assert(check(z_loan(payloads[i]), 1000, (uint8_t)i));
+    }
+
+    // Free neighbours are merged to hold a larger payload
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), 3000, &payloads[nb], &data) != Z_OK);
+    z_drop(z_move(payloads[1]));
+    z_drop(z_move(payloads[2]));
+    z_drop(z_move(payloads[3]));
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), 3000, &payloads[1], &data) == Z_OK);
+    z_drop(z_move(payloads[0]));
+    z_drop(z_move(payloads[1]));
+    for (size_t i = 4; i < nb; i++) {
+        z_drop(z_move(payloads[i]));
+    }
+
+    // The whole segment is free again
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), SEGMENT_SIZE, &payloads[0], &data) == Z_OK);
+    z_drop(z_move(payloads[0]));
+    z_shm_provider_drop(z_shm_provider_move(&provider));
+}
+
+static void test_chunk_detection(void) {
+    printf("test_chunk_detection\n");
+    z_owned_shm_provider_t provider;
+    assert(z_shm_provider_new(&provider, SEGMENT_SIZE) == Z_OK);
+    z_owned_bytes_t small, large, copied;
+    uint8_t *data;
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), Z_SHM_THRESHOLD - 1, &small, &data) == Z_OK);
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), Z_SHM_THRESHOLD, &large, &data) == Z_OK);
+    fill(data, Z_SHM_THRESHOLD, 3);
+    assert(z_bytes_copy_from_buf(&copied, data, Z_SHM_THRESHOLD) == Z_OK);
+
+    assert(_z_shm_bytes_chunk(z_loan(small)) == NULL);
+    assert(_z_shm_bytes_chunk(z_loan(large)) != NULL);
+    assert(_z_shm_bytes_chunk(z_loan(copied)) == NULL);
+
+    z_drop(z_move(small));
+    z_drop(z_move(large));
+    z_drop(z_move(copied));
+    z_shm_provider_drop(z_shm_provider_move(&provider));
+}
+
+// Sends a payload by reference the way the transmission and the reception of a put do
+static void test_round_trip(void) {
+    printf("test_round_trip\n");
+    z_owned_shm_provider_t provider;
+    assert(z_shm_provider_new(&provider, SEGMENT_SIZE) == Z_OK);
+    _z_shm_segment_cache_t cache;
+    _z_shm_segment_cache_init(&cache);
+
+    z_owned_bytes_t sent;
+    uint8_t *data;
+    size_t len = SEGMENT_SIZE - 64;
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), len, &sent, &data) == Z_OK);
+    fill(data, len, 4);
+    const _z_shm_chunk_ref_t *ref = _z_shm_bytes_chunk(z_loan(sent));
+    assert(ref != NULL);
+    _z_shm_chunk_ref_t handle;
+    assert(_z_shm_chunk_ref_take(ref, &handle) == _Z_RES_OK);
+    _z_bytes_t info;
+    assert(_z_shm_bytes_to_info(z_loan(sent), &handle, &info) == _Z_RES_OK);
+    assert(_z_bytes_len(&info) < 64);
+    assert(_z_shm_info_handle(&info) != NULL);
+    z_drop(z_move(sent));
+
+    // The receiver handle keeps the chunk in use
+    z_owned_bytes_t other;
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), 64, &other, &data) != Z_OK);
+    assert(_z_shm_bytes_from_info(&cache, &info) == _Z_RES_OK);
+    assert(_z_bytes_len(&info) == len);
+    z_owned_bytes_t received = {._val = info};
+    assert(check(z_loan(received), len, 4));
+    z_drop(z_move(received));
+    assert(!_z_shm_chunk_ref_is_held(&handle));
+    // The sender giving it back again changes nothing
+    _z_shm_chunk_ref_release(&handle);
+    _z_shm_chunk_ref_clear(&handle);
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), len, &other, &data) == Z_OK);
+    z_drop(z_move(other));
+
+    // Locations out of the segment or in unknown segments are rejected
+    uint8_t buf[64];
+    size_t n = 0;
+    n += _z_zint64_encode_buf(&buf[n], cache._segments[0]._val->_id);
+    n += _z_zsize_encode_buf(&buf[n], cache._segments[0]._val->_start);
+    n += _z_zsize_encode_buf(&buf[n], 0);
+    n += _z_zsize_encode_buf(&buf[n], SEGMENT_SIZE + 1);
+    n += _z_zint64_encode_buf(&buf[n], 0);
+    n += _z_zint64_encode_buf(&buf[n], 1);
+    assert(_z_bytes_from_buf(&info, buf, n) == _Z_RES_OK);
+    assert(_z_shm_bytes_from_info(&cache, &info) != _Z_RES_OK);
+    _z_bytes_drop(&info);
+    n = 0;
+    n += _z_zint64_encode_buf(&buf[n], cache._segments[0]._val->_id);
+    n += _z_zsize_encode_buf(&buf[n], cache._segments[0]._val->_start);
+    n += _z_zsize_encode_buf(&buf[n], 0);
+    n += _z_zsize_encode_buf(&buf[n], 1);
+    n += _z_zint64_encode_buf(&buf[n], Z_SHM_HANDLE_SLOTS);
+    n += _z_zint64_encode_buf(&buf[n], 1);
+    assert(_z_bytes_from_buf(&info, buf, n) == _Z_RES_OK);
+    assert(_z_shm_bytes_from_info(&cache, &info) != _Z_RES_OK);
+    _z_bytes_drop(&info);
+    n = _z_zint64_encode_buf(buf, cache._segments[0]._val->_id + 1);
+    n += _z_zsize_encode_buf(&buf[n], cache._segments[0]._val->_start);
+    n += _z_zsize_encode_buf(&buf[n], 0);
+    n += _z_zsize_encode_buf(&buf[n], 1);
+    n += _z_zint64_encode_buf(&buf[n], 0);
+    n += _z_zint64_encode_buf(&buf[n], 1);
+    assert(_z_bytes_from_buf(&info, buf, n) == _Z_RES_OK);
+    assert(_z_shm_bytes_from_info(&cache, &info) != _Z_RES_OK);
+    _z_bytes_drop(&info);
+
+    _z_shm_segment_cache_clear(&cache);
+    z_shm_provider_drop(z_shm_provider_move(&provider));
+}
+
+// Handles given to a peer come back once, whether the peer drops its payload or is dropped first
+static void test_ledger(void) {
+    printf("test_ledger\n");
+    z_owned_shm_provider_t provider;
+    assert(z_shm_provider_new(&provider, SEGMENT_SIZE) == Z_OK);
+    _z_shm_segment_cache_t cache;
+    _z_shm_segment_cache_init(&cache);
+    size_t len = SEGMENT_SIZE - 64;
+    z_owned_bytes_t sent, other;
+    uint8_t *data;
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), len, &sent, &data) == Z_OK);
+    fill(data, len, 5);
+    const _z_shm_chunk_ref_t *ref = _z_shm_bytes_chunk(z_loan(sent));
+
+    // Never received: the peer goes away before reading the location
+    _z_shm_ledger_t *ledger = _z_shm_ledger_new();
+    assert(ledger != NULL);
+    _z_shm_chunk_ref_t lost;
+    assert(_z_shm_chunk_ref_take(ref, &lost) == _Z_RES_OK);
+    assert(_z_shm_ledger_add(ledger, &lost) == _Z_RES_OK);
+    _z_shm_chunk_ref_clear(&lost);
+
+    // Received: the peer still holds the payload when it is dropped, then drops it
+    _z_shm_chunk_ref_t held;
+    assert(_z_shm_chunk_ref_take(ref, &held) == _Z_RES_OK);
+    assert(_z_shm_ledger_add(ledger, &held) == _Z_RES_OK);
+    _z_bytes_t info;
+    assert(_z_shm_bytes_to_info(z_loan(sent), &held, &info) == _Z_RES_OK);
+    _z_shm_chunk_ref_clear(&held);
+    assert(_z_shm_bytes_from_info(&cache, &info) == _Z_RES_OK);
+    z_drop(z_move(sent));
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), len, &other, &data) != Z_OK);
+    _z_shm_ledger_free(&ledger);
+    assert(ledger == NULL);
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), len, &other, &data) == Z_OK);
+    z_drop(z_move(other));
+    _z_bytes_drop(&info);
+    // The late drop did not release the chunk a second time
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), len, &sent, &data) == Z_OK);
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), len, &other, &data) != Z_OK);
+
+    // Handles given back by the peer are forgotten by the ledger, while a full segment falls back to copies
+    ledger = _z_shm_ledger_new();
+    assert(ledger != NULL);
+    ref = _z_shm_bytes_chunk(z_loan(sent));
+    for (size_t i = 0; i < 4 * Z_SHM_HANDLE_SLOTS; i++) {
+        _z_shm_chunk_ref_t handle;
+        assert(_z_shm_chunk_ref_take(ref, &handle) == _Z_RES_OK);
+        assert(_z_shm_ledger_add(ledger, &handle) == _Z_RES_OK);
+        _z_shm_chunk_ref_release(&handle);
+        _z_shm_chunk_ref_clear(&handle);
+    }
+    assert(_z_shm_chunk_ref_svec_len(&ledger->_refs) <= Z_SHM_HANDLE_SLOTS);
+    _z_shm_chunk_ref_t handles[Z_SHM_HANDLE_SLOTS];
+    for (size_t i = 0; i < Z_SHM_HANDLE_SLOTS; i++) {
+        assert(_z_shm_chunk_ref_take(ref, &handles[i]) == _Z_RES_OK);
+    }
+    _z_shm_chunk_ref_t extra;
+    assert(_z_shm_chunk_ref_take(ref, &extra) != _Z_RES_OK);
+    for (size_t i = 0; i < Z_SHM_HANDLE_SLOTS; i++) {
+        _z_shm_chunk_ref_release(&handles[i]);
+        _z_shm_chunk_ref_clear(&handles[i]);
+    }
+    _z_shm_ledger_free(&ledger);
+    z_drop(z_move(sent));
+    assert(z_shm_provider_alloc(z_shm_provider_loan(&provider), len, &sent, &data) == Z_OK);
+    z_drop(z_move(sent));
+
+    _z_shm_segment_cache_clear(&cache);
+    z_shm_provider_drop(z_shm_provider_move(&provider));
+}
+
+int main(void) {
+    test_alloc();
+    test_exhaustion();
+    test_chunk_detection();
+    test_round_trip();
+    test_ledger();
+    return 0;
+}
+
+#else
+int main(void) { return 0; }
+#endif
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "zenoh-pico/collections/timer_wheel.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+typedef struct {
+    _z_timer_wheel_node_t node;
+    uint64_t fired_at;
+    size_t fired_nb;
+} test_timer_t;
+
+typedef struct {
+    uint64_t now;
+    size_t fired_nb;
+} expire_ctx_t;
+
+static void on_expire(_z_timer_wheel_node_t *node, void *arg) {
+    expire_ctx_t *ctx = (expire_ctx_t *)arg;
+    // The node is the first member of the timer
+    test_timer_t *timer = (test_timer_t *)node;
+    assert(!_z_timer_wheel_node_is_scheduled(node));
+    timer->fired_at = ctx->now;
+    timer->fired_nb++;
+    ctx->fired_nb++;
+}
+
+static void advance(_z_timer_wheel_t *tw, expire_ctx_t *ctx, uint64_t now) {
+    ctx->now = now;
+    _z_timer_wheel_advance(tw, now, on_expire, ctx);
+}
+
+static void test_basic(void) {
+    printf("test_basic\n");
+    _z_timer_wheel_t tw;
+    _z_timer_wheel_init(&tw, 100);
+    expire_ctx_t ctx = {0};
+    test_timer_t t1 = {0}, t2 = {0}, t3 = {0};
+    _z_timer_wheel_node_init(&t1.node);
+    _z_timer_wheel_node_init(&t2.node);
+    _z_timer_wheel_node_init(&t3.node);
+
+    _z_timer_wheel_add(&tw, &t1.node, 110);
+    _z_timer_wheel_add(&tw, &t2.node, 5000);
+    _z_timer_wheel_add(&tw, &t3.node, 50);  // Already expired
+    assert(_z_timer_wheel_len(&tw) == 3);
+
+    advance(&tw, &ctx, 100);
+    assert(t3.fired_nb == 1 && t1.fired_nb == 0);
+    advance(&tw, &ctx, 109);
+    assert(t1.fired_nb == 0);
+    advance(&tw, &ctx, 110);
+    assert(t1.fired_nb == 1 && t1.fired_at == 110);
+    assert(_z_timer_wheel_len(&tw) == 1);
+
+    // Cancelled and rescheduled timers
+    _z_timer_wheel_add(&tw, &t1.node, 2000);
+    _z_timer_wheel_remove(&tw, &t1.node);
+    _z_timer_wheel_remove(&tw, &t1.node);
+    _z_timer_wheel_add(&tw, &t2.node, 3000);
+    assert(_z_timer_wheel_len(&tw) == 1);
+    advance(&tw, &ctx, 2999);
+    assert(t1.fired_nb == 1 && t2.fired_nb == 0);
+    advance(&tw, &ctx, 10000);
+    assert(t2.fired_nb == 1 && t2.fired_at == 10000);
+    assert(_z_timer_wheel_len(&tw) == 0);
+    assert(ctx.fired_nb == 3);
+}
+
+static void test_beyond_range(void) {
+    printf("test_beyond_range\n");
+    _z_timer_wheel_t tw;
+    _z_timer_wheel_init(&tw, 0);
+    expire_ctx_t ctx = {0};
+    test_timer_t t = {0};
+    _z_timer_wheel_node_init(&t.node);
+    uint64_t range = (uint64_t)1 << (_Z_TIMER_WHEEL_SLOT_BITS * _Z_TIMER_WHEEL_LEVEL_NB);
+    uint64_t expiry = 3 * range + 12345;
+    _z_timer_wheel_add(&tw, &t.node, expiry);
+    for (uint64_t now = 0; now < expiry; now += 997) {
+        advance(&tw, &ctx, now);
+        assert(t.fired_nb == 0);
+    }
+    advance(&tw, &ctx, expiry);
+    assert(t.fired_nb == 1 && t.fired_at == expiry);
+}
+
+#define RANDOM_TIMER_NB 2000
+#define RANDOM_ROUND_NB 20000
+
+// Compares the wheel to the expected expiries of timers randomly scheduled, cancelled and advanced through
+static void test_random(void) {
+    printf("test_random\n");
+    static test_timer_t timers[RANDOM_TIMER_NB];
+    static uint64_t expiries[RANDOM_TIMER_NB];
+    static bool scheduled[RANDOM_TIMER_NB];
+    memset(timers, 0, sizeof(timers));
+    memset(scheduled, 0, sizeof(scheduled));
+    for (size_t i = 0; i < RANDOM_TIMER_NB; i++) {
+        _z_timer_wheel_node_init(&timers[i].node);
+    }
+    _z_timer_wheel_t tw;
+    uint64_t now = 7;
+    _z_timer_wheel_init(&tw, now);
+    expire_ctx_t ctx = {0};
+    srand(42);
+
+    for (size_t round = 0; round < RANDOM_ROUND_NB; round++) {
+        size_t i = (size_t)rand() % RANDOM_TIMER_NB;
+        int op = rand() % 10;
+        if (op < 6) {
+            // Mostly short timeouts, some reaching the upper levels
+            uint64_t delay = (op < 4) ? (uint64_t)(rand() % 3000) : (uint64_t)rand() % 2000000;
+            expiries[i] = now + delay;
+            scheduled[i] = true;
+            _z_timer_wheel_add(&tw, &timers[i].node, expiries[i]);
+        } else if (op < 7) {
+            scheduled[i] = false;
+            _z_timer_wheel_remove(&tw, &timers[i].node);
+        } else {
+            for (size_t j = 0; j < RANDOM_TIMER_NB; j++) {
+                timers[j].fired_nb = 0;
+            }
+            now += (uint64_t)(rand() % 500);
+            advance(&tw, &ctx, now);
+            size_t len = 0;
+            for (size_t j = 0; j < RANDOM_TIMER_NB; j++) {
+                if (scheduled[j] && expiries[j] <= now) {
+                    assert(timers[j].fired_nb == 1);
+                    scheduled[j] = false;
+                } else {
+                    assert(timers[j].fired_nb == 0);
+                }
+                len += scheduled[j] ? 1 : 0;
+                assert(_z_timer_wheel_node_is_scheduled(&timers[j].node) == scheduled[j]);
+            }
+            assert(_z_timer_wheel_len(&tw) == len);
+        }
+    }
+    printf("Fired: %zu\n", ctx.fired_nb);
+}
+
+static void on_expire_reschedule(_z_timer_wheel_node_t *node, void *arg) {
+    _z_timer_wheel_t *tw = (_z_timer_wheel_t *)arg;
+    test_timer_t *timer = (test_timer_t *)node;
+    timer->fired_nb++;
+    if (timer->fired_nb < 3) {
+        _z_timer_wheel_add(tw, node, node->_expiry + 10);
+    }
+}
+
+static void test_reschedule_from_expiry(void) {
+    printf("test_reschedule_from_expiry\n");
+    _z_timer_wheel_t tw;
+    _z_timer_wheel_init(&tw, 0);
+    test_timer_t t = {0};
+    _z_timer_wheel_node_init(&t.node);
+    _z_timer_wheel_add(&tw, &t.node, 5);
+    _z_timer_wheel_advance(&tw, 14, on_expire_reschedule, &tw);
+    assert(t.fired_nb == 1);
+    _z_timer_wheel_advance(&tw, 25, on_expire_reschedule, &tw);
+    assert(t.fired_nb == 3);
+    assert(_z_timer_wheel_len(&tw) == 0);
+}
+
+int main(void) {
+    test_basic();
+    test_beyond_range();
+    test_random();
+    test_reschedule_from_expiry();
+    return 0;
+}
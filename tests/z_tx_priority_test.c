@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/fake_link.h"
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/transport/common/tx.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if Z_FEATURE_BATCHING == 1
+
+#define WBUF_SIZE 256
+
+typedef struct {
+    _z_zint_t sn;
+    size_t msg_nb;
+    z_priority_t priority;
+} frame_info_t;
+
+static frame_info_t decode_datagram(size_t idx) {
+    frame_info_t info = {0};
+    _z_network_message_t msgs[FAKE_LINK_DATAGRAM_MAX];
+    info.msg_nb = fake_link_decode_frame(idx, &info.sn, msgs, FAKE_LINK_DATAGRAM_MAX);
+    for (size_t i = 0; i < info.msg_nb; i++) {
+        assert(msgs[i]._tag == _Z_N_PUSH);
+        z_priority_t priority = _z_n_qos_get_priority(msgs[i]._body._push._qos);
+        // A frame only holds messages of a single priority
+        assert(i == 0 || info.priority == priority);
+        info.priority = priority;
+        _z_n_msg_clear(&msgs[i]);
+    }
+    return info;
+}
+
+static void send_del(_z_session_t *zn, z_priority_t priority, bool express) {
+    _z_keyexpr_t key = _z_rid_with_suffix(Z_RESOURCE_ID_NONE, "test/priority");
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_del(&n_msg, &key, _z_n_qos_make(express, false, priority), NULL, Z_RELIABILITY_RELIABLE, NULL);
+    assert(_z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) == _Z_RES_OK);
+}
+
+static void setup(_z_session_t *zn, _z_link_t *link) {
+    memset(zn, 0, sizeof(_z_session_t));
+    zn->_tp._type = _Z_TRANSPORT_MULTICAST_TYPE;
+    fake_link_transport_setup(&zn->_tp._transport._multicast._common, link, WBUF_SIZE);
+}
+
+static void teardown(_z_session_t *zn) { fake_link_transport_teardown(&zn->_tp._transport._multicast._common); }
+
+static void test_priority_order(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+    _z_transport_common_t *ztc = &zn._tp._transport._multicast._common;
+    ztc->_batch_state = _Z_BATCHING_ACTIVE;
+
+    send_del(&zn, Z_PRIORITY_DATA_LOW, false);
+    send_del(&zn, Z_PRIORITY_DATA_LOW, false);
+    send_del(&zn, Z_PRIORITY_REAL_TIME, false);
+    assert(fake_link_datagram_nb == 0);
+    assert(_z_send_n_batch(&zn, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+
+    // Real time frame is drained first, SNs follow the wire order
+    assert(fake_link_datagram_nb == 2);
+    frame_info_t first = decode_datagram(0);
+    frame_info_t second = decode_datagram(1);
+    assert(first.priority == Z_PRIORITY_REAL_TIME && first.msg_nb == 1);
+    assert(second.priority == Z_PRIORITY_DATA_LOW && second.msg_nb == 2);
+    assert(_z_sn_consecutive(ztc->_sn_res, first.sn, second.sn));
+    assert(ztc->_batch_count == 0);
+    teardown(&zn);
+}
+
+static void test_express(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+    zn._tp._transport._multicast._common._batch_state = _Z_BATCHING_ACTIVE;
+
+    send_del(&zn, Z_PRIORITY_BACKGROUND, false);
+    send_del(&zn, Z_PRIORITY_INTERACTIVE_HIGH, true);
+    // Express message flushes every lane, highest priority first
+    assert(fake_link_datagram_nb == 2);
+    assert(decode_datagram(0).priority == Z_PRIORITY_INTERACTIVE_HIGH);
+    assert(decode_datagram(1).priority == Z_PRIORITY_BACKGROUND);
+    teardown(&zn);
+}
+
+static void test_lane_overflow(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+    _z_transport_common_t *ztc = &zn._tp._transport._multicast._common;
+    ztc->_batch_state = _Z_BATCHING_ACTIVE;
+
+    size_t msg_nb = 100;
+    for (size_t i = 0; i < msg_nb; i++) {
+        send_del(&zn, Z_PRIORITY_DATA, false);
+    }
+    assert(fake_link_datagram_nb > 0);
+    ztc->_batch_state = _Z_BATCHING_IDLE;
+    // Leftover batch is sent before non batched messages
+    send_del(&zn, Z_PRIORITY_REAL_TIME, false);
+    size_t total = 0;
+    for (size_t i = 0; i < fake_link_datagram_nb; i++) {
+        frame_info_t info = decode_datagram(i);
+        if (i > 0) {
+            assert(_z_sn_consecutive(ztc->_sn_res, decode_datagram(i - 1).sn, info.sn));
+        }
+        if (i < fake_link_datagram_nb - 1) {
+            assert(info.priority == Z_PRIORITY_DATA);
+            total += info.msg_nb;
+        } else {
+            assert(info.priority == Z_PRIORITY_REAL_TIME);
+        }
+    }
+    assert(total == msg_nb);
+    teardown(&zn);
+}
+
+int main(void) {
+    test_priority_order();
+    test_express();
+    test_lane_overflow();
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_FEATURE_BATCHING\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,364 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "utils/fake_link.h"
+#include "zenoh-pico/net/session.h"
+#include "zenoh-pico/protocol/definitions/network.h"
+#include "zenoh-pico/transport/common/tx.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if defined(_Z_TX_QUEUE)
+
+#define WBUF_SIZE 256
+#define PAYLOAD_SIZE 1000
+
+static z_result_t send_del(_z_session_t *zn, uint16_t id, z_congestion_control_t cong_ctrl) {
+    _z_keyexpr_t key = _z_rid_with_suffix(id, NULL);
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_del(&n_msg, &key, _Z_N_QOS_DEFAULT, NULL, Z_RELIABILITY_RELIABLE, NULL);
+    return _z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, cong_ctrl, NULL);
+}
+
+#define PUT_PAYLOAD_SIZE 200
+
+static z_result_t send_put(_z_session_t *zn, uint16_t id) {
+    uint8_t data[PUT_PAYLOAD_SIZE];
+    memset(data, (uint8_t)id, PUT_PAYLOAD_SIZE);
+    _z_bytes_t payload;
+    assert(_z_bytes_from_buf(&payload, data, PUT_PAYLOAD_SIZE) == _Z_RES_OK);
+    _z_keyexpr_t key = _z_rid_with_suffix(id, NULL);
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_put(&n_msg, &key, &payload, NULL, _Z_N_QOS_DEFAULT, NULL, NULL, Z_RELIABILITY_RELIABLE, NULL);
+    z_result_t ret = _z_send_n_msg(zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL);
+    _z_bytes_drop(&payload);
+    return ret;
+}
+
+// Decodes the ids of the deletes in a frame, returns their number
+static size_t decode_frame(size_t idx, _z_zint_t *sn, uint16_t *ids, size_t max_ids) {
+    _z_network_message_t msgs[FAKE_LINK_DATAGRAM_MAX];
+    size_t nb = fake_link_decode_frame(idx, sn, msgs, FAKE_LINK_DATAGRAM_MAX);
+    assert(nb <= max_ids);
+    for (size_t i = 0; i < nb; i++) {
+        assert(msgs[i]._tag == _Z_N_PUSH);
+        ids[i] = msgs[i]._body._push._key._id;
+        _z_n_msg_clear(&msgs[i]);
+    }
+    return nb;
+}
+
+static void setup(_z_session_t *zn, _z_link_t *link) {
+    memset(zn, 0, sizeof(_z_session_t));
+    zn->_tp._type = _Z_TRANSPORT_MULTICAST_TYPE;
+    _z_transport_common_t *ztc = &zn->_tp._transport._multicast._common;
+    fake_link_transport_setup(ztc, link, WBUF_SIZE);
+    assert(_z_transport_tx_queue_start(ztc, NULL) == _Z_RES_OK);
+}
+
+static void teardown(_z_session_t *zn) {
+    _z_transport_common_t *ztc = &zn->_tp._transport._multicast._common;
+    _z_transport_tx_queue_stop(ztc);
+    assert(ztc->_tx_queue == NULL);
+    fake_link_transport_teardown(ztc);
+}
+
+static void test_batch_queued(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+    _z_transport_common_t *ztc = &zn._tp._transport._multicast._common;
+
+    // Messages queued while the writer is busy go out together in the next frame
+    fake_link_stalled = true;
+    assert(send_del(&zn, 1, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    fake_link_wait_writing();
+    for (uint16_t id = 2; id <= 5; id++) {
+        assert(send_del(&zn, id, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    }
+    size_t depth;
+    uint64_t dropped;
+    _z_transport_tx_queue_stats(ztc, &depth, &dropped);
+    assert(depth == 5 && dropped == 0);
+    fake_link_stalled = false;
+    assert(_z_transport_tx_queue_drain(ztc, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+
+    assert(fake_link_datagram_nb == 2);
+    uint16_t ids[8];
+    _z_zint_t first_sn, second_sn;
+    assert(decode_frame(0, &first_sn, ids, 8) == 1);
+    assert(ids[0] == 1);
+    assert(decode_frame(1, &second_sn, ids, 8) == 4);
+    for (uint16_t i = 0; i < 4; i++) {
+        assert(ids[i] == i + 2);
+    }
+    assert(_z_sn_consecutive(ztc->_sn_res, first_sn, second_sn));
+    _z_transport_tx_queue_stats(ztc, &depth, &dropped);
+    assert(depth == 0 && dropped == 0);
+    teardown(&zn);
+}
+
+static void test_congestion(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+    _z_transport_common_t *ztc = &zn._tp._transport._multicast._common;
+
+    fake_link_stalled = true;
+    assert(send_del(&zn, 1, Z_CONGESTION_CONTROL_DROP) == _Z_RES_OK);
+    fake_link_wait_writing();
+    for (uint16_t id = 2; id <= Z_TX_QUEUE_SIZE; id++) {
+        assert(send_del(&zn, id, Z_CONGESTION_CONTROL_DROP) == _Z_RES_OK);
+    }
+    // Queue is full, dropping doesn't wait and blocking gives up after the timeout
+    assert(send_del(&zn, 100, Z_CONGESTION_CONTROL_DROP) != _Z_RES_OK);
+    z_clock_t start = z_clock_now();
+    assert(send_del(&zn, 101, Z_CONGESTION_CONTROL_BLOCK) != _Z_RES_OK);
+    assert(z_clock_elapsed_ms(&start) + 10 >= Z_TX_QUEUE_BLOCK_TIMEOUT_MS);
+    size_t depth;
+    uint64_t dropped;
+    _z_transport_tx_queue_stats(ztc, &depth, &dropped);
+    assert(depth == Z_TX_QUEUE_SIZE && dropped == 2);
+
+    fake_link_stalled = false;
+    assert(_z_transport_tx_queue_drain(ztc, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    _z_transport_tx_queue_stats(ztc, &depth, &dropped);
+    assert(depth == 0 && dropped == 2);
+    assert(send_del(&zn, 102, Z_CONGESTION_CONTROL_DROP) == _Z_RES_OK);
+    assert(_z_transport_tx_queue_drain(ztc, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    teardown(&zn);
+}
+
+static void *unstall_task(void *arg) {
+    _ZP_UNUSED(arg);
+    z_sleep_ms(50);
+    fake_link_stalled = false;
+    return NULL;
+}
+
+static void test_close_after_queued(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+    _z_transport_common_t *ztc = &zn._tp._transport._multicast._common;
+
+    // Messages published just before closing are sent before the close
+    fake_link_stalled = true;
+    assert(send_del(&zn, 1, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    fake_link_wait_writing();
+    assert(send_del(&zn, 2, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    _z_task_t task;
+    assert(_z_task_init(&task, NULL, unstall_task, NULL) == _Z_RES_OK);
+    _z_transport_message_t t_msg = _z_t_msg_make_close(_Z_CLOSE_GENERIC, false);
+    assert(_z_transport_tx_send_t_msg(ztc, &t_msg, NULL) == _Z_RES_OK);
+    _z_t_msg_clear(&t_msg);
+    _z_task_join(&task);
+
+    assert(fake_link_datagram_nb == 3);
+    uint16_t ids[8];
+    _z_zint_t sn;
+    assert(decode_frame(0, &sn, ids, 8) == 1 && ids[0] == 1);
+    assert(decode_frame(1, &sn, ids, 8) == 1 && ids[0] == 2);
+    _z_zbuf_t zbf = _z_slice_as_zbuf(fake_link_datagrams[2]);
+    assert(_z_transport_message_decode(&t_msg, &zbf) == _Z_RES_OK);
+    assert(_Z_MID(t_msg._header) == _Z_MID_T_CLOSE);
+    _z_t_msg_clear(&t_msg);
+    teardown(&zn);
+}
+
+static void test_drain_timeout(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+    _z_transport_common_t *ztc = &zn._tp._transport._multicast._common;
+
+    // A send waiting behind a stalled writer gives up after the timeout, a dropped message is counted
+    fake_link_stalled = true;
+    assert(send_del(&zn, 1, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    fake_link_wait_writing();
+    z_clock_t start = z_clock_now();
+    assert(_z_transport_tx_queue_drain(ztc, Z_CONGESTION_CONTROL_DROP) != _Z_RES_OK);
+    assert(z_clock_elapsed_ms(&start) + 10 >= Z_TX_QUEUE_BLOCK_TIMEOUT_MS);
+    size_t depth;
+    uint64_t dropped;
+    _z_transport_tx_queue_stats(ztc, &depth, &dropped);
+    assert(depth == 1 && dropped == 1);
+    _z_transport_message_t t_msg = _z_t_msg_make_close(_Z_CLOSE_GENERIC, false);
+    assert(_z_transport_tx_send_t_msg(ztc, &t_msg, NULL) != _Z_RES_OK);
+    _z_t_msg_clear(&t_msg);
+    _z_transport_tx_queue_stats(ztc, &depth, &dropped);
+    assert(depth == 1 && dropped == 1);
+
+    fake_link_stalled = false;
+    assert(_z_transport_tx_queue_drain(ztc, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    assert(fake_link_datagram_nb == 1);
+    teardown(&zn);
+}
+
+#if Z_FEATURE_BATCHING == 1
+static void test_batch_after_queued(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+
+    // Starting a batch waits for the queued messages, batched ones follow them
+    fake_link_stalled = true;
+    assert(send_del(&zn, 1, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    fake_link_wait_writing();
+    assert(send_del(&zn, 2, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    _z_task_t task;
+    assert(_z_task_init(&task, NULL, unstall_task, NULL) == _Z_RES_OK);
+    assert(_z_transport_start_batching(&zn._tp));
+    _z_task_join(&task);
+    assert(fake_link_datagram_nb == 2);
+    assert(send_del(&zn, 3, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    assert(send_del(&zn, 4, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+    _z_transport_stop_batching(&zn._tp);
+    assert(_z_send_n_batch(&zn, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+
+    assert(fake_link_datagram_nb == 3);
+    uint16_t ids[8];
+    _z_zint_t sn;
+    assert(decode_frame(0, &sn, ids, 8) == 1 && ids[0] == 1);
+    assert(decode_frame(1, &sn, ids, 8) == 1 && ids[0] == 2);
+    assert(decode_frame(2, &sn, ids, 8) == 2 && ids[0] == 3 && ids[1] == 4);
+    teardown(&zn);
+}
+#endif
+
+static void test_ring(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+    _z_transport_common_t *ztc = &zn._tp._transport._multicast._common;
+
+    // Queued puts take more than the ring, the last ones get buffers of their own, and the second round wraps around
+    uint16_t id = 1;
+    for (size_t round = 0; round < 2; round++) {
+        fake_link_reset();
+        fake_link_stalled = true;
+        assert(send_put(&zn, id) == _Z_RES_OK);
+        fake_link_wait_writing();
+        for (size_t i = 1; i < Z_TX_QUEUE_SIZE; i++) {
+            assert(send_put(&zn, (uint16_t)(id + i)) == _Z_RES_OK);
+        }
+        fake_link_stalled = false;
+        assert(_z_transport_tx_queue_drain(ztc, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+
+        size_t received = 0;
+        for (size_t i = 0; i < fake_link_datagram_nb; i++) {
+            // Payloads are decoded as references to an owned buffer
+            _z_wbuf_t wbf = _z_wbuf_make(fake_link_datagrams[i].len, false);
+            assert(_z_wbuf_write_bytes(&wbf, fake_link_datagrams[i].start, 0, fake_link_datagrams[i].len) == _Z_RES_OK);
+            _z_zbuf_t zbf = _z_wbuf_to_zbuf(&wbf);
+            _z_transport_message_t t_msg;
+            assert(_z_transport_message_decode(&t_msg, &zbf) == _Z_RES_OK);
+            while (_z_zbuf_len(&zbf) > 0) {
+                _z_network_message_t n_msg = {0};
+                _z_arc_slice_t arcs = _z_arc_slice_empty();
+                assert(_z_network_message_decode(&n_msg, &zbf, &arcs, 0) == _Z_RES_OK);
+                assert(n_msg._body._push._key._id == id);
+                uint8_t out[PUT_PAYLOAD_SIZE];
+                const _z_bytes_t *payload = &n_msg._body._push._body._body._put._payload;
+                assert(_z_bytes_to_buf(payload, out, PUT_PAYLOAD_SIZE) == PUT_PAYLOAD_SIZE);
+                for (size_t j = 0; j < PUT_PAYLOAD_SIZE; j++) {
+                    assert(out[j] == (uint8_t)id);
+                }
+                _z_n_msg_clear(&n_msg);
+                id++;
+                received++;
+            }
+            _z_zbuf_clear(&zbf);
+            _z_wbuf_clear(&wbf);
+        }
+        assert(received == Z_TX_QUEUE_SIZE);
+    }
+    teardown(&zn);
+}
+
+#if Z_FEATURE_FRAGMENTATION == 1
+static void test_fragmented(void) {
+    _z_session_t zn;
+    _z_link_t link;
+    setup(&zn, &link);
+    _z_transport_common_t *ztc = &zn._tp._transport._multicast._common;
+
+    uint8_t data[PAYLOAD_SIZE];
+    for (size_t i = 0; i < PAYLOAD_SIZE; i++) {
+        data[i] = (uint8_t)i;
+    }
+    _z_bytes_t payload;
+    assert(_z_bytes_from_buf(&payload, data, PAYLOAD_SIZE) == _Z_RES_OK);
+    _z_keyexpr_t key = _z_rid_with_suffix(7, NULL);
+    _z_network_message_t n_msg;
+    _z_n_msg_make_push_put(&n_msg, &key, &payload, NULL, _Z_N_QOS_DEFAULT, NULL, NULL, Z_RELIABILITY_RELIABLE, NULL);
+    fake_link_stalled = true;
+    assert(_z_send_n_msg(&zn, &n_msg, Z_RELIABILITY_RELIABLE, Z_CONGESTION_CONTROL_BLOCK, NULL) == _Z_RES_OK);
+    // The queued message doesn't depend on the payload of the sender
+    _z_bytes_drop(&payload);
+    fake_link_stalled = false;
+    assert(_z_transport_tx_queue_drain(ztc, Z_CONGESTION_CONTROL_BLOCK) == _Z_RES_OK);
+
+    assert(fake_link_datagram_nb > 1);
+    _z_wbuf_t msg = _z_wbuf_make(2 * PAYLOAD_SIZE, false);
+    for (size_t i = 0; i < fake_link_datagram_nb; i++) {
+        _z_zbuf_t zbf = _z_slice_as_zbuf(fake_link_datagrams[i]);
+        _z_transport_message_t t_msg;
+        assert(_z_transport_message_decode(&t_msg, &zbf) == _Z_RES_OK);
+        assert(_Z_MID(t_msg._header) == _Z_MID_T_FRAGMENT);
+        assert(_Z_HAS_FLAG(t_msg._header, _Z_FLAG_T_FRAGMENT_M) == (i + 1 < fake_link_datagram_nb));
+        _z_slice_t *frag = &t_msg._body._fragment._payload;
+        assert(_z_wbuf_write_bytes(&msg, frag->start, 0, frag->len) == _Z_RES_OK);
+    }
+    _z_zbuf_t zbf = _z_wbuf_to_zbuf(&msg);
+    _z_network_message_t decoded = {0};
+    _z_arc_slice_t arcs = _z_arc_slice_empty();
+    assert(_z_network_message_decode(&decoded, &zbf, &arcs, 0) == _Z_RES_OK);
+    const _z_bytes_t *received = &decoded._body._push._body._body._put._payload;
+    uint8_t out[PAYLOAD_SIZE];
+    assert(_z_bytes_len(received) == PAYLOAD_SIZE);
+    assert(_z_bytes_to_buf(received, out, PAYLOAD_SIZE) == PAYLOAD_SIZE);
+    assert(memcmp(out, data, PAYLOAD_SIZE) == 0);
+    _z_n_msg_clear(&decoded);
+    _z_zbuf_clear(&zbf);
+    _z_wbuf_clear(&msg);
+    teardown(&zn);
+}
+#endif
+
+int main(void) {
+    test_batch_queued();
+    test_congestion();
+    test_close_after_queued();
+    test_drain_timeout();
+#if Z_FEATURE_BATCHING == 1
+    test_batch_after_queued();
+#endif
+    test_ring();
+#if Z_FEATURE_FRAGMENTATION == 1
+    test_fragmented();
+#endif
+    return 0;
+}
+
+#else
+int main(void) {
+    printf("Missing config token to build this test. This test requires: Z_TX_QUEUE_SIZE > 0 and Z_FEATURE_MULTI_THREAD\n");
+    return 0;
+}
+#endif
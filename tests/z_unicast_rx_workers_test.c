@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2025 ZettaScale Technology
+//
+// This program and the accompanying materials are made available under the
+// terms of the Eclipse Public License 2.0 which is available at
+// http://www.eclipse.org/legal/epl-2.0, or the Apache License, Version 2.0
+// which is available at https://www.apache.org/licenses/LICENSE-2.0.
+//
+// SPDX-License-Identifier: EPL-2.0 OR Apache-2.0
+//
+// Contributors:
+//   ZettaScale Zenoh Team, <zenoh@zettascale.tech>
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "zenoh-pico.h"
+#include "zenoh-pico/net/session.h"
+
+#undef NDEBUG
+#include <assert.h>
+
+#if defined(_Z_SYS_NET_EVENT_SET) && Z_FEATURE_SUBSCRIPTION == 1 && Z_FEATURE_PUBLICATION == 1 && \
+    Z_FEATURE_UNICAST_PEER == 1 && Z_FEATURE_LOCAL_SUBSCRIBER == 0
+
+#define LISTEN_LOCATOR "tcp/127.0.0.1:7457"
+#define WORKER_NB 4
+#define PEER_NB 6
+#define MSG_NB 20
+#define TIMEOUT_S 10
+
+typedef struct {
+    _z_mutex_t mutex;
+    size_t msg_nb[PEER_NB];
+} _rx_ctx_t;
+
+static void sample_handler(z_loaned_sample_t *sample, void *arg) {
+    _rx_ctx_t *ctx = (_rx_ctx_t *)arg;
+    z_view_string_t keystr;
+    z_keyexpr_as_view_string(z_sample_keyexpr(sample), &keystr);
+    // Key expressions are test/workers/<peer index>
+    const char *data = z_string_data(z_loan(keystr));
+    size_t len = z_string_len(z_loan(keystr));
+    assert(len > 0);
+    size_t idx = (size_t)(data[len - 1] - '0');
+    assert(idx < PEER_NB);
+    _z_mutex_lock(&ctx->mutex);
+    ctx->msg_nb[idx]++;
+    _z_mutex_unlock(&ctx->mutex);
+}
+
+static void open_peer(z_owned_session_t *s, uint8_t locator_key, const char *locator) {
+    z_owned_config_t config;
+    z_config_default(&config);
+    zp_config_insert(z_loan_mut(config), Z_CONFIG_MODE_KEY, "peer");
+    zp_config_insert(z_loan_mut(config), locator_key, locator);
+    assert(z_open(s, z_move(config), NULL) == Z_OK);
+}
+
+static bool all_received(_rx_ctx_t *ctx) {
+    bool done = true;
+    _z_mutex_lock(&ctx->mutex);
+    for (size_t i = 0; i < PEER_NB; i++) {
+        if (ctx->msg_nb[i] < MSG_NB) {
+            done = false;
+        }
+    }
+    _z_mutex_unlock(&ctx->mutex);
+    return done;
+}
+
+static void test_sharded_rx(void) {
+    printf("test_sharded_rx\n");
+    _rx_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    assert(_z_mutex_init(&ctx.mutex) == _Z_RES_OK);
+
+    z_owned_session_t listener;
+    open_peer(&listener, Z_CONFIG_LISTEN_KEY, LISTEN_LOCATOR);
+    zp_task_read_options_t read_opts;
+    zp_task_read_options_default(&read_opts);
+    read_opts.worker_count = WORKER_NB;
+    assert(zp_start_read_task(z_loan_mut(listener), &read_opts) == Z_OK);
+    assert(zp_start_lease_task(z_loan_mut(listener), NULL) == Z_OK);
+    _z_transport_unicast_t *ztu = &_Z_RC_IN_VAL(z_loan(listener))->_tp._transport._unicast;
+    assert(ztu->_rx_workers != NULL);
+    assert(ztu->_rx_worker_nb == WORKER_NB);
+
+    z_view_keyexpr_t sub_ke;
+    z_view_keyexpr_from_str_unchecked(&sub_ke, "test/workers/*");
+    z_owned_closure_sample_t callback;
+    z_closure(&callback, sample_handler, NULL, &ctx);
+    assert(z_declare_background_subscriber(z_loan(listener), z_loan(sub_ke), z_move(callback), NULL) == Z_OK);
+
+    z_owned_session_t peers[PEER_NB];
+    for (size_t i = 0; i < PEER_NB; i++) {
+        open_peer(&peers[i], Z_CONFIG_CONNECT_KEY, LISTEN_LOCATOR);
+        assert(zp_start_read_task(z_loan_mut(peers[i]), NULL) == Z_OK);
+        assert(zp_start_lease_task(z_loan_mut(peers[i]), NULL) == Z_OK);
+    }
+    // Wait for the subscriber declaration to reach the peers
+    z_sleep_s(1);
+
+    // Interleave the peers so that several workers have data ready at once
+    char ke_buf[32];
+    for (size_t n = 0; n < MSG_NB; n++) {
+        for (size_t i = 0; i < PEER_NB; i++) {
+            snprintf(ke_buf, sizeof(ke_buf), "test/workers/%zu", i);
+            z_view_keyexpr_t pub_ke;
+            z_view_keyexpr_from_str_unchecked(&pub_ke, ke_buf);
+            z_owned_bytes_t payload;
+            z_bytes_copy_from_str(&payload, "worker data");
+            assert(z_put(z_loan(peers[i]), z_loan(pub_ke), z_move(payload), NULL) == Z_OK);
+        }
+    }
+
+    z_clock_t start = z_clock_now();
+    while (!all_received(&ctx) && (z_clock_elapsed_s(&start) < TIMEOUT_S)) {
+        z_sleep_ms(10);
+    }
+    for (size_t i = 0; i < PEER_NB; i++) {
+        printf("Peer %zu, received: %zu\n", i, ctx.msg_nb[i]);
+        assert(ctx.msg_nb[i] == MSG_NB);
+    }
+
+    // Dropping peers while the workers run must unregister them from their worker
+    for (size_t i = 0; i < PEER_NB; i++) {
+        z_drop(z_move(peers[i]));
+    }
+    z_drop(z_move(listener));
+    _z_mutex_drop(&ctx.mutex);
+}
+
+int main(void) {
+    test_sharded_rx();
+    return 0;
+}
+#else
+int main(void) {
+    printf(
+        "Missing config token to build this test. This test requires: _Z_SYS_NET_EVENT_SET, Z_FEATURE_SUBSCRIPTION, "
+        "Z_FEATURE_PUBLICATION, Z_FEATURE_UNICAST_PEER and not Z_FEATURE_LOCAL_SUBSCRIBER\n");
+    return 0;
+}
+#endif
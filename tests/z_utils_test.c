@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "zenoh-pico/utils/checksum.h"
 #include "zenoh-pico/utils/pointers.h"
 #include "zenoh-pico/utils/query_params.h"
 #include "zenoh-pico/utils/time_range.h"
@@ -393,6 +394,34 @@ static void test_time_range_contains_fully_bounded_mixed(void) {
     assert(_z_time_range_contains_at_time(&r, _z_time_range_resolve_offset(now, 6.0), now) == false);
 }
 
+// Bit by bit reference of the serial link crc
+static uint32_t crc32_reference(const uint8_t *message, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc = crc ^ (uint32_t)message[i];
+        for (uint8_t j = 0; j < (uint8_t)8; j++) {
+            crc = (crc >> 1) ^ ((uint32_t)0x04C11DB7 & (uint32_t)(-(int32_t)(crc & (uint32_t)1)));
+        }
+    }
+    return ~crc;
+}
+
+static void test_crc32(void) {
+    assert(_z_crc32((const uint8_t *)"123456789", 9) == 0xFC4F2BE9);
+    assert(_z_crc32(NULL, 0) == 0);
+
+    uint8_t buf[67];
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)(i * 37 + 11);
+    }
+    // Every offset and length, to cover unaligned starts and tails
+    for (size_t start = 0; start < 8; start++) {
+        for (size_t len = 0; len <= sizeof(buf) - start; len++) {
+            assert(_z_crc32(&buf[start], len) == crc32_reference(&buf[start], len));
+        }
+    }
+}
+
 int main(void) {
     test_query_params();
     test_time_range();
@@ -401,5 +430,6 @@ int main(void) {
     test_time_range_contains_lower_bound_inclusive_exclusive();
     test_time_range_contains_upper_bound_inclusive_exclusive();
     test_time_range_contains_fully_bounded_mixed();
+    test_crc32();
     return 0;
 }